@@ -0,0 +1,248 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgBench.cpp                        //
+//                                                       //
+//  - Implementation for Bench class                     //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgBench.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+Bench::Result::Result ()
+{
+    Name[0] = 0;
+    Group[0] = 0;
+    Items = 0;
+    Iterations = 0;
+    Samples = 0;
+    MinTime = 0.0;
+    MedianTime = 0.0;
+    MeanTime = 0.0;
+    Error = -1.0;
+}
+//----------------------------------------------------------------------------
+Bench::Bench (const char* acSuite)
+    :
+    m_kResult(64,64)
+{
+    m_acSuite = acSuite;
+    m_iArgs = 0;
+    m_aacArg = 0;
+    m_acJSON = 0;
+    m_acCSV = 0;
+    m_acFilter = 0;
+    m_iSamples = 5;
+    m_dSampleTime = 0.02;
+}
+//----------------------------------------------------------------------------
+Bench::~Bench ()
+{
+}
+//----------------------------------------------------------------------------
+bool Bench::ParseArguments (int iArgs, char** aacArg)
+{
+    m_iArgs = iArgs;
+    m_aacArg = aacArg;
+
+    // every option has a value
+    for (int i = 1; i < iArgs; i += 2)
+    {
+        if (aacArg[i][0] != '-' || i+1 >= iArgs)
+        {
+            printf("option %s has no value\n",aacArg[i]);
+            return false;
+        }
+    }
+
+    m_acJSON = GetOption("-json");
+    m_acCSV = GetOption("-csv");
+    m_acFilter = GetOption("-filter");
+    m_iSamples = GetOption("-samples",m_iSamples);
+    if (m_iSamples < 1)
+    {
+        m_iSamples = 1;
+    }
+    m_dSampleTime = 0.001*(double)GetOption("-time",
+        (int)(1000.0*m_dSampleTime));
+    return true;
+}
+//----------------------------------------------------------------------------
+const char* Bench::GetOption (const char* acOption) const
+{
+    for (int i = 1; i+1 < m_iArgs; i += 2)
+    {
+        if (strcmp(m_aacArg[i],acOption) == 0)
+        {
+            return m_aacArg[i+1];
+        }
+    }
+    return 0;
+}
+//----------------------------------------------------------------------------
+int Bench::GetOption (const char* acOption, int iDefault) const
+{
+    const char* acValue = GetOption(acOption);
+    return (acValue ? atoi(acValue) : iDefault);
+}
+//----------------------------------------------------------------------------
+bool Bench::IsSelected (const char* acName, const char* acGroup) const
+{
+    return !m_acFilter || strstr(acName,m_acFilter)
+        || strstr(acGroup,m_acFilter);
+}
+//----------------------------------------------------------------------------
+const Bench::Result* Bench::Run (const char* acName, const char* acGroup,
+    Function oFunction, void* pvData, double dError)
+{
+    if (!IsSelected(acName,acGroup))
+    {
+        return 0;
+    }
+
+    Result kResult;
+    System::Strncpy(kResult.Name,MAX_NAME,acName,MAX_NAME-1);
+    System::Strncpy(kResult.Group,MAX_NAME,acGroup,MAX_NAME-1);
+    kResult.Error = dError;
+
+    // The first call warms the caches and gives an estimate of the time of
+    // an iteration.  The iterations of a sample are then doubled until the
+    // sample lasts the minimum sample time.
+    double dStart = System::GetPreciseTime();
+    kResult.Items = oFunction(pvData);
+    double dTime = System::GetPreciseTime() - dStart;
+    int iIterations = 1;
+    while (dTime < m_dSampleTime && iIterations < (1 << 30))
+    {
+        iIterations *= 2;
+        dStart = System::GetPreciseTime();
+        for (int i = 0; i < iIterations; i++)
+        {
+            oFunction(pvData);
+        }
+        dTime = System::GetPreciseTime() - dStart;
+    }
+    kResult.Iterations = iIterations;
+    kResult.Samples = m_iSamples;
+
+    // the samples, sorted by insertion for the median
+    double* adSample = WG_NEW double[m_iSamples];
+    double dSum = 0.0;
+    int i, j;
+    for (i = 0; i < m_iSamples; i++)
+    {
+        dStart = System::GetPreciseTime();
+        for (j = 0; j < iIterations; j++)
+        {
+            oFunction(pvData);
+        }
+        double dSample = (System::GetPreciseTime() - dStart) /
+            (double)iIterations;
+        dSum += dSample;
+
+        for (j = i; j > 0 && adSample[j-1] > dSample; j--)
+        {
+            adSample[j] = adSample[j-1];
+        }
+        adSample[j] = dSample;
+    }
+    kResult.MinTime = adSample[0];
+    kResult.MedianTime = adSample[m_iSamples/2];
+    kResult.MeanTime = dSum/(double)m_iSamples;
+    WG_DELETE[] adSample;
+
+    double dPerItem = (kResult.Items > 0 ?
+        kResult.MedianTime/(double)kResult.Items : 0.0);
+    printf("%-30s %-14s %8d items %12.3f us %10.1f ns/item",kResult.Name,
+        kResult.Group,kResult.Items,1e6*kResult.MedianTime,1e9*dPerItem);
+    if (kResult.Error >= 0.0)
+    {
+        printf("  error %.3g",kResult.Error);
+    }
+    printf("\n");
+
+    m_kResult.Append(kResult);
+    return &m_kResult[m_kResult.GetQuantity()-1];
+}
+//----------------------------------------------------------------------------
+bool Bench::Write () const
+{
+    bool bWritten = true;
+    FILE* pkFile;
+    if (m_acJSON)
+    {
+        pkFile = fopen(m_acJSON,"w");
+        if (pkFile)
+        {
+            WriteJSON(pkFile);
+            fclose(pkFile);
+        }
+        else
+        {
+            printf("cannot write %s\n",m_acJSON);
+            bWritten = false;
+        }
+    }
+    if (m_acCSV)
+    {
+        pkFile = fopen(m_acCSV,"w");
+        if (pkFile)
+        {
+            WriteCSV(pkFile);
+            fclose(pkFile);
+        }
+        else
+        {
+            printf("cannot write %s\n",m_acCSV);
+            bWritten = false;
+        }
+    }
+    return bWritten;
+}
+//----------------------------------------------------------------------------
+void Bench::WriteJSON (FILE* pkFile) const
+{
+    // the names are written as they are, they contain no quotes
+    fprintf(pkFile,"{\"suite\":\"%s\",\"backend\":\"%s\",\"results\":[",
+        m_acSuite,GetBackend());
+    for (int i = 0; i < m_kResult.GetQuantity(); i++)
+    {
+        const Result& rkResult = m_kResult[i];
+        fprintf(pkFile,"%s\n{\"name\":\"%s\",\"group\":\"%s\",\"items\":%d,"
+            "\"iterations\":%d,\"samples\":%d,\"min_ns\":%.1f,"
+            "\"median_ns\":%.1f,\"mean_ns\":%.1f",(i > 0 ? "," : ""),
+            rkResult.Name,rkResult.Group,rkResult.Items,rkResult.Iterations,
+            rkResult.Samples,1e9*rkResult.MinTime,1e9*rkResult.MedianTime,
+            1e9*rkResult.MeanTime);
+        if (rkResult.Error >= 0.0)
+        {
+            fprintf(pkFile,",\"error\":%.6g",rkResult.Error);
+        }
+        fprintf(pkFile,"}");
+    }
+    fprintf(pkFile,"\n]}\n");
+}
+//----------------------------------------------------------------------------
+void Bench::WriteCSV (FILE* pkFile) const
+{
+    fprintf(pkFile,"suite,backend,name,group,items,iterations,samples,"
+        "min_ns,median_ns,mean_ns,error\n");
+    for (int i = 0; i < m_kResult.GetQuantity(); i++)
+    {
+        const Result& rkResult = m_kResult[i];
+        fprintf(pkFile,"%s,%s,%s,%s,%d,%d,%d,%.1f,%.1f,%.1f,",m_acSuite,
+            GetBackend(),rkResult.Name,rkResult.Group,rkResult.Items,
+            rkResult.Iterations,rkResult.Samples,1e9*rkResult.MinTime,
+            1e9*rkResult.MedianTime,1e9*rkResult.MeanTime);
+        if (rkResult.Error >= 0.0)
+        {
+            fprintf(pkFile,"%.6g",rkResult.Error);
+        }
+        fprintf(pkFile,"\n");
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgBench.h                          //
+//                                                       //
+//  - Interface for Bench class                          //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_BENCH_H__
+#define __WG_BENCH_H__
+
+#include "WgFoundation.h"
+
+namespace WGSoft3D
+{
+
+// The harness of the benchmark programs.  A benchmark is a function that
+// does one iteration of the work to measure and returns the number of items
+// it processed (the objects updated, the rays picked, the operations done).
+// Run calls it until a sample lasts at least the minimum sample time,
+// repeats the samples, and records the fastest, the median and the mean
+// time of an iteration.  Every result is printed when it is done; the
+// results are written as JSON and CSV by Write, so that runs of different
+// builds (the fixed and the float backend, with and without an
+// optimization) can be compared by a script.
+//
+// The options of the command line that the harness knows are
+//   -json file     write the results as JSON
+//   -csv file      write the results as CSV
+//   -filter text   run only the benchmarks whose name or group contains text
+//   -samples n     the number of samples of a benchmark (default 5)
+//   -time ms       the minimum duration of a sample (default 20)
+// A program may define more options and read them with GetOption.
+
+class Bench
+{
+public:
+    Bench (const char* acSuite);
+    ~Bench ();
+
+    // Returns false for an option without a value.
+    bool ParseArguments (int iArgs, char** aacArg);
+    const char* GetOption (const char* acOption) const;
+    int GetOption (const char* acOption, int iDefault) const;
+
+    // the benchmark function, it returns the number of items processed
+    typedef int (*Function)(void* pvData);
+
+    enum
+    {
+        MAX_NAME = 64
+    };
+
+    class Result
+    {
+    public:
+        Result ();
+
+        char Name[MAX_NAME];   // the work measured, for example "UpdateGS"
+        char Group[MAX_NAME];  // the input, for example "city-32"
+        int Items;             // the items of an iteration
+        int Iterations;        // the iterations of a sample
+        int Samples;
+        double MinTime, MedianTime, MeanTime;  // seconds per iteration
+        double Error;          // the error of the output, < 0 if unknown
+    };
+
+    // Run a benchmark.  Returns null when it is filtered out.  The error is
+    // an accuracy measure of the output that the program computed, it is
+    // reported with the times when it is not negative.
+    const Result* Run (const char* acName, const char* acGroup,
+        Function oFunction, void* pvData, double dError = -1.0);
+
+    bool IsSelected (const char* acName, const char* acGroup) const;
+    int GetResultQuantity () const;
+    const Result& GetResult (int i) const;
+
+    // the numeric backend of the build, "fixed" or "float"
+    static const char* GetBackend ();
+
+    // Write the results to the files named on the command line.  Returns
+    // false when a file cannot be written.
+    bool Write () const;
+    void WriteJSON (FILE* pkFile) const;
+    void WriteCSV (FILE* pkFile) const;
+
+private:
+    const char* m_acSuite;
+    int m_iArgs;
+    char** m_aacArg;
+    const char* m_acJSON;
+    const char* m_acCSV;
+    const char* m_acFilter;
+    int m_iSamples;
+    double m_dSampleTime;
+    TArray<Result> m_kResult;
+};
+
+#include "WgBench.inl"
+
+}
+
+#endif
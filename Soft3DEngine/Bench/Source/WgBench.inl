@@ -0,0 +1,27 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgBench.inl                        //
+//                                                       //
+//  - Inlines for Bench class                            //
+//                                                       //
+///////////////////////////////////////////////////////////
+//----------------------------------------------------------------------------
+inline int Bench::GetResultQuantity () const
+{
+    return m_kResult.GetQuantity();
+}
+//----------------------------------------------------------------------------
+inline const Bench::Result& Bench::GetResult (int i) const
+{
+    return m_kResult[i];
+}
+//----------------------------------------------------------------------------
+inline const char* Bench::GetBackend ()
+{
+#if WG_REAL == WG_REAL_FLOAT
+    return "float";
+#else
+    return "fixed";
+#endif
+}
+//----------------------------------------------------------------------------
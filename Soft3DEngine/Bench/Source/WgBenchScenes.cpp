@@ -0,0 +1,393 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgBenchScenes.cpp                  //
+//                                                       //
+//  - Implementation for BenchScenes class               //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgBenchScenes.h"
+#include <cmath>
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+TriMesh* BenchScenes::Share (TriMesh* pkMesh)
+{
+    TriMesh* pkShare = WG_NEW TriMesh(pkMesh->Vertices,pkMesh->Indices,
+        false);
+    pkShare->Normals = pkMesh->Normals;
+    return pkShare;
+}
+//----------------------------------------------------------------------------
+Node* BenchScenes::CreateChain (int iDepth)
+{
+    Transformation kXFrm;
+    kXFrm.SetUniformScale(fixed(FIXED_CONST(0.04)));
+    TriMeshPtr spkMesh = StandardMesh().Transform(kXFrm).Normals(true,false)
+        .Icosahedron();
+
+    // ten degrees and a step of 0.1 per level
+    Matrix3x kTurn;
+    kTurn.FromAxisAngle(Vector3x::UNIT_Z,
+        fixed::FromInt(10)*Mathx::DEG_TO_RAD);
+    Vector3x kStep(fixed(FIXED_CONST(0.1)),fixed(FIXED_ZERO),
+        fixed(FIXED_CONST(0.01)));
+
+    Node* pkRoot = WG_NEW Node(2);
+    Node* pkParent = pkRoot;
+    for (int i = 1; i < iDepth; i++)
+    {
+        Node* pkNode = WG_NEW Node(2);
+        pkNode->Local.SetRotate(kTurn);
+        pkNode->Local.SetTranslate(kStep);
+        pkParent->AttachChild(Share(spkMesh));
+        pkParent->AttachChild(pkNode);
+        pkParent = pkNode;
+    }
+    pkParent->AttachChild(Share(spkMesh));
+    return pkRoot;
+}
+//----------------------------------------------------------------------------
+Node* BenchScenes::CreateFanOut (int iWidth)
+{
+    Transformation kXFrm;
+    kXFrm.SetUniformScale(fixed(FIXED_CONST(0.2)));
+    TriMeshPtr spkMesh = StandardMesh().Transform(kXFrm).Normals(true,false)
+        .Icosahedron();
+
+    int iSide = (int)ceil(sqrt((double)iWidth));
+    fixed fSpacing = fixed(FIXED_HALF);
+    Node* pkRoot = WG_NEW Node(iWidth);
+    for (int i = 0; i < iWidth; i++)
+    {
+        TriMesh* pkMesh = Share(spkMesh);
+        pkMesh->Local.SetTranslate(Vector3x(
+            fSpacing*fixed::FromInt(i%iSide - iSide/2),
+            fSpacing*fixed::FromInt(i/iSide - iSide/2),fixed(FIXED_ZERO)));
+        pkRoot->AttachChild(pkMesh);
+    }
+    return pkRoot;
+}
+//----------------------------------------------------------------------------
+Node* BenchScenes::CreateCity (int iBlocks)
+{
+    fixed fZero = fixed(FIXED_ZERO);
+    fixed fOffset = fixed(FIXED_CONST(0.25));
+    fixed fWidth = fixed(FIXED_CONST(0.15));
+
+    // buildings of three heights, the UVs of the boxes are all the same
+    StandardMesh kSM;
+    kSM.Normals(true,false).UVs(true,false);
+    TriMeshPtr aspkBuilding[3];
+    fixed afHeight[3];
+    int i;
+    for (i = 0; i < 3; i++)
+    {
+        afHeight[i] = fOffset*fixed::FromInt(i+1);
+        aspkBuilding[i] = kSM.Box(fWidth,fWidth,afHeight[i]);
+    }
+    Vector2xArrayPtr spkUVs = kSM.GetUVs();
+
+    // a checkerboard texture
+    const int iSize = 8;
+    unsigned char* aucData = WG_NEW unsigned char[4*iSize*iSize];
+    for (i = 0; i < iSize*iSize; i++)
+    {
+        unsigned char ucValue = (((i/iSize + i) & 1) ? 255 : 64);
+        aucData[4*i] = ucValue;
+        aucData[4*i+1] = ucValue;
+        aucData[4*i+2] = ucValue;
+        aucData[4*i+3] = 255;
+    }
+    TexturePtr spkTexture = WG_NEW Texture(WG_NEW Image(Image::IT_RGBA8888,
+        iSize,iSize,aucData));
+
+    MaterialState* apkMaterial[2];
+    for (i = 0; i < 2; i++)
+    {
+        apkMaterial[i] = WG_NEW MaterialState;
+        apkMaterial[i]->Diffuse = ColorRGBA(fixed(FIXED_CONST(0.5)),
+            fixed(FIXED_CONST(0.5)),fixed(FIXED_CONST(0.5+0.25*i)),
+            fixed(FIXED_ONE));
+    }
+
+    Node* pkRoot = WG_NEW Node(iBlocks*iBlocks+2);
+    Light* pkLight = WG_NEW Light(Light::LT_DIRECTIONAL);
+    Vector3x kDirection(-fixed(FIXED_ONE),-fixed(FIXED_HALF),
+        -fixed(FIXED_ONE+FIXED_ONE));
+    kDirection.Normalize();
+    pkLight->SetDirection(kDirection);
+    pkRoot->SetLight(pkLight);
+
+    // the ground, a little below the buildings
+    fixed fExtent = fixed(FIXED_HALF)*fixed::FromInt(iBlocks+1);
+    TriMesh* pkGround = StandardMesh().Normals(true,false).Rectangle(2,2,
+        fExtent,fExtent);
+    pkGround->Local.SetTranslate(Vector3x(fZero,fZero,
+        -fixed(FIXED_CONST(0.01))));
+    pkRoot->AttachChild(pkGround);
+
+    int iHalf = iBlocks/2;
+    for (int iY = 0; iY < iBlocks; iY++)
+    {
+        for (int iX = 0; iX < iBlocks; iX++)
+        {
+            Node* pkBlock = WG_NEW Node(4);
+            pkBlock->Local.SetTranslate(Vector3x(fixed::FromInt(iX-iHalf),
+                fixed::FromInt(iY-iHalf),fZero));
+            pkBlock->SetGlobalState(apkMaterial[(iX+iY) & 1]);
+
+            for (i = 0; i < 4; i++)
+            {
+                int iType = (iX+iY+i) % 3;
+                TriMesh* pkBuilding = Share(aspkBuilding[iType]);
+                pkBuilding->Local.SetTranslate(Vector3x(
+                    (i & 1) ? fOffset : -fOffset,
+                    (i & 2) ? fOffset : -fOffset,afHeight[iType]));
+                if (i & 1)
+                {
+                    pkBuilding->SetEffect(WG_NEW TextureEffect(spkTexture,
+                        spkUVs));
+                }
+                pkBlock->AttachChild(pkBuilding);
+            }
+            pkRoot->AttachChild(pkBlock);
+        }
+    }
+
+    // the landmark, a tall building above the middle block
+    Node* pkLandmark = WG_NEW Node;
+    TriMesh* pkTower = Share(aspkBuilding[2]);
+    pkTower->Local.SetUniformScale(fixed::FromInt(2));
+    pkTower->Local.SetTranslate(Vector3x(fOffset,fOffset,
+        afHeight[2]+afHeight[2]));
+    pkLandmark->AttachChild(pkTower);
+    PlanarShadowEffect* pkShadow = WG_NEW PlanarShadowEffect(1);
+    pkShadow->SetPlane(0,pkGround);
+    pkShadow->SetProjector(0,pkLight);
+    pkLandmark->SetEffect(pkShadow);
+    pkRoot->AttachChild(pkLandmark);
+
+    return pkRoot;
+}
+//----------------------------------------------------------------------------
+Node* BenchScenes::CreateRoads (int iBlocks)
+{
+    fixed fZero = fixed(FIXED_ZERO);
+    fixed fWallHeight = fixed(FIXED_CONST(0.05));
+
+    StandardMesh kSM;
+    kSM.Normals(true,false);
+    TriMeshPtr spkRoad = kSM.Box(fixed(FIXED_CONST(0.5)),
+        fixed(FIXED_CONST(0.04)),fixed(FIXED_CONST(0.005)));
+    TriMeshPtr spkWall = kSM.Box(fixed(FIXED_CONST(0.45)),
+        fixed(FIXED_CONST(0.01)),fWallHeight);
+
+    Matrix3x kCross;
+    kCross.FromAxisAngle(Vector3x::UNIT_Z,Mathx::HALF_PI);
+
+    Node* pkRoot = WG_NEW Node(iBlocks*iBlocks);
+    int iHalf = iBlocks/2;
+    for (int iY = 0; iY < iBlocks; iY++)
+    {
+        for (int iX = 0; iX < iBlocks; iX++)
+        {
+            Node* pkBlock = WG_NEW Node(4);
+            pkBlock->Local.SetTranslate(Vector3x(fixed::FromInt(iX-iHalf),
+                fixed::FromInt(iY-iHalf),fZero));
+            Matrix3x kRot;
+            kRot.FromAxisAngle(Vector3x::UNIT_Z,
+                fixed::FromInt(15*((iX+2*iY) % 12))*Mathx::DEG_TO_RAD);
+            pkBlock->Local.SetRotate(kRot);
+
+            // two crossing roads, and two walls along the first one
+            TriMesh* pkRoad = Share(spkRoad);
+            pkBlock->AttachChild(pkRoad);
+            pkRoad = Share(spkRoad);
+            pkRoad->Local.SetRotate(kCross);
+            pkBlock->AttachChild(pkRoad);
+            fixed fSide = fixed(FIXED_CONST(0.1));
+            for (int i = 0; i < 2; i++)
+            {
+                TriMesh* pkWall = Share(spkWall);
+                pkWall->Local.SetTranslate(Vector3x(fZero,
+                    (i == 0 ? fSide : -fSide),fWallHeight));
+                pkBlock->AttachChild(pkWall);
+            }
+            pkRoot->AttachChild(pkBlock);
+        }
+    }
+    return pkRoot;
+}
+//----------------------------------------------------------------------------
+Node* BenchScenes::CreateAnimated (int iBranches, int iDepth)
+{
+    Transformation kXFrm;
+    kXFrm.SetUniformScale(fixed(FIXED_CONST(0.1)));
+    TriMeshPtr spkMesh = StandardMesh().Transform(kXFrm).Normals(true,false)
+        .Icosahedron();
+
+    // a quarter turn per key, the keys of the translation have the same
+    // times
+    const int iKeys = 5;
+    float* afTime = WG_NEW float[iKeys];
+    Quaternionx* akRotation = WG_NEW Quaternionx[iKeys];
+    for (int i = 0; i < iKeys; i++)
+    {
+        afTime[i] = (float)i/(float)(iKeys-1);
+        akRotation[i].FromAxisAngle(Vector3x::UNIT_Z,
+            Mathx::HALF_PI*fixed::FromInt(i));
+    }
+    KeyframeControllerPtr spkModel = WG_NEW KeyframeController;
+    spkModel->RotationTimes = WG_NEW FloatArray(iKeys,afTime);
+    spkModel->RotationData = WG_NEW QuaternionxArray(iKeys,akRotation);
+    spkModel->TranslationTimes = spkModel->RotationTimes;
+
+    Node* pkRoot = WG_NEW Node(iBranches);
+    if (iDepth > 0)
+    {
+        AddChildren(pkRoot,iBranches,iDepth,fixed::FromInt(8),spkMesh,
+            spkModel);
+    }
+    return pkRoot;
+}
+//----------------------------------------------------------------------------
+void BenchScenes::AddChildren (Node* pkParent, int iBranches, int iLevel,
+    fixed fSpacing, TriMesh* pkMesh, KeyframeController* pkModel)
+{
+    for (int i = 0; i < iBranches; i++)
+    {
+        fixed fAngle = Mathx::TWO_PI*fixed::FromInt(i) /
+            fixed::FromInt(iBranches);
+        Spatial* pkChild;
+        if (iLevel > 1)
+        {
+            Node* pkNode = WG_NEW Node(iBranches);
+            AddChildren(pkNode,iBranches,iLevel-1,fixed(FIXED_HALF)*fSpacing,
+                pkMesh,pkModel);
+            pkChild = pkNode;
+        }
+        else
+        {
+            pkChild = Share(pkMesh);
+        }
+        pkChild->Local.SetTranslate(Vector3x(fSpacing*Mathx::Cos(fAngle),
+            fSpacing*Mathx::Sin(fAngle),fixed(FIXED_ZERO)));
+        Animate(pkChild,pkModel,0.1*i + 0.05*iLevel);
+        pkParent->AttachChild(pkChild);
+    }
+}
+//----------------------------------------------------------------------------
+void BenchScenes::Animate (Spatial* pkObject, KeyframeController* pkModel,
+    double dPhase)
+{
+    // the rotation keys are shared, the translation keys move the object up
+    // and down around its place
+    int iKeys = pkModel->RotationTimes->GetQuantity();
+    Vector3x* akTranslation = WG_NEW Vector3x[iKeys];
+    Vector3x kBob = fixed(FIXED_CONST(0.1))*Vector3x::UNIT_Z;
+    for (int i = 0; i < iKeys; i++)
+    {
+        akTranslation[i] = pkObject->Local.GetTranslate();
+        if (i & 1)
+        {
+            akTranslation[i] += ((i & 2) ? -kBob : kBob);
+        }
+    }
+
+    KeyframeController* pkController = WG_NEW KeyframeController;
+    pkController->TranslationTimes = pkModel->TranslationTimes;
+    pkController->TranslationData = WG_NEW Vector3xArray(iKeys,
+        akTranslation);
+    pkController->RotationTimes = pkModel->RotationTimes;
+    pkController->RotationData = pkModel->RotationData;
+    pkController->RepeatType = Controller::RT_WRAP;
+    pkController->MinTime = 0.0;
+    pkController->MaxTime = 1.0;
+    pkController->Phase = dPhase;
+    pkObject->SetController(pkController);
+}
+//----------------------------------------------------------------------------
+Node* BenchScenes::CreateSpheres (int iQuantity, int iSamples)
+{
+    StandardMesh kSM;
+    kSM.Normals(true,false);
+    int iSide = (int)ceil(sqrt((double)iQuantity));
+    Node* pkRoot = WG_NEW Node(iQuantity);
+    for (int i = 0; i < iQuantity; i++)
+    {
+        TriMesh* pkSphere = kSM.Sphere(iSamples,iSamples,
+            fixed(FIXED_CONST(0.4)));
+        pkSphere->Local.SetTranslate(Vector3x(
+            fixed::FromInt(i%iSide - iSide/2),
+            fixed::FromInt(i/iSide - iSide/2),fixed(FIXED_ZERO)));
+        pkRoot->AttachChild(pkSphere);
+    }
+    return pkRoot;
+}
+//----------------------------------------------------------------------------
+Camera* BenchScenes::CreateCamera (Spatial* pkScene)
+{
+    Vector3x kCenter = pkScene->WorldBound->GetCenter();
+    fixed fRadius = pkScene->WorldBound->GetRadius();
+    if (fRadius < fixed(FIXED_ONE))
+    {
+        fRadius = fixed(FIXED_ONE);
+    }
+
+    // down at 45 degrees, towards +y
+    Vector3x kDVector(fixed(FIXED_ZERO),fixed(FIXED_ONE),-fixed(FIXED_ONE));
+    kDVector.Normalize();
+    Vector3x kRVector = kDVector.UnitCross(Vector3x::UNIT_Z);
+    Vector3x kUVector = kRVector.Cross(kDVector);
+
+    Camera* pkCamera = WG_NEW Camera;
+    pkCamera->SetFrustum(fixed::FromInt(60),fixed(FIXED_CONST(4.0/3.0)),
+        fixed(FIXED_CONST(0.1)),fixed::FromInt(3)*fRadius);
+    pkCamera->SetFrame(kCenter - fRadius*kDVector,kDVector,kUVector,
+        kRVector);
+    return pkCamera;
+}
+//----------------------------------------------------------------------------
+int BenchScenes::GetObjectQuantity (Spatial* pkScene)
+{
+    int iQuantity = 1;
+    Node* pkNode = DynamicCast<Node>(pkScene);
+    if (pkNode)
+    {
+        for (int i = 0; i < pkNode->GetQuantity(); i++)
+        {
+            Spatial* pkChild = pkNode->GetChild(i);
+            if (pkChild)
+            {
+                iQuantity += GetObjectQuantity(pkChild);
+            }
+        }
+    }
+    return iQuantity;
+}
+//----------------------------------------------------------------------------
+void BenchScenes::GetGeometry (Spatial* pkScene,
+    TArray<Geometry*>& rkGeometry)
+{
+    Geometry* pkGeometry = DynamicCast<Geometry>(pkScene);
+    if (pkGeometry)
+    {
+        rkGeometry.Append(pkGeometry);
+        return;
+    }
+
+    Node* pkNode = DynamicCast<Node>(pkScene);
+    if (pkNode)
+    {
+        for (int i = 0; i < pkNode->GetQuantity(); i++)
+        {
+            Spatial* pkChild = pkNode->GetChild(i);
+            if (pkChild)
+            {
+                GetGeometry(pkChild,rkGeometry);
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgBenchScenes.h                    //
+//                                                       //
+//  - Interface for BenchScenes class                    //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_BENCHSCENES_H__
+#define __WG_BENCHSCENES_H__
+
+#include "WgFoundation.h"
+#include "WgKeyframeController.h"
+
+namespace WGSoft3D
+{
+
+// Synthetic scenes for the scene graph benchmarks.  Each scene is built from
+// Node, TriMesh (made by StandardMesh), Light, global states and effects,
+// and its size is set by the parameters.  The meshes of a scene share their
+// vertex, normal and index arrays, except those of CreateSpheres.  The up
+// axis is z.  The scenes are small enough for the range of 16.16 fixed
+// point (the squared distances stay below 32768) at the default sizes of
+// the benchmarks.
+//
+// The scenes are returned without an update; call UpdateGS and UpdateRS
+// before drawing them.
+
+class BenchScenes
+{
+public:
+    // A chain of iDepth nodes, each the parent of the next, with a mesh at
+    // every level.  Every level turns and climbs a bit, so the chain is a
+    // helix.  It measures the cost of the recursion in the traversals.
+    static Node* CreateChain (int iDepth);
+
+    // A root with iWidth meshes as its children, on a square grid.
+    static Node* CreateFanOut (int iWidth);
+
+    // A grid of iBlocks x iBlocks blocks on a ground plane.  Each block is a
+    // node with a material and four buildings of three heights, every
+    // other building is textured.  The root has a directional light, and a
+    // landmark in the middle casts a planar shadow on the ground.  The
+    // scene has about 5*iBlocks*iBlocks objects.
+    static Node* CreateCity (int iBlocks);
+
+    // A grid of iBlocks x iBlocks blocks of two crossing roads and two
+    // walls, long thin meshes.  Each block is turned by a multiple of 15
+    // degrees about the up axis, so the meshes have many headings.  It
+    // compares the types of bounding volumes.  The scene has
+    // 5*iBlocks*iBlocks objects.
+    static Node* CreateRoads (int iBlocks);
+
+    // A tree of iDepth levels of nodes with iBranches children each, the
+    // leaves are meshes.  Every node is animated by a KeyframeController
+    // that turns it and moves it up and down, with a period of one second.
+    static Node* CreateAnimated (int iBranches, int iDepth);
+
+    // iQuantity spheres on a grid, each with its own vertices and normals,
+    // for the benchmarks of Geometry::UpdateMS.
+    static Node* CreateSpheres (int iQuantity, int iSamples);
+
+    // A camera with a field of view of 60 degrees that looks at the center
+    // of the world bound of the scene from above, at a distance of the
+    // bound radius, so part of the scene is outside of the frustum.  The
+    // scene must be updated.
+    static Camera* CreateCamera (Spatial* pkScene);
+
+    // the objects of a scene, nodes and geometry
+    static int GetObjectQuantity (Spatial* pkScene);
+    static void GetGeometry (Spatial* pkScene, TArray<Geometry*>& rkGeometry);
+
+private:
+    // a mesh that shares the arrays of another
+    static TriMesh* Share (TriMesh* pkMesh);
+    static void AddChildren (Node* pkParent, int iBranches, int iLevel,
+        fixed fSpacing, TriMesh* pkMesh, KeyframeController* pkModel);
+    static void Animate (Spatial* pkObject, KeyframeController* pkModel,
+        double dPhase);
+};
+
+}
+
+#endif
@@ -0,0 +1,1448 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgMathBench.cpp                    //
+//                                                       //
+//  - Math microbenchmarks                               //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+// The benchmarks of the hot primitives of the mathematics library:
+//
+//   WgMathBench [-json file] [-csv file] [-filter text] [-samples n]
+//       [-time ms]
+//
+// Each operation runs on the same 256 inputs for the fixed classes of the
+// engine (Vector3x, Matrix3x, ..., group "fixed") and for the float and
+// double templates (Vector3<float>, ..., groups "float" and "double").  An
+// item is one operation, so the times are in ns/op.  The error of the
+// fixed and the float results is the largest absolute difference of a
+// component from the double result.  The inputs are multiples of 2^-16
+// that all three types represent exactly, so the error is the error of the
+// arithmetic and not of the input conversion.
+//
+// Transformation exists only for fixed.  For float and double the same
+// arithmetic (a rotation with a uniform scale) is done by RSTransform.
+//
+// A summary at the end lists every operation with the three times and
+// flags the operations where fixed is slower than float.  In a build with
+// WG_REAL=WG_REAL_FLOAT the engine classes use Floatx, their group is
+// "floatx".
+//
+// The fixed build then measures the rows of the table in WgFixedMath.h.
+// For each transcendental function, domain and tier (the group "fast",
+// "normal" or "accurate") the error is the largest error in 16.16 ulp
+// over a sweep of the domain against the double function, and the time is
+// that of 256 random inputs of the domain, in ns/call.  A second table
+// lists them in the layout of the header.
+//
+// Last the fixed build times the product and the quotient of two fixed
+// values, the kernels of fixed that saturate on overflow, against the same
+// 64-bit arithmetic without the saturation ("wrap") and against the round
+// trip through float of the operators before they were integer ("float").
+// The error is in 16.16 ulp.  It checks the results of an overflow, of a
+// division by zero and of FromInt for a negative value; the program
+// returns 1 when a check fails.
+
+#include "WgBench.h"
+#include <cstdio>
+using namespace WGSoft3D;
+
+static const int gs_iQuantity = 256;
+
+#if WG_REAL == WG_REAL_FLOAT
+static const char* gs_acEngine = "floatx";
+#else
+static const char* gs_acEngine = "fixed";
+#endif
+
+//----------------------------------------------------------------------------
+template <class Real>
+inline Real ToReal (double dValue)
+{
+    return (Real)dValue;
+}
+//----------------------------------------------------------------------------
+template <>
+inline fixed ToReal<fixed> (double dValue)
+{
+    return fixed(FixedFromFloat((float)dValue));
+}
+//----------------------------------------------------------------------------
+template <class Real>
+inline double ToDouble (Real fValue)
+{
+    return (double)fValue;
+}
+//----------------------------------------------------------------------------
+template <>
+inline double ToDouble<fixed> (fixed fValue)
+{
+    return (double)FloatFromFixed(fValue);
+}
+//----------------------------------------------------------------------------
+// The operations of Transformation that are measured, for the types that
+// Transformation does not have.  It is the arithmetic of Transformation for
+// a rotation with a uniform scale, the inverse is a general matrix as in
+// Transformation::Inverse.
+template <class Real>
+class RSTransform
+{
+public:
+    RSTransform ()
+    {
+        m_fScale = (Real)1.0;
+        m_bIsRSMatrix = true;
+    }
+
+    void SetRotate (const Matrix3<Real>& rkRotate)
+    {
+        m_kMatrix = rkRotate;
+        m_bIsRSMatrix = true;
+    }
+
+    void SetTranslate (const Vector3<Real>& rkTranslate)
+    {
+        m_kTranslate = rkTranslate;
+    }
+
+    void SetUniformScale (Real fScale)
+    {
+        m_fScale = fScale;
+    }
+
+    bool IsRSMatrix () const
+    {
+        return m_bIsRSMatrix;
+    }
+
+    const Matrix3<Real>& GetMatrix () const
+    {
+        return m_kMatrix;
+    }
+
+    const Vector3<Real>& GetTranslate () const
+    {
+        return m_kTranslate;
+    }
+
+    Real GetUniformScale () const
+    {
+        return m_fScale;
+    }
+
+    Vector3<Real> ApplyForward (const Vector3<Real>& rkInput) const
+    {
+        if (m_bIsRSMatrix)
+        {
+            Vector3<Real> kOutput(m_fScale*rkInput.X(),
+                m_fScale*rkInput.Y(),m_fScale*rkInput.Z());
+            return m_kMatrix*kOutput + m_kTranslate;
+        }
+        return m_kMatrix*rkInput + m_kTranslate;
+    }
+
+    void Product (const RSTransform& rkA, const RSTransform& rkB)
+    {
+        assert(rkA.m_bIsRSMatrix && rkB.m_bIsRSMatrix);
+        RSTransform kProduct;
+        kProduct.SetRotate(rkA.m_kMatrix*rkB.m_kMatrix);
+        kProduct.SetTranslate(rkA.m_fScale*(rkA.m_kMatrix*rkB.m_kTranslate)
+            + rkA.m_kTranslate);
+        kProduct.SetUniformScale(rkA.m_fScale*rkB.m_fScale);
+        *this = kProduct;
+    }
+
+    void Inverse (RSTransform& rkInverse) const
+    {
+        if (m_bIsRSMatrix)
+        {
+            rkInverse.m_kMatrix = m_kMatrix.Transpose()/m_fScale;
+        }
+        else
+        {
+            rkInverse.m_kMatrix = m_kMatrix.Inverse();
+        }
+        rkInverse.m_kTranslate = -(rkInverse.m_kMatrix*m_kTranslate);
+        rkInverse.m_fScale = (Real)1.0;
+        rkInverse.m_bIsRSMatrix = false;
+    }
+
+private:
+    Matrix3<Real> m_kMatrix;
+    Vector3<Real> m_kTranslate;
+    Real m_fScale;
+    bool m_bIsRSMatrix;
+};
+//----------------------------------------------------------------------------
+// the classes of a type, the templates for float and double and the fixed
+// classes of the engine
+template <class Real>
+class MathTypes
+{
+public:
+    typedef Vector3<Real> Vector3T;
+    typedef Matrix3<Real> Matrix3T;
+    typedef Matrix4<Real> Matrix4T;
+    typedef Quaternion<Real> QuaternionT;
+    typedef Plane3<Real> Plane3T;
+    typedef Ray3<Real> Ray3T;
+    typedef Triangle3<Real> Triangle3T;
+    typedef IntrRay3Triangle3<Real> IntrRay3Triangle3T;
+    typedef RSTransform<Real> TransformationT;
+};
+//----------------------------------------------------------------------------
+template <>
+class MathTypes<fixed>
+{
+public:
+    typedef Vector3x Vector3T;
+    typedef Matrix3x Matrix3T;
+    typedef Matrix4x Matrix4T;
+    typedef Quaternionx QuaternionT;
+    typedef Plane3x Plane3T;
+    typedef Ray3x Ray3T;
+    typedef Triangle3x Triangle3T;
+    typedef IntrRay3Triangle3x IntrRay3Triangle3T;
+    typedef Transformation TransformationT;
+};
+//----------------------------------------------------------------------------
+// The inputs in double, multiples of 2^-16 that are small enough for the
+// 24 bits of a float.
+class SourceData
+{
+public:
+    SourceData ();
+
+    double U[gs_iQuantity][3];          // unit length vectors
+    double V[gs_iQuantity][3];          // in [-4,4]^3
+    double Rotate[gs_iQuantity][9];
+    double Matrix[gs_iQuantity][9];     // rotation*scale + shear
+    double Matrix4[gs_iQuantity][16];
+    double P[gs_iQuantity][4], Q[gs_iQuantity][4];  // consecutive keys
+    double A[gs_iQuantity][4], B[gs_iQuantity][4];  // squad controls
+    double Time[gs_iQuantity];
+    double Plane[gs_iQuantity][4];      // unit normal and constant
+    double Scale[gs_iQuantity];
+    double Translate[gs_iQuantity][3];
+    double Origin[gs_iQuantity][3], Direction[gs_iQuantity][3];
+    double Triangle[gs_iQuantity][9];
+
+private:
+    static double Quantize (double dValue);
+    static double Random (double dMin, double dMax);
+    static void RandomUnit (double* adV);
+    static void RandomRotation (double* adRotate, double* adQuaternion);
+};
+//----------------------------------------------------------------------------
+SourceData::SourceData ()
+{
+    Mathd::SymmetricRandom(1);
+
+    double adQ[4];
+    int i, j, k;
+    for (i = 0; i < gs_iQuantity; i++)
+    {
+        RandomUnit(U[i]);
+        for (j = 0; j < 3; j++)
+        {
+            V[i][j] = Quantize(Random(-4.0,4.0));
+        }
+
+        RandomRotation(Rotate[i],adQ);
+        RandomRotation(Matrix[i],adQ);
+        double adScale[3] = { Random(0.5,2.0), Random(0.5,2.0),
+            Random(0.5,2.0) };
+        for (j = 0; j < 9; j++)
+        {
+            // scale the columns and shear
+            Matrix[i][j] = Quantize(Matrix[i][j]*adScale[j%3] +
+                Random(-0.1,0.1));
+        }
+        for (j = 0; j < 16; j++)
+        {
+            Matrix4[i][j] = Quantize(Random(-2.0,2.0));
+        }
+
+        Time[i] = Quantize(Random(0.0,1.0));
+
+        RandomUnit(Plane[i]);
+        Plane[i][3] = Quantize(Random(-2.0,2.0));
+
+        Scale[i] = Quantize(Random(0.5,2.0));
+        for (j = 0; j < 3; j++)
+        {
+            Translate[i][j] = Quantize(Random(-4.0,4.0));
+        }
+
+        // A triangle in [-2,2]^3 and a ray from a point in [-4,4]^3 to a
+        // point well inside the triangle, so that every ray hits.
+        for (j = 0; j < 9; j++)
+        {
+            Triangle[i][j] = Quantize(Random(-2.0,2.0));
+        }
+        double dB0 = Random(0.15,0.4), dB1 = Random(0.15,0.4);
+        double dB2 = 1.0 - dB0 - dB1;
+        double adTarget[3], dLength = 0.0;
+        for (j = 0; j < 3; j++)
+        {
+            Origin[i][j] = Quantize(Random(-4.0,4.0));
+            adTarget[j] = dB0*Triangle[i][j] + dB1*Triangle[i][3+j] +
+                dB2*Triangle[i][6+j];
+            Direction[i][j] = adTarget[j] - Origin[i][j];
+            dLength += Direction[i][j]*Direction[i][j];
+        }
+        dLength = sqrt(dLength);
+        for (j = 0; j < 3; j++)
+        {
+            Direction[i][j] = Quantize(Direction[i][j]/dLength);
+        }
+    }
+
+    // The quaternions of a sequence of keys, each a turn of 0.2 to 1.2
+    // radians from the previous one as in a keyframe controller.  P and Q
+    // are consecutive keys, A and B their squad controls, the intermediate
+    // quaternion of a key between its neighbors.
+    Quaterniond akKey[gs_iQuantity+2];
+    akKey[0] = Quaterniond(Vector3d(U[0]),Random(-Mathd::PI,Mathd::PI));
+    for (i = 1; i < gs_iQuantity+2; i++)
+    {
+        akKey[i] = akKey[i-1]*Quaterniond(Vector3d(U[i % gs_iQuantity]),
+            Random(0.2,1.2));
+        akKey[i].Normalize();
+    }
+    Quaterniond kA;
+    for (i = 0; i < gs_iQuantity; i++)
+    {
+        for (k = 0; k < 4; k++)
+        {
+            P[i][k] = Quantize(akKey[i][k]);
+            Q[i][k] = Quantize(akKey[i+1][k]);
+        }
+        if (i > 0)
+        {
+            kA.Intermediate(akKey[i-1],akKey[i],akKey[i+1]);
+        }
+        else
+        {
+            kA = akKey[0];
+        }
+        for (k = 0; k < 4; k++)
+        {
+            A[i][k] = Quantize(kA[k]);
+        }
+        kA.Intermediate(akKey[i],akKey[i+1],akKey[i+2]);
+        for (k = 0; k < 4; k++)
+        {
+            B[i][k] = Quantize(kA[k]);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+double SourceData::Quantize (double dValue)
+{
+    return floor(dValue*65536.0 + 0.5)/65536.0;
+}
+//----------------------------------------------------------------------------
+double SourceData::Random (double dMin, double dMax)
+{
+    return dMin + 0.5*(dMax - dMin)*(Mathd::SymmetricRandom() + 1.0);
+}
+//----------------------------------------------------------------------------
+void SourceData::RandomUnit (double* adV)
+{
+    // away from zero, so the normalization is well conditioned
+    Vector3d kV;
+    do
+    {
+        kV = Vector3d(Random(-1.0,1.0),Random(-1.0,1.0),Random(-1.0,1.0));
+    }
+    while (kV.Length() < 0.25);
+    kV.Normalize();
+    for (int i = 0; i < 3; i++)
+    {
+        adV[i] = Quantize(kV[i]);
+    }
+}
+//----------------------------------------------------------------------------
+void SourceData::RandomRotation (double* adRotate, double* adQuaternion)
+{
+    double adAxis[3];
+    RandomUnit(adAxis);
+    Vector3d kAxis(adAxis);
+    kAxis.Normalize();
+    Quaterniond kQ(kAxis,Random(-Mathd::PI,Mathd::PI));
+    Matrix3d kRotate;
+    kQ.ToRotationMatrix(kRotate);
+
+    int i;
+    for (i = 0; i < 4; i++)
+    {
+        adQuaternion[i] = Quantize(kQ[i]);
+    }
+    for (i = 0; i < 9; i++)
+    {
+        adRotate[i] = Quantize(kRotate[i/3][i%3]);
+    }
+}
+//----------------------------------------------------------------------------
+// the inputs and the outputs of the operations for a type
+template <class Real>
+class MathData
+{
+public:
+    typedef typename MathTypes<Real>::Vector3T Vector3T;
+    typedef typename MathTypes<Real>::Matrix3T Matrix3T;
+    typedef typename MathTypes<Real>::Matrix4T Matrix4T;
+    typedef typename MathTypes<Real>::QuaternionT QuaternionT;
+    typedef typename MathTypes<Real>::Plane3T Plane3T;
+    typedef typename MathTypes<Real>::Ray3T Ray3T;
+    typedef typename MathTypes<Real>::Triangle3T Triangle3T;
+    typedef typename MathTypes<Real>::IntrRay3Triangle3T IntrRay3Triangle3T;
+    typedef typename MathTypes<Real>::TransformationT TransformationT;
+
+    MathData (const SourceData& rkSource);
+
+    // the outputs as doubles, returns the number of values
+    int GetVectors (double* adValue) const;
+    int GetScalars (double* adValue) const;
+    int GetMatrices3 (double* adValue) const;
+    int GetMatrices4 (double* adValue) const;
+    int GetQuaternions (double* adValue) const;
+    int GetTransformations (double* adValue) const;
+
+    Vector3T U[gs_iQuantity], V[gs_iQuantity];
+    Matrix3T Rotate[gs_iQuantity], Matrix[gs_iQuantity];
+    Matrix4T Matrix4[gs_iQuantity];
+    QuaternionT P[gs_iQuantity], Q[gs_iQuantity];
+    QuaternionT A[gs_iQuantity], B[gs_iQuantity];
+    Real Time[gs_iQuantity];
+    Plane3T Plane[gs_iQuantity];
+    TransformationT Transform[gs_iQuantity];
+    Ray3T Ray[gs_iQuantity];
+    Triangle3T Triangle[gs_iQuantity];
+
+    Vector3T OutVector[gs_iQuantity];
+    Real OutScalar[gs_iQuantity];
+    Matrix3T OutMatrix3[gs_iQuantity];
+    Matrix4T OutMatrix4[gs_iQuantity];
+    QuaternionT OutQuaternion[gs_iQuantity];
+    TransformationT OutTransform[gs_iQuantity];
+
+private:
+    static Vector3T ToVector (const double* adV);
+    static QuaternionT ToQuaternion (const double* adQ);
+    static void Store (const RSTransform<Real>& rkTransform,
+        double* adValue);
+    static void Store (const Transformation& rkTransform, double* adValue);
+};
+//----------------------------------------------------------------------------
+template <class Real>
+MathData<Real>::MathData (const SourceData& rkSource)
+{
+    int i, j;
+    for (i = 0; i < gs_iQuantity; i++)
+    {
+        U[i] = ToVector(rkSource.U[i]);
+        V[i] = ToVector(rkSource.V[i]);
+        for (j = 0; j < 9; j++)
+        {
+            Rotate[i][j/3][j%3] = ToReal<Real>(rkSource.Rotate[i][j]);
+            Matrix[i][j/3][j%3] = ToReal<Real>(rkSource.Matrix[i][j]);
+        }
+        for (j = 0; j < 16; j++)
+        {
+            Matrix4[i][j/4][j%4] = ToReal<Real>(rkSource.Matrix4[i][j]);
+        }
+        P[i] = ToQuaternion(rkSource.P[i]);
+        Q[i] = ToQuaternion(rkSource.Q[i]);
+        A[i] = ToQuaternion(rkSource.A[i]);
+        B[i] = ToQuaternion(rkSource.B[i]);
+        Time[i] = ToReal<Real>(rkSource.Time[i]);
+        Plane[i] = Plane3T(ToVector(rkSource.Plane[i]),
+            ToReal<Real>(rkSource.Plane[i][3]));
+        Transform[i].SetRotate(Rotate[i]);
+        Transform[i].SetUniformScale(ToReal<Real>(rkSource.Scale[i]));
+        Transform[i].SetTranslate(ToVector(rkSource.Translate[i]));
+        Ray[i] = Ray3T(ToVector(rkSource.Origin[i]),
+            ToVector(rkSource.Direction[i]));
+        Triangle[i] = Triangle3T(ToVector(&rkSource.Triangle[i][0]),
+            ToVector(&rkSource.Triangle[i][3]),
+            ToVector(&rkSource.Triangle[i][6]));
+    }
+}
+//----------------------------------------------------------------------------
+template <class Real>
+typename MathData<Real>::Vector3T MathData<Real>::ToVector (
+    const double* adV)
+{
+    return Vector3T(ToReal<Real>(adV[0]),ToReal<Real>(adV[1]),
+        ToReal<Real>(adV[2]));
+}
+//----------------------------------------------------------------------------
+template <class Real>
+typename MathData<Real>::QuaternionT MathData<Real>::ToQuaternion (
+    const double* adQ)
+{
+    return QuaternionT(ToReal<Real>(adQ[0]),ToReal<Real>(adQ[1]),
+        ToReal<Real>(adQ[2]),ToReal<Real>(adQ[3]));
+}
+//----------------------------------------------------------------------------
+template <class Real>
+int MathData<Real>::GetVectors (double* adValue) const
+{
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            *adValue++ = ToDouble<Real>(OutVector[i][j]);
+        }
+    }
+    return 3*gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+int MathData<Real>::GetScalars (double* adValue) const
+{
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        *adValue++ = ToDouble<Real>(OutScalar[i]);
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+int MathData<Real>::GetMatrices3 (double* adValue) const
+{
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        for (int j = 0; j < 9; j++)
+        {
+            *adValue++ = ToDouble<Real>(OutMatrix3[i][j/3][j%3]);
+        }
+    }
+    return 9*gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+int MathData<Real>::GetMatrices4 (double* adValue) const
+{
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        for (int j = 0; j < 16; j++)
+        {
+            *adValue++ = ToDouble<Real>(OutMatrix4[i][j/4][j%4]);
+        }
+    }
+    return 16*gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+int MathData<Real>::GetQuaternions (double* adValue) const
+{
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            *adValue++ = ToDouble<Real>(OutQuaternion[i][j]);
+        }
+    }
+    return 4*gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+int MathData<Real>::GetTransformations (double* adValue) const
+{
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        Store(OutTransform[i],adValue);
+        adValue += 12;
+    }
+    return 12*gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+void MathData<Real>::Store (const RSTransform<Real>& rkTransform,
+    double* adValue)
+{
+    // the matrix M = R*S and the translation
+    Real fScale = (rkTransform.IsRSMatrix() ?
+        rkTransform.GetUniformScale() : (Real)1.0);
+    for (int j = 0; j < 9; j++)
+    {
+        adValue[j] = ToDouble<Real>(rkTransform.GetMatrix()[j/3][j%3]*fScale);
+    }
+    for (int j = 0; j < 3; j++)
+    {
+        adValue[9+j] = ToDouble<Real>(rkTransform.GetTranslate()[j]);
+    }
+}
+//----------------------------------------------------------------------------
+template <class Real>
+void MathData<Real>::Store (const Transformation& rkTransform,
+    double* adValue)
+{
+    // the matrix M = R*S and the translation
+    for (int j = 0; j < 9; j++)
+    {
+        double dEntry = ToDouble<fixed>(rkTransform.GetMatrix()[j/3][j%3]);
+        if (rkTransform.IsRSMatrix())
+        {
+            dEntry *= ToDouble<fixed>(rkTransform.GetScale()[j%3]);
+        }
+        adValue[j] = dEntry;
+    }
+    for (int j = 0; j < 3; j++)
+    {
+        adValue[9+j] = ToDouble<fixed>(rkTransform.GetTranslate()[j]);
+    }
+}
+//----------------------------------------------------------------------------
+// The operations.  Each runs on all the inputs and returns their number.
+template <class Real>
+static int Normalize (void* pvData)
+{
+    MathData<Real>& rkData = *(MathData<Real>*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.OutVector[i] = rkData.V[i];
+        rkData.OutVector[i].Normalize();
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+static int Cross (void* pvData)
+{
+    MathData<Real>& rkData = *(MathData<Real>*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.OutVector[i] = rkData.U[i].Cross(rkData.V[i]);
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+static int Dot (void* pvData)
+{
+    MathData<Real>& rkData = *(MathData<Real>*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.OutScalar[i] = rkData.U[i].Dot(rkData.V[i]);
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+static int Multiply3 (void* pvData)
+{
+    MathData<Real>& rkData = *(MathData<Real>*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.OutMatrix3[i] = rkData.Rotate[i]*rkData.Matrix[i];
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+static int Inverse3 (void* pvData)
+{
+    MathData<Real>& rkData = *(MathData<Real>*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.OutMatrix3[i] = rkData.Matrix[i].Inverse();
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+static int Orthonormalize (void* pvData)
+{
+    MathData<Real>& rkData = *(MathData<Real>*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.OutMatrix3[i] = rkData.Matrix[i];
+        rkData.OutMatrix3[i].Orthonormalize();
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+static int Multiply4 (void* pvData)
+{
+    MathData<Real>& rkData = *(MathData<Real>*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.OutMatrix4[i] = rkData.Matrix4[i] *
+            rkData.Matrix4[gs_iQuantity-1-i];
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+static int Slerp (void* pvData)
+{
+    MathData<Real>& rkData = *(MathData<Real>*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.OutQuaternion[i].Slerp(rkData.Time[i],rkData.P[i],
+            rkData.Q[i]);
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+static int Squad (void* pvData)
+{
+    MathData<Real>& rkData = *(MathData<Real>*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.OutQuaternion[i].Squad(rkData.Time[i],rkData.P[i],
+            rkData.A[i],rkData.B[i],rkData.Q[i]);
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+static int FromRotationMatrix (void* pvData)
+{
+    MathData<Real>& rkData = *(MathData<Real>*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.OutQuaternion[i].FromRotationMatrix(rkData.Rotate[i]);
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+static int Product (void* pvData)
+{
+    MathData<Real>& rkData = *(MathData<Real>*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.OutTransform[i].Product(rkData.Transform[i],
+            rkData.Transform[gs_iQuantity-1-i]);
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+static int ApplyForward (void* pvData)
+{
+    MathData<Real>& rkData = *(MathData<Real>*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.OutVector[i] = rkData.Transform[i].ApplyForward(rkData.V[i]);
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+static int InverseTransform (void* pvData)
+{
+    MathData<Real>& rkData = *(MathData<Real>*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.Transform[i].Inverse(rkData.OutTransform[i]);
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+static int DistanceTo (void* pvData)
+{
+    MathData<Real>& rkData = *(MathData<Real>*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.OutScalar[i] = rkData.Plane[i].DistanceTo(rkData.V[i]);
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class Real>
+static int FindRayTriangle (void* pvData)
+{
+    typedef typename MathData<Real>::IntrRay3Triangle3T IntrRay3Triangle3T;
+    MathData<Real>& rkData = *(MathData<Real>*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        // a missed intersection has the parameter -1
+        IntrRay3Triangle3T kIntr(rkData.Ray[i],rkData.Triangle[i]);
+        rkData.OutScalar[i] = (kIntr.Find() ? kIntr.GetRayT() :
+            ToReal<Real>(-1.0));
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+enum
+{
+    OUT_VECTOR,
+    OUT_SCALAR,
+    OUT_MATRIX3,
+    OUT_MATRIX4,
+    OUT_QUATERNION,
+    OUT_TRANSFORMATION
+};
+//----------------------------------------------------------------------------
+class Operation
+{
+public:
+    const char* Name;
+    Bench::Function Engine, Float, Double;
+    int Output;
+};
+
+#define WG_MATH_OPERATION(name,function,output) \
+    { name, &function<fixed>, &function<float>, &function<double>, output }
+
+static const Operation gs_akOperation[] =
+{
+    WG_MATH_OPERATION("Vector3::Normalize",Normalize,OUT_VECTOR),
+    WG_MATH_OPERATION("Vector3::Cross",Cross,OUT_VECTOR),
+    WG_MATH_OPERATION("Vector3::Dot",Dot,OUT_SCALAR),
+    WG_MATH_OPERATION("Matrix3::operator*",Multiply3,OUT_MATRIX3),
+    WG_MATH_OPERATION("Matrix3::Inverse",Inverse3,OUT_MATRIX3),
+    WG_MATH_OPERATION("Matrix3::Orthonormalize",Orthonormalize,OUT_MATRIX3),
+    WG_MATH_OPERATION("Matrix4::operator*",Multiply4,OUT_MATRIX4),
+    WG_MATH_OPERATION("Quaternion::Slerp",Slerp,OUT_QUATERNION),
+    WG_MATH_OPERATION("Quaternion::Squad",Squad,OUT_QUATERNION),
+    WG_MATH_OPERATION("Quaternion::FromRotationMatrix",FromRotationMatrix,
+        OUT_QUATERNION),
+    WG_MATH_OPERATION("Transformation::Product",Product,OUT_TRANSFORMATION),
+    WG_MATH_OPERATION("Transformation::ApplyForward",ApplyForward,
+        OUT_VECTOR),
+    WG_MATH_OPERATION("Transformation::Inverse",InverseTransform,
+        OUT_TRANSFORMATION),
+    WG_MATH_OPERATION("Plane3::DistanceTo",DistanceTo,OUT_SCALAR),
+    WG_MATH_OPERATION("IntrRay3Triangle3::Find",FindRayTriangle,OUT_SCALAR)
+};
+
+static const int gs_iOperationQuantity =
+    (int)(sizeof(gs_akOperation)/sizeof(gs_akOperation[0]));
+//----------------------------------------------------------------------------
+template <class Real>
+static int GetOutput (const MathData<Real>& rkData, int eOutput,
+    double* adValue)
+{
+    switch (eOutput)
+    {
+    case OUT_VECTOR:
+        return rkData.GetVectors(adValue);
+    case OUT_SCALAR:
+        return rkData.GetScalars(adValue);
+    case OUT_MATRIX3:
+        return rkData.GetMatrices3(adValue);
+    case OUT_MATRIX4:
+        return rkData.GetMatrices4(adValue);
+    case OUT_QUATERNION:
+        return rkData.GetQuaternions(adValue);
+    case OUT_TRANSFORMATION:
+        return rkData.GetTransformations(adValue);
+    }
+    assert(false);
+    return 0;
+}
+//----------------------------------------------------------------------------
+// the largest absolute difference of the output of a type from the double
+// output
+template <class Real>
+static double GetError (const Operation& rkOperation,
+    Bench::Function oFunction, MathData<Real>& rkData,
+    const double* adReference, double* adValue)
+{
+    oFunction(&rkData);
+    int iQuantity = GetOutput(rkData,rkOperation.Output,adValue);
+    double dError = 0.0;
+    for (int i = 0; i < iQuantity; i++)
+    {
+        double dDiff = fabs(adValue[i] - adReference[i]);
+        if (dDiff > dError)
+        {
+            dError = dDiff;
+        }
+    }
+    return dError;
+}
+#if WG_REAL == WG_REAL_FIXED
+//----------------------------------------------------------------------------
+// The transcendental functions of WgFixedMath.h, the table of its header.
+enum
+{
+    F_SIN,
+    F_COS,
+    F_ATAN,
+    F_ATAN2,
+    F_ASIN,
+    F_ACOS,
+    F_EXP,
+    F_LOG,
+    F_XSQRT,
+    F_INVSQRT,
+    F_INVERSE
+};
+
+// the inputs of a sweep of a domain and the inputs that are timed
+static const int gs_iSweepQuantity = 1 << 20;
+static unsigned int gs_uiRandom = 1;
+
+class TranscendentalData
+{
+public:
+    fixed X[gs_iQuantity], Y[gs_iQuantity];
+    fixed Output[gs_iQuantity];
+};
+//----------------------------------------------------------------------------
+static int RandomRaw (int iMin, int iMax)
+{
+    // A uniform value in [iMin,iMax] from all 32 bits of a linear
+    // congruential generator.  The rand of some libraries has 15 bits.
+    gs_uiRandom = 1664525u*gs_uiRandom + 1013904223u;
+    unsigned __int64 ullRange =
+        (unsigned __int64)((unsigned int)iMax - (unsigned int)iMin) + 1;
+    return (int)((unsigned int)iMin +
+        (unsigned int)((ullRange*gs_uiRandom) >> 32));
+}
+//----------------------------------------------------------------------------
+inline fixed Evaluate (int eFunction, fixed fX, fixed fY,
+    FixedPrecision ePrecision)
+{
+    switch (eFunction)
+    {
+    case F_SIN:
+        return sinx(fX,ePrecision);
+    case F_COS:
+        return cosx(fX,ePrecision);
+    case F_ATAN:
+        return atanx(fX,ePrecision);
+    case F_ATAN2:
+        return atan2x(fY,fX,ePrecision);
+    case F_ASIN:
+        return asinx(fX,ePrecision);
+    case F_ACOS:
+        return acosx(fX,ePrecision);
+    case F_EXP:
+        return expx(fX,ePrecision);
+    case F_LOG:
+        return logx(fX,ePrecision);
+    case F_XSQRT:
+        return xsqrt(fX,ePrecision);
+    case F_INVSQRT:
+        return InvSqrt(fX,ePrecision);
+    case F_INVERSE:
+        return Inverse(fX,ePrecision);
+    }
+    assert(false);
+    return fixed(FIXED_ZERO);
+}
+//----------------------------------------------------------------------------
+static double Reference (int eFunction, double dX, double dY)
+{
+    switch (eFunction)
+    {
+    case F_SIN:
+        return sin(dX);
+    case F_COS:
+        return cos(dX);
+    case F_ATAN:
+        return atan(dX);
+    case F_ATAN2:
+        return atan2(dY,dX);
+    case F_ASIN:
+        return asin(dX);
+    case F_ACOS:
+        return acos(dX);
+    case F_EXP:
+        return exp(dX);
+    case F_LOG:
+        return log(dX);
+    case F_XSQRT:
+        return sqrt(dX);
+    case F_INVSQRT:
+        return 1.0/sqrt(dX);
+    case F_INVERSE:
+        return 1.0/dX;
+    }
+    assert(false);
+    return 0.0;
+}
+//----------------------------------------------------------------------------
+template <int eFunction, FixedPrecision ePrecision>
+static int EvaluateAll (void* pvData)
+{
+    TranscendentalData& rkData = *(TranscendentalData*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.Output[i] = Evaluate(eFunction,rkData.X[i],rkData.Y[i],
+            ePrecision);
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+// A function on a domain of 16.16 values, [Min,Max] and [-Max,-Min] when
+// the domain is symmetric.  The error is relative to the result when the
+// result is above 1 and Relative is set.
+class Transcendental
+{
+public:
+    const char* Name;
+    const char* Domain;
+    int Function;
+    int Min, Max;
+    bool Symmetric, Relative;
+    Bench::Function Tier[3];
+};
+
+#define WG_TRANSCENDENTAL(name,domain,function,min,max,symmetric,relative) \
+    { name, domain, function, min, max, symmetric, relative, \
+    { &EvaluateAll<function,FIXED_FAST>, \
+      &EvaluateAll<function,FIXED_NORMAL>, \
+      &EvaluateAll<function,FIXED_ACCURATE> } }
+
+static const Transcendental gs_akTranscendental[] =
+{
+    WG_TRANSCENDENTAL("sinx","|x|<=8",F_SIN,0,0x80000,true,false),
+    WG_TRANSCENDENTAL("sinx","|x|>8",F_SIN,0x80001,0x7fffffff,true,false),
+    WG_TRANSCENDENTAL("cosx","|x|<=8",F_COS,0,0x80000,true,false),
+    WG_TRANSCENDENTAL("cosx","|x|>8",F_COS,0x80001,0x7fffffff,true,false),
+    WG_TRANSCENDENTAL("atanx","all",F_ATAN,0,0x7fffffff,true,false),
+    WG_TRANSCENDENTAL("atan2x","all",F_ATAN2,0,0x7fffffff,true,false),
+    WG_TRANSCENDENTAL("asinx","|x|<=0.99",F_ASIN,0,FIXED_CONST(0.99),true,
+        false),
+    WG_TRANSCENDENTAL("asinx","0.99<|x|<=1",F_ASIN,FIXED_CONST(0.99)+1,
+        FIXED_ONE,true,false),
+    WG_TRANSCENDENTAL("acosx","|x|<=0.99",F_ACOS,0,FIXED_CONST(0.99),true,
+        false),
+    WG_TRANSCENDENTAL("acosx","0.99<|x|<=1",F_ACOS,FIXED_CONST(0.99)+1,
+        FIXED_ONE,true,false),
+    WG_TRANSCENDENTAL("expx","-12<=x<=10.39",F_EXP,FIXED_CONST(-12.0),
+        FIXED_CONST(10.39),false,true),
+    WG_TRANSCENDENTAL("logx","x>0",F_LOG,1,0x7fffffff,false,false),
+    WG_TRANSCENDENTAL("xsqrt","x>0",F_XSQRT,1,0x7fffffff,false,true),
+    WG_TRANSCENDENTAL("InvSqrt","x>0",F_INVSQRT,1,0x7fffffff,false,true),
+    WG_TRANSCENDENTAL("Inverse","x>=3/65536",F_INVERSE,3,0x7fffffff,false,
+        true)
+};
+
+static const int gs_iTranscendentalQuantity =
+    (int)(sizeof(gs_akTranscendental)/sizeof(gs_akTranscendental[0]));
+static const char* gs_aacTier[3] = { "fast", "normal", "accurate" };
+//----------------------------------------------------------------------------
+static double GetUlp (const Transcendental& rkRow, fixed fX, fixed fY,
+    FixedPrecision ePrecision)
+{
+    // the error of one input in 16.16 ulp
+    double dReference = Reference(rkRow.Function,fX.value/65536.0,
+        fY.value/65536.0);
+    fixed fValue = Evaluate(rkRow.Function,fX,fY,ePrecision);
+    double dUlp = fabs(fValue.value - 65536.0*dReference);
+    if (rkRow.Relative && fabs(dReference) > 1.0)
+    {
+        dUlp /= fabs(dReference);
+    }
+    return dUlp;
+}
+//----------------------------------------------------------------------------
+static double GetMaxUlp (const Transcendental& rkRow,
+    FixedPrecision ePrecision)
+{
+    // The largest error over the domain.  A domain of at most
+    // gs_iSweepQuantity values is swept completely.  Of a larger one the
+    // first half of the sweep takes the consecutive values from Min, where
+    // the functions of small inputs are hardest, and the second half
+    // evenly spaced values up to Max.  atan2x gets random pairs.
+    double dMax = 0.0;
+    int i;
+    if (rkRow.Function == F_ATAN2)
+    {
+        gs_uiRandom = 1;
+        for (i = 0; i < gs_iSweepQuantity; i++)
+        {
+            fixed fX(RandomRaw(-rkRow.Max,rkRow.Max));
+            fixed fY(RandomRaw(-rkRow.Max,rkRow.Max));
+            double dUlp = GetUlp(rkRow,fX,fY,ePrecision);
+            if (dUlp > dMax)
+            {
+                dMax = dUlp;
+            }
+        }
+        return dMax;
+    }
+
+    dfixed llRange = (dfixed)rkRow.Max - (dfixed)rkRow.Min;
+    bool bComplete = (llRange < gs_iSweepQuantity);
+    int iQuantity = (bComplete ? (int)llRange + 1 : gs_iSweepQuantity);
+    int iHalf = gs_iSweepQuantity/2;
+    for (i = 0; i < iQuantity; i++)
+    {
+        int iRaw = rkRow.Min + i;
+        if (!bComplete && i > iHalf)
+        {
+            iRaw = (int)(rkRow.Min + iHalf + (llRange - iHalf)*(i - iHalf)/
+                (iQuantity - 1 - iHalf));
+        }
+        for (int iSign = 0; iSign < (rkRow.Symmetric ? 2 : 1); iSign++)
+        {
+            fixed fX(iSign == 0 ? iRaw : -iRaw);
+            double dUlp = GetUlp(rkRow,fX,fixed(FIXED_ZERO),ePrecision);
+            if (dUlp > dMax)
+            {
+                dMax = dUlp;
+            }
+        }
+    }
+    return dMax;
+}
+//----------------------------------------------------------------------------
+static void RunTranscendentals (Bench& rkBench)
+{
+    // The rows of the table in WgFixedMath.h, the largest error in 16.16
+    // ulp and the time in ns/call of each tier.
+    TranscendentalData* pkData = WG_NEW TranscendentalData;
+    double aadUlp[gs_iTranscendentalQuantity][3];
+    double aadTime[gs_iTranscendentalQuantity][3];
+    char acName[Bench::MAX_NAME];
+
+    int i, j;
+    for (i = 0; i < gs_iTranscendentalQuantity; i++)
+    {
+        const Transcendental& rkRow = gs_akTranscendental[i];
+        System::Sprintf(acName,Bench::MAX_NAME,"%s %s",rkRow.Name,
+            rkRow.Domain);
+
+        gs_uiRandom = 1;
+        for (j = 0; j < gs_iQuantity; j++)
+        {
+            int iRaw = RandomRaw(rkRow.Min,rkRow.Max);
+            if (rkRow.Symmetric && (j & 1))
+            {
+                iRaw = -iRaw;
+            }
+            pkData->X[j] = fixed(iRaw);
+            pkData->Y[j] = fixed(RandomRaw(-rkRow.Max,rkRow.Max));
+        }
+
+        for (j = 0; j < 3; j++)
+        {
+            aadUlp[i][j] = -1.0;
+            aadTime[i][j] = -1.0;
+            if (!rkBench.IsSelected(acName,gs_aacTier[j]))
+            {
+                continue;
+            }
+
+            aadUlp[i][j] = GetMaxUlp(rkRow,(FixedPrecision)j);
+            const Bench::Result* pkResult = rkBench.Run(acName,
+                gs_aacTier[j],rkRow.Tier[j],pkData,aadUlp[i][j]);
+            aadTime[i][j] = 1e9*pkResult->MedianTime/pkResult->Items;
+        }
+    }
+
+    printf("\n%-24s %8s %8s %8s %8s %8s %8s\n","ulp and ns/call","fast",
+        "normal","accurate","fast","normal","accurate");
+    for (i = 0; i < gs_iTranscendentalQuantity; i++)
+    {
+        if (aadUlp[i][0] < 0.0 && aadUlp[i][1] < 0.0 && aadUlp[i][2] < 0.0)
+        {
+            continue;
+        }
+
+        System::Sprintf(acName,Bench::MAX_NAME,"%s %s",
+            gs_akTranscendental[i].Name,gs_akTranscendental[i].Domain);
+        printf("%-24s",acName);
+        for (j = 0; j < 6; j++)
+        {
+            double dValue = (j < 3 ? aadUlp[i][j] : aadTime[i][j-3]);
+            if (dValue >= 0.0)
+            {
+                printf(" %8.2f",dValue);
+            }
+            else
+            {
+                printf(" %8s","-");
+            }
+        }
+        printf("\n");
+    }
+
+    WG_DELETE pkData;
+}
+//----------------------------------------------------------------------------
+// The product and the quotient of two fixed values, the kernels of every
+// operation above.  The rows are the kernels of fixed (group "saturate"),
+// the same 64-bit arithmetic without the saturation (group "wrap") and the
+// round trip through float that the operators used before (group "float").
+enum
+{
+    S_MUL,
+    S_DIV
+};
+
+enum
+{
+    S_SATURATE,
+    S_WRAP,
+    S_FLOAT
+};
+
+static const char* gs_aacScalar[3] = { "saturate", "wrap", "float" };
+//----------------------------------------------------------------------------
+template <int eOperation, int eVariant>
+inline int EvaluateScalar (int iA, int iB)
+{
+    if (eVariant == S_SATURATE)
+    {
+        return (eOperation == S_MUL ? fixed::Mul(iA,iB) : fixed::Div(iA,iB));
+    }
+    if (eVariant == S_WRAP)
+    {
+        return (eOperation == S_MUL ?
+            (int)(((dfixed)iA*(dfixed)iB) >> FIXED_PRECISION) :
+            (int)((((dfixed)iA) << FIXED_PRECISION)/(dfixed)iB));
+    }
+    float fA = FloatFromFixed(iA), fB = FloatFromFixed(iB);
+    return FixedFromFloat(eOperation == S_MUL ? fA*fB : fA/fB);
+}
+//----------------------------------------------------------------------------
+template <int eOperation, int eVariant>
+static int ScalarAll (void* pvData)
+{
+    TranscendentalData& rkData = *(TranscendentalData*)pvData;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        rkData.Output[i].value = EvaluateScalar<eOperation,eVariant>(
+            rkData.X[i].value,rkData.Y[i].value);
+    }
+    return gs_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <int eOperation, int eVariant>
+static double GetScalarUlp (const TranscendentalData& rkData)
+{
+    // the largest difference in 16.16 ulp from the exact result
+    double dMax = 0.0;
+    for (int i = 0; i < gs_iQuantity; i++)
+    {
+        double dA = (double)rkData.X[i].value/65536.0;
+        double dB = (double)rkData.Y[i].value/65536.0;
+        double dExact = (eOperation == S_MUL ? dA*dB : dA/dB);
+        double dValue = (double)EvaluateScalar<eOperation,eVariant>(
+            rkData.X[i].value,rkData.Y[i].value)/65536.0;
+        double dUlp = fabs(dValue - dExact)*65536.0;
+        if (dUlp > dMax)
+        {
+            dMax = dUlp;
+        }
+    }
+    return dMax;
+}
+//----------------------------------------------------------------------------
+static int CheckSaturation ()
+{
+    // The results of fixed on overflow, a division by zero and the
+    // conversion of a negative int.  Returns the number of failed checks.
+    const int iMax = 0x7fffffff, iMin = (int)0x80000000;
+    fixed fBig = fixed(FixedFromInt(182));
+    fixed fHalf = fixed(FIXED_HALF);
+    fixed fMax = fixed(iMax), fMin = fixed(iMin);
+    fixed fZero = fixed(FIXED_ZERO);
+
+    struct Check
+    {
+        const char* Name;
+        int Value, Expected;
+    };
+    const Check akCheck[] =
+    {
+        { "182*182", (fBig*fBig).value, iMax },
+        { "-182*182", ((-fBig)*fBig).value, iMin },
+        { "-182*-182", ((-fBig)*(-fBig)).value, iMax },
+        { "max*0.5", (fMax*fHalf).value, iMax/2 },
+        { "max/0.5", (fMax/fHalf).value, iMax },
+        { "min/0.5", (fMin/fHalf).value, iMin },
+        { "182/0", (fBig/fZero).value, iMax },
+        { "-182/0", ((-fBig)/fZero).value, iMin },
+        { "FromInt(-3)", fixed::FromInt(-3).value, -3*65536 },
+        { "FixedFromInt(-3)", FixedFromInt(-3), -3*65536 }
+    };
+    const int iQuantity = (int)(sizeof(akCheck)/sizeof(akCheck[0]));
+
+    int iFailed = 0;
+    for (int i = 0; i < iQuantity; i++)
+    {
+        if (akCheck[i].Value != akCheck[i].Expected)
+        {
+            printf("saturation check %s failed: %d, expected %d\n",
+                akCheck[i].Name,akCheck[i].Value,akCheck[i].Expected);
+            iFailed++;
+        }
+    }
+    return iFailed;
+}
+//----------------------------------------------------------------------------
+static int RunScalars (Bench& rkBench)
+{
+    // The inputs are in (-181,181) and the divisors are at least 1 away
+    // from zero, no result overflows.  The error of a row is its largest
+    // error in 16.16 ulp, the saturating rows also add the number of
+    // failed saturation checks.  Returns that number.
+    TranscendentalData* pkData = WG_NEW TranscendentalData;
+    gs_uiRandom = 1;
+    int i;
+    for (i = 0; i < gs_iQuantity; i++)
+    {
+        int iSign = ((i & 1) ? -1 : 1);
+        pkData->X[i] = fixed(RandomRaw(-0xb50000,0xb50000));
+        pkData->Y[i] = fixed(iSign*RandomRaw(0x10000,0xb50000));
+    }
+    int iFailed = CheckSaturation();
+    printf("\n%d saturation checks failed\n",iFailed);
+
+    static const Bench::Function s_aaoFunction[2][3] =
+    {
+        { &ScalarAll<S_MUL,S_SATURATE>, &ScalarAll<S_MUL,S_WRAP>,
+          &ScalarAll<S_MUL,S_FLOAT> },
+        { &ScalarAll<S_DIV,S_SATURATE>, &ScalarAll<S_DIV,S_WRAP>,
+          &ScalarAll<S_DIV,S_FLOAT> }
+    };
+    const double aadUlp[2][3] =
+    {
+        { GetScalarUlp<S_MUL,S_SATURATE>(*pkData),
+          GetScalarUlp<S_MUL,S_WRAP>(*pkData),
+          GetScalarUlp<S_MUL,S_FLOAT>(*pkData) },
+        { GetScalarUlp<S_DIV,S_SATURATE>(*pkData),
+          GetScalarUlp<S_DIV,S_WRAP>(*pkData),
+          GetScalarUlp<S_DIV,S_FLOAT>(*pkData) }
+    };
+    static const char* s_aacName[2] = { "fixed*fixed", "fixed/fixed" };
+
+    for (i = 0; i < 2; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            double dError = aadUlp[i][j] + (j == S_SATURATE ? iFailed : 0);
+            rkBench.Run(s_aacName[i],gs_aacScalar[j],s_aaoFunction[i][j],
+                pkData,dError);
+        }
+    }
+
+    WG_DELETE pkData;
+    return iFailed;
+}
+#endif
+//----------------------------------------------------------------------------
+int main (int iArgs, char** aacArg)
+{
+    Bench kBench("math");
+    if (!kBench.ParseArguments(iArgs,aacArg))
+    {
+        printf("usage: WgMathBench [-json file] [-csv file] [-filter text] "
+            "[-samples n] [-time ms]\n");
+        return 1;
+    }
+    printf("math benchmarks, %s backend, %d inputs\n",Bench::GetBackend(),
+        gs_iQuantity);
+
+    // the data is large, it is not on the stack
+    SourceData* pkSource = WG_NEW SourceData;
+    MathData<fixed>* pkEngine = WG_NEW MathData<fixed>(*pkSource);
+    MathData<float>* pkFloat = WG_NEW MathData<float>(*pkSource);
+    MathData<double>* pkDouble = WG_NEW MathData<double>(*pkSource);
+    double* adReference = WG_NEW double[16*gs_iQuantity];
+    double* adValue = WG_NEW double[16*gs_iQuantity];
+
+    // the median times in ns/op and the errors of the summary, negative
+    // when an operation was filtered out
+    double aadTime[gs_iOperationQuantity][3];
+    double aadError[gs_iOperationQuantity][2];
+
+    int i, j;
+    for (i = 0; i < gs_iOperationQuantity; i++)
+    {
+        const Operation& rkOperation = gs_akOperation[i];
+        for (j = 0; j < 3; j++)
+        {
+            aadTime[i][j] = -1.0;
+        }
+        if (!kBench.IsSelected(rkOperation.Name,gs_acEngine)
+        &&  !kBench.IsSelected(rkOperation.Name,"float")
+        &&  !kBench.IsSelected(rkOperation.Name,"double"))
+        {
+            continue;
+        }
+
+        rkOperation.Double(pkDouble);
+        GetOutput(*pkDouble,rkOperation.Output,adReference);
+        aadError[i][0] = GetError(rkOperation,rkOperation.Engine,*pkEngine,
+            adReference,adValue);
+        aadError[i][1] = GetError(rkOperation,rkOperation.Float,*pkFloat,
+            adReference,adValue);
+
+        const Bench::Result* pkResult = kBench.Run(rkOperation.Name,
+            gs_acEngine,rkOperation.Engine,pkEngine,aadError[i][0]);
+        if (pkResult)
+        {
+            aadTime[i][0] = 1e9*pkResult->MedianTime/pkResult->Items;
+        }
+        pkResult = kBench.Run(rkOperation.Name,"float",rkOperation.Float,
+            pkFloat,aadError[i][1]);
+        if (pkResult)
+        {
+            aadTime[i][1] = 1e9*pkResult->MedianTime/pkResult->Items;
+        }
+        pkResult = kBench.Run(rkOperation.Name,"double",rkOperation.Double,
+            pkDouble);
+        if (pkResult)
+        {
+            aadTime[i][2] = 1e9*pkResult->MedianTime/pkResult->Items;
+        }
+    }
+
+    printf("\n%-30s %10s %10s %10s %11s %11s\n","ns/op and error",
+        gs_acEngine,"float","double",gs_acEngine,"float");
+    int iSlower = 0;
+    for (i = 0; i < gs_iOperationQuantity; i++)
+    {
+        if (aadTime[i][0] < 0.0 && aadTime[i][1] < 0.0
+        &&  aadTime[i][2] < 0.0)
+        {
+            continue;
+        }
+
+        printf("%-30s",gs_akOperation[i].Name);
+        for (j = 0; j < 3; j++)
+        {
+            if (aadTime[i][j] >= 0.0)
+            {
+                printf(" %10.1f",aadTime[i][j]);
+            }
+            else
+            {
+                printf(" %10s","-");
+            }
+        }
+        printf(" %11.3g %11.3g",aadError[i][0],aadError[i][1]);
+        if (aadTime[i][0] >= 0.0 && aadTime[i][1] >= 0.0
+        &&  aadTime[i][0] > aadTime[i][1])
+        {
+            printf("  %s slower than float",gs_acEngine);
+            iSlower++;
+        }
+        printf("\n");
+    }
+    printf("%d operations where %s is slower than float\n",iSlower,
+        gs_acEngine);
+
+    int iFailed = 0;
+#if WG_REAL == WG_REAL_FIXED
+    RunTranscendentals(kBench);
+    iFailed = RunScalars(kBench);
+#endif
+
+    WG_DELETE[] adValue;
+    WG_DELETE[] adReference;
+    WG_DELETE pkDouble;
+    WG_DELETE pkFloat;
+    WG_DELETE pkEngine;
+    WG_DELETE pkSource;
+    return (kBench.Write() && iFailed == 0 ? 0 : 1);
+}
+//----------------------------------------------------------------------------
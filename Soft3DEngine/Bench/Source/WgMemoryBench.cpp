@@ -0,0 +1,754 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgMemoryBench.cpp                  //
+//                                                       //
+//  - Memory manager benchmarks                          //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+// The benchmarks of the memory manager of WG_MEMORY_MANAGER:
+//
+//   WgMemoryBench [-json file] [-csv file] [-filter text] [-samples n]
+//       [-time ms] [-scale percent] [-fragment churn|city]
+//
+// Every benchmark runs with the pools of the manager (the suffix "-pool")
+// and with blocks of the system heap (the suffix "-heap", see
+// Memory::SetPooling).  A build without WG_MEMORY_MANAGER runs only the
+// heap benchmarks, with the operators of the compiler; in a build with it
+// every block of the heap has the header of the manager too.
+//   Objects   allocate 1024 list nodes and 1024 sphere bounds and free them
+//             in the order of their allocation (the items are the blocks)
+//   Churn     replace random blocks of 4096 live blocks of random sizes, as
+//             many small blocks as large ones of the scene graph (the items
+//             are the blocks)
+//   Append    append 4096 ints, vectors or smart pointers to an array
+//             that starts with room for one (the items are the elements)
+//   Attach    attach the children of the fan-out one at a time to a node
+//             built without their number (the items are the children)
+//   Effects   create 1024 effects with two texture coordinate arrays
+//   Register  create and release 10000, 100000 and 1000000 objects, which
+//             register in Object::InUse (the items are the objects)
+//   Lookup    find each of them in Object::InUse by its ID
+//   Build     build a scene, update it and destroy it (the items are the
+//             objects of the scene)
+//   UpdateRS  the render state update, which allocates its stacks
+//   DoPick    the picking of 64 rays through the view, with the records
+//             (the items are the rays)
+// UpdateRS and DoPick run again with a frame arena (the suffix "-arena",
+// see FrameArena::SetFrame), which is reset after every call.  UpdateRS
+// runs last on a city of about 20000 objects, whose blocks have global
+// states and whose root has a light (the items are the objects).
+//
+// The manager build first measures the fragmentation:  the bytes taken from
+// the system (the pages and the large blocks of the manager, the arena of
+// the C library for the heap, known on glibc only) against the bytes that
+// the live blocks requested, after a churn of 65536 blocks or for a city
+// (-fragment, the default is churn).  It then prints the allocations per
+// size class of a frame of each scene (UpdateGS, UpdateRS, DrawScene and
+// DoPick), without and with a frame arena.
+//
+// -scale scales the size parameters of the scenes (default 100).
+
+#include "WgBench.h"
+#include "WgBenchScenes.h"
+#include "WgNullRenderer.h"
+#include <cstdio>
+#include <cstring>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+using namespace WGSoft3D;
+
+#ifdef WG_MEMORY_MANAGER
+static const int gs_iModes = 2;
+#else
+static const int gs_iModes = 1;
+#endif
+static const char* gs_aacMode[2] = { "heap", "pool" };
+static FrameArena* gs_pkArena = 0;
+
+//----------------------------------------------------------------------------
+static void SetMode (int iMode)
+{
+#ifdef WG_MEMORY_MANAGER
+    Memory::SetPooling(iMode == 1);
+#else
+    (void)iMode;
+#endif
+}
+//----------------------------------------------------------------------------
+// a random number generator that is the same on every platform
+static unsigned int Random (unsigned int& ruiSeed)
+{
+    ruiSeed = ruiSeed*1664525 + 1013904223;
+    return ruiSeed >> 8;
+}
+//----------------------------------------------------------------------------
+// The sizes of the blocks of the scene graph:  half are below 64 bytes
+// (list nodes, bounds, strings), most others below 512 bytes (objects,
+// pick records), and one in 32 is the data of an array.
+static int RandomSize (unsigned int& ruiSeed)
+{
+    unsigned int uiRandom = Random(ruiSeed);
+    unsigned int uiKind = uiRandom & 31;
+    uiRandom >>= 5;
+    if (uiKind < 16)
+    {
+        return 8 + (int)(uiRandom % 56);
+    }
+    if (uiKind < 31)
+    {
+        return 64 + (int)(uiRandom % 448);
+    }
+    return 512 + (int)(uiRandom % 7680);
+}
+//----------------------------------------------------------------------------
+// allocation patterns
+//----------------------------------------------------------------------------
+class ObjectData
+{
+public:
+    enum
+    {
+        QUANTITY = 1024
+    };
+
+    TList<int>* Nodes[QUANTITY];
+    BoundingVolume* Bounds[QUANTITY];
+};
+//----------------------------------------------------------------------------
+static int Objects (void* pvData)
+{
+    ObjectData* pkData = (ObjectData*)pvData;
+    int i;
+    for (i = 0; i < ObjectData::QUANTITY; i++)
+    {
+        pkData->Nodes[i] = WG_NEW TList<int>(i,0);
+        pkData->Bounds[i] = BoundingVolume::Create();
+    }
+    for (i = 0; i < ObjectData::QUANTITY; i++)
+    {
+        WG_DELETE pkData->Nodes[i];
+        WG_DELETE pkData->Bounds[i];
+    }
+    return 2*ObjectData::QUANTITY;
+}
+//----------------------------------------------------------------------------
+class ChurnData
+{
+public:
+    ChurnData (int iQuantity)
+    {
+        Quantity = iQuantity;
+        Block = WG_NEW char*[iQuantity];
+        Size = WG_NEW int[iQuantity];
+        Seed = 1;
+        Bytes = 0;
+        for (int i = 0; i < Quantity; i++)
+        {
+            Size[i] = RandomSize(Seed);
+            Block[i] = WG_NEW char[Size[i]];
+            Bytes += Size[i];
+        }
+    }
+
+    ~ChurnData ()
+    {
+        for (int i = 0; i < Quantity; i++)
+        {
+            WG_DELETE[] Block[i];
+        }
+        WG_DELETE[] Block;
+        WG_DELETE[] Size;
+    }
+
+    void Replace (int iQuantity)
+    {
+        for (int i = 0; i < iQuantity; i++)
+        {
+            int j = (int)(Random(Seed) % (unsigned int)Quantity);
+            WG_DELETE[] Block[j];
+            Bytes -= Size[j];
+            Size[j] = RandomSize(Seed);
+            Block[j] = WG_NEW char[Size[j]];
+            Bytes += Size[j];
+        }
+    }
+
+    int Quantity;
+    char** Block;
+    int* Size;
+    unsigned int Seed;
+    size_t Bytes;  // requested by the live blocks
+};
+//----------------------------------------------------------------------------
+static int Churn (void* pvData)
+{
+    ChurnData* pkData = (ChurnData*)pvData;
+    pkData->Replace(pkData->Quantity);
+    return pkData->Quantity;
+}
+
+//----------------------------------------------------------------------------
+// arrays
+//----------------------------------------------------------------------------
+class ArrayData
+{
+public:
+    enum
+    {
+        QUANTITY = 4096,
+        EFFECTS = 1024
+    };
+
+    SpatialPtr Child;
+    Vector2xArrayPtr UVs;
+    int Width;
+};
+//----------------------------------------------------------------------------
+static int AppendInt (void*)
+{
+    TArray<int> kArray;
+    for (int i = 0; i < ArrayData::QUANTITY; i++)
+    {
+        kArray.Append(i);
+    }
+    return ArrayData::QUANTITY;
+}
+//----------------------------------------------------------------------------
+static int AppendVector (void*)
+{
+    TArray<Vector3x> kArray;
+    Vector3x kVector(fixed(FIXED_ONE),fixed(FIXED_ZERO),fixed(FIXED_ZERO));
+    for (int i = 0; i < ArrayData::QUANTITY; i++)
+    {
+        kArray.Append(kVector);
+    }
+    return ArrayData::QUANTITY;
+}
+//----------------------------------------------------------------------------
+static int AppendPointer (void* pvData)
+{
+    ArrayData* pkData = (ArrayData*)pvData;
+    TArray<SpatialPtr> kArray;
+    for (int i = 0; i < ArrayData::QUANTITY; i++)
+    {
+        kArray.Append(pkData->Child);
+    }
+    return ArrayData::QUANTITY;
+}
+//----------------------------------------------------------------------------
+// A node that is not told the number of its children, as a loader builds
+// it, attaches them one at a time (the items are the children).
+static int Attach (void* pvData)
+{
+    ArrayData* pkData = (ArrayData*)pvData;
+    NodePtr spkNode = WG_NEW Node;
+    for (int i = 0; i < pkData->Width; i++)
+    {
+        spkNode->AttachChild(WG_NEW Node);
+    }
+    return pkData->Width;
+}
+//----------------------------------------------------------------------------
+// effects with two texture coordinate arrays (the items are the effects)
+static int Effects (void* pvData)
+{
+    ArrayData* pkData = (ArrayData*)pvData;
+    for (int i = 0; i < ArrayData::EFFECTS; i++)
+    {
+        EffectPtr spkEffect = WG_NEW Effect;
+        spkEffect->UVs.Append(pkData->UVs);
+        spkEffect->UVs.Append(pkData->UVs);
+    }
+    return ArrayData::EFFECTS;
+}
+
+//----------------------------------------------------------------------------
+// registry of live objects
+//----------------------------------------------------------------------------
+class RegistryData
+{
+public:
+    RegistryData (int iQuantity)
+    {
+        Quantity = iQuantity;
+        Objects = WG_NEW ObjectPtr[iQuantity];
+    }
+
+    ~RegistryData ()
+    {
+        WG_DELETE[] Objects;
+    }
+
+    int Quantity;
+    ObjectPtr* Objects;
+};
+//----------------------------------------------------------------------------
+// create the objects and release them, each registers in Object::InUse
+static int Register (void* pvData)
+{
+    RegistryData* pkData = (RegistryData*)pvData;
+    int i;
+    for (i = 0; i < pkData->Quantity; i++)
+    {
+        pkData->Objects[i] = WG_NEW Vector2xArray;
+    }
+    for (i = 0; i < pkData->Quantity; i++)
+    {
+        pkData->Objects[i] = 0;
+    }
+    return pkData->Quantity;
+}
+//----------------------------------------------------------------------------
+// find every live object by its ID
+static int Lookup (void* pvData)
+{
+    RegistryData* pkData = (RegistryData*)pvData;
+    int iFound = 0;
+    for (int i = 0; i < pkData->Quantity; i++)
+    {
+        if (Object::InUse->Find(pkData->Objects[i]->GetID()))
+        {
+            iFound++;
+        }
+    }
+    assert(iFound == pkData->Quantity);
+    return iFound;
+}
+
+//----------------------------------------------------------------------------
+// scenes
+//----------------------------------------------------------------------------
+class SceneData
+{
+public:
+    SceneData (Node* (*oCreate)(int), int iSize, NullRenderer* pkRenderer);
+    ~SceneData ();
+
+    void Create ();
+    void Destroy ();
+
+    enum
+    {
+        RAYS = 64
+    };
+
+    Node* (*CreateScene)(int);
+    int Size;
+    NodePtr Scene;
+    CameraPtr View;
+    NullRenderer* Renderer;
+    int Objects;
+    double Time;
+    Ray3x Rays[RAYS];
+    Spatial::PickArray Picks;
+};
+//----------------------------------------------------------------------------
+SceneData::SceneData (Node* (*oCreate)(int), int iSize,
+    NullRenderer* pkRenderer)
+{
+    CreateScene = oCreate;
+    Size = iSize;
+    Renderer = pkRenderer;
+    Time = 0.0;
+    Create();
+    Objects = BenchScenes::GetObjectQuantity(Scene);
+
+    View = BenchScenes::CreateCamera(Scene);
+    Renderer->SetCamera(View);
+
+    // the rays go through an 8x8 grid over the view
+    Vector3x kOrigin = View->GetWorldLocation();
+    fixed fStep = fixed(FIXED_CONST(0.125));
+    for (int i = 0; i < RAYS; i++)
+    {
+        fixed fR = fStep*fixed::FromInt(2*(i % 8) - 7);
+        fixed fU = fStep*fixed::FromInt(2*(i / 8) - 7);
+        Vector3x kDirection = View->GetWorldDVector() +
+            fixed(FIXED_CONST(0.5))*fR*View->GetWorldRVector() +
+            fixed(FIXED_CONST(0.4))*fU*View->GetWorldUVector();
+        kDirection.Normalize();
+        Rays[i] = Ray3x(kOrigin,kDirection);
+    }
+}
+//----------------------------------------------------------------------------
+SceneData::~SceneData ()
+{
+    Renderer->SetCamera(0);
+    Destroy();
+}
+//----------------------------------------------------------------------------
+void SceneData::Create ()
+{
+    Scene = CreateScene(Size);
+    Scene->UpdateGS(Time);
+    Scene->UpdateRS();
+}
+//----------------------------------------------------------------------------
+void SceneData::Destroy ()
+{
+    Renderer->ReleaseResources(Scene);
+    Scene = 0;
+}
+//----------------------------------------------------------------------------
+static Node* CreateAnimated (int iLevels)
+{
+    return BenchScenes::CreateAnimated(4,iLevels);
+}
+//----------------------------------------------------------------------------
+static int Build (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    pkData->Destroy();
+    pkData->Create();
+    return pkData->Objects;
+}
+//----------------------------------------------------------------------------
+static int UpdateRS (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    pkData->Scene->UpdateRS();
+    return pkData->Objects;
+}
+//----------------------------------------------------------------------------
+static int DoPick (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    for (int i = 0; i < SceneData::RAYS; i++)
+    {
+        pkData->Scene->DoPick(pkData->Rays[i],pkData->Picks);
+        for (int j = 0; j < pkData->Picks.GetQuantity(); j++)
+        {
+            WG_DELETE pkData->Picks[j];
+        }
+        pkData->Picks.RemoveAll();
+    }
+    if (FrameArena::GetFrame())
+    {
+        FrameArena::GetFrame()->Reset();
+    }
+    return SceneData::RAYS;
+}
+//----------------------------------------------------------------------------
+static void RunScene (Bench& rkBench, const char* acGroup,
+    Node* (*oCreate)(int), int iSize, NullRenderer* pkRenderer)
+{
+    char acName[Bench::MAX_NAME];
+    for (int iMode = 0; iMode < gs_iModes; iMode++)
+    {
+        SetMode(iMode);
+        SceneData kData(oCreate,iSize,pkRenderer);
+        System::Sprintf(acName,Bench::MAX_NAME,"Build-%s",gs_aacMode[iMode]);
+        rkBench.Run(acName,acGroup,Build,&kData);
+        System::Sprintf(acName,Bench::MAX_NAME,"UpdateRS-%s",
+            gs_aacMode[iMode]);
+        rkBench.Run(acName,acGroup,UpdateRS,&kData);
+        System::Sprintf(acName,Bench::MAX_NAME,"DoPick-%s",gs_aacMode[iMode]);
+        rkBench.Run(acName,acGroup,DoPick,&kData);
+
+        FrameArena::SetFrame(gs_pkArena);
+        System::Sprintf(acName,Bench::MAX_NAME,"UpdateRS-%s-arena",
+            gs_aacMode[iMode]);
+        rkBench.Run(acName,acGroup,UpdateRS,&kData);
+        System::Sprintf(acName,Bench::MAX_NAME,"DoPick-%s-arena",
+            gs_aacMode[iMode]);
+        rkBench.Run(acName,acGroup,DoPick,&kData);
+        FrameArena::SetFrame(0);
+    }
+    SetMode(gs_iModes - 1);
+}
+
+#ifdef WG_MEMORY_MANAGER
+//----------------------------------------------------------------------------
+// statistics of the manager
+//----------------------------------------------------------------------------
+// the bytes taken from the system, 0 when unknown
+static size_t GetReservedBytes (int iMode)
+{
+    if (iMode == 1)
+    {
+        return Memory::GetReservedBytes();
+    }
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    struct mallinfo2 kInfo = mallinfo2();
+    return kInfo.arena + kInfo.hblkhd;
+#elif defined(__GLIBC__)
+    struct mallinfo kInfo = mallinfo();
+    return (size_t)(unsigned int)kInfo.arena +
+        (size_t)(unsigned int)kInfo.hblkhd;
+#else
+    return 0;
+#endif
+}
+//----------------------------------------------------------------------------
+static int Frame (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    pkData->Time += 1.0/60.0;
+    pkData->Scene->UpdateGS(pkData->Time);
+    UpdateRS(pvData);
+    pkData->Renderer->ClearBuffers();
+    pkData->Renderer->DrawScene(pkData->Scene);
+    pkData->Renderer->DisplayBackBuffer();
+    DoPick(pvData);  // resets the frame arena
+    return pkData->Objects;
+}
+//----------------------------------------------------------------------------
+static void PrintFootprint (const char* acName, int iMode, size_t uiLive,
+    size_t uiReserved)
+{
+    if (uiReserved == 0 || uiLive == 0)
+    {
+        printf("%-12s %-4s %10lu live bytes  reserved unknown\n",acName,
+            gs_aacMode[iMode],(unsigned long)uiLive);
+        return;
+    }
+    printf("%-12s %-4s %10lu live bytes %10lu reserved  %5.2f reserved/live"
+        "\n",acName,gs_aacMode[iMode],(unsigned long)uiLive,
+        (unsigned long)uiReserved,(double)uiReserved/(double)uiLive);
+}
+//----------------------------------------------------------------------------
+static void MeasureFragmentation (const char* acName,
+    Node* (*oCreate)(int), int iSize, NullRenderer* pkRenderer)
+{
+    // The heap runs first on the arena of the C library that the program
+    // has hardly used, the pools then take new pages.  A second workload
+    // would reuse the memory that the first one freed, so a run measures
+    // one.
+    printf("fragmentation (bytes taken from the system against the bytes "
+        "requested)\n");
+    for (int iMode = 0; iMode < 2; iMode++)
+    {
+        SetMode(iMode);
+        size_t uiReserved = GetReservedBytes(iMode);
+        size_t uiLive = Memory::GetLiveBytes();
+        ChurnData* pkChurn = 0;
+        SceneData* pkScene = 0;
+        if (oCreate)
+        {
+            pkScene = WG_NEW SceneData(oCreate,iSize,pkRenderer);
+        }
+        else
+        {
+            pkChurn = WG_NEW ChurnData(65536);
+            pkChurn->Replace(4*65536);
+        }
+        uiLive = Memory::GetLiveBytes() - uiLive;
+        size_t uiGrown = GetReservedBytes(iMode) - uiReserved;
+        PrintFootprint(acName,iMode,uiLive,uiReserved ? uiGrown : 0);
+
+        WG_DELETE pkScene;
+        WG_DELETE pkChurn;
+        uiGrown = GetReservedBytes(iMode) - uiReserved;
+        printf("%-12s %-4s %10lu bytes kept after freeing all\n",acName,
+            gs_aacMode[iMode],(unsigned long)uiGrown);
+    }
+    printf("\n");
+}
+//----------------------------------------------------------------------------
+static void PrintFrameAllocations (int iScenes, SceneData** apkScene,
+    const char** aacName, FrameArena* pkArena)
+{
+    printf("allocations of a frame per size class%s\n",
+        (pkArena ? " with a frame arena" : ""));
+    printf("class  size");
+    int i;
+    for (i = 0; i < iScenes; i++)
+    {
+        printf(" %14s",aacName[i]);
+    }
+    printf("\n");
+
+    size_t aauiCount[Memory::LARGE_CLASS+1][8];
+    size_t auiArenaPeak[8];
+    FrameArena::SetFrame(pkArena);
+    for (i = 0; i < iScenes; i++)
+    {
+        Frame(apkScene[i]);  // the first frame may grow arrays
+        Memory::BeginFrame();
+        Frame(apkScene[i]);
+        for (int iClass = 0; iClass <= Memory::LARGE_CLASS; iClass++)
+        {
+            aauiCount[iClass][i] = Memory::GetFrameAllocations(iClass);
+        }
+        auiArenaPeak[i] = (pkArena ? pkArena->GetPeakBytes() : 0);
+    }
+    FrameArena::SetFrame(0);
+    for (int iClass = 0; iClass <= Memory::LARGE_CLASS; iClass++)
+    {
+        if (iClass < Memory::LARGE_CLASS)
+        {
+            printf("%5d  %4d",iClass,Memory::GetClassSize(iClass));
+        }
+        else
+        {
+            printf("large     ");
+        }
+        for (i = 0; i < iScenes; i++)
+        {
+            printf(" %14lu",(unsigned long)aauiCount[iClass][i]);
+        }
+        printf("\n");
+    }
+    if (pkArena)
+    {
+        printf("arena peak");
+        for (i = 0; i < iScenes; i++)
+        {
+            printf(" %14lu",(unsigned long)auiArenaPeak[i]);
+        }
+        printf("\n");
+    }
+    printf("\n");
+}
+#endif
+
+//----------------------------------------------------------------------------
+static int Scaled (int iSize, int iScale)
+{
+    int iScaled = iSize*iScale/100;
+    return (iScaled > 1 ? iScaled : 1);
+}
+//----------------------------------------------------------------------------
+int main (int iArgs, char** aacArg)
+{
+    Bench kBench("memory");
+    if (!kBench.ParseArguments(iArgs,aacArg))
+    {
+        printf("usage: WgMemoryBench [-json file] [-csv file] [-filter text] "
+            "[-samples n] [-time ms] [-scale percent] "
+            "[-fragment churn|city]\n");
+        return 1;
+    }
+    int iScale = kBench.GetOption("-scale",100);
+    printf("memory benchmarks, %s backend, scale %d%%, %s\n",
+        Bench::GetBackend(),iScale,(gs_iModes == 2 ? "pools and heap" :
+        "heap only (no WG_MEMORY_MANAGER)"));
+
+    NullRenderer* pkRenderer = WG_NEW NullRenderer(BufferParams(),640,480);
+    gs_pkArena = WG_NEW FrameArena;
+    char acName[Bench::MAX_NAME];
+    char acGroup[Bench::MAX_NAME];
+    int iChain = Scaled(1000,iScale);
+    int iWidth = Scaled(10000,iScale);
+    int iBlocks = Scaled(32,iScale);
+    int iLevels = (iScale >= 100 ? 6 : 4);
+
+#ifdef WG_MEMORY_MANAGER
+    const char* acFragment = kBench.GetOption("-fragment");
+    if (acFragment && strcmp(acFragment,"city") == 0)
+    {
+        System::Sprintf(acGroup,Bench::MAX_NAME,"city-%d",iBlocks);
+        MeasureFragmentation(acGroup,BenchScenes::CreateCity,iBlocks,
+            pkRenderer);
+    }
+    else
+    {
+        MeasureFragmentation("churn-65536",0,0,pkRenderer);
+    }
+
+    const char* aacScene[4];
+    char aacSceneName[4][Bench::MAX_NAME];
+    SceneData* apkScene[4];
+    System::Sprintf(aacSceneName[0],Bench::MAX_NAME,"chain-%d",iChain);
+    apkScene[0] = WG_NEW SceneData(BenchScenes::CreateChain,iChain,
+        pkRenderer);
+    System::Sprintf(aacSceneName[1],Bench::MAX_NAME,"fanout-%d",iWidth);
+    apkScene[1] = WG_NEW SceneData(BenchScenes::CreateFanOut,iWidth,
+        pkRenderer);
+    System::Sprintf(aacSceneName[2],Bench::MAX_NAME,"city-%d",iBlocks);
+    apkScene[2] = WG_NEW SceneData(BenchScenes::CreateCity,iBlocks,
+        pkRenderer);
+    System::Sprintf(aacSceneName[3],Bench::MAX_NAME,"animated-4x%d",iLevels);
+    apkScene[3] = WG_NEW SceneData(CreateAnimated,iLevels,pkRenderer);
+    int i;
+    for (i = 0; i < 4; i++)
+    {
+        aacScene[i] = aacSceneName[i];
+    }
+    PrintFrameAllocations(4,apkScene,aacScene,0);
+    PrintFrameAllocations(4,apkScene,aacScene,gs_pkArena);
+    for (i = 0; i < 4; i++)
+    {
+        WG_DELETE apkScene[i];
+    }
+#endif
+
+    int iMode;
+    for (iMode = 0; iMode < gs_iModes; iMode++)
+    {
+        SetMode(iMode);
+        ObjectData* pkObjects = WG_NEW ObjectData;
+        System::Sprintf(acName,Bench::MAX_NAME,"Objects-%s",
+            gs_aacMode[iMode]);
+        kBench.Run(acName,"list+bound",Objects,pkObjects);
+        WG_DELETE pkObjects;
+
+        ChurnData* pkChurn = WG_NEW ChurnData(4096);
+        System::Sprintf(acName,Bench::MAX_NAME,"Churn-%s",gs_aacMode[iMode]);
+        kBench.Run(acName,"mixed-4096",Churn,pkChurn);
+        WG_DELETE pkChurn;
+
+        ArrayData* pkArrays = WG_NEW ArrayData;
+        pkArrays->Child = WG_NEW Node;
+        pkArrays->UVs = WG_NEW Vector2xArray;
+        pkArrays->Width = iWidth;
+        System::Sprintf(acName,Bench::MAX_NAME,"AppendInt-%s",
+            gs_aacMode[iMode]);
+        kBench.Run(acName,"array-4096",AppendInt,pkArrays);
+        System::Sprintf(acName,Bench::MAX_NAME,"AppendVector-%s",
+            gs_aacMode[iMode]);
+        kBench.Run(acName,"array-4096",AppendVector,pkArrays);
+        System::Sprintf(acName,Bench::MAX_NAME,"AppendPointer-%s",
+            gs_aacMode[iMode]);
+        kBench.Run(acName,"array-4096",AppendPointer,pkArrays);
+        System::Sprintf(acGroup,Bench::MAX_NAME,"fanout-%d",iWidth);
+        System::Sprintf(acName,Bench::MAX_NAME,"Attach-%s",
+            gs_aacMode[iMode]);
+        kBench.Run(acName,acGroup,Attach,pkArrays);
+        System::Sprintf(acName,Bench::MAX_NAME,"Effects-%s",
+            gs_aacMode[iMode]);
+        kBench.Run(acName,"effect-1024",Effects,pkArrays);
+        WG_DELETE pkArrays;
+    }
+    SetMode(gs_iModes - 1);
+
+    int iObjects;
+    for (iObjects = 10000; iObjects <= 1000000; iObjects *= 10)
+    {
+        RegistryData* pkRegistry = WG_NEW RegistryData(iObjects);
+        System::Sprintf(acGroup,Bench::MAX_NAME,"objects-%d",iObjects);
+        kBench.Run("Register",acGroup,Register,pkRegistry);
+        for (int i = 0; i < iObjects; i++)
+        {
+            pkRegistry->Objects[i] = WG_NEW Vector2xArray;
+        }
+        kBench.Run("Lookup",acGroup,Lookup,pkRegistry);
+        WG_DELETE pkRegistry;
+    }
+
+    System::Sprintf(acGroup,Bench::MAX_NAME,"chain-%d",iChain);
+    RunScene(kBench,acGroup,BenchScenes::CreateChain,iChain,pkRenderer);
+    System::Sprintf(acGroup,Bench::MAX_NAME,"fanout-%d",iWidth);
+    RunScene(kBench,acGroup,BenchScenes::CreateFanOut,iWidth,pkRenderer);
+    System::Sprintf(acGroup,Bench::MAX_NAME,"city-%d",iBlocks);
+    RunScene(kBench,acGroup,BenchScenes::CreateCity,iBlocks,pkRenderer);
+    System::Sprintf(acGroup,Bench::MAX_NAME,"animated-4x%d",iLevels);
+    RunScene(kBench,acGroup,CreateAnimated,iLevels,pkRenderer);
+
+    int iCity = Scaled(63,iScale);
+    System::Sprintf(acGroup,Bench::MAX_NAME,"city-%d",iCity);
+    SceneData* pkCity = WG_NEW SceneData(BenchScenes::CreateCity,iCity,
+        pkRenderer);
+    kBench.Run("UpdateRS",acGroup,UpdateRS,pkCity);
+    FrameArena::SetFrame(gs_pkArena);
+    kBench.Run("UpdateRS-arena",acGroup,UpdateRS,pkCity);
+    FrameArena::SetFrame(0);
+    WG_DELETE pkCity;
+
+    WG_DELETE gs_pkArena;
+    WG_DELETE pkRenderer;
+    return (kBench.Write() ? 0 : 1);
+}
+//----------------------------------------------------------------------------
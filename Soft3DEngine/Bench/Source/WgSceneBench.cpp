@@ -0,0 +1,758 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSceneBench.cpp                   //
+//                                                       //
+//  - Scene graph benchmarks                             //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+// The benchmarks of the scene graph, against the NullRenderer:
+//
+//   WgSceneBench [-json file] [-csv file] [-filter text] [-samples n]
+//       [-time ms] [-scale percent] [-threads n]
+//
+// For each scene of BenchScenes it measures
+//   UpdateGS     the geometric update, with the controllers
+//   UpdateRS     the render state update
+//   Cull         the traversal and the culling of DrawScene, with no draws
+//   Cull-batch   Cull with Node::SetBatchCulling, the error is the
+//                difference of the draws and the data read from those of
+//                DrawScene without it
+//   DoPick       the picking of 64 rays through the view frustum
+//   DrawScene    a frame of the NullRenderer
+//   Cull-index   Cull through a SpatialIndex of the scene, the error is
+//                the difference of the draws from those of DrawScene
+//   Cull-narrow, Cull-batch-narrow, Cull-index-narrow
+//                the same with a field of view of 10 degrees
+//   UpdateGS-index  UpdateGS followed by the refit of the index
+//   FindInSphere the query of the index with 64 spheres around meshes
+// The items are the objects of the scene (the rays for DoPick, the
+// spheres for FindInSphere).  On a city and on a grid of roads and walls
+// built with each type of bounding volume (sphere, box and obox, see
+// BoundingVolume::SetDefaultType) it measures Cull and UpdateGS, with
+// the same camera for all types, and prints the meshes drawn and those
+// in view.  A mesh is in view unless all its vertices are outside of one
+// plane of the frustum.  The error of Cull is the fraction of the meshes
+// that are drawn but not in view.  On a set of spheres it measures
+// Geometry::UpdateMS with and without the normals (Normals and ModelBound,
+// the items are the vertices).  On a large city of about 50000 objects it
+// measures the full UpdateGS after a turn of the root, the incremental
+// UpdateGS after a move of one mesh (the item is the update), the parallel
+// UpdateGS with 1, 2, 4, ... up to -threads threads, and the update of a
+// LinearScene after a turn of the root and after a move of one mesh.  The
+// error of the parallel UpdateGS and of the LinearScene is the number of
+// meshes whose world transformation or world bound differs from that of
+// the serial UpdateGS.  On a city of about 400 objects it measures a frame
+// drawn with Renderer::DrawDeferredNoSort and with DrawDeferredSorted (the
+// radix sort of the RenderQueue), and prints the draws that change the
+// global states or the textures of the draw before in each order.  The
+// error of the sorted frame is the difference of its draws from those of
+// the unsorted frame.
+//
+// -scale scales the size parameters of the scenes (default 100).  The
+// results of a build with WG_REAL=WG_REAL_FLOAT are marked with the float
+// backend, so the two backends can be compared.
+
+#include "WgBench.h"
+#include "WgBenchScenes.h"
+#include "WgNullRenderer.h"
+#include <cstdio>
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+class SceneData
+{
+public:
+    SceneData (Node* pkScene, NullRenderer* pkRenderer);
+    ~SceneData ();
+
+    enum
+    {
+        RAYS = 64
+    };
+
+    NodePtr Scene;
+    CameraPtr View;
+    NullRenderer* Renderer;
+    TArray<Geometry*> Meshes;
+    int Objects, Vertices;
+    double Time;
+    Ray3x Rays[RAYS];
+    Spatial::PickArray Picks;
+
+    // for the spatial index
+    SpatialIndex* Index;
+    Sphere3x Spheres[RAYS];
+    TArray<Spatial*> Found;
+
+    // for the incremental and the linear update, the mesh moved next and
+    // the rotation of the root set next
+    int Touched;
+    int TurnIndex;
+    Matrix3x Turn[2];
+    LinearScene* Linear;
+};
+//----------------------------------------------------------------------------
+SceneData::SceneData (Node* pkScene, NullRenderer* pkRenderer)
+{
+    Scene = pkScene;
+    Renderer = pkRenderer;
+    Time = 0.0;
+    Touched = 0;
+    TurnIndex = 0;
+    Linear = 0;
+    Index = 0;
+
+    Scene->UpdateGS(Time);
+    Scene->UpdateRS();
+    Objects = BenchScenes::GetObjectQuantity(Scene);
+    BenchScenes::GetGeometry(Scene,Meshes);
+    Vertices = 0;
+    int i;
+    for (i = 0; i < Meshes.GetQuantity(); i++)
+    {
+        Vertices += Meshes[i]->Vertices->GetQuantity();
+    }
+
+    View = BenchScenes::CreateCamera(Scene);
+    Renderer->SetCamera(View);
+
+    // the rays go through an 8x8 grid over the view
+    Vector3x kOrigin = View->GetWorldLocation();
+    fixed fStep = fixed(FIXED_CONST(0.125));
+    for (i = 0; i < RAYS; i++)
+    {
+        fixed fR = fStep*fixed::FromInt(2*(i % 8) - 7);
+        fixed fU = fStep*fixed::FromInt(2*(i / 8) - 7);
+        Vector3x kDirection = View->GetWorldDVector() +
+            fixed(FIXED_CONST(0.5))*fR*View->GetWorldRVector() +
+            fixed(FIXED_CONST(0.4))*fU*View->GetWorldUVector();
+        kDirection.Normalize();
+        Rays[i] = Ray3x(kOrigin,kDirection);
+    }
+
+    // the query spheres are around meshes spread over the scene, with an
+    // eighth of the scene radius
+    fixed fRadius = Scene->WorldBound->GetRadius()*
+        fixed(FIXED_CONST(0.125));
+    for (i = 0; i < RAYS; i++)
+    {
+        Geometry* pkMesh = Meshes[i*Meshes.GetQuantity()/RAYS];
+        Spheres[i] = Sphere3x(pkMesh->WorldBound->GetCenter(),fRadius);
+    }
+
+    Turn[0].FromAxisAngle(Vector3x::UNIT_Z,Mathx::DEG_TO_RAD);
+    Turn[1].FromAxisAngle(Vector3x::UNIT_Z,-Mathx::DEG_TO_RAD);
+}
+//----------------------------------------------------------------------------
+SceneData::~SceneData ()
+{
+    WG_DELETE Linear;
+    WG_DELETE Index;
+    Renderer->SetCamera(0);
+    Renderer->ReleaseResources(Scene);
+}
+//----------------------------------------------------------------------------
+static int UpdateGS (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    pkData->Time += 1.0/60.0;
+    pkData->Scene->UpdateGS(pkData->Time);
+    return pkData->Objects;
+}
+//----------------------------------------------------------------------------
+static int UpdateRS (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    pkData->Scene->UpdateRS();
+    return pkData->Objects;
+}
+//----------------------------------------------------------------------------
+static int Cull (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    pkData->Renderer->DrawDeferred = &Renderer::DrawDeferredNoDraw;
+    pkData->Renderer->DrawScene(pkData->Scene);
+    pkData->Renderer->DrawDeferred = 0;
+    return pkData->Objects;
+}
+//----------------------------------------------------------------------------
+static int CullBatch (void* pvData)
+{
+    Node::SetBatchCulling(true);
+    int iObjects = Cull(pvData);
+    Node::SetBatchCulling(false);
+    return iObjects;
+}
+//----------------------------------------------------------------------------
+static int DoPick (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    for (int i = 0; i < SceneData::RAYS; i++)
+    {
+        pkData->Scene->DoPick(pkData->Rays[i],pkData->Picks);
+        for (int j = 0; j < pkData->Picks.GetQuantity(); j++)
+        {
+            WG_DELETE pkData->Picks[j];
+        }
+        pkData->Picks.RemoveAll();
+    }
+    return SceneData::RAYS;
+}
+//----------------------------------------------------------------------------
+static int DrawScene (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    pkData->Renderer->ClearBuffers();
+    pkData->Renderer->DrawScene(pkData->Scene);
+    pkData->Renderer->DisplayBackBuffer();
+    return pkData->Objects;
+}
+//----------------------------------------------------------------------------
+static int DrawFrame (SceneData* pkData, Renderer::DrawFunction oDraw)
+{
+    // a frame of the NullRenderer drawn through the deferred objects
+    pkData->Renderer->DrawDeferred = oDraw;
+    pkData->Renderer->ClearBuffers();
+    pkData->Renderer->DrawScene(pkData->Scene);
+    pkData->Renderer->DisplayBackBuffer();
+    pkData->Renderer->DrawDeferred = 0;
+    return pkData->Objects;
+}
+//----------------------------------------------------------------------------
+static int DrawUnsorted (void* pvData)
+{
+    return DrawFrame((SceneData*)pvData,&Renderer::DrawDeferredNoSort);
+}
+//----------------------------------------------------------------------------
+static int DrawSorted (void* pvData)
+{
+    return DrawFrame((SceneData*)pvData,&Renderer::DrawDeferredSorted);
+}
+//----------------------------------------------------------------------------
+static int CullIndexed (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    pkData->Renderer->DrawDeferred = &Renderer::DrawDeferredNoDraw;
+    pkData->Renderer->DrawScene(pkData->Index);
+    pkData->Renderer->DrawDeferred = 0;
+    return pkData->Objects;
+}
+//----------------------------------------------------------------------------
+static int UpdateIndexed (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    pkData->Time += 1.0/60.0;
+    pkData->Scene->UpdateGS(pkData->Time);
+    pkData->Index->Update();
+    return pkData->Objects;
+}
+//----------------------------------------------------------------------------
+static int FindInSphere (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    for (int i = 0; i < SceneData::RAYS; i++)
+    {
+        pkData->Index->FindInSphere(pkData->Spheres[i],pkData->Found);
+        pkData->Found.RemoveAll();
+    }
+    return SceneData::RAYS;
+}
+//----------------------------------------------------------------------------
+static int GetDraws (SceneData* pkData, bool bIndexed)
+{
+    // the draws of a frame of the NullRenderer
+    pkData->Renderer->ClearBuffers();
+    if (bIndexed)
+    {
+        pkData->Renderer->DrawScene(pkData->Index);
+    }
+    else
+    {
+        pkData->Renderer->DrawScene(pkData->Scene);
+    }
+    pkData->Renderer->DisplayBackBuffer();
+    return pkData->Renderer->GetFrameStatistics().Draws;
+}
+//----------------------------------------------------------------------------
+static int CompareBatch (SceneData* pkData)
+{
+    // The difference of a frame with the batched culling from a frame
+    // without it, in the draws and in the data that the NullRenderer read.
+    // The first frame uploads the resources that were not seen yet.
+    int aiDraws[2];
+    unsigned int auiRead[2];
+    GetDraws(pkData,false);
+    for (int i = 0; i < 2; i++)
+    {
+        Node::SetBatchCulling(i == 1);
+        unsigned int uiStart = pkData->Renderer->GetChecksum();
+        aiDraws[i] = GetDraws(pkData,false);
+        auiRead[i] = pkData->Renderer->GetChecksum() - uiStart;
+    }
+    Node::SetBatchCulling(false);
+
+    int iDiff = aiDraws[1] - aiDraws[0];
+    return (iDiff >= 0 ? iDiff : -iDiff) + (auiRead[0] != auiRead[1]);
+}
+//----------------------------------------------------------------------------
+static int CountDrawn (Spatial* pkObject, Camera* pkCamera)
+{
+    // the culling of Spatial::OnDraw
+    if (pkObject->ForceCull)
+    {
+        return 0;
+    }
+
+    unsigned int uiState = pkCamera->GetPlaneState();
+    int iDrawn = 0;
+    if (!pkCamera->Culled(pkObject->WorldBound))
+    {
+        Node* pkNode = DynamicCast<Node>(pkObject);
+        if (pkNode)
+        {
+            for (int i = 0; i < pkNode->GetQuantity(); i++)
+            {
+                Spatial* pkChild = pkNode->GetChild(i);
+                if (pkChild)
+                {
+                    iDrawn += CountDrawn(pkChild,pkCamera);
+                }
+            }
+        }
+        else
+        {
+            iDrawn = 1;
+        }
+    }
+    pkCamera->SetPlaneState(uiState);
+    return iDrawn;
+}
+//----------------------------------------------------------------------------
+static int CountInView (SceneData* pkData)
+{
+    const Plane3x* akPlane = pkData->View->GetPlanes();
+    int iPlanes = pkData->View->GetPlaneQuantity();
+    TArray<Vector3x> kWorld(256,256);
+    int iInView = 0;
+    for (int i = 0; i < pkData->Meshes.GetQuantity(); i++)
+    {
+        // a mesh culled by the application (such as a shadow plane, drawn
+        // by its effect) is not counted
+        Geometry* pkMesh = pkData->Meshes[i];
+        if (pkMesh->ForceCull)
+        {
+            continue;
+        }
+
+        int iVQuantity = pkMesh->Vertices->GetQuantity();
+        kWorld.SetElement(iVQuantity-1,Vector3x::ZERO);
+        pkMesh->World.ApplyForward(iVQuantity,pkMesh->Vertices->GetData(),
+            kWorld.GetArray());
+
+        bool bInView = true;
+        for (int j = 0; j < iPlanes && bInView; j++)
+        {
+            int k;
+            for (k = 0; k < iVQuantity; k++)
+            {
+                if (akPlane[j].DistanceTo(kWorld[k]) >= FIXED_ZERO)
+                {
+                    break;
+                }
+            }
+            bInView = (k < iVQuantity);
+        }
+        if (bInView)
+        {
+            iInView++;
+        }
+    }
+    return iInView;
+}
+//----------------------------------------------------------------------------
+static int Normals (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    for (int i = 0; i < pkData->Meshes.GetQuantity(); i++)
+    {
+        pkData->Meshes[i]->UpdateMS(true);
+    }
+    return pkData->Vertices;
+}
+//----------------------------------------------------------------------------
+static int ModelBound (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    for (int i = 0; i < pkData->Meshes.GetQuantity(); i++)
+    {
+        pkData->Meshes[i]->UpdateMS(false);
+    }
+    return pkData->Vertices;
+}
+//----------------------------------------------------------------------------
+static void TurnRoot (SceneData* pkData)
+{
+    // a change of the root that moves the whole scene
+    pkData->TurnIndex ^= 1;
+    pkData->Scene->Local.SetRotate(pkData->Turn[pkData->TurnIndex]);
+    pkData->Scene->MarkDirty();
+}
+//----------------------------------------------------------------------------
+static int UpdateGSIncremental (void* pvData)
+{
+    // one mesh moved per update
+    SceneData* pkData = (SceneData*)pvData;
+    Geometry* pkMesh = pkData->Meshes[pkData->Touched];
+    pkData->Touched = (pkData->Touched + 1) % pkData->Meshes.GetQuantity();
+    pkMesh->MarkDirty();
+    pkData->Scene->UpdateGS();
+    return 1;
+}
+//----------------------------------------------------------------------------
+static int UpdateLinear (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    TurnRoot(pkData);
+    pkData->Linear->Update();
+    return pkData->Linear->GetQuantity();
+}
+//----------------------------------------------------------------------------
+static int UpdateLinearIncremental (void* pvData)
+{
+    // one mesh moved per update
+    SceneData* pkData = (SceneData*)pvData;
+    Geometry* pkMesh = pkData->Meshes[pkData->Touched];
+    pkData->Touched = (pkData->Touched + 1) % pkData->Meshes.GetQuantity();
+    pkMesh->MarkDirty();
+    pkData->Linear->Update();
+    return 1;
+}
+//----------------------------------------------------------------------------
+static int UpdateGSTurned (void* pvData)
+{
+    SceneData* pkData = (SceneData*)pvData;
+    TurnRoot(pkData);
+    pkData->Scene->UpdateGS();
+    return pkData->Objects;
+}
+//----------------------------------------------------------------------------
+static void GetWorld (SceneData* pkData, TArray<fixed>& rkWorld)
+{
+    // the homogeneous world matrices and the world bounds of the meshes
+    rkWorld.RemoveAll();
+    rkWorld.Reserve(20*pkData->Meshes.GetQuantity());
+    for (int i = 0; i < pkData->Meshes.GetQuantity(); i++)
+    {
+        Geometry* pkMesh = pkData->Meshes[i];
+        const fixed* afH = pkMesh->GetWorldHomogeneous();
+        for (int j = 0; j < 16; j++)
+        {
+            rkWorld.Append(afH[j]);
+        }
+        Vector3x kCenter = pkMesh->WorldBound->GetCenter();
+        rkWorld.Append(kCenter.X());
+        rkWorld.Append(kCenter.Y());
+        rkWorld.Append(kCenter.Z());
+        rkWorld.Append(pkMesh->WorldBound->GetRadius());
+    }
+}
+//----------------------------------------------------------------------------
+static int CountDifferent (const TArray<fixed>& rkA,
+    const TArray<fixed>& rkB)
+{
+    // the meshes whose world data differ
+    int iDifferent = 0;
+    for (int i = 0; i < rkA.GetQuantity(); i += 20)
+    {
+        for (int j = i; j < i + 20; j++)
+        {
+            if (rkA[j] != rkB[j])
+            {
+                iDifferent++;
+                break;
+            }
+        }
+    }
+    return iDifferent;
+}
+//----------------------------------------------------------------------------
+static int CompareParallel (SceneData* pkData, TaskPool* pkPool)
+{
+    // The meshes whose world data after a parallel UpdateGS differ from
+    // those after a serial UpdateGS of the same turn of the root.  The
+    // scene is turned away in between, so that the parallel update starts
+    // from other world data.
+    TArray<fixed> kSerial, kParallel;
+    TurnRoot(pkData);
+    pkData->Scene->UpdateGS();
+    GetWorld(pkData,kSerial);
+    TurnRoot(pkData);
+    pkData->Scene->UpdateGS();
+
+    Spatial::SetUpdatePool(pkPool);
+    TurnRoot(pkData);
+    pkData->Scene->UpdateGS();
+    Spatial::SetUpdatePool(0);
+    GetWorld(pkData,kParallel);
+    return CountDifferent(kSerial,kParallel);
+}
+//----------------------------------------------------------------------------
+static int CompareLinear (SceneData* pkData)
+{
+    // The meshes whose world data after LinearScene::Update differ from
+    // those after UpdateGS of the same turn of the root.  The LinearScene
+    // is compiled after the scene was turned away.
+    TArray<fixed> kSerial, kLinear;
+    TurnRoot(pkData);
+    pkData->Scene->UpdateGS();
+    GetWorld(pkData,kSerial);
+    TurnRoot(pkData);
+    pkData->Scene->UpdateGS();
+
+    pkData->Linear = WG_NEW LinearScene(pkData->Scene);
+    TurnRoot(pkData);
+    pkData->Linear->Update();
+    GetWorld(pkData,kLinear);
+    return CountDifferent(kSerial,kLinear);
+}
+//----------------------------------------------------------------------------
+static void RunScene (Bench& rkBench, const char* acGroup, Node* pkScene,
+    NullRenderer* pkRenderer)
+{
+    SceneData kData(pkScene,pkRenderer);
+    rkBench.Run("UpdateGS",acGroup,UpdateGS,&kData);
+    rkBench.Run("UpdateRS",acGroup,UpdateRS,&kData);
+    rkBench.Run("Cull",acGroup,Cull,&kData);
+    rkBench.Run("Cull-batch",acGroup,CullBatch,&kData,
+        (double)CompareBatch(&kData));
+    rkBench.Run("DoPick",acGroup,DoPick,&kData);
+    rkBench.Run("DrawScene",acGroup,DrawScene,&kData);
+
+    // the scene belongs to the SpatialIndex from now on
+    kData.Index = WG_NEW SpatialIndex(kData.Scene);
+    kData.Index->Update();
+    int iDiff = GetDraws(&kData,true) - GetDraws(&kData,false);
+    rkBench.Run("Cull-index",acGroup,CullIndexed,&kData,
+        (double)(iDiff >= 0 ? iDiff : -iDiff));
+
+    // a view of 10 degrees, which sees a small part of the scene
+    fixed fUpFov, fAspect, fDMin, fDMax;
+    kData.View->GetFrustum(fUpFov,fAspect,fDMin,fDMax);
+    kData.View->SetFrustum(fixed::FromInt(10),fAspect,fDMin,fDMax);
+    kData.View->SetFrame(kData.View->GetWorldLocation(),
+        kData.View->GetWorldDVector(),kData.View->GetWorldUVector(),
+        kData.View->GetWorldRVector());
+    iDiff = GetDraws(&kData,true) - GetDraws(&kData,false);
+    rkBench.Run("Cull-narrow",acGroup,Cull,&kData);
+    rkBench.Run("Cull-batch-narrow",acGroup,CullBatch,&kData,
+        (double)CompareBatch(&kData));
+    rkBench.Run("Cull-index-narrow",acGroup,CullIndexed,&kData,
+        (double)(iDiff >= 0 ? iDiff : -iDiff));
+
+    rkBench.Run("UpdateGS-index",acGroup,UpdateIndexed,&kData);
+    rkBench.Run("FindInSphere",acGroup,FindInSphere,&kData);
+}
+//----------------------------------------------------------------------------
+static void RunBounds (Bench& rkBench, const char* acGroup,
+    Node* (*oCreate)(int), int iSize, NullRenderer* pkRenderer)
+{
+    const char* aacType[BoundingVolume::BV_QUANTITY] =
+    {
+        "sphere", "box", "obox"
+    };
+    char acName[Bench::MAX_NAME];
+
+    // the views of the first type, the camera of a scene depends on its
+    // bound
+    Vector3x kLocation, kDVector, kUVector, kRVector;
+    fixed afFrustum[6];
+
+    for (int iType = 0; iType < BoundingVolume::BV_QUANTITY; iType++)
+    {
+        BoundingVolume::SetDefaultType(iType);
+        SceneData kData(oCreate(iSize),pkRenderer);
+        if (iType == 0)
+        {
+            kData.View->GetFrustum(afFrustum[0],afFrustum[1],afFrustum[2],
+                afFrustum[3],afFrustum[4],afFrustum[5]);
+            kLocation = kData.View->GetWorldLocation();
+            kDVector = kData.View->GetWorldDVector();
+            kUVector = kData.View->GetWorldUVector();
+            kRVector = kData.View->GetWorldRVector();
+        }
+
+        for (int iView = 0; iView < 2; iView++)
+        {
+            // the second view is narrowed to 10 degrees
+            if (iView == 0)
+            {
+                kData.View->SetFrustum(afFrustum[0],afFrustum[1],
+                    afFrustum[2],afFrustum[3],afFrustum[4],afFrustum[5]);
+            }
+            else
+            {
+                kData.View->SetFrustum(fixed::FromInt(10),
+                    afFrustum[1]/afFrustum[3],afFrustum[4],afFrustum[5]);
+            }
+            kData.View->SetFrame(kLocation,kDVector,kUVector,kRVector);
+
+            int iMeshes = kData.Meshes.GetQuantity();
+            int iDrawn = CountDrawn(kData.Scene,kData.View);
+            int iInView = CountInView(&kData);
+            System::Sprintf(acName,Bench::MAX_NAME,"Cull-%s%s",
+                (iView == 0 ? "" : "narrow-"),aacType[iType]);
+            printf("%-30s %-14s %8d meshes %8d drawn %8d in view\n",acName,
+                acGroup,iMeshes,iDrawn,iInView);
+            rkBench.Run(acName,acGroup,Cull,&kData,
+                (double)(iDrawn - iInView)/(double)iMeshes);
+        }
+
+        System::Sprintf(acName,Bench::MAX_NAME,"UpdateGS-%s",
+            aacType[iType]);
+        rkBench.Run(acName,acGroup,UpdateGS,&kData);
+    }
+    BoundingVolume::SetDefaultType(BoundingVolume::BV_SPHERE);
+}
+//----------------------------------------------------------------------------
+static void RunMeshes (Bench& rkBench, const char* acGroup, Node* pkScene,
+    NullRenderer* pkRenderer)
+{
+    SceneData kData(pkScene,pkRenderer);
+    rkBench.Run("Normals",acGroup,Normals,&kData);
+    rkBench.Run("ModelBound",acGroup,ModelBound,&kData);
+}
+//----------------------------------------------------------------------------
+static void RunUpdates (Bench& rkBench, const char* acGroup, Node* pkScene,
+    NullRenderer* pkRenderer, int iMaxThreads)
+{
+    SceneData kData(pkScene,pkRenderer);
+    rkBench.Run("UpdateGS",acGroup,UpdateGSTurned,&kData);
+
+    Spatial::SetIncrementalUpdate(true);
+    kData.Touched = 0;
+    rkBench.Run("UpdateGS-incremental",acGroup,UpdateGSIncremental,&kData);
+    Spatial::SetIncrementalUpdate(false);
+
+    char acName[Bench::MAX_NAME];
+    for (int iThreads = 1; iThreads <= iMaxThreads; iThreads *= 2)
+    {
+        System::Sprintf(acName,Bench::MAX_NAME,"UpdateGS-%dt",iThreads);
+        if (rkBench.IsSelected(acName,acGroup))
+        {
+            TaskPool kPool(iThreads);
+            int iDifferent = CompareParallel(&kData,&kPool);
+            Spatial::SetUpdatePool(&kPool);
+            rkBench.Run(acName,acGroup,UpdateGSTurned,&kData,
+                (double)iDifferent);
+            Spatial::SetUpdatePool(0);
+        }
+    }
+
+    // the scene belongs to the LinearScene from now on
+    if (rkBench.IsSelected("LinearScene",acGroup)
+    ||  rkBench.IsSelected("LinearScene-incremental",acGroup))
+    {
+        int iDifferent = CompareLinear(&kData);
+        rkBench.Run("LinearScene",acGroup,UpdateLinear,&kData,
+            (double)iDifferent);
+        kData.Touched = 0;
+        rkBench.Run("LinearScene-incremental",acGroup,
+            UpdateLinearIncremental,&kData);
+    }
+}
+//----------------------------------------------------------------------------
+static void RunSorting (Bench& rkBench, const char* acGroup, Node* pkScene,
+    NullRenderer* pkRenderer)
+{
+    SceneData kData(pkScene,pkRenderer);
+
+    // The first frame uploads the resources.  The RenderQueue counts the
+    // changes of the sorted order and of the traversal order.
+    DrawSorted(&kData);
+    DrawUnsorted(&kData);
+    int iUnsortedDraws = pkRenderer->GetFrameStatistics().Draws;
+    DrawSorted(&kData);
+    int iSortedDraws = pkRenderer->GetFrameStatistics().Draws;
+    const RenderQueue& rkQueue = pkRenderer->GetRenderQueue();
+
+    for (int i = 0; i < 2; i++)
+    {
+        bool bSorted = (i == 1);
+        printf("%-30s %-14s %8d objects %6d state changes %6d texture "
+            "changes\n",(bSorted ? "DrawScene-sorted" : "DrawScene-unsorted"),
+            acGroup,rkQueue.GetQuantity(),rkQueue.GetStateChanges(bSorted),
+            rkQueue.GetTextureChanges(bSorted));
+    }
+
+    int iDiff = iSortedDraws - iUnsortedDraws;
+    rkBench.Run("DrawScene-unsorted",acGroup,DrawUnsorted,&kData);
+    rkBench.Run("DrawScene-sorted",acGroup,DrawSorted,&kData,
+        (double)(iDiff >= 0 ? iDiff : -iDiff));
+}
+//----------------------------------------------------------------------------
+static int Scaled (int iSize, int iScale)
+{
+    int iScaled = iSize*iScale/100;
+    return (iScaled > 1 ? iScaled : 1);
+}
+//----------------------------------------------------------------------------
+int main (int iArgs, char** aacArg)
+{
+    Bench kBench("scene");
+    if (!kBench.ParseArguments(iArgs,aacArg))
+    {
+        printf("usage: WgSceneBench [-json file] [-csv file] [-filter text] "
+            "[-samples n] [-time ms] [-scale percent] [-threads n]\n");
+        return 1;
+    }
+    int iScale = kBench.GetOption("-scale",100);
+    int iMaxThreads = kBench.GetOption("-threads",16);
+    printf("scene benchmarks, %s backend, scale %d%%\n",Bench::GetBackend(),
+        iScale);
+
+    NullRenderer* pkRenderer = WG_NEW NullRenderer(BufferParams(),640,480);
+    char acGroup[Bench::MAX_NAME];
+
+    int iDepth = Scaled(1000,iScale);
+    System::Sprintf(acGroup,Bench::MAX_NAME,"chain-%d",iDepth);
+    RunScene(kBench,acGroup,BenchScenes::CreateChain(iDepth),pkRenderer);
+
+    int iWidth = Scaled(10000,iScale);
+    System::Sprintf(acGroup,Bench::MAX_NAME,"fanout-%d",iWidth);
+    RunScene(kBench,acGroup,BenchScenes::CreateFanOut(iWidth),pkRenderer);
+
+    int iBlocks = Scaled(32,iScale);
+    System::Sprintf(acGroup,Bench::MAX_NAME,"city-%d",iBlocks);
+    RunScene(kBench,acGroup,BenchScenes::CreateCity(iBlocks),pkRenderer);
+
+    int iLevels = (iScale >= 100 ? 6 : 4);
+    System::Sprintf(acGroup,Bench::MAX_NAME,"animated-4x%d",iLevels);
+    RunScene(kBench,acGroup,BenchScenes::CreateAnimated(4,iLevels),
+        pkRenderer);
+
+    iBlocks = Scaled(32,iScale);
+    System::Sprintf(acGroup,Bench::MAX_NAME,"city-%d",iBlocks);
+    RunBounds(kBench,acGroup,BenchScenes::CreateCity,iBlocks,pkRenderer);
+    System::Sprintf(acGroup,Bench::MAX_NAME,"roads-%d",iBlocks);
+    RunBounds(kBench,acGroup,BenchScenes::CreateRoads,iBlocks,pkRenderer);
+
+    int iSpheres = Scaled(64,iScale);
+    System::Sprintf(acGroup,Bench::MAX_NAME,"spheres-%d",iSpheres);
+    RunMeshes(kBench,acGroup,BenchScenes::CreateSpheres(iSpheres,24),
+        pkRenderer);
+
+    // 9 x 9 blocks are about 400 objects
+    iBlocks = Scaled(9,iScale);
+    System::Sprintf(acGroup,Bench::MAX_NAME,"city-%d",iBlocks);
+    RunSorting(kBench,acGroup,BenchScenes::CreateCity(iBlocks),pkRenderer);
+
+    iBlocks = Scaled(100,iScale);
+    System::Sprintf(acGroup,Bench::MAX_NAME,"city-%d",iBlocks);
+    RunUpdates(kBench,acGroup,BenchScenes::CreateCity(iBlocks),pkRenderer,
+        iMaxThreads);
+
+    WG_DELETE pkRenderer;
+    return (kBench.Write() ? 0 : 1);
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgContBox3.cpp                     //
+//                                                       //
+//  - Implementation for Containment Box 3 class         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgContBox3.h"
+
+namespace WGSoft3D
+{
+//----------------------------------------------------------------------------
+Box3x ContAlignedBox (int iQuantity, const Vector3x* akPoint)
+{
+    Vector3x kMin, kMax;
+    Vector3x::ComputeExtremes(iQuantity,akPoint,kMin,kMax);
+
+    Box3x kBox;
+    kBox.Center = fixed(FIXED_HALF)*(kMin + kMax);
+    kBox.Axis[0] = Vector3x::UNIT_X;
+    kBox.Axis[1] = Vector3x::UNIT_Y;
+    kBox.Axis[2] = Vector3x::UNIT_Z;
+    for (int i = 0; i < 3; i++)
+    {
+        kBox.Extent[i] = fixed(FIXED_HALF)*(kMax[i] - kMin[i]);
+    }
+    return kBox;
+}
+//----------------------------------------------------------------------------
+Box3x ContBox (const Vector3x* akAxis, int iQuantity,
+    const Vector3x* akPoint)
+{
+    assert(iQuantity > 0 && akPoint);
+
+    // The extremes of the projections of the points onto the axes, relative
+    // to the first point to keep the products small.
+    Vector3x kMin = Vector3x::ZERO, kMax = Vector3x::ZERO;
+    int i, j;
+    for (i = 1; i < iQuantity; i++)
+    {
+        Vector3x kDiff = akPoint[i] - akPoint[0];
+        for (j = 0; j < 3; j++)
+        {
+            fixed fDot = kDiff.Dot(akAxis[j]);
+            if (fDot < kMin[j])
+            {
+                kMin[j] = fDot;
+            }
+            else if (fDot > kMax[j])
+            {
+                kMax[j] = fDot;
+            }
+        }
+    }
+
+    Box3x kBox;
+    kBox.Center = akPoint[0];
+    for (j = 0; j < 3; j++)
+    {
+        kBox.Axis[j] = akAxis[j];
+        kBox.Center += (fixed(FIXED_HALF)*(kMin[j] + kMax[j]))*akAxis[j];
+        kBox.Extent[j] = fixed(FIXED_HALF)*(kMax[j] - kMin[j]);
+    }
+    return kBox;
+}
+//----------------------------------------------------------------------------
+bool InBox (const Vector3x& rkPoint, const Box3x& rkBox)
+{
+    Vector3x kDiff = rkPoint - rkBox.Center;
+    for (int i = 0; i < 3; i++)
+    {
+        fixed fCoeff = kDiff.Dot(rkBox.Axis[i]);
+        if (Mathx::FAbs(fCoeff) > rkBox.Extent[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+Box3x MergeBoxes (const Box3x& rkBox0, const Box3x& rkBox1)
+{
+    fixed fSize0 = rkBox0.Extent[0] + rkBox0.Extent[1] + rkBox0.Extent[2];
+    fixed fSize1 = rkBox1.Extent[0] + rkBox1.Extent[1] + rkBox1.Extent[2];
+    const Box3x& rkLarge = (fSize0 >= fSize1 ? rkBox0 : rkBox1);
+    const Box3x& rkSmall = (fSize0 >= fSize1 ? rkBox1 : rkBox0);
+
+    // The projection of the small box onto an axis of the large box is the
+    // interval of its center with the radius sum(E[k]*|Dot(axis,A[k])|),
+    // which is the interval of its vertices.  Merge it with the interval of
+    // the large box, relative to the center of the large box.
+    Vector3x kDiff = rkSmall.Center - rkLarge.Center;
+    Box3x kBox;
+    kBox.Center = rkLarge.Center;
+    for (int j = 0; j < 3; j++)
+    {
+        const Vector3x& rkAxis = rkLarge.Axis[j];
+        fixed fCenter = kDiff.Dot(rkAxis);
+        fixed fRadius =
+            rkSmall.Extent[0]*Mathx::FAbs(rkAxis.Dot(rkSmall.Axis[0])) +
+            rkSmall.Extent[1]*Mathx::FAbs(rkAxis.Dot(rkSmall.Axis[1])) +
+            rkSmall.Extent[2]*Mathx::FAbs(rkAxis.Dot(rkSmall.Axis[2]));
+
+        fixed fMin = fCenter - fRadius, fMax = fCenter + fRadius;
+        if (fMin > -rkLarge.Extent[j])
+        {
+            fMin = -rkLarge.Extent[j];
+        }
+        if (fMax < rkLarge.Extent[j])
+        {
+            fMax = rkLarge.Extent[j];
+        }
+
+        kBox.Axis[j] = rkAxis;
+        kBox.Center += (fixed(FIXED_HALF)*(fMin + fMax))*rkAxis;
+        kBox.Extent[j] = fixed(FIXED_HALF)*(fMax - fMin);
+    }
+    return kBox;
+}
+//----------------------------------------------------------------------------
+}
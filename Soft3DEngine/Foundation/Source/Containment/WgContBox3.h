@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgContBox3.h                       //
+//                                                       //
+//  - Interface for Containment Box 3 class              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_CONT_BOX_3_H__
+#define __WG_CONT_BOX_3_H__
+
+#include "WgFoundationLIB.h"
+#include "WgBox3.h"
+
+namespace WGSoft3D
+{
+
+// Compute the smallest axis-aligned box that contains the points.
+WG3D_FOUNDATION_ITEM Box3x ContAlignedBox (int iQuantity,
+    const Vector3x* akPoint);
+
+// Compute the smallest box with the input axes that contains the points.
+// The axes must be an orthonormal set of vectors.
+WG3D_FOUNDATION_ITEM Box3x ContBox (const Vector3x* akAxis, int iQuantity,
+    const Vector3x* akPoint);
+
+// Test for containment of a point inside a box.
+WG3D_FOUNDATION_ITEM bool InBox (const Vector3x& rkPoint,
+    const Box3x& rkBox);
+
+// Compute a box that contains the input boxes.  The box has the axes of
+// the larger input box (the one with the larger sum of extents), which
+// keeps the merged box tight when a small box is added to a large one.
+WG3D_FOUNDATION_ITEM Box3x MergeBoxes (const Box3x& rkBox0,
+    const Box3x& rkBox1);
+
+}
+
+#endif
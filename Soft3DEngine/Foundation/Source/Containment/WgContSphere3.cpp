@@ -11,6 +11,7 @@
 
 #include "WgFoundationPCH.h"
 #include "WgContSphere3.h"
+#include "WgProfiler.h"
 namespace WGSoft3D
 {
 Sphere3x ContSphereOfAABB (int iQuantity, const Vector3x* akPoint,
@@ -221,6 +222,8 @@ bool InSphere (const Vector3x& rkPoint, const Sphere3x& rkSphere)
 MinSphere3x::MinSphere3x (int iQuantity, const Vector3x* akPoint,
     Sphere3x& rkMinimal, fixed fEpsilon)
 {
+    WG3D_PROFILE("MinSphere3x::MinSphere3x");
+
     m_fEpsilon = fEpsilon;
     m_aoUpdate[0] = 0;
     m_aoUpdate[1] = &MinSphere3x::UpdateSupport1;
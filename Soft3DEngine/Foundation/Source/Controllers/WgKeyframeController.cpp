@@ -12,6 +12,7 @@
 #include "WgFoundationPCH.h"
 #include "WgKeyframeController.h"
 #include "WgSpatial.h"
+#include "WgProfiler.h"
 using namespace WGSoft3D;
 
 WG3D_IMPLEMENT_RTTI(WGSoft3D,KeyframeController,Controller);
@@ -87,14 +88,15 @@ void KeyframeController::GetKeyInfo (float fCtrlTime, int iQuantity,
 Vector3x KeyframeController::GetTranslate (float fNormTime, int i0, int i1)
 {
     Vector3x* akTData = TranslationData->GetData();
-    return akTData[i0] + fNormTime*(akTData[i1] - akTData[i0]);
+    return akTData[i0] + fixed(FixedFromFloat(fNormTime))*
+        (akTData[i1] - akTData[i0]);
 }
 //----------------------------------------------------------------------------
 Matrix3x KeyframeController::GetRotate (float fNormTime, int i0, int i1)
 {
     Quaternionx* akRData = RotationData->GetData();
     Quaternionx kQ;
-    kQ.Slerp(fNormTime,akRData[i0],akRData[i1]);
+    kQ.Slerp(fixed(FixedFromFloat(fNormTime)),akRData[i0],akRData[i1]);
 
     Matrix3x kRot;
     kQ.ToRotationMatrix(kRot);
@@ -104,11 +106,14 @@ Matrix3x KeyframeController::GetRotate (float fNormTime, int i0, int i1)
 fixed KeyframeController::GetScale (float fNormTime, int i0, int i1)
 {
     fixed* afSData = ScaleData->GetData();
-    return afSData[i0] + fNormTime*(afSData[i1] - afSData[i0]);
+    return afSData[i0] + fixed(FixedFromFloat(fNormTime))*
+        (afSData[i1] - afSData[i0]);
 }
 //----------------------------------------------------------------------------
 bool KeyframeController::Update (double dAppTime)
 {
+    WG3D_PROFILE("KeyframeController::Update");
+
     if (!Controller::Update(dAppTime))
     {
         return false;
@@ -14,6 +14,7 @@
 #include "WgTriMesh.h"
 #include "WgCachedColorRGBArray.h"
 #include "WgCachedVector2Array.h"
+#include "WgFixedSimd.h"
 using namespace WGSoft3D;
 
 WG3D_IMPLEMENT_RTTI(WGSoft3D,BumpMapEffect,Effect);
@@ -121,10 +122,8 @@ void BumpMapEffect::ComputeLightVectors (Triangles* pkMesh)
     Vector3x* akVertex = pkMesh->Vertices->GetData();
     Vector2x* akUV = UVs[0]->GetData();
 
-    // Set the light vectors to (0,0,0) as a flag that the quantity has not
-    // yet been computed.  The probability that a light vector is actually
-    // (0,0,0) should be small, so the flag system should save computation
-    // time overall.
+    // Set the light vectors to (0,0,0).  Vertices that no triangle uses keep
+    // this value.
     ColorRGB* akLVec = ColorRGBs->GetData();
     memset(akLVec,0,iVQuantity*sizeof(ColorRGB));
 
@@ -138,6 +137,15 @@ void BumpMapEffect::ComputeLightVectors (Triangles* pkMesh)
     }
     Vector3x* akNormal = pkMesh->Normals->GetData();
 
+    // The tangent of a vertex is estimated from the first triangle that
+    // shares it.  The rest of the work is done in batches over the vertices
+    // that have a tangent, which are listed in aiVertex.
+    bool* abVisited = WG_NEW bool[iVQuantity];
+    memset(abVisited,0,iVQuantity*sizeof(bool));
+    int* aiVertex = WG_NEW int[iVQuantity];
+    Vector3x* akTangent = WG_NEW Vector3x[iVQuantity];
+    int iPQuantity = 0;
+
     int iTQuantity = pkMesh->GetTriangleQuantity();
     for (int iT = 0; iT < iTQuantity; iT++)
     {
@@ -147,6 +155,7 @@ void BumpMapEffect::ComputeLightVectors (Triangles* pkMesh)
         {
             continue;
         }
+        short aiV[3] = {iV0, iV1, iV2};
         Vector3x* apkV[3] = {&akVertex[iV0], &akVertex[iV1], &akVertex[iV2]};
         Vector3x* apkN[3] = {&akNormal[iV0], &akNormal[iV1], &akNormal[iV2]};
         Vector2x* apkUV[3] = {&akUV[iV0], &akUV[iV1], &akUV[iV2]};
@@ -154,11 +163,11 @@ void BumpMapEffect::ComputeLightVectors (Triangles* pkMesh)
 
         for (int i = 0; i < 3; i++)
         {
-            ColorRGB& rkColor = *apkC[i];
-            if (rkColor != ColorRGB::BLACK)
+            if (abVisited[aiV[i]])
             {
                 continue;
             }
+            abVisited[aiV[i]] = true;
 
             int iP = (i == 0) ? 2 : i - 1;
             int iN = (i + 1) % 3;
@@ -230,53 +239,83 @@ void BumpMapEffect::ComputeLightVectors (Triangles* pkMesh)
                 // The texture coordinate mapping is not properly defined for
                 // this.  Just say that the tangent space light vector points
                 // in the same direction as the surface normal.
+                ColorRGB& rkColor = *apkC[i];
                 rkColor.R() = apkN[i]->X();
                 rkColor.G() = apkN[i]->Y();
                 rkColor.B() = apkN[i]->Z();
                 continue;
             }
 
-            // Project T into the tangent plane by projecting out the surface
-            // normal, then make it unit length.
-            kTangent -= apkN[i]->Dot(kTangent)*(*apkN[i]);
-            kTangent.Normalize();
-
-            // compute the bitangent B, another tangent perpendicular to T
-            Vector3x kBitangent = apkN[i]->UnitCross(kTangent);
-
-            // When generating bump/normal maps, folks usually work in a
-            // left-handed screen space with the origin at the upper right,
-            // u to the right, and v down, while we apply the textures with
-            // the origin at the lower left, u right, v up, so we need to flip
-            // the kBitangent (v-axis) to get a proper transformation to the
-            // surface local texture space.
-            Matrix3x kRotTS(
-                kTangent.X(),   kTangent.Y(),   kTangent.Z(),
-              -kBitangent.X(), -kBitangent.Y(), -kBitangent.Z(),
-                apkN[i]->X(),   apkN[i]->Y(),   apkN[i]->Z());
-
-            // compute the tangent space light direction
-            Vector3x kTSDir;
-            if (m_spkLight->Type == Light::LT_DIRECTIONAL)
-            {
-                kTSDir = kMLight;
-            }
-            else  // light is positional
-            {
-                kTSDir = kMLight - *apkV[i];
-            }
-
-            kTSDir.Normalize();
-            kTSDir = kRotTS*kTSDir;
+            akTangent[iPQuantity] = kTangent;
+            aiVertex[iPQuantity] = aiV[i];
+            iPQuantity++;
+        }
+    }
 
-            // Transform the light vector into [0,1]^3 to make it a valid
-            // ColorRGB object.
-            rkColor.R() = FIXED_HALF*(kTSDir.X() + FIXED_ONE);
-            rkColor.G() = FIXED_HALF*(kTSDir.Y() + FIXED_ONE);
-            rkColor.B() = FIXED_HALF*(kTSDir.Z() + FIXED_ONE);
+    Vector3x* akN = WG_NEW Vector3x[iPQuantity];
+    Vector3x* akBitangent = WG_NEW Vector3x[iPQuantity];
+    Vector3x* akTSDir = WG_NEW Vector3x[iPQuantity];
+    fixed* afDot = WG_NEW fixed[iPQuantity];
+    int i;
+    for (i = 0; i < iPQuantity; i++)
+    {
+        akN[i] = akNormal[aiVertex[i]];
+        if (m_spkLight->Type == Light::LT_DIRECTIONAL)
+        {
+            akTSDir[i] = kMLight;
+        }
+        else  // light is positional
+        {
+            akTSDir[i] = kMLight - akVertex[aiVertex[i]];
         }
     }
 
+    // Project T into the tangent plane by projecting out the surface
+    // normal, then make it unit length.
+    FixedSimd::Dot(iPQuantity,akN,akTangent,afDot);
+    for (i = 0; i < iPQuantity; i++)
+    {
+        akTangent[i] -= afDot[i]*akN[i];
+    }
+    FixedSimd::Normalize(iPQuantity,akTangent);
+
+    // compute the bitangent B, another tangent perpendicular to T
+    FixedSimd::Cross(iPQuantity,akN,akTangent,akBitangent);
+    FixedSimd::Normalize(iPQuantity,akBitangent);
+
+    // When generating bump/normal maps, folks usually work in a left-handed
+    // screen space with the origin at the upper right, u to the right, and
+    // v down, while we apply the textures with the origin at the lower left,
+    // u right, v up, so we need to flip the bitangent (v-axis) to get a
+    // proper transformation to the surface local texture space.  The
+    // tangent space light direction is the rotation with rows T, -B and N
+    // applied to the light direction.  Transform the light vector into
+    // [0,1]^3 to make it a valid ColorRGB object.
+    FixedSimd::Normalize(iPQuantity,akTSDir);
+    FixedSimd::Dot(iPQuantity,akTangent,akTSDir,afDot);
+    for (i = 0; i < iPQuantity; i++)
+    {
+        akLVec[aiVertex[i]].R() = FIXED_HALF*(afDot[i] + FIXED_ONE);
+    }
+    FixedSimd::Dot(iPQuantity,akBitangent,akTSDir,afDot);
+    for (i = 0; i < iPQuantity; i++)
+    {
+        akLVec[aiVertex[i]].G() = FIXED_HALF*(-afDot[i] + FIXED_ONE);
+    }
+    FixedSimd::Dot(iPQuantity,akN,akTSDir,afDot);
+    for (i = 0; i < iPQuantity; i++)
+    {
+        akLVec[aiVertex[i]].B() = FIXED_HALF*(afDot[i] + FIXED_ONE);
+    }
+
+    WG_DELETE[] abVisited;
+    WG_DELETE[] aiVertex;
+    WG_DELETE[] akTangent;
+    WG_DELETE[] akN;
+    WG_DELETE[] akBitangent;
+    WG_DELETE[] akTSDir;
+    WG_DELETE[] afDot;
+
     m_bNeedsRecalculation = false;
 }
 //----------------------------------------------------------------------------
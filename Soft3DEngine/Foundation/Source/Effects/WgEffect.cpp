@@ -20,9 +20,6 @@ WG3D_IMPLEMENT_RTTI(WGSoft3D,Effect,Object);
 
 //----------------------------------------------------------------------------
 Effect::Effect ()
-    :
-    Textures(8,8),
-    UVs(8,8)
 {
     Draw = &Renderer::DrawPrimitive;
 }
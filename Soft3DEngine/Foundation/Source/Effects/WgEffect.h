@@ -46,8 +46,8 @@ public:
     // data common to many effects
     ColorRGBArrayPtr ColorRGBs;
     ColorRGBAArrayPtr ColorRGBAs;
-    TArray<TexturePtr> Textures;
-    TArray<Vector2xArrayPtr> UVs;
+    TSmallArray<TexturePtr,4> Textures;
+    TSmallArray<Vector2xArrayPtr,4> UVs;
 	
 	virtual void RemoveColorRGBData();
 	virtual void RemoveColorRGBAData();
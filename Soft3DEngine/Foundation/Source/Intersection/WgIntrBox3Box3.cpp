@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgIntrBox3Box3.cpp                 //
+//                                                       //
+//  - Implementation for Intersection Box3 Box3 class    //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgIntrBox3Box3.h"
+
+namespace WGSoft3D
+{
+//----------------------------------------------------------------------------
+IntrBox3Box3x::IntrBox3Box3x (const Box3x& rkBox0, const Box3x& rkBox1)
+    :
+    m_rkBox0(rkBox0),
+    m_rkBox1(rkBox1)
+{
+}
+//----------------------------------------------------------------------------
+const Box3x& IntrBox3Box3x::GetBox0 () const
+{
+    return m_rkBox0;
+}
+//----------------------------------------------------------------------------
+const Box3x& IntrBox3Box3x::GetBox1 () const
+{
+    return m_rkBox1;
+}
+//----------------------------------------------------------------------------
+bool IntrBox3Box3x::Test ()
+{
+    // Cutoff for cosine of angles between box axes.  This is used to catch
+    // the cases when at least one pair of axes are parallel.  If this
+    // happens, there is no need to test for separation along the
+    // Cross(A[i],B[j]) directions.
+    const fixed fCutoff = fixed(FIXED_ONE) - Mathx::ZERO_TOLERANCE;
+    bool bExistsParallelPair = false;
+    int i;
+
+    // convenience variables
+    const Vector3x* akA = m_rkBox0.Axis;
+    const Vector3x* akB = m_rkBox1.Axis;
+    const fixed* afEA = m_rkBox0.Extent;
+    const fixed* afEB = m_rkBox1.Extent;
+
+    // compute difference of box centers, D = C1-C0
+    Vector3x kD = m_rkBox1.Center - m_rkBox0.Center;
+
+    fixed aafC[3][3];     // matrix C = A^T B, c_{ij} = Dot(A_i,B_j)
+    fixed aafAbsC[3][3];  // |c_{ij}|
+    fixed afAD[3];        // Dot(A_i,D)
+    fixed fR0, fR1, fR;   // interval radii and distance between centers
+    fixed fR01;           // = R0 + R1
+
+    // axes C0+t*A[i]
+    for (i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            aafC[i][j] = akA[i].Dot(akB[j]);
+            aafAbsC[i][j] = Mathx::FAbs(aafC[i][j]);
+            if (aafAbsC[i][j] > fCutoff)
+            {
+                bExistsParallelPair = true;
+            }
+        }
+        afAD[i] = akA[i].Dot(kD);
+        fR = Mathx::FAbs(afAD[i]);
+        fR1 = afEB[0]*aafAbsC[i][0] + afEB[1]*aafAbsC[i][1] +
+            afEB[2]*aafAbsC[i][2];
+        fR01 = afEA[i] + fR1;
+        if (fR > fR01)
+        {
+            return false;
+        }
+    }
+
+    // axes C0+t*B[i]
+    for (i = 0; i < 3; i++)
+    {
+        fR = Mathx::FAbs(akB[i].Dot(kD));
+        fR0 = afEA[0]*aafAbsC[0][i] + afEA[1]*aafAbsC[1][i] +
+            afEA[2]*aafAbsC[2][i];
+        fR01 = fR0 + afEB[i];
+        if (fR > fR01)
+        {
+            return false;
+        }
+    }
+
+    // At least one pair of box axes was parallel, so the separation is
+    // effectively in 2D where checking the "edge" normals is sufficient for
+    // the separation of the boxes.
+    if (bExistsParallelPair)
+    {
+        return true;
+    }
+
+    // axis C0+t*A0xB0
+    fR = Mathx::FAbs(afAD[2]*aafC[1][0] - afAD[1]*aafC[2][0]);
+    fR0 = afEA[1]*aafAbsC[2][0] + afEA[2]*aafAbsC[1][0];
+    fR1 = afEB[1]*aafAbsC[0][2] + afEB[2]*aafAbsC[0][1];
+    fR01 = fR0 + fR1;
+    if (fR > fR01)
+    {
+        return false;
+    }
+
+    // axis C0+t*A0xB1
+    fR = Mathx::FAbs(afAD[2]*aafC[1][1] - afAD[1]*aafC[2][1]);
+    fR0 = afEA[1]*aafAbsC[2][1] + afEA[2]*aafAbsC[1][1];
+    fR1 = afEB[0]*aafAbsC[0][2] + afEB[2]*aafAbsC[0][0];
+    fR01 = fR0 + fR1;
+    if (fR > fR01)
+    {
+        return false;
+    }
+
+    // axis C0+t*A0xB2
+    fR = Mathx::FAbs(afAD[2]*aafC[1][2] - afAD[1]*aafC[2][2]);
+    fR0 = afEA[1]*aafAbsC[2][2] + afEA[2]*aafAbsC[1][2];
+    fR1 = afEB[0]*aafAbsC[0][1] + afEB[1]*aafAbsC[0][0];
+    fR01 = fR0 + fR1;
+    if (fR > fR01)
+    {
+        return false;
+    }
+
+    // axis C0+t*A1xB0
+    fR = Mathx::FAbs(afAD[0]*aafC[2][0] - afAD[2]*aafC[0][0]);
+    fR0 = afEA[0]*aafAbsC[2][0] + afEA[2]*aafAbsC[0][0];
+    fR1 = afEB[1]*aafAbsC[1][2] + afEB[2]*aafAbsC[1][1];
+    fR01 = fR0 + fR1;
+    if (fR > fR01)
+    {
+        return false;
+    }
+
+    // axis C0+t*A1xB1
+    fR = Mathx::FAbs(afAD[0]*aafC[2][1] - afAD[2]*aafC[0][1]);
+    fR0 = afEA[0]*aafAbsC[2][1] + afEA[2]*aafAbsC[0][1];
+    fR1 = afEB[0]*aafAbsC[1][2] + afEB[2]*aafAbsC[1][0];
+    fR01 = fR0 + fR1;
+    if (fR > fR01)
+    {
+        return false;
+    }
+
+    // axis C0+t*A1xB2
+    fR = Mathx::FAbs(afAD[0]*aafC[2][2] - afAD[2]*aafC[0][2]);
+    fR0 = afEA[0]*aafAbsC[2][2] + afEA[2]*aafAbsC[0][2];
+    fR1 = afEB[0]*aafAbsC[1][1] + afEB[1]*aafAbsC[1][0];
+    fR01 = fR0 + fR1;
+    if (fR > fR01)
+    {
+        return false;
+    }
+
+    // axis C0+t*A2xB0
+    fR = Mathx::FAbs(afAD[1]*aafC[0][0] - afAD[0]*aafC[1][0]);
+    fR0 = afEA[0]*aafAbsC[1][0] + afEA[1]*aafAbsC[0][0];
+    fR1 = afEB[1]*aafAbsC[2][2] + afEB[2]*aafAbsC[2][1];
+    fR01 = fR0 + fR1;
+    if (fR > fR01)
+    {
+        return false;
+    }
+
+    // axis C0+t*A2xB1
+    fR = Mathx::FAbs(afAD[1]*aafC[0][1] - afAD[0]*aafC[1][1]);
+    fR0 = afEA[0]*aafAbsC[1][1] + afEA[1]*aafAbsC[0][1];
+    fR1 = afEB[0]*aafAbsC[2][2] + afEB[2]*aafAbsC[2][0];
+    fR01 = fR0 + fR1;
+    if (fR > fR01)
+    {
+        return false;
+    }
+
+    // axis C0+t*A2xB2
+    fR = Mathx::FAbs(afAD[1]*aafC[0][2] - afAD[0]*aafC[1][2]);
+    fR0 = afEA[0]*aafAbsC[1][2] + afEA[1]*aafAbsC[0][2];
+    fR1 = afEB[0]*aafAbsC[2][1] + afEB[1]*aafAbsC[2][0];
+    fR01 = fR0 + fR1;
+    if (fR > fR01)
+    {
+        return false;
+    }
+
+    return true;
+}
+//----------------------------------------------------------------------------
+}
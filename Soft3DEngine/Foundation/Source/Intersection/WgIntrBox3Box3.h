@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgIntrBox3Box3.h                   //
+//                                                       //
+//  - Interface for Intersection Box3 Box3 class         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_INTRBOX3BOX3_H__
+#define __WG_INTRBOX3BOX3_H__
+
+#include "WgFoundationLIB.h"
+#include "WgIntersector.h"
+#include "WgBox3.h"
+
+namespace WGSoft3D
+{
+
+class WG3D_FOUNDATION_ITEM IntrBox3Box3x : public Intersector3x
+{
+public:
+    IntrBox3Box3x (const Box3x& rkBox0, const Box3x& rkBox1);
+
+    // object access
+    const Box3x& GetBox0 () const;
+    const Box3x& GetBox1 () const;
+
+    // static test-intersection query, by the method of separating axes
+    virtual bool Test ();
+
+private:
+    // the objects to intersect
+    const Box3x& m_rkBox0;
+    const Box3x& m_rkBox1;
+};
+
+}
+
+#endif
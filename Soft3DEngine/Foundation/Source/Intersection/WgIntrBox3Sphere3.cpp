@@ -0,0 +1,57 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgIntrBox3Sphere3.cpp              //
+//                                                       //
+//  - Implementation for Intersection Box3 Sphere3 class //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgIntrBox3Sphere3.h"
+
+namespace WGSoft3D
+{
+//----------------------------------------------------------------------------
+IntrBox3Sphere3x::IntrBox3Sphere3x (const Box3x& rkBox,
+    const Sphere3x& rkSphere)
+    :
+    m_rkBox(rkBox),
+    m_rkSphere(rkSphere)
+{
+}
+//----------------------------------------------------------------------------
+const Box3x& IntrBox3Sphere3x::GetBox () const
+{
+    return m_rkBox;
+}
+//----------------------------------------------------------------------------
+const Sphere3x& IntrBox3Sphere3x::GetSphere () const
+{
+    return m_rkSphere;
+}
+//----------------------------------------------------------------------------
+bool IntrBox3Sphere3x::Test ()
+{
+    // The distances of the sphere center outside of the slabs of the box
+    // are measured in units of the radius, so that their squares stay in
+    // the range of fixed point.
+    Vector3x kDiff = m_rkSphere.Center - m_rkBox.Center;
+    fixed fSqrDistance = fixed(FIXED_ZERO);
+    for (int i = 0; i < 3; i++)
+    {
+        fixed fExcess = Mathx::FAbs(kDiff.Dot(m_rkBox.Axis[i])) -
+            m_rkBox.Extent[i];
+        if (fExcess > FIXED_ZERO)
+        {
+            if (fExcess > m_rkSphere.Radius)
+            {
+                return false;
+            }
+            fExcess /= m_rkSphere.Radius;
+            fSqrDistance += fExcess*fExcess;
+        }
+    }
+    return fSqrDistance <= fixed(FIXED_ONE);
+}
+//----------------------------------------------------------------------------
+}
@@ -0,0 +1,40 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgIntrBox3Sphere3.h                //
+//                                                       //
+//  - Interface for Intersection Box3 Sphere3 class      //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_INTRBOX3SPHERE3_H__
+#define __WG_INTRBOX3SPHERE3_H__
+
+#include "WgFoundationLIB.h"
+#include "WgIntersector.h"
+#include "WgBox3.h"
+#include "WgSphere3.h"
+
+namespace WGSoft3D
+{
+
+class WG3D_FOUNDATION_ITEM IntrBox3Sphere3x : public Intersector3x
+{
+public:
+    IntrBox3Sphere3x (const Box3x& rkBox, const Sphere3x& rkSphere);
+
+    // object access
+    const Box3x& GetBox () const;
+    const Sphere3x& GetSphere () const;
+
+    // static test-intersection query
+    virtual bool Test ();
+
+private:
+    // the objects to intersect
+    const Box3x& m_rkBox;
+    const Sphere3x& m_rkSphere;
+};
+
+}
+
+#endif
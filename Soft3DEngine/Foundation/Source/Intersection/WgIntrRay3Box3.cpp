@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgIntrRay3Box3.cpp                 //
+//                                                       //
+//  - Implementation for Intersection Ray3 Box3 class    //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgIntrRay3Box3.h"
+
+namespace WGSoft3D
+{
+//----------------------------------------------------------------------------
+IntrRay3Box3x::IntrRay3Box3x (const Ray3x& rkRay, const Box3x& rkBox)
+    :
+    m_rkRay(rkRay),
+    m_rkBox(rkBox)
+{
+}
+//----------------------------------------------------------------------------
+const Ray3x& IntrRay3Box3x::GetRay () const
+{
+    return m_rkRay;
+}
+//----------------------------------------------------------------------------
+const Box3x& IntrRay3Box3x::GetBox () const
+{
+    return m_rkBox;
+}
+//----------------------------------------------------------------------------
+bool IntrRay3Box3x::Test ()
+{
+    fixed afWdU[3], afAWdU[3], afDdU[3], afADdU[3], afAWxDdU[3], fRhs;
+
+    Vector3x kDiff = m_rkRay.Origin - m_rkBox.Center;
+
+    // The ray misses when the origin is outside of a slab of the box and
+    // the ray points away from it.  The signs are compared rather than
+    // multiplied, the product of two small fixed values may vanish.
+    int i;
+    for (i = 0; i < 3; i++)
+    {
+        afWdU[i] = m_rkRay.Direction.Dot(m_rkBox.Axis[i]);
+        afAWdU[i] = Mathx::FAbs(afWdU[i]);
+        afDdU[i] = kDiff.Dot(m_rkBox.Axis[i]);
+        afADdU[i] = Mathx::FAbs(afDdU[i]);
+        if (afADdU[i] > m_rkBox.Extent[i]
+        &&  (afWdU[i] == FIXED_ZERO
+        ||   (afWdU[i] > FIXED_ZERO) == (afDdU[i] > FIXED_ZERO)))
+        {
+            return false;
+        }
+    }
+
+    Vector3x kWxD = m_rkRay.Direction.Cross(kDiff);
+
+    afAWxDdU[0] = Mathx::FAbs(kWxD.Dot(m_rkBox.Axis[0]));
+    fRhs = m_rkBox.Extent[1]*afAWdU[2] + m_rkBox.Extent[2]*afAWdU[1];
+    if (afAWxDdU[0] > fRhs)
+    {
+        return false;
+    }
+
+    afAWxDdU[1] = Mathx::FAbs(kWxD.Dot(m_rkBox.Axis[1]));
+    fRhs = m_rkBox.Extent[0]*afAWdU[2] + m_rkBox.Extent[2]*afAWdU[0];
+    if (afAWxDdU[1] > fRhs)
+    {
+        return false;
+    }
+
+    afAWxDdU[2] = Mathx::FAbs(kWxD.Dot(m_rkBox.Axis[2]));
+    fRhs = m_rkBox.Extent[0]*afAWdU[1] + m_rkBox.Extent[1]*afAWdU[0];
+    if (afAWxDdU[2] > fRhs)
+    {
+        return false;
+    }
+
+    return true;
+}
+//----------------------------------------------------------------------------
+}
@@ -0,0 +1,40 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgIntrRay3Box3.h                   //
+//                                                       //
+//  - Interface for Intersection Ray3 Box3 class         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_INTRRAY3BOX3_H__
+#define __WG_INTRRAY3BOX3_H__
+
+#include "WgFoundationLIB.h"
+#include "WgIntersector.h"
+#include "WgRay3.h"
+#include "WgBox3.h"
+
+namespace WGSoft3D
+{
+
+class WG3D_FOUNDATION_ITEM IntrRay3Box3x : public Intersector3x
+{
+public:
+    IntrRay3Box3x (const Ray3x& rkRay, const Box3x& rkBox);
+
+    // object access
+    const Ray3x& GetRay () const;
+    const Box3x& GetBox () const;
+
+    // test-intersection query
+    virtual bool Test ();
+
+private:
+    // the objects to intersect
+    const Ray3x& m_rkRay;
+    const Box3x& m_rkBox;
+};
+
+}
+
+#endif
@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgBox3.cpp                         //
+//                                                       //
+//  - Implementation for Box 3 class                     //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgBox3.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+Box3x::Box3x ()
+{
+    // uninitialized
+}
+//----------------------------------------------------------------------------
+Box3x::Box3x (const Vector3x& rkCenter, const Vector3x* akAxis,
+    const fixed* afExtent)
+    :
+    Center(rkCenter)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        Axis[i] = akAxis[i];
+        Extent[i] = afExtent[i];
+    }
+}
+//----------------------------------------------------------------------------
+Box3x::Box3x (const Vector3x& rkCenter, const Vector3x& rkAxis0,
+    const Vector3x& rkAxis1, const Vector3x& rkAxis2, fixed fExtent0,
+    fixed fExtent1, fixed fExtent2)
+    :
+    Center(rkCenter)
+{
+    Axis[0] = rkAxis0;
+    Axis[1] = rkAxis1;
+    Axis[2] = rkAxis2;
+    Extent[0] = fExtent0;
+    Extent[1] = fExtent1;
+    Extent[2] = fExtent2;
+}
+//----------------------------------------------------------------------------
+void Box3x::ComputeVertices (Vector3x akVertex[8]) const
+{
+    Vector3x akEAxis[3] =
+    {
+        Extent[0]*Axis[0],
+        Extent[1]*Axis[1],
+        Extent[2]*Axis[2]
+    };
+
+    akVertex[0] = Center - akEAxis[0] - akEAxis[1] - akEAxis[2];
+    akVertex[1] = Center + akEAxis[0] - akEAxis[1] - akEAxis[2];
+    akVertex[2] = Center + akEAxis[0] + akEAxis[1] - akEAxis[2];
+    akVertex[3] = Center - akEAxis[0] + akEAxis[1] - akEAxis[2];
+    akVertex[4] = Center - akEAxis[0] - akEAxis[1] + akEAxis[2];
+    akVertex[5] = Center + akEAxis[0] - akEAxis[1] + akEAxis[2];
+    akVertex[6] = Center + akEAxis[0] + akEAxis[1] + akEAxis[2];
+    akVertex[7] = Center - akEAxis[0] + akEAxis[1] + akEAxis[2];
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgBox3.h                           //
+//                                                       //
+//  - Interface for Box 3 class                          //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_BOX_3_H__
+#define __WG_BOX_3_H__
+
+#include "WgFoundationLIB.h"
+#include "WgVector3.h"
+
+namespace WGSoft3D
+{
+
+template <class Real>
+class Box3
+{
+public:
+    // A box has center C, axis directions U[0], U[1], and U[2] (all
+    // unit-length vectors), and extents e[0], e[1], and e[2] (all nonnegative
+    // numbers).  A point X = C+y[0]*U[0]+y[1]*U[1]+y[2]*U[2] is inside or
+    // on the box whenever |y[i]| <= e[i] for all i.
+
+    Box3 ();  // uninitialized
+    Box3 (const Vector3<Real>& rkCenter, const Vector3<Real>* akAxis,
+        const Real* afExtent);
+    Box3 (const Vector3<Real>& rkCenter, const Vector3<Real>& rkAxis0,
+        const Vector3<Real>& rkAxis1, const Vector3<Real>& rkAxis2,
+        Real fExtent0, Real fExtent1, Real fExtent2);
+
+    void ComputeVertices (Vector3<Real> akVertex[8]) const;
+
+    Vector3<Real> Center;
+    Vector3<Real> Axis[3];  // must be an orthonormal set of vectors
+    Real Extent[3];         // must be nonnegative
+};
+
+class WG3D_FOUNDATION_ITEM Box3x
+{
+public:
+    // A box has center C, axis directions U[0], U[1], and U[2] (all
+    // unit-length vectors), and extents e[0], e[1], and e[2] (all nonnegative
+    // numbers).  A point X = C+y[0]*U[0]+y[1]*U[1]+y[2]*U[2] is inside or
+    // on the box whenever |y[i]| <= e[i] for all i.
+
+    Box3x ();  // uninitialized
+    Box3x (const Vector3x& rkCenter, const Vector3x* akAxis,
+        const fixed* afExtent);
+    Box3x (const Vector3x& rkCenter, const Vector3x& rkAxis0,
+        const Vector3x& rkAxis1, const Vector3x& rkAxis2,
+        fixed fExtent0, fixed fExtent1, fixed fExtent2);
+
+    void ComputeVertices (Vector3x akVertex[8]) const;
+
+    Vector3x Center;
+    Vector3x Axis[3];  // must be an orthonormal set of vectors
+    fixed Extent[3];   // must be nonnegative
+};
+
+#include "WgBox3.inl"
+
+typedef Box3<float> Box3f;
+typedef Box3<double> Box3d;
+
+}
+
+#endif
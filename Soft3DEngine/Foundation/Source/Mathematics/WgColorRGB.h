@@ -85,6 +85,8 @@ private:
 
 WG3D_FOUNDATION_ITEM ColorRGB operator* (float fScalar, const ColorRGB& rkC);
 
+WG3D_DECLARE_RELOCATABLE(ColorRGB);
+
 #include "WgColorRGB.inl"
 
 }
@@ -87,6 +87,8 @@ private:
 
 WG3D_FOUNDATION_ITEM ColorRGBA operator* (fixed fScalar, const ColorRGBA& rkC);
 
+WG3D_DECLARE_RELOCATABLE(ColorRGBA);
+
 #include "WgColorRGBA.inl"
 
 }
@@ -14,20 +14,30 @@
 
 namespace WGSoft3D
 {
-const fixed Mathx::EPSILON = FixedFromFloat(FLT_EPSILON);
-const fixed Mathx::ZERO_TOLERANCE = FixedFromFloat(1e-06f);
-const fixed Mathx::MAX_REAL = FixedFromFloat(FLT_MAX);
-const fixed Mathx::PI = FixedFromFloat((float)4.0*atan(1.0));
-const fixed Mathx::TWO_PI = FixedFromFloat((float)(4.0*atan(1.0)*2.0));
-const fixed Mathx::HALF_PI = FixedFromFloat((float)(4.0*atan(1.0)*0.5));
-const fixed Mathx::INV_PI = FixedFromFloat(1.0f/((float)4.0*atan(1.0)));
-const fixed Mathx::INV_TWO_PI = FixedFromFloat(1.0f/((float)(4.0*atan(1.0)*2.0)));
-const fixed Mathx::DEG_TO_RAD = FixedFromFloat(((float)4.0*atan(1.0))/180.0f);
-const fixed Mathx::RAD_TO_DEG = FixedFromFloat(180.0f/((float)4.0*atan(1.0)));
-const fixed Mathx::LN_2 = FixedFromFloat(Math<float>::Log(2.0f));
-const fixed Mathx::LN_10 = FixedFromFloat(Math<float>::Log(10.0f));
-const fixed Mathx::INV_LN_2 = FixedFromFloat(1.0f/(Math<float>::Log(2.0f)));
-const fixed Mathx::INV_LN_10 = FixedFromFloat(1.0f/(Math<float>::Log(10.0f)));
+// The 16.16 constants are built from literals so that they are folded at
+// compile time instead of going through FixedFromFloat at startup.  The
+// float backend keeps the full precision of the literals.
+#if WG_REAL == WG_REAL_FLOAT
+#define MATHX_CONST(x)	fixed::FromFloat((float)(x))
+#define MATHX_MAX_REAL	fixed::FromFloat(FLT_MAX)
+#else
+#define MATHX_CONST(x)	fixed(FIXED_CONST(x))
+#define MATHX_MAX_REAL	fixed(0x7fffffff)
+#endif
+const fixed Mathx::EPSILON = MATHX_CONST(1.1920928955078125e-07);
+const fixed Mathx::ZERO_TOLERANCE = MATHX_CONST(1e-06);
+const fixed Mathx::MAX_REAL = MATHX_MAX_REAL;
+const fixed Mathx::PI = MATHX_CONST(3.14159265358979323846);
+const fixed Mathx::TWO_PI = MATHX_CONST(6.28318530717958647692);
+const fixed Mathx::HALF_PI = MATHX_CONST(1.57079632679489661923);
+const fixed Mathx::INV_PI = MATHX_CONST(0.31830988618379067154);
+const fixed Mathx::INV_TWO_PI = MATHX_CONST(0.15915494309189533577);
+const fixed Mathx::DEG_TO_RAD = MATHX_CONST(0.01745329251994329577);
+const fixed Mathx::RAD_TO_DEG = MATHX_CONST(57.2957795130823208768);
+const fixed Mathx::LN_2 = MATHX_CONST(0.69314718055994530942);
+const fixed Mathx::LN_10 = MATHX_CONST(2.30258509299404568402);
+const fixed Mathx::INV_LN_2 = MATHX_CONST(1.44269504088896340736);
+const fixed Mathx::INV_LN_10 = MATHX_CONST(0.43429448190325182765);
 
 template<> const float Math<float>::EPSILON = FLT_EPSILON;
 template<> const float Math<float>::ZERO_TOLERANCE = 1e-06f;
@@ -67,53 +77,25 @@ template<> const double Math<double>::INV_LN_10 = 1.0/Math<double>::LN_10;
 //----------------------------------------------------------------------------
 fixed Mathx::ACos (fixed fValue)
 {
-    if (fValue>FIXED_NEG_ONE)
-    {
-        if (fValue < FIXED_ONE)
-        {
-            return fixed(FixedFromFloat((float)acos((double)FloatFromFixed(fValue))));
-        }
-        else
-        {
-            return fixed(FIXED_ZERO);
-        }
-    }
-    else
-    {
-        return Mathx::PI;
-    }
+    return acosx(fValue,FIXED_ACCURATE);
 }
 //----------------------------------------------------------------------------
 
 fixed Mathx::ASin (fixed fValue)
 {
-    if ( fValue>FIXED_NEG_ONE)
-    {
-        if (fValue < FIXED_ONE)
-        {
-            return fixed(FixedFromFloat((float)asin((double)FloatFromFixed(fValue))));
-        }
-        else
-        {
-            return Mathx::HALF_PI;
-        }
-    }
-    else
-    {
-        return -Mathx::HALF_PI;
-    }
+    return asinx(fValue,FIXED_ACCURATE);
 }
 //----------------------------------------------------------------------------
 
 fixed Mathx::ATan (fixed fValue)
 {
-    return fixed(FixedFromFloat((float)atan((double)FloatFromFixed(fValue))));
+    return atanx(fValue,FIXED_ACCURATE);
 }
 //----------------------------------------------------------------------------
 
 fixed Mathx::ATan2 (fixed fY, fixed fX)
 {
-    return fixed(FixedFromFloat((float)atan2((double)FloatFromFixed(fY),(double)FloatFromFixed(fX))));
+    return atan2x(fY,fX,FIXED_ACCURATE);
 }
 //----------------------------------------------------------------------------
 
@@ -125,13 +107,13 @@ fixed Mathx::Ceil (fixed fValue)
 
 fixed Mathx::Cos (fixed fValue)
 {
-    return fixed(FixedFromFloat(cos(FloatFromFixed(fValue))));
+    return cosx(fValue,FIXED_ACCURATE);
 }
 //----------------------------------------------------------------------------
 
 fixed Mathx::Exp (fixed fValue)
 {
-    return fixed(FixedFromFloat((float)exp((double)FloatFromFixed(fValue))));
+    return expx(fValue,FIXED_ACCURATE);
 }
 //----------------------------------------------------------------------------
 
@@ -155,14 +137,13 @@ fixed Mathx::FMod (fixed fX, fixed fY)
 
 fixed Mathx::InvSqrt (fixed fValue)
 {
-
-    return fixed(FixedFromFloat((float)(1.0/sqrt(FloatFromFixed(fValue)))));
+    return WGSoft3D::InvSqrt(fValue,FIXED_ACCURATE);
 }
 //----------------------------------------------------------------------------
 
 fixed Mathx::Log (fixed fValue)
 {
-    return fixed(FixedFromFloat((float)log((double)FloatFromFixed(fValue))));
+    return logx(fValue,FIXED_ACCURATE);
 }
 //----------------------------------------------------------------------------
 
@@ -185,7 +166,7 @@ fixed Mathx::Pow (fixed fBase, fixed fExponent)
 //----------------------------------------------------------------------------
 fixed Mathx::Sin (fixed fValue)
 {
-    return fixed(FixedFromFloat(Mathf::Sin(FloatFromFixed(fValue))));
+    return sinx(fValue,FIXED_ACCURATE);
 }
 //----------------------------------------------------------------------------
 
@@ -197,7 +178,7 @@ fixed Mathx::Sqr (fixed fValue)
 
 fixed Mathx::Sqrt (fixed fValue)
 {
-    return fixed(FixedFromFloat(Mathf::Sqrt(FloatFromFixed(fValue))));
+    return xsqrt(fValue,FIXED_ACCURATE);
 }
 //----------------------------------------------------------------------------
 
@@ -199,6 +199,8 @@ private:
     fixed m_afTuple[2];
 };
 
+WG3D_DECLARE_RELOCATABLE(Vector2x);
+
 // arithmetic operations
 template <class Real>
 Vector2<Real> operator* (Real fScalar, const Vector2<Real>& rkV);
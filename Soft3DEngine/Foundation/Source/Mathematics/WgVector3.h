@@ -220,6 +220,8 @@ private:
     fixed m_afTuple[3];
 };
 
+WG3D_DECLARE_RELOCATABLE(Vector3x);
+
 
 // arithmetic operations
 
@@ -21,25 +21,45 @@ THashTable<unsigned int,Object*>* Object::InUse = 0;
 //----------------------------------------------------------------------------
 Object::Object ()
 {
-    m_pkControllerList = 0;
+    m_pkControllerArray = 0;
     m_iReferences = 0;
     m_uiID = ms_uiNextID++;
 
+#ifdef WG_MEMORY_MANAGER
+    // the table belongs to the engine, it is not a leak of the application
+    Memory::BeginStatic();
+#endif
     if (!InUse)
     {
         InUse = WG_NEW THashTable<unsigned int,Object*>(1024);
     }
 
     InUse->Insert(m_uiID,this);
+#ifdef WG_MEMORY_MANAGER
+    Memory::EndStatic();
+#endif
 }
 //----------------------------------------------------------------------------
 Object::~Object ()
 {
     RemoveAllControllers();
     assert(InUse);
+#ifdef WG_MEMORY_MANAGER
+    Memory::BeginStatic();
+#endif
     bool bFound = InUse->Remove(m_uiID);
     assert(bFound);
     (void)bFound;  // avoid compiler warning in release build
+#ifdef WG_MEMORY_MANAGER
+    Memory::EndStatic();
+#endif
+
+    // the table is created again by the next object
+    if (InUse->GetQuantity() == 0)
+    {
+        WG_DELETE InUse;
+        InUse = 0;
+    }
 }
 //----------------------------------------------------------------------------
 void Object::DecrementReferences ()
@@ -72,11 +92,15 @@ void Object::SetController (Controller* pkController)
         return;
     }
 
-    // check if controller is already in the list
-    TList<ControllerPtr>* pkList;
-    for (pkList = m_pkControllerList; pkList; pkList = pkList->Next())
+    // check if controller is already attached
+    if (!m_pkControllerArray)
     {
-        if (pkList->Item() == pkController)
+        m_pkControllerArray = WG_NEW TSmallArray<ControllerPtr,1>;
+    }
+    int i;
+    for (i = 0; i < m_pkControllerArray->GetQuantity(); i++)
+    {
+        if ((*m_pkControllerArray)[i] == pkController)
         {
             // controller already exists, nothing to do
             return;
@@ -86,68 +110,41 @@ void Object::SetController (Controller* pkController)
     // bind controller to object
     pkController->SetObject(this);
 
-    // controller not in current list, add it
-    pkList = WG_NEW TList<ControllerPtr>;
-    pkList->Item() = pkController;
-    pkList->Next() = m_pkControllerList;
-    m_pkControllerList = pkList;
+    m_pkControllerArray->Append(pkController);
+    OnControllerChange();
 }
 //----------------------------------------------------------------------------
 int Object::GetControllerQuantity () const
 {
-    int iControllerQuantity = 0;
-
-    TList<ControllerPtr>* pkList;
-    for (pkList = m_pkControllerList; pkList; pkList = pkList->Next())
-    {
-        iControllerQuantity++;
-    }
-
-    return iControllerQuantity;
+    return (m_pkControllerArray ? m_pkControllerArray->GetQuantity() : 0);
 }
 //----------------------------------------------------------------------------
 Controller* Object::GetController (int i) const
 {
     assert(i >= 0);
 
-    TList<ControllerPtr>* pkList = m_pkControllerList;
-    for (int j = 0; j < i; j++, pkList = pkList->Next())
+    // the most recently attached controller is controller 0
+    int iQuantity = GetControllerQuantity();
+    if (0 <= i && i < iQuantity)
     {
-        if (!pkList)
-        {
-            // i >= iControllerQuantity
-            return 0;
-        }
+        return (*m_pkControllerArray)[iQuantity-1-i];
     }
-    return (pkList ? pkList->Item() : 0);
+    return 0;
 }
 //----------------------------------------------------------------------------
 void Object::RemoveController (Controller* pkController)
 {
-    // check if controller is in list
-    TList<ControllerPtr>* pkList = m_pkControllerList;
-    TList<ControllerPtr>* pkPrev = 0;
-    for (/**/; pkList; pkPrev = pkList, pkList = pkList->Next())
+    int iQuantity = GetControllerQuantity();
+    for (int i = 0; i < iQuantity; i++)
     {
-        if (pkList->Item() == pkController)
+        if ((*m_pkControllerArray)[i] == pkController)
         {
             // unbind controller from object
             pkController->SetObject(0);
 
             // remove the controller
-            if (pkPrev)
-            {
-                // controller not at front of list
-                pkPrev->Next() = pkList->Next();
-            }
-            else
-            {
-                // controller at front of list
-                assert(pkList == m_pkControllerList);
-                m_pkControllerList = pkList->Next();
-            }
-            pkList->Next() = 0;
-            WG_DELETE pkList;
+            m_pkControllerArray->Remove(i);
+            OnControllerChange();
             return;
         }
     }
@@ -155,23 +152,26 @@ void Object::RemoveController (Controller* pkController)
 //----------------------------------------------------------------------------
 void Object::RemoveAllControllers ()
 {
-    while (m_pkControllerList)
+    if (!m_pkControllerArray)
+    {
+        return;
+    }
+
+    for (int i = m_pkControllerArray->GetQuantity() - 1; i >= 0; i--)
     {
-        m_pkControllerList->Item()->SetObject(0);
-        m_pkControllerList->Item() = 0;
-        TList<ControllerPtr>* pkSave = m_pkControllerList->Next();
-        WG_DELETE m_pkControllerList;
-        m_pkControllerList = pkSave;
+        (*m_pkControllerArray)[i]->SetObject(0);
     }
+    WG_DELETE m_pkControllerArray;
+    m_pkControllerArray = 0;
+    OnControllerChange();
 }
 //----------------------------------------------------------------------------
 bool Object::UpdateControllers (double dAppTime)
 {
     bool bSomeoneUpdated = false;
-    TList<ControllerPtr>* pkList;
-    for (pkList = m_pkControllerList; pkList!=NULL; pkList = pkList->Next())
+    for (int i = GetControllerQuantity() - 1; i >= 0; i--)
     {
-        Controller* pkController = pkList->Item();
+        Controller* pkController = (*m_pkControllerArray)[i];
         assert(pkController);
         if (pkController->Update(dAppTime))
         {
@@ -181,6 +181,10 @@ bool Object::UpdateControllers (double dAppTime)
     return bSomeoneUpdated;
 }
 //----------------------------------------------------------------------------
+void Object::OnControllerChange ()
+{
+}
+//----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
 // name and unique id
@@ -192,17 +196,12 @@ Object* Object::GetObjectByName (const String& rkName)
         return this;
     }
 
-    TList<ControllerPtr>* pkList;
-    for (pkList = m_pkControllerList; pkList!=NULL; pkList = pkList->Next())
+    for (int i = GetControllerQuantity() - 1; i >= 0; i--)
     {
-        Controller* pkController = pkList->Item();
-        if (pkController)
+        Object* pkFound = (*m_pkControllerArray)[i]->GetObjectByName(rkName);
+        if (pkFound)
         {
-            Object* pkFound = pkController->GetObjectByName(rkName);
-            if (pkFound)
-            {
-                return pkFound;
-            }
+            return pkFound;
         }
     }
 
@@ -217,14 +216,9 @@ void Object::GetAllObjectsByName (const String& rkName,
         rkObjects.Append(this);
     }
 
-    TList<ControllerPtr>* pkList;
-    for (pkList = m_pkControllerList; pkList!=NULL; pkList = pkList->Next())
+    for (int i = GetControllerQuantity() - 1; i >= 0; i--)
     {
-        Controller* pkController = pkList->Item();
-        if (pkController)
-        {
-            pkController->GetAllObjectsByName(rkName,rkObjects);
-        }
+        (*m_pkControllerArray)[i]->GetAllObjectsByName(rkName,rkObjects);
     }
 }
 //----------------------------------------------------------------------------
@@ -235,17 +229,12 @@ Object* Object::GetObjectByID (unsigned int uiID)
         return this;
     }
 
-    TList<ControllerPtr>* pkList;
-    for (pkList = m_pkControllerList; pkList!=NULL; pkList = pkList->Next())
+    for (int i = GetControllerQuantity() - 1; i >= 0; i--)
     {
-        Controller* pkController = pkList->Item();
-        if (pkController)
+        Object* pkFound = (*m_pkControllerArray)[i]->GetObjectByID(uiID);
+        if (pkFound)
         {
-            Object* pkFound = pkController->GetObjectByID(uiID);
-            if (pkFound)
-            {
-                return pkFound;
-            }
+            return pkFound;
         }
     }
 
@@ -48,9 +48,15 @@ public:
     void RemoveController (Controller* pkController);
     void RemoveAllControllers ();
     bool UpdateControllers (double dAppTime);
+protected:
+    // called after a controller is attached or removed
+    virtual void OnControllerChange ();
 private:
-    // controllers (Pointer used directly to avoid circular headers)
-    TList<Pointer<Controller> >* m_pkControllerList;
+    // Controllers, in the order of attachment, so GetController(0) is the
+    // last element.  The array is allocated with the first controller, so
+    // an object without controllers pays for a pointer only.  Pointer is
+    // used directly to avoid circular headers.
+    TSmallArray<Pointer<Controller>,1>* m_pkControllerArray;
 
 // name-ID system
 public:
@@ -71,6 +77,8 @@ public:
     void IncrementReferences ();
     void DecrementReferences ();
     int GetReferences () const;
+
+    // the objects that exist by their IDs, null when there are none
     static THashTable<unsigned int,Object*>* InUse;
 private:
     int m_iReferences;
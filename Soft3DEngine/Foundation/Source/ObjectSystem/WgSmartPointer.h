@@ -48,6 +48,14 @@ protected:
     T* m_pkObject;
 };
 
+// The reference count is in the object, so a pointer may be relocated.
+template <class T>
+class TRelocatable<Pointer<T> >
+{
+public:
+    enum { VALUE = 1 };
+};
+
 #include "WgSmartPointer.inl"
 
 }
@@ -22,8 +22,9 @@ BindInfo::BindInfo ()
 //----------------------------------------------------------------------------
 BindInfoArray::BindInfoArray (int iQuantity, int iGrowBy)
     :
-    m_kBind(iQuantity,iGrowBy)
+    m_kBind(iGrowBy)
 {
+    m_kBind.Reserve(iQuantity);
 }
 //----------------------------------------------------------------------------
 const TArray<BindInfo>& BindInfoArray::GetArray () const
@@ -14,7 +14,7 @@
 
 #include "WgFoundationLIB.h"
 #include "WgSystem.h"
-#include "WgTArray.h"
+#include "WgTSmallArray.h"
 
 namespace WGSoft3D
 {
@@ -35,6 +35,8 @@ public:
     char ID[8];
 };
 
+WG3D_DECLARE_RELOCATABLE(BindInfo);
+
 class WG3D_FOUNDATION_ITEM BindInfoArray
 {
 public:
@@ -47,7 +49,9 @@ public:
     void GetID (Renderer* pkUser, int iSize, void* pvID);
 
 private:
-    TArray<BindInfo> m_kBind;
+    // A resource is usually bound to one renderer, so the first binding
+    // does not allocate.
+    TSmallArray<BindInfo,1> m_kBind;
 };
 
 };
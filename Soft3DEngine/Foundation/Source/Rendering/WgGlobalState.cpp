@@ -41,6 +41,10 @@ GlobalState::~GlobalState ()
 
 void GlobalState::SetGlobalStates()
 {
+#ifdef WG_MEMORY_MANAGER
+	// the default states live to the end of the program
+	Memory::BeginStatic();
+#endif
 	if(!Default[ALPHA])
 		Default[ALPHA]=new AlphaState();
 	if(!Default[CULL])
@@ -59,6 +63,9 @@ void GlobalState::SetGlobalStates()
 		Default[STENCIL]=new StencilState();
 	if(!Default[ZBUFFER])
 		Default[ZBUFFER]=new ZBufferState();
+#ifdef WG_MEMORY_MANAGER
+	Memory::EndStatic();
+#endif
 }
 //----------------------------------------------------------------------------
 
@@ -0,0 +1,367 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgRenderQueue.cpp                  //
+//                                                       //
+//  - Implementation for Render Queue class              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgRenderQueue.h"
+#include "WgCamera.h"
+#include "WgEffect.h"
+#include "WgGeometry.h"
+#include "WgTexture.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+RenderQueue::RenderQueue ()
+    :
+    m_kEffectType(0,8)
+{
+    m_iQuantity = 0;
+    m_iMaxQuantity = 0;
+    m_auiKey = 0;
+    m_auiTmpKey = 0;
+    m_aiIndex = 0;
+    m_aiTmpIndex = 0;
+    m_apkObject = 0;
+    m_abIsGeometry = 0;
+    m_fDMin = FIXED_ZERO;
+    m_fDMax = FIXED_ONE;
+    m_bHasCamera = false;
+    m_iOpaqueQuantity = 0;
+    m_iTransparentQuantity = 0;
+    m_iStateChanges = 0;
+    m_iUnsortedStateChanges = 0;
+    m_iTextureChanges = 0;
+    m_iUnsortedTextureChanges = 0;
+}
+//----------------------------------------------------------------------------
+RenderQueue::~RenderQueue ()
+{
+    WG_DELETE[] m_auiKey;
+    WG_DELETE[] m_auiTmpKey;
+    WG_DELETE[] m_aiIndex;
+    WG_DELETE[] m_aiTmpIndex;
+    WG_DELETE[] m_apkObject;
+    WG_DELETE[] m_abIsGeometry;
+}
+//----------------------------------------------------------------------------
+void RenderQueue::Reserve (int iQuantity)
+{
+    if (iQuantity <= m_iMaxQuantity)
+    {
+        return;
+    }
+
+    // the contents are rebuilt by every Sort, so nothing is copied
+    int iMaxQuantity = 2*m_iMaxQuantity;
+    if (iMaxQuantity < iQuantity)
+    {
+        iMaxQuantity = iQuantity;
+    }
+
+    WG_DELETE[] m_auiKey;
+    WG_DELETE[] m_auiTmpKey;
+    WG_DELETE[] m_aiIndex;
+    WG_DELETE[] m_aiTmpIndex;
+    WG_DELETE[] m_apkObject;
+    WG_DELETE[] m_abIsGeometry;
+
+    m_iMaxQuantity = iMaxQuantity;
+    m_auiKey = WG_NEW unsigned __int64[m_iMaxQuantity];
+    m_auiTmpKey = WG_NEW unsigned __int64[m_iMaxQuantity];
+    m_aiIndex = WG_NEW int[m_iMaxQuantity];
+    m_aiTmpIndex = WG_NEW int[m_iMaxQuantity];
+    m_apkObject = WG_NEW Spatial*[m_iMaxQuantity];
+    m_abIsGeometry = WG_NEW bool[m_iMaxQuantity];
+}
+//----------------------------------------------------------------------------
+void RenderQueue::Sort (int iQuantity, Spatial* const* apkObject,
+    const bool* abIsGeometry, const Camera* pkCamera)
+{
+    Reserve(iQuantity);
+    m_iQuantity = iQuantity;
+    m_iOpaqueQuantity = 0;
+    m_iTransparentQuantity = 0;
+
+    m_bHasCamera = (pkCamera != 0);
+    if (m_bHasCamera)
+    {
+        m_kEye = pkCamera->GetWorldLocation();
+        m_kDirection = pkCamera->GetWorldDVector();
+        m_fDMin = pkCamera->GetFrustum()[Camera::VF_DMIN];
+        m_fDMax = pkCamera->GetFrustum()[Camera::VF_DMAX];
+    }
+
+    int i;
+    for (i = 0; i < iQuantity; i++)
+    {
+        if (abIsGeometry[i])
+        {
+            bool bTransparent;
+            m_auiKey[i] = GetKey((Geometry*)apkObject[i],bTransparent);
+            if (bTransparent)
+            {
+                m_iTransparentQuantity++;
+            }
+            else
+            {
+                m_iOpaqueQuantity++;
+            }
+        }
+        else
+        {
+            // the sort is stable, so the nodes keep their order
+            m_auiKey[i] = ((unsigned __int64)BUCKET_NODE) << 56;
+        }
+        m_aiIndex[i] = i;
+    }
+
+    RadixSort(iQuantity,m_auiKey,m_aiIndex,m_auiTmpKey,m_aiTmpIndex);
+
+    for (i = 0; i < iQuantity; i++)
+    {
+        m_apkObject[i] = apkObject[m_aiIndex[i]];
+        m_abIsGeometry[i] = abIsGeometry[m_aiIndex[i]];
+    }
+
+    CountChanges(iQuantity,apkObject,abIsGeometry,m_iUnsortedStateChanges,
+        m_iUnsortedTextureChanges);
+    CountChanges(iQuantity,m_apkObject,m_abIsGeometry,m_iStateChanges,
+        m_iTextureChanges);
+}
+//----------------------------------------------------------------------------
+void RenderQueue::RadixSort (int iQuantity, unsigned __int64* auiKey,
+    int* aiValue, unsigned __int64* auiTmpKey, int* aiTmpValue)
+{
+    if (iQuantity <= 1)
+    {
+        return;
+    }
+
+    // the histograms of all eight bytes in one pass
+    int aaiCount[8][256];
+    memset(aaiCount,0,8*256*sizeof(int));
+    int i, j, iByte;
+    for (i = 0; i < iQuantity; i++)
+    {
+        unsigned __int64 uiKey = auiKey[i];
+        for (iByte = 0; iByte < 8; iByte++)
+        {
+            aaiCount[iByte][(unsigned int)(uiKey >> (8*iByte)) & 0xFF]++;
+        }
+    }
+
+    unsigned __int64* auiSrcKey = auiKey;
+    unsigned __int64* auiDstKey = auiTmpKey;
+    int* aiSrcValue = aiValue;
+    int* aiDstValue = aiTmpValue;
+    for (iByte = 0; iByte < 8; iByte++)
+    {
+        // A byte that is the same in all the keys leaves the order as it
+        // is.  In practice most of the high bytes are skipped.
+        int iShift = 8*iByte;
+        int* aiCount = aaiCount[iByte];
+        if (aiCount[(unsigned int)(auiSrcKey[0] >> iShift) & 0xFF]
+            == iQuantity)
+        {
+            continue;
+        }
+
+        int iSum = 0;
+        for (j = 0; j < 256; j++)
+        {
+            int iCount = aiCount[j];
+            aiCount[j] = iSum;
+            iSum += iCount;
+        }
+
+        for (i = 0; i < iQuantity; i++)
+        {
+            int iDst = aiCount[(unsigned int)(auiSrcKey[i] >> iShift) & 0xFF]++;
+            auiDstKey[iDst] = auiSrcKey[i];
+            aiDstValue[iDst] = aiSrcValue[i];
+        }
+
+        unsigned __int64* auiKeySave = auiSrcKey;
+        auiSrcKey = auiDstKey;
+        auiDstKey = auiKeySave;
+        int* aiValueSave = aiSrcValue;
+        aiSrcValue = aiDstValue;
+        aiDstValue = aiValueSave;
+    }
+
+    if (auiSrcKey != auiKey)
+    {
+        memcpy(auiKey,auiSrcKey,iQuantity*sizeof(unsigned __int64));
+        memcpy(aiValue,aiSrcValue,iQuantity*sizeof(int));
+    }
+}
+//----------------------------------------------------------------------------
+unsigned __int64 RenderQueue::GetKey (Geometry* pkGeometry,
+    bool& rbTransparent)
+{
+    AlphaState* pkAlpha = StaticCast<AlphaState>(
+        pkGeometry->States[GlobalState::ALPHA]);
+    rbTransparent = (pkAlpha && pkAlpha->BlendEnabled);
+
+    unsigned __int64 uiEffect = GetEffectType(pkGeometry);     // 8 bits
+    unsigned __int64 uiTexture = GetTextureHash(pkGeometry);   // 16 bits
+    unsigned __int64 uiState = GetStateHash(pkGeometry);       // 16 bits
+    unsigned __int64 uiDepth = GetDepth(pkGeometry);           // 16 bits
+
+    if (!rbTransparent)
+    {
+        // state first, then front to back
+        return (((unsigned __int64)BUCKET_OPAQUE) << 56) | (uiEffect << 48)
+            | (uiTexture << 32) | (uiState << 16) | uiDepth;
+    }
+
+    // back to front first, then state
+    return (((unsigned __int64)BUCKET_TRANSPARENT) << 56)
+        | ((0xFFFF - uiDepth) << 40) | (uiEffect << 32) | (uiTexture << 16)
+        | uiState;
+}
+//----------------------------------------------------------------------------
+unsigned int RenderQueue::GetEffectType (const Geometry* pkGeometry)
+{
+    Effect* pkEffect = pkGeometry->GetEffect();
+    if (!pkEffect)
+    {
+        return 0;
+    }
+
+    // Applications use a handful of effect classes, a linear search is
+    // all it takes.  Classes beyond 254 share the last value.
+    const Rtti* pkType = &pkEffect->GetType();
+    int iQuantity = m_kEffectType.GetQuantity();
+    for (int i = 0; i < iQuantity; i++)
+    {
+        if (m_kEffectType[i] == pkType)
+        {
+            return (unsigned int)(i + 1);
+        }
+    }
+
+    if (iQuantity < 254)
+    {
+        m_kEffectType.Append(pkType);
+        return (unsigned int)(iQuantity + 1);
+    }
+    return 255;
+}
+//----------------------------------------------------------------------------
+unsigned int RenderQueue::GetDepth (const Geometry* pkGeometry) const
+{
+    if (!m_bHasCamera)
+    {
+        return 0;
+    }
+
+    fixed fDepth = m_kDirection.Dot(pkGeometry->WorldBound->GetCenter() -
+        m_kEye);
+    if (fDepth <= m_fDMin)
+    {
+        return 0;
+    }
+    if (fDepth >= m_fDMax)
+    {
+        return 0xFFFF;
+    }
+
+    // the fraction of the way from the near plane to the far plane
+    fixed fT = (fDepth - m_fDMin)/(m_fDMax - m_fDMin);
+    return (unsigned int)FractionFromFixed(fT) & 0xFFFF;
+}
+//----------------------------------------------------------------------------
+unsigned int RenderQueue::GetTextureHash (const Geometry* pkGeometry)
+{
+    unsigned int uiHash = 0;
+    Effect* pkEffect = pkGeometry->GetEffect();
+    if (pkEffect)
+    {
+        for (int i = 0; i < pkEffect->Textures.GetQuantity(); i++)
+        {
+            Texture* pkTexture = pkEffect->Textures[i];
+            uiHash = 31*uiHash + (pkTexture ? pkTexture->GetID() : 0);
+        }
+    }
+    return (uiHash ^ (uiHash >> 16)) & 0xFFFF;
+}
+//----------------------------------------------------------------------------
+unsigned int RenderQueue::GetStateHash (const Geometry* pkGeometry)
+{
+    unsigned int uiHash = 0;
+    for (int i = 0; i < GlobalState::MAX_STATE; i++)
+    {
+        GlobalState* pkState = pkGeometry->States[i];
+        uiHash = 31*uiHash + (pkState ? pkState->GetID() : 0);
+    }
+    return (uiHash ^ (uiHash >> 16)) & 0xFFFF;
+}
+//----------------------------------------------------------------------------
+bool RenderQueue::SameTextures (const Geometry* pkG0, const Geometry* pkG1)
+{
+    Effect* pkE0 = pkG0->GetEffect();
+    Effect* pkE1 = pkG1->GetEffect();
+    int iQuantity0 = (pkE0 ? pkE0->Textures.GetQuantity() : 0);
+    int iQuantity1 = (pkE1 ? pkE1->Textures.GetQuantity() : 0);
+    if (iQuantity0 != iQuantity1)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < iQuantity0; i++)
+    {
+        if (pkE0->Textures[i] != pkE1->Textures[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+bool RenderQueue::SameStates (const Geometry* pkG0, const Geometry* pkG1)
+{
+    for (int i = 0; i < GlobalState::MAX_STATE; i++)
+    {
+        if (pkG0->States[i] != pkG1->States[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+void RenderQueue::CountChanges (int iQuantity, Spatial* const* apkObject,
+    const bool* abIsGeometry, int& riStates, int& riTextures) const
+{
+    riStates = 0;
+    riTextures = 0;
+
+    const Geometry* pkPrevious = 0;
+    for (int i = 0; i < iQuantity; i++)
+    {
+        if (!abIsGeometry[i])
+        {
+            continue;
+        }
+
+        const Geometry* pkGeometry = (const Geometry*)apkObject[i];
+        if (pkPrevious)
+        {
+            if (!SameStates(pkPrevious,pkGeometry))
+            {
+                riStates++;
+            }
+            if (!SameTextures(pkPrevious,pkGeometry))
+            {
+                riTextures++;
+            }
+        }
+        pkPrevious = pkGeometry;
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgRenderQueue.h                    //
+//                                                       //
+//  - Interface for Render Queue class                   //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_RENDERQUEUE_H__
+#define __WG_RENDERQUEUE_H__
+
+#include "WgFoundationLIB.h"
+#include "WgVector3.h"
+#include "WgTArray.h"
+
+namespace WGSoft3D
+{
+
+class Camera;
+class Geometry;
+class Rtti;
+class Spatial;
+
+// The drawing order of the deferred objects (Renderer::DrawDeferredSorted).
+// Every object gets a 64-bit key and the keys are radix sorted, so the cost
+// is linear in the number of objects.  The top byte of a key selects the
+// bucket:
+//   0  Geometry without blending, sorted by effect type, textures, global
+//      states and then front to back, so that objects with the same state
+//      are drawn together and hidden pixels fail the depth test early;
+//   1  Nodes with a global effect, in traversal order;
+//   2  Geometry whose AlphaState has blending enabled, sorted back to front
+//      and then by the same state, so that blending composes correctly.
+// The view depth of an object is the depth of its world bound center
+// between the near and far planes of the camera, quantized to 16 bits.
+// Textures and global states are identified by hashes of their object IDs,
+// so different states rarely share a key; that only affects the grouping,
+// never what is drawn.
+
+class WG3D_FOUNDATION_ITEM RenderQueue
+{
+public:
+    RenderQueue ();
+    ~RenderQueue ();
+
+    // Sort the deferred objects.  The camera may be null, then all the
+    // objects have the same depth.
+    void Sort (int iQuantity, Spatial* const* apkObject,
+        const bool* abIsGeometry, const Camera* pkCamera);
+
+    // the objects in drawing order
+    int GetQuantity () const;
+    Spatial* GetObject (int i) const;
+    bool IsGeometry (int i) const;
+    int GetOpaqueQuantity () const;
+    int GetTransparentQuantity () const;
+
+    // The number of Geometry draws that change the global states or the
+    // textures of the draw before, in the sorted order and in the traversal
+    // order.  The differences are the changes saved by sorting.
+    int GetStateChanges (bool bSorted = true) const;
+    int GetTextureChanges (bool bSorted = true) const;
+
+    // Sort the keys in increasing order and permute the values the same
+    // way.  The sort is stable.  The temporary arrays must have iQuantity
+    // elements.
+    static void RadixSort (int iQuantity, unsigned __int64* auiKey,
+        int* aiValue, unsigned __int64* auiTmpKey, int* aiTmpValue);
+
+private:
+    enum
+    {
+        BUCKET_OPAQUE = 0,
+        BUCKET_NODE = 1,
+        BUCKET_TRANSPARENT = 2
+    };
+
+    void Reserve (int iQuantity);
+    unsigned __int64 GetKey (Geometry* pkGeometry, bool& rbTransparent);
+    unsigned int GetEffectType (const Geometry* pkGeometry);
+    unsigned int GetDepth (const Geometry* pkGeometry) const;
+    static unsigned int GetTextureHash (const Geometry* pkGeometry);
+    static unsigned int GetStateHash (const Geometry* pkGeometry);
+    static bool SameTextures (const Geometry* pkG0, const Geometry* pkG1);
+    static bool SameStates (const Geometry* pkG0, const Geometry* pkG1);
+    void CountChanges (int iQuantity, Spatial* const* apkObject,
+        const bool* abIsGeometry, int& riStates, int& riTextures) const;
+
+    // sort buffers
+    int m_iQuantity, m_iMaxQuantity;
+    unsigned __int64* m_auiKey;
+    unsigned __int64* m_auiTmpKey;
+    int* m_aiIndex;
+    int* m_aiTmpIndex;
+
+    // the sorted objects
+    Spatial** m_apkObject;
+    bool* m_abIsGeometry;
+
+    // effect types seen so far, the index+1 is the key field
+    TArray<const Rtti*> m_kEffectType;
+
+    // view depth parameters of the current Sort
+    Vector3x m_kEye, m_kDirection;
+    fixed m_fDMin, m_fDMax;
+    bool m_bHasCamera;
+
+    // statistics of the most recent Sort
+    int m_iOpaqueQuantity, m_iTransparentQuantity;
+    int m_iStateChanges, m_iUnsortedStateChanges;
+    int m_iTextureChanges, m_iUnsortedTextureChanges;
+};
+
+#include "WgRenderQueue.inl"
+
+}
+
+#endif
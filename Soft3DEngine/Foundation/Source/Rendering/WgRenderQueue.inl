@@ -0,0 +1,46 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgRenderQueue.inl                  //
+//                                                       //
+//  - Inlines for Render Queue class                     //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+inline int RenderQueue::GetQuantity () const
+{
+    return m_iQuantity;
+}
+//----------------------------------------------------------------------------
+inline Spatial* RenderQueue::GetObject (int i) const
+{
+    assert(0 <= i && i < m_iQuantity);
+    return m_apkObject[i];
+}
+//----------------------------------------------------------------------------
+inline bool RenderQueue::IsGeometry (int i) const
+{
+    assert(0 <= i && i < m_iQuantity);
+    return m_abIsGeometry[i];
+}
+//----------------------------------------------------------------------------
+inline int RenderQueue::GetOpaqueQuantity () const
+{
+    return m_iOpaqueQuantity;
+}
+//----------------------------------------------------------------------------
+inline int RenderQueue::GetTransparentQuantity () const
+{
+    return m_iTransparentQuantity;
+}
+//----------------------------------------------------------------------------
+inline int RenderQueue::GetStateChanges (bool bSorted) const
+{
+    return (bSorted ? m_iStateChanges : m_iUnsortedStateChanges);
+}
+//----------------------------------------------------------------------------
+inline int RenderQueue::GetTextureChanges (bool bSorted) const
+{
+    return (bSorted ? m_iTextureChanges : m_iUnsortedTextureChanges);
+}
+//----------------------------------------------------------------------------
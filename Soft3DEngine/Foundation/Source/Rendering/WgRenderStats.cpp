@@ -0,0 +1,280 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgRenderStats.cpp                  //
+//                                                       //
+//  - Implementation for Render Statistics class         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgRenderStats.h"
+#include "WgGeometry.h"
+using namespace WGSoft3D;
+
+double RenderStats::ms_dUpdateTime = 0.0;
+
+// The integer fields of a frame in the order of the CSV columns and the JSON
+// members, followed by the three times in milliseconds.
+static const char* gs_aacCountName[] =
+{
+    "frame",
+    "nodes_visited",
+    "nodes_culled",
+    "culled_left",
+    "culled_right",
+    "culled_bottom",
+    "culled_top",
+    "culled_near",
+    "culled_far",
+    "culled_user",
+    "geometry_drawn",
+    "draw_calls",
+    "triangles",
+    "set_alpha",
+    "set_cull",
+    "set_dither",
+    "set_fog",
+    "set_material",
+    "set_polygon_offset",
+    "set_shade",
+    "set_zbuffer",
+    "set_stencil",
+    "texture_binds",
+    "texture_uploads",
+    "texture_bytes",
+    "buffer_creations",
+    "buffer_bytes",
+    "array_releases"
+};
+
+static const int gs_iCountQuantity =
+    (int)(sizeof(gs_aacCountName)/sizeof(gs_aacCountName[0]));
+
+static const char* gs_aacTimeName[3] =
+{
+    "update_ms",
+    "cull_ms",
+    "draw_ms"
+};
+
+//----------------------------------------------------------------------------
+static void GetCounts (const RenderStats::Frame& rkFrame, int* aiCount)
+{
+    int iC = 0, i;
+    aiCount[iC++] = rkFrame.Index;
+    aiCount[iC++] = rkFrame.NodesVisited;
+    aiCount[iC++] = rkFrame.NodesCulled;
+    for (i = 0; i < RenderStats::CULL_PLANES; i++)
+    {
+        aiCount[iC++] = rkFrame.CulledByPlane[i];
+    }
+    aiCount[iC++] = rkFrame.GeometryDrawn;
+    aiCount[iC++] = rkFrame.DrawCalls;
+    aiCount[iC++] = rkFrame.Triangles;
+    for (i = 0; i < GlobalState::MAX_STATE; i++)
+    {
+        aiCount[iC++] = rkFrame.StateSets[i];
+    }
+    aiCount[iC++] = rkFrame.TextureBinds;
+    aiCount[iC++] = rkFrame.TextureUploads;
+    aiCount[iC++] = rkFrame.TextureBytes;
+    aiCount[iC++] = rkFrame.BufferCreations;
+    aiCount[iC++] = rkFrame.BufferBytes;
+    aiCount[iC++] = rkFrame.ArrayReleases;
+    assert(iC == gs_iCountQuantity);
+}
+//----------------------------------------------------------------------------
+static void GetTimes (const RenderStats::Frame& rkFrame, double* adTime)
+{
+    adTime[0] = 1000.0*rkFrame.UpdateTime;
+    adTime[1] = 1000.0*rkFrame.CullTime;
+    adTime[2] = 1000.0*rkFrame.DrawTime;
+}
+//----------------------------------------------------------------------------
+RenderStats::Frame::Frame ()
+{
+    Index = 0;
+    Reset();
+}
+//----------------------------------------------------------------------------
+void RenderStats::Frame::Reset ()
+{
+    int i;
+    NodesVisited = 0;
+    NodesCulled = 0;
+    for (i = 0; i < CULL_PLANES; i++)
+    {
+        CulledByPlane[i] = 0;
+    }
+    GeometryDrawn = 0;
+    DrawCalls = 0;
+    Triangles = 0;
+    for (i = 0; i < GlobalState::MAX_STATE; i++)
+    {
+        StateSets[i] = 0;
+    }
+    TextureBinds = 0;
+    TextureUploads = 0;
+    TextureBytes = 0;
+    BufferCreations = 0;
+    BufferBytes = 0;
+    ArrayReleases = 0;
+    UpdateTime = 0.0;
+    CullTime = 0.0;
+    DrawTime = 0.0;
+}
+//----------------------------------------------------------------------------
+RenderStats::RenderStats (int iMaxHistoryQuantity)
+{
+    m_akHistory = 0;
+    m_iMaxHistoryQuantity = 0;
+    m_oCallback = 0;
+    m_pvCallbackData = 0;
+    SetMaxHistoryQuantity(iMaxHistoryQuantity);
+    Clear();
+}
+//----------------------------------------------------------------------------
+RenderStats::~RenderStats ()
+{
+    WG_DELETE[] m_akHistory;
+}
+//----------------------------------------------------------------------------
+void RenderStats::SetMaxHistoryQuantity (int iMaxHistoryQuantity)
+{
+    assert(iMaxHistoryQuantity > 0);
+    if (iMaxHistoryQuantity != m_iMaxHistoryQuantity)
+    {
+        WG_DELETE[] m_akHistory;
+        m_akHistory = WG_NEW Frame[iMaxHistoryQuantity];
+        m_iMaxHistoryQuantity = iMaxHistoryQuantity;
+    }
+    m_iHistoryQuantity = 0;
+    m_iNext = 0;
+}
+//----------------------------------------------------------------------------
+void RenderStats::Clear ()
+{
+    m_iHistoryQuantity = 0;
+    m_iNext = 0;
+    m_iFrameQuantity = 0;
+    m_kCurrent.Index = 0;
+    m_kCurrent.Reset();
+}
+//----------------------------------------------------------------------------
+void RenderStats::EndFrame ()
+{
+    m_kCurrent.UpdateTime += ms_dUpdateTime;
+    ms_dUpdateTime = 0.0;
+
+    m_akHistory[m_iNext] = m_kCurrent;
+    if (++m_iNext == m_iMaxHistoryQuantity)
+    {
+        m_iNext = 0;
+    }
+    if (m_iHistoryQuantity < m_iMaxHistoryQuantity)
+    {
+        m_iHistoryQuantity++;
+    }
+    m_iFrameQuantity++;
+
+    if (m_oCallback)
+    {
+        m_oCallback(m_kCurrent,m_pvCallbackData);
+    }
+
+    m_kCurrent.Index++;
+    m_kCurrent.Reset();
+}
+//----------------------------------------------------------------------------
+void RenderStats::WriteCSV (FILE* pkFile) const
+{
+    WriteCSVHeader(pkFile);
+    for (int i = m_iHistoryQuantity-1; i >= 0; i--)
+    {
+        WriteCSVRow(pkFile,GetHistory(i));
+    }
+}
+//----------------------------------------------------------------------------
+void RenderStats::WriteJSON (FILE* pkFile) const
+{
+    fprintf(pkFile,"[");
+    for (int i = m_iHistoryQuantity-1; i >= 0; i--)
+    {
+        fprintf(pkFile,"\n");
+        WriteJSONObject(pkFile,GetHistory(i));
+        if (i > 0)
+        {
+            fprintf(pkFile,",");
+        }
+    }
+    fprintf(pkFile,"\n]\n");
+}
+//----------------------------------------------------------------------------
+void RenderStats::WriteCSVHeader (FILE* pkFile)
+{
+    int i;
+    for (i = 0; i < gs_iCountQuantity; i++)
+    {
+        fprintf(pkFile,i > 0 ? ",%s" : "%s",gs_aacCountName[i]);
+    }
+    for (i = 0; i < 3; i++)
+    {
+        fprintf(pkFile,",%s",gs_aacTimeName[i]);
+    }
+    fprintf(pkFile,"\n");
+}
+//----------------------------------------------------------------------------
+void RenderStats::WriteCSVRow (FILE* pkFile, const Frame& rkFrame)
+{
+    int aiCount[gs_iCountQuantity];
+    double adTime[3];
+    GetCounts(rkFrame,aiCount);
+    GetTimes(rkFrame,adTime);
+
+    int i;
+    for (i = 0; i < gs_iCountQuantity; i++)
+    {
+        fprintf(pkFile,i > 0 ? ",%d" : "%d",aiCount[i]);
+    }
+    for (i = 0; i < 3; i++)
+    {
+        fprintf(pkFile,",%.4f",adTime[i]);
+    }
+    fprintf(pkFile,"\n");
+}
+//----------------------------------------------------------------------------
+void RenderStats::WriteJSONObject (FILE* pkFile, const Frame& rkFrame)
+{
+    int aiCount[gs_iCountQuantity];
+    double adTime[3];
+    GetCounts(rkFrame,aiCount);
+    GetTimes(rkFrame,adTime);
+
+    int i;
+    fprintf(pkFile,"{");
+    for (i = 0; i < gs_iCountQuantity; i++)
+    {
+        fprintf(pkFile,i > 0 ? ",\"%s\":%d" : "\"%s\":%d",
+            gs_aacCountName[i],aiCount[i]);
+    }
+    for (i = 0; i < 3; i++)
+    {
+        fprintf(pkFile,",\"%s\":%.4f",gs_aacTimeName[i],adTime[i]);
+    }
+    fprintf(pkFile,"}");
+}
+//----------------------------------------------------------------------------
+int RenderStats::GetTriangleQuantity (int eType, int iQuantity)
+{
+    switch (eType)
+    {
+    case Geometry::GT_TRIMESH:
+        return iQuantity/3;
+    case Geometry::GT_TRISTRIP:
+    case Geometry::GT_TRIFAN:
+        return (iQuantity > 2 ? iQuantity-2 : 0);
+    default:
+        return 0;
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,138 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgRenderStats.h                    //
+//                                                       //
+//  - Interface for Render Statistics class              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_RENDERSTATS_H__
+#define __WG_RENDERSTATS_H__
+
+#include "WgFoundationLIB.h"
+#include "WgSystem.h"
+#include "WgGlobalState.h"
+
+// The statistics are gathered only when WG3D_RENDER_STATS is defined for the
+// whole build.  Otherwise the renderer has no RenderStats member and every
+// WG3D_RENDER_STATS_DO statement expands to nothing, so the counting costs
+// nothing.  The statement must not contain a comma outside of parentheses.
+#ifdef WG3D_RENDER_STATS
+#define WG3D_RENDER_STATS_DO(kStatement) kStatement
+#else
+#define WG3D_RENDER_STATS_DO(kStatement)
+#endif
+
+namespace WGSoft3D
+{
+
+// The counts and times of the frames drawn by a renderer.  The scene graph
+// core counts the traversal (Spatial::OnDraw, Camera::Culled), the Geometry
+// drawn and the global states set, the OpenGL ES renderers count what they
+// hand to the driver.  The application ends each frame with EndFrame, after
+// its DisplayBackBuffer; the frame is then appended to a history of the most
+// recent frames and passed to the frame callback.
+
+class WG3D_FOUNDATION_ITEM RenderStats
+{
+public:
+    RenderStats (int iMaxHistoryQuantity = 128);
+    ~RenderStats ();
+
+    enum
+    {
+        // the six frustum planes of Camera, then one count for all the
+        // planes pushed by the application
+        CULL_PLANES = 7
+    };
+
+    class WG3D_FOUNDATION_ITEM Frame
+    {
+    public:
+        Frame ();
+        void Reset ();
+
+        // the number of the frame, starting at 0
+        int Index;
+
+        // Spatial::OnDraw calls, and the objects culled by each plane
+        int NodesVisited, NodesCulled;
+        int CulledByPlane[CULL_PLANES];
+
+        // Geometry drawn by Renderer::Draw, the draw calls of the
+        // graphics library and their triangles
+        int GeometryDrawn, DrawCalls, Triangles;
+
+        // Set*State calls by state type
+        int StateSets[GlobalState::MAX_STATE];
+
+        // A bind is a use of a texture by a draw, an upload is the first
+        // use that creates the texture.  A buffer creation is the first use
+        // of a cached array.  A release is a ReleaseArray call.
+        int TextureBinds, TextureUploads, TextureBytes;
+        int BufferCreations, BufferBytes;
+        int ArrayReleases;
+
+        // Seconds in Spatial::UpdateGS, in Camera::Culled and in the rest
+        // of Renderer::DrawScene.
+        double UpdateTime, CullTime, DrawTime;
+    };
+
+    // the frame in progress
+    Frame& GetCurrent ();
+    const Frame& GetCurrent () const;
+
+    // Close the frame in progress, store it in the history, call the frame
+    // callback and start the next frame.
+    void EndFrame ();
+
+    // The number of frames ended, the frames in the history and the
+    // capacity of the history.  GetHistory(0) is the most recent frame.
+    int GetFrameQuantity () const;
+    int GetHistoryQuantity () const;
+    int GetMaxHistoryQuantity () const;
+    const Frame& GetHistory (int i) const;
+
+    // Resizing the history discards it.  Clear discards the history and the
+    // frame in progress and restarts the frame numbers.
+    void SetMaxHistoryQuantity (int iMaxHistoryQuantity);
+    void Clear ();
+
+    // called by EndFrame with the frame that ended
+    typedef void (*FrameCallback)(const Frame& rkFrame, void* pvData);
+    void SetFrameCallback (FrameCallback oCallback, void* pvData);
+
+    // Write the history, oldest frame first, as CSV with a header line or as
+    // a JSON array of objects.  The row functions write a single frame, for
+    // example from a frame callback.
+    void WriteCSV (FILE* pkFile) const;
+    void WriteJSON (FILE* pkFile) const;
+    static void WriteCSVHeader (FILE* pkFile);
+    static void WriteCSVRow (FILE* pkFile, const Frame& rkFrame);
+    static void WriteJSONObject (FILE* pkFile, const Frame& rkFrame);
+
+    // Update time is measured by Spatial::UpdateGS, which knows no renderer.
+    // It is accumulated here and charged to the next frame that ends.
+    static void AddUpdateTime (double dSeconds);
+
+    // The triangles of a draw of iQuantity indices (or vertices) of the
+    // Geometry::GeometryType eType.  Points and lines have none.
+    static int GetTriangleQuantity (int eType, int iQuantity);
+
+private:
+    Frame m_kCurrent;
+    Frame* m_akHistory;
+    int m_iMaxHistoryQuantity, m_iHistoryQuantity, m_iNext;
+    int m_iFrameQuantity;
+
+    FrameCallback m_oCallback;
+    void* m_pvCallbackData;
+
+    static double ms_dUpdateTime;
+};
+
+#include "WgRenderStats.inl"
+
+}
+
+#endif
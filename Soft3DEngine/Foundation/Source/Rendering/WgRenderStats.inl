@@ -0,0 +1,57 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgRenderStats.inl                  //
+//                                                       //
+//  - Inlines for Render Statistics class                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+inline RenderStats::Frame& RenderStats::GetCurrent ()
+{
+    return m_kCurrent;
+}
+//----------------------------------------------------------------------------
+inline const RenderStats::Frame& RenderStats::GetCurrent () const
+{
+    return m_kCurrent;
+}
+//----------------------------------------------------------------------------
+inline int RenderStats::GetFrameQuantity () const
+{
+    return m_iFrameQuantity;
+}
+//----------------------------------------------------------------------------
+inline int RenderStats::GetHistoryQuantity () const
+{
+    return m_iHistoryQuantity;
+}
+//----------------------------------------------------------------------------
+inline int RenderStats::GetMaxHistoryQuantity () const
+{
+    return m_iMaxHistoryQuantity;
+}
+//----------------------------------------------------------------------------
+inline const RenderStats::Frame& RenderStats::GetHistory (int i) const
+{
+    assert(0 <= i && i < m_iHistoryQuantity);
+    int iSlot = m_iNext - 1 - i;
+    if (iSlot < 0)
+    {
+        iSlot += m_iMaxHistoryQuantity;
+    }
+    return m_akHistory[iSlot];
+}
+//----------------------------------------------------------------------------
+inline void RenderStats::SetFrameCallback (FrameCallback oCallback,
+    void* pvData)
+{
+    m_oCallback = oCallback;
+    m_pvCallbackData = pvData;
+}
+//----------------------------------------------------------------------------
+inline void RenderStats::AddUpdateTime (double dSeconds)
+{
+    ms_dUpdateTime += dSeconds;
+}
+//----------------------------------------------------------------------------
@@ -18,12 +18,14 @@
 #include "WgNode.h"
 #include "WgPBuffer.h"
 #include "WgScreenPolygon.h"
+#include "WgSpatialIndex.h"
 #include "WgTexture.h"
 #include "WgCachedColorRGBAArray.h"
 #include "WgCachedColorRGBArray.h"
 #include "WgCachedShortArray.h"
 #include "WgCachedVector2Array.h"
 #include "WgCachedVector3Array.h"
+#include "WgProfiler.h"
 using namespace WGSoft3D;
 
 Renderer::SetConstantFunction
@@ -89,9 +91,11 @@ Renderer::Renderer (const BufferParams& rkBufferParams, int iWidth,
     m_bAllowDitherState = true;
     m_bAllowFogState = true;
     m_bAllowMaterialState = true;
+    m_bAllowPolygonOffsetState = true;
     m_bAllowShadeState = true;
    // m_bAllowWireframeState = true;
     m_bAllowZBufferState = true;
+    m_bAllowStencilState = true;
     m_bAllowLighting = true;
     m_bAllowNormals = true;
     m_bAllowColors = true;
@@ -148,6 +152,13 @@ void Renderer::DrawScene (Node* pkScene, bool bNoCull)
 {
     if (pkScene)
     {
+#ifdef WG3D_RENDER_STATS
+        // the cull time is measured by Camera::Culled, the rest is draw time
+        RenderStats::Frame& rkFrame = m_kStats.GetCurrent();
+        double dStart = System::GetPreciseTime();
+        double dCullTime = rkFrame.CullTime;
+#endif
+
         pkScene->OnDraw(*this,bNoCull);
 
         if (DrawDeferred)
@@ -155,6 +166,36 @@ void Renderer::DrawScene (Node* pkScene, bool bNoCull)
             (this->*DrawDeferred)();
             m_iDeferredQuantity = 0;
         }
+
+#ifdef WG3D_RENDER_STATS
+        rkFrame.DrawTime += System::GetPreciseTime() - dStart -
+            (rkFrame.CullTime - dCullTime);
+#endif
+    }
+}
+//----------------------------------------------------------------------------
+void Renderer::DrawScene (SpatialIndex* pkIndex)
+{
+    if (pkIndex)
+    {
+#ifdef WG3D_RENDER_STATS
+        RenderStats::Frame& rkFrame = m_kStats.GetCurrent();
+        double dStart = System::GetPreciseTime();
+        double dCullTime = rkFrame.CullTime;
+#endif
+
+        pkIndex->Draw(*this);
+
+        if (DrawDeferred)
+        {
+            (this->*DrawDeferred)();
+            m_iDeferredQuantity = 0;
+        }
+
+#ifdef WG3D_RENDER_STATS
+        rkFrame.DrawTime += System::GetPreciseTime() - dStart -
+            (rkFrame.CullTime - dCullTime);
+#endif
     }
 }
 //----------------------------------------------------------------------------
@@ -185,6 +226,7 @@ void Renderer::Draw (Geometry* pkGeometry)
 {
     if (!DrawDeferred)
     {
+        WG3D_RENDER_STATS_DO(m_kStats.GetCurrent().GeometryDrawn++);
         m_pkGeometry = pkGeometry;
         m_pkLocalEffect = pkGeometry->GetEffect();
 
@@ -223,42 +265,56 @@ void Renderer::SetGlobalState (
     if (m_bAllowAlphaState)
     {
         pkState = aspkState[GlobalState::ALPHA];
+        WG3D_RENDER_STATS_DO(
+            m_kStats.GetCurrent().StateSets[GlobalState::ALPHA]++);
         SetAlphaState((AlphaState*)pkState);
     }
 
     if (m_bAllowCullState)
     {
         pkState = aspkState[GlobalState::CULL];
+        WG3D_RENDER_STATS_DO(
+            m_kStats.GetCurrent().StateSets[GlobalState::CULL]++);
         SetCullState((CullState*)pkState);
     }
 
     if (m_bAllowDitherState)
     {
         pkState = aspkState[GlobalState::DITHER];
+        WG3D_RENDER_STATS_DO(
+            m_kStats.GetCurrent().StateSets[GlobalState::DITHER]++);
         SetDitherState((DitherState*)pkState);
     }
 
     if (m_bAllowFogState)
     {
         pkState = aspkState[GlobalState::FOG];
+        WG3D_RENDER_STATS_DO(
+            m_kStats.GetCurrent().StateSets[GlobalState::FOG]++);
         SetFogState((FogState*)pkState);
     }
 
     if (m_bAllowMaterialState)
     {
         pkState = aspkState[GlobalState::MATERIAL];
+        WG3D_RENDER_STATS_DO(
+            m_kStats.GetCurrent().StateSets[GlobalState::MATERIAL]++);
         SetMaterialState((MaterialState*)pkState);
     }
 
     if (m_bAllowPolygonOffsetState)
     {
         pkState = aspkState[GlobalState::POLYGONOFFSET];
+        WG3D_RENDER_STATS_DO(
+            m_kStats.GetCurrent().StateSets[GlobalState::POLYGONOFFSET]++);
         SetPolygonOffsetState((PolygonOffsetState*)pkState);
     }
 
     if (m_bAllowShadeState)
     {
         pkState = aspkState[GlobalState::SHADE];
+        WG3D_RENDER_STATS_DO(
+            m_kStats.GetCurrent().StateSets[GlobalState::SHADE]++);
         SetShadeState((ShadeState*)pkState);
     }
 
@@ -271,8 +327,22 @@ void Renderer::SetGlobalState (
     if (m_bAllowZBufferState)
     {
         pkState = aspkState[GlobalState::ZBUFFER];
+        WG3D_RENDER_STATS_DO(
+            m_kStats.GetCurrent().StateSets[GlobalState::ZBUFFER]++);
         SetZBufferState((ZBufferState*)pkState);
     }
+
+    if (m_bAllowStencilState)
+    {
+        pkState = aspkState[GlobalState::STENCIL];
+        WG3D_RENDER_STATS_DO(
+            m_kStats.GetCurrent().StateSets[GlobalState::STENCIL]++);
+        SetStencilState((StencilState*)pkState);
+    }
+}
+//----------------------------------------------------------------------------
+void Renderer::SetStencilState (StencilState*)
+{
 }
 //----------------------------------------------------------------------------
 void Renderer::EnableTextures ()
@@ -455,6 +525,8 @@ void Renderer::ReleaseArrays (Spatial* pkScene)
 //----------------------------------------------------------------------------
 void Renderer::DrawPrimitive ()
 {
+    WG3D_PROFILE("Renderer::DrawPrimitive");
+
     if (m_bAllowGlobalState)
     {
         SetGlobalState(m_pkGeometry->States);
@@ -566,6 +638,31 @@ void Renderer::DrawDeferredNoSort ()
     DrawDeferred = oSave;
 }
 //----------------------------------------------------------------------------
+void Renderer::DrawDeferredSorted ()
+{
+    m_kRenderQueue.Sort(m_iDeferredQuantity,m_kDeferredObject.GetArray(),
+        m_kDeferredIsGeometry.GetArray(),m_pkCamera);
+
+    // disable deferred drawing
+    DrawFunction oSave = DrawDeferred;
+    DrawDeferred = 0;
+
+    for (int i = 0; i < m_kRenderQueue.GetQuantity(); i++)
+    {
+        if (m_kRenderQueue.IsGeometry(i))
+        {
+            Draw((Geometry*)m_kRenderQueue.GetObject(i));
+        }
+        else
+        {
+            Draw((Node*)m_kRenderQueue.GetObject(i));
+        }
+    }
+
+    // enable deferred drawing
+    DrawDeferred = oSave;
+}
+//----------------------------------------------------------------------------
 void Renderer::ReleaseResources (Spatial* pkScene)
 {
     ReleaseTextures(pkScene);
@@ -27,6 +27,8 @@
 #include "WgZBufferState.h"
 #include "WgStencilState.h"
 #include "WgShaderConstant.h"
+#include "WgRenderQueue.h"
+#include "WgRenderStats.h"
 
 namespace WGSoft3D
 {
@@ -51,6 +53,7 @@ class PixelShader;
 class ScreenPolygon;
 class Shader;
 class Spatial;
+class SpatialIndex;
 class Texture;
 class VertexShader;
 
@@ -114,6 +117,11 @@ public:
 
     // object drawing
     void DrawScene (Node* pkScene, bool bNoCull=false);
+
+    // Draw the scene culled through its spatial index.  The index must be
+    // updated after the geometric update of the frame.
+    void DrawScene (SpatialIndex* pkIndex);
+
     virtual void Draw (ScreenPolygon* pkPolygon);
 
     // 2D drawing
@@ -174,6 +182,19 @@ public:
     // draw all objects without sorting
     void DrawDeferredNoSort ();
 
+    // Draw the objects in the order of the render queue: the Geometry
+    // without blending sorted by state and front to back, then the nodes
+    // with global effects, then the Geometry with blending back to front.
+    // The queue reports the state and texture changes saved by sorting.
+    void DrawDeferredSorted ();
+    const RenderQueue& GetRenderQueue () const;
+
+#ifdef WG3D_RENDER_STATS
+    // The statistics of the frames drawn.  The application calls
+    // GetStats().EndFrame() once per frame, after DisplayBackBuffer.
+    RenderStats& GetStats ();
+#endif
+
 protected:
     // abstract base class
     Renderer (const BufferParams& rkBufferParams, int iWidth, int iHeight);
@@ -190,6 +211,10 @@ protected:
 //    virtual void SetWireframeState (WireframeState* pkState) = 0;
     virtual void SetZBufferState (ZBufferState* pkState) = 0;
 
+    // The stencil state is applied only by renderers that override this
+    // function.  The default ignores it.
+    virtual void SetStencilState (StencilState* pkState);
+
     // light management
     enum
     {
@@ -292,6 +317,7 @@ protected:
     bool m_bAllowShadeState;
     //bool m_bAllowWireframeState;
     bool m_bAllowZBufferState;
+    bool m_bAllowStencilState;
     bool m_bAllowLighting;
     bool m_bAllowNormals;
     bool m_bAllowColors;
@@ -311,6 +337,11 @@ protected:
     int m_iDeferredQuantity;
     TArray<Spatial*> m_kDeferredObject;
     TArray<bool> m_kDeferredIsGeometry;
+    RenderQueue m_kRenderQueue;
+
+#ifdef WG3D_RENDER_STATS
+    RenderStats m_kStats;
+#endif
 
     // point size, line width, and line stipple
     fixed m_fPointSize;  // default = 1
@@ -128,6 +128,18 @@ inline int Renderer::GetMaxStencilIndices () const
     return m_iMaxStencilIndices;
 }
 //----------------------------------------------------------------------------
+inline const RenderQueue& Renderer::GetRenderQueue () const
+{
+    return m_kRenderQueue;
+}
+//----------------------------------------------------------------------------
+#ifdef WG3D_RENDER_STATS
+inline RenderStats& Renderer::GetStats ()
+{
+    return m_kStats;
+}
+//----------------------------------------------------------------------------
+#endif
 inline Texture* Renderer::GetTarget ()
 {
     return m_pkTarget;
@@ -11,11 +11,16 @@
 
 #include "WgFoundationPCH.h"
 #include "WgBoundingVolume.h"
+#include "WgBoxBV.h"
+#include "WgOrientedBoxBV.h"
+#include "WgSphereBV.h"
 using namespace WGSoft3D;
 
 WG3D_IMPLEMENT_RTTI(WGSoft3D,BoundingVolume,Object);
 WG3D_IMPLEMENT_DEFAULT_NAME_ID(BoundingVolume,Object);
 
+int BoundingVolume::ms_iDefaultType = BoundingVolume::BV_SPHERE;
+
 //----------------------------------------------------------------------------
 BoundingVolume::BoundingVolume ()
 {
@@ -26,3 +31,36 @@ BoundingVolume::~BoundingVolume ()
 }
 //----------------------------------------------------------------------------
 
+BoundingVolume* BoundingVolume::Create ()
+{
+    return Create(ms_iDefaultType);
+}
+//----------------------------------------------------------------------------
+BoundingVolume* BoundingVolume::Create (int eType)
+{
+    switch (eType)
+    {
+    case BV_BOX:
+        return WG_NEW BoxBV;
+    case BV_ORIENTED_BOX:
+        return WG_NEW OrientedBoxBV;
+    default:
+        assert(eType == BV_SPHERE);
+        return WG_NEW SphereBV;
+    }
+}
+//----------------------------------------------------------------------------
+void BoundingVolume::SetDefaultType (int eType)
+{
+    assert(0 <= eType && eType < BV_QUANTITY);
+    if (0 <= eType && eType < BV_QUANTITY)
+    {
+        ms_iDefaultType = eType;
+    }
+}
+//----------------------------------------------------------------------------
+int BoundingVolume::GetDefaultType ()
+{
+    return ms_iDefaultType;
+}
+//----------------------------------------------------------------------------
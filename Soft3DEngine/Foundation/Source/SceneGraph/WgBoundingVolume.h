@@ -13,6 +13,7 @@
 
 #include "WgFoundationLIB.h"
 #include "WgObject.h"
+#include "WgBox3.h"
 #include "WgPlane3.h"
 #include "WgRay3.h"
 #include "WgTransformation.h"
@@ -35,6 +36,7 @@ public:
     {
         BV_SPHERE,
         BV_BOX,
+        BV_ORIENTED_BOX,
         BV_QUANTITY
     };
     virtual int GetBVType () const = 0;
@@ -45,15 +47,25 @@ public:
     virtual Vector3x GetCenter () const = 0;
     virtual fixed GetRadius () const = 0;
 
-    // One of the derived classes has the responsibility for implementing
-    // this factory function.  Our default is the WmlSphereBV class, but
-    // you may change it to another.
+    // All bounding volumes must also define a box that contains them.  The
+    // bounds of different types are compared through it.
+    virtual Box3x GetBox () const = 0;
+
+    // The factory functions.  Create() makes a bounding volume of the
+    // default type, which every Spatial uses for its world bound and every
+    // Geometry for its model bound.  The default is BV_SPHERE.  Boxes fit
+    // long thin objects (roads, walls, strips of terrain) much better than
+    // spheres, see Geometry::SetBoundType to choose the type of one object.
     static BoundingVolume* Create ();
+    static BoundingVolume* Create (int eType);
+    static void SetDefaultType (int eType);
+    static int GetDefaultType ();
 
     // Compute a bounding volume that contains all the points.
     virtual void ComputeFromData (const Vector3xArray* pkVertices) = 0;
 
-    // Transform the bounding volume (model-to-world conversion).
+    // Transform the bounding volume (model-to-world conversion).  The
+    // result must be of the same type as the bounding volume.
     virtual void TransformBy (const Transformation& rkTransform,
         BoundingVolume* pkResult) = 0;
 
@@ -68,7 +80,8 @@ public:
     // computed).  The input direction must be unit length.
     virtual bool TestIntersection (const Ray3x& rkRay) const = 0;
 
-    // Test for intersection of the two bounds.
+    // Test for intersection of the two bounds.  The input bound, and the
+    // input bound of CopyFrom and GrowToContain, may be of any type.
     virtual bool TestIntersection (const BoundingVolume* pkInput) const = 0;
 
     // Make a copy of the bounding volume.
@@ -83,6 +96,8 @@ public:
 
 protected:
     BoundingVolume ();
+
+    static int ms_iDefaultType;
 };
 
 typedef Pointer<BoundingVolume> BoundingVolumePtr;
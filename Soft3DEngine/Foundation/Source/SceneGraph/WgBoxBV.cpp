@@ -0,0 +1,208 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgBoxBV.cpp                        //
+//                                                       //
+//  - Implementation for Box Bounding Volume class       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgBoxBV.h"
+#include "WgIntrBox3Box3.h"
+#include "WgIntrBox3Sphere3.h"
+#include "WgIntrRay3Box3.h"
+using namespace WGSoft3D;
+
+WG3D_IMPLEMENT_RTTI(WGSoft3D,BoxBV,BoundingVolume);
+WG3D_IMPLEMENT_DEFAULT_NAME_ID(BoxBV,BoundingVolume);
+
+//----------------------------------------------------------------------------
+BoxBV::BoxBV ()
+    :
+    m_kCenter(Vector3x::ZERO),
+    m_kExtent(Vector3x::ZERO)
+{
+}
+//----------------------------------------------------------------------------
+BoxBV::BoxBV (const Vector3x& rkMin, const Vector3x& rkMax)
+    :
+    m_kCenter(fixed(FIXED_HALF)*(rkMin + rkMax)),
+    m_kExtent(fixed(FIXED_HALF)*(rkMax - rkMin))
+{
+}
+//----------------------------------------------------------------------------
+Box3x BoxBV::GetBox () const
+{
+    return Box3x(m_kCenter,Vector3x::UNIT_X,Vector3x::UNIT_Y,
+        Vector3x::UNIT_Z,m_kExtent.X(),m_kExtent.Y(),m_kExtent.Z());
+}
+//----------------------------------------------------------------------------
+void BoxBV::ComputeFromData (const Vector3xArray* pkVertices)
+{
+    if (pkVertices && pkVertices->GetQuantity() > 0)
+    {
+        Vector3x kMin, kMax;
+        Vector3x::ComputeExtremes(pkVertices->GetQuantity(),
+            pkVertices->GetData(),kMin,kMax);
+        m_kCenter = fixed(FIXED_HALF)*(kMin + kMax);
+        m_kExtent = fixed(FIXED_HALF)*(kMax - kMin);
+    }
+}
+//----------------------------------------------------------------------------
+void BoxBV::TransformBy (const Transformation& rkTransform,
+    BoundingVolume* pkResult)
+{
+    assert(pkResult->GetBVType() == BV_BOX);
+    BoxBV* pkTarget = (BoxBV*)pkResult;
+
+    // The extent of the transformed box along a world axis is the sum of
+    // the extents of the box along its own axes, projected onto the world
+    // axis, that is, E'[i] = sum_j |M[i][j]|*E[j].
+    Vector3x kExtent = m_kExtent;
+    if (rkTransform.IsRSMatrix())
+    {
+        const Vector3x& rkScale = rkTransform.GetScale();
+        for (int j = 0; j < 3; j++)
+        {
+            kExtent[j] *= Mathx::FAbs(rkScale[j]);
+        }
+    }
+
+    const Matrix3x& rkMatrix = rkTransform.GetMatrix();
+    for (int i = 0; i < 3; i++)
+    {
+        pkTarget->m_kExtent[i] =
+            Mathx::FAbs(rkMatrix(i,0))*kExtent[0] +
+            Mathx::FAbs(rkMatrix(i,1))*kExtent[1] +
+            Mathx::FAbs(rkMatrix(i,2))*kExtent[2];
+    }
+    pkTarget->m_kCenter = rkTransform.ApplyForward(m_kCenter);
+}
+//----------------------------------------------------------------------------
+int BoxBV::WhichSide (const Plane3x& rkPlane) const
+{
+    fixed fProjRadius =
+        Mathx::FAbs(rkPlane.Normal.X())*m_kExtent.X() +
+        Mathx::FAbs(rkPlane.Normal.Y())*m_kExtent.Y() +
+        Mathx::FAbs(rkPlane.Normal.Z())*m_kExtent.Z();
+
+    fixed fDistance = rkPlane.DistanceTo(m_kCenter);
+
+    if (fDistance <= -fProjRadius)
+    {
+        return -1;
+    }
+    else if (fDistance >= fProjRadius)
+    {
+        return +1;
+    }
+
+    return 0;
+}
+//----------------------------------------------------------------------------
+bool BoxBV::TestIntersection (const Ray3x& rkRay) const
+{
+    Box3x kBox = GetBox();
+    return IntrRay3Box3x(rkRay,kBox).Test();
+}
+//----------------------------------------------------------------------------
+bool BoxBV::TestIntersection (const BoundingVolume* pkInput) const
+{
+    int eType = pkInput->GetBVType();
+    if (eType == BV_BOX)
+    {
+        const BoxBV* pkBox = (const BoxBV*)pkInput;
+        for (int i = 0; i < 3; i++)
+        {
+            if (Mathx::FAbs(pkBox->m_kCenter[i] - m_kCenter[i]) >
+                pkBox->m_kExtent[i] + m_kExtent[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Box3x kBox = GetBox();
+    if (eType == BV_SPHERE)
+    {
+        Sphere3x kSphere(pkInput->GetCenter(),pkInput->GetRadius());
+        return IntrBox3Sphere3x(kBox,kSphere).Test();
+    }
+
+    Box3x kInput = pkInput->GetBox();
+    return IntrBox3Box3x(kBox,kInput).Test();
+}
+//----------------------------------------------------------------------------
+void BoxBV::CopyFrom (const BoundingVolume* pkInput)
+{
+    GetAlignedBox(pkInput,m_kCenter,m_kExtent);
+}
+//----------------------------------------------------------------------------
+void BoxBV::GrowToContain (const BoundingVolume* pkInput)
+{
+    Vector3x kCenter, kExtent;
+    GetAlignedBox(pkInput,kCenter,kExtent);
+
+    for (int i = 0; i < 3; i++)
+    {
+        fixed fMin = m_kCenter[i] - m_kExtent[i];
+        fixed fMax = m_kCenter[i] + m_kExtent[i];
+        fixed fInputMin = kCenter[i] - kExtent[i];
+        fixed fInputMax = kCenter[i] + kExtent[i];
+        if (fInputMin < fMin)
+        {
+            fMin = fInputMin;
+        }
+        if (fInputMax > fMax)
+        {
+            fMax = fInputMax;
+        }
+        m_kCenter[i] = fixed(FIXED_HALF)*(fMin + fMax);
+        m_kExtent[i] = fixed(FIXED_HALF)*(fMax - fMin);
+    }
+}
+//----------------------------------------------------------------------------
+bool BoxBV::Contains (const Vector3x& rkPoint) const
+{
+    for (int i = 0; i < 3; i++)
+    {
+        if (Mathx::FAbs(rkPoint[i] - m_kCenter[i]) > m_kExtent[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+void BoxBV::GetAlignedBox (const BoundingVolume* pkInput,
+    Vector3x& rkCenter, Vector3x& rkExtent)
+{
+    int eType = pkInput->GetBVType();
+    if (eType == BV_BOX)
+    {
+        rkCenter = ((const BoxBV*)pkInput)->m_kCenter;
+        rkExtent = ((const BoxBV*)pkInput)->m_kExtent;
+    }
+    else if (eType == BV_SPHERE)
+    {
+        fixed fRadius = pkInput->GetRadius();
+        rkCenter = pkInput->GetCenter();
+        rkExtent = Vector3x(fRadius,fRadius,fRadius);
+    }
+    else
+    {
+        // the same projection as in TransformBy, with the box axes as the
+        // columns of the matrix
+        Box3x kBox = pkInput->GetBox();
+        rkCenter = kBox.Center;
+        for (int i = 0; i < 3; i++)
+        {
+            rkExtent[i] =
+                Mathx::FAbs(kBox.Axis[0][i])*kBox.Extent[0] +
+                Mathx::FAbs(kBox.Axis[1][i])*kBox.Extent[1] +
+                Mathx::FAbs(kBox.Axis[2][i])*kBox.Extent[2];
+        }
+    }
+}
+//----------------------------------------------------------------------------
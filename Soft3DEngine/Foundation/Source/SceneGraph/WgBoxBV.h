@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgBoxBV.h                          //
+//                                                       //
+//  - Interface for Box Bounding Volume class            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_BOXBV_H__
+#define __WG_BOXBV_H__
+
+#include "WgFoundationLIB.h"
+#include "WgBoundingVolume.h"
+
+namespace WGSoft3D
+{
+
+// An axis-aligned box in the coordinates of its space, stored as a center
+// and the extents along the axes.  The world box of a Geometry is the
+// axis-aligned box of its transformed model box, so it is exact for the
+// translations and for the rotations about multiples of 90 degrees, and
+// grows for the other rotations.  OrientedBoxBV turns with the object.
+
+class WG3D_FOUNDATION_ITEM BoxBV : public BoundingVolume
+{
+    WG3D_DECLARE_RTTI;
+    WG3D_DECLARE_NAME_ID;
+
+public:
+    // construction
+    BoxBV ();  // center (0,0,0), extents 0
+    BoxBV (const Vector3x& rkMin, const Vector3x& rkMax);
+
+    virtual int GetBVType () const;
+
+    // All bounding volumes must define a center and radius.  The radius is
+    // half the diagonal of the box.  SetRadius sets all extents to the
+    // radius, so the box contains the sphere of that radius.
+    virtual void SetCenter (const Vector3x& rkCenter);
+    virtual void SetRadius (fixed fRadius);
+    virtual Vector3x GetCenter () const;
+    virtual fixed GetRadius () const;
+
+    virtual Box3x GetBox () const;
+
+    // the extents are half the sizes of the box along the axes
+    void SetExtent (const Vector3x& rkExtent);
+    const Vector3x& GetExtent () const;
+    Vector3x GetMin () const;
+    Vector3x GetMax () const;
+
+    // Compute the smallest box that contains all the points.
+    virtual void ComputeFromData (const Vector3xArray* pkVertices);
+
+    // Transform the box (model-to-world conversion).  The result is the
+    // axis-aligned box of the transformed box.
+    virtual void TransformBy (const Transformation& rkTransform,
+        BoundingVolume* pkResult);
+
+    // Determine if the bounding volume is one side of the plane, the other
+    // side, or straddles the plane.  If it is on the positive side (the
+    // side to which the normal points), the return value is +1.  If it is
+    // on the negative side, the return value is -1.  If it straddles the
+    // plane, the return value is 0.
+    virtual int WhichSide (const Plane3x& rkPlane) const;
+
+    // Test for intersection of ray and bound (points of intersection not
+    // computed).
+    virtual bool TestIntersection (const Ray3x& rkRay) const;
+
+    // Test for intersection of the two bounds.
+    virtual bool TestIntersection (const BoundingVolume* pkInput) const;
+
+    // Make a copy of the bounding volume.  Another type is replaced by its
+    // axis-aligned box.
+    virtual void CopyFrom (const BoundingVolume* pkInput);
+
+    // Change the current box so that it is the smallest axis-aligned box
+    // that contains the input bound as well as its old box.
+    virtual void GrowToContain (const BoundingVolume* pkInput);
+
+    // test for containment of a point
+    virtual bool Contains (const Vector3x& rkPoint) const;
+
+protected:
+    // the axis-aligned box of a bound
+    static void GetAlignedBox (const BoundingVolume* pkInput,
+        Vector3x& rkCenter, Vector3x& rkExtent);
+
+    Vector3x m_kCenter, m_kExtent;
+};
+
+#include "WgBoxBV.inl"
+
+typedef Pointer<BoxBV> BoxBVPtr;
+
+}
+
+#endif
@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgBoxBV.inl                        //
+//                                                       //
+//  - Inlines for Box Bounding Volume class              //
+//                                                       //
+///////////////////////////////////////////////////////////
+//----------------------------------------------------------------------------
+inline int BoxBV::GetBVType () const
+{
+    return BoundingVolume::BV_BOX;
+}
+//----------------------------------------------------------------------------
+inline void BoxBV::SetCenter (const Vector3x& rkCenter)
+{
+    m_kCenter = rkCenter;
+}
+//----------------------------------------------------------------------------
+inline void BoxBV::SetRadius (fixed fRadius)
+{
+    m_kExtent = Vector3x(fRadius,fRadius,fRadius);
+}
+//----------------------------------------------------------------------------
+inline Vector3x BoxBV::GetCenter () const
+{
+    return m_kCenter;
+}
+//----------------------------------------------------------------------------
+inline fixed BoxBV::GetRadius () const
+{
+    return m_kExtent.Length();
+}
+//----------------------------------------------------------------------------
+inline void BoxBV::SetExtent (const Vector3x& rkExtent)
+{
+    m_kExtent = rkExtent;
+}
+//----------------------------------------------------------------------------
+inline const Vector3x& BoxBV::GetExtent () const
+{
+    return m_kExtent;
+}
+//----------------------------------------------------------------------------
+inline Vector3x BoxBV::GetMin () const
+{
+    return m_kCenter - m_kExtent;
+}
+//----------------------------------------------------------------------------
+inline Vector3x BoxBV::GetMax () const
+{
+    return m_kCenter + m_kExtent;
+}
+//----------------------------------------------------------------------------
@@ -12,6 +12,7 @@
 
 #include "WgFoundationPCH.h"
 #include "WgCamera.h"
+#include "WgFixedSimd.h"
 #include "WgRenderer.h"
 using namespace WGSoft3D;
 
@@ -102,8 +103,13 @@ void Camera::SetFrustum (const fixed* afFrustum)
 void Camera::SetFrustum (fixed fUpFovDegrees, fixed fAspectRatio, fixed fDMin,
     fixed fDMax)
 {
-    fixed fHalfAngleRadians = FixedFromFloat(0.5f*FloatFromFixed(fUpFovDegrees)*Mathf::DEG_TO_RAD);
-    m_afFrustum[VF_UMAX] = FixedFromFloat(FloatFromFixed(fDMin)*Mathf::Tan(FloatFromFixed(fHalfAngleRadians)));
+    // half angle in radians, pi/360 is scaled by 2^12 to keep its fraction
+    // bits
+    fixed fHalfAngleRadians = fUpFovDegrees*
+        fixed(FIXED_CONST_Q(0.00872664625997164788,28))/(FIXED_ONE << 12);
+    fixed fSin, fCos;
+    sincosx(fHalfAngleRadians,fSin,fCos,FIXED_ACCURATE);
+    m_afFrustum[VF_UMAX] = fDMin*fSin/fCos;
     m_afFrustum[VF_RMAX] = fAspectRatio*m_afFrustum[VF_UMAX];
     m_afFrustum[VF_UMIN] = -m_afFrustum[VF_UMAX];
     m_afFrustum[VF_RMIN] = -m_afFrustum[VF_RMAX];
@@ -130,7 +136,8 @@ bool Camera::GetFrustum (fixed& rfUpFovDegrees, fixed& rfAspectRatio,
     &&  m_afFrustum[VF_UMIN] == -m_afFrustum[VF_UMAX])
     {
         fixed fAngle = m_afFrustum[VF_UMAX]/m_afFrustum[VF_DMIN];
-        rfUpFovDegrees = FixedFromFloat(2.0f)*FixedFromFloat(Mathf::ATan(FloatFromFixed(fAngle))*Mathf::RAD_TO_DEG);
+        rfUpFovDegrees = FixedFromFloat(2.0f*Mathf::ATan(
+            FloatFromFixed(fAngle))*Mathf::RAD_TO_DEG);
         rfAspectRatio = m_afFrustum[VF_RMAX]/m_afFrustum[VF_UMAX];
         rfDMin = m_afFrustum[VF_DMIN];
         rfDMax = m_afFrustum[VF_DMAX];
@@ -268,6 +275,10 @@ void Camera::PopPlane ()
 //----------------------------------------------------------------------------
 bool Camera::Culled (const BoundingVolume* pkWBound)
 {
+#ifdef WG3D_RENDER_STATS
+    double dStart = System::GetPreciseTime();
+#endif
+
     // start with last pushed plane (potentially the most restrictive plane)
     int iP = m_iPlaneQuantity - 1;
     unsigned int uiMask = 1 << iP;
@@ -281,6 +292,7 @@ bool Camera::Culled (const BoundingVolume* pkWBound)
             if (iSide < 0)
             {
                 // Object is on negative side.  Cull it.
+                WG3D_RENDER_STATS_DO(CountCulled(iP,dStart));
                 return true;
             }
 
@@ -294,9 +306,133 @@ bool Camera::Culled (const BoundingVolume* pkWBound)
         }
     }
 
+    WG3D_RENDER_STATS_DO(CountCulled(-1,dStart));
     return false;
 }
 //----------------------------------------------------------------------------
+void Camera::Culled (int iQuantity, const fixed* afX, const fixed* afY,
+    const fixed* afZ, const fixed* afRadius, unsigned int uiFirst,
+    unsigned int* auiState, int* aiPlane)
+{
+    assert(0 <= iQuantity && iQuantity <= MAX_CULL_BATCH);
+#ifdef WG3D_RENDER_STATS
+    double dStart = System::GetPreciseTime();
+#endif
+
+    // The spheres that are not culled yet are kept packed at the front of
+    // the lanes, with the index of each in aiObject.
+    fixed afLX[MAX_CULL_BATCH], afLY[MAX_CULL_BATCH], afLZ[MAX_CULL_BATCH];
+    fixed afLRadius[MAX_CULL_BATCH];
+    int aiObject[MAX_CULL_BATCH], aiSide[MAX_CULL_BATCH];
+    int i, iLive = iQuantity;
+    for (i = 0; i < iQuantity; i++)
+    {
+        afLX[i] = afX[i];
+        afLY[i] = afY[i];
+        afLZ[i] = afZ[i];
+        afLRadius[i] = afRadius[i];
+        aiObject[i] = i;
+        auiState[i] = m_uiPlaneState;
+        aiPlane[i] = -1;
+    }
+
+    // The first pass tests the active planes in uiFirst, the second pass the
+    // other active planes, each from the last pushed plane down as Culled
+    // does.
+    for (int iPass = 0; iPass < 2 && iLive > 0; iPass++)
+    {
+        unsigned int uiPass = m_uiPlaneState &
+            (iPass == 0 ? uiFirst : ~uiFirst);
+        for (int iP = m_iPlaneQuantity-1; iP >= 0 && iLive > 0; iP--)
+        {
+            unsigned int uiMask = 1u << iP;
+            if (!(uiPass & uiMask))
+            {
+                continue;
+            }
+
+            FixedSimd::WhichSide(iLive,m_akWPlane[iP],afLX,afLY,afLZ,
+                afLRadius,aiSide);
+
+            int iKeep = 0;
+            for (i = 0; i < iLive; i++)
+            {
+                int iObject = aiObject[i];
+                if (aiSide[i] < 0)
+                {
+                    // the sphere is on the negative side, cull it
+                    aiPlane[iObject] = iP;
+                    continue;
+                }
+
+                if (aiSide[i] > 0)
+                {
+                    // the subobjects need not be tested against the plane
+                    auiState[iObject] &= ~uiMask;
+                }
+
+                if (iKeep < i)
+                {
+                    afLX[iKeep] = afLX[i];
+                    afLY[iKeep] = afLY[i];
+                    afLZ[iKeep] = afLZ[i];
+                    afLRadius[iKeep] = afLRadius[i];
+                    aiObject[iKeep] = iObject;
+                }
+                iKeep++;
+            }
+            iLive = iKeep;
+        }
+    }
+
+    WG3D_RENDER_STATS_DO(CountCulled(iQuantity,aiPlane,dStart));
+}
+//----------------------------------------------------------------------------
+#ifdef WG3D_RENDER_STATS
+void Camera::CountCulled (int iPlane, double dStart)
+{
+    if (!m_pkRenderer)
+    {
+        return;
+    }
+
+    // the planes pushed by the application share the last count
+    RenderStats::Frame& rkFrame = m_pkRenderer->GetStats().GetCurrent();
+    if (iPlane >= CAM_FRUSTUM_PLANES)
+    {
+        iPlane = CAM_FRUSTUM_PLANES;
+    }
+    if (iPlane >= 0)
+    {
+        rkFrame.CulledByPlane[iPlane]++;
+    }
+    rkFrame.CullTime += System::GetPreciseTime() - dStart;
+}
+//----------------------------------------------------------------------------
+void Camera::CountCulled (int iQuantity, const int* aiPlane, double dStart)
+{
+    if (!m_pkRenderer)
+    {
+        return;
+    }
+
+    RenderStats::Frame& rkFrame = m_pkRenderer->GetStats().GetCurrent();
+    for (int i = 0; i < iQuantity; i++)
+    {
+        int iPlane = aiPlane[i];
+        if (iPlane >= CAM_FRUSTUM_PLANES)
+        {
+            iPlane = CAM_FRUSTUM_PLANES;
+        }
+        if (iPlane >= 0)
+        {
+            rkFrame.CulledByPlane[iPlane]++;
+        }
+    }
+    rkFrame.CullTime += System::GetPreciseTime() - dStart;
+}
+#endif
+//----------------------------------------------------------------------------
 bool Camera::Culled (int iVertexQuantity, const Vector3x* akVertex,
     bool bIgnoreNearPlane)
 {
@@ -191,6 +191,22 @@ public:
     unsigned int GetPlaneState () const;
     bool Culled (const BoundingVolume* pkWBound);
 
+    // Culling support in Node::Draw.  The spheres of up to MAX_CULL_BATCH
+    // sibling bounds, in structure of arrays form, are tested together
+    // against each active plane with FixedSimd::WhichSide.  The result for
+    // each sphere is that of Culled for its SphereBV:  aiPlane[i] is the
+    // plane that culls sphere i, or -1 when it is not culled, and
+    // auiState[i] is the plane state to draw it with.  The planes in
+    // uiFirst are tested first (the order of the planes changes the work,
+    // not the result).  The plane state of the camera is not changed.
+    enum
+    {
+        MAX_CULL_BATCH = 32
+    };
+    void Culled (int iQuantity, const fixed* afX, const fixed* afY,
+        const fixed* afZ, const fixed* afRadius, unsigned int uiFirst,
+        unsigned int* auiState, int* aiPlane);
+
     // culling support in Portal::Draw
     bool Culled (int iVertexQuantity, const Vector3x* akVertex,
         bool bIgnoreNearPlane);
@@ -203,6 +219,14 @@ public:
     Renderer* m_pkRenderer;
 
 private:
+#ifdef WG3D_RENDER_STATS
+    // Charge a call of Culled that started at dStart to the renderer, with
+    // the index of the culling plane or -1 when the bound is not culled
+    // (one index per sphere for the batched test).
+    void CountCulled (int iPlane, double dStart);
+    void CountCulled (int iQuantity, const int* aiPlane, double dStart);
+#endif
+
     // base class functions not supported
     virtual void UpdateState (TStack<GlobalState*>*, TStack<Light*>*) { /**/ }
     virtual void Draw (Renderer&, bool) { /**/ }
@@ -21,19 +21,21 @@ WG3D_IMPLEMENT_RTTI(WGSoft3D,Geometry,Spatial);
 //----------------------------------------------------------------------------
 Geometry::Geometry ()
     :
-    ModelBound(BoundingVolume::Create()),
-    Lights(8,8)
+    ModelBound(BoundingVolume::Create())
 {
     memset(States,0,GlobalState::MAX_STATE*sizeof(GlobalState*));
+    m_uiWorldHVersion = 0;
+    m_uiWorldInvHVersion = 0;
 }
 //----------------------------------------------------------------------------
 Geometry::Geometry (Vector3xArrayPtr spkVertices)
     :
     Vertices(spkVertices),
-    ModelBound(BoundingVolume::Create()),
-    Lights(8,8)
+    ModelBound(BoundingVolume::Create())
 {
     memset(States,0,GlobalState::MAX_STATE*sizeof(GlobalState*));
+    m_uiWorldHVersion = 0;
+    m_uiWorldInvHVersion = 0;
     UpdateModelBound();
 }
 //----------------------------------------------------------------------------
@@ -48,6 +50,20 @@ void Geometry::UpdateMS (bool bUpdateNormals)
     {
         UpdateModelNormals();
     }
+
+    // the world bound must be recomputed by the next incremental update
+    MarkDirty();
+}
+//----------------------------------------------------------------------------
+void Geometry::SetBoundType (int eType)
+{
+    if (ModelBound->GetBVType() != eType)
+    {
+        ModelBound = BoundingVolume::Create(eType);
+        WorldBound = BoundingVolume::Create(eType);
+        UpdateModelBound();
+        MarkDirty();
+    }
 }
 //----------------------------------------------------------------------------
 void Geometry::UpdateModelBound ()
@@ -40,6 +40,19 @@ public:
     // geometric updates
     virtual void UpdateMS (bool bUpdateNormals = true);
 
+    // Replace the model and world bounds by bounds of the type eType (a
+    // BoundingVolume::BVType) and recompute the model bound.  The object
+    // keeps the type through the updates; its parents keep theirs and grow
+    // to contain it.  Choose the type before a LinearScene is compiled
+    // from the scene, it notes the types of the bounds.
+    void SetBoundType (int eType);
+
+    // The homogeneous matrix of World and its inverse, for the renderers
+    // (see Transformation::GetHomogeneous).  Both are computed on first
+    // access after World changes and are cached until the next change.
+    const fixed* GetWorldHomogeneous () const;
+    const fixed* GetWorldInverseHomogeneous () const;
+
     // Picking support. This nested class exists only to maintain the
     // class-derivation chain that is parallel to the one whose base is
     // Spatial.
@@ -65,6 +78,11 @@ protected:
     // drawing
     virtual void Draw (Renderer& rkRenderer, bool bNoCull = false);
 
+private:
+    // the cached matrices and the versions of World they were computed for
+    mutable unsigned int m_uiWorldHVersion, m_uiWorldInvHVersion;
+    mutable fixed m_afWorldH[16], m_afWorldInvH[16];
+
 // internal use
 public:
     // Render state and lights in path to this object.  An attached effect
@@ -85,7 +103,7 @@ public:
 
     GeometryType m_GeometryType;
     GlobalStatePtr States[GlobalState::MAX_STATE];
-    TArray<LightPtr> Lights;
+    TSmallArray<LightPtr,4> Lights;
 };
 
 typedef Pointer<Geometry> GeometryPtr;
@@ -16,3 +16,23 @@ inline void Geometry::UpdateModelNormals ()
 }
 //----------------------------------------------------------------------------
 
+inline const fixed* Geometry::GetWorldHomogeneous () const
+{
+    if (m_uiWorldHVersion != World.GetVersion())
+    {
+        World.GetHomogeneous(m_afWorldH);
+        m_uiWorldHVersion = World.GetVersion();
+    }
+    return m_afWorldH;
+}
+//----------------------------------------------------------------------------
+inline const fixed* Geometry::GetWorldInverseHomogeneous () const
+{
+    if (m_uiWorldInvHVersion != World.GetVersion())
+    {
+        World.GetInverseHomogeneous(m_afWorldInvH);
+        m_uiWorldInvHVersion = World.GetVersion();
+    }
+    return m_afWorldInvH;
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,610 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgLinearScene.cpp                  //
+//                                                       //
+//  - Implementation for Linear Scene class              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgLinearScene.h"
+#include "WgContSphere3.h"
+#include "WgGeometry.h"
+#include "WgLight.h"
+#include "WgSphereBV.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+LinearScene::LinearScene (Spatial* pkRoot)
+    :
+    m_spkRoot(pkRoot),
+    m_kAnimated(16,16),
+    m_kTouched(16,16)
+{
+    assert(pkRoot);
+    m_bCompiled = false;
+    m_iQuantity = 0;
+    m_apkObject = 0;
+    m_aiParent = 0;
+    m_aiFirstChild = 0;
+    m_aiChildQuantity = 0;
+    m_aiChild = 0;
+    m_aucKind = 0;
+    m_aucFlags = 0;
+    m_akLocalMatrix = 0;
+    m_akLocalTranslate = 0;
+    m_akLocalScale = 0;
+    m_aucLocalHints = 0;
+    m_akWorldMatrix = 0;
+    m_akWorldTranslate = 0;
+    m_akWorldScale = 0;
+    m_aucWorldHints = 0;
+    m_akModelBound = 0;
+    m_akWorldBound = 0;
+    m_iWorldChanges = 0;
+    m_iBoundChanges = 0;
+    Compile();
+}
+//----------------------------------------------------------------------------
+LinearScene::~LinearScene ()
+{
+    Release();
+}
+//----------------------------------------------------------------------------
+void LinearScene::Release ()
+{
+    for (int i = 0; i < m_iQuantity; i++)
+    {
+        Spatial* pkObject = m_apkObject[i];
+        if (pkObject && pkObject->m_pkLinearScene == this)
+        {
+            pkObject->m_pkLinearScene = 0;
+            pkObject->m_iLinearHandle = -1;
+        }
+    }
+
+    WG_DELETE[] m_apkObject;
+    WG_DELETE[] m_aiParent;
+    WG_DELETE[] m_aiFirstChild;
+    WG_DELETE[] m_aiChildQuantity;
+    WG_DELETE[] m_aiChild;
+    WG_DELETE[] m_aucKind;
+    WG_DELETE[] m_aucFlags;
+    WG_DELETE[] m_akLocalMatrix;
+    WG_DELETE[] m_akLocalTranslate;
+    WG_DELETE[] m_akLocalScale;
+    WG_DELETE[] m_aucLocalHints;
+    WG_DELETE[] m_akWorldMatrix;
+    WG_DELETE[] m_akWorldTranslate;
+    WG_DELETE[] m_akWorldScale;
+    WG_DELETE[] m_aucWorldHints;
+    WG_DELETE[] m_akModelBound;
+    WG_DELETE[] m_akWorldBound;
+    m_apkObject = 0;
+    m_aiParent = 0;
+    m_aiFirstChild = 0;
+    m_aiChildQuantity = 0;
+    m_aiChild = 0;
+    m_aucKind = 0;
+    m_aucFlags = 0;
+    m_akLocalMatrix = 0;
+    m_akLocalTranslate = 0;
+    m_akLocalScale = 0;
+    m_aucLocalHints = 0;
+    m_akWorldMatrix = 0;
+    m_akWorldTranslate = 0;
+    m_akWorldScale = 0;
+    m_aucWorldHints = 0;
+    m_akModelBound = 0;
+    m_akWorldBound = 0;
+    m_iQuantity = 0;
+    m_kAnimated.RemoveAll();
+    m_kTouched.RemoveAll();
+    m_bCompiled = false;
+}
+//----------------------------------------------------------------------------
+void LinearScene::Compile ()
+{
+    Release();
+
+    // Depth-first traversal in the order of UpdateGS, which is usually the
+    // order in which the objects were created and so their order in memory.
+    // An object precedes all of its descendants.
+    TArray<Spatial*> kObject(256,256);
+    TArray<int> kParent(256,256);
+    TArray<Spatial*> kStack(64,64);
+    TArray<int> kStackParent(64,64);
+    kStack.Append(m_spkRoot);
+    kStackParent.Append(-1);
+
+    int i, j;
+    while (kStack.GetQuantity() > 0)
+    {
+        int iTop = kStack.GetQuantity() - 1;
+        Spatial* pkObject = kStack[iTop];
+        int iParent = kStackParent[iTop];
+        kStack.Remove(iTop);
+        kStackParent.Remove(iTop);
+
+        i = kObject.GetQuantity();
+        kObject.Append(pkObject);
+        kParent.Append(iParent);
+
+        // the children are pushed in reverse, so the first is visited first
+        Node* pkNode = DynamicCast<Node>(pkObject);
+        if (pkNode)
+        {
+            for (j = pkNode->GetQuantity() - 1; j >= 0; j--)
+            {
+                Spatial* pkChild = pkNode->GetChild(j);
+                if (pkChild)
+                {
+                    kStack.Append(pkChild);
+                    kStackParent.Append(i);
+                }
+            }
+        }
+    }
+
+    m_iQuantity = kObject.GetQuantity();
+    m_apkObject = WG_NEW Spatial*[m_iQuantity];
+    m_aiParent = WG_NEW int[m_iQuantity];
+    m_aiFirstChild = WG_NEW int[m_iQuantity];
+    m_aiChildQuantity = WG_NEW int[m_iQuantity];
+    m_aiChild = (m_iQuantity > 1 ? WG_NEW int[m_iQuantity-1] : 0);
+    m_aucKind = WG_NEW unsigned char[m_iQuantity];
+    m_aucFlags = WG_NEW unsigned char[m_iQuantity];
+    m_akLocalMatrix = WG_NEW Matrix3x[m_iQuantity];
+    m_akLocalTranslate = WG_NEW Vector3x[m_iQuantity];
+    m_akLocalScale = WG_NEW Vector3x[m_iQuantity];
+    m_aucLocalHints = WG_NEW unsigned char[m_iQuantity];
+    m_akWorldMatrix = WG_NEW Matrix3x[m_iQuantity];
+    m_akWorldTranslate = WG_NEW Vector3x[m_iQuantity];
+    m_akWorldScale = WG_NEW Vector3x[m_iQuantity];
+    m_aucWorldHints = WG_NEW unsigned char[m_iQuantity];
+    m_akModelBound = WG_NEW Sphere3x[m_iQuantity];
+    m_akWorldBound = WG_NEW Sphere3x[m_iQuantity];
+
+    for (i = 0; i < m_iQuantity; i++)
+    {
+        Spatial* pkObject = kObject[i];
+        if (pkObject->m_pkLinearScene)
+        {
+            // the object moved here from another scene
+            pkObject->m_pkLinearScene->OnDestroy(pkObject->m_iLinearHandle);
+        }
+        pkObject->m_pkLinearScene = this;
+        pkObject->m_iLinearHandle = i;
+
+        m_apkObject[i] = pkObject;
+        m_aiParent[i] = kParent[i];
+        m_aiChildQuantity[i] = 0;
+        if (kParent[i] >= 0)
+        {
+            m_aiChildQuantity[kParent[i]]++;
+        }
+
+        const int iSphere = BoundingVolume::BV_SPHERE;
+        bool bSphere = (pkObject->WorldBound->GetBVType() == iSphere);
+        Geometry* pkGeometry = DynamicCast<Geometry>(pkObject);
+        if (bSphere && pkObject->IsExactly(Node::TYPE))
+        {
+            m_aucKind[i] = K_NODE;
+        }
+        else if (bSphere && pkGeometry
+            &&   pkGeometry->ModelBound->GetBVType() == iSphere)
+        {
+            m_aucKind[i] = K_GEOMETRY;
+            m_akModelBound[i] =
+                StaticCast<SphereBV>(pkGeometry->ModelBound)->GetSphere();
+        }
+        else
+        {
+            m_aucKind[i] = K_OTHER;
+        }
+
+        unsigned int uiHints;
+        pkObject->Local.Get(m_akLocalMatrix[i],m_akLocalTranslate[i],
+            m_akLocalScale[i],uiHints);
+        m_aucLocalHints[i] = (unsigned char)uiHints;
+        pkObject->World.Get(m_akWorldMatrix[i],m_akWorldTranslate[i],
+            m_akWorldScale[i],uiHints);
+        m_aucWorldHints[i] = (unsigned char)uiHints;
+        m_akWorldBound[i].Center = pkObject->WorldBound->GetCenter();
+        m_akWorldBound[i].Radius = pkObject->WorldBound->GetRadius();
+
+        // the first update recomputes everything
+        m_aucFlags[i] = F_LOCAL_CHANGED | F_MODEL_CHANGED |
+            F_CHILD_BOUND_CHANGED;
+        if (pkObject->WorldIsCurrent)
+        {
+            m_aucFlags[i] |= F_WORLD_IS_CURRENT | F_WORLD_CHANGED;
+        }
+        if (pkObject->WorldIsCurrent || HasControllers(pkObject))
+        {
+            m_aucFlags[i] |= F_ANIMATED;
+            m_kAnimated.Append(i);
+        }
+    }
+
+    // The children of the object at index i are m_aiChild[m_aiFirstChild[i]]
+    // and the following entries, in the order of the Node.
+    int iFirst = 0;
+    for (i = 0; i < m_iQuantity; i++)
+    {
+        m_aiFirstChild[i] = iFirst;
+        iFirst += m_aiChildQuantity[i];
+        m_aiChildQuantity[i] = 0;
+    }
+    for (i = 1; i < m_iQuantity; i++)
+    {
+        int iParent = m_aiParent[i];
+        m_aiChild[m_aiFirstChild[iParent]+m_aiChildQuantity[iParent]++] = i;
+    }
+
+    Spatial* pkParent = m_spkRoot->GetParent();
+    if (pkParent)
+    {
+        m_kParentWorld = pkParent->World;
+    }
+
+    m_bCompiled = true;
+}
+//----------------------------------------------------------------------------
+void LinearScene::Touch (int iHandle)
+{
+    assert(0 <= iHandle && iHandle < m_iQuantity);
+    if (!(m_aucFlags[iHandle] & F_TOUCHED))
+    {
+        m_aucFlags[iHandle] |= F_TOUCHED;
+        m_kTouched.Append(iHandle);
+    }
+}
+//----------------------------------------------------------------------------
+void LinearScene::OnDestroy (int iHandle)
+{
+    assert(0 <= iHandle && iHandle < m_iQuantity);
+    m_apkObject[iHandle] = 0;
+    m_bCompiled = false;
+}
+//----------------------------------------------------------------------------
+bool LinearScene::HasControllers (Spatial* pkObject)
+{
+    if (pkObject->GetControllerQuantity() > 0)
+    {
+        return true;
+    }
+
+    unsigned int uiStates = pkObject->m_uiGlobalStates;
+    int i;
+    for (i = 0; (uiStates >> i) != 0; i++)
+    {
+        GlobalState* pkGState = pkObject->m_aspkGlobalState[i];
+        if (pkGState && pkGState->GetControllerQuantity() > 0)
+        {
+            return true;
+        }
+    }
+
+    for (i = 0; i < pkObject->GetLightQuantity(); i++)
+    {
+        if (pkObject->GetLight(i)->GetControllerQuantity() > 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+//----------------------------------------------------------------------------
+void LinearScene::Gather (int i)
+{
+    Spatial* pkObject = m_apkObject[i];
+    unsigned char& rucFlags = m_aucFlags[i];
+
+    if (SetLocal(i,pkObject->Local))
+    {
+        rucFlags |= F_LOCAL_CHANGED;
+    }
+
+    if (pkObject->WorldIsCurrent)
+    {
+        // the world transformation was set directly
+        rucFlags |= F_WORLD_IS_CURRENT;
+        Matrix3x kMatrix;
+        Vector3x kTranslate, kScale;
+        unsigned int uiHints;
+        pkObject->World.Get(kMatrix,kTranslate,kScale,uiHints);
+        if (SetWorld(i,kMatrix,kTranslate,kScale,uiHints))
+        {
+            rucFlags |= F_WORLD_CHANGED;
+        }
+    }
+    else if (rucFlags & F_WORLD_IS_CURRENT)
+    {
+        rucFlags &= ~F_WORLD_IS_CURRENT;
+        rucFlags |= F_LOCAL_CHANGED;
+    }
+
+    if (m_aucKind[i] == K_GEOMETRY)
+    {
+        const Sphere3x& rkModelBound = StaticCast<SphereBV>(
+            StaticCast<Geometry>(pkObject)->ModelBound)->GetSphere();
+        if (rkModelBound.Center != m_akModelBound[i].Center
+        ||  rkModelBound.Radius != m_akModelBound[i].Radius)
+        {
+            m_akModelBound[i] = rkModelBound;
+            rucFlags |= F_MODEL_CHANGED;
+        }
+    }
+    else if (m_aucKind[i] == K_OTHER)
+    {
+        rucFlags |= F_MODEL_CHANGED;
+    }
+
+    if (!(rucFlags & F_ANIMATED)
+    &&  (pkObject->WorldIsCurrent || HasControllers(pkObject)))
+    {
+        rucFlags |= F_ANIMATED;
+        m_kAnimated.Append(i);
+    }
+}
+//----------------------------------------------------------------------------
+bool LinearScene::SetLocal (int i, const Transformation& rkLocal)
+{
+    Matrix3x kMatrix;
+    Vector3x kTranslate, kScale;
+    unsigned int uiHints;
+    rkLocal.Get(kMatrix,kTranslate,kScale,uiHints);
+    if (m_aucLocalHints[i] == uiHints
+    &&  m_akLocalTranslate[i] == kTranslate
+    &&  m_akLocalScale[i] == kScale
+    &&  m_akLocalMatrix[i] == kMatrix)
+    {
+        return false;
+    }
+
+    m_akLocalMatrix[i] = kMatrix;
+    m_akLocalTranslate[i] = kTranslate;
+    m_akLocalScale[i] = kScale;
+    m_aucLocalHints[i] = (unsigned char)uiHints;
+    return true;
+}
+//----------------------------------------------------------------------------
+bool LinearScene::SetWorld (int i, const Matrix3x& rkMatrix,
+    const Vector3x& rkTranslate, const Vector3x& rkScale,
+    unsigned int uiHints)
+{
+    // the same comparison as Transformation::Set
+    if (m_aucWorldHints[i] == uiHints
+    &&  m_akWorldTranslate[i] == rkTranslate
+    &&  m_akWorldScale[i] == rkScale
+    &&  m_akWorldMatrix[i] == rkMatrix)
+    {
+        return false;
+    }
+
+    m_akWorldMatrix[i] = rkMatrix;
+    m_akWorldTranslate[i] = rkTranslate;
+    m_akWorldScale[i] = rkScale;
+    m_aucWorldHints[i] = (unsigned char)uiHints;
+    return true;
+}
+//----------------------------------------------------------------------------
+void LinearScene::SetWorldBound (int i, const Sphere3x& rkBound)
+{
+    if (rkBound.Center != m_akWorldBound[i].Center
+    ||  rkBound.Radius != m_akWorldBound[i].Radius)
+    {
+        m_akWorldBound[i] = rkBound;
+        if (m_aucKind[i] != K_OTHER)
+        {
+            StaticCast<SphereBV>(m_apkObject[i]->WorldBound)->Sphere() =
+                rkBound;
+        }
+        if (m_aiParent[i] >= 0)
+        {
+            m_aucFlags[m_aiParent[i]] |= F_CHILD_BOUND_CHANGED;
+        }
+        m_iBoundChanges++;
+    }
+}
+//----------------------------------------------------------------------------
+void LinearScene::Update (double dAppTime)
+{
+    if (!m_bCompiled)
+    {
+        Compile();
+    }
+
+    m_iWorldChanges = 0;
+    m_iBoundChanges = 0;
+
+    // Collect the objects reported by Touch first, an object that was given
+    // a controller joins the animated list here.
+    int i, j, k;
+    for (k = 0; k < m_kTouched.GetQuantity(); k++)
+    {
+        i = m_kTouched[k];
+        m_aucFlags[i] &= ~F_TOUCHED;
+        Gather(i);
+    }
+    m_kTouched.RemoveAll();
+
+    // Run the controllers and collect the local transformations they set.
+    // Objects that lost their controllers leave the list.
+    for (k = 0; k < m_kAnimated.GetQuantity(); /**/)
+    {
+        i = m_kAnimated[k];
+        Spatial* pkObject = m_apkObject[i];
+        if (!pkObject->WorldIsCurrent && !HasControllers(pkObject))
+        {
+            m_aucFlags[i] &= ~F_ANIMATED;
+            int iLast = m_kAnimated.GetQuantity() - 1;
+            m_kAnimated[k] = m_kAnimated[iLast];
+            m_kAnimated.Remove(iLast);
+            continue;
+        }
+
+        pkObject->UpdateControllers(dAppTime);
+
+        unsigned int uiStates = pkObject->m_uiGlobalStates;
+        for (j = 0; (uiStates >> j) != 0; j++)
+        {
+            GlobalState* pkGState = pkObject->m_aspkGlobalState[j];
+            if (pkGState)
+            {
+                pkGState->UpdateControllers(dAppTime);
+            }
+        }
+
+        for (j = 0; j < pkObject->GetLightQuantity(); j++)
+        {
+            pkObject->GetLight(j)->UpdateControllers(dAppTime);
+        }
+
+        Gather(i);
+        k++;
+    }
+
+    // the parent of the root is outside the scene
+    bool bParentChanged = false;
+    Spatial* pkRootParent = m_spkRoot->GetParent();
+    Matrix3x kParentMatrix;
+    Vector3x kParentTranslate, kParentScale;
+    unsigned int uiParentHints = 0;
+    if (pkRootParent)
+    {
+        unsigned int uiVersion = m_kParentWorld.GetVersion();
+        m_kParentWorld = pkRootParent->World;
+        bParentChanged = (m_kParentWorld.GetVersion() != uiVersion);
+        m_kParentWorld.Get(kParentMatrix,kParentTranslate,kParentScale,
+            uiParentHints);
+    }
+
+    // Forward sweep, the world transformations and the world bounds of the
+    // Geometry objects.  A parent precedes its children, so its world
+    // transformation is final when they are reached.  The bound of a
+    // Geometry object is computed while the object is in the cache.
+    for (i = 0; i < m_iQuantity; i++)
+    {
+        unsigned char& rucFlags = m_aucFlags[i];
+        int iParent = m_aiParent[i];
+        bool bRecompute;
+        if (rucFlags & F_WORLD_IS_CURRENT)
+        {
+            if (rucFlags & F_WORLD_CHANGED)
+            {
+                m_iWorldChanges++;
+            }
+            bRecompute = false;
+        }
+        else if (iParent >= 0)
+        {
+            bRecompute = (rucFlags & F_LOCAL_CHANGED)
+                || (m_aucFlags[iParent] & F_WORLD_CHANGED);
+        }
+        else
+        {
+            bRecompute = (rucFlags & F_LOCAL_CHANGED) || bParentChanged;
+        }
+
+        if (bRecompute)
+        {
+            // the arithmetic of Transformation::Product
+            Matrix3x kMatrix;
+            Vector3x kTranslate, kScale;
+            unsigned int uiHints;
+            if (iParent >= 0)
+            {
+                uiHints = Transformation::Product(m_akWorldMatrix[iParent],
+                    m_akWorldTranslate[iParent],m_akWorldScale[iParent],
+                    m_aucWorldHints[iParent],m_akLocalMatrix[i],
+                    m_akLocalTranslate[i],m_akLocalScale[i],
+                    m_aucLocalHints[i],kMatrix,kTranslate,kScale);
+            }
+            else if (pkRootParent)
+            {
+                uiHints = Transformation::Product(kParentMatrix,
+                    kParentTranslate,kParentScale,uiParentHints,
+                    m_akLocalMatrix[i],m_akLocalTranslate[i],
+                    m_akLocalScale[i],m_aucLocalHints[i],kMatrix,kTranslate,
+                    kScale);
+            }
+            else
+            {
+                kMatrix = m_akLocalMatrix[i];
+                kTranslate = m_akLocalTranslate[i];
+                kScale = m_akLocalScale[i];
+                uiHints = m_aucLocalHints[i];
+            }
+
+            if (SetWorld(i,kMatrix,kTranslate,kScale,uiHints))
+            {
+                m_apkObject[i]->World.Set(kMatrix,kTranslate,kScale,uiHints);
+                rucFlags |= F_WORLD_CHANGED;
+                m_iWorldChanges++;
+            }
+        }
+
+        if (m_aucKind[i] == K_GEOMETRY
+        &&  (rucFlags & (F_WORLD_CHANGED | F_MODEL_CHANGED)))
+        {
+            // same operations as SphereBV::TransformBy
+            const Sphere3x& rkModelBound = m_akModelBound[i];
+            Sphere3x kBound;
+            kBound.Center = Transformation::ApplyForward(m_akWorldMatrix[i],
+                m_akWorldTranslate[i],m_akWorldScale[i],m_aucWorldHints[i],
+                rkModelBound.Center);
+            kBound.Radius = Transformation::GetNorm(m_akWorldMatrix[i],
+                m_akWorldScale[i],m_aucWorldHints[i])*rkModelBound.Radius;
+            SetWorldBound(i,kBound);
+        }
+    }
+
+    // Backward sweep, the world bounds of the other objects.  The
+    // descendants of an object follow it, so their bounds are final when it
+    // is reached.
+    for (i = m_iQuantity - 1; i >= 0; i--)
+    {
+        unsigned char& rucFlags = m_aucFlags[i];
+        if (m_aucKind[i] == K_NODE)
+        {
+            if ((rucFlags & F_CHILD_BOUND_CHANGED)
+            &&  m_aiChildQuantity[i] > 0
+            &&  !m_apkObject[i]->WorldBoundIsCurrent)
+            {
+                // same merge order as Node::UpdateWorldBound
+                const int* aiChild = &m_aiChild[m_aiFirstChild[i]];
+                Sphere3x kBound = m_akWorldBound[aiChild[0]];
+                for (j = 1; j < m_aiChildQuantity[i]; j++)
+                {
+                    kBound = MergeSpheres(kBound,m_akWorldBound[aiChild[j]]);
+                }
+                SetWorldBound(i,kBound);
+            }
+        }
+        else if (m_aucKind[i] == K_OTHER)
+        {
+            if (rucFlags & (F_WORLD_CHANGED | F_MODEL_CHANGED |
+                F_CHILD_BOUND_CHANGED))
+            {
+                // the children of a Node-derived object were written back
+                Spatial* pkObject = m_apkObject[i];
+                pkObject->UpdateWorldBound();
+                Sphere3x kBound;
+                kBound.Center = pkObject->WorldBound->GetCenter();
+                kBound.Radius = pkObject->WorldBound->GetRadius();
+                SetWorldBound(i,kBound);
+            }
+        }
+
+        rucFlags &= (F_WORLD_IS_CURRENT | F_ANIMATED | F_TOUCHED);
+    }
+
+    if (pkRootParent && m_iBoundChanges > 0)
+    {
+        m_spkRoot->PropagateBoundToRoot();
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,46 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgLinearScene.inl                  //
+//                                                       //
+//  - Inlines for Linear Scene class                     //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+inline void LinearScene::Invalidate ()
+{
+    m_bCompiled = false;
+}
+//----------------------------------------------------------------------------
+inline Spatial* LinearScene::GetRoot () const
+{
+    return m_spkRoot;
+}
+//----------------------------------------------------------------------------
+inline int LinearScene::GetQuantity () const
+{
+    return m_iQuantity;
+}
+//----------------------------------------------------------------------------
+inline Spatial* LinearScene::GetObject (int iHandle) const
+{
+    assert(0 <= iHandle && iHandle < m_iQuantity);
+    return m_apkObject[iHandle];
+}
+//----------------------------------------------------------------------------
+inline int LinearScene::GetParent (int iHandle) const
+{
+    assert(0 <= iHandle && iHandle < m_iQuantity);
+    return m_aiParent[iHandle];
+}
+//----------------------------------------------------------------------------
+inline int LinearScene::GetWorldChanges () const
+{
+    return m_iWorldChanges;
+}
+//----------------------------------------------------------------------------
+inline int LinearScene::GetBoundChanges () const
+{
+    return m_iBoundChanges;
+}
+//----------------------------------------------------------------------------
@@ -11,14 +11,20 @@
 
 #include "WgFoundationPCH.h"
 #include "WgNode.h"
+#include "WgCamera.h"
+#include "WgSphereBV.h"
 using namespace WGSoft3D;
 
 WG3D_IMPLEMENT_RTTI(WGSoft3D,Node,Spatial);
 
+bool Node::ms_bBatchCulling = false;
+int Node::ms_iBatchThreshold = 8;
+
 //----------------------------------------------------------------------------
 Node::Node (int iQuantity, int iGrowBy)
     :
-    m_kChild(iQuantity,iGrowBy)
+    m_kChild(iQuantity,iGrowBy),
+    m_kCullPlane(0,iGrowBy)
 {
     m_iUsed = 0;
 }
@@ -43,16 +49,20 @@ int Node::AttachChild (Spatial* pkChild)
     assert( pkChild && !pkChild->GetParent() );
 
     pkChild->SetParent(this);
-    m_iUsed++;
 
-    // attach child in first available slot (if any)
+    // Attach child in first available slot (if any).  The slots are all
+    // used when the used quantity is the array quantity, which is the case
+    // while a node is built, so attaching its children does not search.
     int iQuantity = m_kChild.GetQuantity();
-    for (int i = 0; i < iQuantity; i++)
+    if (m_iUsed++ < iQuantity)
     {
-        if (m_kChild[i] == 0)
+        for (int i = 0; i < iQuantity; i++)
         {
-            m_kChild[i] = pkChild;
-            return i;
+            if (m_kChild[i] == 0)
+            {
+                m_kChild[i] = pkChild;
+                return i;
+            }
         }
     }
 
@@ -149,12 +159,67 @@ void Node::UpdateWorldData (double dAppTime)
 {
     Spatial::UpdateWorldData(dAppTime);
 
+    m_iSubtreeQuantity = 1;
     for (int i = 0; i < m_kChild.GetQuantity(); i++)
     {
         Spatial* pkChild = m_kChild[i];
         if (pkChild)
         {
-            pkChild->UpdateGS(dAppTime,false);
+            // When nothing changed in the subtree, its world data and bound
+            // are those of the previous update.
+            if (!ms_bIncrementalUpdate || pkChild->IsUpdateNeeded())
+            {
+                pkChild->UpdateGS(dAppTime,false);
+                m_iVisitedQuantity += pkChild->GetVisitedQuantity();
+            }
+
+            m_iSubtreeQuantity += pkChild->GetSubtreeQuantity();
+            if (pkChild->IsAnimated())
+            {
+                m_bAnimated = true;
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void Node::SplitWorldData (double dAppTime, TArray<Spatial*>& rkJoin,
+    TArray<Spatial*>& rkTask)
+{
+    if (m_iSubtreeQuantity <= ms_iUpdateThreshold)
+    {
+        rkTask.Append(this);
+        return;
+    }
+
+    // the node now, its bound after the tasks
+    Spatial::UpdateWorldData(dAppTime);
+    rkJoin.Append(this);
+
+    for (int i = 0; i < m_kChild.GetQuantity(); i++)
+    {
+        Spatial* pkChild = m_kChild[i];
+        if (pkChild)
+        {
+            pkChild->SplitUpdateGS(dAppTime,rkJoin,rkTask);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void Node::JoinWorldData ()
+{
+    m_iSubtreeQuantity = 1;
+    m_iVisitedQuantity = 1;
+    for (int i = 0; i < m_kChild.GetQuantity(); i++)
+    {
+        Spatial* pkChild = m_kChild[i];
+        if (pkChild)
+        {
+            m_iSubtreeQuantity += pkChild->GetSubtreeQuantity();
+            m_iVisitedQuantity += pkChild->GetVisitedQuantity();
+            if (pkChild->IsAnimated())
+            {
+                m_bAnimated = true;
+            }
         }
     }
 }
@@ -202,6 +267,13 @@ void Node::Draw (Renderer& rkRenderer, bool bNoCull)
 {
     if (m_spkEffect == 0)
     {
+        if (ms_bBatchCulling && !bNoCull
+        &&  m_kChild.GetQuantity() >= ms_iBatchThreshold)
+        {
+            DrawBatch(rkRenderer);
+            return;
+        }
+
         for (int i = 0; i < m_kChild.GetQuantity(); i++)
         {
             Spatial* pkChild = m_kChild[i];
@@ -219,6 +291,89 @@ void Node::Draw (Renderer& rkRenderer, bool bNoCull)
     }
 }
 //----------------------------------------------------------------------------
+void Node::DrawBatch (Renderer& rkRenderer)
+{
+    Camera* pkCamera = rkRenderer.GetCamera();
+    unsigned int uiState = pkCamera->GetPlaneState();
+
+    int iQuantity = m_kChild.GetQuantity();
+    int i;
+    if (m_kCullPlane.GetQuantity() < iQuantity)
+    {
+        m_kCullPlane.SetMaxQuantity(iQuantity,true);
+        for (i = m_kCullPlane.GetQuantity(); i < iQuantity; i++)
+        {
+            m_kCullPlane.Append(-1);
+        }
+    }
+
+    const int iMax = Camera::MAX_CULL_BATCH;
+    fixed afX[iMax], afY[iMax], afZ[iMax], afRadius[iMax];
+    unsigned int auiState[iMax];
+    int aiChild[iMax], aiPlane[iMax];
+    for (int iStart = 0; iStart < iQuantity; iStart += iMax)
+    {
+        int iEnd = (iStart + iMax < iQuantity ? iStart + iMax : iQuantity);
+
+        // gather the sphere bounds of the children that OnDraw would test
+        int iBatch = 0;
+        unsigned int uiFirst = 0;
+        for (i = iStart; i < iEnd; i++)
+        {
+            Spatial* pkChild = m_kChild[i];
+            if (pkChild && !pkChild->ForceCull
+            &&  pkChild->WorldBound->GetBVType() == BoundingVolume::BV_SPHERE)
+            {
+                const Sphere3x& rkSphere = StaticCast<SphereBV>(
+                    pkChild->WorldBound)->GetSphere();
+                afX[iBatch] = rkSphere.Center.X();
+                afY[iBatch] = rkSphere.Center.Y();
+                afZ[iBatch] = rkSphere.Center.Z();
+                afRadius[iBatch] = rkSphere.Radius;
+                aiChild[iBatch] = i;
+                if (m_kCullPlane[i] >= 0)
+                {
+                    uiFirst |= 1u << m_kCullPlane[i];
+                }
+                iBatch++;
+            }
+        }
+
+        pkCamera->Culled(iBatch,afX,afY,afZ,afRadius,uiFirst,auiState,
+            aiPlane);
+
+        // draw in the order of the children
+        int iLane = 0;
+        for (i = iStart; i < iEnd; i++)
+        {
+            Spatial* pkChild = m_kChild[i];
+            if (iLane < iBatch && aiChild[iLane] == i)
+            {
+                WG3D_RENDER_STATS_DO(
+                    rkRenderer.GetStats().GetCurrent().NodesVisited++);
+                m_kCullPlane[i] = aiPlane[iLane];
+                if (aiPlane[iLane] < 0)
+                {
+                    pkCamera->SetPlaneState(auiState[iLane]);
+                    pkChild->Draw(rkRenderer);
+                    pkCamera->SetPlaneState(uiState);
+                }
+#ifdef WG3D_RENDER_STATS
+                else
+                {
+                    rkRenderer.GetStats().GetCurrent().NodesCulled++;
+                }
+#endif
+                iLane++;
+            }
+            else if (pkChild)
+            {
+                pkChild->OnDraw(rkRenderer);
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
 void Node::DoPick (const Ray3x& rkRay, PickArray& rkResults)
 {
     if (WorldBound->TestIntersection(rkRay))
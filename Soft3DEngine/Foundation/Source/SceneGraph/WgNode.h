@@ -39,6 +39,18 @@ public:
     SpatialPtr SetChild (int i, Spatial* pkChild);
     SpatialPtr GetChild (int i);
 
+    // Batched culling.  When it is enabled, Draw culls the children of a
+    // node with at least iThreshold children in groups:  the sphere bounds
+    // of up to Camera::MAX_CULL_BATCH children are tested together against
+    // each active plane, and the planes that culled any of them in the
+    // previous draw are tested first.  The children drawn, their order and
+    // the plane states they are drawn with are those of Spatial::OnDraw.
+    // Bounds of other types are tested one at a time.  The default is the
+    // test of Spatial::OnDraw for every child.
+    static void SetBatchCulling (bool bBatch, int iThreshold = 8);
+    static bool GetBatchCulling ();
+    static int GetBatchThreshold ();
+
     // Picking support.  The origin and direction of the ray must be in world
     // coordinates.  The application is responsible for deleting the pick
     // records in the array.
@@ -48,6 +60,9 @@ protected:
     // geometric updates
     virtual void UpdateWorldData (double dAppTime);
     virtual void UpdateWorldBound ();
+    virtual void SplitWorldData (double dAppTime, TArray<Spatial*>& rkJoin,
+        TArray<Spatial*>& rkTask);
+    virtual void JoinWorldData ();
 
     // render state updates
     virtual void UpdateState (TStack<GlobalState*>* akGStack,
@@ -57,6 +72,14 @@ protected:
     TArray<SpatialPtr> m_kChild;
     int m_iUsed;
 
+    // batched culling, the plane that culled each child in the previous
+    // draw, or -1
+    void DrawBatch (Renderer& rkRenderer);
+    TArray<int> m_kCullPlane;
+
+    static bool ms_bBatchCulling;
+    static int ms_iBatchThreshold;
+
 // internal use
 public:
     // Drawing.  The Renderer needs to call this when the Node has a global
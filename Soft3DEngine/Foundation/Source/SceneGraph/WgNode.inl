@@ -19,4 +19,19 @@ inline int Node::GetUsed () const
     return m_iUsed;
 }
 //----------------------------------------------------------------------------
-
+inline void Node::SetBatchCulling (bool bBatch, int iThreshold)
+{
+    ms_bBatchCulling = bBatch;
+    ms_iBatchThreshold = iThreshold;
+}
+//----------------------------------------------------------------------------
+inline bool Node::GetBatchCulling ()
+{
+    return ms_bBatchCulling;
+}
+//----------------------------------------------------------------------------
+inline int Node::GetBatchThreshold ()
+{
+    return ms_iBatchThreshold;
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgOrientedBoxBV.cpp                //
+//                                                       //
+//  - Implementation for Oriented Box BV class           //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgOrientedBoxBV.h"
+#include "WgContBox3.h"
+#include "WgIntrBox3Box3.h"
+#include "WgIntrBox3Sphere3.h"
+#include "WgIntrRay3Box3.h"
+using namespace WGSoft3D;
+
+WG3D_IMPLEMENT_RTTI(WGSoft3D,OrientedBoxBV,BoundingVolume);
+WG3D_IMPLEMENT_DEFAULT_NAME_ID(OrientedBoxBV,BoundingVolume);
+
+//----------------------------------------------------------------------------
+OrientedBoxBV::OrientedBoxBV ()
+    :
+    m_kBox(Vector3x::ZERO,Vector3x::UNIT_X,Vector3x::UNIT_Y,Vector3x::UNIT_Z,
+        fixed(FIXED_ZERO),fixed(FIXED_ZERO),fixed(FIXED_ZERO))
+{
+}
+//----------------------------------------------------------------------------
+OrientedBoxBV::OrientedBoxBV (const Box3x& rkBox)
+    :
+    m_kBox(rkBox)
+{
+}
+//----------------------------------------------------------------------------
+void OrientedBoxBV::ComputeFromData (const Vector3xArray* pkVertices)
+{
+    if (pkVertices && pkVertices->GetQuantity() > 0)
+    {
+        m_kBox = ContAlignedBox(pkVertices->GetQuantity(),
+            pkVertices->GetData());
+    }
+}
+//----------------------------------------------------------------------------
+void OrientedBoxBV::TransformBy (const Transformation& rkTransform,
+    BoundingVolume* pkResult)
+{
+    assert(pkResult->GetBVType() == BV_ORIENTED_BOX);
+    Box3x& rkTarget = ((OrientedBoxBV*)pkResult)->m_kBox;
+
+    int i;
+    if (rkTransform.IsRSMatrix() && rkTransform.IsUniformScale())
+    {
+        const Matrix3x& rkRotate = rkTransform.GetRotate();
+        fixed fScale = Mathx::FAbs(rkTransform.GetUniformScale());
+        rkTarget.Center = rkTransform.ApplyForward(m_kBox.Center);
+        for (i = 0; i < 3; i++)
+        {
+            rkTarget.Axis[i] = rkRotate*m_kBox.Axis[i];
+            rkTarget.Extent[i] = fScale*m_kBox.Extent[i];
+        }
+        return;
+    }
+
+    // The images of the axes are not orthogonal in general.  The box with
+    // the orthonormalized images contains the images of the corners, so it
+    // contains the whole parallelepiped.
+    Vector3x akVertex[8], akWorldVertex[8], akAxis[3];
+    m_kBox.ComputeVertices(akVertex);
+    rkTransform.ApplyForward(8,akVertex,akWorldVertex);
+    Vector3x kOrigin = rkTransform.ApplyForward(Vector3x::ZERO);
+    for (i = 0; i < 3; i++)
+    {
+        akAxis[i] = rkTransform.ApplyForward(m_kBox.Axis[i]) - kOrigin;
+    }
+    Vector3x::Orthonormalize(akAxis);
+    rkTarget = ContBox(akAxis,8,akWorldVertex);
+}
+//----------------------------------------------------------------------------
+int OrientedBoxBV::WhichSide (const Plane3x& rkPlane) const
+{
+    fixed fProjRadius =
+        m_kBox.Extent[0]*Mathx::FAbs(rkPlane.Normal.Dot(m_kBox.Axis[0])) +
+        m_kBox.Extent[1]*Mathx::FAbs(rkPlane.Normal.Dot(m_kBox.Axis[1])) +
+        m_kBox.Extent[2]*Mathx::FAbs(rkPlane.Normal.Dot(m_kBox.Axis[2]));
+
+    fixed fDistance = rkPlane.DistanceTo(m_kBox.Center);
+
+    if (fDistance <= -fProjRadius)
+    {
+        return -1;
+    }
+    else if (fDistance >= fProjRadius)
+    {
+        return +1;
+    }
+
+    return 0;
+}
+//----------------------------------------------------------------------------
+bool OrientedBoxBV::TestIntersection (const Ray3x& rkRay) const
+{
+    return IntrRay3Box3x(rkRay,m_kBox).Test();
+}
+//----------------------------------------------------------------------------
+bool OrientedBoxBV::TestIntersection (const BoundingVolume* pkInput) const
+{
+    if (pkInput->GetBVType() == BV_SPHERE)
+    {
+        Sphere3x kSphere(pkInput->GetCenter(),pkInput->GetRadius());
+        return IntrBox3Sphere3x(m_kBox,kSphere).Test();
+    }
+
+    Box3x kInput = pkInput->GetBox();
+    return IntrBox3Box3x(m_kBox,kInput).Test();
+}
+//----------------------------------------------------------------------------
+void OrientedBoxBV::CopyFrom (const BoundingVolume* pkInput)
+{
+    m_kBox = pkInput->GetBox();
+}
+//----------------------------------------------------------------------------
+void OrientedBoxBV::GrowToContain (const BoundingVolume* pkInput)
+{
+    m_kBox = MergeBoxes(m_kBox,pkInput->GetBox());
+}
+//----------------------------------------------------------------------------
+bool OrientedBoxBV::Contains (const Vector3x& rkPoint) const
+{
+    return InBox(rkPoint,m_kBox);
+}
+//----------------------------------------------------------------------------
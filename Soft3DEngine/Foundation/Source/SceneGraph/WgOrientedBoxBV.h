@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgOrientedBoxBV.h                  //
+//                                                       //
+//  - Interface for Oriented Box Bounding Volume class   //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_ORIENTEDBOXBV_H__
+#define __WG_ORIENTEDBOXBV_H__
+
+#include "WgFoundationLIB.h"
+#include "WgBoundingVolume.h"
+
+namespace WGSoft3D
+{
+
+// An oriented box.  The model box of a Geometry is aligned with the model
+// axes, and the world box turns with the object, so it stays as tight as
+// the model box under any rotation.  The bound of a Node is the box with
+// the axes of its largest child that contains all the children.
+
+class WG3D_FOUNDATION_ITEM OrientedBoxBV : public BoundingVolume
+{
+    WG3D_DECLARE_RTTI;
+    WG3D_DECLARE_NAME_ID;
+
+public:
+    // construction
+    OrientedBoxBV ();  // center (0,0,0), axes of the world, extents 0
+    OrientedBoxBV (const Box3x& rkBox);
+
+    virtual int GetBVType () const;
+
+    // All bounding volumes must define a center and radius.  The radius is
+    // half the diagonal of the box.  SetRadius sets all extents to the
+    // radius, so the box contains the sphere of that radius.
+    virtual void SetCenter (const Vector3x& rkCenter);
+    virtual void SetRadius (fixed fRadius);
+    virtual Vector3x GetCenter () const;
+    virtual fixed GetRadius () const;
+
+    virtual Box3x GetBox () const;
+
+    Box3x& Box ();
+
+    // Compute the smallest box with the model axes that contains all the
+    // points.
+    virtual void ComputeFromData (const Vector3xArray* pkVertices);
+
+    // Transform the box (model-to-world conversion).  A rotation with a
+    // uniform scale turns and scales the box.  Other transformations turn
+    // a box into a parallelepiped, which is then bounded by the box with
+    // the orthonormalized images of the axes.
+    virtual void TransformBy (const Transformation& rkTransform,
+        BoundingVolume* pkResult);
+
+    // Determine if the bounding volume is one side of the plane, the other
+    // side, or straddles the plane.  If it is on the positive side (the
+    // side to which the normal points), the return value is +1.  If it is
+    // on the negative side, the return value is -1.  If it straddles the
+    // plane, the return value is 0.
+    virtual int WhichSide (const Plane3x& rkPlane) const;
+
+    // Test for intersection of ray and bound (points of intersection not
+    // computed).
+    virtual bool TestIntersection (const Ray3x& rkRay) const;
+
+    // Test for intersection of the two bounds.
+    virtual bool TestIntersection (const BoundingVolume* pkInput) const;
+
+    // Make a copy of the bounding volume.  Another type is replaced by its
+    // box.
+    virtual void CopyFrom (const BoundingVolume* pkInput);
+
+    // Change the current box so that it contains the input bound as well
+    // as its old box (see MergeBoxes).
+    virtual void GrowToContain (const BoundingVolume* pkInput);
+
+    // test for containment of a point
+    virtual bool Contains (const Vector3x& rkPoint) const;
+
+protected:
+    Box3x m_kBox;
+};
+
+#include "WgOrientedBoxBV.inl"
+
+typedef Pointer<OrientedBoxBV> OrientedBoxBVPtr;
+
+}
+
+#endif
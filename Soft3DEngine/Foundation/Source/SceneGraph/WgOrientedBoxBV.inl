@@ -0,0 +1,45 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgOrientedBoxBV.inl                //
+//                                                       //
+//  - Inlines for Oriented Box Bounding Volume class     //
+//                                                       //
+///////////////////////////////////////////////////////////
+//----------------------------------------------------------------------------
+inline int OrientedBoxBV::GetBVType () const
+{
+    return BoundingVolume::BV_ORIENTED_BOX;
+}
+//----------------------------------------------------------------------------
+inline void OrientedBoxBV::SetCenter (const Vector3x& rkCenter)
+{
+    m_kBox.Center = rkCenter;
+}
+//----------------------------------------------------------------------------
+inline void OrientedBoxBV::SetRadius (fixed fRadius)
+{
+    m_kBox.Extent[0] = fRadius;
+    m_kBox.Extent[1] = fRadius;
+    m_kBox.Extent[2] = fRadius;
+}
+//----------------------------------------------------------------------------
+inline Vector3x OrientedBoxBV::GetCenter () const
+{
+    return m_kBox.Center;
+}
+//----------------------------------------------------------------------------
+inline fixed OrientedBoxBV::GetRadius () const
+{
+    return Vector3x(m_kBox.Extent).Length();
+}
+//----------------------------------------------------------------------------
+inline Box3x OrientedBoxBV::GetBox () const
+{
+    return m_kBox;
+}
+//----------------------------------------------------------------------------
+inline Box3x& OrientedBoxBV::Box ()
+{
+    return m_kBox;
+}
+//----------------------------------------------------------------------------
@@ -80,37 +80,15 @@ void PolarCamera::polarToCartesianDeg(fixed azimuthDegAngle ,fixed altitudeDegAn
 }
 void PolarCamera::polarToCartesianRad(fixed azimuthDegAngle ,fixed altitudeDegAngle ,fixed dist ,Vector3x &pKVecOut)
 {
-	float x,y,z;
-	float azimuthDegAnglef= FloatFromFixed(azimuthDegAngle);
-	float theta=Mathf::HALF_PI - FloatFromFixed(azimuthDegAngle);
-	float tantheta =(float)tan(theta);//Mathf::Tan(theta);
-	float radian_alt=FloatFromFixed(altitudeDegAngle);
-	float cospsi =Mathf::Cos(radian_alt);
-	float distf=FloatFromFixed(dist);
-	x= Mathf::Sqrt(((distf*distf)/(tantheta * tantheta + 1.0f)));
-	z= tantheta * x;
-	
-	x=-x;
-	if(((azimuthDegAnglef>=Mathf::PI) && (azimuthDegAnglef <=(2.0f*Mathf::PI))) || (azimuthDegAnglef==0.0f))
-	{
-		x=-x;
-		z=-z;
-	}
-	y=Mathf::Sqrt((z * z + x * x))*Mathf::Sin(radian_alt);
-	
-	if(distf<0.0f)
-	{
-		x = -x;
-		y = -y;
-		z = -z;
-	}
-	
-	x= x*cospsi;
-	z= z*cospsi;
-	
-	pKVecOut.X()=FixedFromFloat(x);
-	pKVecOut.Y()=FixedFromFloat(z);
-	pKVecOut.Z()=FixedFromFloat(y);
+	// x = -d*cos(alt)*sin(az), y = d*cos(alt)*cos(az), z = d*sin(alt)
+	fixed sinAz,cosAz,sinAlt,cosAlt;
+	sincosx(azimuthDegAngle,sinAz,cosAz,FIXED_NORMAL);
+	sincosx(altitudeDegAngle,sinAlt,cosAlt,FIXED_NORMAL);
+	fixed horiz=dist*cosAlt;
+	
+	pKVecOut.X()=-(horiz*sinAz);
+	pKVecOut.Y()=horiz*cosAz;
+	pKVecOut.Z()=dist*sinAlt;
 	
 }
 
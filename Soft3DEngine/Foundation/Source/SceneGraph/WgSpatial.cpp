@@ -13,10 +13,36 @@
 #include "WgSpatial.h"
 #include "WgCamera.h"
 #include "WgLight.h"
+#include "WgLinearScene.h"
+#include "WgSpatialIndex.h"
+#include "WgTaskPool.h"
+#include "WgProfiler.h"
 using namespace WGSoft3D;
 
 WG3D_IMPLEMENT_RTTI(WGSoft3D,Spatial,Object);
 
+bool Spatial::ms_bIncrementalUpdate = false;
+int Spatial::ms_iUpdateVisited = 0;
+int Spatial::ms_iUpdateSkipped = 0;
+TaskPool* Spatial::ms_pkUpdatePool = 0;
+int Spatial::ms_iUpdateThreshold = 512;
+
+// A task of the parallel update, consecutive subtrees updated serially.
+class SpatialUpdateTask : public Task
+{
+public:
+    virtual void Execute (TaskPool&, int)
+    {
+        for (int i = 0; i < Quantity; i++)
+        {
+            Subtree[i]->UpdateGS(AppTime,false);
+        }
+    }
+
+    Spatial** Subtree;
+    int Quantity;
+    double AppTime;
+};
 
 //----------------------------------------------------------------------------
 Spatial::Spatial ()
@@ -27,23 +53,66 @@ Spatial::Spatial ()
     WorldIsCurrent = false;
     WorldBoundIsCurrent = false;
     m_pkParent = 0;
-    m_pkGlobalList = 0;
-    m_pkLightList = 0;
+    m_uiGlobalStates = 0;
+    m_pkLightArray = 0;
+    m_uiDirty = DIRTY_SELF | DIRTY_CHILD;
+    m_uiLocalVersion = 0;
+    m_uiParentVersion = 0;
+    m_uiWorldVersion = 0;
+    m_bAnimated = false;
+    m_iSubtreeQuantity = 1;
+    m_iVisitedQuantity = 1;
+    m_pkLinearScene = 0;
+    m_iLinearHandle = -1;
+    m_pkSpatialIndex = 0;
+    m_iIndexHandle = -1;
 }
 //----------------------------------------------------------------------------
 Spatial::~Spatial ()
 {
-    RemoveAllGlobalStates();
-    RemoveAllLights();
+    if (m_pkLinearScene)
+    {
+        m_pkLinearScene->OnDestroy(m_iLinearHandle);
+    }
+    if (m_pkSpatialIndex)
+    {
+        m_pkSpatialIndex->OnDestroy(m_iIndexHandle);
+    }
+
+    // the Remove functions would mark an object that is going away dirty
+    for (int i = 0; i < GlobalState::MAX_STATE; i++)
+    {
+        m_aspkGlobalState[i] = 0;
+    }
+    WG_DELETE m_pkLightArray;
 }
 //----------------------------------------------------------------------------
 void Spatial::UpdateGS (double dAppTime, bool bInitiator)
 {
-    UpdateWorldData(dAppTime);
-    UpdateWorldBound();
+    WG3D_PROFILE("Spatial::UpdateGS");
+
+#ifdef WG3D_RENDER_STATS
+    double dStart = (bInitiator ? System::GetPreciseTime() : 0.0);
+#endif
+
+    if (bInitiator && ms_pkUpdatePool
+    &&  m_iSubtreeQuantity > ms_iUpdateThreshold)
+    {
+        UpdateParallel(dAppTime);
+    }
+    else
+    {
+        UpdateWorldData(dAppTime);
+        UpdateWorldBound();
+    }
+
     if (bInitiator)
     {
         PropagateBoundToRoot();
+        ms_iUpdateVisited = m_iVisitedQuantity;
+        ms_iUpdateSkipped = m_iSubtreeQuantity - m_iVisitedQuantity;
+        WG3D_RENDER_STATS_DO(RenderStats::AddUpdateTime(
+            System::GetPreciseTime() - dStart));
     }
 }
 //----------------------------------------------------------------------------
@@ -55,33 +124,229 @@ void Spatial::UpdateBS ()
 //----------------------------------------------------------------------------
 void Spatial::UpdateWorldData (double dAppTime)
 {
+    bool bForce = ((m_uiDirty & DIRTY_SELF) != 0);
+    m_uiDirty = 0;
+    m_iVisitedQuantity = 1;
+
     // update any controllers associated with this object
     UpdateControllers(dAppTime);
+    m_bAnimated = (GetControllerQuantity() > 0);
 
-    TList<GlobalStatePtr>* pkGList;
-    for (pkGList = m_pkGlobalList; pkGList!=NULL; pkGList = pkGList->Next())
+    int i;
+    for (i = 0; (m_uiGlobalStates >> i) != 0; i++)
     {
-        pkGList->Item()->UpdateControllers(dAppTime);
+        GlobalState* pkGState = m_aspkGlobalState[i];
+        if (pkGState)
+        {
+            if (UpdateSharedControllers(pkGState,dAppTime)
+            ||  pkGState->GetControllerQuantity() > 0)
+            {
+                m_bAnimated = true;
+            }
+        }
     }
 
-    TList<LightPtr>* pkLList;
-    for (pkLList = m_pkLightList; pkLList!=NULL; pkLList = pkLList->Next())
+    for (i = GetLightQuantity() - 1; i >= 0; i--)
     {
-        pkLList->Item()->UpdateControllers(dAppTime);
+        if (UpdateSharedControllers((*m_pkLightArray)[i],dAppTime)
+        ||  (*m_pkLightArray)[i]->GetControllerQuantity() > 0)
+        {
+            m_bAnimated = true;
+        }
     }
 
-    // update world transforms
+    // Update world transforms.  The product is skipped when neither Local
+    // nor the parent's World changed since it was last computed and World
+    // was not set directly.
     if (!WorldIsCurrent)
     {
-        if (m_pkParent)
+        unsigned int uiParentVersion =
+            (m_pkParent ? m_pkParent->World.GetVersion() : 0);
+
+        if (bForce
+        ||  Local.GetVersion() != m_uiLocalVersion
+        ||  uiParentVersion != m_uiParentVersion
+        ||  World.GetVersion() != m_uiWorldVersion)
         {
-            World.Product(m_pkParent->World,Local);
+            if (m_pkParent)
+            {
+                World.Product(m_pkParent->World,Local);
+            }
+            else
+            {
+                World = Local;
+            }
+
+            m_uiLocalVersion = Local.GetVersion();
+            m_uiParentVersion = uiParentVersion;
+            m_uiWorldVersion = World.GetVersion();
         }
-        else
+    }
+}
+//----------------------------------------------------------------------------
+void Spatial::SetUpdatePool (TaskPool* pkPool, int iThreshold)
+{
+    ms_pkUpdatePool = pkPool;
+    ms_iUpdateThreshold = iThreshold;
+}
+//----------------------------------------------------------------------------
+void Spatial::UpdateParallel (double dAppTime)
+{
+    // the lists of the update are released from the arena at the end
+    FrameArena* pkArena = FrameArena::GetFrame();
+    size_t uiMark = (pkArena ? pkArena->GetMark() : 0);
+    UpdateParallel(dAppTime,pkArena);
+    if (pkArena)
+    {
+        pkArena->Release(uiMark);
+    }
+}
+//----------------------------------------------------------------------------
+void Spatial::UpdateParallel (double dAppTime, FrameArena* pkArena)
+{
+    TArray<Spatial*> kJoin(0,64,pkArena), kSubtree(0,256,pkArena);
+    SplitWorldData(dAppTime,kJoin,kSubtree);
+
+    // Deal the subtrees to tasks of at least ms_iUpdateThreshold objects.
+    int iQuantity = kSubtree.GetQuantity();
+    TArray<SpatialUpdateTask> kTask(iQuantity,0,pkArena);
+    TArray<Task*> kTaskPtr(iQuantity,0,pkArena);
+    SpatialUpdateTask* akTask = kTask.GetArray();
+    Task** apkTask = kTaskPtr.GetArray();
+    int iTaskQuantity = 0, iObjects = 0, i;
+    for (i = 0; i < iQuantity; i++)
+    {
+        if (iObjects == 0)
         {
-            World = Local;
+            SpatialUpdateTask& rkTask = akTask[iTaskQuantity];
+            rkTask.Subtree = &kSubtree[i];
+            rkTask.Quantity = 0;
+            rkTask.AppTime = dAppTime;
+            apkTask[iTaskQuantity++] = &rkTask;
         }
+
+        akTask[iTaskQuantity-1].Quantity++;
+        iObjects += kSubtree[i]->GetSubtreeQuantity();
+        if (iObjects >= ms_iUpdateThreshold)
+        {
+            iObjects = 0;
+        }
+    }
+
+    ms_pkUpdatePool->Run(iTaskQuantity,apkTask);
+
+    // Children precede their parents in reverse order, so each bound is
+    // grown from final child bounds, in the order of Node::UpdateWorldBound.
+    for (i = kJoin.GetQuantity() - 1; i >= 0; i--)
+    {
+        kJoin[i]->JoinWorldData();
+        kJoin[i]->UpdateWorldBound();
+    }
+}
+//----------------------------------------------------------------------------
+void Spatial::SplitUpdateGS (double dAppTime, TArray<Spatial*>& rkJoin,
+    TArray<Spatial*>& rkTask)
+{
+    if (ms_bIncrementalUpdate && !IsUpdateNeeded())
+    {
+        // nothing changed in the subtree
+        m_iVisitedQuantity = 0;
+        return;
+    }
+
+    SplitWorldData(dAppTime,rkJoin,rkTask);
+}
+//----------------------------------------------------------------------------
+void Spatial::SplitWorldData (double, TArray<Spatial*>&,
+    TArray<Spatial*>& rkTask)
+{
+    rkTask.Append(this);
+}
+//----------------------------------------------------------------------------
+void Spatial::JoinWorldData ()
+{
+}
+//----------------------------------------------------------------------------
+bool Spatial::UpdateSharedControllers (Object* pkObject, double dAppTime)
+{
+    // Global states and lights may be attached to objects that are updated
+    // by different tasks.
+    if (ms_pkUpdatePool && pkObject->GetControllerQuantity() > 0)
+    {
+        ms_pkUpdatePool->Lock();
+        bool bUpdated = pkObject->UpdateControllers(dAppTime);
+        ms_pkUpdatePool->Unlock();
+        return bUpdated;
+    }
+    return pkObject->UpdateControllers(dAppTime);
+}
+//----------------------------------------------------------------------------
+void Spatial::MarkDirty ()
+{
+    m_uiDirty |= DIRTY_SELF;
+    PropagateDirty();
+    if (m_pkLinearScene)
+    {
+        m_pkLinearScene->Touch(m_iLinearHandle);
+    }
+}
+//----------------------------------------------------------------------------
+void Spatial::PropagateDirty ()
+{
+    // An object flagged DIRTY_CHILD has all its ancestors flagged as well,
+    // so the walk stops at the first one that is already flagged.
+    for (Spatial* pkObject = this; pkObject; pkObject = pkObject->m_pkParent)
+    {
+        if (pkObject->m_uiDirty & DIRTY_CHILD)
+        {
+            break;
+        }
+        pkObject->m_uiDirty |= DIRTY_CHILD;
+    }
+}
+//----------------------------------------------------------------------------
+void Spatial::SetParent (Spatial* pkParent)
+{
+    // the old parent must regrow its bound without this child
+    if (m_pkParent)
+    {
+        m_pkParent->PropagateDirty();
+        if (m_pkParent->m_pkLinearScene)
+        {
+            m_pkParent->m_pkLinearScene->Invalidate();
+        }
+    }
+    if (pkParent && pkParent->m_pkLinearScene)
+    {
+        pkParent->m_pkLinearScene->Invalidate();
+    }
+
+    // the subtree leaves the index of the old parent and joins the index
+    // of the new one
+    if (m_pkParent && m_pkSpatialIndex
+    &&  m_pkParent->m_pkSpatialIndex == m_pkSpatialIndex)
+    {
+        m_pkSpatialIndex->OnDetach(m_iIndexHandle);
+    }
+    if (pkParent && pkParent->m_pkSpatialIndex)
+    {
+        pkParent->m_pkSpatialIndex->OnAttach(this,
+            pkParent->m_iIndexHandle);
     }
+    m_pkParent = pkParent;
+
+    // A new or detached object may still be flagged from before, so the
+    // flags of the new ancestors are not implied by its own.
+    if (m_pkParent)
+    {
+        m_pkParent->PropagateDirty();
+    }
+    MarkDirty();
+}
+//----------------------------------------------------------------------------
+void Spatial::OnControllerChange ()
+{
+    MarkDirty();
 }
 //----------------------------------------------------------------------------
 void Spatial::PropagateBoundToRoot ()
@@ -97,154 +362,92 @@ void Spatial::SetGlobalState (GlobalState* pkState)
 {
     assert(pkState);
 
-    // check if type of state already exists
-    TList<GlobalStatePtr>* pkList;
-    for (pkList = m_pkGlobalList; pkList!=NULL; pkList = pkList->Next())
-    {
-        if (pkList->Item()->GetGlobalStateType() ==
-            pkState->GetGlobalStateType())
-        {
-            // type of state exists, replace it
-            pkList->Item() = pkState;
-            return;
-        }
-    }
-
-    // type of state not in current list, add state
-    pkList = WG_NEW TList<GlobalStatePtr>;
-    pkList->Item() = pkState;
-    pkList->Next() = m_pkGlobalList;
-    m_pkGlobalList = pkList;
+    // a state replaces the one of its type
+    int eType = pkState->GetGlobalStateType();
+    m_aspkGlobalState[eType] = pkState;
+    m_uiGlobalStates |= (1 << eType);
+    MarkDirty();
 }
 //----------------------------------------------------------------------------
 GlobalState* Spatial::GetGlobalState (int eType) const
 {
-    // check if type of state already exists
-    TList<GlobalStatePtr>* pkList;
-    for (pkList = m_pkGlobalList; pkList!=NULL; pkList = pkList->Next())
+    if (0 <= eType && eType < GlobalState::MAX_STATE)
     {
-        if (pkList->Item()->GetGlobalStateType() == eType)
-        {
-            // type of state exists, return it
-            return pkList->Item();
-        }
+        return m_aspkGlobalState[eType];
     }
     return 0;
 }
 //----------------------------------------------------------------------------
 void Spatial::RemoveGlobalState (int eType)
 {
-    // check if type of state already exists
-    TList<GlobalStatePtr>* pkList = m_pkGlobalList;
-    TList<GlobalStatePtr>* pkPrev = 0;
-    for (/**/; pkList!=NULL; pkPrev = pkList, pkList = pkList->Next())
+    if (0 <= eType && eType < GlobalState::MAX_STATE)
     {
-        if (pkList->Item()->GetGlobalStateType() == eType)
-        {
-            // type of state exists, remove it
-            if (pkPrev)
-            {
-                // render state not at front of list
-                pkPrev->Next() = pkList->Next();
-            }
-            else
-            {
-                // render state at front of list
-                assert(pkList == m_pkGlobalList);
-                m_pkGlobalList = pkList->Next();
-            }
-            pkList->Next() = 0;
-            WG_DELETE pkList;
-            return;
-        }
+        m_aspkGlobalState[eType] = 0;
+        m_uiGlobalStates &= ~(1 << eType);
+        MarkDirty();
     }
 }
 //----------------------------------------------------------------------------
 void Spatial::RemoveAllGlobalStates ()
 {
-    while (m_pkGlobalList)
+    for (int i = 0; i < GlobalState::MAX_STATE; i++)
     {
-        m_pkGlobalList->Item() = 0;
-        TList<GlobalStatePtr>* pkSave = m_pkGlobalList->Next();
-        WG_DELETE m_pkGlobalList;
-        m_pkGlobalList = pkSave;
+        m_aspkGlobalState[i] = 0;
     }
+    m_uiGlobalStates = 0;
+    MarkDirty();
 }
 //----------------------------------------------------------------------------
 void Spatial::SetLight (Light* pkLight)
 {
     assert(pkLight);
 
-    // check if light is already in the list
-    TList<LightPtr>* pkList;
-    for (pkList = m_pkLightList; pkList; pkList = pkList->Next())
+    // check if light is already attached
+    if (!m_pkLightArray)
+    {
+        m_pkLightArray = WG_NEW TSmallArray<LightPtr,2>;
+    }
+    for (int i = 0; i < m_pkLightArray->GetQuantity(); i++)
     {
-        if (pkList->Item() == pkLight)
+        if ((*m_pkLightArray)[i] == pkLight)
         {
             // light already exists, nothing to do
             return;
         }
     }
 
-    // light not in current list, add it
-    pkList = WG_NEW TList<LightPtr>;
-    pkList->Item() = pkLight;
-    pkList->Next() = m_pkLightList;
-    m_pkLightList = pkList;
+    m_pkLightArray->Append(pkLight);
+    MarkDirty();
 }
 //----------------------------------------------------------------------------
 int Spatial::GetLightQuantity () const
 {
-    int iLightQuantity = 0;
-
-    TList<LightPtr>* pkList;
-    for (pkList = m_pkLightList; pkList; pkList = pkList->Next())
-    {
-        iLightQuantity++;
-    }
-
-    return iLightQuantity;
+    return (m_pkLightArray ? m_pkLightArray->GetQuantity() : 0);
 }
 //----------------------------------------------------------------------------
 Light* Spatial::GetLight (int i) const
 {
     assert(i >= 0);
 
-    TList<LightPtr>* pkList = m_pkLightList;
-    for (int j = 0; j < i; j++, pkList = pkList->Next())
+    // the most recently attached light is light 0
+    int iQuantity = GetLightQuantity();
+    if (0 <= i && i < iQuantity)
     {
-        if (!pkList)
-        {
-            // i >= iLightQuantity
-            return 0;
-        }
+        return (*m_pkLightArray)[iQuantity-1-i];
     }
-    return (pkList ? pkList->Item() : 0);
+    return 0;
 }
 //----------------------------------------------------------------------------
 void Spatial::RemoveLight (Light* pkLight)
 {
-    // check if light is in list
-    TList<LightPtr>* pkList = m_pkLightList;
-    TList<LightPtr>* pkPrev = 0;
-    for (/**/; pkList; pkPrev = pkList, pkList = pkList->Next())
+    int iQuantity = GetLightQuantity();
+    for (int i = 0; i < iQuantity; i++)
     {
-        if (pkList->Item() == pkLight)
+        if ((*m_pkLightArray)[i] == pkLight)
         {
             // light exists, remove it
-            if (pkPrev)
-            {
-                // light not at front of list
-                pkPrev->Next() = pkList->Next();
-            }
-            else
-            {
-                // light at front of list
-                assert(pkList == m_pkLightList);
-                m_pkLightList = pkList->Next();
-            }
-            pkList->Next() = 0;
-            WG_DELETE pkList;
+            m_pkLightArray->Remove(i);
+            MarkDirty();
             return;
         }
     }
@@ -252,31 +455,53 @@ void Spatial::RemoveLight (Light* pkLight)
 //----------------------------------------------------------------------------
 void Spatial::RemoveAllLights ()
 {
-    while (m_pkLightList)
-    {
-        m_pkLightList->Item() = 0;
-        TList<LightPtr>* pkSave = m_pkLightList->Next();
-        WG_DELETE m_pkLightList;
-        m_pkLightList = pkSave;
-    }
+    WG_DELETE m_pkLightArray;
+    m_pkLightArray = 0;
+    MarkDirty();
 }
 //----------------------------------------------------------------------------
 void Spatial::UpdateRS (TStack<GlobalState*>* akGStack,
     TStack<Light*>* pkLStack)
 {
+    WG3D_PROFILE("Spatial::UpdateRS");
+
     bool bInitiator = (akGStack == 0);
+    FrameArena* pkArena = (bInitiator ? FrameArena::GetFrame() : 0);
+    size_t uiMark = 0;
+    int i;
 
     if (bInitiator)
     {
         // stack initialized to contain the default global states
-        akGStack = WG_NEW TStack<GlobalState*>[GlobalState::MAX_STATE];
-        for (int i = 0; i < GlobalState::MAX_STATE; i++)
+        if (pkArena)
+        {
+            uiMark = pkArena->GetMark();
+            akGStack = (TStack<GlobalState*>*)pkArena->Allocate(
+                GlobalState::MAX_STATE*sizeof(TStack<GlobalState*>));
+            for (i = 0; i < GlobalState::MAX_STATE; i++)
+            {
+                new(&akGStack[i]) TStack<GlobalState*>(64,pkArena);
+            }
+        }
+        else
+        {
+            akGStack = WG_NEW TStack<GlobalState*>[GlobalState::MAX_STATE];
+        }
+        for (i = 0; i < GlobalState::MAX_STATE; i++)
         {
             akGStack[i].Push(GlobalState::Default[i]);
         }
 
         // stack has no lights initially
-        pkLStack = WG_NEW TStack<Light*>;
+        if (pkArena)
+        {
+            pkLStack = new(pkArena->Allocate(sizeof(TStack<Light*>)))
+                TStack<Light*>(64,pkArena);
+        }
+        else
+        {
+            pkLStack = WG_NEW TStack<Light*>;
+        }
 
         // traverse to root and push states from root to this node
         PropagateStateFromRoot(akGStack,pkLStack);
@@ -290,7 +515,16 @@ void Spatial::UpdateRS (TStack<GlobalState*>* akGStack,
     // propagate the new state to the subtree rooted here
     UpdateState(akGStack,pkLStack);
 
-    if (bInitiator)
+    if (pkArena)
+    {
+        for (i = 0; i < GlobalState::MAX_STATE; i++)
+        {
+            akGStack[i].~TStack<GlobalState*>();
+        }
+        pkLStack->~TStack<Light*>();
+        pkArena->Release(uiMark);
+    }
+    else if (bInitiator)
     {
         WG_DELETE[] akGStack;
         WG_DELETE pkLStack;
@@ -318,33 +552,36 @@ void Spatial::PropagateStateFromRoot (TStack<GlobalState*>* akGStack,
 void Spatial::PushState (TStack<GlobalState*>* akGStack,
     TStack<Light*>* pkLStack)
 {
-    TList<GlobalStatePtr>* pkGList;
-    for (pkGList = m_pkGlobalList; pkGList; pkGList = pkGList->Next())
+    int i;
+    for (i = 0; (m_uiGlobalStates >> i) != 0; i++)
     {
-        int eType = pkGList->Item()->GetGlobalStateType();
-        akGStack[eType].Push(pkGList->Item());
+        if (m_uiGlobalStates & (1 << i))
+        {
+            akGStack[i].Push(m_aspkGlobalState[i]);
+        }
     }
 
-    TList<LightPtr>* pkLList;
-    for (pkLList = m_pkLightList; pkLList; pkLList = pkLList->Next())
+    // the most recently attached light is pushed first
+    for (i = GetLightQuantity() - 1; i >= 0; i--)
     {
-        pkLStack->Push(pkLList->Item());
+        pkLStack->Push((*m_pkLightArray)[i]);
     }
 }
 //----------------------------------------------------------------------------
 void Spatial::PopState (TStack<GlobalState*>* akGStack,
     TStack<Light*>* pkLStack)
 {
-    TList<GlobalStatePtr>* pkGList;
-    for (pkGList = m_pkGlobalList; pkGList; pkGList = pkGList->Next())
+    int i;
+    for (i = 0; (m_uiGlobalStates >> i) != 0; i++)
     {
-        int eType = pkGList->Item()->GetGlobalStateType();
-        GlobalState* pkDummy;
-        akGStack[eType].Pop(pkDummy);
+        if (m_uiGlobalStates & (1 << i))
+        {
+            GlobalState* pkDummy;
+            akGStack[i].Pop(pkDummy);
+        }
     }
 
-    TList<LightPtr>* pkLList;
-    for (pkLList = m_pkLightList; pkLList; pkLList = pkLList->Next())
+    for (i = 0; i < GetLightQuantity(); i++)
     {
         Light* pkDummy;
         pkLStack->Pop(pkDummy);
@@ -353,6 +590,8 @@ void Spatial::PopState (TStack<GlobalState*>* akGStack,
 //----------------------------------------------------------------------------
 void Spatial::OnDraw (Renderer& rkRenderer, bool bNoCull)
 {
+    WG3D_PROFILE("Spatial::OnDraw");
+
     if (ForceCull)
     {
         return;
@@ -360,11 +599,18 @@ void Spatial::OnDraw (Renderer& rkRenderer, bool bNoCull)
 
     CameraPtr spkCamera = rkRenderer.GetCamera();
     unsigned int uiState = spkCamera->GetPlaneState();
+    WG3D_RENDER_STATS_DO(rkRenderer.GetStats().GetCurrent().NodesVisited++);
 
     if (bNoCull || !spkCamera->Culled(WorldBound))
     {
         Draw(rkRenderer,bNoCull);
     }
+#ifdef WG3D_RENDER_STATS
+    else
+    {
+        rkRenderer.GetStats().GetCurrent().NodesCulled++;
+    }
+#endif
 
     spkCamera->SetPlaneState(uiState);
 }
@@ -381,6 +627,59 @@ Spatial::PickRecord::~PickRecord ()
     // stub for derived classes
 }
 //----------------------------------------------------------------------------
+// A pick record is preceded by the arena that it was allocated in, null for
+// the heap.
+static void* SetPickArena (void* pvMemory, FrameArena* pkArena)
+{
+    *(FrameArena**)pvMemory = pkArena;
+    return (char*)pvMemory + FrameArena::ALIGNMENT;
+}
+//----------------------------------------------------------------------------
+static void* GetPickMemory (void* pvAddr, FrameArena*& rpkArena)
+{
+    void* pvMemory = (char*)pvAddr - FrameArena::ALIGNMENT;
+    rpkArena = *(FrameArena**)pvMemory;
+    return pvMemory;
+}
+//----------------------------------------------------------------------------
+void* Spatial::PickRecord::operator new (size_t uiSize)
+{
+    FrameArena* pkArena = FrameArena::GetFrame();
+    uiSize += FrameArena::ALIGNMENT;
+    return SetPickArena(pkArena ? pkArena->Allocate(uiSize) :
+        ::operator new(uiSize),pkArena);
+}
+//----------------------------------------------------------------------------
+void Spatial::PickRecord::operator delete (void* pvAddr)
+{
+    if (pvAddr)
+    {
+        FrameArena* pkArena;
+        void* pvMemory = GetPickMemory(pvAddr,pkArena);
+        if (!pkArena)
+        {
+            ::operator delete(pvMemory);
+        }
+    }
+}
+#ifdef WG_MEMORY_MANAGER
+//----------------------------------------------------------------------------
+void* Spatial::PickRecord::operator new (size_t uiSize, const char* acFile,
+    unsigned int uiLine)
+{
+    FrameArena* pkArena = FrameArena::GetFrame();
+    uiSize += FrameArena::ALIGNMENT;
+    return SetPickArena(pkArena ? pkArena->Allocate(uiSize) :
+        ::operator new(uiSize,acFile,uiLine),pkArena);
+}
+//----------------------------------------------------------------------------
+void Spatial::PickRecord::operator delete (void* pvAddr, const char*,
+    unsigned int)
+{
+    PickRecord::operator delete(pvAddr);
+}
+#endif
+//----------------------------------------------------------------------------
 void Spatial::DoPick (const Ray3x&, PickArray&)
 {
     // stub for derived classes
@@ -428,10 +727,10 @@ Object* Spatial::GetObjectByName (const String& rkName)
         }
     }
 
-    TList<GlobalStatePtr>* pkGList;
-    for (pkGList = m_pkGlobalList; pkGList; pkGList = pkGList->Next())
+    int i;
+    for (i = 0; i < GlobalState::MAX_STATE; i++)
     {
-        GlobalState* pkGState = pkGList->Item();
+        GlobalState* pkGState = m_aspkGlobalState[i];
         if (pkGState)
         {
             pkFound = pkGState->GetObjectByName(rkName);
@@ -442,17 +741,12 @@ Object* Spatial::GetObjectByName (const String& rkName)
         }
     }
 
-    TList<LightPtr>* pkLList;
-    for (pkLList = m_pkLightList; pkLList; pkLList = pkLList->Next())
+    for (i = GetLightQuantity() - 1; i >= 0; i--)
     {
-        Light* pkLight = pkLList->Item();
-        if (pkLight)
+        pkFound = (*m_pkLightArray)[i]->GetObjectByName(rkName);
+        if (pkFound)
         {
-            pkFound = pkLight->GetObjectByName(rkName);
-            if (pkFound)
-            {
-                return pkFound;
-            }
+            return pkFound;
         }
     }
 
@@ -480,24 +774,19 @@ void Spatial::GetAllObjectsByName (const String& rkName,
         WorldBound->GetAllObjectsByName(rkName,rkObjects);
     }
 
-    TList<GlobalStatePtr>* pkGList;
-    for (pkGList = m_pkGlobalList; pkGList; pkGList = pkGList->Next())
+    int i;
+    for (i = 0; i < GlobalState::MAX_STATE; i++)
     {
-        GlobalState* pkGState = pkGList->Item();
+        GlobalState* pkGState = m_aspkGlobalState[i];
         if (pkGState)
         {
             pkGState->GetAllObjectsByName(rkName,rkObjects);
         }
     }
 
-    TList<LightPtr>* pkLList;
-    for (pkLList = m_pkLightList; pkLList; pkLList = pkLList->Next())
+    for (i = GetLightQuantity() - 1; i >= 0; i--)
     {
-        Light* pkLight = pkLList->Item();
-        if (pkLight)
-        {
-            pkLight->GetAllObjectsByName(rkName,rkObjects);
-        }
+        (*m_pkLightArray)[i]->GetAllObjectsByName(rkName,rkObjects);
     }
 
     if (m_spkEffect)
@@ -526,10 +815,10 @@ Object* Spatial::GetObjectByID (unsigned int uiID)
         }
     }
 
-    TList<GlobalStatePtr>* pkGList;
-    for (pkGList = m_pkGlobalList; pkGList; pkGList = pkGList->Next())
+    int i;
+    for (i = 0; i < GlobalState::MAX_STATE; i++)
     {
-        GlobalState* pkGState = pkGList->Item();
+        GlobalState* pkGState = m_aspkGlobalState[i];
         if (pkGState)
         {
             pkFound = pkGState->GetObjectByID(uiID);
@@ -540,17 +829,12 @@ Object* Spatial::GetObjectByID (unsigned int uiID)
         }
     }
 
-    TList<LightPtr>* pkLList;
-    for (pkLList = m_pkLightList; pkLList; pkLList = pkLList->Next())
+    for (i = GetLightQuantity() - 1; i >= 0; i--)
     {
-        Light* pkLight = pkLList->Item();
-        if (pkLight)
+        pkFound = (*m_pkLightArray)[i]->GetObjectByID(uiID);
+        if (pkFound)
         {
-            pkFound = pkLight->GetObjectByID(uiID);
-            if (pkFound)
-            {
-                return pkFound;
-            }
+            return pkFound;
         }
     }
 
@@ -23,7 +23,10 @@
 namespace WGSoft3D
 {
 
+class LinearScene;
+class SpatialIndex;
 class Light;
+class TaskPool;
 
 class WG3D_FOUNDATION_ITEM Spatial : public Object
 {
@@ -60,6 +63,50 @@ public:
     void UpdateGS (double dAppTime = -Mathd::MAX_REAL, bool bInitiator = true);
     void UpdateBS ();
 
+    // Incremental update.  When enabled, UpdateGS only visits the subtrees
+    // that contain a change since the previous update and the chain of
+    // ancestors whose bounds must be regrown.  A subtree is visited when
+    //   (1) MarkDirty was called on an object in it,
+    //   (2) a child was attached or detached, a controller, global state or
+    //       light was attached, or UpdateMS was called on a Geometry in it,
+    //   (3) it contains an object with controllers (animated objects are
+    //       visited every update),
+    //   (4) the world transformation of its parent changed, or
+    //   (5) the version of its Local differs from the one World was last
+    //       computed from.
+    // The object that UpdateGS is called on is always visited, and (5) is
+    // checked for each child of a visited object.  So setting Local
+    // directly needs no MarkDirty when the parent is visited anyway, for
+    // example on the children of the object that UpdateGS is called on.
+    // Deeper in a subtree that is otherwise unchanged, call MarkDirty on
+    // the object, or call UpdateGS on it, as usual.  The same applies to
+    // controllers attached to a global state or light after it was
+    // attached to this object.  The default is a full update.
+    static void SetIncrementalUpdate (bool bIncremental);
+    static bool GetIncrementalUpdate ();
+    void MarkDirty ();
+
+    // The number of objects visited and skipped by the most recent UpdateGS
+    // call that was an initiator.
+    static int GetUpdateVisited ();
+    static int GetUpdateSkipped ();
+
+    // Parallel update.  When a task pool is set, UpdateGS splits a subtree
+    // that had more than iThreshold objects at the previous update.  The
+    // nodes near the top are updated on the calling thread, the subtrees
+    // below them run as tasks of at least iThreshold objects in the pool,
+    // and the bounds of the top nodes are then grown from their children
+    // in the order of the serial update, so the results are bit identical
+    // to it.  The controllers of different objects run concurrently, which
+    // is safe for controllers that only change their own object (such as
+    // KeyframeController).  Controllers that read or change other objects
+    // (skin or IK controllers) need the serial update.  Global states and
+    // lights may be shared, so their controllers run one at a time.  The
+    // default is no pool, the serial update.
+    static void SetUpdatePool (TaskPool* pkPool, int iThreshold = 512);
+    static TaskPool* GetUpdatePool ();
+    static int GetUpdateThreshold ();
+
     // global state
     void SetGlobalState (GlobalState* pkState);
     GlobalState* GetGlobalState (int eType) const;
@@ -77,7 +124,9 @@ public:
     virtual void SetEffect (Effect* pkEffect);
     Effect* GetEffect () const;
 
-    // update of render state
+    // Update of render state.  The initiator allocates the state stacks in
+    // the arena of the frame when one is set (FrameArena::SetFrame) and
+    // releases them at the end.
     virtual void UpdateRS (TStack<GlobalState*>* akGStack = 0,
         TStack<Light*>* pkLStack = 0);
 
@@ -105,6 +154,19 @@ public:
         // parameter is t >= 0.
         fixed T;
 
+        // The records are allocated in the arena of the frame when one is
+        // set (FrameArena::SetFrame), otherwise on the heap.  WG_DELETE
+        // destroys a record either way, but a record of the arena is valid
+        // only until the arena is reset.
+        static void* operator new (size_t uiSize);
+        static void operator delete (void* pvAddr);
+#ifdef WG_MEMORY_MANAGER
+        static void* operator new (size_t uiSize, const char* acFile,
+            unsigned int uiLine);
+        static void operator delete (void* pvAddr, const char* acFile,
+            unsigned int uiLine);
+#endif
+
     protected:
         PickRecord (Spatial* pkIObject, fixed fT);
     };
@@ -113,6 +175,7 @@ public:
 
     // The origin and direction of the ray must be in world coordinates.  The
     // application is responsible for deleting the pick records in the array.
+    // The array may be in the arena of the frame too, see TArray.
     virtual void DoPick (const Ray3x& rkRay, PickArray& rkResults);
 
     static PickRecord* GetClosest (PickArray& rkResults);
@@ -124,6 +187,51 @@ protected:
     virtual void UpdateWorldData (double dAppTime);
     virtual void UpdateWorldBound () = 0;
     void PropagateBoundToRoot ();
+    void PropagateDirty ();
+    virtual void OnControllerChange ();
+
+    // Parallel update support.  SplitWorldData updates the world data of
+    // the object and sorts the subtree into objects whose bounds are grown
+    // after the tasks (rkJoin, parents before children) and subtrees that
+    // are updated by tasks (rkTask).  JoinWorldData gathers the update
+    // statistics of the children.  A class that overrides UpdateWorldData
+    // must override these consistently or leave the subtree to one task.
+    virtual void SplitWorldData (double dAppTime, TArray<Spatial*>& rkJoin,
+        TArray<Spatial*>& rkTask);
+    virtual void JoinWorldData ();
+    void UpdateParallel (double dAppTime);
+    void UpdateParallel (double dAppTime, FrameArena* pkArena);
+    static bool UpdateSharedControllers (Object* pkObject, double dAppTime);
+
+    // incremental update state
+    enum
+    {
+        DIRTY_SELF  = 1,  // recompute World even if the versions match
+        DIRTY_CHILD = 2   // something in the subtree must be visited
+    };
+    unsigned int m_uiDirty;
+    unsigned int m_uiLocalVersion, m_uiParentVersion, m_uiWorldVersion;
+    bool m_bAnimated;         // the subtree contains controllers
+    int m_iSubtreeQuantity;   // objects in the subtree at the last visit
+    int m_iVisitedQuantity;   // objects of those visited at the last visit
+
+    static bool ms_bIncrementalUpdate;
+    static int ms_iUpdateVisited;
+    static int ms_iUpdateSkipped;
+    static TaskPool* ms_pkUpdatePool;
+    static int ms_iUpdateThreshold;
+
+    // the compiled scene that contains this object, if any, and the index
+    // of this object in its arrays
+    friend class LinearScene;
+    LinearScene* m_pkLinearScene;
+    int m_iLinearHandle;
+
+    // the spatial index that contains this object, if any, and the index
+    // of this object in its entries
+    friend class SpatialIndex;
+    SpatialIndex* m_pkSpatialIndex;
+    int m_iIndexHandle;
 
     // render state updates
     void PropagateStateFromRoot (TStack<GlobalState*>* akGStack,
@@ -136,11 +244,16 @@ protected:
     // support for hierarchical scene graph
     Spatial* m_pkParent;
 
-    // global render state
-    TList<GlobalStatePtr>* m_pkGlobalList;
+    // Global render state, one slot per type.  Bit i of m_uiGlobalStates
+    // is set when slot i holds a state, so the traversals skip the objects
+    // without states.
+    GlobalStatePtr m_aspkGlobalState[GlobalState::MAX_STATE];
+    unsigned int m_uiGlobalStates;
 
-    // light state (Pointer used directly to avoid circular headers)
-    TList<Pointer<Light> >* m_pkLightList;
+    // Light state, in the order of attachment, so GetLight(0) is the last
+    // element.  The array is allocated with the first light.  Pointer is
+    // used directly to avoid circular headers.
+    TSmallArray<Pointer<Light>,2>* m_pkLightArray;
 
     // Effect state.  If the effect is attached to a Geometry object, it
     // applies to that object alone.  If the effect is attached to a Node
@@ -155,6 +268,24 @@ public:
     // parent access (Node calls this during attach/detach of children)
     void SetParent (Spatial* pkParent);
 
+    // linear scene access
+    LinearScene* GetLinearScene () const;
+    int GetLinearHandle () const;
+
+    // spatial index access
+    SpatialIndex* GetSpatialIndex () const;
+    int GetIndexHandle () const;
+
+    // incremental update support (Node calls these for its children)
+    bool IsUpdateNeeded () const;
+    bool IsAnimated () const;
+    int GetSubtreeQuantity () const;
+    int GetVisitedQuantity () const;
+
+    // parallel update support (Node calls this for its children)
+    void SplitUpdateGS (double dAppTime, TArray<Spatial*>& rkJoin,
+        TArray<Spatial*>& rkTask);
+
     // renderer needs access to these
     void OnDraw (Renderer& rkRenderer, bool bNoCull = false);
     virtual void Draw (Renderer& rkRenderer, bool bNoCull = false) = 0;
@@ -9,11 +9,6 @@
 //                                                       //
 ///////////////////////////////////////////////////////////
 
-//----------------------------------------------------------------------------
-inline void Spatial::SetParent (Spatial* pkParent)
-{
-    m_pkParent = pkParent;
-}
 //----------------------------------------------------------------------------
 inline Spatial* Spatial::GetParent ()
 {
@@ -30,4 +25,75 @@ inline Effect* Spatial::GetEffect () const
     return m_spkEffect;
 }
 //----------------------------------------------------------------------------
-
+inline void Spatial::SetIncrementalUpdate (bool bIncremental)
+{
+    ms_bIncrementalUpdate = bIncremental;
+}
+//----------------------------------------------------------------------------
+inline bool Spatial::GetIncrementalUpdate ()
+{
+    return ms_bIncrementalUpdate;
+}
+//----------------------------------------------------------------------------
+inline int Spatial::GetUpdateVisited ()
+{
+    return ms_iUpdateVisited;
+}
+//----------------------------------------------------------------------------
+inline int Spatial::GetUpdateSkipped ()
+{
+    return ms_iUpdateSkipped;
+}
+//----------------------------------------------------------------------------
+inline TaskPool* Spatial::GetUpdatePool ()
+{
+    return ms_pkUpdatePool;
+}
+//----------------------------------------------------------------------------
+inline int Spatial::GetUpdateThreshold ()
+{
+    return ms_iUpdateThreshold;
+}
+//----------------------------------------------------------------------------
+inline bool Spatial::IsUpdateNeeded () const
+{
+    return m_uiDirty != 0 || m_bAnimated
+        || Local.GetVersion() != m_uiLocalVersion || (m_pkParent
+        && m_pkParent->World.GetVersion() != m_uiParentVersion);
+}
+//----------------------------------------------------------------------------
+inline bool Spatial::IsAnimated () const
+{
+    return m_bAnimated;
+}
+//----------------------------------------------------------------------------
+inline int Spatial::GetSubtreeQuantity () const
+{
+    return m_iSubtreeQuantity;
+}
+//----------------------------------------------------------------------------
+inline int Spatial::GetVisitedQuantity () const
+{
+    return m_iVisitedQuantity;
+}
+//----------------------------------------------------------------------------
+inline LinearScene* Spatial::GetLinearScene () const
+{
+    return m_pkLinearScene;
+}
+//----------------------------------------------------------------------------
+inline int Spatial::GetLinearHandle () const
+{
+    return m_iLinearHandle;
+}
+//----------------------------------------------------------------------------
+inline SpatialIndex* Spatial::GetSpatialIndex () const
+{
+    return m_pkSpatialIndex;
+}
+//----------------------------------------------------------------------------
+inline int Spatial::GetIndexHandle () const
+{
+    return m_iIndexHandle;
+}
+//----------------------------------------------------------------------------
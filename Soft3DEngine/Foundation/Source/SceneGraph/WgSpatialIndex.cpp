@@ -0,0 +1,808 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSpatialIndex.cpp                 //
+//                                                       //
+//  - Implementation for Spatial Index class             //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgSpatialIndex.h"
+#include "WgCamera.h"
+#include "WgProfiler.h"
+#include "WgRenderer.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+SpatialIndex::SpatialIndex (Spatial* pkRoot)
+    :
+    m_spkRoot(pkRoot),
+    m_kEntry(256,256),
+    m_kNode(256,256),
+    m_kStack(64,64),
+    m_kMask(64,64),
+    m_kLeaf(256,256),
+    m_kLeafMask(256,256)
+{
+    assert(pkRoot);
+    m_iRemoved = 0;
+    m_iTreeRoot = -1;
+    m_iFreeNode = -1;
+    m_iLeafQuantity = 0;
+    m_iInsertions = 0;
+    OnAttach(pkRoot,-1);
+}
+//----------------------------------------------------------------------------
+SpatialIndex::~SpatialIndex ()
+{
+    for (int i = 0; i < m_kEntry.GetQuantity(); i++)
+    {
+        Spatial* pkObject = m_kEntry[i].Object;
+        if (pkObject && pkObject->m_pkSpatialIndex == this)
+        {
+            pkObject->m_pkSpatialIndex = 0;
+            pkObject->m_iIndexHandle = -1;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::Update ()
+{
+    WG3D_PROFILE("SpatialIndex::Update");
+
+    if (2*m_iRemoved > m_kEntry.GetQuantity())
+    {
+        Compact();
+    }
+
+    // One forward sweep.  The parents precede their children, so the flags
+    // of the parent are current when the child is visited.
+    m_iInsertions = 0;
+    for (int i = 0; i < m_kEntry.GetQuantity(); i++)
+    {
+        Entry& rkEntry = m_kEntry[i];
+        Spatial* pkObject = rkEntry.Object;
+        if (!pkObject)
+        {
+            continue;
+        }
+
+        unsigned int uiParentFlags =
+            (rkEntry.Parent >= 0 ? m_kEntry[rkEntry.Parent].Flags : 0);
+        unsigned int uiFlags = (rkEntry.Flags & F_NODE);
+        if (uiParentFlags & (F_UNIT | F_INSIDE))
+        {
+            uiFlags |= F_INSIDE;
+        }
+        else if (!(uiFlags & F_NODE) || pkObject->GetEffect())
+        {
+            uiFlags |= F_UNIT;
+        }
+        if (pkObject->ForceCull || (uiParentFlags & F_HIDDEN))
+        {
+            uiFlags |= F_HIDDEN;
+        }
+        if (rkEntry.Leaf >= 0 && ((uiFlags ^ rkEntry.Flags) & F_HIDDEN))
+        {
+            m_kNode[rkEntry.Leaf].Hidden = ((uiFlags & F_HIDDEN) != 0);
+        }
+        rkEntry.Flags = uiFlags;
+
+        if (!(uiFlags & F_UNIT))
+        {
+            if (rkEntry.Leaf >= 0)
+            {
+                RemoveLeaf(i);
+            }
+            continue;
+        }
+
+        Sphere3x kBound(pkObject->WorldBound->GetCenter(),
+            pkObject->WorldBound->GetRadius());
+        if (rkEntry.Leaf < 0)
+        {
+            rkEntry.Bound = kBound;
+            InsertLeaf(i,Vector3x::ZERO);
+        }
+        else if (kBound.Center != rkEntry.Bound.Center
+            ||   kBound.Radius != rkEntry.Bound.Radius)
+        {
+            // the object moves to another leaf only when it left its box
+            Vector3x kMotion = kBound.Center - rkEntry.Bound.Center;
+            rkEntry.Bound = kBound;
+            Box kBox;
+            GetBox(kBound,fixed(FIXED_ZERO),kBox);
+            if (!m_kNode[rkEntry.Leaf].Bound.Contains(kBox))
+            {
+                RemoveLeaf(i);
+                InsertLeaf(i,kMotion);
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::Draw (Renderer& rkRenderer)
+{
+    WG3D_PROFILE("SpatialIndex::Draw");
+
+    CameraPtr spkCamera = rkRenderer.GetCamera();
+    unsigned int uiState = spkCamera->GetPlaneState();
+#ifdef WG3D_RENDER_STATS
+    double dStart = System::GetPreciseTime();
+#endif
+    CullLeaves(spkCamera->GetPlanes(),spkCamera->GetPlaneQuantity(),
+        uiState);
+    WG3D_RENDER_STATS_DO(rkRenderer.GetStats().GetCurrent().CullTime +=
+        System::GetPreciseTime() - dStart);
+
+    // OnDraw tests the bound of the object against the planes that still
+    // intersect its box.  An object with its box inside all the planes is
+    // drawn directly, OnDraw would not test it.
+    for (int i = 0; i < m_kLeaf.GetQuantity(); i++)
+    {
+        unsigned int uiMask = m_kLeafMask[i];
+        spkCamera->SetPlaneState(uiMask);
+        if (uiMask)
+        {
+            m_kLeaf[i]->OnDraw(rkRenderer);
+        }
+        else
+        {
+            WG3D_RENDER_STATS_DO(
+                rkRenderer.GetStats().GetCurrent().NodesVisited++);
+            m_kLeaf[i]->Draw(rkRenderer);
+        }
+    }
+
+    spkCamera->SetPlaneState(uiState);
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::FindVisible (Camera* pkCamera,
+    TArray<Spatial*>& rkObjects)
+{
+    const Plane3x* akPlane = pkCamera->GetPlanes();
+    int iPlaneQuantity = pkCamera->GetPlaneQuantity();
+    unsigned int uiState = (iPlaneQuantity < 32 ?
+        (1u << iPlaneQuantity) - 1 : ~0u);
+    CullLeaves(akPlane,iPlaneQuantity,uiState);
+
+    for (int i = 0; i < m_kLeaf.GetQuantity(); i++)
+    {
+        // the test of Camera::Culled, without changing the camera
+        const BoundingVolume* pkBound = m_kLeaf[i]->WorldBound;
+        unsigned int uiMask = m_kLeafMask[i];
+        bool bCulled = false;
+        for (int j = 0; j < iPlaneQuantity && !bCulled; j++)
+        {
+            if ((uiMask & (1u << j)) && pkBound->WhichSide(akPlane[j]) < 0)
+            {
+                bCulled = true;
+            }
+        }
+        if (!bCulled)
+        {
+            rkObjects.Append(m_kLeaf[i]);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::FindInSphere (const Sphere3x& rkSphere,
+    TArray<Spatial*>& rkObjects)
+{
+    Box kQuery;
+    GetBox(rkSphere,fixed(FIXED_ZERO),kQuery);
+
+    int iTop = 0;
+    if (m_iTreeRoot >= 0)
+    {
+        m_kStack.SetElement(iTop++,m_iTreeRoot);
+    }
+    while (iTop > 0)
+    {
+        const TreeNode& rkNode = m_kNode[m_kStack[--iTop]];
+        if (!rkNode.Bound.Intersects(kQuery))
+        {
+            continue;
+        }
+
+        if (rkNode.IsLeaf())
+        {
+            const Entry& rkEntry = m_kEntry[rkNode.Entry];
+            if (SphereIntersectsSphere(rkEntry.Bound,rkSphere))
+            {
+                rkObjects.Append(rkEntry.Object);
+            }
+        }
+        else
+        {
+            m_kStack.SetElement(iTop++,rkNode.Child[1]);
+            m_kStack.SetElement(iTop++,rkNode.Child[0]);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::FindInBox (const Vector3x& rkMin, const Vector3x& rkMax,
+    TArray<Spatial*>& rkObjects)
+{
+    Box kQuery;
+    kQuery.Min = rkMin;
+    kQuery.Max = rkMax;
+
+    int iTop = 0;
+    if (m_iTreeRoot >= 0)
+    {
+        m_kStack.SetElement(iTop++,m_iTreeRoot);
+    }
+    while (iTop > 0)
+    {
+        const TreeNode& rkNode = m_kNode[m_kStack[--iTop]];
+        if (!rkNode.Bound.Intersects(kQuery))
+        {
+            continue;
+        }
+
+        if (rkNode.IsLeaf())
+        {
+            const Entry& rkEntry = m_kEntry[rkNode.Entry];
+            if (SphereIntersectsBox(rkEntry.Bound,kQuery))
+            {
+                rkObjects.Append(rkEntry.Object);
+            }
+        }
+        else
+        {
+            m_kStack.SetElement(iTop++,rkNode.Child[1]);
+            m_kStack.SetElement(iTop++,rkNode.Child[0]);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::CullLeaves (const Plane3x* akPlane, int iPlaneQuantity,
+    unsigned int uiState)
+{
+    m_kLeaf.RemoveAll();
+    m_kLeafMask.RemoveAll();
+
+    int iTop = 0;
+    if (m_iTreeRoot >= 0)
+    {
+        m_kStack.SetElement(iTop,m_iTreeRoot);
+        m_kMask.SetElement(iTop,uiState);
+        iTop++;
+    }
+    while (iTop > 0)
+    {
+        iTop--;
+        const TreeNode& rkNode = m_kNode[m_kStack[iTop]];
+        unsigned int uiMask = m_kMask[iTop];
+        if (rkNode.IsLeaf())
+        {
+            // the bound of the object gets the exact test, the test of
+            // its box would only repeat it
+            if (!rkNode.Hidden)
+            {
+                m_kLeaf.Append(rkNode.Object);
+                m_kLeafMask.Append(uiMask);
+            }
+            continue;
+        }
+
+        if (uiMask && Culled(rkNode.Bound,akPlane,iPlaneQuantity,uiMask))
+        {
+            continue;
+        }
+
+        m_kStack.SetElement(iTop,rkNode.Child[1]);
+        m_kMask.SetElement(iTop,uiMask);
+        iTop++;
+        m_kStack.SetElement(iTop,rkNode.Child[0]);
+        m_kMask.SetElement(iTop,uiMask);
+        iTop++;
+    }
+}
+//----------------------------------------------------------------------------
+bool SpatialIndex::Culled (const Box& rkBox, const Plane3x* akPlane,
+    int iPlaneQuantity, unsigned int& ruiMask)
+{
+    for (int i = 0; i < iPlaneQuantity; i++)
+    {
+        unsigned int uiBit = 1u << i;
+        if (!(ruiMask & uiBit))
+        {
+            continue;
+        }
+
+        // the corners of the box farthest along and against the normal
+        const Plane3x& rkPlane = akPlane[i];
+        Vector3x kFar, kNear;
+        for (int j = 0; j < 3; j++)
+        {
+            if (rkPlane.Normal[j] >= FIXED_ZERO)
+            {
+                kFar[j] = rkBox.Max[j];
+                kNear[j] = rkBox.Min[j];
+            }
+            else
+            {
+                kFar[j] = rkBox.Min[j];
+                kNear[j] = rkBox.Max[j];
+            }
+        }
+
+        if (rkPlane.DistanceTo(kFar) <= FIXED_ZERO)
+        {
+            // the box, and the bounds in it, are on the negative side
+            return true;
+        }
+        if (rkPlane.DistanceTo(kNear) >= FIXED_ZERO)
+        {
+            // the box is on the positive side, the plane is inactive below
+            ruiMask &= ~uiBit;
+        }
+    }
+    return false;
+}
+//----------------------------------------------------------------------------
+static bool WithinRadius (const Vector3x& rkDiff, fixed fRadius)
+{
+    // Test |D| <= R as |D/R| <= 1, since the squared distance overflows the
+    // fixed-point range at moderate distances.
+    int i;
+    for (i = 0; i < 3; i++)
+    {
+        if (Mathx::FAbs(rkDiff[i]) > fRadius)
+        {
+            return false;
+        }
+    }
+    if (fRadius == FIXED_ZERO)
+    {
+        return true;
+    }
+    return (rkDiff/fRadius).SquaredLength() <= fixed(FIXED_ONE);
+}
+//----------------------------------------------------------------------------
+bool SpatialIndex::SphereIntersectsSphere (const Sphere3x& rkA,
+    const Sphere3x& rkB)
+{
+    return WithinRadius(rkB.Center - rkA.Center,rkA.Radius + rkB.Radius);
+}
+//----------------------------------------------------------------------------
+bool SpatialIndex::SphereIntersectsBox (const Sphere3x& rkSphere,
+    const Box& rkBox)
+{
+    // the difference to the closest point of the box
+    Vector3x kDiff;
+    for (int i = 0; i < 3; i++)
+    {
+        fixed fC = rkSphere.Center[i];
+        if (fC < rkBox.Min[i])
+        {
+            kDiff[i] = rkBox.Min[i] - fC;
+        }
+        else if (fC > rkBox.Max[i])
+        {
+            kDiff[i] = fC - rkBox.Max[i];
+        }
+        else
+        {
+            kDiff[i] = fixed(FIXED_ZERO);
+        }
+    }
+    return WithinRadius(kDiff,rkSphere.Radius);
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::Box::Merge (const Box& rkA, const Box& rkB)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        Min[i] = (rkA.Min[i] < rkB.Min[i] ? rkA.Min[i] : rkB.Min[i]);
+        Max[i] = (rkA.Max[i] > rkB.Max[i] ? rkA.Max[i] : rkB.Max[i]);
+    }
+}
+//----------------------------------------------------------------------------
+bool SpatialIndex::Box::Contains (const Box& rkBox) const
+{
+    for (int i = 0; i < 3; i++)
+    {
+        if (rkBox.Min[i] < Min[i] || rkBox.Max[i] > Max[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+bool SpatialIndex::Box::Intersects (const Box& rkBox) const
+{
+    for (int i = 0; i < 3; i++)
+    {
+        if (rkBox.Max[i] < Min[i] || rkBox.Min[i] > Max[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+fixed SpatialIndex::Box::GetCost () const
+{
+    // Half the perimeter of the box.  It orders the boxes like the surface
+    // area does, without products that overflow the fixed-point range.
+    return (Max[0] - Min[0]) + (Max[1] - Min[1]) + (Max[2] - Min[2]);
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::GetBox (const Sphere3x& rkBound, fixed fMargin,
+    Box& rkBox)
+{
+    fixed fRadius = rkBound.Radius + fMargin;
+    Vector3x kExtent(fRadius,fRadius,fRadius);
+    rkBox.Min = rkBound.Center - kExtent;
+    rkBox.Max = rkBound.Center + kExtent;
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::Append (Spatial* pkObject, int iParent)
+{
+    if (pkObject->m_pkSpatialIndex)
+    {
+        // the object moved here from another index
+        pkObject->m_pkSpatialIndex->OnDestroy(pkObject->m_iIndexHandle);
+    }
+
+    Entry kEntry;
+    kEntry.Object = pkObject;
+    kEntry.Parent = iParent;
+    kEntry.Leaf = -1;
+    kEntry.Flags = (pkObject->IsDerived(Node::TYPE) ? F_NODE : 0);
+    pkObject->m_pkSpatialIndex = this;
+    pkObject->m_iIndexHandle = m_kEntry.GetQuantity();
+    m_kEntry.Append(kEntry);
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::Compact ()
+{
+    // Move the entries down over the removed ones.  The order is kept, so
+    // the parents still precede their children.
+    int iQuantity = m_kEntry.GetQuantity();
+    int* aiMap = WG_NEW int[iQuantity];
+    TArray<Entry> kEntry(iQuantity-m_iRemoved+256,256);
+    for (int i = 0; i < iQuantity; i++)
+    {
+        Entry kMoved = m_kEntry[i];
+        if (!kMoved.Object)
+        {
+            aiMap[i] = -1;
+            continue;
+        }
+
+        aiMap[i] = kEntry.GetQuantity();
+        if (kMoved.Parent >= 0)
+        {
+            kMoved.Parent = aiMap[kMoved.Parent];
+        }
+        if (kMoved.Leaf >= 0)
+        {
+            m_kNode[kMoved.Leaf].Entry = aiMap[i];
+        }
+        kMoved.Object->m_iIndexHandle = aiMap[i];
+        kEntry.Append(kMoved);
+    }
+    WG_DELETE[] aiMap;
+
+    m_kEntry = kEntry;
+    m_iRemoved = 0;
+}
+//----------------------------------------------------------------------------
+int SpatialIndex::AllocateNode ()
+{
+    int iNode;
+    if (m_iFreeNode >= 0)
+    {
+        iNode = m_iFreeNode;
+        m_iFreeNode = m_kNode[iNode].Parent;
+    }
+    else
+    {
+        iNode = m_kNode.GetQuantity();
+        m_kNode.Append(TreeNode());
+    }
+
+    TreeNode& rkNode = m_kNode[iNode];
+    rkNode.Parent = -1;
+    rkNode.Child[0] = -1;
+    rkNode.Child[1] = -1;
+    rkNode.Height = 0;
+    rkNode.Entry = -1;
+    rkNode.Object = 0;
+    rkNode.Hidden = false;
+    return iNode;
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::FreeNode (int iNode)
+{
+    m_kNode[iNode].Parent = m_iFreeNode;
+    m_kNode[iNode].Height = -1;
+    m_iFreeNode = iNode;
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::InsertLeaf (int iEntry, const Vector3x& rkMotion)
+{
+    int iLeaf = AllocateNode();
+    TreeNode& rkLeaf = m_kNode[iLeaf];
+    Entry& rkEntry = m_kEntry[iEntry];
+    const fixed fMarginFraction = fixed(FIXED_CONST(0.125));
+    GetBox(rkEntry.Bound,rkEntry.Bound.Radius*fMarginFraction,
+        rkLeaf.Bound);
+
+    // the box also covers the next four moves like the last one
+    for (int i = 0; i < 3; i++)
+    {
+        fixed fReach = fixed::FromInt(4)*rkMotion[i];
+        if (fReach > FIXED_ZERO)
+        {
+            rkLeaf.Bound.Max[i] += fReach;
+        }
+        else
+        {
+            rkLeaf.Bound.Min[i] += fReach;
+        }
+    }
+    rkLeaf.Entry = iEntry;
+    rkLeaf.Object = rkEntry.Object;
+    rkLeaf.Hidden = ((rkEntry.Flags & F_HIDDEN) != 0);
+    rkEntry.Leaf = iLeaf;
+
+    InsertTreeLeaf(iLeaf);
+    m_iLeafQuantity++;
+    m_iInsertions++;
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::RemoveLeaf (int iEntry)
+{
+    Entry& rkEntry = m_kEntry[iEntry];
+    RemoveTreeLeaf(rkEntry.Leaf);
+    FreeNode(rkEntry.Leaf);
+    rkEntry.Leaf = -1;
+    m_iLeafQuantity--;
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::InsertTreeLeaf (int iLeaf)
+{
+    if (m_iTreeRoot < 0)
+    {
+        m_iTreeRoot = iLeaf;
+        m_kNode[iLeaf].Parent = -1;
+        return;
+    }
+
+    // Descend to the sibling for which the leaf adds the least cost.  At
+    // each node the choice is between a new parent of the node and the
+    // leaf, and the cheaper child, which also pays for the growth of this
+    // node.
+    Box kLeafBox = m_kNode[iLeaf].Bound;
+    int iSibling = m_iTreeRoot;
+    while (!m_kNode[iSibling].IsLeaf())
+    {
+        const TreeNode& rkNode = m_kNode[iSibling];
+        Box kMerged;
+        kMerged.Merge(rkNode.Bound,kLeafBox);
+        fixed fMergedCost = kMerged.GetCost();
+        fixed fNewParentCost = fMergedCost + fMergedCost;
+        fixed fGrowth = fNewParentCost - rkNode.Bound.GetCost() -
+            rkNode.Bound.GetCost();
+
+        fixed afChildCost[2];
+        for (int i = 0; i < 2; i++)
+        {
+            const TreeNode& rkChild = m_kNode[rkNode.Child[i]];
+            kMerged.Merge(rkChild.Bound,kLeafBox);
+            afChildCost[i] = kMerged.GetCost() + fGrowth;
+            if (!rkChild.IsLeaf())
+            {
+                afChildCost[i] -= rkChild.Bound.GetCost();
+            }
+        }
+
+        if (fNewParentCost < afChildCost[0]
+        &&  fNewParentCost < afChildCost[1])
+        {
+            break;
+        }
+        iSibling = rkNode.Child[afChildCost[0] < afChildCost[1] ? 0 : 1];
+    }
+
+    // the new parent of the sibling and the leaf
+    int iOldParent = m_kNode[iSibling].Parent;
+    int iNewParent = AllocateNode();
+    TreeNode& rkNewParent = m_kNode[iNewParent];
+    rkNewParent.Parent = iOldParent;
+    rkNewParent.Bound.Merge(m_kNode[iSibling].Bound,kLeafBox);
+    rkNewParent.Height = m_kNode[iSibling].Height + 1;
+    rkNewParent.Child[0] = iSibling;
+    rkNewParent.Child[1] = iLeaf;
+    m_kNode[iSibling].Parent = iNewParent;
+    m_kNode[iLeaf].Parent = iNewParent;
+
+    if (iOldParent >= 0)
+    {
+        TreeNode& rkOldParent = m_kNode[iOldParent];
+        rkOldParent.Child[rkOldParent.Child[0] == iSibling ? 0 : 1] =
+            iNewParent;
+        Refit(iOldParent);
+    }
+    else
+    {
+        m_iTreeRoot = iNewParent;
+    }
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::RemoveTreeLeaf (int iLeaf)
+{
+    if (iLeaf == m_iTreeRoot)
+    {
+        m_iTreeRoot = -1;
+        return;
+    }
+
+    // the sibling of the leaf replaces their parent
+    int iParent = m_kNode[iLeaf].Parent;
+    const TreeNode& rkParent = m_kNode[iParent];
+    int iGrandParent = rkParent.Parent;
+    int iSibling = rkParent.Child[rkParent.Child[0] == iLeaf ? 1 : 0];
+    m_kNode[iSibling].Parent = iGrandParent;
+    FreeNode(iParent);
+
+    if (iGrandParent >= 0)
+    {
+        TreeNode& rkGrandParent = m_kNode[iGrandParent];
+        rkGrandParent.Child[rkGrandParent.Child[0] == iParent ? 0 : 1] =
+            iSibling;
+        Refit(iGrandParent);
+    }
+    else
+    {
+        m_iTreeRoot = iSibling;
+    }
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::Refit (int iNode)
+{
+    // rebalance and regrow the boxes up to the root
+    while (iNode >= 0)
+    {
+        iNode = Balance(iNode);
+
+        TreeNode& rkNode = m_kNode[iNode];
+        const TreeNode& rkChild0 = m_kNode[rkNode.Child[0]];
+        const TreeNode& rkChild1 = m_kNode[rkNode.Child[1]];
+        rkNode.Height = 1 + (rkChild0.Height > rkChild1.Height ?
+            rkChild0.Height : rkChild1.Height);
+        rkNode.Bound.Merge(rkChild0.Bound,rkChild1.Bound);
+        iNode = rkNode.Parent;
+    }
+}
+//----------------------------------------------------------------------------
+int SpatialIndex::Balance (int iA)
+{
+    // An AVL rotation.  When the heights of the children of A differ by
+    // more than one, the taller child C takes the place of A, A takes the
+    // place of the taller child of C, and the shorter child of C becomes a
+    // child of A.  The function returns the node now in the place of A.
+    TreeNode* akNode = m_kNode.GetArray();
+    TreeNode& rkA = akNode[iA];
+    if (rkA.IsLeaf() || rkA.Height < 2)
+    {
+        return iA;
+    }
+
+    int iDiff = akNode[rkA.Child[1]].Height - akNode[rkA.Child[0]].Height;
+    if (-1 <= iDiff && iDiff <= 1)
+    {
+        return iA;
+    }
+
+    // the taller child of A and its children
+    int iTall = (iDiff > 0 ? 1 : 0);
+    int iC = rkA.Child[iTall];
+    int iB = rkA.Child[1-iTall];
+    TreeNode& rkC = akNode[iC];
+    int iF = rkC.Child[0];
+    int iG = rkC.Child[1];
+    if (akNode[iF].Height < akNode[iG].Height)
+    {
+        int iSave = iF;
+        iF = iG;
+        iG = iSave;
+    }
+
+    // C takes the place of A
+    rkC.Parent = rkA.Parent;
+    rkA.Parent = iC;
+    if (rkC.Parent >= 0)
+    {
+        TreeNode& rkParent = akNode[rkC.Parent];
+        rkParent.Child[rkParent.Child[0] == iA ? 0 : 1] = iC;
+    }
+    else
+    {
+        m_iTreeRoot = iC;
+    }
+
+    // A keeps B and takes the shorter child G of C, C keeps F
+    rkA.Child[iTall] = iG;
+    akNode[iG].Parent = iA;
+    rkC.Child[0] = iA;
+    rkC.Child[1] = iF;
+
+    rkA.Bound.Merge(akNode[iB].Bound,akNode[iG].Bound);
+    rkA.Height = 1 + (akNode[iB].Height > akNode[iG].Height ?
+        akNode[iB].Height : akNode[iG].Height);
+    rkC.Bound.Merge(rkA.Bound,akNode[iF].Bound);
+    rkC.Height = 1 + (rkA.Height > akNode[iF].Height ?
+        rkA.Height : akNode[iF].Height);
+    return iC;
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::OnAttach (Spatial* pkChild, int iParent)
+{
+    // Breadth-first traversal of the subtree.  The entries are appended,
+    // so the parents precede their children.
+    int i = m_kEntry.GetQuantity();
+    Append(pkChild,iParent);
+    for (/**/; i < m_kEntry.GetQuantity(); i++)
+    {
+        if (m_kEntry[i].Flags & F_NODE)
+        {
+            Node* pkNode = StaticCast<Node>(m_kEntry[i].Object);
+            for (int j = 0; j < pkNode->GetQuantity(); j++)
+            {
+                Spatial* pkGrandChild = pkNode->GetChild(j);
+                if (pkGrandChild)
+                {
+                    Append(pkGrandChild,i);
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::OnDetach (int iHandle)
+{
+    assert(0 <= iHandle && iHandle < m_kEntry.GetQuantity());
+
+    int iTop = 0;
+    m_kStack.SetElement(iTop++,iHandle);
+    while (iTop > 0)
+    {
+        int i = m_kStack[--iTop];
+        if (m_kEntry[i].Flags & F_NODE)
+        {
+            Node* pkNode = StaticCast<Node>(m_kEntry[i].Object);
+            for (int j = 0; j < pkNode->GetQuantity(); j++)
+            {
+                Spatial* pkChild = pkNode->GetChild(j);
+                if (pkChild && pkChild->m_pkSpatialIndex == this)
+                {
+                    m_kStack.SetElement(iTop++,pkChild->m_iIndexHandle);
+                }
+            }
+        }
+        OnDestroy(i);
+    }
+}
+//----------------------------------------------------------------------------
+void SpatialIndex::OnDestroy (int iHandle)
+{
+    assert(0 <= iHandle && iHandle < m_kEntry.GetQuantity());
+    Entry& rkEntry = m_kEntry[iHandle];
+    if (rkEntry.Leaf >= 0)
+    {
+        RemoveLeaf(iHandle);
+    }
+    rkEntry.Object->m_pkSpatialIndex = 0;
+    rkEntry.Object->m_iIndexHandle = -1;
+    rkEntry.Object = 0;
+    rkEntry.Flags = 0;
+    m_iRemoved++;
+}
+//----------------------------------------------------------------------------
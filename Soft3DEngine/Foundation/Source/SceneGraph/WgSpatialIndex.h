@@ -0,0 +1,201 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSpatialIndex.h                   //
+//                                                       //
+//  - Interface for Spatial Index class                  //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_SPATIALINDEX_H__
+#define __WG_SPATIALINDEX_H__
+
+#include "WgFoundationLIB.h"
+#include "WgNode.h"
+#include "WgSphere3.h"
+
+namespace WGSoft3D
+{
+
+class Camera;
+
+// A bounding volume hierarchy over the objects of a subtree, for culling and
+// region queries that do not depend on the shape of the authoring tree.  The
+// hierarchy is a dynamic tree of axis-aligned boxes.  Each leaf holds an
+// object that is drawn as a unit:  a Geometry (or any leaf other than a
+// Node), or a Node with a global effect, whose subtree the effect draws.  A
+// leaf box contains the world bound of its object and is enlarged by an
+// eighth of the bound radius, and by four times the last move of the object
+// in the direction of the move, so an object that moves smoothly stays in
+// its leaf for a few updates.  Leaves are inserted where they enlarge the
+// hierarchy least, and the interior nodes are rebalanced by rotations.
+//
+// Each object of the subtree knows its index and its handle.  Attaching a
+// child to an indexed node inserts the child's subtree, and detaching or
+// destroying it removes the subtree, so handles are stable until the next
+// Update.  Update reads the world bounds, whichever way they were computed
+// (UpdateGS, LinearScene or set directly), and reinserts the leaves whose
+// bound left their box.  It also notices effects that were attached or
+// removed and the ForceCull flags.  Call it after the geometric update of
+// the frame and before drawing or querying.
+//
+// Renderer::DrawScene(SpatialIndex*) draws the visible leaves.  A subtree
+// of boxes inside a frustum plane skips that plane, and each visible leaf
+// is drawn by Spatial::OnDraw with the remaining planes, so every object
+// gets the same bound test as in the hierarchical traversal.  Because the
+// bound of a node contains the bounds of its children, the same objects
+// are drawn, up to the rounding of the merged bounds, but in the order of
+// the hierarchy rather than the depth-first order of the scene.  An object
+// with ForceCull set, or below a node with ForceCull set, is not drawn.
+// Camera planes pushed by the application are honored.
+//
+// The queries return the leaf objects whose world bound intersects the
+// frustum, sphere or box.  FindVisible skips the objects that Draw does not
+// draw, FindInSphere and FindInBox ignore ForceCull.  An object belongs to
+// at most one index.
+
+class WG3D_FOUNDATION_ITEM SpatialIndex
+{
+public:
+    // construction and destruction
+    SpatialIndex (Spatial* pkRoot);
+    ~SpatialIndex ();
+
+    Spatial* GetRoot () const;
+
+    // the refit of the hierarchy from the world bounds
+    void Update ();
+
+    // Culling support for Renderer::DrawScene.  The visible leaves are
+    // drawn through Spatial::OnDraw.
+    void Draw (Renderer& rkRenderer);
+
+    // Region queries.  The objects are appended to rkObjects.
+    void FindVisible (Camera* pkCamera, TArray<Spatial*>& rkObjects);
+    void FindInSphere (const Sphere3x& rkSphere,
+        TArray<Spatial*>& rkObjects);
+    void FindInBox (const Vector3x& rkMin, const Vector3x& rkMax,
+        TArray<Spatial*>& rkObjects);
+
+    // the number of leaves and the height of the hierarchy (a single leaf
+    // has height 0, an empty hierarchy -1)
+    int GetLeafQuantity () const;
+    int GetHeight () const;
+
+    // the number of leaves that were inserted, counting the reinsertion of
+    // moving objects, in the most recent Update
+    int GetInsertions () const;
+
+private:
+    // an axis-aligned box
+    class Box
+    {
+    public:
+        Vector3x Min, Max;
+
+        void Merge (const Box& rkA, const Box& rkB);
+        bool Contains (const Box& rkBox) const;
+        bool Intersects (const Box& rkBox) const;
+        fixed GetCost () const;
+    };
+
+    // An object of the subtree.  Parents precede their children.
+    class Entry
+    {
+    public:
+        Spatial* Object;
+        int Parent;
+        int Leaf;           // the tree node of the object, or -1
+        unsigned int Flags;
+        Sphere3x Bound;     // the world bound when the leaf was refit
+    };
+
+    enum // Flags
+    {
+        F_NODE = 1,         // the object is a Node
+        F_UNIT = 2,         // the object is a leaf of the hierarchy
+        F_INSIDE = 4,       // the object is below a unit
+        F_HIDDEN = 8        // ForceCull is set on the object or above it
+    };
+
+    // A node of the hierarchy.  Leaves have no children, they keep the
+    // object and its F_HIDDEN flag, so the culling does not visit the
+    // entries.  A free node links to the next one through Parent.
+    class TreeNode
+    {
+    public:
+        Box Bound;
+        int Parent;
+        int Child[2];
+        int Height;
+        int Entry;
+        Spatial* Object;
+        bool Hidden;
+
+        bool IsLeaf () const;
+    };
+
+    // entries
+    void Append (Spatial* pkObject, int iParent);
+    void Compact ();
+
+    // hierarchy
+    int AllocateNode ();
+    void FreeNode (int iNode);
+    void InsertLeaf (int iEntry, const Vector3x& rkMotion);
+    void RemoveLeaf (int iEntry);
+    void InsertTreeLeaf (int iLeaf);
+    void RemoveTreeLeaf (int iLeaf);
+    void Refit (int iNode);
+    int Balance (int iA);
+    static void GetBox (const Sphere3x& rkBound, fixed fMargin,
+        Box& rkBox);
+
+    // The objects of the leaves whose boxes are not culled by the planes of
+    // uiState, and are not hidden, are stored in m_kLeaf, with the planes
+    // that still intersect them in m_kLeafMask.  Culled is true when the box
+    // is on the negative side of a plane of the mask, and it removes the
+    // planes with the box on their positive side from the mask.
+    void CullLeaves (const Plane3x* akPlane, int iPlaneQuantity,
+        unsigned int uiState);
+    static bool Culled (const Box& rkBox, const Plane3x* akPlane,
+        int iPlaneQuantity, unsigned int& ruiMask);
+
+    // the exact tests of the queries
+    static bool SphereIntersectsSphere (const Sphere3x& rkA,
+        const Sphere3x& rkB);
+    static bool SphereIntersectsBox (const Sphere3x& rkSphere,
+        const Box& rkBox);
+
+    Pointer<Spatial> m_spkRoot;
+
+    TArray<Entry> m_kEntry;
+    int m_iRemoved;
+
+    TArray<TreeNode> m_kNode;
+    int m_iTreeRoot, m_iFreeNode;
+    int m_iLeafQuantity;
+    int m_iInsertions;
+
+    // the traversal stack of Draw and the queries, and the leaves that
+    // CullLeaves found
+    TArray<int> m_kStack;
+    TArray<unsigned int> m_kMask;
+    TArray<Spatial*> m_kLeaf;
+    TArray<unsigned int> m_kLeafMask;
+
+// internal use
+public:
+    // Spatial::SetParent calls these when a child is attached to or
+    // detached from an object of the index.
+    void OnAttach (Spatial* pkChild, int iParent);
+    void OnDetach (int iHandle);
+
+    // the object is being destroyed
+    void OnDestroy (int iHandle);
+};
+
+#include "WgSpatialIndex.inl"
+
+}
+
+#endif
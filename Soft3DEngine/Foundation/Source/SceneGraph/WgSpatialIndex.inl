@@ -0,0 +1,34 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSpatialIndex.inl                 //
+//                                                       //
+//  - Inlines for Spatial Index class                    //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+inline Spatial* SpatialIndex::GetRoot () const
+{
+    return m_spkRoot;
+}
+//----------------------------------------------------------------------------
+inline int SpatialIndex::GetLeafQuantity () const
+{
+    return m_iLeafQuantity;
+}
+//----------------------------------------------------------------------------
+inline int SpatialIndex::GetHeight () const
+{
+    return (m_iTreeRoot >= 0 ? m_kNode[m_iTreeRoot].Height : -1);
+}
+//----------------------------------------------------------------------------
+inline int SpatialIndex::GetInsertions () const
+{
+    return m_iInsertions;
+}
+//----------------------------------------------------------------------------
+inline bool SpatialIndex::TreeNode::IsLeaf () const
+{
+    return Child[0] < 0;
+}
+//----------------------------------------------------------------------------
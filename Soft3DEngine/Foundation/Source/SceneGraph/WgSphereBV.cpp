@@ -19,16 +19,6 @@ using namespace WGSoft3D;
 WG3D_IMPLEMENT_RTTI(WGSoft3D,SphereBV,BoundingVolume);
 WG3D_IMPLEMENT_DEFAULT_NAME_ID(SphereBV,BoundingVolume);
 
-//----------------------------------------------------------------------------
-// The factory function of BoundingVolume creates SphereBV objects.  You may
-// delete this and allow another bounding volume class to be the default.
-//----------------------------------------------------------------------------
-BoundingVolume* BoundingVolume::Create ()
-{
-    return WG_NEW SphereBV;
-}
-//----------------------------------------------------------------------------
-
 //----------------------------------------------------------------------------
 SphereBV::SphereBV ()
     :
@@ -55,6 +45,7 @@ void SphereBV::ComputeFromData (const Vector3xArray* pkVertices)
 void SphereBV::TransformBy (const Transformation& rkTransform,
     BoundingVolume* pkResult)
 {
+    assert(pkResult->GetBVType() == BV_SPHERE);
     Sphere3x& rkTarget = ((SphereBV*)pkResult)->m_kSphere;
     rkTarget.Center = rkTransform.ApplyForward(m_kSphere.Center);
     rkTarget.Radius = rkTransform.GetNorm()*m_kSphere.Radius;
@@ -76,6 +67,12 @@ int SphereBV::WhichSide (const Plane3x& rkPlane) const
     return 0;
 }
 //----------------------------------------------------------------------------
+Box3x SphereBV::GetBox () const
+{
+    return Box3x(m_kSphere.Center,Vector3x::UNIT_X,Vector3x::UNIT_Y,
+        Vector3x::UNIT_Z,m_kSphere.Radius,m_kSphere.Radius,m_kSphere.Radius);
+}
+//----------------------------------------------------------------------------
 bool SphereBV::TestIntersection (const Ray3x& rkRay) const
 {
     return IntrRay3Sphere3x(rkRay,m_kSphere).Test();
@@ -83,18 +80,40 @@ bool SphereBV::TestIntersection (const Ray3x& rkRay) const
 //----------------------------------------------------------------------------
 bool SphereBV::TestIntersection (const BoundingVolume* pkInput) const
 {
+    if (pkInput->GetBVType() != BV_SPHERE)
+    {
+        // the box bounds test spheres exactly
+        return pkInput->TestIntersection(this);
+    }
+
     return IntrSphere3Sphere3x(m_kSphere,
         ((SphereBV*)pkInput)->m_kSphere).Test();
 }
 //----------------------------------------------------------------------------
 void SphereBV::CopyFrom (const BoundingVolume* pkInput)
 {
-    m_kSphere = ((SphereBV*)pkInput)->m_kSphere;
+    if (pkInput->GetBVType() == BV_SPHERE)
+    {
+        m_kSphere = ((SphereBV*)pkInput)->m_kSphere;
+    }
+    else
+    {
+        m_kSphere.Center = pkInput->GetCenter();
+        m_kSphere.Radius = pkInput->GetRadius();
+    }
 }
 //----------------------------------------------------------------------------
 void SphereBV::GrowToContain (const BoundingVolume* pkInput)
 {
-    m_kSphere = MergeSpheres(m_kSphere,((SphereBV*)pkInput)->m_kSphere);
+    if (pkInput->GetBVType() == BV_SPHERE)
+    {
+        m_kSphere = MergeSpheres(m_kSphere,((SphereBV*)pkInput)->m_kSphere);
+    }
+    else
+    {
+        Sphere3x kInput(pkInput->GetCenter(),pkInput->GetRadius());
+        m_kSphere = MergeSpheres(m_kSphere,kInput);
+    }
 }
 //----------------------------------------------------------------------------
 bool SphereBV::Contains (const Vector3x& rkPoint) const
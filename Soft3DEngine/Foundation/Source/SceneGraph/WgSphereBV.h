@@ -37,6 +37,9 @@ public:
     virtual Vector3x GetCenter () const;
     virtual fixed GetRadius () const;
 
+    // the axis-aligned cube around the sphere
+    virtual Box3x GetBox () const;
+
     Sphere3x& Sphere ();
     const Sphere3x& GetSphere () const;
 
@@ -65,7 +68,8 @@ public:
     virtual void CopyFrom (const BoundingVolume* pkInput);
 
     // Change the current sphere so that it is the minimum volume sphere that
-    // contains the input sphere as well as its old sphere.
+    // contains the input sphere as well as its old sphere.  A box is
+    // replaced by its bounding sphere.
     virtual void GrowToContain (const BoundingVolume* pkInput);
 
     // test for containment of a point
@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgStandardMesh.h                   //
+//                                                       //
+//  - Interface for StandardMesh class                   //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_STANDARDMESH_H__
+#define __WG_STANDARDMESH_H__
+
+#include "WgFoundationLIB.h"
+#include "WgTriMesh.h"
+#include "WgVector2Array.h"
+
+namespace WGSoft3D
+{
+
+class WG3D_FOUNDATION_ITEM StandardMesh
+{
+public:
+    StandardMesh ();
+    ~StandardMesh ();
+
+    // parameters to control the mesh generation
+    StandardMesh& Transform (const Transformation& rkXFrm);
+    StandardMesh& Vertices (bool bCached);
+    StandardMesh& Indices (bool bCached);
+    StandardMesh& Normals (bool bCreate, bool bCached);
+    StandardMesh& UVs (bool bCreate, bool bCached);
+    StandardMesh& Inside (bool bInside);
+
+    // texture coordinates
+    Vector2xArrayPtr GetUVs () const;
+
+    // Standard meshes.  Each mesh is centered at (0,0,0) and has an up-axis
+    // of (0,0,1).  The other axes forming the coordinate system are (1,0,0)
+    // and (0,1,0).  An application may transform the meshes as necessary.
+    //
+    // The indices are shorts, so a mesh has at most 32767 vertices.  The
+    // sample counts of the tessellated meshes must respect that limit.
+
+    TriMesh* Rectangle (int iXSamples, int iYSamples, fixed fXExtent,
+        fixed fYExtent);
+
+    TriMesh* Disk (int iShellSamples, int iRadialSamples, fixed fRadius);
+
+    TriMesh* Box (fixed fXExtent, fixed fYExtent, fixed fZExtent);
+
+    TriMesh* Cylinder (int iAxisSamples, int iRadialSamples, fixed fRadius,
+        fixed fHeight, bool bOpen);
+
+    TriMesh* Sphere (int iZSamples, int iRadialSamples, fixed fRadius);
+
+    TriMesh* Torus (int iCircleSamples, int iRadialSamples,
+        fixed fOuterRadius, fixed fInnerRadius);
+
+    // Platonic solids, inscribed in a unit sphere centered at (0,0,0).
+    TriMesh* Tetrahedron ();
+    TriMesh* Hexahedron ();
+    TriMesh* Octahedron ();
+    TriMesh* Dodecahedron ();
+    TriMesh* Icosahedron ();
+
+private:
+    void CreateData (int iVQuantity, int iTQuantity);
+    void CreatePlatonicNormals (int iVQuantity);
+    void CreatePlatonicUVs (int iVQuantity);
+    void ReverseTriangleOrder (int iTQuantity);
+    void TransformData (int iVQuantity);
+
+    // the fraction i/iQuantity
+    static fixed Fraction (int i, int iQuantity);
+
+    // temporary storage for mesh creation
+    Vector3xArrayPtr m_spkVertices;
+    ShortArrayPtr m_spkIndices;
+    Vector3xArrayPtr m_spkNormals;
+    Vector2xArrayPtr m_spkUVs;
+    Vector3x* m_akVertex;
+    short* m_aiIndex;
+    Vector3x* m_akNormal;
+    Vector2x* m_akUV;
+
+    Transformation m_kXFrm;
+
+    bool m_bCachedVertices;  // default = false
+    bool m_bCachedIndices;   // default = false
+    bool m_bCachedNormals;   // default = false
+    bool m_bCachedUVs;       // default = false
+    bool m_bNormals;         // default = false
+    bool m_bUVs;             // default = false
+    bool m_bInside;          // default = false
+};
+
+#include "WgStandardMesh.inl"
+
+}
+
+#endif
@@ -0,0 +1,46 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgStandardMesh.inl                 //
+//                                                       //
+//  - Inlines for StandardMesh class                     //
+//                                                       //
+///////////////////////////////////////////////////////////
+//----------------------------------------------------------------------------
+inline StandardMesh& StandardMesh::Vertices (bool bCached)
+{
+    m_bCachedVertices = bCached;
+    return *this;
+}
+//----------------------------------------------------------------------------
+inline StandardMesh& StandardMesh::Indices (bool bCached)
+{
+    m_bCachedIndices = bCached;
+    return *this;
+}
+//----------------------------------------------------------------------------
+inline StandardMesh& StandardMesh::Normals (bool bCreate, bool bCached)
+{
+    m_bNormals = bCreate;
+    m_bCachedNormals = bCached;
+    return *this;
+}
+//----------------------------------------------------------------------------
+inline StandardMesh& StandardMesh::UVs (bool bCreate, bool bCached)
+{
+    m_bUVs = bCreate;
+    m_bCachedUVs = bCached;
+    return *this;
+}
+//----------------------------------------------------------------------------
+inline StandardMesh& StandardMesh::Inside (bool bInside)
+{
+    m_bInside = bInside;
+    return *this;
+}
+//----------------------------------------------------------------------------
+inline Vector2xArrayPtr StandardMesh::GetUVs () const
+{
+    return m_spkUVs;
+}
+//----------------------------------------------------------------------------
+
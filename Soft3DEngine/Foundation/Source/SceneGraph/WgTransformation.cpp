@@ -12,6 +12,7 @@
 
 #include "WgFoundationPCH.h"
 #include "WgTransformation.h"
+#include "WgFixedSimd.h"
 using namespace WGSoft3D;
 
 const Transformation Transformation::IDENTITY;
@@ -27,12 +28,57 @@ Transformation::Transformation ()
     m_bIsIdentity = true;
     m_bIsRSMatrix = true;
     m_bIsUniformScale = true;
+    m_uiVersion = 1;
 }
 //----------------------------------------------------------------------------
 Transformation::~Transformation ()
 {
 }
 //----------------------------------------------------------------------------
+Transformation& Transformation::operator= (const Transformation& rkTransform)
+{
+    if (m_bIsIdentity != rkTransform.m_bIsIdentity
+    ||  m_bIsRSMatrix != rkTransform.m_bIsRSMatrix
+    ||  m_bIsUniformScale != rkTransform.m_bIsUniformScale
+    ||  m_kTranslate != rkTransform.m_kTranslate
+    ||  m_kScale != rkTransform.m_kScale
+    ||  m_kMatrix != rkTransform.m_kMatrix)
+    {
+        m_kMatrix = rkTransform.m_kMatrix;
+        m_kTranslate = rkTransform.m_kTranslate;
+        m_kScale = rkTransform.m_kScale;
+        m_bIsIdentity = rkTransform.m_bIsIdentity;
+        m_bIsRSMatrix = rkTransform.m_bIsRSMatrix;
+        m_bIsUniformScale = rkTransform.m_bIsUniformScale;
+        m_uiVersion++;
+    }
+    return *this;
+}
+//----------------------------------------------------------------------------
+void Transformation::Set (const Matrix3x& rkMatrix,
+    const Vector3x& rkTranslate, const Vector3x& rkScale,
+    unsigned int uiHints)
+{
+    bool bIsIdentity = ((uiHints & H_IDENTITY) != 0);
+    bool bIsRSMatrix = ((uiHints & H_RSMATRIX) != 0);
+    bool bIsUniformScale = ((uiHints & H_UNIFORM_SCALE) != 0);
+    if (m_bIsIdentity != bIsIdentity
+    ||  m_bIsRSMatrix != bIsRSMatrix
+    ||  m_bIsUniformScale != bIsUniformScale
+    ||  m_kTranslate != rkTranslate
+    ||  m_kScale != rkScale
+    ||  m_kMatrix != rkMatrix)
+    {
+        m_kMatrix = rkMatrix;
+        m_kTranslate = rkTranslate;
+        m_kScale = rkScale;
+        m_bIsIdentity = bIsIdentity;
+        m_bIsRSMatrix = bIsRSMatrix;
+        m_bIsUniformScale = bIsUniformScale;
+        m_uiVersion++;
+    }
+}
+//----------------------------------------------------------------------------
 void Transformation::MakeIdentity ()
 {
     m_kMatrix = Matrix3x::IDENTITY;
@@ -41,6 +87,7 @@ void Transformation::MakeIdentity ()
     m_bIsIdentity = true;
     m_bIsRSMatrix = true;
     m_bIsUniformScale = true;
+    m_uiVersion++;
 }
 //----------------------------------------------------------------------------
 void Transformation::MakeUnitScale ()
@@ -49,20 +96,27 @@ void Transformation::MakeUnitScale ()
 
     m_kScale = Vector3x(fixed(FIXED_ONE),fixed(FIXED_ONE),fixed(FIXED_ONE));
     m_bIsUniformScale = true;
+    m_uiVersion++;
 }
 //----------------------------------------------------------------------------
 fixed Transformation::GetNorm () const
 {
-    if (m_bIsRSMatrix)
+    return GetNorm(m_kMatrix,m_kScale,GetHints());
+}
+//----------------------------------------------------------------------------
+fixed Transformation::GetNorm (const Matrix3x& rkMatrix,
+    const Vector3x& rkScale, unsigned int uiHints)
+{
+    if (uiHints & H_RSMATRIX)
     {
-        fixed fMax = Mathx::FAbs(m_kScale.X());
-        if (Mathx::FAbs(m_kScale.Y()) > fMax)
+        fixed fMax = Mathx::FAbs(rkScale.X());
+        if (Mathx::FAbs(rkScale.Y()) > fMax)
         {
-            fMax = Mathx::FAbs(m_kScale.Y());
+            fMax = Mathx::FAbs(rkScale.Y());
         }
-        if (Mathx::FAbs(m_kScale.Z()) > fMax)
+        if (Mathx::FAbs(rkScale.Z()) > fMax)
         {
-            fMax = Mathx::FAbs(m_kScale.Z());
+            fMax = Mathx::FAbs(rkScale.Z());
         }
         return fMax;
     }
@@ -72,14 +126,14 @@ fixed Transformation::GetNorm () const
     // equal to this norm.  Therefore, this function returns an approximation
     // to the maximum scale.
     fixed fMaxColSum =
-        Mathx::FAbs(m_kMatrix[0][0]) +
-        Mathx::FAbs(m_kMatrix[1][0]) +
-        Mathx::FAbs(m_kMatrix[2][0]);
+        Mathx::FAbs(rkMatrix[0][0]) +
+        Mathx::FAbs(rkMatrix[1][0]) +
+        Mathx::FAbs(rkMatrix[2][0]);
 
     fixed fColSum =
-        Mathx::FAbs(m_kMatrix[0][1]) +
-        Mathx::FAbs(m_kMatrix[1][1]) +
-        Mathx::FAbs(m_kMatrix[2][1]);
+        Mathx::FAbs(rkMatrix[0][1]) +
+        Mathx::FAbs(rkMatrix[1][1]) +
+        Mathx::FAbs(rkMatrix[2][1]);
 
     if (fColSum > fMaxColSum)
     {
@@ -87,9 +141,9 @@ fixed Transformation::GetNorm () const
     }
 
     fColSum =
-        Mathx::FAbs(m_kMatrix[0][2]) +
-        Mathx::FAbs(m_kMatrix[1][2]) +
-        Mathx::FAbs(m_kMatrix[2][2]);
+        Mathx::FAbs(rkMatrix[0][2]) +
+        Mathx::FAbs(rkMatrix[1][2]) +
+        Mathx::FAbs(rkMatrix[2][2]);
 
     if (fColSum > fMaxColSum)
     {
@@ -104,12 +158,14 @@ void Transformation::SetRotate (const Matrix3x& rkRotate)
     m_kMatrix = rkRotate;
     m_bIsIdentity = false;
     m_bIsRSMatrix = true;
+    m_uiVersion++;
 }
 //----------------------------------------------------------------------------
 void Transformation::SetTranslate (const Vector3x& rkTranslate)
 {
     m_kTranslate = rkTranslate;
     m_bIsIdentity = false;
+    m_uiVersion++;
 }
 //----------------------------------------------------------------------------
 void Transformation::SetScale (const Vector3x& rkScale)
@@ -120,6 +176,7 @@ void Transformation::SetScale (const Vector3x& rkScale)
     m_kScale = rkScale;
     m_bIsIdentity = false;
     m_bIsUniformScale = false;
+    m_uiVersion++;
 }
 //----------------------------------------------------------------------------
 void Transformation::SetUniformScale (fixed fScale)
@@ -128,6 +185,7 @@ void Transformation::SetUniformScale (fixed fScale)
     m_kScale = Vector3x(fScale,fScale,fScale);
     m_bIsIdentity = false;
     m_bIsUniformScale = true;
+    m_uiVersion++;
 }
 //----------------------------------------------------------------------------
 void Transformation::SetMatrix (const Matrix3x& rkMatrix)
@@ -136,27 +194,35 @@ void Transformation::SetMatrix (const Matrix3x& rkMatrix)
     m_bIsIdentity = false;
     m_bIsRSMatrix = false;
     m_bIsUniformScale = false;
+    m_uiVersion++;
 }
 //----------------------------------------------------------------------------
 Vector3x Transformation::ApplyForward (const Vector3x& rkInput) const
 {
-    if (m_bIsIdentity)
+    return ApplyForward(m_kMatrix,m_kTranslate,m_kScale,GetHints(),rkInput);
+}
+//----------------------------------------------------------------------------
+Vector3x Transformation::ApplyForward (const Matrix3x& rkMatrix,
+    const Vector3x& rkTranslate, const Vector3x& rkScale,
+    unsigned int uiHints, const Vector3x& rkInput)
+{
+    if (uiHints & H_IDENTITY)
     {
         // Y = X
         return rkInput;
     }
 
-    if (m_bIsRSMatrix)
+    if (uiHints & H_RSMATRIX)
     {
         // Y = R*S*X + T
-        Vector3x kOutput(m_kScale.X()*rkInput.X(),m_kScale.Y()*rkInput.Y(),
-            m_kScale.Z()*rkInput.Z());
-        kOutput = m_kMatrix*kOutput + m_kTranslate;
+        Vector3x kOutput(rkScale.X()*rkInput.X(),rkScale.Y()*rkInput.Y(),
+            rkScale.Z()*rkInput.Z());
+        kOutput = rkMatrix*kOutput + rkTranslate;
         return kOutput;
     }
 
     // Y = M*X + T
-    Vector3x kOutput = m_kMatrix*rkInput + m_kTranslate;
+    Vector3x kOutput = rkMatrix*rkInput + rkTranslate;
     return kOutput;
 }
 //----------------------------------------------------------------------------
@@ -169,28 +235,17 @@ void Transformation::ApplyForward (int iQuantity, const Vector3x* akInput,
         size_t uiSize = iQuantity*sizeof(Vector3x);
         System::Memcpy(akOutput,uiSize,akInput,uiSize);
     }
+    else if (m_bIsRSMatrix)
+    {
+        // Y = R*S*X + T
+        FixedSimd::Transform(iQuantity,m_kMatrix,m_kScale,m_kTranslate,
+            akInput,akOutput);
+    }
     else
     {
-        int i;
-        if (m_bIsRSMatrix)
-        {
-            // Y = R*S*X + T
-            for (i = 0; i < iQuantity; i++)
-            {
-                akOutput[i].X() = m_kScale.X()*akInput[i].X();
-                akOutput[i].Y() = m_kScale.Y()*akInput[i].Y();
-                akOutput[i].Z() = m_kScale.Z()*akInput[i].Z();
-                akOutput[i] = m_kMatrix*akOutput[i] + m_kTranslate;
-            }
-        }
-        else
-        {
-            // Y = M*X + T
-            for (i = 0; i < iQuantity; i++)
-            {
-                akOutput[i] = m_kMatrix*akInput[i] + m_kTranslate;
-            }
-        }
+        // Y = M*X + T
+        FixedSimd::Transform(iQuantity,m_kMatrix,m_kTranslate,akInput,
+            akOutput);
     }
 }
 //----------------------------------------------------------------------------
@@ -422,51 +477,69 @@ Plane3x Transformation::ApplyForward (const Plane3x& rkInput) const
 void Transformation::Product (const Transformation& rkA,
     const Transformation& rkB)
 {
-    if (rkA.IsIdentity())
+    // The product is built in temporaries and set, so the version only
+    // changes when the product differs from the current transformation.
+    Matrix3x kMatrix;
+    Vector3x kTranslate, kScale;
+    unsigned int uiHints = Product(rkA.m_kMatrix,rkA.m_kTranslate,
+        rkA.m_kScale,rkA.GetHints(),rkB.m_kMatrix,rkB.m_kTranslate,
+        rkB.m_kScale,rkB.GetHints(),kMatrix,kTranslate,kScale);
+    Set(kMatrix,kTranslate,kScale,uiHints);
+}
+//----------------------------------------------------------------------------
+unsigned int Transformation::Product (const Matrix3x& rkMA,
+    const Vector3x& rkTA, const Vector3x& rkSA, unsigned int uiHintsA,
+    const Matrix3x& rkMB, const Vector3x& rkTB, const Vector3x& rkSB,
+    unsigned int uiHintsB, Matrix3x& rkMatrix, Vector3x& rkTranslate,
+    Vector3x& rkScale)
+{
+    if (uiHintsA & H_IDENTITY)
     {
-        *this = rkB;
-        return;
+        rkMatrix = rkMB;
+        rkTranslate = rkTB;
+        rkScale = rkSB;
+        return uiHintsB;
     }
 
-    if (rkB.IsIdentity())
+    if (uiHintsB & H_IDENTITY)
     {
-        *this = rkA;
-        return;
+        rkMatrix = rkMA;
+        rkTranslate = rkTA;
+        rkScale = rkSA;
+        return uiHintsA;
     }
 
-    if (rkA.m_bIsRSMatrix && rkB.m_bIsRSMatrix)
+    if ((uiHintsA & H_RSMATRIX) && (uiHintsB & H_RSMATRIX))
     {
-        if (rkA.m_bIsUniformScale)
+        if (uiHintsA & H_UNIFORM_SCALE)
         {
-            SetRotate(rkA.m_kMatrix*rkB.m_kMatrix);
-
-            SetTranslate(rkA.GetUniformScale()*(
-                rkA.m_kMatrix*rkB.m_kTranslate) + rkA.m_kTranslate);
+            fixed fScaleA = rkSA.X();
+            rkMatrix = rkMA*rkMB;
+            rkTranslate = fScaleA*(rkMA*rkTB) + rkTA;
 
-            if (rkB.IsUniformScale())
+            if (uiHintsB & H_UNIFORM_SCALE)
             {
-                SetUniformScale(rkA.GetUniformScale()*rkB.GetUniformScale());
-            }
-            else
-            {
-                SetScale(rkA.GetUniformScale()*rkB.GetScale());
+                fixed fScale = fScaleA*rkSB.X();
+                rkScale = Vector3x(fScale,fScale,fScale);
+                return H_RSMATRIX | H_UNIFORM_SCALE;
             }
 
-            return;
+            rkScale = fScaleA*rkSB;
+            return H_RSMATRIX;
         }
     }
 
     // In all remaining cases, the matrix cannot be written as R*S*X+T.
-    Matrix3x kMA = (rkA.m_bIsRSMatrix ?
-        rkA.m_kMatrix.TimesDiagonal(rkA.m_kScale) :
-        rkA.m_kMatrix);
+    Matrix3x kMA = ((uiHintsA & H_RSMATRIX) ? rkMA.TimesDiagonal(rkSA) :
+        rkMA);
 
-    Matrix3x kMB = (rkB.m_bIsRSMatrix ?
-        rkB.m_kMatrix.TimesDiagonal(rkB.m_kScale) :
-        rkB.m_kMatrix);
+    Matrix3x kMB = ((uiHintsB & H_RSMATRIX) ? rkMB.TimesDiagonal(rkSB) :
+        rkMB);
 
-    SetMatrix(kMA*kMB);
-    SetTranslate(kMA*rkB.m_kTranslate+rkA.m_kTranslate);
+    rkMatrix = kMA*kMB;
+    rkTranslate = kMA*rkTB + rkTA;
+    rkScale = Vector3x(fixed(FIXED_ONE),fixed(FIXED_ONE),fixed(FIXED_ONE));
+    return 0;
 }
 //----------------------------------------------------------------------------
 void Transformation::Inverse (Transformation& rkInverse) const
@@ -498,5 +571,54 @@ void Transformation::Inverse (Transformation& rkInverse) const
     rkInverse.m_bIsIdentity = false;
     rkInverse.m_bIsRSMatrix = false;
     rkInverse.m_bIsUniformScale = false;
+    rkInverse.m_uiVersion++;
+}
+//----------------------------------------------------------------------------
+void Transformation::GetHomogeneous (fixed* afH) const
+{
+    if (m_bIsRSMatrix)
+    {
+        MakeHomogeneous(m_kMatrix.TimesDiagonal(m_kScale),m_kTranslate,afH);
+    }
+    else
+    {
+        MakeHomogeneous(m_kMatrix,m_kTranslate,afH);
+    }
+}
+//----------------------------------------------------------------------------
+void Transformation::GetInverseHomogeneous (fixed* afInvH) const
+{
+    if (m_bIsIdentity)
+    {
+        MakeHomogeneous(Matrix3x::IDENTITY,Vector3x::ZERO,afInvH);
+    }
+    else
+    {
+        Transformation kInverse;
+        Inverse(kInverse);
+        MakeHomogeneous(kInverse.m_kMatrix,kInverse.m_kTranslate,afInvH);
+    }
+}
+//----------------------------------------------------------------------------
+void Transformation::MakeHomogeneous (const Matrix3x& rkMatrix,
+    const Vector3x& rkTranslate, fixed* afH)
+{
+    // column-major, the translation is the last column of H
+    afH[ 0] = rkMatrix[0][0];
+    afH[ 1] = rkMatrix[1][0];
+    afH[ 2] = rkMatrix[2][0];
+    afH[ 3] = FIXED_ZERO;
+    afH[ 4] = rkMatrix[0][1];
+    afH[ 5] = rkMatrix[1][1];
+    afH[ 6] = rkMatrix[2][1];
+    afH[ 7] = FIXED_ZERO;
+    afH[ 8] = rkMatrix[0][2];
+    afH[ 9] = rkMatrix[1][2];
+    afH[10] = rkMatrix[2][2];
+    afH[11] = FIXED_ZERO;
+    afH[12] = rkTranslate.X();
+    afH[13] = rkTranslate.Y();
+    afH[14] = rkTranslate.Z();
+    afH[15] = FIXED_ONE;
 }
 //----------------------------------------------------------------------------
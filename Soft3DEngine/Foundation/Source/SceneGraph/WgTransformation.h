@@ -34,11 +34,14 @@ public:
 
     // Construction and destruction.  The default constructor produces the
     // identity transformation.  The default copy constructor is created by
-    // the compiler, as is the default assignment operator.  The defaults are
-    // consistent with the design of this class.
+    // the compiler.  The assignment operator copies only when the
+    // transformation actually changes, so the version (see GetVersion) is
+    // left alone when an unchanged transformation is assigned again.
     Transformation ();
     ~Transformation ();
 
+    Transformation& operator= (const Transformation& rkTransform);
+
     // set the transformation to the identity
     void MakeIdentity ();
 
@@ -103,16 +106,63 @@ public:
     // pair, the inverse is <M^{-1},-M^{-1}*T>.
     void Inverse (Transformation& rkInverse) const;
 
+    // The 4-by-4 homogeneous matrix H = [M T; 0 1] and its inverse, stored
+    // in column-major order so that they can be passed directly to
+    // glLoadMatrix/glMultMatrix.  For M = R*S the upper 3-by-3 block is
+    // R*S.  Geometry caches both for its world transformation.
+    void GetHomogeneous (fixed* afH) const;
+    void GetInverseHomogeneous (fixed* afInvH) const;
+
+    // The version is incremented by every member function that changes the
+    // transformation.  A client that holds data derived from the
+    // transformation can compare versions to find out whether it is stale.
+    unsigned int GetVersion () const;
+
+    // The components of the transformation, for code that keeps many
+    // transformations as arrays of components (LinearScene).  The scale is
+    // (1,1,1) when M is a general matrix.  Set copies and changes the
+    // version only when the transformation changes, like operator=.
+    enum // Hints
+    {
+        H_IDENTITY = 1,
+        H_RSMATRIX = 2,
+        H_UNIFORM_SCALE = 4
+    };
+    unsigned int GetHints () const;
+    void Get (Matrix3x& rkMatrix, Vector3x& rkTranslate, Vector3x& rkScale,
+        unsigned int& ruiHints) const;
+    void Set (const Matrix3x& rkMatrix, const Vector3x& rkTranslate,
+        const Vector3x& rkScale, unsigned int uiHints);
+
+    // Product, ApplyForward and GetNorm of transformations given by their
+    // components, the member functions of the same names call these.
+    // Product returns the hints of C = A*B, its outputs must not be any of
+    // its inputs.
+    static unsigned int Product (const Matrix3x& rkMA,
+        const Vector3x& rkTA, const Vector3x& rkSA, unsigned int uiHintsA,
+        const Matrix3x& rkMB, const Vector3x& rkTB, const Vector3x& rkSB,
+        unsigned int uiHintsB, Matrix3x& rkMatrix, Vector3x& rkTranslate,
+        Vector3x& rkScale);
+    static Vector3x ApplyForward (const Matrix3x& rkMatrix,
+        const Vector3x& rkTranslate, const Vector3x& rkScale,
+        unsigned int uiHints, const Vector3x& rkInput);
+    static fixed GetNorm (const Matrix3x& rkMatrix, const Vector3x& rkScale,
+        unsigned int uiHints);
+
     // The identity transformation.
     static const Transformation IDENTITY;
 
 private:
     friend class Spatial;
 
+    static void MakeHomogeneous (const Matrix3x& rkMatrix,
+        const Vector3x& rkTranslate, fixed* afH);
+
     Matrix3x m_kMatrix;
     Vector3x m_kTranslate;
     Vector3x m_kScale;
     bool m_bIsIdentity, m_bIsRSMatrix, m_bIsUniformScale;
+    unsigned int m_uiVersion;
 };
 
 #include "WgTransformation.inl"
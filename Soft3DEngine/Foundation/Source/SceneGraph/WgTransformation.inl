@@ -53,4 +53,24 @@ inline fixed Transformation::GetUniformScale () const
     return m_kScale.X();
 }
 //----------------------------------------------------------------------------
-
+inline unsigned int Transformation::GetVersion () const
+{
+    return m_uiVersion;
+}
+//----------------------------------------------------------------------------
+inline unsigned int Transformation::GetHints () const
+{
+    return (m_bIsIdentity ? H_IDENTITY : 0) |
+        (m_bIsRSMatrix ? H_RSMATRIX : 0) |
+        (m_bIsUniformScale ? H_UNIFORM_SCALE : 0);
+}
+//----------------------------------------------------------------------------
+inline void Transformation::Get (Matrix3x& rkMatrix, Vector3x& rkTranslate,
+    Vector3x& rkScale, unsigned int& ruiHints) const
+{
+    rkMatrix = m_kMatrix;
+    rkTranslate = m_kTranslate;
+    rkScale = m_kScale;
+    ruiHints = GetHints();
+}
+//----------------------------------------------------------------------------
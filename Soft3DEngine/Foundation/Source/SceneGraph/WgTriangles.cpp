@@ -13,6 +13,8 @@
 #include "WgTriangles.h"
 #include "WgCachedVector3Array.h"
 #include "WgIntrRay3Triangle3.h"
+#include "WgFixedSimd.h"
+#include "WgProfiler.h"
 using namespace WGSoft3D;
 
 WG3D_IMPLEMENT_RTTI(WGSoft3D,Triangles,Geometry);
@@ -105,6 +107,8 @@ void Triangles::GenerateNormals (bool bCached)
 //----------------------------------------------------------------------------
 void Triangles::UpdateModelNormals ()
 {
+    WG3D_PROFILE("Triangles::UpdateModelNormals");
+
     if (!Normals)
     {
         return;
@@ -118,36 +122,47 @@ void Triangles::UpdateModelNormals ()
     Vector3x* akNormal = Normals->GetData();
     memset(Normals->GetData(),0,iVQuantity*sizeof(Vector3x));
 
+    // The facet normals are computed a batch of triangles at a time.
+    const int iBatch = 128;
+    Vector3x akEdge1[iBatch], akEdge2[iBatch], akFacet[iBatch];
+    short aiIndex[3*iBatch];
+
     int iTQuantity = GetTriangleQuantity();
-    int i;
-    for (i = 0; i < iTQuantity; i++)
+    int i = 0;
+    while (i < iTQuantity)
     {
-        // get vertex indices
-        short iV0, iV1, iV2;
-        if (!GetTriangle(i,iV0,iV1,iV2))
+        int iCount = 0;
+        for (/**/; i < iTQuantity && iCount < iBatch; i++)
         {
-            continue;
-        }
+            // get vertex indices
+            short iV0, iV1, iV2;
+            if (!GetTriangle(i,iV0,iV1,iV2))
+            {
+                continue;
+            }
 
-        // get vertices
-        Vector3x& rkV0 = akVertex[iV0];
-        Vector3x& rkV1 = akVertex[iV1];
-        Vector3x& rkV2 = akVertex[iV2];
+            // get the edges
+            akEdge1[iCount] = akVertex[iV1] - akVertex[iV0];
+            akEdge2[iCount] = akVertex[iV2] - akVertex[iV0];
+            aiIndex[3*iCount] = iV0;
+            aiIndex[3*iCount+1] = iV1;
+            aiIndex[3*iCount+2] = iV2;
+            iCount++;
+        }
 
-        // compute the normal (length provides the weighted sum)
-        Vector3x kEdge1 = rkV1 - rkV0;
-        Vector3x kEdge2 = rkV2 - rkV0;
-        Vector3x kNormal = kEdge1.Cross(kEdge2);
+        // compute the normals (length provides the weighted sum)
+        FixedSimd::Cross(iCount,akEdge1,akEdge2,akFacet);
 
-        akNormal[iV0] += kNormal;
-        akNormal[iV1] += kNormal;
-        akNormal[iV2] += kNormal;
+        const short* piIndex = aiIndex;
+        for (int j = 0; j < iCount; j++, piIndex += 3)
+        {
+            akNormal[piIndex[0]] += akFacet[j];
+            akNormal[piIndex[1]] += akFacet[j];
+            akNormal[piIndex[2]] += akFacet[j];
+        }
     }
 
-    for (i = 0; i < iVQuantity; i++)
-    {
-        akNormal[i].Normalize();
-    }
+    FixedSimd::Normalize(iVQuantity,akNormal);
 }
 //----------------------------------------------------------------------------
 Triangles::PickRecord::PickRecord (Triangles* pkIObject, fixed fT,
@@ -1,4 +1,5 @@
 #include "WgFixed.h"
+#include "WgFixedMath.h"
 namespace WGSoft3D
 {
 static const dfixed __gl_rcp_tab[] = { /* domain 0.5 .. 1.0-1/16 */
@@ -35,11 +36,35 @@ ufixed CountLeadingZeros(ufixed x) {
 	return exp;
 	}
 
-int Inverse(int value)
+// The three bits after the leading one of a positive value, the index
+// into the tables.  Values below 8 have fewer bits and are shifted up.
+static inline int TableIndex(int value, int exp)
+{
+	if (exp > 28)
+		return (value<<(exp-28))&0x7;
+	return (value>>(28-exp))&0x7;
+}
+
+int InverseEstimate(int value)
 {
 	int exp;
 	int x;
 	
+	exp = CountLeadingZeros(value);
+	x = ((int)__gl_rcp_tab[TableIndex(value,exp)]) << 2;
+	exp -= 16;
+	
+	if (exp <= 0)
+		x >>= -exp;
+	else
+		x <<= exp;
+	return x;
+}
+
+int Inverse(int value)
+{
+	int x;
+	
 	if (value == FIXED_ZERO) 
 		return 0x7fffffff;
 	
@@ -50,14 +75,7 @@ int Inverse(int value)
 		value = -value;
 	}
 	
-	exp = CountLeadingZeros(value);
-	x = ((int)__gl_rcp_tab[(value>>(28-exp))&0x7]) << 2;
-	exp -= 16;
-	
-	if (exp <= 0)
-		x >>= -exp;
-	else
-		x <<= exp;
+	x = InverseEstimate(value);
 	
 	/* two iterations of newton-raphson  x = x(2-ax) */
 	x = xMul(x,(FIXED_ONE*2 - xMul(value,x)));
@@ -70,21 +88,17 @@ int Inverse(int value)
 }
 
 
+static const ufixed __gl_rsq_tab[] = { /* domain 0.5 .. 1.0-1/16 */
+	0xb504, 0xaaaa, 0xa1e8, 0x9a5f, 0x93cd, 0x8e00, 0x88d6, 0x8432,
+};
 
-int InvSqrt(int value)
+int InvSqrtEstimate(int value)
 {
-	
     int x; 
-    
-    static const ufixed __gl_rsq_tab[] = { /* domain 0.5 .. 1.0-1/16 */
-		0xb504, 0xaaaa, 0xa1e8, 0x9a5f, 0x93cd, 0x8e00, 0x88d6, 0x8432,
-    };
-    int i, exp;
-    if (value == FIXED_ZERO) return 0x7fffffff;
-    if (value == FIXED_ONE) return value;
+    int exp;
 	
 	exp = CountLeadingZeros(value);
-    x = __gl_rsq_tab[(value>>(28-exp))&0x7]<<1;
+    x = __gl_rsq_tab[TableIndex(value,exp)]<<1;
 	
     exp -= 16;
     if (exp <= 0)
@@ -92,6 +106,18 @@ int InvSqrt(int value)
     else
 		x <<= (exp>>1)+(exp&1);
     if (exp&1) x = xMul(x, __gl_rsq_tab[0]);
+    return x;
+}
+
+int InvSqrt(int value)
+{
+	
+    int x; 
+    int i;
+    if (value == FIXED_ZERO) return 0x7fffffff;
+    if (value == FIXED_ONE) return value;
+	
+    x = InvSqrtEstimate(value);
 		
     i = 0;
     do {
@@ -102,43 +128,28 @@ int InvSqrt(int value)
     return x;
 }
 
-static const unsigned short __gl_sin_tab[] = {
-#include "WgSinTable.h"
-};
+#if WG_REAL == WG_REAL_FLOAT
+int cosx(int value)
+{
+	return (int)floorf(cosf(FloatFromFixed(value))*(float)FIXED_ONE + 0.5f);
+}
 
+int sinx(int value)
+{
+	return (int)floorf(sinf(FloatFromFixed(value))*(float)FIXED_ONE + 0.5f);
+}
+#else
 int cosx(int value)
 {
-	int v;
-    /* reduce to [0,1) */
-    while (value < FIXED_ZERO) value += FIXED_2PI;
-    value *= FIXED_R2PI;
-    value >>= FIXED_PRECISION;
-    value += 0x4000;
-	
-    /* now in the range [0, 0xffff], reduce to [0, 0xfff] */
-    value >>= 4;
-	
-    v = (value & 0x400) ? __gl_sin_tab[0x3ff - (value & 0x3ff)] : __gl_sin_tab[value & 0x3ff];
-    v = xMul(v,FIXED_ONE);
-    return (value & 0x800) ? -v : v;
+	// the table lookup of the fast tier, see WgFixedMath.cpp
+	return cosx(fixed(value),FIXED_FAST).value;
 }
 
 int sinx(int value)
 {
-    int v;
-	
-    /* reduce to [0,1) */
-    while (value < FIXED_ZERO) value += FIXED_2PI;
-    value *= FIXED_R2PI;
-    value >>= FIXED_PRECISION;
-	
-    /* now in the range [0, 0xffff], reduce to [0, 0xfff] */
-    value >>= 4;
-	
-    v = (value & 0x400) ? __gl_sin_tab[0x3ff - (value & 0x3ff)] : __gl_sin_tab[value & 0x3ff];
-    v = xMul(v,FIXED_ONE);
-    return (value & 0x800) ? -v : v;
+	return sinx(fixed(value),FIXED_FAST).value;
 }
+#endif
 int xsqrt(int value)
 {
     int s;
@@ -194,6 +205,35 @@ int powx(int value, int exponent)
 }
 
 
+#if WG_REAL == WG_REAL_FLOAT
+fixed Inverse(fixed value)
+{
+	return fixed::FromFloat(1.0f/value.value);
+}
+fixed InvSqrt(fixed value)
+{
+	return fixed::FromFloat(1.0f/sqrtf(value.value));
+}
+fixed cosx(fixed value)
+{
+	return fixed::FromFloat(cosf(value.value));
+}
+
+fixed sinx(fixed value)
+{
+	return fixed::FromFloat(sinf(value.value));
+}
+
+fixed xsqrt(fixed value)
+{
+	return fixed::FromFloat(value.value <= 0.0f ? 0.0f : sqrtf(value.value));
+}
+
+fixed powx(fixed value, fixed exponent)
+{
+	return fixed::FromFloat(powf(value.value,exponent.value));
+}
+#else
 fixed Inverse(fixed value)
 {
 	return fixed(Inverse(value.value));
@@ -221,4 +261,5 @@ fixed powx(fixed value, fixed exponent)
 {
 	return fixed(powx(value.value,exponent.value));
 }
+#endif
 }
\ No newline at end of file
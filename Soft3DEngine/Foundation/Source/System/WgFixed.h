@@ -9,6 +9,7 @@
 //                                                       //
 ///////////////////////////////////////////////////////////
 #include "WgFoundationLIB.h"
+#include <math.h>
 
 #ifndef __WG3D_FIXED_H__
 #define __WG3D_FIXED_H__
@@ -18,10 +19,26 @@ namespace WGSoft3D
 #define FIXED_ONE (1<<FIXED_PRECISION)
 #define FIXED_ZERO	  0						// representation of 0
 #define FIXED_HALF	  0x08000				// 0.5 
-#define FIXED_NEG_ONE ((-1)<<FIXED_PRECISION)
+#define FIXED_NEG_ONE (-FIXED_ONE)
 
-#define FIXED_2PI		FixedFromFloat(6.28318530717958647692f)
-#define FIXED_R2PI		FixedFromFloat(1.0f/6.28318530717958647692f)
+// Compile time construction from a floating literal, rounded to nearest.
+// With a literal argument the whole expression folds to an integer
+// constant, so no float code is generated for it.
+#define FIXED_CONST_Q(x,bits)	((int)((x)*(double)(1<<(bits))+((x)<0.0?-0.5:0.5)))
+#define FIXED_CONST(x)			FIXED_CONST_Q(x,FIXED_PRECISION)
+
+#define FIXED_2PI		0x0006487F			// 6.28318530717958647692
+#define FIXED_R2PI		0x000028BE			// 1/(2*pi)
+
+// Numeric backend of the engine.  fixed is 16.16 fixed point unless WG_REAL
+// is defined as WG_REAL_FLOAT for the whole build, then fixed is a float with
+// the same interface (see WgFloatx.h) and the renderers use the float entry
+// points of OpenGL ES.
+#define WG_REAL_FIXED	0
+#define WG_REAL_FLOAT	1
+#ifndef WG_REAL
+#define WG_REAL			WG_REAL_FIXED
+#endif
 
 //typedef int fixed;
 typedef unsigned int ufixed;
@@ -33,7 +50,9 @@ inline int xMul(int a, int b);
 inline int xDiv(int a, int b); 
 
 inline int FixedFromInt(int value);
+#if WG_REAL == WG_REAL_FIXED
 inline int FixedFromFloat(float value);
+#endif
 inline float FloatFromFixed(int value);
 inline int   IntFromFixed(int value);
 inline int   FractionFromFixed(int value);
@@ -50,10 +69,21 @@ static inline int xMax(int first, int second);
 
 WG3D_FOUNDATION_ITEM int Inverse(int value);
 WG3D_FOUNDATION_ITEM int InvSqrt(int value);
+// Table estimates that Inverse and InvSqrt refine with Newton-Raphson steps.
+// InverseEstimate expects a positive value.
+WG3D_FOUNDATION_ITEM int InverseEstimate(int value);
+WG3D_FOUNDATION_ITEM int InvSqrtEstimate(int value);
 inline int FastSqrt(int value);
 
 // Fixed class Mathematic Operation
-class fixed;
+template <int FRACBITS> class Fixed;
+#if WG_REAL == WG_REAL_FLOAT
+class Floatx;
+typedef Floatx fixed;
+inline fixed FixedFromFloat(float value);
+#else
+typedef Fixed<FIXED_PRECISION> fixed;		// 16.16
+#endif
 inline fixed xMul(fixed a, fixed b);
 inline fixed xDiv(fixed a, fixed b); 
 
@@ -77,53 +107,103 @@ WG3D_FOUNDATION_ITEM fixed InvSqrt(fixed value);
 inline fixed FastSqrt(fixed value);
 
 
-class fixed{
+// Fixed point number with FRACBITS fractional bits.  All the arithmetic is
+// done on integers; fixed (16.16) is the format used by the engine.
+template <int FRACBITS>
+class Fixed
+{
 public:
-	fixed()
+	enum
+	{
+		FRACTION_BITS = FRACBITS,
+		ONE = (1<<FRACBITS)
+	};
+
+	Fixed()
 	{
-		value=FIXED_ZERO;
+		value=0;
 	}
-	fixed(const int x)
+	Fixed(const int x)
 	{
 		value=x;
 	}
-	fixed(const fixed &rkF)
+	Fixed(const Fixed &rkF)
 	{
 		value=rkF.value;
 	}
-	inline fixed& operator =(const fixed &rkF)
+	inline Fixed& operator =(const Fixed &rkF)
 	{
 		value=rkF.value;
 		return *this;
 	}
-	inline fixed& operator =(const int val)
+	inline Fixed& operator =(const int val)
 	{
 		value=val;
 		return *this;
 	}
 
+	// Raw integer kernels.  The product and the quotient are formed in
+	// 64 bits so that no precision is lost before the final shift.  Both
+	// saturate to the largest or the smallest value on overflow, like
+	// FixedFromFloat does (a quotient by zero takes the sign of a).  The
+	// int kernels xMul and xDiv do not saturate.
+	static inline int Mul(int a, int b)
+	{
+		dfixed p = ((dfixed)a*(dfixed)b) >> FRACBITS;
+		if (p > (dfixed)0x7fffffff)
+			return 0x7fffffff;
+		if (p < -(dfixed)0x7fffffff-1)
+			return (int)0x80000000;
+		return (int)p;
+	}
+	static inline int Div(int a, int b)
+	{
+		if (b == 0)
+			return (a < 0) ? (int)0x80000000 : 0x7fffffff;
+		dfixed q = (((dfixed)a) << FRACBITS)/(dfixed)b;
+		if (q > (dfixed)0x7fffffff)
+			return 0x7fffffff;
+		if (q < -(dfixed)0x7fffffff-1)
+			return (int)0x80000000;
+		return (int)q;
+	}
+
+	// conversion
+	static inline Fixed FromInt(int val)
+	{
+		return Fixed(val*ONE);
+	}
+	static inline Fixed FromFloat(float val)
+	{
+		return Fixed((int)(val*(float)ONE));
+	}
+	inline float ToFloat() const
+	{
+		return (float)value*(1.0f/(float)ONE);
+	}
+
 	// comparison
-    bool operator== (const fixed& rkF) const
+    bool operator== (const Fixed& rkF) const
 	{
 		return value==rkF.value;
 	}
-    bool operator!= (const fixed& rkF) const
+    bool operator!= (const Fixed& rkF) const
 	{
 		return value!=rkF.value;
 	}
-    bool operator<  (const fixed& rkF) const
+    bool operator<  (const Fixed& rkF) const
 	{
 		return (value<rkF.value);
 	}
-    bool operator<= (const fixed& rkF) const
+    bool operator<= (const Fixed& rkF) const
 	{
 		return (value<=rkF.value);
 	}
-    bool operator>  (const fixed& rkF) const
+    bool operator>  (const Fixed& rkF) const
 	{
 		return (value>rkF.value);
 	}
-    bool operator>= (const fixed& rkF) const
+    bool operator>= (const Fixed& rkF) const
 	{
 		return (value>=rkF.value);
 	}
@@ -153,160 +233,149 @@ public:
 		return value>=val;
 	}
 
-	inline fixed operator+ (const fixed& rkF) const
+	inline Fixed operator+ (const Fixed& rkF) const
 	{
-		return fixed(value+rkF.value);
+		return Fixed(value+rkF.value);
 	}
-    inline fixed operator- (const fixed& rkF) const
+    inline Fixed operator- (const Fixed& rkF) const
 	{
-		return fixed(value-rkF.value);
+		return Fixed(value-rkF.value);
 	}
-    inline fixed operator* (const fixed& rkF) const
+    inline Fixed operator* (const Fixed& rkF) const
 	{
-		float val1=FloatFromFixed(value);
-		float val2=FloatFromFixed(rkF);
-		return fixed(FixedFromFloat(val1*val2));
+		return Fixed(Mul(value,rkF.value));
 	}
-    inline fixed operator/ (const fixed& rkF) const
+    inline Fixed operator/ (const Fixed& rkF) const
 	{
-		float val1=FloatFromFixed(value);
-		float val2=FloatFromFixed(rkF);
-		return fixed(FixedFromFloat(val1/val2));
+		return Fixed(Div(value,rkF.value));
 	}
 
-	inline fixed operator+ (const int val) const
+	inline Fixed operator+ (const int val) const
 	{
-		return fixed(value+val);
+		return Fixed(value+val);
 	}
-	inline fixed operator- (const int val) const
+	inline Fixed operator- (const int val) const
 	{
-		return fixed(value-val);
+		return Fixed(value-val);
 	}
-    inline fixed operator* (const int val) const
+    inline Fixed operator* (const int val) const
 	{
-		float val1=FloatFromFixed(value);
-		float val2=FloatFromFixed(val);
-		return fixed(FixedFromFloat(val1*val2));
+		return Fixed(Mul(value,val));
 	}
-    inline fixed operator/ (const int val) const
+    inline Fixed operator/ (const int val) const
 	{
-		float val1=FloatFromFixed(value);
-		float val2=FloatFromFixed(val);
-		return fixed(FixedFromFloat(val1/val2));
+		return Fixed(Div(value,val));
 	}
-    inline fixed operator- () const
+    inline Fixed operator- () const
 	{
-		float x=FloatFromFixed(value);
-		x*=-1.0f;
-		return fixed(FixedFromFloat(x));
+		return Fixed(-value);
 	}
-	inline fixed operator+ () const
+	inline Fixed operator+ () const
 	{
-		float x=FloatFromFixed(value);
-		x = +x;
-		return fixed(FixedFromFloat(x));
+		return *this;
 	}
 	
     // arithmetic updates
-    inline fixed& operator+= (const fixed& rkF)
+    inline Fixed& operator+= (const Fixed& rkF)
 	{
 		value+=rkF.value;
 		return *this;
 	}
-    inline fixed& operator-= (const fixed& rkF)
+    inline Fixed& operator-= (const Fixed& rkF)
 	{
 		value-=rkF.value;
 		return *this;
 	}
-    inline fixed& operator*= (const fixed& rkF)
+    inline Fixed& operator*= (const Fixed& rkF)
 	{
-		float val1=FloatFromFixed(value);
-		float val2=FloatFromFixed(rkF);
-		value=FixedFromFloat(val1*val2);
+		value=Mul(value,rkF.value);
 		return *this;
 	}
-    inline fixed& operator/= (const fixed& rkF)
+    inline Fixed& operator/= (const Fixed& rkF)
 	{
-		float val1=FloatFromFixed(value);
-		float val2=FloatFromFixed(rkF);
-		value= FixedFromFloat(val1/val2);
+		value=Div(value,rkF.value);
 		return *this;
 	}
 
-    inline fixed& operator+= (const int val)
+    inline Fixed& operator+= (const int val)
 	{
 		value+=val;
 		return *this;
 	}
-    inline fixed& operator-= (const int val)
+    inline Fixed& operator-= (const int val)
 	{
 		value-=val;
 		return *this;
 	}
-    inline fixed& operator*= (const int val)
+    inline Fixed& operator*= (const int val)
 	{
-		float val1=FloatFromFixed(value);
-		float val2=FloatFromFixed(val);
-		value=FixedFromFloat(val1*val2);
+		value=Mul(value,val);
 		return *this;
 	}
-    inline fixed& operator/= (const int val)
+    inline Fixed& operator/= (const int val)
 	{
-		float val1=FloatFromFixed(value);
-		float val2=FloatFromFixed(val);
-		value= FixedFromFloat(val1/val2);
+		value=Div(value,val);
 		return *this;
 	}
 	int value;
 };
 
 // Global Fixed Arithmetic Operator
-inline int operator *(const int &val,const fixed &val2)
+template <int FRACBITS>
+inline int operator *(const int &val,const Fixed<FRACBITS> &val2)
 {
-	float fval1=FloatFromFixed(val);
-	float fval2=FloatFromFixed(val2);
-	return FixedFromFloat(fval1*fval2);
+	return Fixed<FRACBITS>::Mul(val,val2.value);
 }
-inline int operator /(const int &val, const fixed &val2)
+template <int FRACBITS>
+inline int operator /(const int &val, const Fixed<FRACBITS> &val2)
 {
-	float fval1=FloatFromFixed(val);
-	float fval2=FloatFromFixed(val2);
-	return FixedFromFloat(fval1/fval2);
+	return Fixed<FRACBITS>::Div(val,val2.value);
 }
-inline int operator +(const int &val,const fixed &val2)
+template <int FRACBITS>
+inline int operator +(const int &val,const Fixed<FRACBITS> &val2)
 {
-	return val-val2.value;
+	return val+val2.value;
 }
-inline int operator -(const int &val, const fixed &val2)
+template <int FRACBITS>
+inline int operator -(const int &val, const Fixed<FRACBITS> &val2)
 {
 	return val-val2.value;
 }
 
 // Global Fixed Comparison Operator
-inline bool operator== (const int &val, const fixed &val2)
+template <int FRACBITS>
+inline bool operator== (const int &val, const Fixed<FRACBITS> &val2)
 {
 	return val==val2.value;
 }
-inline bool operator!= (const int &val, const fixed &val2)
+template <int FRACBITS>
+inline bool operator!= (const int &val, const Fixed<FRACBITS> &val2)
 {
 	return val!=val2.value;
 }
-inline bool operator<  (const int &val, const fixed &val2)
+template <int FRACBITS>
+inline bool operator<  (const int &val, const Fixed<FRACBITS> &val2)
 {
 	return val<val2.value;
 }
-inline bool operator<= (const int &val, const fixed &val2)
+template <int FRACBITS>
+inline bool operator<= (const int &val, const Fixed<FRACBITS> &val2)
 {
 	return val<=val2.value;
 }
-inline bool operator>  (const int &val, const fixed &val2)
+template <int FRACBITS>
+inline bool operator>  (const int &val, const Fixed<FRACBITS> &val2)
 {
 	return val>val2.value;
 }
-inline bool operator>= (const int &val, const fixed &val2)
+template <int FRACBITS>
+inline bool operator>= (const int &val, const Fixed<FRACBITS> &val2)
 {
 	return val>=val2.value;
 }
+#if WG_REAL == WG_REAL_FLOAT
+#include "WgFloatx.h"
+#endif
 #include "WgFixed.inl"
 }
 #endif
\ No newline at end of file
@@ -10,9 +10,10 @@
 ///////////////////////////////////////////////////////////
 inline int FixedFromInt(int value)
 {
-	return value << FIXED_PRECISION;
+	return value*FIXED_ONE;
 }
 
+#if WG_REAL == WG_REAL_FIXED
 inline int FixedFromFloat(float value)
 {
 	if (value >= 32767.5f)
@@ -22,6 +23,7 @@ inline int FixedFromFloat(float value)
 	else
 		return static_cast<int>(value * static_cast<float>(FIXED_ONE));
 }
+#endif
 inline float FloatFromFixed(int value)
 {
 	return static_cast<float>(static_cast<double>(value) * (1.0f/static_cast<float>(FIXED_ONE)));
@@ -73,6 +75,48 @@ inline int FastSqrt(int value)
 }
 
 
+#if WG_REAL == WG_REAL_FLOAT
+inline fixed FixedFromFloat(float value)
+{
+	return fixed::FromFloat(value);
+}
+inline float FloatFromFixed(fixed value)
+{
+	return value.value;
+}
+inline int   IntFromFixed(fixed value)
+{
+	return (int)floorf(value.value);
+}
+inline int FractionFromFixed(fixed value)
+{
+	return (int)((value.value - floorf(value.value))*(float)FIXED_ONE);
+}
+static inline fixed xabs(fixed value)
+{
+	return fixed::FromFloat(fabsf(value.value));
+}
+static inline fixed xMin(fixed first, fixed second)
+{
+	return first < second ? first : second;
+}
+static inline fixed xMax(fixed first, fixed second)
+{
+	return first > second ? first : second;
+}
+inline fixed xMul(fixed a, fixed b)
+{
+	return a*b;
+}
+inline fixed xDiv(fixed a, fixed b)
+{
+	return a/b;
+}
+inline fixed FastSqrt(fixed value)
+{
+	return fixed::FromFloat(value.value <= 0.0f ? 0.0f : sqrtf(value.value));
+}
+#else
 // inline fixed FixedFromInt(int value)
 // {
 // 	return fixed(FixedFromInt(value));
@@ -116,4 +160,5 @@ inline fixed xDiv(fixed a, fixed b)
 inline fixed FastSqrt(fixed value)
 {
 	return fixed(FastSqrt(value.value));
-}
\ No newline at end of file
+}
+#endif
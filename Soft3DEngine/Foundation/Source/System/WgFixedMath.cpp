@@ -0,0 +1,667 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgFixedMath.cpp                    //
+//                                                       //
+//  - Implementation for Fixed Transcendental functions  //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFixedMath.h"
+#include <float.h>
+namespace WGSoft3D
+{
+#if WG_REAL == WG_REAL_FLOAT
+// With the float backend every tier is the C library function.
+//----------------------------------------------------------------------------
+void sincosx(fixed fAngle, fixed& rfSin, fixed& rfCos, FixedPrecision)
+{
+	rfSin = fixed::FromFloat(sinf(fAngle.value));
+	rfCos = fixed::FromFloat(cosf(fAngle.value));
+}
+//----------------------------------------------------------------------------
+fixed sinx(fixed fAngle, FixedPrecision)
+{
+	return fixed::FromFloat(sinf(fAngle.value));
+}
+//----------------------------------------------------------------------------
+fixed cosx(fixed fAngle, FixedPrecision)
+{
+	return fixed::FromFloat(cosf(fAngle.value));
+}
+//----------------------------------------------------------------------------
+fixed atanx(fixed fValue, FixedPrecision)
+{
+	return fixed::FromFloat(atanf(fValue.value));
+}
+//----------------------------------------------------------------------------
+fixed atan2x(fixed fY, fixed fX, FixedPrecision)
+{
+	if (fY.value == 0.0f && fX.value == 0.0f)
+	{
+		return fixed(FIXED_ZERO);
+	}
+	return fixed::FromFloat(atan2f(fY.value,fX.value));
+}
+//----------------------------------------------------------------------------
+fixed asinx(fixed fValue, FixedPrecision)
+{
+	float fV = (fValue.value < -1.0f ? -1.0f :
+		(fValue.value > 1.0f ? 1.0f : fValue.value));
+	return fixed::FromFloat(asinf(fV));
+}
+//----------------------------------------------------------------------------
+fixed acosx(fixed fValue, FixedPrecision)
+{
+	float fV = (fValue.value < -1.0f ? -1.0f :
+		(fValue.value > 1.0f ? 1.0f : fValue.value));
+	return fixed::FromFloat(acosf(fV));
+}
+//----------------------------------------------------------------------------
+fixed expx(fixed fValue, FixedPrecision)
+{
+	return fixed::FromFloat(expf(fValue.value));
+}
+//----------------------------------------------------------------------------
+fixed logx(fixed fValue, FixedPrecision)
+{
+	if (fValue.value <= 0.0f)
+	{
+		return fixed::FromFloat(-FLT_MAX);
+	}
+	return fixed::FromFloat(logf(fValue.value));
+}
+//----------------------------------------------------------------------------
+fixed xsqrt(fixed fValue, FixedPrecision)
+{
+	return fixed::FromFloat(fValue.value <= 0.0f ? 0.0f : sqrtf(fValue.value));
+}
+//----------------------------------------------------------------------------
+fixed InvSqrt(fixed fValue, FixedPrecision)
+{
+	return fixed::FromFloat(1.0f/sqrtf(fValue.value));
+}
+//----------------------------------------------------------------------------
+fixed Inverse(fixed fValue, FixedPrecision)
+{
+	return fixed::FromFloat(1.0f/fValue.value);
+}
+//----------------------------------------------------------------------------
+#else
+// 2.30 constants used by the accurate tier
+#define FIXED30_ONE			((dfixed)1 << 30)
+#define FIXED30_HALF_PI		((dfixed)1686629713)
+#define FIXED30_QUARTER_PI	((dfixed)843314857)
+#define FIXED30_PI			((dfixed)3373259426u)
+#define FIXED30_TAN_PI_8	((dfixed)444758426)
+#define FIXED30_LN_2		((dfixed)744261118)
+#define FIXED30_LOG2_E		((dfixed)1549082005)
+
+// 65536/(2*pi) in 32.32, turns radians in 16.16 into a 32-bit phase
+// (the integer part 10430 and the fraction 0x60db9391)
+#define FIXED_PHASE_SCALE	(((unsigned __int64)10430 << 32) | 0x60db9391u)
+
+// The fast tier uses the 1024 entry quarter wave of the original sinx.
+static const unsigned short __gl_sin_tab[] = {
+#include "WgSinTable.h"
+};
+
+// The other tables have 257 samples on [0,1] of the argument plus a copy of
+// the last sample, so that interpolation at 1 needs no special case.
+
+// sin(x*pi/2)
+static const int gs_aiSin[258] =
+{
+    0, 402, 804, 1206, 1608, 2010, 2412, 2814,
+    3216, 3617, 4019, 4420, 4821, 5222, 5623, 6023,
+    6424, 6824, 7224, 7623, 8022, 8421, 8820, 9218,
+    9616, 10014, 10411, 10808, 11204, 11600, 11996, 12391,
+    12785, 13180, 13573, 13966, 14359, 14751, 15143, 15534,
+    15924, 16314, 16703, 17091, 17479, 17867, 18253, 18639,
+    19024, 19409, 19792, 20175, 20557, 20939, 21320, 21699,
+    22078, 22457, 22834, 23210, 23586, 23961, 24335, 24708,
+    25080, 25451, 25821, 26190, 26558, 26925, 27291, 27656,
+    28020, 28383, 28745, 29106, 29466, 29824, 30182, 30538,
+    30893, 31248, 31600, 31952, 32303, 32652, 33000, 33347,
+    33692, 34037, 34380, 34721, 35062, 35401, 35738, 36075,
+    36410, 36744, 37076, 37407, 37736, 38064, 38391, 38716,
+    39040, 39362, 39683, 40002, 40320, 40636, 40951, 41264,
+    41576, 41886, 42194, 42501, 42806, 43110, 43412, 43713,
+    44011, 44308, 44604, 44898, 45190, 45480, 45769, 46056,
+    46341, 46624, 46906, 47186, 47464, 47741, 48015, 48288,
+    48559, 48828, 49095, 49361, 49624, 49886, 50146, 50404,
+    50660, 50914, 51166, 51417, 51665, 51911, 52156, 52398,
+    52639, 52878, 53114, 53349, 53581, 53812, 54040, 54267,
+    54491, 54714, 54934, 55152, 55368, 55582, 55794, 56004,
+    56212, 56418, 56621, 56823, 57022, 57219, 57414, 57607,
+    57798, 57986, 58172, 58356, 58538, 58718, 58896, 59071,
+    59244, 59415, 59583, 59750, 59914, 60075, 60235, 60392,
+    60547, 60700, 60851, 60999, 61145, 61288, 61429, 61568,
+    61705, 61839, 61971, 62101, 62228, 62353, 62476, 62596,
+    62714, 62830, 62943, 63054, 63162, 63268, 63372, 63473,
+    63572, 63668, 63763, 63854, 63944, 64031, 64115, 64197,
+    64277, 64354, 64429, 64501, 64571, 64639, 64704, 64766,
+    64827, 64884, 64940, 64993, 65043, 65091, 65137, 65180,
+    65220, 65259, 65294, 65328, 65358, 65387, 65413, 65436,
+    65457, 65476, 65492, 65505, 65516, 65525, 65531, 65535,
+    65536, 65536
+};
+
+// atan(x)
+static const int gs_aiATan[258] =
+{
+    0, 256, 512, 768, 1024, 1280, 1536, 1792,
+    2047, 2303, 2559, 2814, 3070, 3325, 3580, 3836,
+    4091, 4346, 4600, 4855, 5110, 5364, 5618, 5872,
+    6126, 6380, 6633, 6887, 7140, 7392, 7645, 7898,
+    8150, 8402, 8653, 8905, 9156, 9407, 9657, 9908,
+    10158, 10408, 10657, 10906, 11155, 11403, 11652, 11899,
+    12147, 12394, 12641, 12887, 13133, 13379, 13624, 13869,
+    14114, 14358, 14601, 14845, 15088, 15330, 15572, 15814,
+    16055, 16296, 16536, 16776, 17015, 17254, 17492, 17730,
+    17968, 18205, 18441, 18677, 18913, 19148, 19382, 19616,
+    19850, 20083, 20315, 20547, 20779, 21009, 21240, 21469,
+    21699, 21927, 22156, 22383, 22610, 22836, 23062, 23288,
+    23512, 23737, 23960, 24183, 24406, 24627, 24849, 25069,
+    25289, 25509, 25727, 25946, 26163, 26380, 26597, 26813,
+    27028, 27242, 27456, 27670, 27882, 28094, 28306, 28517,
+    28727, 28936, 29145, 29354, 29561, 29768, 29975, 30180,
+    30386, 30590, 30794, 30997, 31200, 31402, 31603, 31803,
+    32003, 32203, 32401, 32600, 32797, 32994, 33190, 33385,
+    33580, 33774, 33968, 34160, 34353, 34544, 34735, 34925,
+    35115, 35304, 35492, 35680, 35867, 36053, 36239, 36424,
+    36608, 36792, 36975, 37158, 37340, 37521, 37701, 37881,
+    38060, 38239, 38417, 38594, 38771, 38947, 39123, 39297,
+    39472, 39645, 39818, 39990, 40162, 40333, 40503, 40673,
+    40842, 41010, 41178, 41346, 41512, 41678, 41844, 42008,
+    42172, 42336, 42499, 42661, 42823, 42984, 43145, 43304,
+    43464, 43622, 43780, 43938, 44095, 44251, 44407, 44562,
+    44716, 44870, 45024, 45176, 45328, 45480, 45631, 45781,
+    45931, 46080, 46229, 46377, 46525, 46672, 46818, 46964,
+    47109, 47254, 47398, 47542, 47685, 47827, 47969, 48111,
+    48251, 48392, 48531, 48671, 48809, 48947, 49085, 49222,
+    49359, 49495, 49630, 49765, 49899, 50033, 50167, 50299,
+    50432, 50563, 50695, 50826, 50956, 51086, 51215, 51344,
+    51472, 51472
+};
+
+// 2^x
+static const int gs_aiExp2[258] =
+{
+    65536, 65714, 65892, 66071, 66250, 66429, 66609, 66790,
+    66971, 67153, 67335, 67517, 67700, 67884, 68068, 68252,
+    68438, 68623, 68809, 68996, 69183, 69370, 69558, 69747,
+    69936, 70126, 70316, 70507, 70698, 70889, 71082, 71274,
+    71468, 71661, 71856, 72050, 72246, 72442, 72638, 72835,
+    73032, 73230, 73429, 73628, 73828, 74028, 74229, 74430,
+    74632, 74834, 75037, 75240, 75444, 75649, 75854, 76060,
+    76266, 76473, 76680, 76888, 77096, 77305, 77515, 77725,
+    77936, 78147, 78359, 78572, 78785, 78998, 79212, 79427,
+    79642, 79858, 80075, 80292, 80510, 80728, 80947, 81166,
+    81386, 81607, 81828, 82050, 82273, 82496, 82719, 82944,
+    83169, 83394, 83620, 83847, 84074, 84302, 84531, 84760,
+    84990, 85220, 85451, 85683, 85915, 86148, 86382, 86616,
+    86851, 87086, 87322, 87559, 87796, 88034, 88273, 88513,
+    88752, 88993, 89234, 89476, 89719, 89962, 90206, 90451,
+    90696, 90942, 91188, 91436, 91684, 91932, 92181, 92431,
+    92682, 92933, 93185, 93438, 93691, 93945, 94200, 94455,
+    94711, 94968, 95226, 95484, 95743, 96002, 96263, 96524,
+    96785, 97048, 97311, 97575, 97839, 98104, 98370, 98637,
+    98905, 99173, 99442, 99711, 99982, 100253, 100524, 100797,
+    101070, 101344, 101619, 101895, 102171, 102448, 102726, 103004,
+    103283, 103564, 103844, 104126, 104408, 104691, 104975, 105260,
+    105545, 105831, 106118, 106406, 106694, 106984, 107274, 107565,
+    107856, 108149, 108442, 108736, 109031, 109326, 109623, 109920,
+    110218, 110517, 110816, 111117, 111418, 111720, 112023, 112327,
+    112631, 112937, 113243, 113550, 113858, 114167, 114476, 114787,
+    115098, 115410, 115723, 116036, 116351, 116667, 116983, 117300,
+    117618, 117937, 118257, 118577, 118899, 119221, 119544, 119869,
+    120194, 120519, 120846, 121174, 121502, 121832, 122162, 122493,
+    122825, 123158, 123492, 123827, 124163, 124500, 124837, 125176,
+    125515, 125855, 126197, 126539, 126882, 127226, 127571, 127917,
+    128263, 128611, 128960, 129310, 129660, 130012, 130364, 130718,
+    131072, 131072
+};
+
+// log2(1+x)
+static const int gs_aiLog2[258] =
+{
+    0, 369, 736, 1102, 1466, 1829, 2190, 2551,
+    2909, 3267, 3623, 3978, 4331, 4683, 5034, 5384,
+    5732, 6079, 6425, 6769, 7112, 7454, 7795, 8134,
+    8473, 8810, 9146, 9480, 9814, 10146, 10477, 10807,
+    11136, 11464, 11791, 12116, 12440, 12764, 13086, 13407,
+    13727, 14046, 14363, 14680, 14996, 15310, 15624, 15937,
+    16248, 16559, 16868, 17177, 17484, 17791, 18096, 18401,
+    18704, 19007, 19308, 19609, 19909, 20207, 20505, 20802,
+    21098, 21393, 21687, 21980, 22272, 22564, 22854, 23144,
+    23433, 23720, 24007, 24293, 24579, 24863, 25146, 25429,
+    25711, 25992, 26272, 26551, 26830, 27108, 27384, 27660,
+    27936, 28210, 28484, 28757, 29029, 29300, 29571, 29840,
+    30109, 30378, 30645, 30912, 31178, 31443, 31707, 31971,
+    32234, 32496, 32758, 33019, 33279, 33538, 33797, 34055,
+    34312, 34569, 34825, 35080, 35334, 35588, 35841, 36094,
+    36346, 36597, 36847, 37097, 37346, 37595, 37842, 38090,
+    38336, 38582, 38827, 39072, 39316, 39559, 39802, 40044,
+    40286, 40527, 40767, 41006, 41246, 41484, 41722, 41959,
+    42196, 42432, 42667, 42902, 43137, 43370, 43603, 43836,
+    44068, 44300, 44530, 44761, 44990, 45220, 45448, 45676,
+    45904, 46131, 46357, 46583, 46809, 47034, 47258, 47482,
+    47705, 47928, 48150, 48372, 48593, 48813, 49034, 49253,
+    49472, 49691, 49909, 50127, 50344, 50560, 50776, 50992,
+    51207, 51422, 51636, 51850, 52063, 52276, 52488, 52700,
+    52911, 53122, 53332, 53542, 53751, 53960, 54169, 54377,
+    54584, 54791, 54998, 55204, 55410, 55615, 55820, 56025,
+    56229, 56432, 56635, 56838, 57040, 57242, 57443, 57644,
+    57845, 58045, 58245, 58444, 58643, 58841, 59039, 59237,
+    59434, 59631, 59827, 60023, 60219, 60414, 60609, 60803,
+    60997, 61190, 61384, 61576, 61769, 61961, 62152, 62343,
+    62534, 62725, 62915, 63104, 63294, 63483, 63671, 63859,
+    64047, 64234, 64421, 64608, 64794, 64980, 65166, 65351,
+    65536, 65536
+};
+
+//----------------------------------------------------------------------------
+static inline int RoundFixed30 (dfixed llValue)
+{
+	// 2.30 to 16.16, rounded to nearest
+	return (int)((llValue + (1 << 13)) >> 14);
+}
+//----------------------------------------------------------------------------
+static inline int Interpolate (const int* aiTable, ufixed uiX)
+{
+	// uiX is the table argument in 8.16, the table holds 16.16 values
+	int i = (int)(uiX >> 8);
+	int iFrac = (int)(uiX & 0xff);
+	return aiTable[i] + (((aiTable[i+1] - aiTable[i])*iFrac + 0x80) >> 8);
+}
+//----------------------------------------------------------------------------
+static unsigned int SqrtU64 (unsigned __int64 ullValue)
+{
+	// square root rounded to nearest, one result bit per iteration
+	unsigned __int64 ullRoot = 0;
+	unsigned __int64 ullBit = (unsigned __int64)1 << 62;
+	while (ullBit > ullValue)
+	{
+		ullBit >>= 2;
+	}
+	while (ullBit != 0)
+	{
+		if (ullValue >= ullRoot + ullBit)
+		{
+			ullValue -= ullRoot + ullBit;
+			ullRoot = (ullRoot >> 1) + ullBit;
+		}
+		else
+		{
+			ullRoot >>= 1;
+		}
+		ullBit >>= 2;
+	}
+	if (ullValue > ullRoot)
+	{
+		ullRoot++;
+	}
+	return (unsigned int)ullRoot;
+}
+//----------------------------------------------------------------------------
+static inline ufixed ToPhase (int iAngle)
+{
+	// Radians to a phase where 2^32 is a full turn, rounded to nearest.
+	// The product overflows 64 bits for large angles, but only its bits
+	// 32 to 63 are the phase and those are exact in unsigned arithmetic.
+	// The truncation to 32 bits is the range reduction.
+	unsigned __int64 ullPhase =
+		(unsigned __int64)(dfixed)iAngle*FIXED_PHASE_SCALE;
+	return (ufixed)((ullPhase + 0x80000000u) >> 32);
+}
+//----------------------------------------------------------------------------
+static void SinCosQuarter (ufixed uiPos, FixedPrecision ePrecision,
+	int& riSin, int& riCos)
+{
+	// sin and cos of uiPos/2^30*pi/2 for uiPos in [0,2^30)
+	if (ePrecision == FIXED_FAST)
+	{
+		int i = (int)(uiPos >> 20);
+		riSin = __gl_sin_tab[i];
+		riCos = __gl_sin_tab[0x3ff - i];
+	}
+	else if (ePrecision == FIXED_NORMAL)
+	{
+		riSin = Interpolate(gs_aiSin,uiPos >> 14);
+		riCos = Interpolate(gs_aiSin,((ufixed)1 << 16) - (uiPos >> 14));
+	}
+	else
+	{
+		// Taylor series through x^11 and x^12, the truncation error is
+		// below 1e-7 on [0,pi/2]
+		dfixed x = ((dfixed)uiPos*FIXED30_HALF_PI) >> 30;
+		dfixed x2 = (x*x) >> 30;
+
+		dfixed s = FIXED30_ONE - x2/110;
+		s = FIXED30_ONE - ((x2*s) >> 30)/72;
+		s = FIXED30_ONE - ((x2*s) >> 30)/42;
+		s = FIXED30_ONE - ((x2*s) >> 30)/20;
+		s = FIXED30_ONE - ((x2*s) >> 30)/6;
+		riSin = RoundFixed30((x*s) >> 30);
+
+		dfixed c = FIXED30_ONE - x2/132;
+		c = FIXED30_ONE - ((x2*c) >> 30)/90;
+		c = FIXED30_ONE - ((x2*c) >> 30)/56;
+		c = FIXED30_ONE - ((x2*c) >> 30)/30;
+		c = FIXED30_ONE - ((x2*c) >> 30)/12;
+		c = FIXED30_ONE - ((x2*c) >> 30)/2;
+		riCos = RoundFixed30(c);
+	}
+}
+//----------------------------------------------------------------------------
+void sincosx(fixed fAngle, fixed& rfSin, fixed& rfCos,
+	FixedPrecision ePrecision)
+{
+	ufixed uiPhase = ToPhase(fAngle.value);
+	int iS, iC;
+	SinCosQuarter(uiPhase & 0x3fffffff,ePrecision,iS,iC);
+
+	// rotate by the quadrant
+	switch (uiPhase >> 30)
+	{
+	case 0:  rfSin =  iS;  rfCos =  iC;  break;
+	case 1:  rfSin =  iC;  rfCos = -iS;  break;
+	case 2:  rfSin = -iS;  rfCos = -iC;  break;
+	default: rfSin = -iC;  rfCos =  iS;  break;
+	}
+}
+//----------------------------------------------------------------------------
+fixed sinx(fixed fAngle, FixedPrecision ePrecision)
+{
+	fixed fSin, fCos;
+	sincosx(fAngle,fSin,fCos,ePrecision);
+	return fSin;
+}
+//----------------------------------------------------------------------------
+fixed cosx(fixed fAngle, FixedPrecision ePrecision)
+{
+	fixed fSin, fCos;
+	sincosx(fAngle,fSin,fCos,ePrecision);
+	return fCos;
+}
+//----------------------------------------------------------------------------
+static dfixed ATanUnit (ufixed uiNum, ufixed uiDen,
+	FixedPrecision ePrecision)
+{
+	// atan(uiNum/uiDen) in 2.30 for 0 <= uiNum <= uiDen, uiDen > 0.  The
+	// fast tier is the normal tier.  The quotient is needed either way and
+	// a nearest entry saves only the interpolation, less than the time
+	// that the reciprocal of xDiv or of a Newton-Raphson estimate takes.
+	if (ePrecision != FIXED_ACCURATE)
+	{
+		ufixed uiZ = (ufixed)(((unsigned __int64)uiNum << 16)/uiDen);
+		return (dfixed)Interpolate(gs_aiATan,uiZ) << 14;
+	}
+
+	// atan(z) = pi/4 + atan((z-1)/(z+1)) moves z above tan(pi/8) into
+	// [-tan(pi/8),tan(pi/8)], where the series through t^17 is below 2e-8.
+	dfixed z = (dfixed)(((unsigned __int64)uiNum << 30)/uiDen);
+	dfixed llBase = 0;
+	if (z > FIXED30_TAN_PI_8)
+	{
+		z = (z - FIXED30_ONE)*FIXED30_ONE/(z + FIXED30_ONE);
+		llBase = FIXED30_QUARTER_PI;
+	}
+
+	dfixed z2 = (z*z) >> 30;
+	dfixed s = FIXED30_ONE/17;
+	for (int iDen = 15; iDen >= 1; iDen -= 2)
+	{
+		s = FIXED30_ONE/iDen - ((z2*s) >> 30);
+	}
+	return llBase + ((z*s) >> 30);
+}
+//----------------------------------------------------------------------------
+fixed atan2x(fixed fY, fixed fX, FixedPrecision ePrecision)
+{
+	ufixed uiY = (ufixed)xabs(fY.value);
+	ufixed uiX = (ufixed)xabs(fX.value);
+	if (uiX == 0 && uiY == 0)
+	{
+		return fixed(FIXED_ZERO);
+	}
+
+	// reduce to the first octant
+	dfixed llAngle;
+	if (uiY <= uiX)
+	{
+		llAngle = ATanUnit(uiY,uiX,ePrecision);
+	}
+	else
+	{
+		llAngle = FIXED30_HALF_PI - ATanUnit(uiX,uiY,ePrecision);
+	}
+
+	if (fX.value < 0)
+	{
+		llAngle = FIXED30_PI - llAngle;
+	}
+	if (fY.value < 0)
+	{
+		llAngle = -llAngle;
+	}
+	return fixed(RoundFixed30(llAngle));
+}
+//----------------------------------------------------------------------------
+fixed atanx(fixed fValue, FixedPrecision ePrecision)
+{
+	return atan2x(fValue,fixed(FIXED_ONE),ePrecision);
+}
+//----------------------------------------------------------------------------
+static fixed CoSine (fixed fValue, FixedPrecision ePrecision)
+{
+	// sqrt(1-v^2) for |v| < 1
+	if (ePrecision == FIXED_ACCURATE)
+	{
+		unsigned __int64 ullOne = (unsigned __int64)1 << 32;
+		unsigned __int64 ullSqr =
+			(unsigned __int64)((dfixed)fValue.value*fValue.value);
+		return fixed((int)SqrtU64(ullOne - ullSqr));
+	}
+	return xsqrt(fixed(FIXED_ONE - xMul(fValue.value,fValue.value)),
+		ePrecision);
+}
+//----------------------------------------------------------------------------
+fixed asinx(fixed fValue, FixedPrecision ePrecision)
+{
+	if (fValue >= FIXED_ONE)
+	{
+		return fixed(RoundFixed30(FIXED30_HALF_PI));
+	}
+	if (fValue <= FIXED_NEG_ONE)
+	{
+		return fixed(-RoundFixed30(FIXED30_HALF_PI));
+	}
+	return atan2x(fValue,CoSine(fValue,ePrecision),ePrecision);
+}
+//----------------------------------------------------------------------------
+fixed acosx(fixed fValue, FixedPrecision ePrecision)
+{
+	if (fValue >= FIXED_ONE)
+	{
+		return fixed(FIXED_ZERO);
+	}
+	if (fValue <= FIXED_NEG_ONE)
+	{
+		return fixed(RoundFixed30(FIXED30_PI));
+	}
+	return atan2x(CoSine(fValue,ePrecision),fValue,ePrecision);
+}
+//----------------------------------------------------------------------------
+fixed expx(fixed fValue, FixedPrecision ePrecision)
+{
+	// e^x = 2^k * 2^f with k an integer and f in [0,1)
+	dfixed y = ((dfixed)fValue.value*FIXED30_LOG2_E) >> 16;
+	int k = (int)(y >> 30);
+	ufixed uiF = (ufixed)(y & (FIXED30_ONE - 1));
+
+	if (k >= 15)
+	{
+		return fixed(0x7fffffff);
+	}
+	int iShift = 14 - k;
+	if (iShift >= 62)
+	{
+		return fixed(FIXED_ZERO);
+	}
+
+	dfixed llPow;
+	if (ePrecision == FIXED_FAST)
+	{
+		llPow = (dfixed)gs_aiExp2[(uiF + (1 << 21)) >> 22] << 14;
+	}
+	else if (ePrecision == FIXED_NORMAL)
+	{
+		llPow = (dfixed)Interpolate(gs_aiExp2,uiF >> 14) << 14;
+	}
+	else
+	{
+		// e^u for u = f*ln(2) in [0,ln(2)), series through u^10
+		dfixed u = ((dfixed)uiF*FIXED30_LN_2) >> 30;
+		llPow = FIXED30_ONE;
+		for (int iDen = 10; iDen >= 1; iDen--)
+		{
+			llPow = FIXED30_ONE + ((u*llPow) >> 30)/iDen;
+		}
+	}
+
+	dfixed llResult = (iShift > 0 ?
+		(llPow + ((dfixed)1 << (iShift - 1))) >> iShift : llPow);
+	if (llResult > 0x7fffffff)
+	{
+		return fixed(0x7fffffff);
+	}
+	return fixed((int)llResult);
+}
+//----------------------------------------------------------------------------
+fixed logx(fixed fValue, FixedPrecision ePrecision)
+{
+	if (fValue.value <= 0)
+	{
+		return fixed((int)0x80000000);
+	}
+
+	// value = m * 2^k with m in [1,2) stored in 2.30
+	int iBit = 31 - (int)CountLeadingZeros((ufixed)fValue.value);
+	dfixed m = (iBit >= 30 ? (dfixed)(fValue.value >> (iBit - 30)) :
+		(dfixed)fValue.value << (30 - iBit));
+	int k = iBit - FIXED_PRECISION;
+
+	dfixed llLog;
+	if (ePrecision == FIXED_ACCURATE)
+	{
+		// ln(m) = 2*atanh(t), t = (m-1)/(m+1) in [0,1/3), series through
+		// t^11
+		dfixed t = ((m - FIXED30_ONE) << 30)/(m + FIXED30_ONE);
+		dfixed t2 = (t*t) >> 30;
+		dfixed s = FIXED30_ONE/13;
+		for (int iDen = 11; iDen >= 1; iDen -= 2)
+		{
+			s = FIXED30_ONE/iDen + ((t2*s) >> 30);
+		}
+		llLog = ((2*t*s) >> 30) + k*FIXED30_LN_2;
+	}
+	else
+	{
+		ufixed uiF = (ufixed)(m - FIXED30_ONE);
+		dfixed llLog2;
+		if (ePrecision == FIXED_FAST)
+		{
+			llLog2 = gs_aiLog2[(uiF + (1 << 21)) >> 22];
+		}
+		else
+		{
+			llLog2 = Interpolate(gs_aiLog2,uiF >> 14);
+		}
+		llLog2 += (dfixed)k*65536;
+		llLog = (llLog2*FIXED30_LN_2) >> 16;
+	}
+	return fixed(RoundFixed30(llLog));
+}
+//----------------------------------------------------------------------------
+fixed xsqrt(fixed fValue, FixedPrecision ePrecision)
+{
+	int iValue = fValue.value;
+	if (iValue <= 0)
+	{
+		return fixed(FIXED_ZERO);
+	}
+
+	switch (ePrecision)
+	{
+	case FIXED_FAST:
+		return fixed(xMul(iValue,InvSqrt(fValue,FIXED_FAST).value));
+	case FIXED_NORMAL:
+	{
+		// x/sqrt(x) loses bits when 1/sqrt(x) is small, one Heron step
+		// recovers them
+		int iRoot = xMul(iValue,InvSqrt(iValue));
+		if (iRoot <= 0)
+		{
+			iRoot = 1;
+		}
+		dfixed llQuotient = ((dfixed)iValue << 16)/iRoot;
+		return fixed((int)((iRoot + llQuotient) >> 1));
+	}
+	default:
+		return fixed((int)SqrtU64((unsigned __int64)iValue << 16));
+	}
+}
+//----------------------------------------------------------------------------
+fixed InvSqrt(fixed fValue, FixedPrecision ePrecision)
+{
+	int iValue = fValue.value;
+	if (ePrecision == FIXED_NORMAL || iValue <= 0)
+	{
+		return fixed(InvSqrt(iValue));
+	}
+
+	if (ePrecision == FIXED_FAST)
+	{
+		if (iValue == FIXED_ONE)
+		{
+			return fValue;
+		}
+		int x = InvSqrtEstimate(iValue);
+		return fixed(xMul((x>>1),(FIXED_ONE*3 - xMul(xMul(iValue,x),x))));
+	}
+
+	// 2^40/sqrt(v*2^32) is 1/sqrt(v) in 16.16
+	unsigned int uiRoot = SqrtU64((unsigned __int64)iValue << 32);
+	unsigned __int64 ullInv =
+		(((unsigned __int64)1 << 40) + (uiRoot >> 1))/uiRoot;
+	return fixed(ullInv > 0x7fffffff ? 0x7fffffff : (int)ullInv);
+}
+//----------------------------------------------------------------------------
+fixed Inverse(fixed fValue, FixedPrecision ePrecision)
+{
+	int iValue = fValue.value;
+	if (ePrecision == FIXED_NORMAL || iValue == FIXED_ZERO)
+	{
+		return fixed(Inverse(iValue));
+	}
+
+	bool bNegative = (iValue < 0);
+	ufixed uiAbs = (ufixed)xabs(iValue);
+	int x;
+	if (ePrecision == FIXED_FAST)
+	{
+		x = InverseEstimate((int)uiAbs);
+		x = xMul(x,(FIXED_ONE*2 - xMul((int)uiAbs,x)));
+	}
+	else
+	{
+		unsigned __int64 ullInv =
+			(((unsigned __int64)1 << 32) + (uiAbs >> 1))/uiAbs;
+		x = (ullInv > 0x7fffffff ? 0x7fffffff : (int)ullInv);
+	}
+	return fixed(bNegative ? -x : x);
+}
+//----------------------------------------------------------------------------
+#endif
+}
@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgFixedMath.h                      //
+//                                                       //
+//  - Interface for Fixed Transcendental functions       //
+//                                                       //
+///////////////////////////////////////////////////////////
+#include "WgFoundationLIB.h"
+#include "WgFixed.h"
+
+#ifndef __WG3D_FIXEDMATH_H__
+#define __WG3D_FIXEDMATH_H__
+namespace WGSoft3D
+{
+
+// Integer only transcendental functions in three precision tiers.
+//
+//   FIXED_FAST     - nearest table entry (Inverse, InvSqrt and xsqrt use
+//                    the table estimate and one Newton-Raphson step).  atan
+//                    and atan2 need a quotient in every tier, their fast
+//                    tier is the normal tier.  asin and acos use the fast
+//                    xsqrt and the normal atan2.
+//   FIXED_NORMAL   - linear interpolation of the table (Inverse and
+//                    InvSqrt are the default scalar routines, xsqrt adds a
+//                    Heron step to x*InvSqrt(x))
+//   FIXED_ACCURATE - polynomial or exact integer evaluation in 2.30 with a
+//                    single rounding to 16.16
+//
+// Angles are reduced by one 64-bit multiply to a 32-bit phase, which wraps
+// at 2*pi, so any input angle is valid and no loop or branch is needed.
+// Maximum errors in 16.16 ulp (1/65536) and median times in ns/call of
+// three runs of WgMathBench on an x86-64 host, which sweeps each domain
+// and times each tier.  For exp, xsqrt, InvSqrt and Inverse the error is
+// relative to the result when the result is above 1.
+//
+//                                      error in ulp           ns/call
+//                                   fast normal   acc.    fast normal   acc.
+//   sin, cos    any x                101    2.5    0.5       7      9     28
+//   atan        any x                2.2    2.2    0.5      12     12     37
+//   atan2       any x, y             2.2    2.2    0.5       7     10     39
+//   asin, acos  |x| <= 0.99          184    3.3    1.0      28     40     73
+//               0.99 < |x| <= 1       49    5.4    1.0      29     40     59
+//   exp         -12 <= x <= 10.39     89    1.5    0.5       6      8     44
+//   log         x > 0                128    2.0    0.5       9     10     29
+//   xsqrt       x > 0                590    1.0    0.5      10     18     62
+//   InvSqrt     x > 0                369     53    0.5       8     15     72
+//   Inverse     x >= 3/65536        1024     16    0.5      10     11      6
+//
+// The accurate Inverse is a single 64-bit division, which is the fastest
+// tier on a processor that divides in hardware.  The fast and the normal
+// tier do not divide, for the processors that do not.
+//
+// The sinx(fixed) and cosx(fixed) of WgFixed.h are the fast tier.  With the
+// float backend (WG_REAL_FLOAT) all the tiers are the C library functions.
+
+enum FixedPrecision
+{
+    FIXED_FAST,
+    FIXED_NORMAL,
+    FIXED_ACCURATE
+};
+
+WG3D_FOUNDATION_ITEM fixed sinx(fixed fAngle, FixedPrecision ePrecision);
+WG3D_FOUNDATION_ITEM fixed cosx(fixed fAngle, FixedPrecision ePrecision);
+WG3D_FOUNDATION_ITEM void sincosx(fixed fAngle, fixed& rfSin, fixed& rfCos,
+	FixedPrecision ePrecision = FIXED_NORMAL);
+
+// atan2x(0,0) is 0.  asinx and acosx clamp their input to [-1,1].
+WG3D_FOUNDATION_ITEM fixed atanx(fixed fValue,
+	FixedPrecision ePrecision = FIXED_NORMAL);
+WG3D_FOUNDATION_ITEM fixed atan2x(fixed fY, fixed fX,
+	FixedPrecision ePrecision = FIXED_NORMAL);
+WG3D_FOUNDATION_ITEM fixed asinx(fixed fValue,
+	FixedPrecision ePrecision = FIXED_NORMAL);
+WG3D_FOUNDATION_ITEM fixed acosx(fixed fValue,
+	FixedPrecision ePrecision = FIXED_NORMAL);
+
+// expx saturates to the largest fixed value.  logx of a value that is not
+// positive returns the smallest fixed value.
+WG3D_FOUNDATION_ITEM fixed expx(fixed fValue,
+	FixedPrecision ePrecision = FIXED_NORMAL);
+WG3D_FOUNDATION_ITEM fixed logx(fixed fValue,
+	FixedPrecision ePrecision = FIXED_NORMAL);
+
+// xsqrt of a value that is not positive is 0.  InvSqrt(0) and Inverse(0)
+// return the largest fixed value.
+WG3D_FOUNDATION_ITEM fixed xsqrt(fixed fValue, FixedPrecision ePrecision);
+WG3D_FOUNDATION_ITEM fixed InvSqrt(fixed fValue, FixedPrecision ePrecision);
+WG3D_FOUNDATION_ITEM fixed Inverse(fixed fValue, FixedPrecision ePrecision);
+
+}
+#endif
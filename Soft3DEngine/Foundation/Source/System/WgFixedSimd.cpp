@@ -0,0 +1,1196 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgFixedSimd.cpp                    //
+//                                                       //
+//  - Implementation for Fixed SIMD kernel class         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgFixedSimd.h"
+#include "WgMatrix3.h"
+#include "WgPlane3.h"
+#include "WgVector3.h"
+using namespace WGSoft3D;
+
+// The vector paths need SSE4.1 (VC 9.0) and AVX2 (VC 11.0) intrinsics.  Gcc
+// compiles them per function through the target attribute, so the rest of
+// the library does not have to be built for those instruction sets.
+#if !defined(WG3D_FIXEDSIMD_SCALAR_ONLY) && !defined(_WIN32_WCE)
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#if _MSC_VER >= 1500
+#define WG3D_FIXEDSIMD_SSE41
+#endif
+#if _MSC_VER >= 1700
+#define WG3D_FIXEDSIMD_AVX2
+#endif
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)
+#define WG3D_FIXEDSIMD_SSE41
+#define WG3D_FIXEDSIMD_AVX2
+#endif
+#endif
+#endif
+
+#if defined(WG3D_FIXEDSIMD_SSE41) || defined(WG3D_FIXEDSIMD_AVX2)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(WG3D_FIXEDSIMD_SSE41)
+#include <smmintrin.h>
+#endif
+
+#if defined(WG3D_FIXEDSIMD_AVX2)
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__)
+#define WG3D_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define WG3D_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define WG3D_TARGET_SSE41
+#define WG3D_TARGET_AVX2
+#endif
+
+FixedSimd::Path FixedSimd::ms_ePath = FixedSimd::FS_SCALAR;
+bool FixedSimd::ms_bInitialized = false;
+
+// Number of lanes the kernels stage on the stack between primitives.
+#define WG3D_FIXEDSIMD_CHUNK 64
+
+//----------------------------------------------------------------------------
+// lane primitives, scalar
+//----------------------------------------------------------------------------
+static void MulLanes (int iQuantity, const int* aiA, const int* aiB,
+    int* aiR)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        aiR[i] = xMul(aiA[i],aiB[i]);
+    }
+}
+//----------------------------------------------------------------------------
+static void ScaleLanes (int iQuantity, const int* aiA, int iScale, int* aiR)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        aiR[i] = xMul(iScale,aiA[i]);
+    }
+}
+//----------------------------------------------------------------------------
+static void Dot3Lanes (int iQuantity, const int* aiAX, const int* aiAY,
+    const int* aiAZ, const int* aiBX, const int* aiBY, const int* aiBZ,
+    int* aiR)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        aiR[i] = xMul(aiAX[i],aiBX[i]) + xMul(aiAY[i],aiBY[i]) +
+            xMul(aiAZ[i],aiBZ[i]);
+    }
+}
+//----------------------------------------------------------------------------
+static void MulSubLanes (int iQuantity, const int* aiA, const int* aiB,
+    const int* aiC, const int* aiD, int* aiR)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        aiR[i] = xMul(aiA[i],aiB[i]) - xMul(aiC[i],aiD[i]);
+    }
+}
+//----------------------------------------------------------------------------
+static void AffineLanes (int iQuantity, const int* aiRow, const int* aiX,
+    const int* aiY, const int* aiZ, int* aiR)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        aiR[i] = xMul(aiRow[0],aiX[i]) + xMul(aiRow[1],aiY[i]) +
+            xMul(aiRow[2],aiZ[i]) + aiRow[3];
+    }
+}
+//----------------------------------------------------------------------------
+static void SphereSideLanes (int iQuantity, const int* aiRow, const int* aiX,
+    const int* aiY, const int* aiZ, const int* aiRadius, int* aiSide)
+{
+    // the distance of Plane3x::DistanceTo and the test of
+    // SphereBV::WhichSide
+    for (int i = 0; i < iQuantity; i++)
+    {
+        int iDistance = xMul(aiRow[0],aiX[i]) + xMul(aiRow[1],aiY[i]) +
+            xMul(aiRow[2],aiZ[i]) + aiRow[3];
+        aiSide[i] = (iDistance <= -aiRadius[i] ? -1 :
+            (iDistance >= aiRadius[i] ? +1 : 0));
+    }
+}
+//----------------------------------------------------------------------------
+static void InverseNewtonLanes (int iQuantity, const int* aiV, int* aiX)
+{
+    // the two Newton-Raphson steps of Inverse, x = x(2-ax)
+    for (int i = 0; i < iQuantity; i++)
+    {
+        int x = aiX[i];
+        x = xMul(x,(FIXED_ONE*2 - xMul(aiV[i],x)));
+        x = xMul(x,(FIXED_ONE*2 - xMul(aiV[i],x)));
+        aiX[i] = x;
+    }
+}
+//----------------------------------------------------------------------------
+static void InvSqrtNewtonLanes (int iQuantity, const int* aiV, int* aiX)
+{
+    // the three Newton-Raphson steps of InvSqrt, x = x(3-ax^2)/2
+    for (int i = 0; i < iQuantity; i++)
+    {
+        int x = aiX[i];
+        for (int j = 0; j < 3; j++)
+        {
+            x = xMul((x>>1),(FIXED_ONE*3 - xMul(xMul(aiV[i],x),x)));
+        }
+        aiX[i] = x;
+    }
+}
+
+#if defined(WG3D_FIXEDSIMD_SSE41)
+//----------------------------------------------------------------------------
+// lane primitives, SSE4.1
+//----------------------------------------------------------------------------
+WG3D_TARGET_SSE41
+static inline __m128i MulSse41 (__m128i kA, __m128i kB)
+{
+    // The 64-bit products of lanes 0,2 and of lanes 1,3.  Bits 16 to 47 of
+    // a product are the same whether it is shifted logically or
+    // arithmetically, so the result matches xMul exactly.
+    __m128i kEven = _mm_srli_epi64(_mm_mul_epi32(kA,kB),FIXED_PRECISION);
+    __m128i kOdd = _mm_mul_epi32(_mm_srli_epi64(kA,32),
+        _mm_srli_epi64(kB,32));
+    kOdd = _mm_slli_epi64(kOdd,32-FIXED_PRECISION);
+    return _mm_blend_epi16(kEven,kOdd,0xCC);
+}
+//----------------------------------------------------------------------------
+#define WG3D_LOAD128(aiA,i) _mm_loadu_si128((const __m128i*)((aiA)+(i)))
+#define WG3D_STORE128(aiA,i,kV) _mm_storeu_si128((__m128i*)((aiA)+(i)),kV)
+//----------------------------------------------------------------------------
+WG3D_TARGET_SSE41
+static void MulLanesSse41 (int iQuantity, const int* aiA, const int* aiB,
+    int* aiR)
+{
+    int i;
+    for (i = 0; i+4 <= iQuantity; i += 4)
+    {
+        WG3D_STORE128(aiR,i,MulSse41(WG3D_LOAD128(aiA,i),
+            WG3D_LOAD128(aiB,i)));
+    }
+    MulLanes(iQuantity-i,aiA+i,aiB+i,aiR+i);
+}
+//----------------------------------------------------------------------------
+WG3D_TARGET_SSE41
+static void ScaleLanesSse41 (int iQuantity, const int* aiA, int iScale,
+    int* aiR)
+{
+    __m128i kScale = _mm_set1_epi32(iScale);
+    int i;
+    for (i = 0; i+4 <= iQuantity; i += 4)
+    {
+        WG3D_STORE128(aiR,i,MulSse41(kScale,WG3D_LOAD128(aiA,i)));
+    }
+    ScaleLanes(iQuantity-i,aiA+i,iScale,aiR+i);
+}
+//----------------------------------------------------------------------------
+WG3D_TARGET_SSE41
+static void Dot3LanesSse41 (int iQuantity, const int* aiAX, const int* aiAY,
+    const int* aiAZ, const int* aiBX, const int* aiBY, const int* aiBZ,
+    int* aiR)
+{
+    int i;
+    for (i = 0; i+4 <= iQuantity; i += 4)
+    {
+        __m128i kR = MulSse41(WG3D_LOAD128(aiAX,i),WG3D_LOAD128(aiBX,i));
+        kR = _mm_add_epi32(kR,MulSse41(WG3D_LOAD128(aiAY,i),
+            WG3D_LOAD128(aiBY,i)));
+        kR = _mm_add_epi32(kR,MulSse41(WG3D_LOAD128(aiAZ,i),
+            WG3D_LOAD128(aiBZ,i)));
+        WG3D_STORE128(aiR,i,kR);
+    }
+    Dot3Lanes(iQuantity-i,aiAX+i,aiAY+i,aiAZ+i,aiBX+i,aiBY+i,aiBZ+i,aiR+i);
+}
+//----------------------------------------------------------------------------
+WG3D_TARGET_SSE41
+static void MulSubLanesSse41 (int iQuantity, const int* aiA, const int* aiB,
+    const int* aiC, const int* aiD, int* aiR)
+{
+    int i;
+    for (i = 0; i+4 <= iQuantity; i += 4)
+    {
+        __m128i kAB = MulSse41(WG3D_LOAD128(aiA,i),WG3D_LOAD128(aiB,i));
+        __m128i kCD = MulSse41(WG3D_LOAD128(aiC,i),WG3D_LOAD128(aiD,i));
+        WG3D_STORE128(aiR,i,_mm_sub_epi32(kAB,kCD));
+    }
+    MulSubLanes(iQuantity-i,aiA+i,aiB+i,aiC+i,aiD+i,aiR+i);
+}
+//----------------------------------------------------------------------------
+WG3D_TARGET_SSE41
+static void AffineLanesSse41 (int iQuantity, const int* aiRow,
+    const int* aiX, const int* aiY, const int* aiZ, int* aiR)
+{
+    __m128i kR0 = _mm_set1_epi32(aiRow[0]);
+    __m128i kR1 = _mm_set1_epi32(aiRow[1]);
+    __m128i kR2 = _mm_set1_epi32(aiRow[2]);
+    __m128i kR3 = _mm_set1_epi32(aiRow[3]);
+    int i;
+    for (i = 0; i+4 <= iQuantity; i += 4)
+    {
+        __m128i kR = MulSse41(kR0,WG3D_LOAD128(aiX,i));
+        kR = _mm_add_epi32(kR,MulSse41(kR1,WG3D_LOAD128(aiY,i)));
+        kR = _mm_add_epi32(kR,MulSse41(kR2,WG3D_LOAD128(aiZ,i)));
+        WG3D_STORE128(aiR,i,_mm_add_epi32(kR,kR3));
+    }
+    AffineLanes(iQuantity-i,aiRow,aiX+i,aiY+i,aiZ+i,aiR+i);
+}
+//----------------------------------------------------------------------------
+WG3D_TARGET_SSE41
+static void SphereSideLanesSse41 (int iQuantity, const int* aiRow,
+    const int* aiX, const int* aiY, const int* aiZ, const int* aiRadius,
+    int* aiSide)
+{
+    __m128i kR0 = _mm_set1_epi32(aiRow[0]);
+    __m128i kR1 = _mm_set1_epi32(aiRow[1]);
+    __m128i kR2 = _mm_set1_epi32(aiRow[2]);
+    __m128i kR3 = _mm_set1_epi32(aiRow[3]);
+    __m128i kZero = _mm_setzero_si128();
+    __m128i kOne = _mm_set1_epi32(1);
+    int i;
+    for (i = 0; i+4 <= iQuantity; i += 4)
+    {
+        __m128i kD = MulSse41(kR0,WG3D_LOAD128(aiX,i));
+        kD = _mm_add_epi32(kD,MulSse41(kR1,WG3D_LOAD128(aiY,i)));
+        kD = _mm_add_epi32(kD,MulSse41(kR2,WG3D_LOAD128(aiZ,i)));
+        kD = _mm_add_epi32(kD,kR3);
+
+        // -1 where d <= -r, else +1 where d >= r, else 0
+        __m128i kRadius = WG3D_LOAD128(aiRadius,i);
+        __m128i kNeg = _mm_cmpgt_epi32(_mm_sub_epi32(kZero,kRadius),kD);
+        kNeg = _mm_or_si128(kNeg,_mm_cmpeq_epi32(kD,
+            _mm_sub_epi32(kZero,kRadius)));
+        __m128i kPos = _mm_andnot_si128(_mm_cmpgt_epi32(kRadius,kD),kOne);
+        WG3D_STORE128(aiSide,i,_mm_or_si128(kNeg,kPos));
+    }
+    SphereSideLanes(iQuantity-i,aiRow,aiX+i,aiY+i,aiZ+i,aiRadius+i,
+        aiSide+i);
+}
+//----------------------------------------------------------------------------
+WG3D_TARGET_SSE41
+static void InverseNewtonLanesSse41 (int iQuantity, const int* aiV,
+    int* aiX)
+{
+    __m128i kTwo = _mm_set1_epi32(FIXED_ONE*2);
+    int i;
+    for (i = 0; i+4 <= iQuantity; i += 4)
+    {
+        __m128i kV = WG3D_LOAD128(aiV,i);
+        __m128i kX = WG3D_LOAD128(aiX,i);
+        kX = MulSse41(kX,_mm_sub_epi32(kTwo,MulSse41(kV,kX)));
+        kX = MulSse41(kX,_mm_sub_epi32(kTwo,MulSse41(kV,kX)));
+        WG3D_STORE128(aiX,i,kX);
+    }
+    InverseNewtonLanes(iQuantity-i,aiV+i,aiX+i);
+}
+//----------------------------------------------------------------------------
+WG3D_TARGET_SSE41
+static void InvSqrtNewtonLanesSse41 (int iQuantity, const int* aiV,
+    int* aiX)
+{
+    __m128i kThree = _mm_set1_epi32(FIXED_ONE*3);
+    int i;
+    for (i = 0; i+4 <= iQuantity; i += 4)
+    {
+        __m128i kV = WG3D_LOAD128(aiV,i);
+        __m128i kX = WG3D_LOAD128(aiX,i);
+        for (int j = 0; j < 3; j++)
+        {
+            __m128i kT = MulSse41(MulSse41(kV,kX),kX);
+            kX = MulSse41(_mm_srai_epi32(kX,1),_mm_sub_epi32(kThree,kT));
+        }
+        WG3D_STORE128(aiX,i,kX);
+    }
+    InvSqrtNewtonLanes(iQuantity-i,aiV+i,aiX+i);
+}
+#endif
+
+#if defined(WG3D_FIXEDSIMD_AVX2)
+//----------------------------------------------------------------------------
+// lane primitives, AVX2
+//----------------------------------------------------------------------------
+// Each function clears the upper halves of the registers before its scalar
+// tail.  The compiler does not do it before the tail call, and the SSE code
+// that runs next would pay the penalty of the AVX to SSE transition.
+//----------------------------------------------------------------------------
+WG3D_TARGET_AVX2
+static inline __m256i MulAvx2 (__m256i kA, __m256i kB)
+{
+    // same lane split as MulSse41
+    __m256i kEven = _mm256_srli_epi64(_mm256_mul_epi32(kA,kB),
+        FIXED_PRECISION);
+    __m256i kOdd = _mm256_mul_epi32(_mm256_srli_epi64(kA,32),
+        _mm256_srli_epi64(kB,32));
+    kOdd = _mm256_slli_epi64(kOdd,32-FIXED_PRECISION);
+    return _mm256_blend_epi32(kEven,kOdd,0xAA);
+}
+//----------------------------------------------------------------------------
+#define WG3D_LOAD256(aiA,i) _mm256_loadu_si256((const __m256i*)((aiA)+(i)))
+#define WG3D_STORE256(aiA,i,kV) \
+    _mm256_storeu_si256((__m256i*)((aiA)+(i)),kV)
+//----------------------------------------------------------------------------
+WG3D_TARGET_AVX2
+static void MulLanesAvx2 (int iQuantity, const int* aiA, const int* aiB,
+    int* aiR)
+{
+    int i;
+    for (i = 0; i+8 <= iQuantity; i += 8)
+    {
+        WG3D_STORE256(aiR,i,MulAvx2(WG3D_LOAD256(aiA,i),
+            WG3D_LOAD256(aiB,i)));
+    }
+    _mm256_zeroupper();
+    MulLanes(iQuantity-i,aiA+i,aiB+i,aiR+i);
+}
+//----------------------------------------------------------------------------
+WG3D_TARGET_AVX2
+static void ScaleLanesAvx2 (int iQuantity, const int* aiA, int iScale,
+    int* aiR)
+{
+    __m256i kScale = _mm256_set1_epi32(iScale);
+    int i;
+    for (i = 0; i+8 <= iQuantity; i += 8)
+    {
+        WG3D_STORE256(aiR,i,MulAvx2(kScale,WG3D_LOAD256(aiA,i)));
+    }
+    _mm256_zeroupper();
+    ScaleLanes(iQuantity-i,aiA+i,iScale,aiR+i);
+}
+//----------------------------------------------------------------------------
+WG3D_TARGET_AVX2
+static void Dot3LanesAvx2 (int iQuantity, const int* aiAX, const int* aiAY,
+    const int* aiAZ, const int* aiBX, const int* aiBY, const int* aiBZ,
+    int* aiR)
+{
+    int i;
+    for (i = 0; i+8 <= iQuantity; i += 8)
+    {
+        __m256i kR = MulAvx2(WG3D_LOAD256(aiAX,i),WG3D_LOAD256(aiBX,i));
+        kR = _mm256_add_epi32(kR,MulAvx2(WG3D_LOAD256(aiAY,i),
+            WG3D_LOAD256(aiBY,i)));
+        kR = _mm256_add_epi32(kR,MulAvx2(WG3D_LOAD256(aiAZ,i),
+            WG3D_LOAD256(aiBZ,i)));
+        WG3D_STORE256(aiR,i,kR);
+    }
+    _mm256_zeroupper();
+    Dot3Lanes(iQuantity-i,aiAX+i,aiAY+i,aiAZ+i,aiBX+i,aiBY+i,aiBZ+i,aiR+i);
+}
+//----------------------------------------------------------------------------
+WG3D_TARGET_AVX2
+static void MulSubLanesAvx2 (int iQuantity, const int* aiA, const int* aiB,
+    const int* aiC, const int* aiD, int* aiR)
+{
+    int i;
+    for (i = 0; i+8 <= iQuantity; i += 8)
+    {
+        __m256i kAB = MulAvx2(WG3D_LOAD256(aiA,i),WG3D_LOAD256(aiB,i));
+        __m256i kCD = MulAvx2(WG3D_LOAD256(aiC,i),WG3D_LOAD256(aiD,i));
+        WG3D_STORE256(aiR,i,_mm256_sub_epi32(kAB,kCD));
+    }
+    _mm256_zeroupper();
+    MulSubLanes(iQuantity-i,aiA+i,aiB+i,aiC+i,aiD+i,aiR+i);
+}
+//----------------------------------------------------------------------------
+WG3D_TARGET_AVX2
+static void AffineLanesAvx2 (int iQuantity, const int* aiRow,
+    const int* aiX, const int* aiY, const int* aiZ, int* aiR)
+{
+    __m256i kR0 = _mm256_set1_epi32(aiRow[0]);
+    __m256i kR1 = _mm256_set1_epi32(aiRow[1]);
+    __m256i kR2 = _mm256_set1_epi32(aiRow[2]);
+    __m256i kR3 = _mm256_set1_epi32(aiRow[3]);
+    int i;
+    for (i = 0; i+8 <= iQuantity; i += 8)
+    {
+        __m256i kR = MulAvx2(kR0,WG3D_LOAD256(aiX,i));
+        kR = _mm256_add_epi32(kR,MulAvx2(kR1,WG3D_LOAD256(aiY,i)));
+        kR = _mm256_add_epi32(kR,MulAvx2(kR2,WG3D_LOAD256(aiZ,i)));
+        WG3D_STORE256(aiR,i,_mm256_add_epi32(kR,kR3));
+    }
+    _mm256_zeroupper();
+    AffineLanes(iQuantity-i,aiRow,aiX+i,aiY+i,aiZ+i,aiR+i);
+}
+//----------------------------------------------------------------------------
+WG3D_TARGET_AVX2
+static void SphereSideLanesAvx2 (int iQuantity, const int* aiRow,
+    const int* aiX, const int* aiY, const int* aiZ, const int* aiRadius,
+    int* aiSide)
+{
+    __m256i kR0 = _mm256_set1_epi32(aiRow[0]);
+    __m256i kR1 = _mm256_set1_epi32(aiRow[1]);
+    __m256i kR2 = _mm256_set1_epi32(aiRow[2]);
+    __m256i kR3 = _mm256_set1_epi32(aiRow[3]);
+    __m256i kZero = _mm256_setzero_si256();
+    __m256i kOne = _mm256_set1_epi32(1);
+    int i;
+    for (i = 0; i+8 <= iQuantity; i += 8)
+    {
+        __m256i kD = MulAvx2(kR0,WG3D_LOAD256(aiX,i));
+        kD = _mm256_add_epi32(kD,MulAvx2(kR1,WG3D_LOAD256(aiY,i)));
+        kD = _mm256_add_epi32(kD,MulAvx2(kR2,WG3D_LOAD256(aiZ,i)));
+        kD = _mm256_add_epi32(kD,kR3);
+
+        // same tests as SphereSideLanesSse41
+        __m256i kRadius = WG3D_LOAD256(aiRadius,i);
+        __m256i kNegRadius = _mm256_sub_epi32(kZero,kRadius);
+        __m256i kNeg = _mm256_or_si256(_mm256_cmpgt_epi32(kNegRadius,kD),
+            _mm256_cmpeq_epi32(kD,kNegRadius));
+        __m256i kPos = _mm256_andnot_si256(_mm256_cmpgt_epi32(kRadius,kD),
+            kOne);
+        WG3D_STORE256(aiSide,i,_mm256_or_si256(kNeg,kPos));
+    }
+    _mm256_zeroupper();
+    SphereSideLanes(iQuantity-i,aiRow,aiX+i,aiY+i,aiZ+i,aiRadius+i,
+        aiSide+i);
+}
+//----------------------------------------------------------------------------
+WG3D_TARGET_AVX2
+static void InverseNewtonLanesAvx2 (int iQuantity, const int* aiV,
+    int* aiX)
+{
+    __m256i kTwo = _mm256_set1_epi32(FIXED_ONE*2);
+    int i;
+    for (i = 0; i+8 <= iQuantity; i += 8)
+    {
+        __m256i kV = WG3D_LOAD256(aiV,i);
+        __m256i kX = WG3D_LOAD256(aiX,i);
+        kX = MulAvx2(kX,_mm256_sub_epi32(kTwo,MulAvx2(kV,kX)));
+        kX = MulAvx2(kX,_mm256_sub_epi32(kTwo,MulAvx2(kV,kX)));
+        WG3D_STORE256(aiX,i,kX);
+    }
+    _mm256_zeroupper();
+    InverseNewtonLanes(iQuantity-i,aiV+i,aiX+i);
+}
+//----------------------------------------------------------------------------
+WG3D_TARGET_AVX2
+static void InvSqrtNewtonLanesAvx2 (int iQuantity, const int* aiV,
+    int* aiX)
+{
+    __m256i kThree = _mm256_set1_epi32(FIXED_ONE*3);
+    int i;
+    for (i = 0; i+8 <= iQuantity; i += 8)
+    {
+        __m256i kV = WG3D_LOAD256(aiV,i);
+        __m256i kX = WG3D_LOAD256(aiX,i);
+        for (int j = 0; j < 3; j++)
+        {
+            __m256i kT = MulAvx2(MulAvx2(kV,kX),kX);
+            kX = MulAvx2(_mm256_srai_epi32(kX,1),
+                _mm256_sub_epi32(kThree,kT));
+        }
+        WG3D_STORE256(aiX,i,kX);
+    }
+    _mm256_zeroupper();
+    InvSqrtNewtonLanes(iQuantity-i,aiV+i,aiX+i);
+}
+#endif
+
+//----------------------------------------------------------------------------
+// dispatch
+//----------------------------------------------------------------------------
+typedef struct
+{
+    void (*Mul)(int,const int*,const int*,int*);
+    void (*Scale)(int,const int*,int,int*);
+    void (*Dot3)(int,const int*,const int*,const int*,const int*,const int*,
+        const int*,int*);
+    void (*MulSub)(int,const int*,const int*,const int*,const int*,int*);
+    void (*Affine)(int,const int*,const int*,const int*,const int*,int*);
+    void (*InverseNewton)(int,const int*,int*);
+    void (*InvSqrtNewton)(int,const int*,int*);
+    void (*SphereSide)(int,const int*,const int*,const int*,const int*,
+        const int*,int*);
+}
+LaneKernels;
+
+static const LaneKernels gs_kScalarKernels =
+{
+    MulLanes, ScaleLanes, Dot3Lanes, MulSubLanes, AffineLanes,
+    InverseNewtonLanes, InvSqrtNewtonLanes, SphereSideLanes
+};
+
+#if defined(WG3D_FIXEDSIMD_SSE41)
+static const LaneKernels gs_kSse41Kernels =
+{
+    MulLanesSse41, ScaleLanesSse41, Dot3LanesSse41, MulSubLanesSse41,
+    AffineLanesSse41, InverseNewtonLanesSse41, InvSqrtNewtonLanesSse41,
+    SphereSideLanesSse41
+};
+#endif
+
+#if defined(WG3D_FIXEDSIMD_AVX2)
+static const LaneKernels gs_kAvx2Kernels =
+{
+    MulLanesAvx2, ScaleLanesAvx2, Dot3LanesAvx2, MulSubLanesAvx2,
+    AffineLanesAvx2, InverseNewtonLanesAvx2, InvSqrtNewtonLanesAvx2,
+    SphereSideLanesAvx2
+};
+#endif
+
+static const LaneKernels* gs_pkKernels = &gs_kScalarKernels;
+static bool gs_abSupported[FixedSimd::FS_QUANTITY] = { true, false, false };
+
+//----------------------------------------------------------------------------
+static void DetectProcessor (bool& rbSse41, bool& rbAvx2)
+{
+    rbSse41 = false;
+    rbAvx2 = false;
+
+#if defined(WG3D_FIXEDSIMD_SSE41) || defined(WG3D_FIXEDSIMD_AVX2)
+    unsigned int uiMaxLeaf, uiECX1, uiEBX7 = 0;
+#if defined(_MSC_VER)
+    int aiInfo[4];
+    __cpuid(aiInfo,0);
+    uiMaxLeaf = (unsigned int)aiInfo[0];
+    __cpuid(aiInfo,1);
+    uiECX1 = (unsigned int)aiInfo[2];
+#if defined(WG3D_FIXEDSIMD_AVX2)
+    if (uiMaxLeaf >= 7)
+    {
+        __cpuidex(aiInfo,7,0);
+        uiEBX7 = (unsigned int)aiInfo[1];
+    }
+#endif
+#else
+    unsigned int uiA, uiB, uiC, uiD;
+    uiMaxLeaf = __get_cpuid_max(0,0);
+    if (uiMaxLeaf < 1)
+    {
+        return;
+    }
+    __cpuid(1,uiA,uiB,uiC,uiD);
+    uiECX1 = uiC;
+    if (uiMaxLeaf >= 7)
+    {
+        __cpuid_count(7,0,uiA,uiB,uiC,uiD);
+        uiEBX7 = uiB;
+    }
+#endif
+
+    rbSse41 = (uiECX1 & (1 << 19)) != 0;
+
+    // AVX2 also needs the operating system to save the ymm registers
+    const unsigned int uiOSXSAVE = (1 << 27), uiAVX = (1 << 28);
+    if ((uiECX1 & uiOSXSAVE) && (uiECX1 & uiAVX) && (uiEBX7 & (1 << 5)))
+    {
+        unsigned int uiXCR0;
+#if defined(_MSC_VER)
+#if defined(WG3D_FIXEDSIMD_AVX2)
+        uiXCR0 = (unsigned int)_xgetbv(0);
+#else
+        uiXCR0 = 0;
+#endif
+#else
+        unsigned int uiEDX;
+        __asm__ __volatile__ ("xgetbv" : "=a"(uiXCR0), "=d"(uiEDX) : "c"(0));
+#endif
+        rbAvx2 = (uiXCR0 & 6) == 6;
+    }
+#endif
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Initialize ()
+{
+    bool bSse41, bAvx2;
+    DetectProcessor(bSse41,bAvx2);
+
+#if defined(WG3D_FIXEDSIMD_SSE41)
+    gs_abSupported[FS_SSE41] = bSse41;
+#endif
+#if defined(WG3D_FIXEDSIMD_AVX2)
+    gs_abSupported[FS_AVX2] = bAvx2;
+#endif
+
+    ms_bInitialized = true;
+    SetPath(FS_AVX2);
+}
+//----------------------------------------------------------------------------
+FixedSimd::Path FixedSimd::GetPath ()
+{
+    if (!ms_bInitialized)
+    {
+        Initialize();
+    }
+    return ms_ePath;
+}
+//----------------------------------------------------------------------------
+FixedSimd::Path FixedSimd::SetPath (Path ePath)
+{
+    if (!ms_bInitialized)
+    {
+        Initialize();
+    }
+
+    int i = (int)ePath;
+    if (i < 0 || i >= FS_QUANTITY)
+    {
+        i = FS_QUANTITY-1;
+    }
+    while (i > 0 && !gs_abSupported[i])
+    {
+        i--;
+    }
+
+    ms_ePath = (Path)i;
+    switch (ms_ePath)
+    {
+#if defined(WG3D_FIXEDSIMD_SSE41)
+    case FS_SSE41:
+        gs_pkKernels = &gs_kSse41Kernels;
+        break;
+#endif
+#if defined(WG3D_FIXEDSIMD_AVX2)
+    case FS_AVX2:
+        gs_pkKernels = &gs_kAvx2Kernels;
+        break;
+#endif
+    default:
+        gs_pkKernels = &gs_kScalarKernels;
+        break;
+    }
+    return ms_ePath;
+}
+//----------------------------------------------------------------------------
+bool FixedSimd::IsSupported (Path ePath)
+{
+    if (!ms_bInitialized)
+    {
+        Initialize();
+    }
+    return ePath >= 0 && ePath < FS_QUANTITY && gs_abSupported[ePath];
+}
+//----------------------------------------------------------------------------
+const char* FixedSimd::GetPathName (Path ePath)
+{
+    static const char* s_aacName[FS_QUANTITY] =
+    {
+        "scalar",
+        "SSE4.1",
+        "AVX2"
+    };
+
+    if (ePath < 0 || ePath >= FS_QUANTITY)
+    {
+        return "unknown";
+    }
+    return s_aacName[ePath];
+}
+
+#if WG_REAL == WG_REAL_FIXED
+//----------------------------------------------------------------------------
+// staging helpers
+//----------------------------------------------------------------------------
+static void Deinterleave (int iQuantity, const Vector3x* akV, int* aiX,
+    int* aiY, int* aiZ)
+{
+    const int* aiV = (const int*)(const fixed*)akV[0];
+    for (int i = 0; i < iQuantity; i++, aiV += 3)
+    {
+        aiX[i] = aiV[0];
+        aiY[i] = aiV[1];
+        aiZ[i] = aiV[2];
+    }
+}
+//----------------------------------------------------------------------------
+static void Interleave (int iQuantity, const int* aiX, const int* aiY,
+    const int* aiZ, Vector3x* akV)
+{
+    int* aiV = (int*)(fixed*)akV[0];
+    for (int i = 0; i < iQuantity; i++, aiV += 3)
+    {
+        aiV[0] = aiX[i];
+        aiV[1] = aiY[i];
+        aiV[2] = aiZ[i];
+    }
+}
+//----------------------------------------------------------------------------
+static void InvSqrtLanes (const LaneKernels* pkK, int iQuantity,
+    const int* aiV, int* aiR)
+{
+    // InvSqrt returns the zero and one special cases without refining them
+    int i;
+    for (i = 0; i < iQuantity; i++)
+    {
+        int iV = aiV[i];
+        aiR[i] = (iV == FIXED_ZERO || iV == FIXED_ONE ? FIXED_ZERO :
+            InvSqrtEstimate(iV));
+    }
+
+    pkK->InvSqrtNewton(iQuantity,aiV,aiR);
+
+    for (i = 0; i < iQuantity; i++)
+    {
+        if (aiV[i] == FIXED_ZERO)
+        {
+            aiR[i] = 0x7fffffff;
+        }
+        else if (aiV[i] == FIXED_ONE)
+        {
+            aiR[i] = FIXED_ONE;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+// kernels
+//----------------------------------------------------------------------------
+void FixedSimd::Mul (int iQuantity, const fixed* afA, const fixed* afB,
+    fixed* afResult)
+{
+    GetPath();
+    gs_pkKernels->Mul(iQuantity,(const int*)afA,(const int*)afB,
+        (int*)afResult);
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Div (int iQuantity, const fixed* afA, const fixed* afB,
+    fixed* afResult)
+{
+    GetPath();
+    const LaneKernels* pkK = gs_pkKernels;
+    const int* aiA = (const int*)afA;
+    const int* aiB = (const int*)afB;
+    int* aiResult = (int*)afResult;
+
+    int aiNum[WG3D_FIXEDSIMD_CHUNK], aiDen[WG3D_FIXEDSIMD_CHUNK];
+    int aiAbs[WG3D_FIXEDSIMD_CHUNK], aiInv[WG3D_FIXEDSIMD_CHUNK];
+    for (int iStart = 0; iStart < iQuantity; iStart += WG3D_FIXEDSIMD_CHUNK)
+    {
+        int iCount = iQuantity - iStart;
+        if (iCount > WG3D_FIXEDSIMD_CHUNK)
+        {
+            iCount = WG3D_FIXEDSIMD_CHUNK;
+        }
+
+        // xDiv drops 8 bits from both operands when the divisor is large,
+        // then multiplies by Inverse of the divisor
+        int i;
+        for (i = 0; i < iCount; i++)
+        {
+            int iA = aiA[iStart+i], iB = aiB[iStart+i];
+            if ((iB >> 24) && (iB >> 24) + 1)
+            {
+                iA >>= 8;
+                iB >>= 8;
+            }
+            aiNum[i] = iA;
+            aiDen[i] = iB;
+            aiAbs[i] = (iB < 0 ? -iB : iB);
+            aiInv[i] = (iB == FIXED_ZERO ? FIXED_ZERO :
+                InverseEstimate(aiAbs[i]));
+        }
+
+        pkK->InverseNewton(iCount,aiAbs,aiInv);
+
+        for (i = 0; i < iCount; i++)
+        {
+            if (aiDen[i] == FIXED_ZERO)
+            {
+                aiInv[i] = 0x7fffffff;
+            }
+            else if (aiDen[i] < 0)
+            {
+                aiInv[i] = -aiInv[i];
+            }
+        }
+
+        pkK->Mul(iCount,aiNum,aiInv,aiResult+iStart);
+    }
+}
+//----------------------------------------------------------------------------
+void FixedSimd::InvSqrt (int iQuantity, const fixed* afValue,
+    fixed* afResult)
+{
+    GetPath();
+    const int* aiValue = (const int*)afValue;
+    int* aiResult = (int*)afResult;
+
+    int aiV[WG3D_FIXEDSIMD_CHUNK];
+    for (int iStart = 0; iStart < iQuantity; iStart += WG3D_FIXEDSIMD_CHUNK)
+    {
+        int iCount = iQuantity - iStart;
+        if (iCount > WG3D_FIXEDSIMD_CHUNK)
+        {
+            iCount = WG3D_FIXEDSIMD_CHUNK;
+        }
+
+        // copy so that the result may overwrite the input
+        memcpy(aiV,aiValue+iStart,iCount*sizeof(int));
+        InvSqrtLanes(gs_pkKernels,iCount,aiV,aiResult+iStart);
+    }
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Dot (int iQuantity, const Vector3x* akA, const Vector3x* akB,
+    fixed* afResult)
+{
+    GetPath();
+    const LaneKernels* pkK = gs_pkKernels;
+    int* aiResult = (int*)afResult;
+
+    int aiAX[WG3D_FIXEDSIMD_CHUNK], aiAY[WG3D_FIXEDSIMD_CHUNK];
+    int aiAZ[WG3D_FIXEDSIMD_CHUNK], aiBX[WG3D_FIXEDSIMD_CHUNK];
+    int aiBY[WG3D_FIXEDSIMD_CHUNK], aiBZ[WG3D_FIXEDSIMD_CHUNK];
+    for (int iStart = 0; iStart < iQuantity; iStart += WG3D_FIXEDSIMD_CHUNK)
+    {
+        int iCount = iQuantity - iStart;
+        if (iCount > WG3D_FIXEDSIMD_CHUNK)
+        {
+            iCount = WG3D_FIXEDSIMD_CHUNK;
+        }
+
+        Deinterleave(iCount,akA+iStart,aiAX,aiAY,aiAZ);
+        Deinterleave(iCount,akB+iStart,aiBX,aiBY,aiBZ);
+        pkK->Dot3(iCount,aiAX,aiAY,aiAZ,aiBX,aiBY,aiBZ,aiResult+iStart);
+    }
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Cross (int iQuantity, const Vector3x* akA,
+    const Vector3x* akB, Vector3x* akResult)
+{
+    GetPath();
+    const LaneKernels* pkK = gs_pkKernels;
+
+    int aiAX[WG3D_FIXEDSIMD_CHUNK], aiAY[WG3D_FIXEDSIMD_CHUNK];
+    int aiAZ[WG3D_FIXEDSIMD_CHUNK], aiBX[WG3D_FIXEDSIMD_CHUNK];
+    int aiBY[WG3D_FIXEDSIMD_CHUNK], aiBZ[WG3D_FIXEDSIMD_CHUNK];
+    int aiRX[WG3D_FIXEDSIMD_CHUNK], aiRY[WG3D_FIXEDSIMD_CHUNK];
+    int aiRZ[WG3D_FIXEDSIMD_CHUNK];
+    for (int iStart = 0; iStart < iQuantity; iStart += WG3D_FIXEDSIMD_CHUNK)
+    {
+        int iCount = iQuantity - iStart;
+        if (iCount > WG3D_FIXEDSIMD_CHUNK)
+        {
+            iCount = WG3D_FIXEDSIMD_CHUNK;
+        }
+
+        Deinterleave(iCount,akA+iStart,aiAX,aiAY,aiAZ);
+        Deinterleave(iCount,akB+iStart,aiBX,aiBY,aiBZ);
+        pkK->MulSub(iCount,aiAY,aiBZ,aiAZ,aiBY,aiRX);
+        pkK->MulSub(iCount,aiAZ,aiBX,aiAX,aiBZ,aiRY);
+        pkK->MulSub(iCount,aiAX,aiBY,aiAY,aiBX,aiRZ);
+        Interleave(iCount,aiRX,aiRY,aiRZ,akResult+iStart);
+    }
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Normalize (int iQuantity, Vector3x* akV)
+{
+    Normalize(iQuantity,akV,akV);
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Normalize (int iQuantity, const Vector3x* akInput,
+    Vector3x* akOutput)
+{
+    GetPath();
+    const LaneKernels* pkK = gs_pkKernels;
+
+    int aiX[WG3D_FIXEDSIMD_CHUNK], aiY[WG3D_FIXEDSIMD_CHUNK];
+    int aiZ[WG3D_FIXEDSIMD_CHUNK], aiSqrLen[WG3D_FIXEDSIMD_CHUNK];
+    int aiInv[WG3D_FIXEDSIMD_CHUNK];
+    for (int iStart = 0; iStart < iQuantity; iStart += WG3D_FIXEDSIMD_CHUNK)
+    {
+        int iCount = iQuantity - iStart;
+        if (iCount > WG3D_FIXEDSIMD_CHUNK)
+        {
+            iCount = WG3D_FIXEDSIMD_CHUNK;
+        }
+
+        Deinterleave(iCount,akInput+iStart,aiX,aiY,aiZ);
+
+        // Scale by a power of two so that the largest component magnitude
+        // is in [1,2).  The squared length is then in [1,12) and keeps full
+        // precision without overflowing.
+        for (int i = 0; i < iCount; i++)
+        {
+            ufixed uiMax = (ufixed)xabs(aiX[i]);
+            ufixed uiAbs = (ufixed)xabs(aiY[i]);
+            if (uiAbs > uiMax)
+            {
+                uiMax = uiAbs;
+            }
+            uiAbs = (ufixed)xabs(aiZ[i]);
+            if (uiAbs > uiMax)
+            {
+                uiMax = uiAbs;
+            }
+            if (uiMax == 0)
+            {
+                continue;
+            }
+
+            int iShift = 15 - (int)CountLeadingZeros(uiMax);
+            if (iShift > 0)
+            {
+                aiX[i] >>= iShift;
+                aiY[i] >>= iShift;
+                aiZ[i] >>= iShift;
+            }
+            else if (iShift < 0)
+            {
+                // a left shift of a negative value is undefined
+                int iScale = 1 << -iShift;
+                aiX[i] *= iScale;
+                aiY[i] *= iScale;
+                aiZ[i] *= iScale;
+            }
+        }
+
+        // A zero vector gets the 0x7fffffff inverse and stays zero.
+        pkK->Dot3(iCount,aiX,aiY,aiZ,aiX,aiY,aiZ,aiSqrLen);
+        InvSqrtLanes(pkK,iCount,aiSqrLen,aiInv);
+        pkK->Mul(iCount,aiX,aiInv,aiX);
+        pkK->Mul(iCount,aiY,aiInv,aiY);
+        pkK->Mul(iCount,aiZ,aiInv,aiZ);
+
+        Interleave(iCount,aiX,aiY,aiZ,akOutput+iStart);
+    }
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Transform (int iQuantity, const Matrix3x& rkM,
+    const Vector3x* akInput, Vector3x* akOutput)
+{
+    Transform(iQuantity,rkM,Vector3x::ZERO,akInput,akOutput);
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Transform (int iQuantity, const Matrix3x& rkM,
+    const Vector3x& rkT, const Vector3x* akInput, Vector3x* akOutput)
+{
+    GetPath();
+    const LaneKernels* pkK = gs_pkKernels;
+
+    // rows of the 3x4 matrix [M|T]
+    const fixed* afM = (const fixed*)rkM;
+    int aaiRow[3][4];
+    for (int iRow = 0; iRow < 3; iRow++)
+    {
+        aaiRow[iRow][0] = afM[3*iRow].value;
+        aaiRow[iRow][1] = afM[3*iRow+1].value;
+        aaiRow[iRow][2] = afM[3*iRow+2].value;
+        aaiRow[iRow][3] = rkT[iRow].value;
+    }
+
+    int aiX[WG3D_FIXEDSIMD_CHUNK], aiY[WG3D_FIXEDSIMD_CHUNK];
+    int aiZ[WG3D_FIXEDSIMD_CHUNK], aiRX[WG3D_FIXEDSIMD_CHUNK];
+    int aiRY[WG3D_FIXEDSIMD_CHUNK], aiRZ[WG3D_FIXEDSIMD_CHUNK];
+    for (int iStart = 0; iStart < iQuantity; iStart += WG3D_FIXEDSIMD_CHUNK)
+    {
+        int iCount = iQuantity - iStart;
+        if (iCount > WG3D_FIXEDSIMD_CHUNK)
+        {
+            iCount = WG3D_FIXEDSIMD_CHUNK;
+        }
+
+        Deinterleave(iCount,akInput+iStart,aiX,aiY,aiZ);
+        pkK->Affine(iCount,aaiRow[0],aiX,aiY,aiZ,aiRX);
+        pkK->Affine(iCount,aaiRow[1],aiX,aiY,aiZ,aiRY);
+        pkK->Affine(iCount,aaiRow[2],aiX,aiY,aiZ,aiRZ);
+        Interleave(iCount,aiRX,aiRY,aiRZ,akOutput+iStart);
+    }
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Transform (int iQuantity, const Matrix3x& rkM,
+    const Vector3x& rkS, const Vector3x& rkT, const Vector3x* akInput,
+    Vector3x* akOutput)
+{
+    GetPath();
+    const LaneKernels* pkK = gs_pkKernels;
+
+    const fixed* afM = (const fixed*)rkM;
+    int aaiRow[3][4];
+    for (int iRow = 0; iRow < 3; iRow++)
+    {
+        aaiRow[iRow][0] = afM[3*iRow].value;
+        aaiRow[iRow][1] = afM[3*iRow+1].value;
+        aaiRow[iRow][2] = afM[3*iRow+2].value;
+        aaiRow[iRow][3] = rkT[iRow].value;
+    }
+
+    int aiX[WG3D_FIXEDSIMD_CHUNK], aiY[WG3D_FIXEDSIMD_CHUNK];
+    int aiZ[WG3D_FIXEDSIMD_CHUNK], aiRX[WG3D_FIXEDSIMD_CHUNK];
+    int aiRY[WG3D_FIXEDSIMD_CHUNK], aiRZ[WG3D_FIXEDSIMD_CHUNK];
+    for (int iStart = 0; iStart < iQuantity; iStart += WG3D_FIXEDSIMD_CHUNK)
+    {
+        int iCount = iQuantity - iStart;
+        if (iCount > WG3D_FIXEDSIMD_CHUNK)
+        {
+            iCount = WG3D_FIXEDSIMD_CHUNK;
+        }
+
+        // the scale is applied first, as Transformation::ApplyForward does
+        Deinterleave(iCount,akInput+iStart,aiX,aiY,aiZ);
+        pkK->Scale(iCount,aiX,rkS[0].value,aiX);
+        pkK->Scale(iCount,aiY,rkS[1].value,aiY);
+        pkK->Scale(iCount,aiZ,rkS[2].value,aiZ);
+        pkK->Affine(iCount,aaiRow[0],aiX,aiY,aiZ,aiRX);
+        pkK->Affine(iCount,aaiRow[1],aiX,aiY,aiZ,aiRY);
+        pkK->Affine(iCount,aaiRow[2],aiX,aiY,aiZ,aiRZ);
+        Interleave(iCount,aiRX,aiRY,aiRZ,akOutput+iStart);
+    }
+}
+//----------------------------------------------------------------------------
+void FixedSimd::WhichSide (int iQuantity, const Plane3x& rkPlane,
+    const fixed* afX, const fixed* afY, const fixed* afZ,
+    const fixed* afRadius, int* aiSide)
+{
+    GetPath();
+
+    // The lanes are read in place, the distance is the affine function
+    // N*X-c of the center.
+    int aiRow[4];
+    aiRow[0] = rkPlane.Normal[0].value;
+    aiRow[1] = rkPlane.Normal[1].value;
+    aiRow[2] = rkPlane.Normal[2].value;
+    aiRow[3] = -rkPlane.Constant.value;
+    gs_pkKernels->SphereSide(iQuantity,aiRow,(const int*)afX,
+        (const int*)afY,(const int*)afZ,(const int*)afRadius,aiSide);
+}
+//----------------------------------------------------------------------------
+#else
+//----------------------------------------------------------------------------
+// kernels of the float backend
+//----------------------------------------------------------------------------
+// The lanes are plain float loops over the packed arrays, which the compiler
+// vectorizes by itself, so the path setting has no effect on them.
+void FixedSimd::Mul (int iQuantity, const fixed* afA, const fixed* afB,
+    fixed* afResult)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        afResult[i].value = afA[i].value*afB[i].value;
+    }
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Div (int iQuantity, const fixed* afA, const fixed* afB,
+    fixed* afResult)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        afResult[i].value = afA[i].value/afB[i].value;
+    }
+}
+//----------------------------------------------------------------------------
+void FixedSimd::InvSqrt (int iQuantity, const fixed* afValue,
+    fixed* afResult)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        afResult[i].value = 1.0f/sqrtf(afValue[i].value);
+    }
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Dot (int iQuantity, const Vector3x* akA, const Vector3x* akB,
+    fixed* afResult)
+{
+    const float* afA = (const float*)(const fixed*)akA[0];
+    const float* afB = (const float*)(const fixed*)akB[0];
+    for (int i = 0; i < iQuantity; i++, afA += 3, afB += 3)
+    {
+        afResult[i].value = afA[0]*afB[0] + afA[1]*afB[1] + afA[2]*afB[2];
+    }
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Cross (int iQuantity, const Vector3x* akA,
+    const Vector3x* akB, Vector3x* akResult)
+{
+    const float* afA = (const float*)(const fixed*)akA[0];
+    const float* afB = (const float*)(const fixed*)akB[0];
+    float* afR = (float*)(fixed*)akResult[0];
+    for (int i = 0; i < iQuantity; i++, afA += 3, afB += 3, afR += 3)
+    {
+        float fX = afA[1]*afB[2] - afA[2]*afB[1];
+        float fY = afA[2]*afB[0] - afA[0]*afB[2];
+        float fZ = afA[0]*afB[1] - afA[1]*afB[0];
+        afR[0] = fX;
+        afR[1] = fY;
+        afR[2] = fZ;
+    }
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Normalize (int iQuantity, Vector3x* akV)
+{
+    Normalize(iQuantity,akV,akV);
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Normalize (int iQuantity, const Vector3x* akInput,
+    Vector3x* akOutput)
+{
+    const float* afV = (const float*)(const fixed*)akInput[0];
+    float* afR = (float*)(fixed*)akOutput[0];
+    for (int i = 0; i < iQuantity; i++, afV += 3, afR += 3)
+    {
+        float fSqrLen = afV[0]*afV[0] + afV[1]*afV[1] + afV[2]*afV[2];
+        float fInv = (fSqrLen > 0.0f ? 1.0f/sqrtf(fSqrLen) : 0.0f);
+        afR[0] = afV[0]*fInv;
+        afR[1] = afV[1]*fInv;
+        afR[2] = afV[2]*fInv;
+    }
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Transform (int iQuantity, const Matrix3x& rkM,
+    const Vector3x* akInput, Vector3x* akOutput)
+{
+    Transform(iQuantity,rkM,Vector3x::ZERO,akInput,akOutput);
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Transform (int iQuantity, const Matrix3x& rkM,
+    const Vector3x& rkT, const Vector3x* akInput, Vector3x* akOutput)
+{
+    Transform(iQuantity,rkM,Vector3x::ONE,rkT,akInput,akOutput);
+}
+//----------------------------------------------------------------------------
+void FixedSimd::Transform (int iQuantity, const Matrix3x& rkM,
+    const Vector3x& rkS, const Vector3x& rkT, const Vector3x* akInput,
+    Vector3x* akOutput)
+{
+    // the scale is folded into the columns of M
+    const float* afM = (const float*)(const fixed*)rkM;
+    float aafRow[3][4];
+    for (int iRow = 0; iRow < 3; iRow++)
+    {
+        aafRow[iRow][0] = afM[3*iRow]*rkS[0].value;
+        aafRow[iRow][1] = afM[3*iRow+1]*rkS[1].value;
+        aafRow[iRow][2] = afM[3*iRow+2]*rkS[2].value;
+        aafRow[iRow][3] = rkT[iRow].value;
+    }
+
+    const float* afV = (const float*)(const fixed*)akInput[0];
+    float* afR = (float*)(fixed*)akOutput[0];
+    for (int i = 0; i < iQuantity; i++, afV += 3, afR += 3)
+    {
+        float fX = afV[0], fY = afV[1], fZ = afV[2];
+        for (int iRow = 0; iRow < 3; iRow++)
+        {
+            afR[iRow] = aafRow[iRow][0]*fX + aafRow[iRow][1]*fY +
+                aafRow[iRow][2]*fZ + aafRow[iRow][3];
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void FixedSimd::WhichSide (int iQuantity, const Plane3x& rkPlane,
+    const fixed* afX, const fixed* afY, const fixed* afZ,
+    const fixed* afRadius, int* aiSide)
+{
+    float fNX = rkPlane.Normal[0].value, fNY = rkPlane.Normal[1].value;
+    float fNZ = rkPlane.Normal[2].value, fC = rkPlane.Constant.value;
+    for (int i = 0; i < iQuantity; i++)
+    {
+        float fDistance = fNX*afX[i].value + fNY*afY[i].value +
+            fNZ*afZ[i].value - fC;
+        float fRadius = afRadius[i].value;
+        aiSide[i] = (fDistance <= -fRadius ? -1 :
+            (fDistance >= fRadius ? +1 : 0));
+    }
+}
+//----------------------------------------------------------------------------
+#endif
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgFixedSimd.h                      //
+//                                                       //
+//  - Interface for Fixed SIMD kernel class              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG3D_FIXEDSIMD_H__
+#define __WG3D_FIXEDSIMD_H__
+
+#include "WgFoundationLIB.h"
+#include "WgSystem.h"
+
+namespace WGSoft3D
+{
+
+class Matrix3x;
+class Plane3x;
+class Vector3x;
+
+// Batched fixed point kernels.  Each kernel is written once on top of a
+// small set of lane primitives and the primitives have a scalar, an SSE4.1
+// and an AVX2 implementation.  The vector paths are compiled only where the
+// compiler supports them (define WG3D_FIXEDSIMD_SCALAR_ONLY to leave them
+// out) and are chosen at run time from the processor capabilities.  All the
+// paths do the same integer operations, so their results are bit identical.
+//
+// Accuracy against the scalar routines:
+//   Mul, Div, InvSqrt  - bit exact with xMul, xDiv and InvSqrt (0 ulp),
+//                        including the wrap of xMul on overflow
+//   Dot, Cross         - bit exact with Vector3x::Dot and Vector3x::Cross
+//                        within range
+//   Transform          - bit exact with M*X, M*X+T and M*(S*X)+T within
+//                        range
+// The products of the kernels are those of xMul, they wrap on overflow.
+// The products of the fixed operators saturate, so Dot, Cross and
+// Transform differ from the operators when a product leaves the range of
+// 16.16.
+//   WhichSide          - the same sides as SphereBV::WhichSide
+//   Normalize          - scales each vector so that its largest component is
+//                        in [1,2), then multiplies by InvSqrt of the
+//                        squared length.  It is within 5 ulp per component
+//                        of the exactly normalized vector and does not
+//                        overflow for large vectors the way SquaredLength
+//                        does.  A zero vector stays zero.
+// The output arrays may be the same as the input arrays.  With the float
+// backend (WG_REAL_FLOAT) the kernels are plain float loops.
+
+class WG3D_FOUNDATION_ITEM FixedSimd
+{
+public:
+    enum Path
+    {
+        FS_SCALAR,
+        FS_SSE41,
+        FS_AVX2,
+        FS_QUANTITY
+    };
+
+    // The best supported path is selected on first use.  SetPath falls back
+    // to the best supported path at or below the requested one and returns
+    // the path actually selected.
+    static Path GetPath ();
+    static Path SetPath (Path ePath);
+    static bool IsSupported (Path ePath);
+    static const char* GetPathName (Path ePath);
+
+    // fixed arrays
+    static void Mul (int iQuantity, const fixed* afA, const fixed* afB,
+        fixed* afResult);
+    static void Div (int iQuantity, const fixed* afA, const fixed* afB,
+        fixed* afResult);
+    static void InvSqrt (int iQuantity, const fixed* afValue,
+        fixed* afResult);
+
+    // Vector3x arrays
+    static void Dot (int iQuantity, const Vector3x* akA, const Vector3x* akB,
+        fixed* afResult);
+    static void Cross (int iQuantity, const Vector3x* akA,
+        const Vector3x* akB, Vector3x* akResult);
+    static void Normalize (int iQuantity, Vector3x* akV);
+    static void Normalize (int iQuantity, const Vector3x* akInput,
+        Vector3x* akOutput);
+
+    // Y = M*X, Y = M*X+T and Y = M*(S*X)+T where S is a diagonal scale
+    static void Transform (int iQuantity, const Matrix3x& rkM,
+        const Vector3x* akInput, Vector3x* akOutput);
+    static void Transform (int iQuantity, const Matrix3x& rkM,
+        const Vector3x& rkT, const Vector3x* akInput, Vector3x* akOutput);
+    static void Transform (int iQuantity, const Matrix3x& rkM,
+        const Vector3x& rkS, const Vector3x& rkT, const Vector3x* akInput,
+        Vector3x* akOutput);
+
+    // The side of each sphere with respect to the plane, +1, -1 or 0 as in
+    // SphereBV::WhichSide.  The spheres are in structure of arrays form,
+    // sphere i has center (afX[i],afY[i],afZ[i]) and radius afRadius[i].
+    static void WhichSide (int iQuantity, const Plane3x& rkPlane,
+        const fixed* afX, const fixed* afY, const fixed* afZ,
+        const fixed* afRadius, int* aiSide);
+
+private:
+    static void Initialize ();
+
+    static Path ms_ePath;
+    static bool ms_bInitialized;
+};
+
+}
+
+#endif
@@ -0,0 +1,256 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgFloatx.h                         //
+//                                                       //
+//  - Interface for Float backend of fixed class         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG3D_FLOATX_H__
+#define __WG3D_FLOATX_H__
+
+// Included by WgFixed.h when WG_REAL is WG_REAL_FLOAT.  Floatx keeps the
+// interface of Fixed so that code written against fixed compiles unchanged.
+// An int operand is still a raw 16.16 value, which is how the engine writes
+// its constants (fixed(FIXED_ONE), f*FIXED_HALF, f > FIXED_ZERO).
+
+class Floatx
+{
+public:
+	enum
+	{
+		FRACTION_BITS = FIXED_PRECISION,
+		ONE = FIXED_ONE
+	};
+
+	Floatx()
+	{
+		value=0.0f;
+	}
+	Floatx(const int x)
+	{
+		value=FromRaw(x);
+	}
+	Floatx(const Floatx &rkF)
+	{
+		value=rkF.value;
+	}
+	inline Floatx& operator =(const Floatx &rkF)
+	{
+		value=rkF.value;
+		return *this;
+	}
+	inline Floatx& operator =(const int val)
+	{
+		value=FromRaw(val);
+		return *this;
+	}
+
+	// a raw 16.16 operand as float
+	static inline float FromRaw(int val)
+	{
+		return (float)val*(1.0f/(float)FIXED_ONE);
+	}
+
+	// conversion
+	static inline Floatx FromInt(int val)
+	{
+		Floatx kF;
+		kF.value=(float)val;
+		return kF;
+	}
+	static inline Floatx FromFloat(float val)
+	{
+		Floatx kF;
+		kF.value=val;
+		return kF;
+	}
+	inline float ToFloat() const
+	{
+		return value;
+	}
+
+	// comparison
+    bool operator== (const Floatx& rkF) const
+	{
+		return value==rkF.value;
+	}
+    bool operator!= (const Floatx& rkF) const
+	{
+		return value!=rkF.value;
+	}
+    bool operator<  (const Floatx& rkF) const
+	{
+		return (value<rkF.value);
+	}
+    bool operator<= (const Floatx& rkF) const
+	{
+		return (value<=rkF.value);
+	}
+    bool operator>  (const Floatx& rkF) const
+	{
+		return (value>rkF.value);
+	}
+    bool operator>= (const Floatx& rkF) const
+	{
+		return (value>=rkF.value);
+	}
+
+	bool operator== (const int val) const
+	{
+		return value==FromRaw(val);
+	}
+    bool operator!= (const int val) const
+	{
+		return value!=FromRaw(val);
+	}
+    bool operator<  (const int val) const
+	{
+		return value<FromRaw(val);
+	}
+    bool operator<= (const int val) const
+	{
+		return value<=FromRaw(val);
+	}
+    bool operator>  (const int val) const
+	{
+		return value>FromRaw(val);
+	}
+    bool operator>= (const int val) const
+	{
+		return value>=FromRaw(val);
+	}
+
+	inline Floatx operator+ (const Floatx& rkF) const
+	{
+		return FromFloat(value+rkF.value);
+	}
+    inline Floatx operator- (const Floatx& rkF) const
+	{
+		return FromFloat(value-rkF.value);
+	}
+    inline Floatx operator* (const Floatx& rkF) const
+	{
+		return FromFloat(value*rkF.value);
+	}
+    inline Floatx operator/ (const Floatx& rkF) const
+	{
+		return FromFloat(value/rkF.value);
+	}
+
+	inline Floatx operator+ (const int val) const
+	{
+		return FromFloat(value+FromRaw(val));
+	}
+	inline Floatx operator- (const int val) const
+	{
+		return FromFloat(value-FromRaw(val));
+	}
+    inline Floatx operator* (const int val) const
+	{
+		return FromFloat(value*FromRaw(val));
+	}
+    inline Floatx operator/ (const int val) const
+	{
+		return FromFloat(value/FromRaw(val));
+	}
+    inline Floatx operator- () const
+	{
+		return FromFloat(-value);
+	}
+	inline Floatx operator+ () const
+	{
+		return *this;
+	}
+
+    // arithmetic updates
+    inline Floatx& operator+= (const Floatx& rkF)
+	{
+		value+=rkF.value;
+		return *this;
+	}
+    inline Floatx& operator-= (const Floatx& rkF)
+	{
+		value-=rkF.value;
+		return *this;
+	}
+    inline Floatx& operator*= (const Floatx& rkF)
+	{
+		value*=rkF.value;
+		return *this;
+	}
+    inline Floatx& operator/= (const Floatx& rkF)
+	{
+		value/=rkF.value;
+		return *this;
+	}
+
+    inline Floatx& operator+= (const int val)
+	{
+		value+=FromRaw(val);
+		return *this;
+	}
+    inline Floatx& operator-= (const int val)
+	{
+		value-=FromRaw(val);
+		return *this;
+	}
+    inline Floatx& operator*= (const int val)
+	{
+		value*=FromRaw(val);
+		return *this;
+	}
+    inline Floatx& operator/= (const int val)
+	{
+		value/=FromRaw(val);
+		return *this;
+	}
+	float value;
+};
+
+// Global Floatx Arithmetic Operator.  Unlike the fixed backend the result is
+// a Floatx, an int result would drop the fraction.
+inline Floatx operator *(const int &val,const Floatx &val2)
+{
+	return Floatx::FromFloat(Floatx::FromRaw(val)*val2.value);
+}
+inline Floatx operator /(const int &val, const Floatx &val2)
+{
+	return Floatx::FromFloat(Floatx::FromRaw(val)/val2.value);
+}
+inline Floatx operator +(const int &val,const Floatx &val2)
+{
+	return Floatx::FromFloat(Floatx::FromRaw(val)+val2.value);
+}
+inline Floatx operator -(const int &val, const Floatx &val2)
+{
+	return Floatx::FromFloat(Floatx::FromRaw(val)-val2.value);
+}
+
+// Global Floatx Comparison Operator
+inline bool operator== (const int &val, const Floatx &val2)
+{
+	return Floatx::FromRaw(val)==val2.value;
+}
+inline bool operator!= (const int &val, const Floatx &val2)
+{
+	return Floatx::FromRaw(val)!=val2.value;
+}
+inline bool operator<  (const int &val, const Floatx &val2)
+{
+	return Floatx::FromRaw(val)<val2.value;
+}
+inline bool operator<= (const int &val, const Floatx &val2)
+{
+	return Floatx::FromRaw(val)<=val2.value;
+}
+inline bool operator>  (const int &val, const Floatx &val2)
+{
+	return Floatx::FromRaw(val)>val2.value;
+}
+inline bool operator>= (const int &val, const Floatx &val2)
+{
+	return Floatx::FromRaw(val)>=val2.value;
+}
+
+#endif
@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgFrameArena.cpp                   //
+//                                                       //
+//  - Implementation for Frame Arena class               //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgSystem.h"
+#include "WgFrameArena.h"
+using namespace WGSoft3D;
+
+FrameArena* FrameArena::ms_pkFrame = 0;
+
+namespace WGSoft3D
+{
+
+// A chunk covers the marks [Base,Base+Size) of the arena.
+class FrameArena::Chunk
+{
+public:
+    Chunk* Next;
+    size_t Base, Size;
+    char* Memory;  // as allocated, Data is aligned in it
+    char* Data;
+};
+
+}
+
+//----------------------------------------------------------------------------
+FrameArena::FrameArena (int iChunkSize)
+{
+    assert(iChunkSize > 0);
+    m_uiChunkSize = (size_t)(iChunkSize > 0 ? iChunkSize : 65536);
+    m_pkFirst = 0;
+    m_pkLast = 0;
+    m_pkCurrent = 0;
+    m_uiOffset = 0;
+    m_uiPeak = 0;
+    m_uiReserved = 0;
+    m_iAllocations = 0;
+    m_iChunkAllocations = 0;
+}
+//----------------------------------------------------------------------------
+FrameArena::~FrameArena ()
+{
+    if (ms_pkFrame == this)
+    {
+        ms_pkFrame = 0;
+    }
+
+    while (m_pkFirst)
+    {
+        Chunk* pkNext = m_pkFirst->Next;
+        WG_DELETE[] m_pkFirst->Memory;
+        WG_DELETE m_pkFirst;
+        m_pkFirst = pkNext;
+    }
+}
+//----------------------------------------------------------------------------
+void* FrameArena::Allocate (size_t uiSize)
+{
+    uiSize = (uiSize + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1);
+    if (!m_pkCurrent || uiSize > m_pkCurrent->Size - m_uiOffset)
+    {
+        NextChunk(uiSize);
+    }
+
+    void* pvAddr = m_pkCurrent->Data + m_uiOffset;
+    m_uiOffset += uiSize;
+    m_iAllocations++;
+
+    size_t uiUsed = m_pkCurrent->Base + m_uiOffset;
+    if (uiUsed > m_uiPeak)
+    {
+        m_uiPeak = uiUsed;
+    }
+    return pvAddr;
+}
+//----------------------------------------------------------------------------
+size_t FrameArena::GetMark () const
+{
+    return (m_pkCurrent ? m_pkCurrent->Base + m_uiOffset : 0);
+}
+//----------------------------------------------------------------------------
+void FrameArena::Release (size_t uiMark)
+{
+    assert(uiMark <= GetMark());
+
+    // the first chunk that contains the mark (a mark at the end of a chunk
+    // is also the start of the next one)
+    Chunk* pkChunk;
+    for (pkChunk = m_pkFirst; pkChunk; pkChunk = pkChunk->Next)
+    {
+        if (uiMark <= pkChunk->Base + pkChunk->Size)
+        {
+            m_pkCurrent = pkChunk;
+            m_uiOffset = uiMark - pkChunk->Base;
+            return;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void FrameArena::Reset ()
+{
+    m_iAllocations = 0;
+    m_uiOffset = 0;
+    m_pkCurrent = m_pkFirst;
+
+    if (m_pkFirst && m_pkFirst->Next)
+    {
+        // The frame needed several chunks, the next ones fit in a single
+        // chunk of their total size.
+        size_t uiSize = m_uiReserved;
+        while (m_pkFirst)
+        {
+            Chunk* pkNext = m_pkFirst->Next;
+            WG_DELETE[] m_pkFirst->Memory;
+            WG_DELETE m_pkFirst;
+            m_pkFirst = pkNext;
+        }
+        m_uiReserved = 0;
+        m_pkFirst = CreateChunk(0,uiSize);
+        m_pkLast = m_pkFirst;
+        m_pkCurrent = m_pkFirst;
+    }
+}
+//----------------------------------------------------------------------------
+void FrameArena::NextChunk (size_t uiSize)
+{
+    // The chunks after the current one were used by a frame before, take
+    // the first one that is large enough.  The rest of the current chunk
+    // and the skipped chunks are unused until the next Reset.
+    Chunk* pkChunk = (m_pkCurrent ? m_pkCurrent->Next : m_pkFirst);
+    for (/**/; pkChunk; pkChunk = pkChunk->Next)
+    {
+        if (uiSize <= pkChunk->Size)
+        {
+            m_pkCurrent = pkChunk;
+            m_uiOffset = 0;
+            return;
+        }
+    }
+
+    size_t uiBase = (m_pkLast ? m_pkLast->Base + m_pkLast->Size : 0);
+    pkChunk = CreateChunk(uiBase,
+        (uiSize > m_uiChunkSize ? uiSize : m_uiChunkSize));
+    if (m_pkLast)
+    {
+        m_pkLast->Next = pkChunk;
+    }
+    else
+    {
+        m_pkFirst = pkChunk;
+    }
+    m_pkLast = pkChunk;
+    m_pkCurrent = pkChunk;
+    m_uiOffset = 0;
+}
+//----------------------------------------------------------------------------
+FrameArena::Chunk* FrameArena::CreateChunk (size_t uiBase, size_t uiSize)
+{
+    Chunk* pkChunk = WG_NEW Chunk;
+    pkChunk->Next = 0;
+    pkChunk->Base = uiBase;
+    pkChunk->Size = uiSize;
+    pkChunk->Memory = WG_NEW char[uiSize + ALIGNMENT - 1];
+    size_t uiMisalign = (size_t)pkChunk->Memory & (ALIGNMENT - 1);
+    pkChunk->Data = pkChunk->Memory +
+        (uiMisalign ? ALIGNMENT - uiMisalign : 0);
+
+    m_uiReserved += uiSize;
+    m_iChunkAllocations += 2;
+    return pkChunk;
+}
+//----------------------------------------------------------------------------
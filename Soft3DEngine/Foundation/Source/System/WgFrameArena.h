@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgFrameArena.h                     //
+//                                                       //
+//  - Interface for Frame Arena class                    //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG3D_FRAMEARENA_H__
+#define __WG3D_FRAMEARENA_H__
+
+#include "WgFoundationLIB.h"
+#include <cstddef>
+#include <new>
+
+namespace WGSoft3D
+{
+
+// A bump allocator for the memory that lives for one frame.  Allocate hands
+// out consecutive pieces of chunks that the arena takes from the heap, and
+// nothing is freed individually:  Reset makes the whole arena free again at
+// the end of a frame, and Release frees what was allocated after a mark,
+// for the temporary data of a call.  The chunks are kept.  When a frame
+// needed more than one chunk, Reset replaces them by a single chunk of
+// their total size, so after the first frames the arena takes nothing from
+// the heap.  The arena does not call destructors; whoever constructs an
+// object in it destroys the object before the memory is reset.  An arena
+// is used by one thread at a time.
+//
+// The arena of the frame (SetFrame) is used by the traversals of the scene
+// graph when it is set:  the stacks of Spatial::UpdateRS, the task lists of
+// the parallel UpdateGS and the pick records of DoPick come from it instead
+// of the heap.  The application resets it once per frame, after it deleted
+// the pick records of the frame.  The default is no arena, the heap.
+
+class WG3D_FOUNDATION_ITEM FrameArena
+{
+public:
+    class Chunk;  // defined in WgFrameArena.cpp
+
+    FrameArena (int iChunkSize = 65536);
+    ~FrameArena ();
+
+    // The memory is aligned to ALIGNMENT bytes and stays valid until the
+    // arena is reset or released to a mark taken before the allocation.
+    enum { ALIGNMENT = 16 };
+    void* Allocate (size_t uiSize);
+
+    // The mark is the number of bytes in use.
+    size_t GetMark () const;
+    void Release (size_t uiMark);
+    void Reset ();
+
+    // The statistics.  The allocations are the calls to Allocate since the
+    // most recent Reset.  The chunk allocations are the allocations that
+    // the arena made on the heap since its construction.
+    size_t GetUsedBytes () const;
+    size_t GetPeakBytes () const;
+    size_t GetReservedBytes () const;
+    int GetAllocations () const;
+    int GetChunkAllocations () const;
+
+    // the arena of the frame, null for none
+    static void SetFrame (FrameArena* pkArena);
+    static FrameArena* GetFrame ();
+
+private:
+    void NextChunk (size_t uiSize);
+    Chunk* CreateChunk (size_t uiBase, size_t uiSize);
+
+    size_t m_uiChunkSize;
+    Chunk* m_pkFirst;
+    Chunk* m_pkLast;
+    Chunk* m_pkCurrent;
+    size_t m_uiOffset;  // the bytes in use in the current chunk
+    size_t m_uiPeak, m_uiReserved;
+    int m_iAllocations, m_iChunkAllocations;
+
+    static FrameArena* ms_pkFrame;
+};
+
+#include "WgFrameArena.inl"
+
+}
+
+#endif
@@ -0,0 +1,44 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgFrameArena.inl                   //
+//                                                       //
+//  - Inlines for Frame Arena class                      //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+inline size_t FrameArena::GetUsedBytes () const
+{
+    return GetMark();
+}
+//----------------------------------------------------------------------------
+inline size_t FrameArena::GetPeakBytes () const
+{
+    return m_uiPeak;
+}
+//----------------------------------------------------------------------------
+inline size_t FrameArena::GetReservedBytes () const
+{
+    return m_uiReserved;
+}
+//----------------------------------------------------------------------------
+inline int FrameArena::GetAllocations () const
+{
+    return m_iAllocations;
+}
+//----------------------------------------------------------------------------
+inline int FrameArena::GetChunkAllocations () const
+{
+    return m_iChunkAllocations;
+}
+//----------------------------------------------------------------------------
+inline void FrameArena::SetFrame (FrameArena* pkArena)
+{
+    ms_pkFrame = pkArena;
+}
+//----------------------------------------------------------------------------
+inline FrameArena* FrameArena::GetFrame ()
+{
+    return ms_pkFrame;
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,985 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgMemory.cpp                       //
+//                                                       //
+//  - Implementation for Custum Memory class             //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgSystem.h"
+
+#ifdef WG_MEMORY_MANAGER
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+using namespace WGSoft3D;
+
+bool Memory::ms_bPooling = true;
+
+// The operators of <new> have exception specifications before C++11.
+#if __cplusplus >= 201103L
+#define WG_THROW_BAD_ALLOC
+#define WG_THROW_NOTHING noexcept
+#else
+#define WG_THROW_BAD_ALLOC throw (std::bad_alloc)
+#define WG_THROW_NOTHING throw ()
+#endif
+
+//----------------------------------------------------------------------------
+// blocks, pools and caches
+//----------------------------------------------------------------------------
+namespace WGSoft3D
+{
+
+// The header in front of every block.  A free block of a pool links to the
+// next free block through its first bytes.
+class MemoryBlock
+{
+public:
+    union
+    {
+        const char* File;    // the file of WG_NEW, null for plain new
+        size_t SystemSize;   // the request of a block without pooling
+        unsigned __int64 Pad;
+    };
+    unsigned int Line;
+    unsigned short Size;     // the request of a block of a pool
+    unsigned char Class;     // a pool, LARGE_BLOCK or SYSTEM_BLOCK
+    unsigned char Flags;
+
+    MemoryBlock*& NextFree ()
+    {
+        return *(MemoryBlock**)(this + 1);
+    }
+};
+
+// The link in front of the header of a large block.
+class MemoryLarge
+{
+public:
+    MemoryLarge* Prev;
+    MemoryLarge* Next;
+    size_t Size;
+    size_t Pad;
+};
+
+// A page of a pool, the blocks follow it.
+class MemoryPage
+{
+public:
+    union
+    {
+        MemoryPage* Next;
+        unsigned __int64 Pad[2];
+    };
+};
+
+class MemoryPool
+{
+public:
+    MemoryBlock* Free;
+    MemoryPage* Pages;
+    int PageQuantity;
+};
+
+// The free blocks and the statistics of a thread.  Only the thread changes
+// them; the statistics are read by the other threads.
+class MemoryCache
+{
+public:
+    MemoryBlock* Free[Memory::CLASS_QUANTITY];
+    int FreeQuantity[Memory::CLASS_QUANTITY];
+    volatile size_t Allocations[Memory::CLASS_QUANTITY+1];
+    volatile size_t Frees[Memory::CLASS_QUANTITY+1];
+    volatile ptrdiff_t Bytes;  // requested bytes allocated minus freed
+    unsigned int Sample;
+    int StaticDepth;           // the BeginStatic calls not yet ended
+    MemoryCache* Next;
+};
+
+// The live blocks of WG_NEW in the leak report.
+class MemoryRecord
+{
+public:
+    const char* File;
+    unsigned int Line;
+    size_t Size;
+};
+
+}
+
+enum
+{
+    LARGE_BLOCK = 254,
+    SYSTEM_BLOCK = 255,
+    BLOCK_LIVE = 1,
+    BLOCK_ARRAY = 2,
+    BLOCK_STATIC = 4,   // not listed by the report
+
+    // the blocks a cache takes from a pool or returns to it at a time
+    BATCH = 32,
+
+    // the allocations of a thread between samples of the peak
+    SAMPLE_MASK = 63
+};
+
+static const int gs_aiClassSize[Memory::CLASS_QUANTITY] =
+{
+    16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512
+};
+
+// the class of a request of n bytes is gs_aucClassOf[(n+15)/16]
+static const unsigned char gs_aucClassOf[Memory::MAX_SMALL/16+1] =
+{
+    0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 8, 9, 9, 10, 10, 11, 11,
+    12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15
+};
+
+// The state is zero initialized, so the manager works before the static
+// constructors of the program run.
+static MemoryPool gs_akPool[Memory::CLASS_QUANTITY];
+static MemoryLarge* gs_pkLarge;
+static size_t gs_uiLargeReserved;
+static MemoryCache* volatile gs_pkCaches;
+static volatile long gs_lLock;
+static volatile size_t gs_uiPeak;
+static size_t gs_auiFrameBase[Memory::CLASS_QUANTITY+1];
+static bool gs_bReportAtExit;
+static char gs_acReportFile[256];
+
+//----------------------------------------------------------------------------
+// platform layer
+//----------------------------------------------------------------------------
+static void Lock ()
+{
+#if defined(_WIN32)
+    while (InterlockedExchange((LONG*)&gs_lLock,1) != 0)
+    {
+        Sleep(0);
+    }
+#else
+    while (__sync_lock_test_and_set(&gs_lLock,1) != 0)
+    {
+        sched_yield();
+    }
+#endif
+}
+//----------------------------------------------------------------------------
+static void Unlock ()
+{
+#if defined(_WIN32)
+    InterlockedExchange((LONG*)&gs_lLock,0);
+#else
+    __sync_lock_release(&gs_lLock);
+#endif
+}
+//----------------------------------------------------------------------------
+// the cache of the calling thread, null until the thread allocates
+#if defined(_WIN32_WCE)
+static DWORD gs_dwCacheSlot = TLS_OUT_OF_INDEXES;
+static MemoryCache* GetThreadCache ()
+{
+    if (gs_dwCacheSlot == TLS_OUT_OF_INDEXES)
+    {
+        return 0;
+    }
+    return (MemoryCache*)TlsGetValue(gs_dwCacheSlot);
+}
+// called under the lock
+static void SetThreadCache (MemoryCache* pkCache)
+{
+    if (gs_dwCacheSlot == TLS_OUT_OF_INDEXES)
+    {
+        gs_dwCacheSlot = TlsAlloc();
+    }
+    TlsSetValue(gs_dwCacheSlot,pkCache);
+}
+#else
+#if defined(_MSC_VER)
+static __declspec(thread) MemoryCache* gs_pkThreadCache = 0;
+#else
+static __thread MemoryCache* gs_pkThreadCache = 0;
+#endif
+static MemoryCache* GetThreadCache ()
+{
+    return gs_pkThreadCache;
+}
+static void SetThreadCache (MemoryCache* pkCache)
+{
+    gs_pkThreadCache = pkCache;
+}
+#endif
+
+//----------------------------------------------------------------------------
+// internal functions
+//----------------------------------------------------------------------------
+static size_t SumLiveBytes ()
+{
+    ptrdiff_t iBytes = 0;
+    for (MemoryCache* pkCache = gs_pkCaches; pkCache; pkCache = pkCache->Next)
+    {
+        iBytes += pkCache->Bytes;
+    }
+    return (iBytes > 0 ? (size_t)iBytes : 0);
+}
+//----------------------------------------------------------------------------
+static void SamplePeak ()
+{
+    size_t uiLive = SumLiveBytes();
+    if (uiLive > gs_uiPeak)
+    {
+        gs_uiPeak = uiLive;
+    }
+}
+//----------------------------------------------------------------------------
+static void ReportAtExit ()
+{
+    // report only when blocks of WG_NEW are live
+    bool bLeak = false;
+    Lock();
+    for (int iClass = 0; iClass < Memory::CLASS_QUANTITY && !bLeak; iClass++)
+    {
+        int iStride = (int)sizeof(MemoryBlock) + gs_aiClassSize[iClass];
+        int iQuantity = (Memory::PAGE_SIZE - (int)sizeof(MemoryPage))/iStride;
+        MemoryPage* pkPage = gs_akPool[iClass].Pages;
+        for (/**/; pkPage && !bLeak; pkPage = pkPage->Next)
+        {
+            char* acBlock = (char*)(pkPage + 1);
+            for (int i = 0; i < iQuantity; i++, acBlock += iStride)
+            {
+                MemoryBlock* pkBlock = (MemoryBlock*)acBlock;
+                if ((pkBlock->Flags & (BLOCK_LIVE | BLOCK_STATIC)) ==
+                    BLOCK_LIVE && pkBlock->File)
+                {
+                    bLeak = true;
+                    break;
+                }
+            }
+        }
+    }
+    for (MemoryLarge* pkLarge = gs_pkLarge; pkLarge && !bLeak;
+         pkLarge = pkLarge->Next)
+    {
+        MemoryBlock* pkBlock = (MemoryBlock*)(pkLarge + 1);
+        bLeak = (!(pkBlock->Flags & BLOCK_STATIC) && pkBlock->File);
+    }
+    Unlock();
+
+    if (bLeak && (!gs_acReportFile[0]
+    ||  !Memory::GenerateReport(gs_acReportFile)))
+    {
+        Memory::GenerateReport(stderr);
+    }
+}
+//----------------------------------------------------------------------------
+static MemoryCache* CreateThreadCache ()
+{
+    MemoryCache* pkCache = (MemoryCache*)malloc(sizeof(MemoryCache));
+    if (!pkCache)
+    {
+        return 0;
+    }
+    memset(pkCache,0,sizeof(MemoryCache));
+
+    Lock();
+    if (!gs_bReportAtExit)
+    {
+        // The first allocation registers the report, so it runs after the
+        // static destructors of the objects constructed later.
+        gs_bReportAtExit = true;
+        atexit(ReportAtExit);
+    }
+    // the other threads walk the list without the lock
+    pkCache->Next = gs_pkCaches;
+#if defined(_WIN32)
+    MemoryBarrier();
+#else
+    __sync_synchronize();
+#endif
+    gs_pkCaches = pkCache;
+    SetThreadCache(pkCache);
+    Unlock();
+    return pkCache;
+}
+//----------------------------------------------------------------------------
+// called under the lock
+static bool AddPage (int iClass)
+{
+    MemoryPage* pkPage = (MemoryPage*)malloc(Memory::PAGE_SIZE);
+    if (!pkPage)
+    {
+        return false;
+    }
+
+    MemoryPool& rkPool = gs_akPool[iClass];
+    pkPage->Next = rkPool.Pages;
+    rkPool.Pages = pkPage;
+    rkPool.PageQuantity++;
+
+    // link the blocks in the order of their addresses
+    int iStride = (int)sizeof(MemoryBlock) + gs_aiClassSize[iClass];
+    int iQuantity = (Memory::PAGE_SIZE - (int)sizeof(MemoryPage))/iStride;
+    char* acFirst = (char*)(pkPage + 1);
+    MemoryBlock* pkNext = rkPool.Free;
+    for (int i = iQuantity - 1; i >= 0; i--)
+    {
+        MemoryBlock* pkBlock = (MemoryBlock*)(acFirst + i*iStride);
+        pkBlock->File = 0;
+        pkBlock->Class = (unsigned char)iClass;
+        pkBlock->Flags = 0;
+        pkBlock->NextFree() = pkNext;
+        pkNext = pkBlock;
+    }
+    rkPool.Free = pkNext;
+    return true;
+}
+//----------------------------------------------------------------------------
+static MemoryBlock* Refill (MemoryCache* pkCache, int iClass)
+{
+    MemoryPool& rkPool = gs_akPool[iClass];
+    Lock();
+    if (!rkPool.Free && !AddPage(iClass))
+    {
+        Unlock();
+        return 0;
+    }
+
+    MemoryBlock* pkFirst = rkPool.Free;
+    MemoryBlock* pkLast = pkFirst;
+    int iQuantity = 1;
+    while (iQuantity < BATCH && pkLast->NextFree())
+    {
+        pkLast = pkLast->NextFree();
+        iQuantity++;
+    }
+    rkPool.Free = pkLast->NextFree();
+    pkLast->NextFree() = 0;
+    SamplePeak();
+    Unlock();
+
+    pkCache->Free[iClass] = pkFirst;
+    pkCache->FreeQuantity[iClass] = iQuantity;
+    return pkFirst;
+}
+//----------------------------------------------------------------------------
+static void Flush (MemoryCache* pkCache, int iClass)
+{
+    // keep the BATCH blocks freed most recently, return the older ones
+    MemoryBlock* pkKeep = pkCache->Free[iClass];
+    for (int i = 1; i < BATCH; i++)
+    {
+        pkKeep = pkKeep->NextFree();
+    }
+    MemoryBlock* pkFirst = pkKeep->NextFree();
+    MemoryBlock* pkLast = pkFirst;
+    while (pkLast->NextFree())
+    {
+        pkLast = pkLast->NextFree();
+    }
+    pkKeep->NextFree() = 0;
+    pkCache->FreeQuantity[iClass] = BATCH;
+
+    MemoryPool& rkPool = gs_akPool[iClass];
+    Lock();
+    pkLast->NextFree() = rkPool.Free;
+    rkPool.Free = pkFirst;
+    SamplePeak();
+    Unlock();
+}
+//----------------------------------------------------------------------------
+static MemoryBlock* AllocateLarge (size_t uiSize)
+{
+    size_t uiHeader = sizeof(MemoryLarge) + sizeof(MemoryBlock);
+    if (uiSize > ~(size_t)0 - uiHeader)
+    {
+        return 0;
+    }
+    MemoryLarge* pkLarge = (MemoryLarge*)malloc(uiHeader + uiSize);
+    if (!pkLarge)
+    {
+        return 0;
+    }
+    pkLarge->Prev = 0;
+    pkLarge->Size = uiSize;
+
+    Lock();
+    pkLarge->Next = gs_pkLarge;
+    if (gs_pkLarge)
+    {
+        gs_pkLarge->Prev = pkLarge;
+    }
+    gs_pkLarge = pkLarge;
+    gs_uiLargeReserved += uiHeader + uiSize;
+    Unlock();
+
+    MemoryBlock* pkBlock = (MemoryBlock*)(pkLarge + 1);
+    pkBlock->Size = 0;
+    pkBlock->Class = LARGE_BLOCK;
+    return pkBlock;
+}
+//----------------------------------------------------------------------------
+static void DeallocateLarge (MemoryBlock* pkBlock)
+{
+    MemoryLarge* pkLarge = (MemoryLarge*)pkBlock - 1;
+    Lock();
+    if (pkLarge->Prev)
+    {
+        pkLarge->Prev->Next = pkLarge->Next;
+    }
+    else
+    {
+        gs_pkLarge = pkLarge->Next;
+    }
+    if (pkLarge->Next)
+    {
+        pkLarge->Next->Prev = pkLarge->Prev;
+    }
+    gs_uiLargeReserved -= sizeof(MemoryLarge) + sizeof(MemoryBlock) +
+        pkLarge->Size;
+    Unlock();
+    free(pkLarge);
+}
+//----------------------------------------------------------------------------
+static MemoryBlock* AllocateSystem (size_t uiSize)
+{
+    if (uiSize > ~(size_t)0 - sizeof(MemoryBlock))
+    {
+        return 0;
+    }
+    MemoryBlock* pkBlock = (MemoryBlock*)malloc(sizeof(MemoryBlock) + uiSize);
+    if (!pkBlock)
+    {
+        return 0;
+    }
+    pkBlock->SystemSize = uiSize;
+    pkBlock->Size = 0;
+    pkBlock->Class = SYSTEM_BLOCK;
+    return pkBlock;
+}
+//----------------------------------------------------------------------------
+static int CompareRecords (const void* pvRecord0, const void* pvRecord1)
+{
+    const MemoryRecord* pkRecord0 = (const MemoryRecord*)pvRecord0;
+    const MemoryRecord* pkRecord1 = (const MemoryRecord*)pvRecord1;
+    int iCompare = strcmp(pkRecord0->File,pkRecord1->File);
+    if (iCompare != 0)
+    {
+        return iCompare;
+    }
+    if (pkRecord0->Line != pkRecord1->Line)
+    {
+        return (pkRecord0->Line < pkRecord1->Line ? -1 : 1);
+    }
+    return 0;
+}
+
+//----------------------------------------------------------------------------
+// Memory
+//----------------------------------------------------------------------------
+void* Memory::Allocate (size_t uiSize, const char* acFile,
+    unsigned int uiLine, bool bIsArray)
+{
+    MemoryCache* pkCache = GetThreadCache();
+    if (!pkCache)
+    {
+        pkCache = CreateThreadCache();
+        if (!pkCache)
+        {
+            return 0;
+        }
+    }
+
+    MemoryBlock* pkBlock;
+    int iClass;
+    if (uiSize <= MAX_SMALL)
+    {
+        iClass = gs_aucClassOf[(uiSize + 15) >> 4];
+        if (ms_bPooling)
+        {
+            pkBlock = pkCache->Free[iClass];
+            if (!pkBlock)
+            {
+                pkBlock = Refill(pkCache,iClass);
+                if (!pkBlock)
+                {
+                    return 0;
+                }
+            }
+            pkCache->Free[iClass] = pkBlock->NextFree();
+            pkCache->FreeQuantity[iClass]--;
+            pkBlock->Size = (unsigned short)uiSize;
+        }
+        else
+        {
+            pkBlock = AllocateSystem(uiSize);
+        }
+    }
+    else
+    {
+        iClass = LARGE_CLASS;
+        if (ms_bPooling)
+        {
+            pkBlock = AllocateLarge(uiSize);
+        }
+        else
+        {
+            pkBlock = AllocateSystem(uiSize);
+        }
+    }
+    if (!pkBlock)
+    {
+        return 0;
+    }
+
+    if (pkBlock->Class != SYSTEM_BLOCK)
+    {
+        pkBlock->File = acFile;
+    }
+    pkBlock->Line = uiLine;
+    pkBlock->Flags = (unsigned char)(bIsArray ? BLOCK_LIVE | BLOCK_ARRAY
+        : BLOCK_LIVE);
+    if (pkCache->StaticDepth > 0)
+    {
+        pkBlock->Flags |= BLOCK_STATIC;
+    }
+
+    pkCache->Allocations[iClass]++;
+    pkCache->Bytes += (ptrdiff_t)uiSize;
+    if ((++pkCache->Sample & SAMPLE_MASK) == 0 || iClass == LARGE_CLASS)
+    {
+        SamplePeak();
+    }
+    return pkBlock + 1;
+}
+//----------------------------------------------------------------------------
+void Memory::Deallocate (void* pvAddr, bool bIsArray)
+{
+    if (!pvAddr)
+    {
+        return;
+    }
+
+    MemoryBlock* pkBlock = (MemoryBlock*)pvAddr - 1;
+
+    // The block is not live when it was freed before or was not allocated
+    // by the manager.  The array flag catches new[] freed by delete.
+    assert((pkBlock->Flags & BLOCK_LIVE) != 0);
+    assert(((pkBlock->Flags & BLOCK_ARRAY) != 0) == bIsArray);
+    (void)bIsArray;
+    pkBlock->Flags = 0;
+
+    MemoryCache* pkCache = GetThreadCache();
+    if (!pkCache)
+    {
+        pkCache = CreateThreadCache();
+    }
+
+    int iClass = pkBlock->Class;
+    size_t uiSize;
+    if (iClass < CLASS_QUANTITY)
+    {
+        uiSize = pkBlock->Size;
+        if (!pkCache)
+        {
+            // no memory for a cache, return the block to its pool
+            Lock();
+            pkBlock->NextFree() = gs_akPool[iClass].Free;
+            gs_akPool[iClass].Free = pkBlock;
+            Unlock();
+            return;
+        }
+        pkBlock->NextFree() = pkCache->Free[iClass];
+        pkCache->Free[iClass] = pkBlock;
+        if (++pkCache->FreeQuantity[iClass] == 2*BATCH)
+        {
+            Flush(pkCache,iClass);
+        }
+    }
+    else if (iClass == LARGE_BLOCK)
+    {
+        uiSize = ((MemoryLarge*)pkBlock - 1)->Size;
+        iClass = LARGE_CLASS;
+        DeallocateLarge(pkBlock);
+    }
+    else
+    {
+        uiSize = pkBlock->SystemSize;
+        iClass = (uiSize <= MAX_SMALL ? gs_aucClassOf[(uiSize + 15) >> 4]
+            : (int)LARGE_CLASS);
+        free(pkBlock);
+    }
+
+    if (pkCache)
+    {
+        pkCache->Frees[iClass]++;
+        pkCache->Bytes -= (ptrdiff_t)uiSize;
+    }
+}
+//----------------------------------------------------------------------------
+void Memory::SetPooling (bool bPooling)
+{
+    ms_bPooling = bPooling;
+}
+//----------------------------------------------------------------------------
+bool Memory::GetPooling ()
+{
+    return ms_bPooling;
+}
+//----------------------------------------------------------------------------
+size_t Memory::GetLiveBytes ()
+{
+    return SumLiveBytes();
+}
+//----------------------------------------------------------------------------
+size_t Memory::GetPeakBytes ()
+{
+    SamplePeak();
+    return gs_uiPeak;
+}
+//----------------------------------------------------------------------------
+void Memory::ResetPeakBytes ()
+{
+    gs_uiPeak = SumLiveBytes();
+}
+//----------------------------------------------------------------------------
+size_t Memory::GetLiveBlocks ()
+{
+    size_t uiBlocks = 0;
+    for (int iClass = 0; iClass <= LARGE_CLASS; iClass++)
+    {
+        uiBlocks += GetClassLiveBlocks(iClass);
+    }
+    return uiBlocks;
+}
+//----------------------------------------------------------------------------
+size_t Memory::GetReservedBytes ()
+{
+    Lock();
+    size_t uiBytes = gs_uiLargeReserved;
+    for (int iClass = 0; iClass < CLASS_QUANTITY; iClass++)
+    {
+        uiBytes += (size_t)gs_akPool[iClass].PageQuantity*PAGE_SIZE;
+    }
+    Unlock();
+    return uiBytes;
+}
+//----------------------------------------------------------------------------
+int Memory::GetClassSize (int iClass)
+{
+    assert(0 <= iClass && iClass <= LARGE_CLASS);
+    return (iClass < CLASS_QUANTITY ? gs_aiClassSize[iClass] : 0);
+}
+//----------------------------------------------------------------------------
+size_t Memory::GetClassLiveBlocks (int iClass)
+{
+    assert(0 <= iClass && iClass <= LARGE_CLASS);
+    size_t uiBlocks = 0;
+    for (MemoryCache* pkCache = gs_pkCaches; pkCache; pkCache = pkCache->Next)
+    {
+        uiBlocks += pkCache->Allocations[iClass] - pkCache->Frees[iClass];
+    }
+    return uiBlocks;
+}
+//----------------------------------------------------------------------------
+size_t Memory::GetClassAllocations (int iClass)
+{
+    assert(0 <= iClass && iClass <= LARGE_CLASS);
+    size_t uiAllocations = 0;
+    for (MemoryCache* pkCache = gs_pkCaches; pkCache; pkCache = pkCache->Next)
+    {
+        uiAllocations += pkCache->Allocations[iClass];
+    }
+    return uiAllocations;
+}
+//----------------------------------------------------------------------------
+void Memory::BeginFrame ()
+{
+    for (int iClass = 0; iClass <= LARGE_CLASS; iClass++)
+    {
+        gs_auiFrameBase[iClass] = GetClassAllocations(iClass);
+    }
+}
+//----------------------------------------------------------------------------
+size_t Memory::GetFrameAllocations (int iClass)
+{
+    return GetClassAllocations(iClass) - gs_auiFrameBase[iClass];
+}
+//----------------------------------------------------------------------------
+void Memory::MarkStatics ()
+{
+    Lock();
+    for (int iClass = 0; iClass < CLASS_QUANTITY; iClass++)
+    {
+        int iStride = (int)sizeof(MemoryBlock) + gs_aiClassSize[iClass];
+        int iQuantity = (PAGE_SIZE - (int)sizeof(MemoryPage))/iStride;
+        MemoryPage* pkPage = gs_akPool[iClass].Pages;
+        for (/**/; pkPage; pkPage = pkPage->Next)
+        {
+            char* acBlock = (char*)(pkPage + 1);
+            for (int i = 0; i < iQuantity; i++, acBlock += iStride)
+            {
+                MemoryBlock* pkBlock = (MemoryBlock*)acBlock;
+                if (pkBlock->Flags & BLOCK_LIVE)
+                {
+                    pkBlock->Flags |= BLOCK_STATIC;
+                }
+            }
+        }
+    }
+    for (MemoryLarge* pkLarge = gs_pkLarge; pkLarge; pkLarge = pkLarge->Next)
+    {
+        ((MemoryBlock*)(pkLarge + 1))->Flags |= BLOCK_STATIC;
+    }
+    Unlock();
+}
+//----------------------------------------------------------------------------
+void Memory::BeginStatic ()
+{
+    MemoryCache* pkCache = GetThreadCache();
+    if (!pkCache)
+    {
+        pkCache = CreateThreadCache();
+    }
+    if (pkCache)
+    {
+        pkCache->StaticDepth++;
+    }
+}
+//----------------------------------------------------------------------------
+void Memory::EndStatic ()
+{
+    MemoryCache* pkCache = GetThreadCache();
+    if (pkCache && pkCache->StaticDepth > 0)
+    {
+        pkCache->StaticDepth--;
+    }
+}
+//----------------------------------------------------------------------------
+void Memory::SetReportFile (const char* acFilename)
+{
+    if (acFilename)
+    {
+        strncpy(gs_acReportFile,acFilename,sizeof(gs_acReportFile)-1);
+        gs_acReportFile[sizeof(gs_acReportFile)-1] = 0;
+    }
+    else
+    {
+        gs_acReportFile[0] = 0;
+    }
+}
+//----------------------------------------------------------------------------
+void Memory::GenerateReport (FILE* pkFile)
+{
+    // gather the live blocks of WG_NEW
+    Lock();
+    int iQuantity = 0, iMaxQuantity = 256;
+    MemoryRecord* akRecord = (MemoryRecord*)malloc(
+        iMaxQuantity*sizeof(MemoryRecord));
+    for (int iClass = 0; iClass <= LARGE_CLASS; iClass++)
+    {
+        int iStride = (int)sizeof(MemoryBlock);
+        int iBlocks = 0;
+        MemoryPage* pkPage = 0;
+        MemoryLarge* pkLarge = 0;
+        if (iClass < CLASS_QUANTITY)
+        {
+            iStride += gs_aiClassSize[iClass];
+            iBlocks = (PAGE_SIZE - (int)sizeof(MemoryPage))/iStride;
+            pkPage = gs_akPool[iClass].Pages;
+        }
+        else
+        {
+            pkLarge = gs_pkLarge;
+        }
+
+        // the blocks of a page, then of the next page, or the large blocks
+        char* acBlock = (pkPage ? (char*)(pkPage + 1) : 0);
+        int iBlock = 0;
+        while (akRecord && (pkPage || pkLarge))
+        {
+            MemoryBlock* pkBlock;
+            size_t uiSize;
+            if (pkPage)
+            {
+                pkBlock = (MemoryBlock*)acBlock;
+                uiSize = pkBlock->Size;
+                acBlock += iStride;
+                if (++iBlock == iBlocks)
+                {
+                    pkPage = pkPage->Next;
+                    acBlock = (pkPage ? (char*)(pkPage + 1) : 0);
+                    iBlock = 0;
+                }
+            }
+            else
+            {
+                pkBlock = (MemoryBlock*)(pkLarge + 1);
+                uiSize = pkLarge->Size;
+                pkLarge = pkLarge->Next;
+            }
+            if ((pkBlock->Flags & (BLOCK_LIVE | BLOCK_STATIC)) != BLOCK_LIVE
+            ||  !pkBlock->File)
+            {
+                continue;
+            }
+
+            if (iQuantity == iMaxQuantity)
+            {
+                iMaxQuantity *= 2;
+                MemoryRecord* akNew = (MemoryRecord*)realloc(akRecord,
+                    iMaxQuantity*sizeof(MemoryRecord));
+                if (!akNew)
+                {
+                    break;
+                }
+                akRecord = akNew;
+            }
+            akRecord[iQuantity].File = pkBlock->File;
+            akRecord[iQuantity].Line = pkBlock->Line;
+            akRecord[iQuantity].Size = uiSize;
+            iQuantity++;
+        }
+    }
+    Unlock();
+
+    fprintf(pkFile,"Memory report\n\n");
+    if (akRecord)
+    {
+        qsort(akRecord,iQuantity,sizeof(MemoryRecord),CompareRecords);
+        fprintf(pkFile,"live blocks of WG_NEW: %d\n",iQuantity);
+        for (int i0 = 0, i1; i0 < iQuantity; i0 = i1)
+        {
+            size_t uiBytes = 0;
+            for (i1 = i0; i1 < iQuantity
+            &&   CompareRecords(&akRecord[i0],&akRecord[i1]) == 0; i1++)
+            {
+                uiBytes += akRecord[i1].Size;
+            }
+            fprintf(pkFile,"  %s(%u): %d blocks, %lu bytes\n",
+                akRecord[i0].File,akRecord[i0].Line,i1-i0,
+                (unsigned long)uiBytes);
+        }
+        free(akRecord);
+    }
+
+    fprintf(pkFile,"\nlive bytes %lu, peak %lu, live blocks %lu, "
+        "reserved bytes %lu\n",(unsigned long)GetLiveBytes(),
+        (unsigned long)GetPeakBytes(),(unsigned long)GetLiveBlocks(),
+        (unsigned long)GetReservedBytes());
+    fprintf(pkFile,"class  size  live blocks  allocations  pages\n");
+    for (int iClass = 0; iClass <= LARGE_CLASS; iClass++)
+    {
+        int iPages = (iClass < CLASS_QUANTITY ?
+            gs_akPool[iClass].PageQuantity : 0);
+        fprintf(pkFile,"%5d  %4d  %11lu  %11lu  %5d\n",iClass,
+            GetClassSize(iClass),(unsigned long)GetClassLiveBlocks(iClass),
+            (unsigned long)GetClassAllocations(iClass),iPages);
+    }
+}
+//----------------------------------------------------------------------------
+bool Memory::GenerateReport (const char* acFilename)
+{
+    FILE* pkFile = fopen(acFilename,"wt");
+    if (!pkFile)
+    {
+        return false;
+    }
+    GenerateReport(pkFile);
+    fclose(pkFile);
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// operators
+//----------------------------------------------------------------------------
+void* operator new (size_t uiSize) WG_THROW_BAD_ALLOC
+{
+    void* pvAddr = Memory::Allocate(uiSize,0,0,false);
+    if (!pvAddr)
+    {
+        throw std::bad_alloc();
+    }
+    return pvAddr;
+}
+//----------------------------------------------------------------------------
+void* operator new[] (size_t uiSize) WG_THROW_BAD_ALLOC
+{
+    void* pvAddr = Memory::Allocate(uiSize,0,0,true);
+    if (!pvAddr)
+    {
+        throw std::bad_alloc();
+    }
+    return pvAddr;
+}
+//----------------------------------------------------------------------------
+void* operator new (size_t uiSize, const std::nothrow_t&) WG_THROW_NOTHING
+{
+    return Memory::Allocate(uiSize,0,0,false);
+}
+//----------------------------------------------------------------------------
+void* operator new[] (size_t uiSize, const std::nothrow_t&) WG_THROW_NOTHING
+{
+    return Memory::Allocate(uiSize,0,0,true);
+}
+//----------------------------------------------------------------------------
+void* operator new (size_t uiSize, const char* acFile, unsigned int uiLine)
+{
+    void* pvAddr = Memory::Allocate(uiSize,acFile,uiLine,false);
+    if (!pvAddr)
+    {
+        throw std::bad_alloc();
+    }
+    return pvAddr;
+}
+//----------------------------------------------------------------------------
+void* operator new[] (size_t uiSize, const char* acFile,
+    unsigned int uiLine)
+{
+    void* pvAddr = Memory::Allocate(uiSize,acFile,uiLine,true);
+    if (!pvAddr)
+    {
+        throw std::bad_alloc();
+    }
+    return pvAddr;
+}
+//----------------------------------------------------------------------------
+void operator delete (void* pvAddr) WG_THROW_NOTHING
+{
+    Memory::Deallocate(pvAddr,false);
+}
+//----------------------------------------------------------------------------
+void operator delete[] (void* pvAddr) WG_THROW_NOTHING
+{
+    Memory::Deallocate(pvAddr,true);
+}
+//----------------------------------------------------------------------------
+void operator delete (void* pvAddr, const std::nothrow_t&) WG_THROW_NOTHING
+{
+    Memory::Deallocate(pvAddr,false);
+}
+//----------------------------------------------------------------------------
+void operator delete[] (void* pvAddr, const std::nothrow_t&)
+    WG_THROW_NOTHING
+{
+    Memory::Deallocate(pvAddr,true);
+}
+//----------------------------------------------------------------------------
+void operator delete (void* pvAddr, const char*, unsigned int)
+{
+    Memory::Deallocate(pvAddr,false);
+}
+//----------------------------------------------------------------------------
+void operator delete[] (void* pvAddr, const char*, unsigned int)
+{
+    Memory::Deallocate(pvAddr,true);
+}
+//----------------------------------------------------------------------------
+
+#endif //WG_MEMORY_MANAGER
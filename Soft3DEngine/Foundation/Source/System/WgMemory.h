@@ -20,9 +20,118 @@
 
 #else //WG_MEMORY_MANAGER
 
-// Use the default memory manager.
-#define WG_NEW new
+#include "WgFoundationLIB.h"
+#include <cstddef>
+#include <cstdio>
+
+namespace WGSoft3D
+{
+
+// The memory manager of the engine.  It replaces the global operators new
+// and delete, so it serves every allocation of the program, and WG_NEW
+// records the file and the line of the allocation for the leak report.
+//
+// Requests of up to MAX_SMALL bytes (list nodes, bounding volumes, pick
+// records, strings) are served by pools of fixed size blocks, one pool per
+// size class.  A pool takes pages of PAGE_SIZE bytes from the system heap
+// and never returns them.  Every thread keeps a cache of free blocks per
+// size class, so an allocation or a deallocation is a push or a pop on a
+// list of the calling thread.  A thread exchanges batches of blocks with
+// the pool under a lock when its cache runs empty or full.  A block may be
+// freed by a thread other than the one that allocated it.  The blocks that
+// are cached by a thread that exits stay reserved.
+//
+// Larger requests (the data of arrays) are blocks of the system heap that
+// are linked for the report.  Every block has a header of 16 bytes.
+//
+// The manager exists only when WG_MEMORY_MANAGER is defined for the whole
+// build.  Otherwise WG_NEW and WG_DELETE are the operators of the compiler.
+// The operators are replaced in the module that links the manager, so use
+// it with the static libraries, not with the DLL.
+
+class WG3D_FOUNDATION_ITEM Memory
+{
+public:
+    enum
+    {
+        CLASS_QUANTITY = 16,   // the size classes of the pools
+        LARGE_CLASS = 16,      // the class of the statistics of large blocks
+        MAX_SMALL = 512,       // the largest request served by a pool
+        PAGE_SIZE = 65536      // the bytes a pool takes at a time
+    };
+
+    // The operators call these.  The file is null for the allocations that
+    // do not come from WG_NEW.
+    static void* Allocate (size_t uiSize, const char* acFile,
+        unsigned int uiLine, bool bIsArray);
+    static void Deallocate (void* pvAddr, bool bIsArray);
+
+    // When pooling is off, every request is a block of the system heap, for
+    // a comparison with the pools.  The blocks allocated in either mode may
+    // be freed in the other.  The default is on.
+    static void SetPooling (bool bPooling);
+    static bool GetPooling ();
+
+    // The statistics.  The live bytes are the bytes requested by the blocks
+    // that were not freed.  The peak is sampled when a thread exchanges a
+    // batch with a pool, at every large block and at every 64th allocation
+    // of a thread, so it may miss a short peak by less than 64 small
+    // blocks per thread.  The reserved bytes are the pages of the pools and
+    // the large blocks with their headers; the blocks allocated without
+    // pooling are not included.
+    static size_t GetLiveBytes ();
+    static size_t GetPeakBytes ();
+    static void ResetPeakBytes ();
+    static size_t GetLiveBlocks ();
+    static size_t GetReservedBytes ();
+
+    // The size classes.  GetClassSize is the largest request of a class
+    // (0 for LARGE_CLASS, which counts the requests above MAX_SMALL).
+    static int GetClassSize (int iClass);
+    static size_t GetClassLiveBlocks (int iClass);
+    static size_t GetClassAllocations (int iClass);
+
+    // The allocations of each class since the most recent BeginFrame.
+    static void BeginFrame ();
+    static size_t GetFrameAllocations (int iClass);
+
+    // The leak report lists the live blocks that were allocated by WG_NEW,
+    // grouped by file and line, followed by the statistics.  It is written
+    // at the exit of the program when blocks of WG_NEW are live, to the
+    // file set by SetReportFile or else to stderr.  GenerateReport may be
+    // called at any time when no other thread allocates.
+    //
+    // Static blocks are not listed.  MarkStatics makes every live block
+    // static; call it at the start of main, so the blocks of the static
+    // constructors, which may be freed after the report, are not listed.
+    // The blocks that the calling thread allocates between BeginStatic and
+    // EndStatic are static too.  The engine allocates its own statics so
+    // (the table of Object::InUse and the default global states).  The
+    // calls nest.
+    static void MarkStatics ();
+    static void BeginStatic ();
+    static void EndStatic ();
+
+    static void SetReportFile (const char* acFilename);
+    static void GenerateReport (FILE* pkFile);
+    static bool GenerateReport (const char* acFilename);
+
+private:
+    static bool ms_bPooling;
+};
+
+}
+
+#define WG_NEW new(__FILE__,__LINE__)
 #define WG_DELETE delete
+
+void* operator new (size_t uiSize, const char* acFile, unsigned int uiLine);
+void* operator new[] (size_t uiSize, const char* acFile,
+    unsigned int uiLine);
+void operator delete (void* pvAddr, const char* acFile, unsigned int uiLine);
+void operator delete[] (void* pvAddr, const char* acFile,
+    unsigned int uiLine);
+
 #endif //WG_MEMORY_MANAGER
 
-#endif //__WG_MEMORY_H__
\ No newline at end of file
+#endif //__WG_MEMORY_H__
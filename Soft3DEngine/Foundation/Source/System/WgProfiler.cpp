@@ -0,0 +1,335 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgProfiler.cpp                     //
+//                                                       //
+//  - Implementation for Profiler class                  //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgProfiler.h"
+using namespace WGSoft3D;
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+volatile bool Profiler::ms_bEnabled = false;
+int Profiler::ms_iRingCapacity = 16384;
+
+//----------------------------------------------------------------------------
+// platform layer
+//----------------------------------------------------------------------------
+namespace WGSoft3D
+{
+
+class ProfileEvent
+{
+public:
+    const char* Name;
+    unsigned __int64 Start, End;
+};
+
+// The events of one thread.  Only that thread writes them.  Written counts
+// all the events ever recorded, the newest is at (Written-1) & Mask.
+class ProfileRing
+{
+public:
+    ProfileRing (int iCapacity, int iThread)
+    {
+        Event = WG_NEW ProfileEvent[iCapacity];
+        Mask = (unsigned int)(iCapacity - 1);
+        Written = 0;
+        Thread = iThread;
+        Name = 0;
+        Next = 0;
+    }
+
+    ~ProfileRing ()
+    {
+        WG_DELETE[] Event;
+    }
+
+    int GetQuantity () const
+    {
+        return (Written > Mask ? (int)Mask + 1 : (int)Written);
+    }
+
+    ProfileEvent* Event;
+    unsigned int Mask;
+    volatile unsigned int Written;
+    int Thread;
+    const char* Name;
+    ProfileRing* Next;
+};
+
+// The list of the rings of all threads.  A ring is added when its thread
+// records first and stays until the program ends, so the events of the
+// threads that exit remain in the trace.
+class ProfileRingList
+{
+public:
+    ProfileRingList ()
+    {
+#if defined(_WIN32)
+        InitializeCriticalSection(&m_kSection);
+#else
+        pthread_mutex_init(&m_kMutex,0);
+#endif
+        First = 0;
+        Quantity = 0;
+    }
+
+    ~ProfileRingList ()
+    {
+        while (First)
+        {
+            ProfileRing* pkNext = First->Next;
+            WG_DELETE First;
+            First = pkNext;
+        }
+#if defined(_WIN32)
+        DeleteCriticalSection(&m_kSection);
+#else
+        pthread_mutex_destroy(&m_kMutex);
+#endif
+    }
+
+    void Enter ()
+    {
+#if defined(_WIN32)
+        EnterCriticalSection(&m_kSection);
+#else
+        pthread_mutex_lock(&m_kMutex);
+#endif
+    }
+
+    void Leave ()
+    {
+#if defined(_WIN32)
+        LeaveCriticalSection(&m_kSection);
+#else
+        pthread_mutex_unlock(&m_kMutex);
+#endif
+    }
+
+    ProfileRing* First;
+    int Quantity;
+
+private:
+#if defined(_WIN32)
+    CRITICAL_SECTION m_kSection;
+#else
+    pthread_mutex_t m_kMutex;
+#endif
+};
+
+}
+
+static ProfileRingList gs_kRings;
+
+// the ring of the calling thread, null until the thread records
+#if defined(_WIN32_WCE)
+static DWORD gs_dwRingSlot = TlsAlloc();
+static ProfileRing* GetThreadRing ()
+{
+    return (ProfileRing*)TlsGetValue(gs_dwRingSlot);
+}
+static void SetThreadRing (ProfileRing* pkRing)
+{
+    TlsSetValue(gs_dwRingSlot,pkRing);
+}
+#else
+#if defined(_MSC_VER)
+static __declspec(thread) ProfileRing* gs_pkThreadRing = 0;
+#else
+static __thread ProfileRing* gs_pkThreadRing = 0;
+#endif
+static ProfileRing* GetThreadRing ()
+{
+    return gs_pkThreadRing;
+}
+static void SetThreadRing (ProfileRing* pkRing)
+{
+    gs_pkThreadRing = pkRing;
+}
+#endif
+
+// the calibration of the ticks, taken by the first Enable(true)
+static bool gs_bCalibrated = false;
+static unsigned __int64 gs_uiBaseTicks = 0;
+static double gs_dBaseTime = 0.0;
+
+//----------------------------------------------------------------------------
+static ProfileRing* CreateThreadRing ()
+{
+    gs_kRings.Enter();
+    ProfileRing* pkRing = WG_NEW ProfileRing(Profiler::GetRingCapacity(),
+        gs_kRings.Quantity++);
+    pkRing->Next = gs_kRings.First;
+    gs_kRings.First = pkRing;
+    gs_kRings.Leave();
+
+    SetThreadRing(pkRing);
+    return pkRing;
+}
+//----------------------------------------------------------------------------
+static void WriteString (FILE* pkFile, const char* acString)
+{
+    fputc('"',pkFile);
+    for (const char* pcChar = acString; *pcChar; pcChar++)
+    {
+        if (*pcChar == '"' || *pcChar == '\\')
+        {
+            fputc('\\',pkFile);
+        }
+        fputc(*pcChar,pkFile);
+    }
+    fputc('"',pkFile);
+}
+//----------------------------------------------------------------------------
+// Profiler
+//----------------------------------------------------------------------------
+void Profiler::Enable (bool bEnabled)
+{
+    if (bEnabled && !gs_bCalibrated)
+    {
+        gs_bCalibrated = true;
+        gs_dBaseTime = System::GetPreciseTime();
+        gs_uiBaseTicks = GetTicks();
+    }
+    ms_bEnabled = bEnabled;
+}
+//----------------------------------------------------------------------------
+void Profiler::SetRingCapacity (int iCapacity)
+{
+    // round up to a power of two, the rings index with a mask
+    assert(iCapacity > 0);
+    int iPower = 1;
+    while (iPower < iCapacity)
+    {
+        iPower <<= 1;
+    }
+    ms_iRingCapacity = iPower;
+}
+//----------------------------------------------------------------------------
+void Profiler::SetThreadName (const char* acName)
+{
+    ProfileRing* pkRing = GetThreadRing();
+    if (!pkRing)
+    {
+        pkRing = CreateThreadRing();
+    }
+    pkRing->Name = acName;
+}
+//----------------------------------------------------------------------------
+void Profiler::Clear ()
+{
+    gs_kRings.Enter();
+    for (ProfileRing* pkRing = gs_kRings.First; pkRing; pkRing = pkRing->Next)
+    {
+        pkRing->Written = 0;
+    }
+    gs_kRings.Leave();
+}
+//----------------------------------------------------------------------------
+int Profiler::GetEventQuantity ()
+{
+    int iQuantity = 0;
+    gs_kRings.Enter();
+    for (ProfileRing* pkRing = gs_kRings.First; pkRing; pkRing = pkRing->Next)
+    {
+        iQuantity += pkRing->GetQuantity();
+    }
+    gs_kRings.Leave();
+    return iQuantity;
+}
+//----------------------------------------------------------------------------
+void Profiler::Record (const char* acName, unsigned __int64 uiStart,
+    unsigned __int64 uiEnd)
+{
+    ProfileRing* pkRing = GetThreadRing();
+    if (!pkRing)
+    {
+        pkRing = CreateThreadRing();
+    }
+
+    ProfileEvent& rkEvent = pkRing->Event[pkRing->Written & pkRing->Mask];
+    rkEvent.Name = acName;
+    rkEvent.Start = uiStart;
+    rkEvent.End = uiEnd;
+    pkRing->Written++;
+}
+//----------------------------------------------------------------------------
+double Profiler::GetTicksPerMicrosecond ()
+{
+    double dElapsed = System::GetPreciseTime() - gs_dBaseTime;
+    unsigned __int64 uiTicks = GetTicks() - gs_uiBaseTicks;
+    if (!gs_bCalibrated || dElapsed <= 0.0 || uiTicks == 0)
+    {
+        // the nanoseconds of the portable counter
+        return 1000.0;
+    }
+    return (double)(__int64)uiTicks/(1e6*dElapsed);
+}
+//----------------------------------------------------------------------------
+bool Profiler::WriteTrace (const char* acFilename)
+{
+    FILE* pkFile = fopen(acFilename,"wt");
+    if (!pkFile)
+    {
+        return false;
+    }
+    WriteTrace(pkFile);
+    fclose(pkFile);
+    return true;
+}
+//----------------------------------------------------------------------------
+void Profiler::WriteTrace (FILE* pkFile)
+{
+    double dInvTicks = 1.0/GetTicksPerMicrosecond();
+    bool bFirst = true;
+
+    fprintf(pkFile,"{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    gs_kRings.Enter();
+    for (ProfileRing* pkRing = gs_kRings.First; pkRing; pkRing = pkRing->Next)
+    {
+        if (pkRing->Name)
+        {
+            fprintf(pkFile,"%s\n{\"name\":\"thread_name\",\"ph\":\"M\","
+                "\"pid\":1,\"tid\":%d,\"args\":{\"name\":",bFirst ? "" : ",",
+                pkRing->Thread);
+            WriteString(pkFile,pkRing->Name);
+            fprintf(pkFile,"}}");
+            bFirst = false;
+        }
+
+        // oldest event first
+        int iQuantity = pkRing->GetQuantity();
+        unsigned int uiFirst = pkRing->Written - (unsigned int)iQuantity;
+        for (int i = 0; i < iQuantity; i++)
+        {
+            const ProfileEvent& rkEvent =
+                pkRing->Event[(uiFirst + i) & pkRing->Mask];
+
+            // the ticks relative to the calibration, signed in case of
+            // events recorded before it
+            double dStart = dInvTicks*
+                (double)(__int64)(rkEvent.Start - gs_uiBaseTicks);
+            double dDuration = dInvTicks*
+                (double)(__int64)(rkEvent.End - rkEvent.Start);
+
+            fprintf(pkFile,"%s\n{\"name\":",bFirst ? "" : ",");
+            WriteString(pkFile,rkEvent.Name);
+            fprintf(pkFile,",\"cat\":\"wg3d\",\"ph\":\"X\",\"pid\":1,"
+                "\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",pkRing->Thread,dStart,
+                dDuration);
+            bFirst = false;
+        }
+    }
+    gs_kRings.Leave();
+    fprintf(pkFile,"\n]}\n");
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgProfiler.h                       //
+//                                                       //
+//  - Interface for Profiler class                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG3D_PROFILER_H__
+#define __WG3D_PROFILER_H__
+
+#include "WgFoundationLIB.h"
+#include "WgSystem.h"
+
+// the time stamp counter is read directly on x86
+#if defined(_MSC_VER) && _MSC_VER >= 1400 \
+&&  (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#define WG3D_PROFILER_RDTSC
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define WG3D_PROFILER_RDTSC
+#endif
+
+// The profiler exists only when WG3D_PROFILER is defined for the whole
+// build.  Otherwise WG3D_PROFILE expands to nothing.  WG3D_PROFILE times the
+// rest of the enclosing block; use at most one per block.  The name must be
+// a string that lives as long as the captured events, normally a literal.
+#ifdef WG3D_PROFILER
+#define WG3D_PROFILE(acName) ProfileScope kProfileScope(acName)
+#else
+#define WG3D_PROFILE(acName)
+#endif
+
+namespace WGSoft3D
+{
+
+// A capture of timed scopes for chrome://tracing and Perfetto.  Each thread
+// that records gets its own ring of events when it records first, so the
+// threads never wait for each other while recording:  a scope only reads
+// the tick counter twice and writes one event to the ring of its thread.
+// When a ring is full the oldest events are overwritten.  The events are
+// kept as complete events (name, start, end); the viewer nests them by time.
+//
+// Recording is off until Enable(true).  WriteTrace must be called while no
+// thread records, for example after Enable(false) between frames.
+
+class WG3D_FOUNDATION_ITEM Profiler
+{
+public:
+    // Start or stop recording.  The first start calibrates the ticks
+    // against System::GetPreciseTime.
+    static void Enable (bool bEnabled);
+    static bool IsEnabled ();
+
+    // The events per thread ring.  Rings created before the call keep their
+    // size.  The default is 16384 events (384 KB per thread).
+    static void SetRingCapacity (int iCapacity);
+    static int GetRingCapacity ();
+
+    // A name for the calling thread in the trace.
+    static void SetThreadName (const char* acName);
+
+    // Discard the recorded events of all threads.
+    static void Clear ();
+
+    // the number of events held by the rings of all threads
+    static int GetEventQuantity ();
+
+    // Write the events as a Chrome trace_event JSON object.
+    static bool WriteTrace (const char* acFilename);
+    static void WriteTrace (FILE* pkFile);
+
+    // A counter of the platform:  the time stamp counter on x86, otherwise
+    // nanoseconds of System::GetPreciseTime.
+    static unsigned __int64 GetTicks ();
+
+    // Store an event in the ring of the calling thread.
+    static void Record (const char* acName, unsigned __int64 uiStart,
+        unsigned __int64 uiEnd);
+
+private:
+    static double GetTicksPerMicrosecond ();
+
+    static volatile bool ms_bEnabled;
+    static int ms_iRingCapacity;
+};
+
+// The timer of WG3D_PROFILE.  It records when the profiler was enabled at
+// its construction.
+class ProfileScope
+{
+public:
+    ProfileScope (const char* acName);
+    ~ProfileScope ();
+
+private:
+    const char* m_acName;
+    unsigned __int64 m_uiStart;
+};
+
+#include "WgProfiler.inl"
+
+}
+
+#endif
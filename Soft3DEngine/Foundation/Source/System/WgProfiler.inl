@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgProfiler.inl                     //
+//                                                       //
+//  - Inlines for Profiler class                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+inline bool Profiler::IsEnabled ()
+{
+    return ms_bEnabled;
+}
+//----------------------------------------------------------------------------
+inline int Profiler::GetRingCapacity ()
+{
+    return ms_iRingCapacity;
+}
+//----------------------------------------------------------------------------
+inline unsigned __int64 Profiler::GetTicks ()
+{
+#if defined(WG3D_PROFILER_RDTSC) && defined(_MSC_VER)
+    return (unsigned __int64)__rdtsc();
+#elif defined(WG3D_PROFILER_RDTSC)
+    unsigned int uiLo, uiHi;
+    __asm__ __volatile__ ("rdtsc" : "=a" (uiLo), "=d" (uiHi));
+    return ((unsigned __int64)uiHi << 32) | uiLo;
+#else
+    return (unsigned __int64)(System::GetPreciseTime()*1e9);
+#endif
+}
+//----------------------------------------------------------------------------
+inline ProfileScope::ProfileScope (const char* acName)
+{
+    if (Profiler::IsEnabled())
+    {
+        m_acName = acName;
+        m_uiStart = Profiler::GetTicks();
+    }
+    else
+    {
+        m_acName = 0;
+    }
+}
+//----------------------------------------------------------------------------
+inline ProfileScope::~ProfileScope ()
+{
+    if (m_acName)
+    {
+        Profiler::Record(m_acName,m_uiStart,Profiler::GetTicks());
+    }
+}
+//----------------------------------------------------------------------------
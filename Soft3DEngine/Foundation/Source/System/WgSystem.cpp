@@ -21,6 +21,14 @@ using namespace WGSoft3D;
 #include <time.h>
 #endif //_WIN32_WCE
 
+// support for GetPreciseTime
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/time.h>
+#include <time.h>
+#endif
+
 static long gs_lInitialSec = 0;
 static long gs_lInitialUSec = 0;
 static bool gs_bInitializedTime = false;
@@ -66,6 +74,51 @@ double System::GetTime ()
 }
 #endif //_WIN32_WCE
 //----------------------------------------------------------------------------
+double System::GetPreciseTime ()
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER s_kFrequency, s_kInitial;
+    static bool s_bInitialized = false;
+
+    LARGE_INTEGER kCounter;
+    QueryPerformanceCounter(&kCounter);
+    if (!s_bInitialized)
+    {
+        s_bInitialized = true;
+        QueryPerformanceFrequency(&s_kFrequency);
+        s_kInitial = kCounter;
+    }
+
+    return (double)(kCounter.QuadPart - s_kInitial.QuadPart)/
+        (double)s_kFrequency.QuadPart;
+#else
+    static long s_lInitialSec = 0;
+    static bool s_bInitialized = false;
+
+    long lSec, lNSec;
+#if defined(CLOCK_MONOTONIC)
+    struct timespec kTS;
+    clock_gettime(CLOCK_MONOTONIC,&kTS);
+    lSec = (long)kTS.tv_sec;
+    lNSec = (long)kTS.tv_nsec;
+#else
+    struct timeval kTV;
+    gettimeofday(&kTV,0);
+    lSec = (long)kTV.tv_sec;
+    lNSec = 1000*(long)kTV.tv_usec;
+#endif
+    if (!s_bInitialized)
+    {
+        s_bInitialized = true;
+        s_lInitialSec = lSec;
+    }
+
+    // The seconds are relative to the first call, so the double keeps the
+    // nanoseconds.
+    return (double)(lSec - s_lInitialSec) + 1e-09*(double)lNSec;
+#endif
+}
+//----------------------------------------------------------------------------
 void* System::Memcpy (void* pvDst, size_t uiDstSize, const void* pvSrc,
 					  size_t uiSrcSize)
 {
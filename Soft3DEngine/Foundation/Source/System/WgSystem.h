@@ -74,6 +74,12 @@ public:
 #ifndef _WIN32_WCE
     static double GetTime ();
 #endif //_WIN32_WCE
+
+    // A time with the resolution of the performance counter of the platform
+    // (return value is seconds since the first call).  GetTime has only
+    // millisecond resolution, too coarse for the timing of single calls.
+    static double GetPreciseTime ();
+
     // File support for buffer load and save.
 //     static bool Load (const char* acFilename, char*& racBuffer, int& riSize);
 //     static bool Save (const char* acFilename, const char* acBuffer,int iSize);
@@ -160,10 +166,15 @@ private:
 };
 }
 #include "WgFixed.h"
+#include "WgFixedMath.h"
 
+#include "WgFrameArena.h"
 #include "WgTArray.h"
+#include "WgTHashSet.h"
 #include "WgTHashTable.h"
 #include "WgTList.h"
+#include "WgTSmallArray.h"
+#include "WgTSmallUnorderedSet.h"
 #include "WgTStack.h"
 #include "WgString.h"
 
@@ -13,6 +13,8 @@
 #define __WG_TARRAY_H__
 
 #include "WgFoundationLIB.h"
+#include "WgFrameArena.h"
+#include "WgTRelocatable.h"
 
 // The class T is either native data or is class data that has the following
 // member functions:
@@ -27,12 +29,16 @@ template <class T>
 class TArray
 {
 public:
-    // construction and destruction
-    TArray (int iQuantity = 1, int iGrowBy = 1);
+    // Construction and destruction.  The elements are stored in the arena
+    // when one is given, otherwise on the heap.  The arena keeps the storage
+    // that the array outgrows until it is reset.  An array in an arena must
+    // be destroyed before the arena is reset or released to a mark taken
+    // before the construction.  A copy is stored on the heap.
+    TArray (int iQuantity = 1, int iGrowBy = 1, FrameArena* pkArena = 0);
     TArray (const TArray& rkObject);
     ~TArray ();
 
-    // assignment
+    // assignment, the array keeps its own arena
     TArray& operator= (const TArray& rkObject);
 
     // element access, index i must be in range
@@ -42,8 +48,17 @@ public:
     T& operator[] (int i);
     const T& operator[] (int i) const;
 
-    // add new element, array will dynamically grow if necessary
+    // Add new element, array will dynamically grow if necessary.  A full
+    // array grows by its capacity, but at least by the grow-by quantity, so
+    // appending n elements relocates O(n) elements.  Emplace adds an element
+    // with the default value and returns it to be filled in place, without
+    // the copy of Append.  An array that cannot grow (the grow-by quantity
+    // is zero) overwrites its last element instead.
     void Append (const T& rtElement);
+#ifdef WG3D_HAS_MOVE
+    void Append (T&& rtElement);
+#endif
+    T& Emplace ();
     void SetElement (int i, const T& rtElement);
 
     // Remove the element at the specified index.  The elements occurring
@@ -57,15 +72,34 @@ public:
     // all elements are set to the default object of class T
     void RemoveAll ();
 
-    // dynamic growth, new array elements are default constructed
+    // Dynamic growth, new array elements are default constructed.  Reserve
+    // makes room for iQuantity elements and keeps the elements.  The
+    // elements are relocated with memcpy when TRelocatable<T> allows it.
     void SetMaxQuantity (int iNewMaxQuantity, bool bCopy);
     int GetMaxQuantity () const;
+    void Reserve (int iQuantity);
     void SetGrowBy (int iGrowBy);
     int GetGrowBy () const;
 
+protected:
+    // For TSmallArray, the storage for iInlineQuantity elements is in the
+    // derived object.  It is used whenever the capacity fits in it.
+    TArray (T* atInline, int iInlineQuantity, int iGrowBy);
+
 private:
+    int GetGrownQuantity (int iMinQuantity) const;
+    void Reallocate (int iNewMaxQuantity, int iKeepQuantity);
+    T* Allocate (int iQuantity);
+    void Free (T* atArray);
+    static void Construct (T* atArray, int iQuantity);
+    static void Destroy (T* atArray, int iQuantity);
+    static void Relocate (T* atDst, T* atSrc, int iQuantity);
+
     int m_iQuantity, m_iMaxQuantity, m_iGrowBy;
     T* m_atArray;
+    FrameArena* m_pkArena;
+    T* m_atInline;
+    int m_iInlineQuantity;
 };
 
 #include "WgTArray.inl"
@@ -11,7 +11,7 @@
 
 //----------------------------------------------------------------------------
 template <class T>
-TArray<T>::TArray (int iQuantity, int iGrowBy)
+TArray<T>::TArray (int iQuantity, int iGrowBy, FrameArena* pkArena)
 {
     assert(iQuantity >= 0 && iGrowBy >= 0);
 
@@ -26,38 +26,75 @@ TArray<T>::TArray (int iQuantity, int iGrowBy)
     }
 
     m_iQuantity = 0;
-    m_iMaxQuantity = iQuantity;
+    m_iMaxQuantity = 0;
     m_iGrowBy = iGrowBy;
-    m_atArray = (m_iMaxQuantity > 0 ? WG_NEW T[m_iMaxQuantity] : 0);
+    m_atArray = 0;
+    m_pkArena = pkArena;
+    m_atInline = 0;
+    m_iInlineQuantity = 0;
+    if (iQuantity > 0)
+    {
+        Reallocate(iQuantity,0);
+    }
+}
+//----------------------------------------------------------------------------
+template <class T>
+TArray<T>::TArray (T* atInline, int iInlineQuantity, int iGrowBy)
+{
+    assert(iInlineQuantity > 0 && iGrowBy >= 0);
+
+    m_iQuantity = 0;
+    m_iMaxQuantity = 0;
+    m_iGrowBy = (iGrowBy > 0 ? iGrowBy : 0);
+    m_atArray = 0;
+    m_pkArena = 0;
+    m_atInline = atInline;
+    m_iInlineQuantity = iInlineQuantity;
+    Reallocate(iInlineQuantity,0);
 }
 //----------------------------------------------------------------------------
 template <class T>
 TArray<T>::TArray (const TArray& rkObject)
 {
+    m_iQuantity = 0;
+    m_iMaxQuantity = 0;
+    m_iGrowBy = 0;
     m_atArray = 0;
+    m_pkArena = 0;
+    m_atInline = 0;
+    m_iInlineQuantity = 0;
     *this = rkObject;
 }
 //----------------------------------------------------------------------------
 template <class T>
 TArray<T>::~TArray ()
 {
-    WG_DELETE[] m_atArray;
+    Destroy(m_atArray,m_iMaxQuantity);
+    Free(m_atArray);
 }
 //----------------------------------------------------------------------------
 template <class T>
 TArray<T>& TArray<T>::operator= (const TArray& rkObject)
 {
+    if (this == &rkObject)
+    {
+        return *this;
+    }
+
+    Destroy(m_atArray,m_iMaxQuantity);
+    Free(m_atArray);
+
     m_iQuantity = rkObject.m_iQuantity;
     m_iMaxQuantity = rkObject.m_iMaxQuantity;
     m_iGrowBy = rkObject.m_iGrowBy;
 
-    WG_DELETE[] m_atArray;
     if (m_iMaxQuantity > 0)
     {
-        m_atArray = WG_NEW T[m_iMaxQuantity];
+        m_atArray = (m_iMaxQuantity <= m_iInlineQuantity ? m_atInline :
+            Allocate(m_iMaxQuantity));
         for (int i = 0; i < m_iMaxQuantity; i++)
         {
-            m_atArray[i] = rkObject.m_atArray[i];
+            new(&m_atArray[i]) T(rkObject.m_atArray[i]);
         }
     }
     else
@@ -121,25 +158,69 @@ const T& TArray<T>::operator[] (int i) const
 template <class T>
 void TArray<T>::Append (const T& rtElement)
 {
-    if (++m_iQuantity > m_iMaxQuantity)
+    if (m_iQuantity == m_iMaxQuantity)
     {
         if (m_iGrowBy > 0)
         {
             // Increase the size of the array.  In the event rtElement is a
             // reference to something in the current array, the reallocation
-            // in SetMaxQuantity will invalidate the reference.  A copy of
-            // rtElement is made here to avoid the invalidation.
+            // will invalidate the reference.  A copy of rtElement is made
+            // here to avoid the invalidation.
             T tSaveElement(rtElement);
-            SetMaxQuantity(m_iMaxQuantity+m_iGrowBy,true);
-            m_atArray[m_iQuantity-1] = tSaveElement;
+            Reallocate(GetGrownQuantity(m_iQuantity+1),m_iMaxQuantity);
+            m_atArray[m_iQuantity++] = WG3D_MOVE(tSaveElement);
             return;
         }
 
         // cannot grow the array, overwrite the last element
-        --m_iQuantity;
+        m_atArray[m_iQuantity-1] = rtElement;
+        return;
     }
 
-    m_atArray[m_iQuantity-1] = rtElement;
+    m_atArray[m_iQuantity++] = rtElement;
+}
+//----------------------------------------------------------------------------
+#ifdef WG3D_HAS_MOVE
+template <class T>
+void TArray<T>::Append (T&& rtElement)
+{
+    if (m_iQuantity == m_iMaxQuantity)
+    {
+        if (m_iGrowBy > 0)
+        {
+            // rtElement may be in the current array, see above
+            T tSaveElement(std::move(rtElement));
+            Reallocate(GetGrownQuantity(m_iQuantity+1),m_iMaxQuantity);
+            m_atArray[m_iQuantity++] = std::move(tSaveElement);
+            return;
+        }
+
+        // cannot grow the array, overwrite the last element
+        m_atArray[m_iQuantity-1] = std::move(rtElement);
+        return;
+    }
+
+    m_atArray[m_iQuantity++] = std::move(rtElement);
+}
+#endif
+//----------------------------------------------------------------------------
+template <class T>
+T& TArray<T>::Emplace ()
+{
+    if (m_iQuantity == m_iMaxQuantity)
+    {
+        if (m_iGrowBy == 0)
+        {
+            // cannot grow the array, overwrite the last element
+            assert(m_iQuantity > 0);
+            m_atArray[m_iQuantity-1] = T();
+            return m_atArray[m_iQuantity-1];
+        }
+
+        Reallocate(GetGrownQuantity(m_iQuantity+1),m_iMaxQuantity);
+    }
+
+    return m_atArray[m_iQuantity++];
 }
 //----------------------------------------------------------------------------
 template <class T>
@@ -157,29 +238,19 @@ void TArray<T>::SetElement (int i, const T& rtElement)
         {
             if (m_iGrowBy > 0)
             {
-                // increase the size of the array
-                if (i+1 >= m_iMaxQuantity)
-                {
-                    int iN = 1 + (int)(0.5f+(i+1-m_iMaxQuantity) /
-                        (float)m_iGrowBy);
-
-                    // Increase the size of the array.  In the event rtElement
-                    // is a reference to something in the current array, the
-                    // reallocation in SetMaxQuantity will invalidate the
-                    // reference.  A copy of rtElement is made here to avoid
-                    // the invalidation.
-                    T tSaveElement(rtElement);
-                    SetMaxQuantity(m_iMaxQuantity+iN*m_iGrowBy,true);
-                    m_iQuantity = i+1;
-                    m_atArray[i] = tSaveElement;
-                    return;
-                }
-            }
-            else
-            {
-                // cannot grow the array, overwrite the last element
-                i = m_iQuantity-1;
+                // Increase the size of the array.  In the event rtElement is
+                // a reference to something in the current array, the
+                // reallocation will invalidate the reference.  A copy of
+                // rtElement is made here to avoid the invalidation.
+                T tSaveElement(rtElement);
+                Reallocate(GetGrownQuantity(i+1),m_iMaxQuantity);
+                m_iQuantity = i+1;
+                m_atArray[i] = WG3D_MOVE(tSaveElement);
+                return;
             }
+
+            // cannot grow the array, overwrite the last element
+            i = m_iQuantity-1;
         }
         m_iQuantity = i+1;
     }
@@ -225,7 +296,9 @@ void TArray<T>::SetMaxQuantity (int iNewMaxQuantity, bool bCopy)
 
     if (iNewMaxQuantity == 0)
     {
-        WG_DELETE[] m_atArray;
+        Destroy(m_atArray,m_iMaxQuantity);
+        Free(m_atArray);
+        m_atArray = 0;
         m_iQuantity = 0;
         m_iMaxQuantity = 0;
         return;
@@ -233,25 +306,10 @@ void TArray<T>::SetMaxQuantity (int iNewMaxQuantity, bool bCopy)
 
     if (iNewMaxQuantity != m_iMaxQuantity)
     {
-        T* atNewArray = WG_NEW T[iNewMaxQuantity];
-
         if (bCopy)
         {
-            int iCopyQuantity;
-            if (iNewMaxQuantity > m_iMaxQuantity)
-            {
-                iCopyQuantity = m_iMaxQuantity;
-            }
-            else
-            {
-                iCopyQuantity = iNewMaxQuantity;
-            }
-
-            for (int i = 0; i < iCopyQuantity; i++)
-            {
-                atNewArray[i] = m_atArray[i];
-            }
-
+            Reallocate(iNewMaxQuantity,(iNewMaxQuantity > m_iMaxQuantity ?
+                m_iMaxQuantity : iNewMaxQuantity));
             if (m_iQuantity > iNewMaxQuantity)
             {
                 m_iQuantity = iNewMaxQuantity;
@@ -259,12 +317,9 @@ void TArray<T>::SetMaxQuantity (int iNewMaxQuantity, bool bCopy)
         }
         else
         {
+            Reallocate(iNewMaxQuantity,0);
             m_iQuantity = 0;
         }
-
-        WG_DELETE[] m_atArray;
-        m_atArray = atNewArray;
-        m_iMaxQuantity = iNewMaxQuantity;
     }
 }
 //----------------------------------------------------------------------------
@@ -275,6 +330,15 @@ int TArray<T>::GetMaxQuantity () const
 }
 //----------------------------------------------------------------------------
 template <class T>
+void TArray<T>::Reserve (int iQuantity)
+{
+    if (iQuantity > m_iMaxQuantity)
+    {
+        Reallocate(iQuantity,m_iMaxQuantity);
+    }
+}
+//----------------------------------------------------------------------------
+template <class T>
 void TArray<T>::SetGrowBy (int iGrowBy)
 {
     assert(iGrowBy >= 0);
@@ -290,4 +354,96 @@ int TArray<T>::GetGrowBy () const
     return m_iGrowBy;
 }
 //----------------------------------------------------------------------------
+template <class T>
+int TArray<T>::GetGrownQuantity (int iMinQuantity) const
+{
+    int iGrowBy = (m_iMaxQuantity > m_iGrowBy ? m_iMaxQuantity : m_iGrowBy);
+    int iNewMaxQuantity = m_iMaxQuantity + iGrowBy;
+    return (iNewMaxQuantity > iMinQuantity ? iNewMaxQuantity : iMinQuantity);
+}
+//----------------------------------------------------------------------------
+template <class T>
+void TArray<T>::Reallocate (int iNewMaxQuantity, int iKeepQuantity)
+{
+    // The first iKeepQuantity elements move to storage for iNewMaxQuantity
+    // elements, the others are default constructed.
+    T* atNewArray = (iNewMaxQuantity <= m_iInlineQuantity ? m_atInline :
+        Allocate(iNewMaxQuantity));
+
+    if (atNewArray == m_atArray)
+    {
+        // the inline storage is resized in place
+        Destroy(m_atArray+iKeepQuantity,m_iMaxQuantity-iKeepQuantity);
+    }
+    else
+    {
+        Relocate(atNewArray,m_atArray,iKeepQuantity);
+        if (m_atArray)
+        {
+            Destroy(m_atArray+iKeepQuantity,m_iMaxQuantity-iKeepQuantity);
+            Free(m_atArray);
+        }
+    }
+    Construct(atNewArray+iKeepQuantity,iNewMaxQuantity-iKeepQuantity);
+
+    m_atArray = atNewArray;
+    m_iMaxQuantity = iNewMaxQuantity;
+}
+//----------------------------------------------------------------------------
+template <class T>
+T* TArray<T>::Allocate (int iQuantity)
+{
+    if (m_pkArena)
+    {
+        return (T*)m_pkArena->Allocate(iQuantity*sizeof(T));
+    }
+    return (T*)WG_NEW char[iQuantity*sizeof(T)];
+}
+//----------------------------------------------------------------------------
+template <class T>
+void TArray<T>::Free (T* atArray)
+{
+    if (atArray && atArray != m_atInline && !m_pkArena)
+    {
+        WG_DELETE[] (char*)atArray;
+    }
+}
+//----------------------------------------------------------------------------
+template <class T>
+void TArray<T>::Construct (T* atArray, int iQuantity)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        new(&atArray[i]) T;
+    }
+}
+//----------------------------------------------------------------------------
+template <class T>
+void TArray<T>::Destroy (T* atArray, int iQuantity)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        atArray[i].~T();
+    }
+}
+//----------------------------------------------------------------------------
+template <class T>
+void TArray<T>::Relocate (T* atDst, T* atSrc, int iQuantity)
+{
+    if (TRelocatable<T>::VALUE)
+    {
+        if (iQuantity > 0)
+        {
+            memcpy((void*)atDst,(const void*)atSrc,iQuantity*sizeof(T));
+        }
+        return;
+    }
+
+    for (int i = 0; i < iQuantity; i++)
+    {
+        new(&atDst[i]) T(WG3D_MOVE(atSrc[i]));
+        atSrc[i].~T();
+    }
+}
+//----------------------------------------------------------------------------
 
@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgTHashSet.h                       //
+//                                                       //
+//  - Interface for Generic Hash Set class               //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_THASHSET_H__
+#define __WG_THASHSET_H__
+
+#include "WgFoundationLIB.h"
+
+// The class TKEY is either native data or is class data that has the
+// following member functions:
+//   TKEY::TKEY ()
+//   TKEY& TKEY::operator= (const TKEY&)
+//   bool TKEY::operator== (const TKEY&) const
+//   bool TKEY::operator!= (const TKEY&) const
+//   TKEY::operator unsigned int () const
+// The implicit conversion to unsigned int is used to select a hash table
+// index for the T object.  The return value need not be within the range of
+// hash table indices.  THashSet scrambles it with a multiplicative hash.
+
+#include "WgSystem.h"
+#include "WgTRelocatable.h"
+
+namespace WGSoft3D
+{
+
+// The set is open addressed with Robin Hood hashing and removes without
+// tombstones, as THashTable.  The pointers returned by Insert, Get and the
+// traversal are valid until the next insertion or removal.  The set must
+// not be modified during a traversal.
+
+template <class TKEY>
+class THashSet
+{
+public:
+    // Construction and destruction.  The set starts with room for
+    // iTableSize keys and grows as needed.
+    THashSet (int iTableSize);
+    ~THashSet ();
+
+    // element access
+    int GetQuantity () const;
+
+    // A pointer to the actual storage is returned so that the caller has
+    // direct access to it.  This allows a subset of TKEY members to be used
+    // in key comparison.
+    TKEY* Insert (const TKEY& rtKey);
+
+    // If the input key exists, a pointer to the actual storage is returned.
+    // This allows a subset of TKEY members to be used in key comparison,
+    // but gives the caller a chance to modify other TKEY members.
+    TKEY* Get (const TKEY& rtKey) const;
+
+    bool Remove (const TKEY& rtKey);
+    void RemoveAll ();
+
+    // linear traversal of set
+    TKEY* GetFirst () const;
+    TKEY* GetNext () const;
+
+    // User-specified key-to-index construction.  Set it before the first
+    // insertion.
+    int (*UserHashFunction)(const TKEY&);
+
+private:
+    class HashItem
+    {
+    public:
+        HashItem () : m_iDistance(0) { /**/ }
+
+        TKEY m_tKey;
+        int m_iDistance;  // 0 for a free slot, else 1 + distance from slot
+    };
+
+    // Default key-to-index construction (override by user-specified when
+    // requested).
+    unsigned int HashFunction (const TKEY& rtKey) const;
+    int FindSlot (const TKEY& rtKey) const;  // -1 when missing
+    int GetSlot (unsigned int uiHash) const;
+    int GetNextSlot (int iSlot) const;
+    void Place (HashItem& rkItem, int iSlot);
+    void Grow ();
+
+    // hash table
+    int m_iTableSize;
+    int m_iQuantity;
+    int m_iMaxQuantity;  // the quantity at which the table grows
+    int m_iShift;        // 32 minus the base-2 logarithm of the table size
+    HashItem* m_akTable;
+
+    // iterator for traversal
+    mutable int m_iIndex;
+};
+
+#include "WgTHashSet.inl"
+
+}
+
+#endif
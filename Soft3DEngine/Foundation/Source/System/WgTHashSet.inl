@@ -0,0 +1,237 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgTHashSet.inl                     //
+//                                                       //
+//  - Inlines for Generic Hash Set class                 //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+template <class TKEY>
+THashSet<TKEY>::THashSet (int iTableSize)
+{
+    assert(iTableSize > 0);
+
+    // the smallest power of two with room for iTableSize keys
+    m_iTableSize = 8;
+    m_iShift = 29;
+    while (m_iTableSize - m_iTableSize/4 < iTableSize)
+    {
+        m_iTableSize *= 2;
+        m_iShift--;
+    }
+
+    m_iQuantity = 0;
+    m_iMaxQuantity = m_iTableSize - m_iTableSize/4;
+    m_iIndex = 0;
+    m_akTable = WG_NEW HashItem[m_iTableSize];
+    UserHashFunction = 0;
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+THashSet<TKEY>::~THashSet ()
+{
+    WG_DELETE[] m_akTable;
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+int THashSet<TKEY>::GetQuantity () const
+{
+    return m_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+TKEY* THashSet<TKEY>::Insert (const TKEY& rtKey)
+{
+    // search for the key up to the slot where it belongs
+    unsigned int uiHash = HashFunction(rtKey);
+    int iSlot = GetSlot(uiHash);
+    int iDistance = 1;
+    while (m_akTable[iSlot].m_iDistance >= iDistance)
+    {
+        if (rtKey == m_akTable[iSlot].m_tKey)
+        {
+            // item already in hash table
+            return &m_akTable[iSlot].m_tKey;
+        }
+        iSlot = GetNextSlot(iSlot);
+        iDistance++;
+    }
+
+    if (m_iQuantity == m_iMaxQuantity)
+    {
+        Grow();
+        iSlot = GetSlot(uiHash);
+        iDistance = 1;
+        while (m_akTable[iSlot].m_iDistance >= iDistance)
+        {
+            iSlot = GetNextSlot(iSlot);
+            iDistance++;
+        }
+    }
+
+    // the key stays in the slot, the pairs that it displaces move on
+    HashItem kItem;
+    kItem.m_tKey = rtKey;
+    kItem.m_iDistance = iDistance;
+    Place(kItem,iSlot);
+    m_iQuantity++;
+
+    return &m_akTable[iSlot].m_tKey;
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+TKEY* THashSet<TKEY>::Get (const TKEY& rtKey) const
+{
+    int iSlot = FindSlot(rtKey);
+    return (iSlot >= 0 ? &m_akTable[iSlot].m_tKey : 0);
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+bool THashSet<TKEY>::Remove (const TKEY& rtKey)
+{
+    int iSlot = FindSlot(rtKey);
+    if (iSlot < 0)
+    {
+        return false;
+    }
+
+    // shift the following keys back up to a free slot or a key in its own
+    // slot
+    int iNext = GetNextSlot(iSlot);
+    while (m_akTable[iNext].m_iDistance > 1)
+    {
+        m_akTable[iSlot] = WG3D_MOVE(m_akTable[iNext]);
+        m_akTable[iSlot].m_iDistance--;
+        iSlot = iNext;
+        iNext = GetNextSlot(iNext);
+    }
+
+    m_akTable[iSlot] = HashItem();
+    m_iQuantity--;
+    return true;
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+void THashSet<TKEY>::RemoveAll ()
+{
+    for (int i = 0; m_iQuantity > 0 && i < m_iTableSize; i++)
+    {
+        if (m_akTable[i].m_iDistance != 0)
+        {
+            m_akTable[i] = HashItem();
+            m_iQuantity--;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+TKEY* THashSet<TKEY>::GetFirst () const
+{
+    m_iIndex = -1;
+    return GetNext();
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+TKEY* THashSet<TKEY>::GetNext () const
+{
+    for (m_iIndex++; m_iIndex < m_iTableSize; m_iIndex++)
+    {
+        if (m_akTable[m_iIndex].m_iDistance != 0)
+        {
+            return &m_akTable[m_iIndex].m_tKey;
+        }
+    }
+
+    return 0;
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+unsigned int THashSet<TKEY>::HashFunction (const TKEY& rtKey) const
+{
+    if (UserHashFunction)
+    {
+        return (unsigned int)(*UserHashFunction)(rtKey);
+    }
+
+    // default hash function
+    return (unsigned int)rtKey;
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+int THashSet<TKEY>::FindSlot (const TKEY& rtKey) const
+{
+    // A key nearer to its slot than the searched key would be ends the
+    // search.
+    int iSlot = GetSlot(HashFunction(rtKey));
+    for (int iDistance = 1; m_akTable[iSlot].m_iDistance >= iDistance;
+         iDistance++)
+    {
+        if (rtKey == m_akTable[iSlot].m_tKey)
+        {
+            return iSlot;
+        }
+        iSlot = GetNextSlot(iSlot);
+    }
+
+    return -1;
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+int THashSet<TKEY>::GetSlot (unsigned int uiHash) const
+{
+    // Fibonacci hashing, the high bits of the product are the slot
+    return (int)((uiHash*2654435769u) >> m_iShift);
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+int THashSet<TKEY>::GetNextSlot (int iSlot) const
+{
+    return (iSlot + 1) & (m_iTableSize - 1);
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+void THashSet<TKEY>::Place (HashItem& rkItem, int iSlot)
+{
+    for (;;)
+    {
+        HashItem& rkSlot = m_akTable[iSlot];
+        if (rkSlot.m_iDistance == 0)
+        {
+            rkSlot = WG3D_MOVE(rkItem);
+            return;
+        }
+        if (rkSlot.m_iDistance < rkItem.m_iDistance)
+        {
+            HashItem kSave(WG3D_MOVE(rkSlot));
+            rkSlot = WG3D_MOVE(rkItem);
+            rkItem = WG3D_MOVE(kSave);
+        }
+        iSlot = GetNextSlot(iSlot);
+        rkItem.m_iDistance++;
+    }
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+void THashSet<TKEY>::Grow ()
+{
+    HashItem* akOld = m_akTable;
+    int iOldSize = m_iTableSize;
+
+    m_iTableSize *= 2;
+    m_iShift--;
+    m_iMaxQuantity = m_iTableSize - m_iTableSize/4;
+    m_akTable = WG_NEW HashItem[m_iTableSize];
+
+    for (int i = 0; i < iOldSize; i++)
+    {
+        if (akOld[i].m_iDistance != 0)
+        {
+            akOld[i].m_iDistance = 1;
+            Place(akOld[i],GetSlot(HashFunction(akOld[i].m_tKey)));
+        }
+    }
+
+    WG_DELETE[] akOld;
+}
+//----------------------------------------------------------------------------
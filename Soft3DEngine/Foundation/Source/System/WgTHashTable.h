@@ -24,8 +24,8 @@
 //   TKEY::operator unsigned int () const
 // The implicit conversion to unsigned int is used to select a hash table
 // index for the T object.  The return value need not be within the range of
-// hash table indices.  THashTable will use modular arithmetic to make this
-// happen.
+// hash table indices.  THashTable scrambles it with a multiplicative hash,
+// so consecutive keys (object IDs, GL names) spread over the table.
 //
 // The class TVALUE is either native data or is class data that has the
 // following member functions:
@@ -33,15 +33,31 @@
 //   TVALUE& TVALUE::operator= (const TVALUE&)
 
 #include "WgSystem.h"
+#include "WgTRelocatable.h"
 
 namespace WGSoft3D
 {
 
+// The table is open addressed with Robin Hood hashing.  The key-value pairs
+// are stored in one array, a pair in the first free slot after the slot of
+// its hash, and a pair that is farther from its slot takes the place of one
+// that is nearer.  A search stops at the first pair that is nearer to its
+// slot than the searched key would be, so a search for a missing key is as
+// short as one for a present key.  Removal shifts the following pairs back
+// by one slot, so the table has no tombstones.  The table doubles when it is
+// three quarters full and halves when less than an eighth of it is used, down
+// to its initial size, and an insertion or a removal allocates only then.
+//
+// The pointers returned by Insert, Find and the traversal are valid until
+// the next insertion or removal, which may move the pairs.  The table must
+// not be modified during a traversal.
+
 template <class TKEY, class TVALUE>
 class THashTable
 {
 public:
-    // construction and destruction
+    // Construction and destruction.  The table starts with room for
+    // iTableSize pairs and grows as needed.
     THashTable (int iTableSize);
     ~THashTable ();
 
@@ -62,30 +78,54 @@ public:
     TVALUE* GetFirst (TKEY* ptKey) const;
     TVALUE* GetNext (TKEY* ptKey) const;
 
-    // user-specified key-to-index construction
+    // User-specified key-to-index construction.  Set it before the first
+    // insertion.
     int (*UserHashFunction)(const TKEY&);
 
-private:
+    // The number of slots and the mean distance of the pairs from their
+    // slots (0 when every pair is in its slot), for profiling.
+    int GetTableSize () const;
+    float GetMeanProbeLength () const;
+
+protected:
     class HashItem
     {
     public:
+        HashItem () : m_iDistance(0) { /**/ }
+
         TKEY m_tKey;
         TVALUE m_tValue;
-        HashItem* m_pkNext;
+        int m_iDistance;  // 0 for a free slot, else 1 + distance from slot
     };
 
+    // The slot of a hash value and the next slot of a search.  The hash
+    // value is the key converted to unsigned int or the value of the user
+    // function.
+    int GetSlot (unsigned int uiHash) const;
+    int GetNextSlot (int iSlot) const;
+
+    // remove the pair of a slot and shift the following pairs back
+    void RemoveSlot (int iSlot);
+
+    int m_iTableSize;
+    HashItem* m_akTable;
+
+private:
     // Default key-to-index construction (override by user-specified when
     // requested).
-    int HashFunction (const TKEY& rtKey) const;
+    unsigned int HashFunction (const TKEY& rtKey) const;
+    int FindSlot (const TKEY& rtKey) const;  // -1 when missing
+    void Place (HashItem& rkItem, int iSlot);
+    void Resize (int iTableSize, int iShift);
 
-    // hash table
-    int m_iTableSize;
     int m_iQuantity;
-    HashItem** m_apkTable;
+    int m_iMaxQuantity;  // the quantity at which the table grows
+    int m_iMinQuantity;  // the quantity below which the table shrinks
+    int m_iShift;        // 32 minus the base-2 logarithm of the table size
+    int m_iInitialSize;
 
     // iterator for traversal
     mutable int m_iIndex;
-    mutable HashItem* m_pkItem;
 };
 
 #include "WgTHashTable.inl"
@@ -15,20 +15,28 @@ THashTable<TKEY,TVALUE>::THashTable (int iTableSize)
 {
     assert(iTableSize > 0);
 
-    m_iTableSize = iTableSize;
+    // the smallest power of two with room for iTableSize pairs
+    m_iTableSize = 8;
+    m_iShift = 29;
+    while (m_iTableSize - m_iTableSize/4 < iTableSize)
+    {
+        m_iTableSize *= 2;
+        m_iShift--;
+    }
+
     m_iQuantity = 0;
+    m_iMaxQuantity = m_iTableSize - m_iTableSize/4;
+    m_iMinQuantity = 0;
+    m_iInitialSize = m_iTableSize;
     m_iIndex = 0;
-    m_pkItem = 0;
-    m_apkTable = WG_NEW HashItem*[m_iTableSize];
-    memset(m_apkTable,0,m_iTableSize*sizeof(HashItem*));
+    m_akTable = WG_NEW HashItem[m_iTableSize];
     UserHashFunction = 0;
 }
 //----------------------------------------------------------------------------
 template <class TKEY, class TVALUE>
 THashTable<TKEY,TVALUE>::~THashTable ()
 {
-    RemoveAll();
-    WG_DELETE[] m_apkTable;
+    WG_DELETE[] m_akTable;
 }
 //----------------------------------------------------------------------------
 template <class TKEY, class TVALUE>
@@ -41,27 +49,39 @@ template <class TKEY, class TVALUE>
 bool THashTable<TKEY,TVALUE>::Insert (const TKEY& rtKey,
     const TVALUE& rtValue)
 {
-    // find hash table entry for given key
-    int iIndex = HashFunction(rtKey);
-    HashItem* pkItem = m_apkTable[iIndex];
-
-    // search for item in list associated with key
-    while (pkItem)
+    // Search for the key up to the slot where it belongs, the first one
+    // whose pair is nearer to its own slot.
+    unsigned int uiHash = HashFunction(rtKey);
+    int iSlot = GetSlot(uiHash);
+    int iDistance = 1;
+    while (m_akTable[iSlot].m_iDistance >= iDistance)
     {
-        if (rtKey == pkItem->m_tKey)
+        if (rtKey == m_akTable[iSlot].m_tKey)
         {
             // item already in hash table
             return false;
         }
-        pkItem = pkItem->m_pkNext;
+        iSlot = GetNextSlot(iSlot);
+        iDistance++;
     }
 
-    // add item to beginning of list
-    pkItem = WG_NEW HashItem;
-    pkItem->m_tKey = rtKey;
-    pkItem->m_tValue = rtValue;
-    pkItem->m_pkNext = m_apkTable[iIndex];
-    m_apkTable[iIndex] = pkItem;
+    if (m_iQuantity == m_iMaxQuantity)
+    {
+        Resize(2*m_iTableSize,m_iShift-1);
+        iSlot = GetSlot(uiHash);
+        iDistance = 1;
+        while (m_akTable[iSlot].m_iDistance >= iDistance)
+        {
+            iSlot = GetNextSlot(iSlot);
+            iDistance++;
+        }
+    }
+
+    HashItem kItem;
+    kItem.m_tKey = rtKey;
+    kItem.m_tValue = rtValue;
+    kItem.m_iDistance = iDistance;
+    Place(kItem,iSlot);
     m_iQuantity++;
 
     return true;
@@ -70,147 +90,209 @@ bool THashTable<TKEY,TVALUE>::Insert (const TKEY& rtKey,
 template <class TKEY, class TVALUE>
 TVALUE* THashTable<TKEY,TVALUE>::Find (const TKEY& rtKey) const
 {
-    // find hash table entry for given key
-    int iIndex = HashFunction(rtKey);
-    HashItem* pkItem = m_apkTable[iIndex];
+    int iSlot = FindSlot(rtKey);
+    return (iSlot >= 0 ? &m_akTable[iSlot].m_tValue : 0);
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+bool THashTable<TKEY,TVALUE>::Remove (const TKEY& rtKey)
+{
+    int iSlot = FindSlot(rtKey);
+    if (iSlot < 0)
+    {
+        return false;
+    }
 
-    // search for item in list associated with key
-    while (pkItem)
+    RemoveSlot(iSlot);
+    if (m_iQuantity < m_iMinQuantity)
+    {
+        Resize(m_iTableSize/2,m_iShift+1);
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+void THashTable<TKEY,TVALUE>::RemoveAll ()
+{
+    for (int i = 0; m_iQuantity > 0 && i < m_iTableSize; i++)
     {
-        if (rtKey == pkItem->m_tKey)
+        if (m_akTable[i].m_iDistance != 0)
         {
-            // item is in hash table
-            return &pkItem->m_tValue;
+            m_akTable[i] = HashItem();
+            m_iQuantity--;
         }
-        pkItem = pkItem->m_pkNext;
     }
 
-    return 0;
+    // back to the initial size
+    int iShift = m_iShift;
+    for (int iSize = m_iTableSize; iSize > m_iInitialSize; iSize /= 2)
+    {
+        iShift++;
+    }
+    if (iShift != m_iShift)
+    {
+        Resize(m_iInitialSize,iShift);
+    }
 }
 //----------------------------------------------------------------------------
 template <class TKEY, class TVALUE>
-bool THashTable<TKEY,TVALUE>::Remove (const TKEY& rtKey)
+TVALUE* THashTable<TKEY,TVALUE>::GetFirst (TKEY* ptKey) const
 {
-    // find hash table entry for given key
-    int iIndex = HashFunction(rtKey);
-    HashItem* pkItem = m_apkTable[iIndex];
-
-    if (!pkItem)
+    m_iIndex = -1;
+    return GetNext(ptKey);
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+TVALUE* THashTable<TKEY,TVALUE>::GetNext (TKEY* ptKey) const
+{
+    for (m_iIndex++; m_iIndex < m_iTableSize; m_iIndex++)
     {
-        return false;
+        if (m_akTable[m_iIndex].m_iDistance != 0)
+        {
+            *ptKey = m_akTable[m_iIndex].m_tKey;
+            return &m_akTable[m_iIndex].m_tValue;
+        }
     }
 
-    if (rtKey == pkItem->m_tKey)
+    return 0;
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+int THashTable<TKEY,TVALUE>::GetTableSize () const
+{
+    return m_iTableSize;
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+float THashTable<TKEY,TVALUE>::GetMeanProbeLength () const
+{
+    if (m_iQuantity == 0)
     {
-        // item is at front of list, strip it off
-        HashItem* pkSave = pkItem;
-        m_apkTable[iIndex] = pkItem->m_pkNext;
-        WG_DELETE pkSave;
-        m_iQuantity--;
-        return true;
+        return 0.0f;
     }
 
-    // search for item in list
-    HashItem* pkPrev = pkItem;
-    HashItem* pkCurr = pkItem->m_pkNext;
-    while (pkCurr && rtKey != pkCurr->m_tKey)
+    int iSum = 0;
+    for (int i = 0; i < m_iTableSize; i++)
     {
-        pkPrev = pkCurr;
-        pkCurr = pkCurr->m_pkNext;
+        if (m_akTable[i].m_iDistance != 0)
+        {
+            iSum += m_akTable[i].m_iDistance - 1;
+        }
     }
-
-    if (pkCurr)
+    return (float)iSum/(float)m_iQuantity;
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+int THashTable<TKEY,TVALUE>::GetSlot (unsigned int uiHash) const
+{
+    // Fibonacci hashing, the high bits of the product are the slot
+    return (int)((uiHash*2654435769u) >> m_iShift);
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+int THashTable<TKEY,TVALUE>::GetNextSlot (int iSlot) const
+{
+    return (iSlot + 1) & (m_iTableSize - 1);
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+void THashTable<TKEY,TVALUE>::RemoveSlot (int iSlot)
+{
+    // Shift the following pairs back by one slot up to a free slot or a
+    // pair in its own slot.  Every pair is then as near to its slot as its
+    // insertion would have put it, so no tombstone is needed.
+    int iNext = GetNextSlot(iSlot);
+    while (m_akTable[iNext].m_iDistance > 1)
     {
-        // found the item
-        pkPrev->m_pkNext = pkCurr->m_pkNext;
-        WG_DELETE pkCurr;
-        m_iQuantity--;
-        return true;
+        m_akTable[iSlot] = WG3D_MOVE(m_akTable[iNext]);
+        m_akTable[iSlot].m_iDistance--;
+        iSlot = iNext;
+        iNext = GetNextSlot(iNext);
     }
 
-    return false;
+    m_akTable[iSlot] = HashItem();
+    m_iQuantity--;
 }
 //----------------------------------------------------------------------------
 template <class TKEY, class TVALUE>
-void THashTable<TKEY,TVALUE>::RemoveAll ()
+unsigned int THashTable<TKEY,TVALUE>::HashFunction (const TKEY& rtKey) const
 {
-    if (m_iQuantity > 0)
+    if (UserHashFunction)
     {
-        for (int iIndex = 0; iIndex < m_iTableSize; iIndex++)
-        {
-            while (m_apkTable[iIndex])
-            {
-                HashItem* pkSave = m_apkTable[iIndex];
-                m_apkTable[iIndex] = m_apkTable[iIndex]->m_pkNext;
-                WG_DELETE pkSave;
-                if (--m_iQuantity == 0)
-                {
-                    return;
-                }
-            }
-        }
+        return (unsigned int)(*UserHashFunction)(rtKey);
     }
+
+    // default hash function
+    return (unsigned int)rtKey;
 }
 //----------------------------------------------------------------------------
 template <class TKEY, class TVALUE>
-TVALUE* THashTable<TKEY,TVALUE>::GetFirst (TKEY* ptKey) const
+int THashTable<TKEY,TVALUE>::FindSlot (const TKEY& rtKey) const
 {
-    if (m_iQuantity > 0)
+    // A pair nearer to its slot than the searched key would be ends the
+    // search.
+    int iSlot = GetSlot(HashFunction(rtKey));
+    for (int iDistance = 1; m_akTable[iSlot].m_iDistance >= iDistance;
+         iDistance++)
     {
-        for (m_iIndex = 0; m_iIndex < m_iTableSize; m_iIndex++)
+        if (rtKey == m_akTable[iSlot].m_tKey)
         {
-            if (m_apkTable[m_iIndex])
-            {
-                m_pkItem = m_apkTable[m_iIndex];
-                *ptKey = m_pkItem->m_tKey;
-                return &m_pkItem->m_tValue;
-            }
+            return iSlot;
         }
+        iSlot = GetNextSlot(iSlot);
     }
 
-    return 0;
+    return -1;
 }
 //----------------------------------------------------------------------------
 template <class TKEY, class TVALUE>
-TVALUE* THashTable<TKEY,TVALUE>::GetNext (TKEY* ptKey) const
+void THashTable<TKEY,TVALUE>::Place (HashItem& rkItem, int iSlot)
 {
-    if (m_iQuantity > 0)
+    // Store the item in the slot.  Each pair that it displaces moves on to
+    // the next slot whose pair is nearer to its own slot, and so on up to a
+    // free slot.
+    for (;;)
     {
-        m_pkItem = m_pkItem->m_pkNext;
-        if (m_pkItem)
+        HashItem& rkSlot = m_akTable[iSlot];
+        if (rkSlot.m_iDistance == 0)
         {
-            *ptKey = m_pkItem->m_tKey;
-            return &m_pkItem->m_tValue;
+            rkSlot = WG3D_MOVE(rkItem);
+            return;
         }
-        
-        for (m_iIndex++; m_iIndex < m_iTableSize; m_iIndex++)
+        if (rkSlot.m_iDistance < rkItem.m_iDistance)
         {
-            if (m_apkTable[m_iIndex])
-            {
-                m_pkItem = m_apkTable[m_iIndex];
-                *ptKey = m_pkItem->m_tKey;
-                return &m_pkItem->m_tValue;
-            }
+            HashItem kSave(WG3D_MOVE(rkSlot));
+            rkSlot = WG3D_MOVE(rkItem);
+            rkItem = WG3D_MOVE(kSave);
         }
+        iSlot = GetNextSlot(iSlot);
+        rkItem.m_iDistance++;
     }
-
-    return 0;
 }
 //----------------------------------------------------------------------------
 template <class TKEY, class TVALUE>
-int THashTable<TKEY,TVALUE>::HashFunction (const TKEY& rtKey) const
+void THashTable<TKEY,TVALUE>::Resize (int iTableSize, int iShift)
 {
-    if (UserHashFunction)
+    HashItem* akOld = m_akTable;
+    int iOldSize = m_iTableSize;
+
+    // A grown table is three eighths full and a shrunk one a quarter, so
+    // the next insertions and removals do not resize it again.
+    m_iTableSize = iTableSize;
+    m_iShift = iShift;
+    m_iMaxQuantity = m_iTableSize - m_iTableSize/4;
+    m_iMinQuantity = (m_iTableSize > m_iInitialSize ? m_iTableSize/8 : 0);
+    m_akTable = WG_NEW HashItem[m_iTableSize];
+
+    for (int i = 0; i < iOldSize; i++)
     {
-        return (*UserHashFunction)(rtKey);
+        if (akOld[i].m_iDistance != 0)
+        {
+            akOld[i].m_iDistance = 1;
+            Place(akOld[i],GetSlot(HashFunction(akOld[i].m_tKey)));
+        }
     }
 
-    // default hash function
-    static double s_dHashMultiplier = 0.5*(sqrt(5.0)-1.0);
-    unsigned int uiKey;
-    System::Memcpy(&uiKey,sizeof(unsigned int),&rtKey,sizeof(unsigned int));
-    uiKey %= m_iTableSize;
-    double dFraction = fmod(s_dHashMultiplier*uiKey,1.0);
-    return (int)floor(m_iTableSize*dFraction);
+    WG_DELETE[] akOld;
 }
 //----------------------------------------------------------------------------
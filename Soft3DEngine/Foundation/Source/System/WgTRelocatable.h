@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgTRelocatable.h                   //
+//                                                       //
+//  - Interface for Relocatable trait                    //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_TRELOCATABLE_H__
+#define __WG_TRELOCATABLE_H__
+
+#include "WgFoundationLIB.h"
+#include "WgFixed.h"
+#include <cstring>
+#include <utility>
+
+namespace WGSoft3D
+{
+
+// TRelocatable<T>::VALUE is 1 when an object of class T may be moved to
+// another address with memcpy, the source then being dropped without its
+// destructor.  This holds for a class that neither points into itself nor
+// registers its address anywhere.  Native types and pointers are
+// relocatable, other classes declare it after their definition with
+// WG3D_DECLARE_RELOCATABLE.  The containers relocate the other classes with
+// the copy constructor (the move constructor in C++11) and the destructor.
+
+template <class T>
+class TRelocatable
+{
+public:
+    enum { VALUE = 0 };
+};
+
+template <class T>
+class TRelocatable<T*>
+{
+public:
+    enum { VALUE = 1 };
+};
+
+#define WG3D_DECLARE_RELOCATABLE(classname) \
+template <> \
+class TRelocatable<classname> \
+{ \
+public: \
+    enum { VALUE = 1 }; \
+}
+
+WG3D_DECLARE_RELOCATABLE(bool);
+WG3D_DECLARE_RELOCATABLE(char);
+WG3D_DECLARE_RELOCATABLE(unsigned char);
+WG3D_DECLARE_RELOCATABLE(short);
+WG3D_DECLARE_RELOCATABLE(unsigned short);
+WG3D_DECLARE_RELOCATABLE(int);
+WG3D_DECLARE_RELOCATABLE(unsigned int);
+WG3D_DECLARE_RELOCATABLE(long);
+WG3D_DECLARE_RELOCATABLE(unsigned long);
+WG3D_DECLARE_RELOCATABLE(float);
+WG3D_DECLARE_RELOCATABLE(double);
+WG3D_DECLARE_RELOCATABLE(fixed);
+
+// Moves in C++11 builds, copies otherwise.
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600)
+#define WG3D_HAS_MOVE
+#define WG3D_MOVE(object) std::move(object)
+#else
+#define WG3D_MOVE(object) (object)
+#endif
+
+}
+
+#endif
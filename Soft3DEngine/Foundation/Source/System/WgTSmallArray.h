@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgTSmallArray.h                    //
+//                                                       //
+//  - Interface for Small Array class                    //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_TSMALLARRAY_H__
+#define __WG_TSMALLARRAY_H__
+
+#include "WgFoundationLIB.h"
+#include "WgTArray.h"
+
+namespace WGSoft3D
+{
+
+// An array with room for N elements inside the object, for the arrays that
+// usually hold a few elements (the textures of an effect, the lights of a
+// geometry).  Up to N elements it does not allocate, beyond that it is an
+// array on the heap like TArray, and it returns to the inline storage when
+// its capacity is set to N or less.  It is a TArray, so the functions that
+// take a TArray take it too.
+
+template <class T, int N>
+class TSmallArray : public TArray<T>
+{
+public:
+    TSmallArray (int iGrowBy = 1);
+    TSmallArray (const TSmallArray& rkObject);
+    TSmallArray (const TArray<T>& rkObject);
+
+    TSmallArray& operator= (const TSmallArray& rkObject);
+    TSmallArray& operator= (const TArray<T>& rkObject);
+
+private:
+    // raw storage, aligned for any element
+    union Storage
+    {
+        char Data[N*sizeof(T)];
+        double Align0;
+        void* Align1;
+    };
+    Storage m_kStorage;
+};
+
+#include "WgTSmallArray.inl"
+
+}
+
+#endif
@@ -0,0 +1,46 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgTSmallArray.inl                  //
+//                                                       //
+//  - Inlines for Small Array class                      //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+template <class T, int N>
+TSmallArray<T,N>::TSmallArray (int iGrowBy)
+    :
+    TArray<T>((T*)m_kStorage.Data,N,iGrowBy)
+{
+}
+//----------------------------------------------------------------------------
+template <class T, int N>
+TSmallArray<T,N>::TSmallArray (const TSmallArray& rkObject)
+    :
+    TArray<T>((T*)m_kStorage.Data,N,rkObject.GetGrowBy())
+{
+    TArray<T>::operator=(rkObject);
+}
+//----------------------------------------------------------------------------
+template <class T, int N>
+TSmallArray<T,N>::TSmallArray (const TArray<T>& rkObject)
+    :
+    TArray<T>((T*)m_kStorage.Data,N,rkObject.GetGrowBy())
+{
+    TArray<T>::operator=(rkObject);
+}
+//----------------------------------------------------------------------------
+template <class T, int N>
+TSmallArray<T,N>& TSmallArray<T,N>::operator= (const TSmallArray& rkObject)
+{
+    TArray<T>::operator=(rkObject);
+    return *this;
+}
+//----------------------------------------------------------------------------
+template <class T, int N>
+TSmallArray<T,N>& TSmallArray<T,N>::operator= (const TArray<T>& rkObject)
+{
+    TArray<T>::operator=(rkObject);
+    return *this;
+}
+//----------------------------------------------------------------------------
@@ -1,36 +1,35 @@
-// Wild Magic Source Code
-// David Eberly
-// http://www.geometrictools.com
-// Copyright (c) 1998-2009
-//
-// This library is free software; you can redistribute it and/or modify it
-// under the terms of the GNU Lesser General Public License as published by
-// the Free Software Foundation; either version 2.1 of the License, or (at
-// your option) any later version.  The license is available for reading at
-// either of the locations:
-//     http://www.gnu.org/copyleft/lgpl.html
-//     http://www.geometrictools.com/License/WildMagicLicense.pdf
-//
-// Version: 4.0.1 (2007/02/25)
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgTSmallUnorderedSet.h             //
+//                                                       //
+//  - Interface for Small Unordered Set class            //
+//                                                       //
+//  - Written By Woong Gyu La a.k.a. Chris               //
+//       on 2009.10.09                                   //
+//                                                       //
+///////////////////////////////////////////////////////////
 
-#ifndef WM4TSMALLUNORDEREDSET_H
-#define WM4TSMALLUNORDEREDSET_H
+#ifndef __WG_TSMALLUNORDEREDSET_H__
+#define __WG_TSMALLUNORDEREDSET_H__
 
-#include "Wm4FoundationLIB.h"
+#include "WgFoundationLIB.h"
+#include "WgTArray.h"
 
 // This template class is for unordered sets of objects.  The intent is that
 // the sets are not too large.  If you do not plan on searching the set and
 // you know that the elements to be added are unique, then the size of the
 // set is irrelevant since a member function is provided that inserts an
-// element without checking to see if one already exists.
+// element without checking to see if one already exists.  For large sets
+// use THashSet.
 //
 // The class T is either native data or is class data that has the following
 // member functions:
 //   T::T ()
 //   T::T (const T&);
 //   T& T::operator= (const T&)
+//   bool T::operator== (const T&) const
 
-namespace Wm4
+namespace WGSoft3D
 {
 
 template <class T>
@@ -40,11 +39,6 @@ public:
     // construction and destruction
     TSmallUnorderedSet ();
     TSmallUnorderedSet (int iMaxQuantity, int iGrowBy);
-    TSmallUnorderedSet (const TSmallUnorderedSet& rkSet);
-    ~TSmallUnorderedSet ();
-
-    // assignment
-    TSmallUnorderedSet& operator= (const TSmallUnorderedSet& rkSet);
 
     // member access
     int GetMaxQuantity () const;
@@ -59,7 +53,7 @@ public:
     bool Insert (const T& rkElement);
     void InsertNoCheck (const T& rkElement);
     bool Remove (const T& rkElement);
-    bool Exists (const T& rkElement);
+    bool Exists (const T& rkElement) const;
 
     // make empty set, keep quantity and growth parameters
     void Clear ();
@@ -68,11 +62,12 @@ public:
     void Clear (int iMaxQuantity, int iGrowBy);
 
 private:
-    int m_iQuantity, m_iMaxQuantity, m_iGrowBy;
-    T* m_atElement;
+    int Search (const T& rkElement) const;  // -1 when missing
+
+    TArray<T> m_kElement;
 };
 
-#include "Wm4TSmallUnorderedSet.inl"
+#include "WgTSmallUnorderedSet.inl"
 
 }
 
@@ -0,0 +1,138 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgTSmallUnorderedSet.inl           //
+//                                                       //
+//  - Inlines for Small Unordered Set class              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+template <class T>
+TSmallUnorderedSet<T>::TSmallUnorderedSet ()
+    :
+    m_kElement(1,1)
+{
+}
+//----------------------------------------------------------------------------
+template <class T>
+TSmallUnorderedSet<T>::TSmallUnorderedSet (int iMaxQuantity, int iGrowBy)
+    :
+    m_kElement(iMaxQuantity > 0 ? iMaxQuantity : 1,
+        iGrowBy > 0 ? iGrowBy : 1)
+{
+    assert(iMaxQuantity > 0 && iGrowBy > 0);
+}
+//----------------------------------------------------------------------------
+template <class T>
+int TSmallUnorderedSet<T>::GetMaxQuantity () const
+{
+    return m_kElement.GetMaxQuantity();
+}
+//----------------------------------------------------------------------------
+template <class T>
+int TSmallUnorderedSet<T>::GetGrowBy () const
+{
+    return m_kElement.GetGrowBy();
+}
+//----------------------------------------------------------------------------
+template <class T>
+int TSmallUnorderedSet<T>::GetQuantity () const
+{
+    return m_kElement.GetQuantity();
+}
+//----------------------------------------------------------------------------
+template <class T>
+T* TSmallUnorderedSet<T>::GetElements ()
+{
+    return m_kElement.GetArray();
+}
+//----------------------------------------------------------------------------
+template <class T>
+const T* TSmallUnorderedSet<T>::GetElements () const
+{
+    return m_kElement.GetArray();
+}
+//----------------------------------------------------------------------------
+template <class T>
+T& TSmallUnorderedSet<T>::operator[] (int i)
+{
+    return m_kElement[i];
+}
+//----------------------------------------------------------------------------
+template <class T>
+const T& TSmallUnorderedSet<T>::operator[] (int i) const
+{
+    return m_kElement[i];
+}
+//----------------------------------------------------------------------------
+template <class T>
+bool TSmallUnorderedSet<T>::Insert (const T& rkElement)
+{
+    if (Search(rkElement) >= 0)
+    {
+        return false;
+    }
+
+    m_kElement.Append(rkElement);
+    return true;
+}
+//----------------------------------------------------------------------------
+template <class T>
+void TSmallUnorderedSet<T>::InsertNoCheck (const T& rkElement)
+{
+    m_kElement.Append(rkElement);
+}
+//----------------------------------------------------------------------------
+template <class T>
+bool TSmallUnorderedSet<T>::Remove (const T& rkElement)
+{
+    int i = Search(rkElement);
+    if (i < 0)
+    {
+        return false;
+    }
+
+    // the order of the set does not matter, the last element fills the slot
+    int iLast = m_kElement.GetQuantity() - 1;
+    if (i < iLast)
+    {
+        m_kElement[i] = m_kElement[iLast];
+    }
+    m_kElement.Remove(iLast);
+    return true;
+}
+//----------------------------------------------------------------------------
+template <class T>
+bool TSmallUnorderedSet<T>::Exists (const T& rkElement) const
+{
+    return Search(rkElement) >= 0;
+}
+//----------------------------------------------------------------------------
+template <class T>
+void TSmallUnorderedSet<T>::Clear ()
+{
+    m_kElement.RemoveAll();
+}
+//----------------------------------------------------------------------------
+template <class T>
+void TSmallUnorderedSet<T>::Clear (int iMaxQuantity, int iGrowBy)
+{
+    assert(iMaxQuantity > 0 && iGrowBy > 0);
+    m_kElement.SetMaxQuantity(iMaxQuantity > 0 ? iMaxQuantity : 1,false);
+    m_kElement.SetGrowBy(iGrowBy > 0 ? iGrowBy : 1);
+}
+//----------------------------------------------------------------------------
+template <class T>
+int TSmallUnorderedSet<T>::Search (const T& rkElement) const
+{
+    for (int i = 0; i < m_kElement.GetQuantity(); i++)
+    {
+        if (rkElement == m_kElement[i])
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+//----------------------------------------------------------------------------
@@ -12,6 +12,7 @@
 #define __WG_TSTACK_H__
 
 #include "WgFoundationLIB.h"
+#include "WgFrameArena.h"
 
 // The class T is either native data or is class data that has the following
 // member functions:
@@ -26,7 +27,10 @@ template <class T>
 class TStack
 {
 public:
-    TStack (int iMaxQuantity = 64);
+    // The elements are stored in the arena when one is given, otherwise on
+    // the heap.  A stack in an arena must be destroyed before the arena is
+    // reset or released to a mark taken before the construction.
+    TStack (int iMaxQuantity = 64, FrameArena* pkArena = 0);
     ~TStack ();
 
     bool IsEmpty () const;
@@ -43,6 +47,7 @@ public:
 private:
     int m_iMaxQuantity, m_iTop;
     T* m_atStack;
+    FrameArena* m_pkArena;
 };
 
 #include "WgTStack.inl"
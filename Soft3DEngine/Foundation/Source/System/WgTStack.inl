@@ -11,18 +11,40 @@
 
 //----------------------------------------------------------------------------
 template <class T>
-TStack<T>::TStack (int iMaxQuantity)
+TStack<T>::TStack (int iMaxQuantity, FrameArena* pkArena)
 {
     assert(iMaxQuantity > 0);
     m_iMaxQuantity = iMaxQuantity;
     m_iTop = -1;
-    m_atStack = WG_NEW T[m_iMaxQuantity];
+    m_pkArena = pkArena;
+    if (m_pkArena)
+    {
+        m_atStack = (T*)m_pkArena->Allocate(m_iMaxQuantity*sizeof(T));
+        for (int i = 0; i < m_iMaxQuantity; i++)
+        {
+            new(&m_atStack[i]) T;
+        }
+    }
+    else
+    {
+        m_atStack = WG_NEW T[m_iMaxQuantity];
+    }
 }
 //----------------------------------------------------------------------------
 template <class T>
 TStack<T>::~TStack ()
 {
-    WG_DELETE[] m_atStack;
+    if (m_pkArena)
+    {
+        for (int i = 0; i < m_iMaxQuantity; i++)
+        {
+            m_atStack[i].~T();
+        }
+    }
+    else
+    {
+        WG_DELETE[] m_atStack;
+    }
 }
 //----------------------------------------------------------------------------
 template <class T>
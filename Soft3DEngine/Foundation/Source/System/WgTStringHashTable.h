@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgTStringHashTable.h               //
+//                                                       //
+//  - Interface for String Hash Table class              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_TSTRINGHASHTABLE_H__
+#define __WG_TSTRINGHASHTABLE_H__
+
+#include "WgFoundationLIB.h"
+
+// The class TVALUE is either native data or is class data that has the
+// following member functions:
+//   TVALUE::TVALUE ()
+//   TVALUE& TVALUE::operator= (const TVALUE&)
+
+#include "WgString.h"
+#include "WgTHashTable.h"
+
+namespace WGSoft3D
+{
+
+// A THashTable keyed by strings.  Find and Remove take the text of the key,
+// so a lookup by a literal or a char buffer does not build a String.  The
+// hash of the text is the hash of String, so the table has no user hash
+// function.
+
+template <class TVALUE>
+class TStringHashTable : protected THashTable<String,TVALUE>
+{
+public:
+    // Construction and destruction.  The table starts with room for
+    // iTableSize pairs and grows as needed.
+    TStringHashTable (int iTableSize);
+
+    // element access
+    using THashTable<String,TVALUE>::GetQuantity;
+
+    // insert a key-value pair into the hash table
+    using THashTable<String,TVALUE>::Insert;
+
+    // search for a key and returns it value (null, if key does not exist)
+    TVALUE* Find (const char* acKey) const;
+
+    // remove key-value pairs from the hash table
+    bool Remove (const char* acKey);
+    using THashTable<String,TVALUE>::RemoveAll;
+
+    // linear traversal of table
+    using THashTable<String,TVALUE>::GetFirst;
+    using THashTable<String,TVALUE>::GetNext;
+
+    // profiling
+    using THashTable<String,TVALUE>::GetTableSize;
+    using THashTable<String,TVALUE>::GetMeanProbeLength;
+
+private:
+    // the hash of String::operator unsigned int and the length of the text
+    static unsigned int HashText (const char* acText, int& riLength);
+
+    int FindSlot (const char* acKey) const;  // -1 when missing
+};
+
+#include "WgTStringHashTable.inl"
+
+}
+
+#endif
@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgTStringHashTable.inl             //
+//                                                       //
+//  - Inlines for String Hash Table class                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+template <class TVALUE>
+TStringHashTable<TVALUE>::TStringHashTable (int iTableSize)
+    :
+    THashTable<String,TVALUE>(iTableSize)
+{
+}
+//----------------------------------------------------------------------------
+template <class TVALUE>
+TVALUE* TStringHashTable<TVALUE>::Find (const char* acKey) const
+{
+    int iSlot = FindSlot(acKey);
+    return (iSlot >= 0 ? &this->m_akTable[iSlot].m_tValue : 0);
+}
+//----------------------------------------------------------------------------
+template <class TVALUE>
+bool TStringHashTable<TVALUE>::Remove (const char* acKey)
+{
+    int iSlot = FindSlot(acKey);
+    if (iSlot < 0)
+    {
+        return false;
+    }
+
+    this->RemoveSlot(iSlot);
+    return true;
+}
+//----------------------------------------------------------------------------
+template <class TVALUE>
+unsigned int TStringHashTable<TVALUE>::HashText (const char* acText,
+    int& riLength)
+{
+    unsigned int uiKey = 0;
+    int i;
+    for (i = 0; acText[i]; i++)
+    {
+        uiKey += (uiKey << 5) + acText[i];
+    }
+    riLength = i;
+    return uiKey;
+}
+//----------------------------------------------------------------------------
+template <class TVALUE>
+int TStringHashTable<TVALUE>::FindSlot (const char* acKey) const
+{
+    assert(acKey);
+    if (!acKey)
+    {
+        return -1;
+    }
+
+    int iLength;
+    int iSlot = this->GetSlot(HashText(acKey,iLength));
+    for (int iDistance = 1; this->m_akTable[iSlot].m_iDistance >= iDistance;
+         iDistance++)
+    {
+        const String& rkKey = this->m_akTable[iSlot].m_tKey;
+        if (rkKey.GetLength() == iLength
+        &&  memcmp((const char*)rkKey,acKey,iLength) == 0)
+        {
+            return iSlot;
+        }
+        iSlot = this->GetNextSlot(iSlot);
+    }
+
+    return -1;
+}
+//----------------------------------------------------------------------------
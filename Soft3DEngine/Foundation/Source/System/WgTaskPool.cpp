@@ -0,0 +1,424 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgTaskPool.cpp                     //
+//                                                       //
+//  - Implementation for Task Pool class                 //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgFoundationPCH.h"
+#include "WgTaskPool.h"
+#include "WgTArray.h"
+using namespace WGSoft3D;
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------------
+// platform layer
+//----------------------------------------------------------------------------
+namespace WGSoft3D
+{
+
+class TaskLock
+{
+public:
+    TaskLock ()
+    {
+#if defined(_WIN32)
+        InitializeCriticalSection(&m_kSection);
+#else
+        pthread_mutex_init(&m_kMutex,0);
+#endif
+    }
+
+    ~TaskLock ()
+    {
+#if defined(_WIN32)
+        DeleteCriticalSection(&m_kSection);
+#else
+        pthread_mutex_destroy(&m_kMutex);
+#endif
+    }
+
+    void Enter ()
+    {
+#if defined(_WIN32)
+        EnterCriticalSection(&m_kSection);
+#else
+        pthread_mutex_lock(&m_kMutex);
+#endif
+    }
+
+    void Leave ()
+    {
+#if defined(_WIN32)
+        LeaveCriticalSection(&m_kSection);
+#else
+        pthread_mutex_unlock(&m_kMutex);
+#endif
+    }
+
+private:
+#if defined(_WIN32)
+    CRITICAL_SECTION m_kSection;
+#else
+    pthread_mutex_t m_kMutex;
+#endif
+};
+
+// An event that wakes one waiting thread and then resets itself.
+class TaskEvent
+{
+public:
+    TaskEvent ()
+    {
+#if defined(_WIN32)
+        m_hEvent = CreateEvent(0,FALSE,FALSE,0);
+#else
+        pthread_mutex_init(&m_kMutex,0);
+        pthread_cond_init(&m_kCondition,0);
+        m_bSignaled = false;
+#endif
+    }
+
+    ~TaskEvent ()
+    {
+#if defined(_WIN32)
+        CloseHandle(m_hEvent);
+#else
+        pthread_cond_destroy(&m_kCondition);
+        pthread_mutex_destroy(&m_kMutex);
+#endif
+    }
+
+    void Signal ()
+    {
+#if defined(_WIN32)
+        SetEvent(m_hEvent);
+#else
+        pthread_mutex_lock(&m_kMutex);
+        m_bSignaled = true;
+        pthread_cond_signal(&m_kCondition);
+        pthread_mutex_unlock(&m_kMutex);
+#endif
+    }
+
+    void Wait ()
+    {
+#if defined(_WIN32)
+        WaitForSingleObject(m_hEvent,INFINITE);
+#else
+        pthread_mutex_lock(&m_kMutex);
+        while (!m_bSignaled)
+        {
+            pthread_cond_wait(&m_kCondition,&m_kMutex);
+        }
+        m_bSignaled = false;
+        pthread_mutex_unlock(&m_kMutex);
+#endif
+    }
+
+private:
+#if defined(_WIN32)
+    HANDLE m_hEvent;
+#else
+    pthread_mutex_t m_kMutex;
+    pthread_cond_t m_kCondition;
+    bool m_bSignaled;
+#endif
+};
+
+}
+
+static void YieldThread ()
+{
+#if defined(_WIN32)
+    Sleep(0);
+#else
+    sched_yield();
+#endif
+}
+
+//----------------------------------------------------------------------------
+// workers
+//----------------------------------------------------------------------------
+class TaskPool::Worker
+{
+public:
+    Worker ()
+        :
+        Queue(0,64)
+    {
+        Front = 0;
+        Pool = 0;
+        Index = 0;
+#if defined(_WIN32)
+        Thread = 0;
+#endif
+    }
+
+    // The tasks in [Front,Queue.GetQuantity()).  The owner takes them from
+    // the back, thieves take them from the front.
+    TaskLock Lock;
+    TArray<Task*> Queue;
+    int Front;
+
+    TaskEvent Wake;
+    TaskPool* Pool;
+    int Index;
+
+#if defined(_WIN32)
+    HANDLE Thread;
+#else
+    pthread_t Thread;
+#endif
+};
+
+#if defined(_WIN32)
+static DWORD WINAPI WorkerMain (LPVOID pvWorker)
+#else
+static void* WorkerMain (void* pvWorker)
+#endif
+{
+    TaskPool::Worker* pkWorker = (TaskPool::Worker*)pvWorker;
+    pkWorker->Pool->Serve(pkWorker->Index);
+    return 0;
+}
+
+//----------------------------------------------------------------------------
+// Task
+//----------------------------------------------------------------------------
+Task::~Task ()
+{
+}
+
+//----------------------------------------------------------------------------
+// TaskPool
+//----------------------------------------------------------------------------
+TaskPool::TaskPool (int iThreadQuantity)
+{
+    if (iThreadQuantity <= 0)
+    {
+        iThreadQuantity = GetProcessorQuantity();
+    }
+
+    m_iThreadQuantity = iThreadQuantity;
+    m_akWorker = WG_NEW Worker[m_iThreadQuantity];
+    m_pvLock = WG_NEW TaskLock;
+    m_iPending = 0;
+    m_iStealQuantity = 0;
+    m_bQuit = false;
+
+    // worker 0 is the thread that calls Run
+    for (int i = 0; i < m_iThreadQuantity; i++)
+    {
+        Worker& rkWorker = m_akWorker[i];
+        rkWorker.Pool = this;
+        rkWorker.Index = i;
+        if (i > 0)
+        {
+#if defined(_WIN32)
+            rkWorker.Thread = CreateThread(0,0,WorkerMain,&rkWorker,0,0);
+#else
+            pthread_create(&rkWorker.Thread,0,WorkerMain,&rkWorker);
+#endif
+        }
+    }
+}
+//----------------------------------------------------------------------------
+TaskPool::~TaskPool ()
+{
+    m_bQuit = true;
+    int i;
+    for (i = 1; i < m_iThreadQuantity; i++)
+    {
+        m_akWorker[i].Wake.Signal();
+    }
+    for (i = 1; i < m_iThreadQuantity; i++)
+    {
+#if defined(_WIN32)
+        WaitForSingleObject(m_akWorker[i].Thread,INFINITE);
+        CloseHandle(m_akWorker[i].Thread);
+#else
+        pthread_join(m_akWorker[i].Thread,0);
+#endif
+    }
+
+    WG_DELETE[] m_akWorker;
+    WG_DELETE (TaskLock*)m_pvLock;
+}
+//----------------------------------------------------------------------------
+int TaskPool::GetProcessorQuantity ()
+{
+#if defined(_WIN32)
+    SYSTEM_INFO kInfo;
+    GetSystemInfo(&kInfo);
+    int iQuantity = (int)kInfo.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    int iQuantity = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#else
+    int iQuantity = 1;
+#endif
+    return (iQuantity > 0 ? iQuantity : 1);
+}
+//----------------------------------------------------------------------------
+void TaskPool::Run (int iQuantity, Task** apkTask)
+{
+    if (iQuantity <= 0)
+    {
+        return;
+    }
+
+    Lock();
+    m_iPending = iQuantity;
+    m_iStealQuantity = 0;
+    Unlock();
+
+    int i;
+    for (i = 0; i < iQuantity; i++)
+    {
+        Worker& rkWorker = m_akWorker[i % m_iThreadQuantity];
+        rkWorker.Lock.Enter();
+        rkWorker.Queue.Append(apkTask[i]);
+        rkWorker.Lock.Leave();
+    }
+
+    for (i = 1; i < m_iThreadQuantity; i++)
+    {
+        m_akWorker[i].Wake.Signal();
+    }
+
+    // The calling thread works as well and returns when nothing is pending.
+    // The other workers go back to sleep on their own.
+    Work(0);
+}
+//----------------------------------------------------------------------------
+void TaskPool::Spawn (Task* pkTask, int iWorker)
+{
+    assert(0 <= iWorker && iWorker < m_iThreadQuantity);
+
+    // The batch is not finished before the spawning task is, so the new
+    // task is counted before anyone can see the count drop to zero.
+    Lock();
+    m_iPending++;
+    Unlock();
+
+    Worker& rkWorker = m_akWorker[iWorker];
+    rkWorker.Lock.Enter();
+    rkWorker.Queue.Append(pkTask);
+    rkWorker.Lock.Leave();
+}
+//----------------------------------------------------------------------------
+void TaskPool::Lock ()
+{
+    ((TaskLock*)m_pvLock)->Enter();
+}
+//----------------------------------------------------------------------------
+void TaskPool::Unlock ()
+{
+    ((TaskLock*)m_pvLock)->Leave();
+}
+//----------------------------------------------------------------------------
+Task* TaskPool::Acquire (int iWorker)
+{
+    Task* pkTask = 0;
+
+    // the newest task of the worker's own queue
+    Worker& rkOwn = m_akWorker[iWorker];
+    rkOwn.Lock.Enter();
+    int iLast = rkOwn.Queue.GetQuantity() - 1;
+    if (iLast >= rkOwn.Front)
+    {
+        pkTask = rkOwn.Queue[iLast];
+        rkOwn.Queue.Remove(iLast);
+        if (iLast == rkOwn.Front)
+        {
+            rkOwn.Queue.RemoveAll();
+            rkOwn.Front = 0;
+        }
+    }
+    rkOwn.Lock.Leave();
+    if (pkTask)
+    {
+        return pkTask;
+    }
+
+    // the oldest task of another worker
+    for (int i = 1; i < m_iThreadQuantity; i++)
+    {
+        Worker& rkVictim = m_akWorker[(iWorker + i) % m_iThreadQuantity];
+        rkVictim.Lock.Enter();
+        if (rkVictim.Front < rkVictim.Queue.GetQuantity())
+        {
+            pkTask = rkVictim.Queue[rkVictim.Front++];
+            if (rkVictim.Front == rkVictim.Queue.GetQuantity())
+            {
+                rkVictim.Queue.RemoveAll();
+                rkVictim.Front = 0;
+            }
+        }
+        rkVictim.Lock.Leave();
+
+        if (pkTask)
+        {
+            Lock();
+            m_iStealQuantity++;
+            Unlock();
+            return pkTask;
+        }
+    }
+
+    return 0;
+}
+//----------------------------------------------------------------------------
+void TaskPool::Work (int iWorker)
+{
+    for (;;)
+    {
+        Task* pkTask = Acquire(iWorker);
+        if (pkTask)
+        {
+            pkTask->Execute(*this,iWorker);
+            Finish();
+            continue;
+        }
+
+        // Nothing to take.  Tasks that are still running may spawn more.
+        Lock();
+        int iPending = m_iPending;
+        Unlock();
+        if (iPending == 0)
+        {
+            return;
+        }
+        YieldThread();
+    }
+}
+//----------------------------------------------------------------------------
+void TaskPool::Finish ()
+{
+    Lock();
+    m_iPending--;
+    Unlock();
+}
+//----------------------------------------------------------------------------
+void TaskPool::Serve (int iWorker)
+{
+    Worker& rkWorker = m_akWorker[iWorker];
+    for (;;)
+    {
+        rkWorker.Wake.Wait();
+        if (m_bQuit)
+        {
+            return;
+        }
+        Work(iWorker);
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgTaskPool.h                       //
+//                                                       //
+//  - Interface for Task Pool class                      //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG3D_TASKPOOL_H__
+#define __WG3D_TASKPOOL_H__
+
+#include "WgFoundationLIB.h"
+#include "WgSystem.h"
+
+namespace WGSoft3D
+{
+
+class TaskPool;
+
+class WG3D_FOUNDATION_ITEM Task
+{
+public:
+    virtual ~Task ();
+
+    // iWorker is the index of the worker that runs the task, 0 being the
+    // thread that called TaskPool::Run.
+    virtual void Execute (TaskPool& rkPool, int iWorker) = 0;
+};
+
+// A fixed set of worker threads with work stealing.  Every worker owns a
+// queue of tasks.  It runs the newest task of its own queue and, when that
+// is empty, steals the oldest task of another worker, so a worker that
+// finishes early takes over the work that was planned for a busy one.  Run
+// hands out a batch of tasks, works on them on the calling thread as
+// worker 0 and returns when the batch is done, including the tasks that
+// were spawned by it.  The pool does not own the tasks.  Run is not
+// reentrant: a task may call Spawn, but not Run.
+
+class WG3D_FOUNDATION_ITEM TaskPool
+{
+public:
+    class Worker;  // defined in WgTaskPool.cpp
+
+    // The quantity includes the thread that calls Run, so a pool of one
+    // thread runs everything on the calling thread.  Zero selects the
+    // number of processors.
+    TaskPool (int iThreadQuantity = 0);
+    ~TaskPool ();
+
+    int GetThreadQuantity () const;
+    static int GetProcessorQuantity ();
+
+    // Run a batch of tasks and wait for them.  The tasks are dealt to the
+    // workers in order.
+    void Run (int iQuantity, Task** apkTask);
+
+    // Add a task to the batch that is running (call from Task::Execute).
+    void Spawn (Task* pkTask, int iWorker);
+
+    // a lock for the data that tasks share
+    void Lock ();
+    void Unlock ();
+
+    // the number of tasks that were stolen during the most recent Run
+    int GetStealQuantity () const;
+
+private:
+    Task* Acquire (int iWorker);
+    void Work (int iWorker);
+    void Finish ();
+
+    int m_iThreadQuantity;
+    Worker* m_akWorker;
+    void* m_pvLock;
+
+    // shared by the workers, accessed under m_pvLock
+    int m_iPending;
+    int m_iStealQuantity;
+    bool m_bQuit;
+
+// internal use
+public:
+    // the loop of the worker threads
+    void Serve (int iWorker);
+};
+
+#include "WgTaskPool.inl"
+
+}
+
+#endif
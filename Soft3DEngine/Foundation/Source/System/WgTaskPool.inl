@@ -0,0 +1,19 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgTaskPool.inl                     //
+//                                                       //
+//  - Inlines for Task Pool class                        //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+inline int TaskPool::GetThreadQuantity () const
+{
+    return m_iThreadQuantity;
+}
+//----------------------------------------------------------------------------
+inline int TaskPool::GetStealQuantity () const
+{
+    return m_iStealQuantity;
+}
+//----------------------------------------------------------------------------
@@ -21,7 +21,7 @@
 
 // containment
 
-//#include "WgContBox3.h"
+#include "WgContBox3.h"
 #include "WgContSphere3.h"
 
 // controllers
@@ -57,9 +57,9 @@
 // #include "WgIntrArc2Circle2.h"
 // #include "WgIntrBox2Box2.h"
 // #include "WgIntrBox2Circle2.h"
-// #include "WgIntrBox3Box3.h"
+#include "WgIntrBox3Box3.h"
 // #include "WgIntrBox3Frustum3.h"
-// #include "WgIntrBox3Sphere3.h"
+#include "WgIntrBox3Sphere3.h"
 // #include "WgIntrCapsule3Capsule3.h"
 // #include "WgIntrCircle2Circle2.h"
 // #include "WgIntrCircle3Plane3.h"
@@ -91,7 +91,7 @@
 // #include "WgIntrRay2Arc2.h"
 // #include "WgIntrRay2Box2.h"
 // #include "WgIntrRay2Circle2.h"
-// #include "WgIntrRay3Box3.h"
+#include "WgIntrRay3Box3.h"
 // #include "WgIntrRay3Capsule3.h"
 // #include "WgIntrRay3Cylinder3.h"
 // #include "WgIntrRay3Ellipsoid3.h"
@@ -124,7 +124,7 @@
 // #include "WgAxisAlignedBox3.h"
 // #include "WgBandedMatrix.h"
 // #include "WgBox2.h"
-// #include "WgBox3.h"
+#include "WgBox3.h"
 // #include "WgCapsule3.h"
 // #include "WgCircle2.h"
 // #include "WgCircle3.h"
@@ -183,6 +183,8 @@
 #include "WgImage.h"
 #include "WgPBuffer.h"
 #include "WgRenderer.h"
+#include "WgRenderQueue.h"
+#include "WgRenderStats.h"
 #include "WgTexture.h"
 #include "WgAlphaState.h"
 #include "WgCullState.h"
@@ -199,18 +201,21 @@
 
 // scene graph
 #include "WgBoundingVolume.h"
-//#include "WgBoxBV.h"
+#include "WgBoxBV.h"
 #include "WgCamera.h"
 #include "WgGeometry.h"
 #include "WgLight.h"
+#include "WgLinearScene.h"
 #include "WgNode.h"
+#include "WgOrientedBoxBV.h"
 //#include "WgParticles.h"
 //#include "WgPolyline.h"
 //#include "WgPolypoint.h"
 #include "WgScreenPolygon.h"
 #include "WgSpatial.h"
+#include "WgSpatialIndex.h"
 #include "WgSphereBV.h"
-//#include "WgStandardMesh.h"
+#include "WgStandardMesh.h"
 #include "WgTransformation.h"
 #include "WgTriangles.h"
 //#include "WgTriFan.h"
@@ -245,13 +250,22 @@
 //#include "WgVector4Array.h"
 
 // system
+#include "WgFixedMath.h"
+#include "WgFixedSimd.h"
+#include "WgFrameArena.h"
+#include "WgProfiler.h"
 #include "WgString.h"
 #include "WgSystem.h"
 #include "WgTArray.h"
-//#include "WgTHashSet.h"
+#include "WgTaskPool.h"
+#include "WgTHashSet.h"
 #include "WgTHashTable.h"
 #include "WgTList.h"
+#include "WgTRelocatable.h"
 //#include "WgTSet.h"
+#include "WgTSmallArray.h"
+#include "WgTSmallUnorderedSet.h"
 #include "WgTStack.h"
+#include "WgTStringHashTable.h"
 
 #endif
@@ -85,6 +85,18 @@ LIB32=link.exe -lib
 # PROP Default_Filter ""
 # Begin Source File
 
+SOURCE=.\Source\Mathematics\WgBox3.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Mathematics\WgBox3.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Mathematics\WgBox3.inl
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\Mathematics\WgColorRGB.cpp
 # End Source File
 # Begin Source File
@@ -281,6 +293,14 @@ SOURCE=.\Source\Mathematics\WgVector4.inl
 # PROP Default_Filter ""
 # Begin Source File
 
+SOURCE=.\Source\Containment\WgContBox3.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Containment\WgContBox3.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\Containment\WgContSphere3.cpp
 # End Source File
 # Begin Source File
@@ -309,6 +329,30 @@ SOURCE=.\Source\Intersection\WgIntersector.inl
 # End Source File
 # Begin Source File
 
+SOURCE=.\Source\Intersection\WgIntrBox3Box3.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Intersection\WgIntrBox3Box3.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Intersection\WgIntrBox3Sphere3.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Intersection\WgIntrBox3Sphere3.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Intersection\WgIntrRay3Box3.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Intersection\WgIntrRay3Box3.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\Intersection\WgIntrRay3Sphere3.cpp
 # End Source File
 # Begin Source File
@@ -533,6 +577,30 @@ SOURCE=.\Source\Rendering\WgRenderer.inl
 # End Source File
 # Begin Source File
 
+SOURCE=.\Source\Rendering\WgRenderQueue.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Rendering\WgRenderQueue.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Rendering\WgRenderQueue.inl
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Rendering\WgRenderStats.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Rendering\WgRenderStats.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Rendering\WgRenderStats.inl
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\Rendering\WgTexture.cpp
 # End Source File
 # Begin Source File
@@ -557,6 +625,18 @@ SOURCE=.\Source\SceneGraph\WgBoundingVolume.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\Source\SceneGraph\WgBoxBV.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\SceneGraph\WgBoxBV.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\SceneGraph\WgBoxBV.inl
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\SceneGraph\WgCamera.cpp
 # End Source File
 # Begin Source File
@@ -593,6 +673,18 @@ SOURCE=.\Source\SceneGraph\WgLight.inl
 # End Source File
 # Begin Source File
 
+SOURCE=.\Source\SceneGraph\WgLinearScene.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\SceneGraph\WgLinearScene.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\SceneGraph\WgLinearScene.inl
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\SceneGraph\WgNode.cpp
 # End Source File
 # Begin Source File
@@ -605,6 +697,18 @@ SOURCE=.\Source\SceneGraph\WgNode.inl
 # End Source File
 # Begin Source File
 
+SOURCE=.\Source\SceneGraph\WgOrientedBoxBV.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\SceneGraph\WgOrientedBoxBV.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\SceneGraph\WgOrientedBoxBV.inl
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\SceneGraph\WgScreenPolygon.cpp
 # End Source File
 # Begin Source File
@@ -629,6 +733,18 @@ SOURCE=.\Source\SceneGraph\WgSpatial.inl
 # End Source File
 # Begin Source File
 
+SOURCE=.\Source\SceneGraph\WgSpatialIndex.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\SceneGraph\WgSpatialIndex.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\SceneGraph\WgSpatialIndex.inl
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\SceneGraph\WgSphereBV.cpp
 # End Source File
 # Begin Source File
@@ -641,6 +757,18 @@ SOURCE=.\Source\SceneGraph\WgSphereBV.inl
 # End Source File
 # Begin Source File
 
+SOURCE=.\Source\SceneGraph\WgStandardMesh.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\SceneGraph\WgStandardMesh.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\SceneGraph\WgStandardMesh.inl
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\SceneGraph\WgTransformation.cpp
 # End Source File
 # Begin Source File
@@ -797,6 +925,42 @@ SOURCE=.\Source\System\WgFixed.inl
 # End Source File
 # Begin Source File
 
+SOURCE=.\Source\System\WgFixedMath.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgFixedMath.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgFixedSimd.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgFixedSimd.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgFloatx.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgFrameArena.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgFrameArena.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgFrameArena.inl
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgMemory.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\System\WgMemory.h
 # End Source File
 # Begin Source File
@@ -805,6 +969,18 @@ SOURCE=.\Source\System\WgPlatforms.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\Source\System\WgProfiler.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgProfiler.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgProfiler.inl
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\System\WgSinTable.h
 # End Source File
 # Begin Source File
@@ -837,6 +1013,26 @@ SOURCE=.\Source\System\WgTArray.inl
 # End Source File
 # Begin Source File
 
+SOURCE=.\Source\System\WgTaskPool.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgTaskPool.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgTaskPool.inl
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgTHashSet.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgTHashSet.inl
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\System\WgTHashTable.h
 # End Source File
 # Begin Source File
@@ -853,12 +1049,40 @@ SOURCE=.\Source\System\WgTList.inl
 # End Source File
 # Begin Source File
 
+SOURCE=.\Source\System\WgTRelocatable.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgTSmallArray.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgTSmallArray.inl
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgTSmallUnorderedSet.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgTSmallUnorderedSet.inl
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\System\WgTStack.h
 # End Source File
 # Begin Source File
 
 SOURCE=.\Source\System\WgTStack.inl
 # End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgTStringHashTable.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\System\WgTStringHashTable.inl
+# End Source File
 # End Group
 # Begin Group "Controllers"
 
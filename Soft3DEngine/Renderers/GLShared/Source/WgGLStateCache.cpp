@@ -0,0 +1,928 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgGLStateCache.cpp                 //
+//                                                       //
+//  - Implementation for GL State Cache class            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgGLStateCache.h"
+using namespace WGSoft3D;
+
+const GLenum GLStateCache::UNKNOWN_ENUM = (GLenum)~0;
+const GLuint GLStateCache::UNKNOWN_NAME = (GLuint)~0;
+
+// the OpenGL capability of each CAP_* index
+static const GLenum gs_aeCap[] =
+{
+    GL_ALPHA_TEST,
+    GL_BLEND,
+    GL_CULL_FACE,
+    GL_DEPTH_TEST,
+    GL_DITHER,
+    GL_FOG,
+    GL_LIGHTING,
+    GL_LIGHT0,
+    GL_LIGHT1,
+    GL_LIGHT2,
+    GL_LIGHT3,
+    GL_LIGHT4,
+    GL_LIGHT5,
+    GL_LIGHT6,
+    GL_LIGHT7,
+    GL_NORMALIZE,
+    GL_POLYGON_OFFSET_FILL,
+    GL_RESCALE_NORMAL,
+    GL_SCISSOR_TEST,
+    GL_STENCIL_TEST
+};
+
+//----------------------------------------------------------------------------
+static bool SameReals (int iQuantity, const GLreal* af0, const GLreal* af1)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        if (af0[i] != af1[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+static void CopyReals (int iQuantity, const GLreal* afSrc, GLreal* afDst)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        afDst[i] = afSrc[i];
+    }
+}
+//----------------------------------------------------------------------------
+static bool QueryInteger (GLenum ePName, GLint iValue)
+{
+    GLint iQuery = 0;
+    glGetIntegerv(ePName,&iQuery);
+    return iQuery == iValue;
+}
+//----------------------------------------------------------------------------
+static bool QueryReals (GLenum ePName, int iQuantity, const GLreal* afValue)
+{
+    GLreal afQuery[4] = { 0, 0, 0, 0 };
+    glGetRealv(ePName,afQuery);
+    return SameReals(iQuantity,afQuery,afValue);
+}
+//----------------------------------------------------------------------------
+GLStateCache::GLStateCache ()
+{
+    Invalidate();
+    ResetCounters();
+}
+//----------------------------------------------------------------------------
+void GLStateCache::Invalidate ()
+{
+    int i;
+    for (i = 0; i < CAP_QUANTITY; i++)
+    {
+        m_aiCap[i] = UNKNOWN;
+    }
+
+    for (i = 0; i < MAX_TEXTURE_UNITS; i++)
+    {
+        UnitState& rkUnit = m_akUnit[i];
+        rkUnit.Enabled = UNKNOWN;
+        rkUnit.Texture = UNKNOWN_NAME;
+        rkUnit.EnvMode = UNKNOWN_ENUM;
+        rkUnit.KnownEnvColor = false;
+    }
+    m_iActiveUnit = UNKNOWN;
+    m_iClientActiveUnit = UNKNOWN;
+    m_ePerspectiveHint = UNKNOWN_ENUM;
+    m_eFogHint = UNKNOWN_ENUM;
+
+    for (i = 0; i < ARRAY_QUANTITY; i++)
+    {
+        m_akArray[i].Enabled = UNKNOWN;
+        m_akArray[i].KnownPointer = false;
+    }
+    m_uiArrayBuffer = UNKNOWN_NAME;
+    m_uiElementBuffer = UNKNOWN_NAME;
+
+    m_eAlphaFunc = UNKNOWN_ENUM;
+    m_eBlendSrc = UNKNOWN_ENUM;
+    m_eBlendDst = UNKNOWN_ENUM;
+    m_eDepthFunc = UNKNOWN_ENUM;
+    m_iDepthMask = UNKNOWN;
+    m_eStencilFunc = UNKNOWN_ENUM;
+    m_eStencilFail = UNKNOWN_ENUM;
+    m_bKnownStencilMask = false;
+
+    m_eCullFace = UNKNOWN_ENUM;
+    m_eFrontFace = UNKNOWN_ENUM;
+    m_eShadeModel = UNKNOWN_ENUM;
+    m_bKnownPolygonOffset = false;
+
+    for (i = 0; i < 4; i++)
+    {
+        m_abKnownMaterial[i] = false;
+    }
+    m_bKnownShininess = false;
+
+    for (i = 0; i < 3; i++)
+    {
+        m_abKnownFog[i] = false;
+    }
+    m_eFogMode = UNKNOWN_ENUM;
+    m_bKnownFogColor = false;
+}
+//----------------------------------------------------------------------------
+int GLStateCache::GetCapIndex (GLenum eCap)
+{
+    switch (eCap)
+    {
+    case GL_ALPHA_TEST:           return CAP_ALPHA_TEST;
+    case GL_BLEND:                return CAP_BLEND;
+    case GL_CULL_FACE:            return CAP_CULL_FACE;
+    case GL_DEPTH_TEST:           return CAP_DEPTH_TEST;
+    case GL_DITHER:               return CAP_DITHER;
+    case GL_FOG:                  return CAP_FOG;
+    case GL_LIGHTING:             return CAP_LIGHTING;
+    case GL_NORMALIZE:            return CAP_NORMALIZE;
+    case GL_POLYGON_OFFSET_FILL:  return CAP_POLYGON_OFFSET_FILL;
+    case GL_RESCALE_NORMAL:       return CAP_RESCALE_NORMAL;
+    case GL_SCISSOR_TEST:         return CAP_SCISSOR_TEST;
+    case GL_STENCIL_TEST:         return CAP_STENCIL_TEST;
+    }
+
+    if (GL_LIGHT0 <= eCap && eCap < GL_LIGHT0 + 8)
+    {
+        return CAP_LIGHT0 + (int)(eCap - GL_LIGHT0);
+    }
+    return -1;
+}
+//----------------------------------------------------------------------------
+int GLStateCache::GetArrayIndex (GLenum eArray, int iClientUnit)
+{
+    switch (eArray)
+    {
+    case GL_VERTEX_ARRAY:  return ARRAY_VERTEX;
+    case GL_NORMAL_ARRAY:  return ARRAY_NORMAL;
+    case GL_COLOR_ARRAY:   return ARRAY_COLOR;
+    case GL_TEXTURE_COORD_ARRAY:
+        if (0 <= iClientUnit && iClientUnit < MAX_TEXTURE_UNITS)
+        {
+            return ARRAY_TEXCOORD + iClientUnit;
+        }
+        break;
+    }
+    return -1;
+}
+//----------------------------------------------------------------------------
+void GLStateCache::SetEnabled (GLenum eCap, bool bEnabled)
+{
+    int iEnabled = (bEnabled ? 1 : 0);
+    int* piShadow = 0;
+    if (eCap == GL_TEXTURE_2D)
+    {
+        UnitState* pkUnit = GetActiveUnit();
+        if (pkUnit)
+        {
+            piShadow = &pkUnit->Enabled;
+        }
+    }
+    else
+    {
+        int iIndex = GetCapIndex(eCap);
+        if (iIndex >= 0)
+        {
+            piShadow = &m_aiCap[iIndex];
+        }
+    }
+
+    if (piShadow)
+    {
+        if (Filter(*piShadow == iEnabled))
+        {
+            return;
+        }
+        *piShadow = iEnabled;
+    }
+    else
+    {
+        m_iIssuedQuantity++;
+    }
+
+    if (bEnabled)
+    {
+        glEnable(eCap);
+    }
+    else
+    {
+        glDisable(eCap);
+    }
+}
+//----------------------------------------------------------------------------
+void GLStateCache::ActiveTexture (int iUnit)
+{
+    if (Filter(m_iActiveUnit == iUnit))
+    {
+        return;
+    }
+    m_iActiveUnit = iUnit;
+    glActiveTexture(GL_TEXTURE0+iUnit);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::ClientActiveTexture (int iUnit)
+{
+    if (Filter(m_iClientActiveUnit == iUnit))
+    {
+        return;
+    }
+    m_iClientActiveUnit = iUnit;
+    glClientActiveTexture(GL_TEXTURE0+iUnit);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::BindTexture (GLuint uiID)
+{
+    UnitState* pkUnit = GetActiveUnit();
+    if (pkUnit)
+    {
+        if (Filter(pkUnit->Texture == uiID))
+        {
+            return;
+        }
+        pkUnit->Texture = uiID;
+    }
+    else
+    {
+        m_iIssuedQuantity++;
+    }
+    glBindTexture(GL_TEXTURE_2D,uiID);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::DeleteTexture (GLuint uiID)
+{
+    // OpenGL binds the default texture to the units that used the deleted
+    // texture.
+    for (int i = 0; i < MAX_TEXTURE_UNITS; i++)
+    {
+        if (m_akUnit[i].Texture == uiID)
+        {
+            m_akUnit[i].Texture = 0;
+        }
+    }
+    m_iIssuedQuantity++;
+    glDeleteTextures((GLsizei)1,&uiID);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::TexEnvMode (GLenum eMode)
+{
+    UnitState* pkUnit = GetActiveUnit();
+    if (pkUnit)
+    {
+        if (Filter(pkUnit->EnvMode == eMode))
+        {
+            return;
+        }
+        pkUnit->EnvMode = eMode;
+    }
+    else
+    {
+        m_iIssuedQuantity++;
+    }
+    glTexEnvx(GL_TEXTURE_ENV,GL_TEXTURE_ENV_MODE,(GLfixed)eMode);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::TexEnvColor (const GLreal* afColor)
+{
+    UnitState* pkUnit = GetActiveUnit();
+    if (pkUnit)
+    {
+        if (Filter(pkUnit->KnownEnvColor
+        &&  SameReals(4,pkUnit->EnvColor,afColor)))
+        {
+            return;
+        }
+        pkUnit->KnownEnvColor = true;
+        CopyReals(4,afColor,pkUnit->EnvColor);
+    }
+    else
+    {
+        m_iIssuedQuantity++;
+    }
+    glTexEnvrv(GL_TEXTURE_ENV,GL_TEXTURE_ENV_COLOR,afColor);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::Hint (GLenum eTarget, GLenum eMode)
+{
+    GLenum* peShadow = 0;
+    if (eTarget == GL_PERSPECTIVE_CORRECTION_HINT)
+    {
+        peShadow = &m_ePerspectiveHint;
+    }
+    else if (eTarget == GL_FOG_HINT)
+    {
+        peShadow = &m_eFogHint;
+    }
+
+    if (peShadow)
+    {
+        if (Filter(*peShadow == eMode))
+        {
+            return;
+        }
+        *peShadow = eMode;
+    }
+    else
+    {
+        m_iIssuedQuantity++;
+    }
+    glHint(eTarget,eMode);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::SetClientState (GLenum eArray, bool bEnabled)
+{
+    int iEnabled = (bEnabled ? 1 : 0);
+    int iIndex = GetArrayIndex(eArray,m_iClientActiveUnit);
+    if (iIndex >= 0)
+    {
+        if (Filter(m_akArray[iIndex].Enabled == iEnabled))
+        {
+            return;
+        }
+        m_akArray[iIndex].Enabled = iEnabled;
+    }
+    else
+    {
+        m_iIssuedQuantity++;
+    }
+
+    if (bEnabled)
+    {
+        glEnableClientState(eArray);
+    }
+    else
+    {
+        glDisableClientState(eArray);
+    }
+}
+//----------------------------------------------------------------------------
+void GLStateCache::BindBuffer (GLenum eTarget, GLuint uiID)
+{
+    GLuint* puiShadow = 0;
+    if (eTarget == GL_ARRAY_BUFFER)
+    {
+        puiShadow = &m_uiArrayBuffer;
+    }
+    else if (eTarget == GL_ELEMENT_ARRAY_BUFFER)
+    {
+        puiShadow = &m_uiElementBuffer;
+    }
+
+    if (puiShadow)
+    {
+        if (Filter(*puiShadow == uiID))
+        {
+            return;
+        }
+        *puiShadow = uiID;
+    }
+    else
+    {
+        m_iIssuedQuantity++;
+    }
+    glBindBuffer(eTarget,uiID);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::DeleteBuffer (GLuint uiID)
+{
+    // OpenGL resets the bindings of the deleted buffer to zero, including
+    // the ones of the arrays that point into it.
+    if (m_uiArrayBuffer == uiID)
+    {
+        m_uiArrayBuffer = 0;
+    }
+    if (m_uiElementBuffer == uiID)
+    {
+        m_uiElementBuffer = 0;
+    }
+    for (int i = 0; i < ARRAY_QUANTITY; i++)
+    {
+        if (m_akArray[i].KnownPointer && m_akArray[i].Buffer == uiID)
+        {
+            m_akArray[i].KnownPointer = false;
+        }
+    }
+    m_iIssuedQuantity++;
+    glDeleteBuffers((GLsizei)1,&uiID);
+}
+//----------------------------------------------------------------------------
+bool GLStateCache::ChangePointer (int iArray, GLint iSize,
+    const GLvoid* pvPointer)
+{
+    // The pointer depends on the buffer bound to GL_ARRAY_BUFFER, so it is
+    // only cached while that binding is known.
+    if (iArray < 0 || m_uiArrayBuffer == UNKNOWN_NAME)
+    {
+        m_iIssuedQuantity++;
+        return true;
+    }
+
+    ArrayState& rkArray = m_akArray[iArray];
+    if (Filter(rkArray.KnownPointer
+    &&  rkArray.Buffer == m_uiArrayBuffer
+    &&  rkArray.Size == iSize
+    &&  rkArray.Pointer == pvPointer))
+    {
+        return false;
+    }
+    rkArray.KnownPointer = true;
+    rkArray.Buffer = m_uiArrayBuffer;
+    rkArray.Size = iSize;
+    rkArray.Pointer = pvPointer;
+    return true;
+}
+//----------------------------------------------------------------------------
+void GLStateCache::VertexPointer (GLint iSize, const GLvoid* pvPointer)
+{
+    if (ChangePointer(ARRAY_VERTEX,iSize,pvPointer))
+    {
+        glVertexPointer(iSize,GL_REAL,0,pvPointer);
+    }
+}
+//----------------------------------------------------------------------------
+void GLStateCache::NormalPointer (const GLvoid* pvPointer)
+{
+    if (ChangePointer(ARRAY_NORMAL,3,pvPointer))
+    {
+        glNormalPointer(GL_REAL,0,pvPointer);
+    }
+}
+//----------------------------------------------------------------------------
+void GLStateCache::ColorPointer (GLint iSize, const GLvoid* pvPointer)
+{
+    if (ChangePointer(ARRAY_COLOR,iSize,pvPointer))
+    {
+        glColorPointer(iSize,GL_REAL,0,pvPointer);
+    }
+}
+//----------------------------------------------------------------------------
+void GLStateCache::TexCoordPointer (GLint iSize, const GLvoid* pvPointer)
+{
+    int iArray = GetArrayIndex(GL_TEXTURE_COORD_ARRAY,m_iClientActiveUnit);
+    if (ChangePointer(iArray,iSize,pvPointer))
+    {
+        glTexCoordPointer(iSize,GL_REAL,0,pvPointer);
+    }
+}
+//----------------------------------------------------------------------------
+void GLStateCache::AlphaFunc (GLenum eFunc, GLreal fRef)
+{
+    if (Filter(m_eAlphaFunc == eFunc && m_fAlphaRef == fRef))
+    {
+        return;
+    }
+    m_eAlphaFunc = eFunc;
+    m_fAlphaRef = fRef;
+    glAlphaFuncr(eFunc,fRef);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::BlendFunc (GLenum eSrc, GLenum eDst)
+{
+    if (Filter(m_eBlendSrc == eSrc && m_eBlendDst == eDst))
+    {
+        return;
+    }
+    m_eBlendSrc = eSrc;
+    m_eBlendDst = eDst;
+    glBlendFunc(eSrc,eDst);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::DepthFunc (GLenum eFunc)
+{
+    if (Filter(m_eDepthFunc == eFunc))
+    {
+        return;
+    }
+    m_eDepthFunc = eFunc;
+    glDepthFunc(eFunc);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::DepthMask (GLboolean bFlag)
+{
+    int iMask = (bFlag ? 1 : 0);
+    if (Filter(m_iDepthMask == iMask))
+    {
+        return;
+    }
+    m_iDepthMask = iMask;
+    glDepthMask(bFlag);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::StencilFunc (GLenum eFunc, GLint iRef, GLuint uiMask)
+{
+    if (Filter(m_eStencilFunc == eFunc && m_iStencilRef == iRef
+    &&  m_uiStencilValueMask == uiMask))
+    {
+        return;
+    }
+    m_eStencilFunc = eFunc;
+    m_iStencilRef = iRef;
+    m_uiStencilValueMask = uiMask;
+    glStencilFunc(eFunc,iRef,uiMask);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::StencilOp (GLenum eFail, GLenum eZFail, GLenum eZPass)
+{
+    if (Filter(m_eStencilFail == eFail && m_eStencilZFail == eZFail
+    &&  m_eStencilZPass == eZPass))
+    {
+        return;
+    }
+    m_eStencilFail = eFail;
+    m_eStencilZFail = eZFail;
+    m_eStencilZPass = eZPass;
+    glStencilOp(eFail,eZFail,eZPass);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::StencilMask (GLuint uiMask)
+{
+    if (Filter(m_bKnownStencilMask && m_uiStencilWriteMask == uiMask))
+    {
+        return;
+    }
+    m_bKnownStencilMask = true;
+    m_uiStencilWriteMask = uiMask;
+    glStencilMask(uiMask);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::CullFace (GLenum eMode)
+{
+    if (Filter(m_eCullFace == eMode))
+    {
+        return;
+    }
+    m_eCullFace = eMode;
+    glCullFace(eMode);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::FrontFace (GLenum eMode)
+{
+    if (Filter(m_eFrontFace == eMode))
+    {
+        return;
+    }
+    m_eFrontFace = eMode;
+    glFrontFace(eMode);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::ShadeModel (GLenum eMode)
+{
+    if (Filter(m_eShadeModel == eMode))
+    {
+        return;
+    }
+    m_eShadeModel = eMode;
+    glShadeModel(eMode);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::PolygonOffset (GLreal fFactor, GLreal fUnits)
+{
+    if (Filter(m_bKnownPolygonOffset && m_fOffsetFactor == fFactor
+    &&  m_fOffsetUnits == fUnits))
+    {
+        return;
+    }
+    m_bKnownPolygonOffset = true;
+    m_fOffsetFactor = fFactor;
+    m_fOffsetUnits = fUnits;
+    glPolygonOffsetr(fFactor,fUnits);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::Materialv (GLenum ePName, const GLreal* afParam)
+{
+    int iIndex;
+    switch (ePName)
+    {
+    case GL_EMISSION:  iIndex = 0;   break;
+    case GL_AMBIENT:   iIndex = 1;   break;
+    case GL_DIFFUSE:   iIndex = 2;   break;
+    case GL_SPECULAR:  iIndex = 3;   break;
+    default:           iIndex = -1;  break;
+    }
+
+    if (iIndex >= 0)
+    {
+        if (Filter(m_abKnownMaterial[iIndex]
+        &&  SameReals(4,m_aafMaterial[iIndex],afParam)))
+        {
+            return;
+        }
+        m_abKnownMaterial[iIndex] = true;
+        CopyReals(4,afParam,m_aafMaterial[iIndex]);
+    }
+    else
+    {
+        m_iIssuedQuantity++;
+    }
+    glMaterialrv(GL_FRONT,ePName,afParam);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::Material (GLenum ePName, GLreal fParam)
+{
+    if (ePName == GL_SHININESS)
+    {
+        if (Filter(m_bKnownShininess && m_fShininess == fParam))
+        {
+            return;
+        }
+        m_bKnownShininess = true;
+        m_fShininess = fParam;
+    }
+    else
+    {
+        m_iIssuedQuantity++;
+    }
+    glMaterialr(GL_FRONT,ePName,fParam);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::Fog (GLenum ePName, GLreal fParam)
+{
+    int iIndex;
+    switch (ePName)
+    {
+    case GL_FOG_START:    iIndex = 0;   break;
+    case GL_FOG_END:      iIndex = 1;   break;
+    case GL_FOG_DENSITY:  iIndex = 2;   break;
+    default:              iIndex = -1;  break;
+    }
+
+    if (iIndex >= 0)
+    {
+        if (Filter(m_abKnownFog[iIndex] && m_afFog[iIndex] == fParam))
+        {
+            return;
+        }
+        m_abKnownFog[iIndex] = true;
+        m_afFog[iIndex] = fParam;
+    }
+    else
+    {
+        m_iIssuedQuantity++;
+    }
+    glFogr(ePName,fParam);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::FogMode (GLenum eMode)
+{
+    if (Filter(m_eFogMode == eMode))
+    {
+        return;
+    }
+    m_eFogMode = eMode;
+    glFogx(GL_FOG_MODE,(GLfixed)eMode);
+}
+//----------------------------------------------------------------------------
+void GLStateCache::FogColor (const GLreal* afColor)
+{
+    if (Filter(m_bKnownFogColor && SameReals(4,m_afFogColor,afColor)))
+    {
+        return;
+    }
+    m_bKnownFogColor = true;
+    CopyReals(4,afColor,m_afFogColor);
+    glFogrv(GL_FOG_COLOR,afColor);
+}
+//----------------------------------------------------------------------------
+bool GLStateCache::Verify () const
+{
+    bool bValid = true;
+    int i;
+
+    // capabilities
+    for (i = 0; i < CAP_QUANTITY; i++)
+    {
+        if (m_aiCap[i] != UNKNOWN)
+        {
+            int iEnabled = (glIsEnabled(gs_aeCap[i]) ? 1 : 0);
+            bValid = bValid && iEnabled == m_aiCap[i];
+        }
+    }
+
+    // texture units, only the active one can be queried
+    if (m_iActiveUnit != UNKNOWN)
+    {
+        bValid = bValid && QueryInteger(GL_ACTIVE_TEXTURE,
+            GL_TEXTURE0+m_iActiveUnit);
+    }
+    if (m_iClientActiveUnit != UNKNOWN)
+    {
+        bValid = bValid && QueryInteger(GL_CLIENT_ACTIVE_TEXTURE,
+            GL_TEXTURE0+m_iClientActiveUnit);
+    }
+    if (0 <= m_iActiveUnit && m_iActiveUnit < MAX_TEXTURE_UNITS)
+    {
+        const UnitState& rkUnit = m_akUnit[m_iActiveUnit];
+        if (rkUnit.Enabled != UNKNOWN)
+        {
+            int iEnabled = (glIsEnabled(GL_TEXTURE_2D) ? 1 : 0);
+            bValid = bValid && iEnabled == rkUnit.Enabled;
+        }
+        if (rkUnit.Texture != UNKNOWN_NAME)
+        {
+            bValid = bValid && QueryInteger(GL_TEXTURE_BINDING_2D,
+                (GLint)rkUnit.Texture);
+        }
+        if (rkUnit.EnvMode != UNKNOWN_ENUM)
+        {
+            GLint iMode = 0;
+            glGetTexEnviv(GL_TEXTURE_ENV,GL_TEXTURE_ENV_MODE,&iMode);
+            bValid = bValid && (GLenum)iMode == rkUnit.EnvMode;
+        }
+        if (rkUnit.KnownEnvColor)
+        {
+            GLreal afColor[4];
+            glGetTexEnvrv(GL_TEXTURE_ENV,GL_TEXTURE_ENV_COLOR,afColor);
+            bValid = bValid && SameReals(4,afColor,rkUnit.EnvColor);
+        }
+    }
+    if (m_ePerspectiveHint != UNKNOWN_ENUM)
+    {
+        bValid = bValid && QueryInteger(GL_PERSPECTIVE_CORRECTION_HINT,
+            (GLint)m_ePerspectiveHint);
+    }
+    if (m_eFogHint != UNKNOWN_ENUM)
+    {
+        bValid = bValid && QueryInteger(GL_FOG_HINT,(GLint)m_eFogHint);
+    }
+
+    // client arrays, only the client active texture coordinates
+    static const GLenum s_aeArray[4] =
+    {
+        GL_VERTEX_ARRAY, GL_NORMAL_ARRAY, GL_COLOR_ARRAY,
+        GL_TEXTURE_COORD_ARRAY
+    };
+    static const GLenum s_aePointer[4] =
+    {
+        GL_VERTEX_ARRAY_POINTER, GL_NORMAL_ARRAY_POINTER,
+        GL_COLOR_ARRAY_POINTER, GL_TEXTURE_COORD_ARRAY_POINTER
+    };
+    static const GLenum s_aeBinding[4] =
+    {
+        GL_VERTEX_ARRAY_BUFFER_BINDING, GL_NORMAL_ARRAY_BUFFER_BINDING,
+        GL_COLOR_ARRAY_BUFFER_BINDING, GL_TEXTURE_COORD_ARRAY_BUFFER_BINDING
+    };
+    static const GLenum s_aeSize[4] =
+    {
+        GL_VERTEX_ARRAY_SIZE, 0, GL_COLOR_ARRAY_SIZE,
+        GL_TEXTURE_COORD_ARRAY_SIZE
+    };
+    for (i = 0; i < 4; i++)
+    {
+        int iArray = GetArrayIndex(s_aeArray[i],m_iClientActiveUnit);
+        if (iArray < 0)
+        {
+            continue;
+        }
+
+        const ArrayState& rkArray = m_akArray[iArray];
+        if (rkArray.Enabled != UNKNOWN)
+        {
+            int iEnabled = (glIsEnabled(s_aeArray[i]) ? 1 : 0);
+            bValid = bValid && iEnabled == rkArray.Enabled;
+        }
+        if (rkArray.KnownPointer)
+        {
+            GLvoid* pvPointer = 0;
+            glGetPointerv(s_aePointer[i],&pvPointer);
+            bValid = bValid && pvPointer == rkArray.Pointer;
+            bValid = bValid && QueryInteger(s_aeBinding[i],
+                (GLint)rkArray.Buffer);
+            if (s_aeSize[i])
+            {
+                bValid = bValid && QueryInteger(s_aeSize[i],rkArray.Size);
+            }
+        }
+    }
+    if (m_uiArrayBuffer != UNKNOWN_NAME)
+    {
+        bValid = bValid && QueryInteger(GL_ARRAY_BUFFER_BINDING,
+            (GLint)m_uiArrayBuffer);
+    }
+    if (m_uiElementBuffer != UNKNOWN_NAME)
+    {
+        bValid = bValid && QueryInteger(GL_ELEMENT_ARRAY_BUFFER_BINDING,
+            (GLint)m_uiElementBuffer);
+    }
+
+    // per-fragment operations
+    if (m_eAlphaFunc != UNKNOWN_ENUM)
+    {
+        bValid = bValid && QueryInteger(GL_ALPHA_TEST_FUNC,
+            (GLint)m_eAlphaFunc);
+        bValid = bValid && QueryReals(GL_ALPHA_TEST_REF,1,&m_fAlphaRef);
+    }
+    if (m_eBlendSrc != UNKNOWN_ENUM)
+    {
+        bValid = bValid && QueryInteger(GL_BLEND_SRC,(GLint)m_eBlendSrc);
+        bValid = bValid && QueryInteger(GL_BLEND_DST,(GLint)m_eBlendDst);
+    }
+    if (m_eDepthFunc != UNKNOWN_ENUM)
+    {
+        bValid = bValid && QueryInteger(GL_DEPTH_FUNC,(GLint)m_eDepthFunc);
+    }
+    if (m_iDepthMask != UNKNOWN)
+    {
+        GLboolean bMask = GL_FALSE;
+        glGetBooleanv(GL_DEPTH_WRITEMASK,&bMask);
+        bValid = bValid && (bMask ? 1 : 0) == m_iDepthMask;
+    }
+    if (m_eStencilFunc != UNKNOWN_ENUM)
+    {
+        bValid = bValid && QueryInteger(GL_STENCIL_FUNC,
+            (GLint)m_eStencilFunc);
+        bValid = bValid && QueryInteger(GL_STENCIL_REF,m_iStencilRef);
+        bValid = bValid && QueryInteger(GL_STENCIL_VALUE_MASK,
+            (GLint)m_uiStencilValueMask);
+    }
+    if (m_eStencilFail != UNKNOWN_ENUM)
+    {
+        bValid = bValid && QueryInteger(GL_STENCIL_FAIL,
+            (GLint)m_eStencilFail);
+        bValid = bValid && QueryInteger(GL_STENCIL_PASS_DEPTH_FAIL,
+            (GLint)m_eStencilZFail);
+        bValid = bValid && QueryInteger(GL_STENCIL_PASS_DEPTH_PASS,
+            (GLint)m_eStencilZPass);
+    }
+    if (m_bKnownStencilMask)
+    {
+        bValid = bValid && QueryInteger(GL_STENCIL_WRITEMASK,
+            (GLint)m_uiStencilWriteMask);
+    }
+
+    // rasterization
+    if (m_eCullFace != UNKNOWN_ENUM)
+    {
+        bValid = bValid && QueryInteger(GL_CULL_FACE_MODE,
+            (GLint)m_eCullFace);
+    }
+    if (m_eFrontFace != UNKNOWN_ENUM)
+    {
+        bValid = bValid && QueryInteger(GL_FRONT_FACE,(GLint)m_eFrontFace);
+    }
+    if (m_eShadeModel != UNKNOWN_ENUM)
+    {
+        bValid = bValid && QueryInteger(GL_SHADE_MODEL,
+            (GLint)m_eShadeModel);
+    }
+    if (m_bKnownPolygonOffset)
+    {
+        bValid = bValid && QueryReals(GL_POLYGON_OFFSET_FACTOR,1,
+            &m_fOffsetFactor);
+        bValid = bValid && QueryReals(GL_POLYGON_OFFSET_UNITS,1,
+            &m_fOffsetUnits);
+    }
+
+    // material
+    static const GLenum s_aeMaterial[4] =
+    {
+        GL_EMISSION, GL_AMBIENT, GL_DIFFUSE, GL_SPECULAR
+    };
+    GLreal afValue[4];
+    for (i = 0; i < 4; i++)
+    {
+        if (m_abKnownMaterial[i])
+        {
+            glGetMaterialrv(GL_FRONT,s_aeMaterial[i],afValue);
+            bValid = bValid && SameReals(4,afValue,m_aafMaterial[i]);
+        }
+    }
+    if (m_bKnownShininess)
+    {
+        glGetMaterialrv(GL_FRONT,GL_SHININESS,afValue);
+        bValid = bValid && afValue[0] == m_fShininess;
+    }
+
+    // fog
+    static const GLenum s_aeFog[3] =
+    {
+        GL_FOG_START, GL_FOG_END, GL_FOG_DENSITY
+    };
+    for (i = 0; i < 3; i++)
+    {
+        if (m_abKnownFog[i])
+        {
+            bValid = bValid && QueryReals(s_aeFog[i],1,&m_afFog[i]);
+        }
+    }
+    if (m_eFogMode != UNKNOWN_ENUM)
+    {
+        bValid = bValid && QueryInteger(GL_FOG_MODE,(GLint)m_eFogMode);
+    }
+    if (m_bKnownFogColor)
+    {
+        bValid = bValid && QueryReals(GL_FOG_COLOR,4,m_afFogColor);
+    }
+
+    return bValid;
+}
+//----------------------------------------------------------------------------
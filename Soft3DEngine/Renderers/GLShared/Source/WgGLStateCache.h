@@ -0,0 +1,285 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgGLStateCache.h                   //
+//                                                       //
+//  - Interface for GL State Cache class                 //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_GLSTATECACHE_H__
+#define __WG_GLSTATECACHE_H__
+
+// The cache is compiled into every OpenGL ES renderer.  It uses the export
+// macro of the renderer library that includes it.
+#ifndef WG3D_RENDERER_ITEM
+#ifdef WG3D_RENDERER_DLL_EXPORT
+#define WG3D_RENDERER_ITEM __declspec(dllexport)
+#else
+#ifdef WG3D_RENDERER_DLL_IMPORT
+#define WG3D_RENDERER_ITEM __declspec(dllimport)
+#else
+#define WG3D_RENDERER_ITEM
+#endif
+#endif
+#endif
+
+#include "WgSystem.h"
+#include "gles/gl.h"
+
+// OpenGL ES entry points for the numeric backend of fixed (see WG_REAL in
+// WgFixed.h).  The r suffix selects the x or the f variant, GLreal is the
+// matching scalar type and GL_REAL the array type of vertex data.
+#if WG_REAL == WG_REAL_FLOAT
+typedef GLfloat GLreal;
+#define GL_REAL             GL_FLOAT
+#define glAlphaFuncr        glAlphaFunc
+#define glClearColorr       glClearColor
+#define glClearDepthr       glClearDepthf
+#define glColor4r           glColor4f
+#define glDepthRanger       glDepthRangef
+#define glFogr              glFogf
+#define glFogrv             glFogfv
+#define glFrustumr          glFrustumf
+#define glGetMaterialrv     glGetMaterialfv
+#define glGetRealv          glGetFloatv
+#define glGetTexEnvrv       glGetTexEnvfv
+#define glLightr            glLightf
+#define glLightrv           glLightfv
+#define glLightModelrv      glLightModelfv
+#define glLineWidthr        glLineWidth
+#define glMaterialr         glMaterialf
+#define glMaterialrv        glMaterialfv
+#define glMultMatrixr       glMultMatrixf
+#define glPointSizer        glPointSize
+#define glPolygonOffsetr    glPolygonOffset
+#define glTexEnvrv          glTexEnvfv
+#define glTranslater        glTranslatef
+#else
+typedef GLfixed GLreal;
+#define GL_REAL             GL_FIXED
+#define glAlphaFuncr        glAlphaFuncx
+#define glClearColorr       glClearColorx
+#define glClearDepthr       glClearDepthx
+#define glColor4r           glColor4x
+#define glDepthRanger       glDepthRangex
+#define glFogr              glFogx
+#define glFogrv             glFogxv
+#define glFrustumr          glFrustumx
+#define glGetMaterialrv     glGetMaterialxv
+#define glGetRealv          glGetFixedv
+#define glGetTexEnvrv       glGetTexEnvxv
+#define glLightr            glLightx
+#define glLightrv           glLightxv
+#define glLightModelrv      glLightModelxv
+#define glLineWidthr        glLineWidthx
+#define glMaterialr         glMaterialx
+#define glMaterialrv        glMaterialxv
+#define glMultMatrixr       glMultMatrixx
+#define glPointSizer        glPointSizex
+#define glPolygonOffsetr    glPolygonOffsetx
+#define glTexEnvrv          glTexEnvxv
+#define glTranslater        glTranslatex
+#endif
+
+namespace WGSoft3D
+{
+
+// A shadow of the OpenGL ES state that the renderers change per draw.  Every
+// request is compared with the shadow and only reaches the driver when it
+// changes something.  A state is unknown until it is set through the cache,
+// so the first request always reaches the driver.  Code that changes the
+// state without the cache must call Invalidate afterwards.
+//
+// The texture states (GL_TEXTURE_2D, the bound texture and the texture
+// environment) belong to the active texture unit, the texture coordinate
+// array belongs to the client active texture unit.  Units beyond
+// MAX_TEXTURE_UNITS are not cached.  Capabilities, hints and parameters
+// that are not cached are passed through.
+//
+// Define WG3D_VERIFY_GL_STATE to have the renderers compare the shadow with
+// the state of OpenGL (glGet*) before every draw.
+
+class WG3D_RENDERER_ITEM GLStateCache
+{
+public:
+    GLStateCache ();
+
+    // Forget the whole state, for example after a context was made current
+    // or after a third party changed the state.
+    void Invalidate ();
+
+    // glEnable and glDisable
+    void Enable (GLenum eCap);
+    void Disable (GLenum eCap);
+
+    // texture units
+    void ActiveTexture (int iUnit);
+    void ClientActiveTexture (int iUnit);
+    void BindTexture (GLuint uiID);
+    void DeleteTexture (GLuint uiID);
+    void TexEnvMode (GLenum eMode);
+    void TexEnvColor (const GLreal* afColor);
+    void Hint (GLenum eTarget, GLenum eMode);
+
+    // Client arrays.  The arrays are of type GL_REAL and tightly packed.  A
+    // pointer is an offset when a buffer is bound to GL_ARRAY_BUFFER.
+    void EnableClientState (GLenum eArray);
+    void DisableClientState (GLenum eArray);
+    void BindBuffer (GLenum eTarget, GLuint uiID);
+    void DeleteBuffer (GLuint uiID);
+    void VertexPointer (GLint iSize, const GLvoid* pvPointer);
+    void NormalPointer (const GLvoid* pvPointer);
+    void ColorPointer (GLint iSize, const GLvoid* pvPointer);
+    void TexCoordPointer (GLint iSize, const GLvoid* pvPointer);
+
+    // per-fragment operations
+    void AlphaFunc (GLenum eFunc, GLreal fRef);
+    void BlendFunc (GLenum eSrc, GLenum eDst);
+    void DepthFunc (GLenum eFunc);
+    void DepthMask (GLboolean bFlag);
+    void StencilFunc (GLenum eFunc, GLint iRef, GLuint uiMask);
+    void StencilOp (GLenum eFail, GLenum eZFail, GLenum eZPass);
+    void StencilMask (GLuint uiMask);
+
+    // rasterization
+    void CullFace (GLenum eMode);
+    void FrontFace (GLenum eMode);
+    void ShadeModel (GLenum eMode);
+    void PolygonOffset (GLreal fFactor, GLreal fUnits);
+
+    // Material of the front faces.  Materialv takes the colors (GL_EMISSION,
+    // GL_AMBIENT, GL_DIFFUSE, GL_SPECULAR), Material takes GL_SHININESS.
+    void Materialv (GLenum ePName, const GLreal* afParam);
+    void Material (GLenum ePName, GLreal fParam);
+
+    // Fog.  Fog takes GL_FOG_START, GL_FOG_END and GL_FOG_DENSITY.
+    void Fog (GLenum ePName, GLreal fParam);
+    void FogMode (GLenum eMode);
+    void FogColor (const GLreal* afColor);
+
+    // The number of requests that reached OpenGL and the number of requests
+    // that were filtered out since the last ResetCounters.
+    int GetIssuedQuantity () const;
+    int GetFilteredQuantity () const;
+    void ResetCounters ();
+
+    // Compare the known part of the shadow with the state of OpenGL.  The
+    // return value is false if any state differs.
+    bool Verify () const;
+
+    enum { MAX_TEXTURE_UNITS = 8 };
+
+private:
+    // the capabilities that are cached, GL_TEXTURE_2D is kept per unit
+    enum
+    {
+        CAP_ALPHA_TEST,
+        CAP_BLEND,
+        CAP_CULL_FACE,
+        CAP_DEPTH_TEST,
+        CAP_DITHER,
+        CAP_FOG,
+        CAP_LIGHTING,
+        CAP_LIGHT0,
+        CAP_NORMALIZE = CAP_LIGHT0 + 8,
+        CAP_POLYGON_OFFSET_FILL,
+        CAP_RESCALE_NORMAL,
+        CAP_SCISSOR_TEST,
+        CAP_STENCIL_TEST,
+        CAP_QUANTITY
+    };
+
+    // the client arrays, the texture coordinates are kept per unit
+    enum
+    {
+        ARRAY_VERTEX,
+        ARRAY_NORMAL,
+        ARRAY_COLOR,
+        ARRAY_TEXCOORD,
+        ARRAY_QUANTITY = ARRAY_TEXCOORD + MAX_TEXTURE_UNITS
+    };
+
+    // shadow values of unknown states
+    enum
+    {
+        UNKNOWN = -1
+    };
+    static const GLenum UNKNOWN_ENUM;
+    static const GLuint UNKNOWN_NAME;
+
+    class ArrayState
+    {
+    public:
+        int Enabled;           // 0, 1 or UNKNOWN
+        bool KnownPointer;     // Buffer, Size and Pointer are valid
+        GLuint Buffer;         // GL_ARRAY_BUFFER when the pointer was set
+        GLint Size;
+        const GLvoid* Pointer;
+    };
+
+    class UnitState
+    {
+    public:
+        int Enabled;           // GL_TEXTURE_2D, 0, 1 or UNKNOWN
+        GLuint Texture;
+        GLenum EnvMode;
+        bool KnownEnvColor;
+        GLreal EnvColor[4];
+    };
+
+    // Count the request and return true if it changes nothing.  The shadow
+    // of an unknown state never equals a request.
+    bool Filter (bool bSame);
+
+    static int GetCapIndex (GLenum eCap);
+    static int GetArrayIndex (GLenum eArray, int iClientUnit);
+    UnitState* GetActiveUnit ();
+    void SetEnabled (GLenum eCap, bool bEnabled);
+    void SetClientState (GLenum eArray, bool bEnabled);
+    bool ChangePointer (int iArray, GLint iSize, const GLvoid* pvPointer);
+
+    int m_aiCap[CAP_QUANTITY];
+    UnitState m_akUnit[MAX_TEXTURE_UNITS];
+    int m_iActiveUnit, m_iClientActiveUnit;
+    GLenum m_ePerspectiveHint, m_eFogHint;
+
+    ArrayState m_akArray[ARRAY_QUANTITY];
+    GLuint m_uiArrayBuffer, m_uiElementBuffer;
+
+    GLenum m_eAlphaFunc;
+    GLreal m_fAlphaRef;
+    GLenum m_eBlendSrc, m_eBlendDst;
+    GLenum m_eDepthFunc;
+    int m_iDepthMask;
+    GLenum m_eStencilFunc;
+    GLint m_iStencilRef;
+    GLuint m_uiStencilValueMask;
+    GLenum m_eStencilFail, m_eStencilZFail, m_eStencilZPass;
+    GLuint m_uiStencilWriteMask;
+    bool m_bKnownStencilMask;
+
+    GLenum m_eCullFace, m_eFrontFace, m_eShadeModel;
+    bool m_bKnownPolygonOffset;
+    GLreal m_fOffsetFactor, m_fOffsetUnits;
+
+    // emission, ambient, diffuse, specular
+    bool m_abKnownMaterial[4];
+    GLreal m_aafMaterial[4][4];
+    bool m_bKnownShininess;
+    GLreal m_fShininess;
+
+    // start, end, density
+    bool m_abKnownFog[3];
+    GLreal m_afFog[3];
+    GLenum m_eFogMode;
+    bool m_bKnownFogColor;
+    GLreal m_afFogColor[4];
+
+    int m_iIssuedQuantity, m_iFilteredQuantity;
+};
+
+#include "WgGLStateCache.inl"
+
+}
+
+#endif
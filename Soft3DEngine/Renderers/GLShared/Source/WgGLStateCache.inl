@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgGLStateCache.inl                 //
+//                                                       //
+//  - Inlines for GL State Cache class                   //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+inline int GLStateCache::GetIssuedQuantity () const
+{
+    return m_iIssuedQuantity;
+}
+//----------------------------------------------------------------------------
+inline int GLStateCache::GetFilteredQuantity () const
+{
+    return m_iFilteredQuantity;
+}
+//----------------------------------------------------------------------------
+inline void GLStateCache::ResetCounters ()
+{
+    m_iIssuedQuantity = 0;
+    m_iFilteredQuantity = 0;
+}
+//----------------------------------------------------------------------------
+inline void GLStateCache::Enable (GLenum eCap)
+{
+    SetEnabled(eCap,true);
+}
+//----------------------------------------------------------------------------
+inline void GLStateCache::Disable (GLenum eCap)
+{
+    SetEnabled(eCap,false);
+}
+//----------------------------------------------------------------------------
+inline void GLStateCache::EnableClientState (GLenum eArray)
+{
+    SetClientState(eArray,true);
+}
+//----------------------------------------------------------------------------
+inline void GLStateCache::DisableClientState (GLenum eArray)
+{
+    SetClientState(eArray,false);
+}
+//----------------------------------------------------------------------------
+inline bool GLStateCache::Filter (bool bSame)
+{
+    if (bSame)
+    {
+        m_iFilteredQuantity++;
+        return true;
+    }
+    m_iIssuedQuantity++;
+    return false;
+}
+//----------------------------------------------------------------------------
+inline GLStateCache::UnitState* GLStateCache::GetActiveUnit ()
+{
+    if (0 <= m_iActiveUnit && m_iActiveUnit < MAX_TEXTURE_UNITS)
+    {
+        return &m_akUnit[m_iActiveUnit];
+    }
+    return 0;
+}
+//----------------------------------------------------------------------------
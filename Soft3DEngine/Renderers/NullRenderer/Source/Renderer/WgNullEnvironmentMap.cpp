@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgNullEnvironmentMap.cpp           //
+//                                                       //
+//  - Implementation for Null Environment Map            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgNullRendererPCH.h"
+#include "WgNullRenderer.h"
+#include "WgNode.h"
+#include "WgEnvironmentMapEffect.h"
+#include "WgProfiler.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+void NullRenderer::DrawEnvironmentMap ()
+{
+    WG3D_PROFILE("NullRenderer::DrawEnvironmentMap");
+
+    m_kStatistics.Effects++;
+
+    // Access the special effect.  Detach it from the node to allow the
+    // effectless node drawing.
+    assert(DynamicCast<EnvironmentMapEffect>(m_pkGlobalEffect));
+    EnvironmentMapEffectPtr spkEMEffect =
+        (EnvironmentMapEffect*)m_pkGlobalEffect;
+    m_pkNode->SetEffect(0);
+
+    // Draw the Node tree.  Any Geometry objects with textures will have the
+    // environment map as an additional one, drawn after the others
+    // according to the apply mode stored by the environment map.
+    m_pkNode->Draw(*this);
+
+    // reattach the effect
+    m_pkNode->SetEffect(spkEMEffect);
+}
+//----------------------------------------------------------------------------
+
@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgNullPlanarShadow.cpp             //
+//                                                       //
+//  - Implementation for Null Planar Shadow              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgNullRendererPCH.h"
+#include "WgNullRenderer.h"
+#include "WgMatrix4.h"
+#include "WgNode.h"
+#include "WgPlanarShadowEffect.h"
+#include "WgProfiler.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+void NullRenderer::DrawPlanarShadow ()
+{
+    WG3D_PROFILE("NullRenderer::DrawPlanarShadow");
+
+    m_kStatistics.Effects++;
+
+    // Access the special effect.  Detach it from the node to allow the
+    // effectless node drawing.
+    assert(DynamicCast<PlanarShadowEffect>(m_pkNode->GetEffect()));
+    PlanarShadowEffectPtr spkPSEffect =
+        (PlanarShadowEffect*)m_pkNode->GetEffect();
+    m_pkNode->SetEffect(0);
+
+    // draw the caster
+    m_pkNode->Draw(*this);
+
+    // number of planes limited by stencil buffer size
+    int iQuantity = spkPSEffect->GetQuantity();
+    if (iQuantity >= m_iMaxStencilIndices-1)
+    {
+        iQuantity = m_iMaxStencilIndices-1;
+    }
+
+    for (int i = 0; i < iQuantity; i++)
+    {
+        TriMeshPtr spkPlane = spkPSEffect->GetPlane(i);
+        LightPtr spkProjector = spkPSEffect->GetProjector(i);
+
+        // draw the plane, the OpenGL ES renderers mark it in the stencil
+        // buffer
+        m_bAllowZBufferState = false;
+        m_bAllowStencilState = false;
+        Renderer::Draw(spkPlane);
+        m_bAllowZBufferState = true;
+        m_bAllowStencilState = true;
+
+        // compute the equation for the shadow plane in world coordinates
+        Triangle3x kTri;
+        spkPlane->GetWorldTriangle(0,kTri);
+        Plane3x kPlane(kTri.V[0],kTri.V[1],kTri.V[2]);
+
+        // Conservative test to see if a shadow should be cast.
+        if (m_pkNode->WorldBound->WhichSide(kPlane) < 0)
+        {
+            // shadow caster is on far side of plane
+            continue;
+        }
+
+        // Compute the projection matrix for the light source.
+        Matrix4x kProjectionTranspose;
+        if (spkProjector->Type == Light::LT_DIRECTIONAL)
+        {
+            fixed fNdD =
+                kPlane.Normal.Dot(spkProjector->GetWorldDVector());
+            if (fNdD >= FIXED_ZERO)
+            {
+                // Projection must be onto the "positive side" of the plane.
+                continue;
+            }
+
+            kProjectionTranspose.MakeObliqueProjection(kPlane.Normal,
+                kTri.V[0],spkProjector->GetWorldDVector());
+        }
+        else if (spkProjector->Type == Light::LT_POINT
+        ||  spkProjector->Type == Light::LT_SPOT)
+        {
+            fixed fNdE =
+                kPlane.Normal.Dot(spkProjector->GetWorldLocation());
+            if (fNdE <= FIXED_ZERO)
+            {
+                // Projection must be onto the "positive side" of the plane.
+                continue;
+            }
+
+            kProjectionTranspose.MakePerspectiveProjection(kPlane.Normal,
+                kTri.V[0],spkProjector->GetWorldLocation());
+        }
+        else
+        {
+            assert(false);
+            kProjectionTranspose = Matrix4x::IDENTITY;
+        }
+        m_kStatistics.Transforms++;
+        m_uiChecksum += Read((const fixed*)kProjectionTranspose,
+            16*sizeof(fixed));
+
+        // Draw the caster again, but using only vertices and triangles
+        // indices.  Disable culling to allow out-of-view objects to cast
+        // shadows.
+        m_bAllowGlobalState = false;
+        m_bAllowLighting = false;
+        m_bAllowNormals = false;
+        m_bAllowColors = false;
+        m_bAllowTextures = false;
+
+        m_pkNode->Draw(*this,true);
+
+        m_bAllowGlobalState = true;
+        m_bAllowLighting = true;
+        m_bAllowNormals = true;
+        m_bAllowColors = true;
+        m_bAllowTextures = true;
+    }
+
+    // reattach the effect
+    m_pkNode->SetEffect(spkPSEffect);
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgNullProjectedTexture.cpp         //
+//                                                       //
+//  - Implementation for Null Projected Texture          //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgNullRendererPCH.h"
+#include "WgNullRenderer.h"
+#include "WgNode.h"
+#include "WgProjectedTextureEffect.h"
+#include "WgProfiler.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+void NullRenderer::DrawProjectedTexture ()
+{
+    WG3D_PROFILE("NullRenderer::DrawProjectedTexture");
+
+    m_kStatistics.Effects++;
+
+    // Access the special effect.  Detach it from the node to allow the
+    // effectless node drawing.
+    assert(DynamicCast<ProjectedTextureEffect>(m_pkGlobalEffect));
+    ProjectedTextureEffectPtr spkPTEffect =
+        (ProjectedTextureEffect*)m_pkGlobalEffect;
+    m_pkNode->SetEffect(0);
+
+    // Draw the Node tree.  Any Geometry objects with textures will have the
+    // projected texture as an additional one, drawn after the others
+    // according to the apply mode stored by the projected texture.
+    m_pkNode->Draw(*this);
+
+    // reattach the effect
+    m_pkNode->SetEffect(spkPTEffect);
+}
+//----------------------------------------------------------------------------
+
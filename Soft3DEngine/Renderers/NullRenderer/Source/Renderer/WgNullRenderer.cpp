@@ -0,0 +1,731 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgNullRenderer.cpp                 //
+//                                                       //
+//  - Implementation for NullRenderer class              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgNullRendererPCH.h"
+#include "WgNullRenderer.h"
+#include "WgCamera.h"
+#include "WgCachedColorRGBAArray.h"
+#include "WgCachedColorRGBArray.h"
+#include "WgCachedShortArray.h"
+#include "WgCachedVector2Array.h"
+#include "WgCachedVector3Array.h"
+#include "WgProfiler.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+NullRenderer::Statistics::Statistics ()
+{
+    Reset();
+}
+//----------------------------------------------------------------------------
+void NullRenderer::Statistics::Reset ()
+{
+    Draws = 0;
+    Triangles = 0;
+    Lines = 0;
+    Points = 0;
+    Vertices = 0;
+    Indices = 0;
+    for (int i = 0; i < GlobalState::MAX_STATE; i++)
+    {
+        StateSets[i] = 0;
+    }
+    TextureBinds = 0;
+    TextureChanges = 0;
+    TextureUploads = 0;
+    BufferBinds = 0;
+    BufferUploads = 0;
+    BytesUploaded = 0;
+    BytesStreamed = 0;
+    LightsEnabled = 0;
+    Transforms = 0;
+    Effects = 0;
+    Clears = 0;
+}
+//----------------------------------------------------------------------------
+NullRenderer::NullRenderer (const BufferParams& rkBufferParams, int iWidth,
+    int iHeight)
+    :
+    Renderer(rkBufferParams,iWidth,iHeight),
+    m_kTexture(16,16),
+    m_kArray(64,64)
+{
+    ms_eType = RT_OPENGL;
+
+    m_iFrameQuantity = 0;
+    m_uiChecksum = 0;
+    m_uiNextID = 1;
+    m_iActiveUnit = 0;
+    for (int i = 0; i < MAX_TEXTURES; i++)
+    {
+        m_auiBoundTexture[i] = 0;
+    }
+
+    m_iMaxTextures = MAX_TEXTURES;
+    m_iMaxLights = MAX_LIGHTS;
+    m_iMaxStencilIndices =
+        (m_kBufferParams.Stencil == BufferParams::BP_STENCIL_8 ? 256 : 0);
+
+    // initialize global render state to default settings
+    GlobalState::SetGlobalStates();
+    SetGlobalState(GlobalState::Default);
+
+    // the defaults are not part of a frame
+    m_kStatistics.Reset();
+}
+//----------------------------------------------------------------------------
+NullRenderer::~NullRenderer ()
+{
+    int i;
+    for (i = 0; i < m_kTexture.GetQuantity(); i++)
+    {
+        m_kTexture[i]->BIArray.Unbind(this);
+    }
+    for (i = 0; i < m_kArray.GetQuantity(); i++)
+    {
+        m_kArray[i]->Unbind(this);
+    }
+}
+//----------------------------------------------------------------------------
+void NullRenderer::Activate ()
+{
+    OnViewPortChange();
+    OnFrustumChange();
+    if (m_pkCamera)
+    {
+        OnFrameChange();
+    }
+}
+//----------------------------------------------------------------------------
+unsigned int NullRenderer::Read (const void* pvData, int iBytes)
+{
+    if (!pvData)
+    {
+        return 0;
+    }
+
+    const unsigned char* aucData = (const unsigned char*)pvData;
+    unsigned int uiSum = 0;
+    int iWords = iBytes/(int)sizeof(unsigned int);
+    int i;
+    for (i = 0; i < iWords; i++)
+    {
+        unsigned int uiWord;
+        memcpy(&uiWord,aucData,sizeof(unsigned int));
+        uiSum += uiWord;
+        aucData += sizeof(unsigned int);
+    }
+    for (i = iWords*(int)sizeof(unsigned int); i < iBytes; i++)
+    {
+        uiSum += *aucData++;
+    }
+    return uiSum;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::ClearBackBuffer ()
+{
+    m_kStatistics.Clears++;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::ClearZBuffer ()
+{
+    m_kStatistics.Clears++;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::ClearStencilBuffer ()
+{
+    m_kStatistics.Clears++;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::ClearBuffers ()
+{
+    m_kStatistics.Clears++;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::ClearBackBuffer (int, int, int, int)
+{
+    m_kStatistics.Clears++;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::ClearZBuffer (int, int, int, int)
+{
+    m_kStatistics.Clears++;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::ClearStencilBuffer (int, int, int, int)
+{
+    m_kStatistics.Clears++;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::ClearBuffers (int, int, int, int)
+{
+    m_kStatistics.Clears++;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::DisplayBackBuffer ()
+{
+    m_kFrameStatistics = m_kStatistics;
+    m_kStatistics.Reset();
+    m_iFrameQuantity++;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::OnFrustumChange ()
+{
+    if (m_pkCamera)
+    {
+        m_uiChecksum += Read(m_pkCamera->GetFrustum(),
+            Camera::VF_QUANTITY*sizeof(fixed));
+    }
+}
+//----------------------------------------------------------------------------
+void NullRenderer::OnViewPortChange ()
+{
+    if (m_pkCamera)
+    {
+        fixed afPort[4];
+        m_pkCamera->GetViewPort(afPort[0],afPort[1],afPort[2],afPort[3]);
+        m_uiChecksum += Read(afPort,4*sizeof(fixed));
+    }
+}
+//----------------------------------------------------------------------------
+void NullRenderer::OnFrameChange ()
+{
+    Vector3x akFrame[3];
+    akFrame[0] = m_pkCamera->GetWorldLocation();
+    akFrame[1] = m_pkCamera->GetWorldUVector();
+    akFrame[2] = m_pkCamera->GetWorldDVector();
+    m_uiChecksum += Read(akFrame,3*sizeof(Vector3x));
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetAlphaState (AlphaState* pkState)
+{
+    m_kStatistics.StateSets[GlobalState::ALPHA]++;
+    m_uiChecksum += pkState->BlendEnabled + pkState->SrcBlend +
+        pkState->DstBlend + pkState->TestEnabled + pkState->Test;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetCullState (CullState* pkState)
+{
+    m_kStatistics.StateSets[GlobalState::CULL]++;
+    m_uiChecksum += pkState->Enabled + pkState->FrontFace +
+        pkState->CullFace + m_bReverseCullFace;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetDitherState (DitherState* pkState)
+{
+    m_kStatistics.StateSets[GlobalState::DITHER]++;
+    m_uiChecksum += pkState->Enabled;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetFogState (FogState* pkState)
+{
+    m_kStatistics.StateSets[GlobalState::FOG]++;
+    m_uiChecksum += pkState->Enabled + pkState->DensityFunction +
+        pkState->ApplyFunction;
+    if (pkState->Enabled)
+    {
+        m_uiChecksum += Read((const fixed*)pkState->Color,4*sizeof(fixed));
+    }
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetMaterialState (MaterialState* pkState)
+{
+    m_kStatistics.StateSets[GlobalState::MATERIAL]++;
+    m_uiChecksum += Read((const fixed*)pkState->Emissive,4*sizeof(fixed));
+    m_uiChecksum += Read((const fixed*)pkState->Ambient,4*sizeof(fixed));
+    m_uiChecksum += Read((const fixed*)pkState->Diffuse,4*sizeof(fixed));
+    m_uiChecksum += Read((const fixed*)pkState->Specular,4*sizeof(fixed));
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetPolygonOffsetState (PolygonOffsetState* pkState)
+{
+    m_kStatistics.StateSets[GlobalState::POLYGONOFFSET]++;
+    m_uiChecksum += pkState->FillEnabled;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetShadeState (ShadeState* pkState)
+{
+    m_kStatistics.StateSets[GlobalState::SHADE]++;
+    m_uiChecksum += pkState->Shade;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetZBufferState (ZBufferState* pkState)
+{
+    m_kStatistics.StateSets[GlobalState::ZBUFFER]++;
+    m_uiChecksum += pkState->Enabled + pkState->Writable +
+        pkState->Compare;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetStencilState (StencilState* pkState)
+{
+    m_kStatistics.StateSets[GlobalState::STENCIL]++;
+    m_uiChecksum += pkState->Enabled + pkState->Compare +
+        pkState->Reference + pkState->OnZPass;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::EnableLighting (int eEnable)
+{
+    int iQuantity = m_pkGeometry->Lights.GetQuantity();
+    if (iQuantity >= m_iMaxLights)
+    {
+        iQuantity = m_iMaxLights;
+    }
+
+    for (int i = 0; i < iQuantity; i++)
+    {
+        const Light* pkLight = m_pkGeometry->Lights[i];
+        if (pkLight->On)
+        {
+            EnableLight(eEnable,i,pkLight);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void NullRenderer::DisableLighting ()
+{
+    int iQuantity = m_pkGeometry->Lights.GetQuantity();
+    if (iQuantity >= m_iMaxLights)
+    {
+        iQuantity = m_iMaxLights;
+    }
+
+    for (int i = 0; i < iQuantity; i++)
+    {
+        const Light* pkLight = m_pkGeometry->Lights[i];
+        if (pkLight->On)
+        {
+            DisableLight(i,pkLight);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void NullRenderer::EnableLight (int eEnable, int, const Light* pkLight)
+{
+    m_kStatistics.LightsEnabled++;
+
+    // the colors and the frame the OpenGL ES renderers pass to glLight
+    ColorRGBA akColor[3];
+    if (eEnable & EL_AMBIENT)
+    {
+        akColor[0] = pkLight->Intensity*pkLight->Ambient;
+    }
+    if ((eEnable & EL_DIFFUSE) && pkLight->Type != Light::LT_AMBIENT)
+    {
+        akColor[1] = pkLight->Intensity*pkLight->Diffuse;
+    }
+    if ((eEnable & EL_SPECULAR) && pkLight->Type != Light::LT_AMBIENT)
+    {
+        akColor[2] = pkLight->Intensity*pkLight->Specular;
+    }
+    m_uiChecksum += Read(akColor,3*sizeof(ColorRGBA));
+
+    Vector3x akFrame[2];
+    akFrame[0] = pkLight->GetWorldLocation();
+    akFrame[1] = pkLight->GetWorldDVector();
+    m_uiChecksum += Read(akFrame,2*sizeof(Vector3x));
+}
+//----------------------------------------------------------------------------
+void NullRenderer::DisableLight (int, const Light*)
+{
+}
+//----------------------------------------------------------------------------
+void NullRenderer::EnableTexture (int iUnit, int i, Effect* pkEffect)
+{
+    SetActiveTextureUnit(iUnit);
+    if (i < pkEffect->UVs.GetQuantity())
+    {
+        Vector2xArray* pkUVs = pkEffect->UVs[i];
+        if (pkUVs)
+        {
+            EnableUVs(i,pkEffect);
+        }
+    }
+
+    Texture* pkTexture = pkEffect->Textures[i];
+    m_kStatistics.TextureBinds++;
+
+    unsigned int uiID;
+    pkTexture->BIArray.GetID(this,sizeof(unsigned int),&uiID);
+    if (uiID == 0)
+    {
+        // texture seen first time, generate name and read the image
+        uiID = m_uiNextID++;
+        pkTexture->BIArray.Bind(this,sizeof(unsigned int),&uiID);
+        m_kTexture.Append(pkTexture);
+        m_kStatistics.TextureUploads++;
+
+        // Not all textures have image data, see OmapGLRenderer.
+        Image* pkImage = pkTexture->GetImage();
+        if (pkImage)
+        {
+            int iBytes = pkImage->GetQuantity()*pkImage->GetBytesPerPixel();
+            m_uiChecksum += Read(pkImage->GetData(),iBytes);
+            m_kStatistics.BytesUploaded += iBytes;
+        }
+    }
+
+    if (0 <= iUnit && iUnit < MAX_TEXTURES)
+    {
+        if (m_auiBoundTexture[iUnit] != uiID)
+        {
+            m_auiBoundTexture[iUnit] = uiID;
+            m_kStatistics.TextureChanges++;
+        }
+    }
+
+    m_uiChecksum += pkTexture->Apply + pkTexture->Correction +
+        Read((const fixed*)pkTexture->BlendColor,4*sizeof(fixed));
+}
+//----------------------------------------------------------------------------
+void NullRenderer::DisableTexture (int, int i, Effect* pkEffect)
+{
+    if (i < pkEffect->UVs.GetQuantity())
+    {
+        Vector2xArray* pkUVs = pkEffect->UVs[i];
+        if (pkUVs)
+        {
+            DisableUVs(pkUVs);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetActiveTextureUnit (int iUnit)
+{
+    m_iActiveUnit = iUnit;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::ReleaseTexture (Texture* pkTexture)
+{
+    assert(pkTexture);
+    unsigned int uiID;
+    pkTexture->BIArray.GetID(this,sizeof(unsigned int),&uiID);
+    if (uiID > 0)
+    {
+        int i;
+        for (i = 0; i < MAX_TEXTURES; i++)
+        {
+            if (m_auiBoundTexture[i] == uiID)
+            {
+                m_auiBoundTexture[i] = 0;
+            }
+        }
+        pkTexture->BIArray.Unbind(this);
+        for (i = 0; i < m_kTexture.GetQuantity(); i++)
+        {
+            if (m_kTexture[i] == pkTexture)
+            {
+                m_kTexture.Remove(i);
+                break;
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetWorldTransformation ()
+{
+    m_kStatistics.Transforms++;
+    m_uiChecksum += Read(m_pkGeometry->GetWorldHomogeneous(),
+        16*sizeof(fixed));
+}
+//----------------------------------------------------------------------------
+void NullRenderer::RestoreWorldTransformation ()
+{
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetScreenTransformation ()
+{
+    m_kStatistics.Transforms++;
+}
+//----------------------------------------------------------------------------
+void NullRenderer::RestoreScreenTransformation ()
+{
+}
+//----------------------------------------------------------------------------
+void NullRenderer::UseArray (BindInfoArray* pkBIArray, const void* pvData,
+    int iBytes)
+{
+    if (pkBIArray)
+    {
+        m_kStatistics.BufferBinds++;
+
+        unsigned int uiID;
+        pkBIArray->GetID(this,sizeof(unsigned int),&uiID);
+        if (uiID > 0)
+        {
+            // array already cached, just bind it
+            return;
+        }
+
+        // array seen first time, generate name and read the data
+        uiID = m_uiNextID++;
+        pkBIArray->Bind(this,sizeof(unsigned int),&uiID);
+        m_kArray.Append(pkBIArray);
+        m_kStatistics.BufferUploads++;
+        m_kStatistics.BytesUploaded += iBytes;
+    }
+    else
+    {
+        // the driver reads the client arrays at every draw
+        m_kStatistics.BytesStreamed += iBytes;
+    }
+
+    m_uiChecksum += Read(pvData,iBytes);
+}
+//----------------------------------------------------------------------------
+void NullRenderer::ReleaseBinding (BindInfoArray* pkBIArray)
+{
+    pkBIArray->Unbind(this);
+    for (int i = 0; i < m_kArray.GetQuantity(); i++)
+    {
+        if (m_kArray[i] == pkBIArray)
+        {
+            m_kArray.Remove(i);
+            break;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void NullRenderer::EnableVertices ()
+{
+    Vector3xArray* pkVertices = m_pkGeometry->Vertices;
+    assert(pkVertices);
+    BindInfoArray* pkBIArray = 0;
+    if (pkVertices->IsExactly(CachedVector3xArray::TYPE))
+    {
+        pkBIArray = &((CachedVector3xArray*)pkVertices)->BIArray;
+    }
+    UseArray(pkBIArray,pkVertices->GetData(),
+        pkVertices->GetQuantity()*sizeof(Vector3x));
+}
+//----------------------------------------------------------------------------
+void NullRenderer::DisableVertices ()
+{
+}
+//----------------------------------------------------------------------------
+void NullRenderer::EnableNormals ()
+{
+    Vector3xArray* pkNormals = m_pkGeometry->Normals;
+    BindInfoArray* pkBIArray = 0;
+    if (pkNormals->IsExactly(CachedVector3xArray::TYPE))
+    {
+        pkBIArray = &((CachedVector3xArray*)pkNormals)->BIArray;
+    }
+    UseArray(pkBIArray,pkNormals->GetData(),
+        pkNormals->GetQuantity()*sizeof(Vector3x));
+}
+//----------------------------------------------------------------------------
+void NullRenderer::DisableNormals ()
+{
+}
+//----------------------------------------------------------------------------
+void NullRenderer::EnableColorRGBAs ()
+{
+    ColorRGBAArray* pkColors = m_pkLocalEffect->ColorRGBAs;
+    BindInfoArray* pkBIArray = 0;
+    if (pkColors->IsExactly(CachedColorRGBAArray::TYPE))
+    {
+        pkBIArray = &((CachedColorRGBAArray*)pkColors)->BIArray;
+    }
+    UseArray(pkBIArray,pkColors->GetData(),
+        pkColors->GetQuantity()*sizeof(ColorRGBA));
+}
+//----------------------------------------------------------------------------
+void NullRenderer::DisableColorRGBAs ()
+{
+}
+//----------------------------------------------------------------------------
+void NullRenderer::EnableColorRGBs ()
+{
+    ColorRGBArray* pkColors = m_pkLocalEffect->ColorRGBs;
+    BindInfoArray* pkBIArray = 0;
+    if (pkColors->IsExactly(CachedColorRGBArray::TYPE))
+    {
+        pkBIArray = &((CachedColorRGBArray*)pkColors)->BIArray;
+    }
+    UseArray(pkBIArray,pkColors->GetData(),
+        pkColors->GetQuantity()*sizeof(ColorRGB));
+}
+//----------------------------------------------------------------------------
+void NullRenderer::DisableColorRGBs ()
+{
+}
+//----------------------------------------------------------------------------
+void NullRenderer::EnableUVs (int i, Effect* pkEffect)
+{
+    Vector2xArray* pkUVs = pkEffect->UVs[i];
+    BindInfoArray* pkBIArray = 0;
+    if (pkUVs->IsExactly(CachedVector2xArray::TYPE))
+    {
+        pkBIArray = &((CachedVector2xArray*)pkUVs)->BIArray;
+    }
+    UseArray(pkBIArray,pkUVs->GetData(),
+        pkUVs->GetQuantity()*sizeof(Vector2x));
+}
+//----------------------------------------------------------------------------
+void NullRenderer::DisableUVs (Vector2xArray*)
+{
+}
+//----------------------------------------------------------------------------
+void NullRenderer::DrawElements ()
+{
+    WG3D_PROFILE("NullRenderer::DrawElements");
+
+    int iVQuantity = m_pkGeometry->Vertices->GetQuantity();
+    ShortArray* pkIndices = m_pkGeometry->Indices;
+    int iIQuantity = iVQuantity;
+    if (pkIndices)
+    {
+        BindInfoArray* pkBIArray = 0;
+        if (pkIndices->IsExactly(CachedShortArray::TYPE))
+        {
+            pkBIArray = &((CachedShortArray*)pkIndices)->BIArray;
+        }
+        if (pkBIArray || pkIndices->GetData())
+        {
+            iIQuantity = pkIndices->GetQuantity();
+            UseArray(pkBIArray,pkIndices->GetData(),
+                iIQuantity*sizeof(short));
+        }
+    }
+
+    m_kStatistics.Draws++;
+    m_kStatistics.Vertices += iVQuantity;
+    m_kStatistics.Indices += iIQuantity;
+
+    // the primitives of glDrawElements (or glDrawArrays without indices)
+    switch (m_pkGeometry->m_GeometryType)
+    {
+    case Geometry::GT_POLYPOINT:
+        m_kStatistics.Points += iIQuantity;
+        break;
+    case Geometry::GT_POLYLINE_SEGMENTS:
+        m_kStatistics.Lines += iIQuantity/2;
+        break;
+    case Geometry::GT_POLYLINE_OPEN:
+        if (iIQuantity > 1)
+        {
+            m_kStatistics.Lines += iIQuantity - 1;
+        }
+        break;
+    case Geometry::GT_POLYLINE_CLOSED:
+        if (iIQuantity > 1)
+        {
+            m_kStatistics.Lines += iIQuantity;
+        }
+        break;
+    case Geometry::GT_TRIMESH:
+        m_kStatistics.Triangles += iIQuantity/3;
+        break;
+    case Geometry::GT_TRISTRIP:
+    case Geometry::GT_TRIFAN:
+        if (iIQuantity > 2)
+        {
+            m_kStatistics.Triangles += iIQuantity - 2;
+        }
+        break;
+    default:  // Geometry::GT_MAX_QUANTITY
+        assert(false);
+        break;
+    }
+}
+//----------------------------------------------------------------------------
+void NullRenderer::ReleaseArray (CachedColorRGBAArray* pkArray)
+{
+    assert(pkArray);
+    ReleaseBinding(&pkArray->BIArray);
+}
+//----------------------------------------------------------------------------
+void NullRenderer::ReleaseArray (CachedColorRGBArray* pkArray)
+{
+    assert(pkArray);
+    ReleaseBinding(&pkArray->BIArray);
+}
+//----------------------------------------------------------------------------
+void NullRenderer::ReleaseArray (CachedShortArray* pkArray)
+{
+    assert(pkArray);
+    ReleaseBinding(&pkArray->BIArray);
+}
+//----------------------------------------------------------------------------
+void NullRenderer::ReleaseArray (CachedVector2xArray* pkArray)
+{
+    assert(pkArray);
+    ReleaseBinding(&pkArray->BIArray);
+}
+//----------------------------------------------------------------------------
+void NullRenderer::ReleaseArray (CachedVector3xArray* pkArray)
+{
+    assert(pkArray);
+    ReleaseBinding(&pkArray->BIArray);
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetConstantTransformM (int iOption, fixed* afData)
+{
+    if (iOption == ShaderConstant::SCO_INVERSE
+    ||  iOption == ShaderConstant::SCO_INVERSE_TRANSPOSE)
+    {
+        // the inverse is cached along with the world matrix
+        Matrix4x kInvM(m_pkGeometry->GetWorldInverseHomogeneous(),false);
+        GetTransform(kInvM,(iOption == ShaderConstant::SCO_INVERSE ?
+            ShaderConstant::SCO_MATRIX : ShaderConstant::SCO_TRANSPOSE),
+            afData);
+        return;
+    }
+
+    Matrix4x kM(m_pkGeometry->GetWorldHomogeneous(),false);
+    GetTransform(kM,iOption,afData);
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetConstantTransformP (int iOption, fixed* afData)
+{
+    // The renderer keeps no projection or view matrix, the constants that
+    // depend on them are identity matrices.
+    Matrix4x kP = Matrix4x::IDENTITY;
+    GetTransform(kP,iOption,afData);
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetConstantTransformMV (int iOption, fixed* afData)
+{
+    Matrix4x kMV = Matrix4x::IDENTITY;
+    GetTransform(kMV,iOption,afData);
+}
+//----------------------------------------------------------------------------
+void NullRenderer::SetConstantTransformMVP (int iOption, fixed* afData)
+{
+    Matrix4x kPMV = Matrix4x::IDENTITY;
+    GetTransform(kPMV,iOption,afData);
+}
+//----------------------------------------------------------------------------
+void NullRenderer::GetTransform (Matrix4x& rkMat, int iOption,
+    fixed* afData)
+{
+    switch (iOption)
+    {
+    case ShaderConstant::SCO_MATRIX:
+        break;
+    case ShaderConstant::SCO_TRANSPOSE:
+        rkMat = rkMat.Transpose();
+        break;
+    case ShaderConstant::SCO_INVERSE:
+        rkMat = rkMat.Inverse();
+        break;
+    case ShaderConstant::SCO_INVERSE_TRANSPOSE:
+        rkMat = rkMat.Inverse().Transpose();
+        break;
+    default:
+        assert(false);
+        break;
+    }
+
+    const fixed* afMat = (const fixed*)rkMat;
+    for (int i = 0; i < 16; i++)
+    {
+        afData[i] = afMat[i];
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,211 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgNullRenderer.h                   //
+//                                                       //
+//  - Interface for NullRenderer class                   //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+
+#ifndef __WG_NULLRENDERER_H__
+#define __WG_NULLRENDERER_H__
+
+#include "WgNullRendererLIB.h"
+#include "WgRenderer.h"
+#include "WgLight.h"
+#include "WgTexture.h"
+#include "WgGeometry.h"
+
+
+namespace WGSoft3D
+{
+
+class BindInfoArray;
+
+// A renderer that draws nothing.  It measures the cost of the scene graph
+// (traversal, culling, render state updates and effect dispatch) without a
+// graphics library, for example for benchmarks of DrawScene on machines
+// without OpenGL ES.
+//
+// Every function of the Renderer interface only counts its calls, but it
+// reads the data that the OpenGL ES renderers hand to the driver:  the
+// vertex, normal, color, texture coordinate and index arrays of each draw,
+// the texture images and the cached arrays when they are seen first, the
+// render states and the lights.  The resources are bound to the renderer in
+// the BindInfoArray of the texture or the cached array, as the OpenGL ES
+// renderers bind their names.  Unlike those renderers it keeps the raw data
+// of the resources, so the scene can be drawn by another renderer later.
+//
+// The counts of the frame in progress are in GetStatistics.  A frame ends
+// with DisplayBackBuffer, then its counts are in GetFrameStatistics.
+
+class WG3D_RENDERER_ITEM NullRenderer : public Renderer
+{
+public:
+    // construction and destruction
+    NullRenderer (const BufferParams& rkBufferParams, int iWidth,
+        int iHeight);
+    virtual ~NullRenderer ();
+
+    virtual void Activate ();
+
+    // full window buffer operations
+    virtual void ClearBackBuffer ();
+    virtual void ClearZBuffer ();
+    virtual void ClearStencilBuffer ();
+    virtual void ClearBuffers ();
+    virtual void DisplayBackBuffer ();
+
+    // clear the buffer in the specified subwindow
+    virtual void ClearBackBuffer (int iXPos, int iYPos, int iWidth,
+        int iHeight);
+    virtual void ClearZBuffer (int iXPos, int iYPos, int iWidth,
+        int iHeight);
+    virtual void ClearStencilBuffer (int iXPos, int iYPos, int iWidth,
+        int iHeight);
+    virtual void ClearBuffers (int iXPos, int iYPos, int iWidth,
+        int iHeight);
+
+    // management of texture resources
+    virtual void ReleaseTexture (Texture* pkTexture);
+
+    // management of array resources
+    virtual void ReleaseArray (CachedColorRGBAArray* pkArray);
+    virtual void ReleaseArray (CachedColorRGBArray* pkArray);
+    virtual void ReleaseArray (CachedShortArray* pkArray);
+    virtual void ReleaseArray (CachedVector2xArray* pkArray);
+    virtual void ReleaseArray (CachedVector3xArray* pkArray);
+
+    // The counts of a frame.  A bind is a request to use a texture or a
+    // cached array, a change is a bind of a texture that was not bound to
+    // the texture unit before.  An upload is the first bind of a resource,
+    // its data counts as uploaded bytes.  The arrays that are not cached
+    // count as streamed bytes at every draw.
+    class WG3D_RENDERER_ITEM Statistics
+    {
+    public:
+        Statistics ();
+        void Reset ();
+
+        int Draws;
+        int Triangles, Lines, Points;
+        int Vertices, Indices;
+        int StateSets[GlobalState::MAX_STATE];
+        int TextureBinds, TextureChanges, TextureUploads;
+        int BufferBinds, BufferUploads;
+        int BytesUploaded, BytesStreamed;
+        int LightsEnabled;
+        int Transforms;
+        int Effects;
+        int Clears;
+    };
+
+    const Statistics& GetStatistics () const;
+    const Statistics& GetFrameStatistics () const;
+    int GetFrameQuantity () const;
+
+    // A sum of all the data that was read.  It exists so that the compiler
+    // cannot drop the reads.
+    unsigned int GetChecksum () const;
+
+    enum
+    {
+        MAX_TEXTURES = 8,
+        MAX_LIGHTS = 8
+    };
+
+protected:
+    // camera updates
+    virtual void OnFrustumChange ();
+    virtual void OnViewPortChange ();
+    virtual void OnFrameChange ();
+
+    // global render state management
+    virtual void SetAlphaState (AlphaState* pkState);
+    virtual void SetCullState (CullState* pkState);
+    virtual void SetDitherState (DitherState* pkState);
+    virtual void SetFogState (FogState* pkState);
+    virtual void SetMaterialState (MaterialState* pkState);
+    virtual void SetPolygonOffsetState (PolygonOffsetState* pkState);
+    virtual void SetShadeState (ShadeState* pkState);
+    virtual void SetZBufferState (ZBufferState* pkState);
+    virtual void SetStencilState (StencilState* pkState);
+
+    // light management
+    virtual void EnableLighting (int eEnable = EL_ALL);
+    virtual void DisableLighting ();
+    virtual void EnableLight (int eEnable, int i, const Light* pkLight);
+    virtual void DisableLight (int i, const Light* pkLight);
+
+    // texture management
+    virtual void EnableTexture (int iUnit, int i, Effect* pkEffect);
+    virtual void DisableTexture (int iUnit, int i, Effect* pkEffect);
+    virtual void SetActiveTextureUnit (int iUnit);
+
+    // transformations
+    virtual void SetWorldTransformation ();
+    virtual void RestoreWorldTransformation ();
+    virtual void SetScreenTransformation ();
+    virtual void RestoreScreenTransformation ();
+
+    // array management
+    virtual void EnableVertices ();
+    virtual void DisableVertices ();
+    virtual void EnableNormals ();
+    virtual void DisableNormals ();
+    virtual void EnableColorRGBAs ();
+    virtual void DisableColorRGBAs ();
+    virtual void EnableColorRGBs ();
+    virtual void DisableColorRGBs ();
+    virtual void EnableUVs (int i, Effect* pkEffect);
+    virtual void DisableUVs (Vector2xArray* pkUVs);
+    virtual void DrawElements ();
+
+    // shader management
+    virtual void SetConstantTransformM (int iOption, fixed* afData);
+    virtual void SetConstantTransformP (int iOption, fixed* afData);
+    virtual void SetConstantTransformMV (int iOption, fixed* afData);
+    virtual void SetConstantTransformMVP (int iOption, fixed* afData);
+    void GetTransform (Matrix4x& rkMat, int iOption, fixed* afData);
+
+    // effects
+    virtual void DrawBumpMap ();
+    virtual void DrawEnvironmentMap ();
+    virtual void DrawGlossMap ();
+    virtual void DrawPlanarShadow ();
+    virtual void DrawProjectedTexture ();
+
+private:
+    // Bind an array to the renderer.  The array is cached when pkBIArray
+    // is not null.  The data is read when the array is uploaded or
+    // streamed.
+    void UseArray (BindInfoArray* pkBIArray, const void* pvData,
+        int iBytes);
+    void ReleaseBinding (BindInfoArray* pkBIArray);
+
+    // the sum of the 32-bit words of a block of memory
+    static unsigned int Read (const void* pvData, int iBytes);
+
+    Statistics m_kStatistics, m_kFrameStatistics;
+    int m_iFrameQuantity;
+    unsigned int m_uiChecksum;
+
+    // The next name of a resource.  The names start at 1, a zero name
+    // means the resource is not bound.
+    unsigned int m_uiNextID;
+
+    // The bound resources.  They are unbound when the renderer is destroyed,
+    // since their destructors release them through the renderer.
+    TArray<Texture*> m_kTexture;
+    TArray<BindInfoArray*> m_kArray;
+
+    // the texture bound to each unit
+    int m_iActiveUnit;
+    unsigned int m_auiBoundTexture[MAX_TEXTURES];
+};
+
+#include "WgNullRenderer.inl"
+
+}
+
+#endif
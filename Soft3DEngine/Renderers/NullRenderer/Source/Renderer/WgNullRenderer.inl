@@ -0,0 +1,30 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgNullRenderer.inl                 //
+//                                                       //
+//  - Inlines for NullRenderer class                     //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+inline const NullRenderer::Statistics& NullRenderer::GetStatistics () const
+{
+    return m_kStatistics;
+}
+//----------------------------------------------------------------------------
+inline const NullRenderer::Statistics& NullRenderer::GetFrameStatistics ()
+    const
+{
+    return m_kFrameStatistics;
+}
+//----------------------------------------------------------------------------
+inline int NullRenderer::GetFrameQuantity () const
+{
+    return m_iFrameQuantity;
+}
+//----------------------------------------------------------------------------
+inline unsigned int NullRenderer::GetChecksum () const
+{
+    return m_uiChecksum;
+}
+//----------------------------------------------------------------------------
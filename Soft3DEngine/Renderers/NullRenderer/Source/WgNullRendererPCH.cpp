@@ -0,0 +1,10 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgNullRendererPCH.cpp              //
+//                                                       //
+//  - Implementation for Precompiled Header class        //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgNullRendererPCH.h"
+
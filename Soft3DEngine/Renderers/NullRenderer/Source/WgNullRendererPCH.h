@@ -0,0 +1,20 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgNullRendererPCH.h                //
+//                                                       //
+//  - Interface for Precompiled Header class             //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+
+#ifndef __WG_NULLRENDERERPCH_H__
+#define __WG_NULLRENDERERPCH_H__
+
+#ifdef WG3D_USE_PRECOMPILED_HEADERS
+
+#include "WgNullRenderer.h"
+
+#endif
+
+#endif
+
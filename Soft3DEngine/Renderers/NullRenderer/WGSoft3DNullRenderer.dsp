@@ -0,0 +1,153 @@
+# Microsoft Developer Studio Project File - Name="WGSoft3DNullRenderer" - Package Owner=<4>
+# Microsoft Developer Studio Generated Build File, Format Version 6.00
+# ** DO NOT EDIT **
+
+# TARGTYPE "Win32 (x86) Dynamic-Link Library" 0x0102
+
+CFG=WGSoft3DNullRenderer - Win32 Debug
+!MESSAGE This is not a valid makefile. To build this project using NMAKE,
+!MESSAGE use the Export Makefile command and run
+!MESSAGE 
+!MESSAGE NMAKE /f "WGSoft3DNullRenderer.mak".
+!MESSAGE 
+!MESSAGE You can specify a configuration when running NMAKE
+!MESSAGE by defining the macro CFG on the command line. For example:
+!MESSAGE 
+!MESSAGE NMAKE /f "WGSoft3DNullRenderer.mak" CFG="WGSoft3DNullRenderer - Win32 Debug"
+!MESSAGE 
+!MESSAGE Possible choices for configuration are:
+!MESSAGE 
+!MESSAGE "WGSoft3DNullRenderer - Win32 Release" (based on "Win32 (x86) Dynamic-Link Library")
+!MESSAGE "WGSoft3DNullRenderer - Win32 Debug" (based on "Win32 (x86) Dynamic-Link Library")
+!MESSAGE 
+
+# Begin Project
+# PROP AllowPerConfigDependencies 0
+# PROP Scc_ProjName ""
+# PROP Scc_LocalPath ""
+CPP=cl.exe
+MTL=midl.exe
+RSC=rc.exe
+
+!IF  "$(CFG)" == "WGSoft3DNullRenderer - Win32 Release"
+
+# PROP BASE Use_MFC 0
+# PROP BASE Use_Debug_Libraries 0
+# PROP BASE Output_Dir "Release"
+# PROP BASE Intermediate_Dir "Release"
+# PROP BASE Target_Dir ""
+# PROP Use_MFC 0
+# PROP Use_Debug_Libraries 0
+# PROP Output_Dir "Release"
+# PROP Intermediate_Dir "Release"
+# PROP Ignore_Export_Lib 0
+# PROP Target_Dir ""
+# ADD BASE CPP /nologo /MT /W3 /GX /O2 /D "WIN32" /D "NDEBUG" /D "_WINDOWS" /D "_MBCS" /D "_USRDLL" /D "WGSOFT3DOMAPGLRENDERER_EXPORTS" /YX /FD /c
+# ADD CPP /nologo /MD /W3 /GX /O2 /I "." /I "./Source" /I "./Source/Renderer" /I "../../include" /D "WIN32" /D "NDEBUG" /D "_WINDOWS" /D "_MBCS" /D "_USRDLL" /D "WG3D_RENDERER_DLL_EXPORT" /D "WG3D_FOUNDATION_DLL_IMPORT" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgNullRendererPCH.h" /FD /c
+# ADD BASE MTL /nologo /D "NDEBUG" /mktyplib203 /win32
+# ADD MTL /nologo /D "NDEBUG" /mktyplib203 /win32
+# ADD BASE RSC /l 0x412 /d "NDEBUG"
+# ADD RSC /l 0x412 /d "NDEBUG"
+BSC32=bscmake.exe
+# ADD BASE BSC32 /nologo
+# ADD BSC32 /nologo
+LINK32=link.exe
+# ADD BASE LINK32 kernel32.lib user32.lib gdi32.lib winspool.lib comdlg32.lib advapi32.lib shell32.lib ole32.lib oleaut32.lib uuid.lib odbc32.lib odbccp32.lib /nologo /dll /machine:I386
+# ADD LINK32 kernel32.lib user32.lib gdi32.lib winspool.lib comdlg32.lib advapi32.lib shell32.lib ole32.lib oleaut32.lib uuid.lib odbc32.lib odbccp32.lib WGSoft3DFoundation.lib /nologo /dll /machine:I386 /out:"../../bin/WGSoft3DNullRenderer.dll" /implib:"../../bin/WGSoft3DNullRenderer.lib" /libpath:"./../../bin"
+# SUBTRACT LINK32 /pdb:none
+# Begin Special Build Tool
+SOURCE="$(InputPath)"
+PostBuild_Cmds=copy /y Source\Renderer\*.h ..\..\Include	copy /y Source\Renderer\*.inl ..\..\Include	copy /y Source\*.h ..\..\Include
+# End Special Build Tool
+
+!ELSEIF  "$(CFG)" == "WGSoft3DNullRenderer - Win32 Debug"
+
+# PROP BASE Use_MFC 0
+# PROP BASE Use_Debug_Libraries 1
+# PROP BASE Output_Dir "Debug"
+# PROP BASE Intermediate_Dir "Debug"
+# PROP BASE Target_Dir ""
+# PROP Use_MFC 0
+# PROP Use_Debug_Libraries 1
+# PROP Output_Dir "Debug"
+# PROP Intermediate_Dir "Debug"
+# PROP Ignore_Export_Lib 0
+# PROP Target_Dir ""
+# ADD BASE CPP /nologo /MTd /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_WINDOWS" /D "_MBCS" /D "_USRDLL" /D "WGSOFT3DOMAPGLRENDERER_EXPORTS" /YX /FD /GZ /c
+# ADD CPP /nologo /MDd /W3 /Gm /GR /GX /ZI /Od /I "." /I "./Source" /I "./Source/Renderer" /I "../../include" /D "WIN32" /D "_DEBUG" /D "_WINDOWS" /D "_MBCS" /D "_USRDLL" /D "WG3D_RENDERER_DLL_EXPORT" /D "WG3D_FOUNDATION_DLL_IMPORT" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgNullRendererPCH.h" /FD /GZ /c
+# ADD BASE MTL /nologo /D "_DEBUG" /mktyplib203 /win32
+# ADD MTL /nologo /D "_DEBUG" /mktyplib203 /win32
+# ADD BASE RSC /l 0x412 /d "_DEBUG"
+# ADD RSC /l 0x412 /d "_DEBUG"
+BSC32=bscmake.exe
+# ADD BASE BSC32 /nologo
+# ADD BSC32 /nologo
+LINK32=link.exe
+# ADD BASE LINK32 kernel32.lib user32.lib gdi32.lib winspool.lib comdlg32.lib advapi32.lib shell32.lib ole32.lib oleaut32.lib uuid.lib odbc32.lib odbccp32.lib /nologo /dll /debug /machine:I386 /pdbtype:sept
+# ADD LINK32 kernel32.lib user32.lib gdi32.lib winspool.lib comdlg32.lib advapi32.lib shell32.lib ole32.lib oleaut32.lib uuid.lib odbc32.lib odbccp32.lib WGSoft3DFoundation_D.lib /nologo /dll /debug /machine:I386 /out:"../../bin/WGSoft3DNullRenderer_D.dll" /implib:"../../bin/WGSoft3DNullRenderer_D.lib" /pdbtype:sept /libpath:"./../../bin"
+# SUBTRACT LINK32 /pdb:none /nodefaultlib
+# Begin Special Build Tool
+SOURCE="$(InputPath)"
+PostBuild_Cmds=copy /y Source\Renderer\*.h ..\..\Include	copy /y Source\Renderer\*.inl ..\..\Include	copy /y Source\*.h ..\..\Include
+# End Special Build Tool
+
+!ENDIF 
+
+# Begin Target
+
+# Name "WGSoft3DNullRenderer - Win32 Release"
+# Name "WGSoft3DNullRenderer - Win32 Debug"
+# Begin Group "Renderer"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullRenderer.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullRenderer.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullRenderer.inl
+# End Source File
+# End Group
+# Begin Group "Effects"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullBumpMap.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullEnvironmentMap.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullGlossMap.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullPlanarShadow.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullProjectedTexture.cpp
+# End Source File
+# End Group
+# Begin Source File
+
+SOURCE=.\Source\WgNullRendererLIB.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\WgNullRendererPCH.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\WgNullRendererPCH.h
+# End Source File
+# End Target
+# End Project
@@ -0,0 +1,136 @@
+# Microsoft Developer Studio Project File - Name="WGSoft3DNullRendererStatic" - Package Owner=<4>
+# Microsoft Developer Studio Generated Build File, Format Version 6.00
+# ** DO NOT EDIT **
+
+# TARGTYPE "Win32 (x86) Static Library" 0x0104
+
+CFG=WGSoft3DNullRendererStatic - Win32 Debug
+!MESSAGE This is not a valid makefile. To build this project using NMAKE,
+!MESSAGE use the Export Makefile command and run
+!MESSAGE 
+!MESSAGE NMAKE /f "WGSoft3DNullRendererStatic.mak".
+!MESSAGE 
+!MESSAGE You can specify a configuration when running NMAKE
+!MESSAGE by defining the macro CFG on the command line. For example:
+!MESSAGE 
+!MESSAGE NMAKE /f "WGSoft3DNullRendererStatic.mak" CFG="WGSoft3DNullRendererStatic - Win32 Debug"
+!MESSAGE 
+!MESSAGE Possible choices for configuration are:
+!MESSAGE 
+!MESSAGE "WGSoft3DNullRendererStatic - Win32 Release" (based on "Win32 (x86) Static Library")
+!MESSAGE "WGSoft3DNullRendererStatic - Win32 Debug" (based on "Win32 (x86) Static Library")
+!MESSAGE 
+
+# Begin Project
+# PROP AllowPerConfigDependencies 0
+# PROP Scc_ProjName ""
+# PROP Scc_LocalPath ""
+CPP=cl.exe
+RSC=rc.exe
+
+!IF  "$(CFG)" == "WGSoft3DNullRendererStatic - Win32 Release"
+
+# PROP BASE Use_MFC 0
+# PROP BASE Use_Debug_Libraries 0
+# PROP BASE Output_Dir "Release"
+# PROP BASE Intermediate_Dir "Release"
+# PROP BASE Target_Dir ""
+# PROP Use_MFC 0
+# PROP Use_Debug_Libraries 0
+# PROP Output_Dir "Release"
+# PROP Intermediate_Dir "Release"
+# PROP Target_Dir ""
+# ADD BASE CPP /nologo /W3 /GX /O2 /D "WIN32" /D "NDEBUG" /D "_MBCS" /D "_LIB" /YX /FD /c
+# ADD CPP /nologo /MT /W3 /GX /O2 /I "." /I "./Source" /I "./Source/Renderer" /I "../../include" /D "WIN32" /D "NDEBUG" /D "_MBCS" /D "_LIB" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgNullRendererPCH.h" /FD /c
+# ADD BASE RSC /l 0x412 /d "NDEBUG"
+# ADD RSC /l 0x412 /d "NDEBUG"
+BSC32=bscmake.exe
+# ADD BASE BSC32 /nologo
+# ADD BSC32 /nologo
+LIB32=link.exe -lib
+# ADD BASE LIB32 /nologo
+# ADD LIB32 /nologo /out:"../../bin/WGSoft3DNullRendererStatic.lib"
+
+!ELSEIF  "$(CFG)" == "WGSoft3DNullRendererStatic - Win32 Debug"
+
+# PROP BASE Use_MFC 0
+# PROP BASE Use_Debug_Libraries 1
+# PROP BASE Output_Dir "Debug"
+# PROP BASE Intermediate_Dir "Debug"
+# PROP BASE Target_Dir ""
+# PROP Use_MFC 0
+# PROP Use_Debug_Libraries 1
+# PROP Output_Dir "Debug"
+# PROP Intermediate_Dir "Debug"
+# PROP Target_Dir ""
+# ADD BASE CPP /nologo /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_MBCS" /D "_LIB" /YX /FD /GZ /c
+# ADD CPP /nologo /MTd /W3 /Gm /GX /ZI /Od /I "." /I "./Source" /I "./Source/Renderer" /I "../../include" /D "WIN32" /D "_DEBUG" /D "_MBCS" /D "_LIB" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgNullRendererPCH.h" /FD /GZ /c
+# ADD BASE RSC /l 0x412 /d "_DEBUG"
+# ADD RSC /l 0x412 /d "_DEBUG"
+BSC32=bscmake.exe
+# ADD BASE BSC32 /nologo
+# ADD BSC32 /nologo
+LIB32=link.exe -lib
+# ADD BASE LIB32 /nologo
+# ADD LIB32 /nologo /out:"../../bin/WGSoft3DNullRendererStatic_D.lib"
+
+!ENDIF 
+
+# Begin Target
+
+# Name "WGSoft3DNullRendererStatic - Win32 Release"
+# Name "WGSoft3DNullRendererStatic - Win32 Debug"
+# Begin Group "Effects"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullBumpMap.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullEnvironmentMap.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullGlossMap.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullPlanarShadow.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullProjectedTexture.cpp
+# End Source File
+# End Group
+# Begin Group "Renderer"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullRenderer.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullRenderer.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgNullRenderer.inl
+# End Source File
+# End Group
+# Begin Source File
+
+SOURCE=.\Source\WgNullRendererLIB.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\WgNullRendererPCH.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\WgNullRendererPCH.h
+# End Source File
+# End Target
+# End Project
@@ -12,11 +12,14 @@
 #include "WgOmapGLRenderer.h"
 #include "WgBumpMapEffect.h"
 #include "WgCachedColorRGBArray.h"
+#include "WgProfiler.h"
 using namespace WGSoft3D;
 
 //----------------------------------------------------------------------------
 void OmapGLRenderer::DrawBumpMap ()
 {
+    WG3D_PROFILE("OmapGLRenderer::DrawBumpMap");
+
     Triangles* pkMesh = DynamicCast<Triangles>(m_pkGeometry);
     assert(pkMesh);
     BumpMapEffect* pkBMEffect = DynamicCast<BumpMapEffect>(
@@ -57,8 +60,8 @@ void OmapGLRenderer::DrawBumpMap ()
 
     // *** SECOND PASS
     EnableLighting();
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_DST_COLOR,GL_ZERO);
+    m_kGLState.Enable(GL_BLEND);
+    m_kGLState.BlendFunc(GL_DST_COLOR,GL_ZERO);
 
     // set the normal array
     EnableNormals();
@@ -30,17 +30,17 @@ void OmapGLRenderer::SetFogState (FogState* pkState)
 {
     if (pkState->Enabled)
     {
-        glEnable(GL_FOG);
-        glFogx(GL_FOG_START,pkState->Start.value);
-        glFogx(GL_FOG_END,pkState->End.value);
-        glFogxv(GL_FOG_COLOR,(GLfixed*)(fixed*)pkState->Color);
-        glFogx(GL_FOG_DENSITY,pkState->Density.value);
-        glFogx(GL_FOG_MODE,ms_aeFogDensity[pkState->DensityFunction]);
-        glHint(GL_FOG_HINT,ms_aeFogApply[pkState->ApplyFunction]);
+        m_kGLState.Enable(GL_FOG);
+        m_kGLState.Fog(GL_FOG_START,pkState->Start.value);
+        m_kGLState.Fog(GL_FOG_END,pkState->End.value);
+        m_kGLState.FogColor((GLreal*)(fixed*)pkState->Color);
+        m_kGLState.Fog(GL_FOG_DENSITY,pkState->Density.value);
+        m_kGLState.FogMode(ms_aeFogDensity[pkState->DensityFunction]);
+        m_kGLState.Hint(GL_FOG_HINT,ms_aeFogApply[pkState->ApplyFunction]);
     }
     else
     {
-        glDisable(GL_FOG);
+        m_kGLState.Disable(GL_FOG);
     }
 }
 //----------------------------------------------------------------------------
@@ -11,11 +11,14 @@
 #include "WgOmapGLRendererPCH.h"
 #include "WgOmapGLRenderer.h"
 #include "WgGlossMapEffect.h"
+#include "WgProfiler.h"
 using namespace WGSoft3D;
 
 //----------------------------------------------------------------------------
 void OmapGLRenderer::DrawGlossMap ()
 {
+    WG3D_PROFILE("OmapGLRenderer::DrawGlossMap");
+
     assert(m_pkGeometry->m_GeometryType == Geometry::GT_TRIMESH);
     assert(DynamicCast<GlossMapEffect>(m_pkGeometry->GetEffect()));
     GlossMapEffect* pkGMEffect = (GlossMapEffect*)m_pkGeometry->GetEffect();
@@ -58,8 +61,8 @@ void OmapGLRenderer::DrawGlossMap ()
     // The idea is that any texture value with alpha value of one will appear
     // to be specular.
     SetGlobalState(m_pkGeometry->States);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE,GL_SRC_ALPHA);
+    m_kGLState.Enable(GL_BLEND);
+    m_kGLState.BlendFunc(GL_ONE,GL_SRC_ALPHA);
     EnableLighting(EL_AMBIENT | EL_DIFFUSE);
 
     // enable the gloss map texture
@@ -15,11 +15,11 @@ using namespace WGSoft3D;
 //----------------------------------------------------------------------------
 void OmapGLRenderer::SetMaterialState (MaterialState* pkState)
 {
-    glMaterialxv(GL_FRONT,GL_EMISSION,(GLfixed*)(fixed*)pkState->Emissive);
-    glMaterialxv(GL_FRONT,GL_AMBIENT,(GLfixed*)(fixed*)pkState->Ambient);
-    glMaterialxv(GL_FRONT,GL_DIFFUSE,(GLfixed*)(fixed*)pkState->Diffuse);
-    glMaterialxv(GL_FRONT,GL_SPECULAR,(GLfixed*)(fixed*)pkState->Specular);
-    glMaterialx(GL_FRONT,GL_SHININESS,pkState->Shininess.value);
+    m_kGLState.Materialv(GL_EMISSION,(GLreal*)(fixed*)pkState->Emissive);
+    m_kGLState.Materialv(GL_AMBIENT,(GLreal*)(fixed*)pkState->Ambient);
+    m_kGLState.Materialv(GL_DIFFUSE,(GLreal*)(fixed*)pkState->Diffuse);
+    m_kGLState.Materialv(GL_SPECULAR,(GLreal*)(fixed*)pkState->Specular);
+    m_kGLState.Material(GL_SHININESS,pkState->Shininess.value);
 }
 //----------------------------------------------------------------------------
 
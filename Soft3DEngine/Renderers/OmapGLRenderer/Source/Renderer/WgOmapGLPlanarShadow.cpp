@@ -14,11 +14,14 @@
 #include "WgMatrix4.h"
 #include "WgNode.h"
 #include "WgPlanarShadowEffect.h"
+#include "WgProfiler.h"
 using namespace WGSoft3D;
 
 //----------------------------------------------------------------------------
 void OmapGLRenderer::DrawPlanarShadow ()
 {
+    WG3D_PROFILE("OmapGLRenderer::DrawPlanarShadow");
+
     // Access the special effect.  Detach it from the node to allow the
     // effectless node drawing.
     assert(DynamicCast<PlanarShadowEffect>(m_pkNode->GetEffect()));
@@ -43,24 +46,24 @@ void OmapGLRenderer::DrawPlanarShadow ()
         ColorRGBA kShadowColor = spkPSEffect->GetShadowColor(i);
 
         // enable depth buffering
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(GL_LEQUAL);
-        glDepthMask(GL_TRUE);
+        m_kGLState.Enable(GL_DEPTH_TEST);
+        m_kGLState.DepthFunc(GL_LEQUAL);
+        m_kGLState.DepthMask(GL_TRUE);
         m_bAllowZBufferState = false;
 
         // Enable the stencil buffer so that the shadow can be clipped by the
         // plane.
-        glEnable(GL_STENCIL_TEST);
-        glStencilFunc(GL_ALWAYS,i+1,~0);
-        glStencilOp(GL_KEEP,GL_KEEP,GL_REPLACE);
-        glStencilMask(~0);
+        m_kGLState.Enable(GL_STENCIL_TEST);
+        m_kGLState.StencilFunc(GL_ALWAYS,i+1,~0);
+        m_kGLState.StencilOp(GL_KEEP,GL_KEEP,GL_REPLACE);
+        m_kGLState.StencilMask(~0);
 
         // draw the plane
         Renderer::Draw(spkPlane);
 
         // disable the stencil buffer and depth buffer
-        glDisable(GL_STENCIL_TEST);
-        glDisable(GL_DEPTH_TEST);
+        m_kGLState.Disable(GL_STENCIL_TEST);
+        m_kGLState.Disable(GL_DEPTH_TEST);
         m_bAllowZBufferState = true;
 
         // compute the equation for the shadow plane in world coordinates
@@ -117,20 +120,20 @@ void OmapGLRenderer::DrawPlanarShadow ()
 
         glMatrixMode(GL_MODELVIEW);
         glPushMatrix();
-        glMultMatrixx((const GLfixed*)(const fixed*)kProjection);
+        glMultMatrixr((const GLreal*)(const fixed*)kProjection);
 
         // Alpha blending used to blend the shadow color with the appropriate
         // pixels drawn for the projection plane.
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
+        m_kGLState.Enable(GL_BLEND);
+        m_kGLState.BlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
         ColorRGBA kSaveColor;
-        glGetFixedv(GL_CURRENT_COLOR,(GLfixed*)(fixed*)kSaveColor);
-        glColor4x(kShadowColor.R().value,kShadowColor.G().value,kShadowColor.B().value,kShadowColor.A().value);
+        glGetRealv(GL_CURRENT_COLOR,(GLreal*)(fixed*)kSaveColor);
+        glColor4r(kShadowColor.R().value,kShadowColor.G().value,kShadowColor.B().value,kShadowColor.A().value);
 		
         // Only draw where the plane has been drawn.
-        glEnable(GL_STENCIL_TEST);
-        glStencilFunc(GL_EQUAL,i+1,~0);
-        glStencilOp(GL_KEEP,GL_KEEP,GL_ZERO);
+        m_kGLState.Enable(GL_STENCIL_TEST);
+        m_kGLState.StencilFunc(GL_EQUAL,i+1,~0);
+        m_kGLState.StencilOp(GL_KEEP,GL_KEEP,GL_ZERO);
 
         // Draw the caster again, but using only vertices and triangles
         // indices.  Disable culling to allow out-of-view objects to cast
@@ -150,13 +153,13 @@ void OmapGLRenderer::DrawPlanarShadow ()
         m_bAllowTextures = true;
 
         // disable the stencil buffer
-        glDisable(GL_STENCIL_TEST);
+        m_kGLState.Disable(GL_STENCIL_TEST);
 
         // restore current color
-		glColor4x(kSaveColor.R().value,kSaveColor.G().value,kSaveColor.B().value,kSaveColor.A().value);
+		glColor4r(kSaveColor.R().value,kSaveColor.G().value,kSaveColor.B().value,kSaveColor.A().value);
 
         // disable alpha blending
-        glDisable(GL_BLEND);
+        m_kGLState.Disable(GL_BLEND);
 
         // restore the model-to-world transformation
         glPopMatrix();
@@ -13,11 +13,14 @@
 #include "WgOmapGLRenderer.h"
 #include "WgNode.h"
 #include "WgProjectedTextureEffect.h"
+#include "WgProfiler.h"
 using namespace WGSoft3D;
 
 //----------------------------------------------------------------------------
 void OmapGLRenderer::DrawProjectedTexture ()
 {
+    WG3D_PROFILE("OmapGLRenderer::DrawProjectedTexture");
+
     // Access the special effect.  Detach it from the node to allow the
     // effectless node drawing.
     assert(DynamicCast<ProjectedTextureEffect>(m_pkGlobalEffect));
@@ -21,7 +21,7 @@ GLenum OmapGLRenderer::ms_aeShade[ShadeState::SM_QUANTITY] =
 //----------------------------------------------------------------------------
 void OmapGLRenderer::SetShadeState (ShadeState* pkState)
 {
-    glShadeModel(ms_aeShade[pkState->Shade]);
+    m_kGLState.ShadeModel(ms_aeShade[pkState->Shade]);
 }
 //----------------------------------------------------------------------------
 
@@ -43,7 +43,7 @@ RSC=rc.exe
 # PROP Ignore_Export_Lib 0
 # PROP Target_Dir ""
 # ADD BASE CPP /nologo /MT /W3 /GX /O2 /D "WIN32" /D "NDEBUG" /D "_WINDOWS" /D "_MBCS" /D "_USRDLL" /D "WGSOFT3DOMAPGLRENDERER_EXPORTS" /YX /FD /c
-# ADD CPP /nologo /MD /W3 /GX /O2 /I "." /I "./Source" /I "./Source/Renderer" /I "../../include" /I "../../external/OmapGL/include" /D "WIN32" /D "NDEBUG" /D "_WINDOWS" /D "_MBCS" /D "_USRDLL" /D "WG3D_RENDERER_DLL_EXPORT" /D "WG3D_FOUNDATION_DLL_IMPORT" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgOmapGLRendererPCH.h" /FD /c
+# ADD CPP /nologo /MD /W3 /GX /O2 /I "." /I "./Source" /I "./Source/Renderer" /I "../GLShared/Source" /I "../../include" /I "../../external/OmapGL/include" /D "WIN32" /D "NDEBUG" /D "_WINDOWS" /D "_MBCS" /D "_USRDLL" /D "WG3D_RENDERER_DLL_EXPORT" /D "WG3D_FOUNDATION_DLL_IMPORT" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgOmapGLRendererPCH.h" /FD /c
 # ADD BASE MTL /nologo /D "NDEBUG" /mktyplib203 /win32
 # ADD MTL /nologo /D "NDEBUG" /mktyplib203 /win32
 # ADD BASE RSC /l 0x412 /d "NDEBUG"
@@ -57,7 +57,7 @@ LINK32=link.exe
 # SUBTRACT LINK32 /pdb:none
 # Begin Special Build Tool
 SOURCE="$(InputPath)"
-PostBuild_Cmds=copy /y Source\Renderer\*.h ..\..\Include	copy /y Source\Renderer\*.inl ..\..\Include	copy /y Source\*.h ..\..\Include
+PostBuild_Cmds=copy /y Source\Renderer\*.h ..\..\Include	copy /y Source\Renderer\*.inl ..\..\Include	copy /y Source\*.h ..\..\Include	copy /y ..\GLShared\Source\*.h ..\..\Include	copy /y ..\GLShared\Source\*.inl ..\..\Include
 # End Special Build Tool
 
 !ELSEIF  "$(CFG)" == "WGSoft3DOmapGLRenderer - Win32 Debug"
@@ -74,7 +74,7 @@ PostBuild_Cmds=copy /y Source\Renderer\*.h ..\..\Include	copy /y Source\Renderer
 # PROP Ignore_Export_Lib 0
 # PROP Target_Dir ""
 # ADD BASE CPP /nologo /MTd /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_WINDOWS" /D "_MBCS" /D "_USRDLL" /D "WGSOFT3DOMAPGLRENDERER_EXPORTS" /YX /FD /GZ /c
-# ADD CPP /nologo /MDd /W3 /Gm /GR /GX /ZI /Od /I "." /I "./Source" /I "./Source/Renderer" /I "../../include" /I "../../external/OmapGL/include" /D "WIN32" /D "_DEBUG" /D "_WINDOWS" /D "_MBCS" /D "_USRDLL" /D "WG3D_RENDERER_DLL_EXPORT" /D "WG3D_FOUNDATION_DLL_IMPORT" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgOmapGLRendererPCH.h" /FD /GZ /c
+# ADD CPP /nologo /MDd /W3 /Gm /GR /GX /ZI /Od /I "." /I "./Source" /I "./Source/Renderer" /I "../GLShared/Source" /I "../../include" /I "../../external/OmapGL/include" /D "WIN32" /D "_DEBUG" /D "_WINDOWS" /D "_MBCS" /D "_USRDLL" /D "WG3D_RENDERER_DLL_EXPORT" /D "WG3D_FOUNDATION_DLL_IMPORT" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgOmapGLRendererPCH.h" /FD /GZ /c
 # ADD BASE MTL /nologo /D "_DEBUG" /mktyplib203 /win32
 # ADD MTL /nologo /D "_DEBUG" /mktyplib203 /win32
 # ADD BASE RSC /l 0x412 /d "_DEBUG"
@@ -88,7 +88,7 @@ LINK32=link.exe
 # SUBTRACT LINK32 /pdb:none /nodefaultlib
 # Begin Special Build Tool
 SOURCE="$(InputPath)"
-PostBuild_Cmds=copy /y Source\Renderer\*.h ..\..\Include	copy /y Source\Renderer\*.inl ..\..\Include	copy /y Source\*.h ..\..\Include
+PostBuild_Cmds=copy /y Source\Renderer\*.h ..\..\Include	copy /y Source\Renderer\*.inl ..\..\Include	copy /y Source\*.h ..\..\Include	copy /y ..\GLShared\Source\*.h ..\..\Include	copy /y ..\GLShared\Source\*.inl ..\..\Include
 # End Special Build Tool
 
 !ENDIF 
@@ -102,6 +102,18 @@ PostBuild_Cmds=copy /y Source\Renderer\*.h ..\..\Include	copy /y Source\Renderer
 # PROP Default_Filter ""
 # Begin Source File
 
+SOURCE=..\GLShared\Source\WgGLStateCache.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=..\GLShared\Source\WgGLStateCache.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\GLShared\Source\WgGLStateCache.inl
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\Renderer\WgOmapGLRenderer.cpp
 # End Source File
 # Begin Source File
@@ -41,7 +41,7 @@ RSC=rc.exe
 # PROP Intermediate_Dir "Release"
 # PROP Target_Dir ""
 # ADD BASE CPP /nologo /W3 /GX /O2 /D "WIN32" /D "NDEBUG" /D "_MBCS" /D "_LIB" /YX /FD /c
-# ADD CPP /nologo /MT /W3 /GX /O2 /I "." /I "./Source" /I "./Source/Renderer" /I "../../include" /I "../../external/OmapGL/include" /D "WIN32" /D "NDEBUG" /D "_MBCS" /D "_LIB" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgOmapGLRendererPCH.h" /FD /c
+# ADD CPP /nologo /MT /W3 /GX /O2 /I "." /I "./Source" /I "./Source/Renderer" /I "../GLShared/Source" /I "../../include" /I "../../external/OmapGL/include" /D "WIN32" /D "NDEBUG" /D "_MBCS" /D "_LIB" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgOmapGLRendererPCH.h" /FD /c
 # ADD BASE RSC /l 0x412 /d "NDEBUG"
 # ADD RSC /l 0x412 /d "NDEBUG"
 BSC32=bscmake.exe
@@ -64,7 +64,7 @@ LIB32=link.exe -lib
 # PROP Intermediate_Dir "Debug"
 # PROP Target_Dir ""
 # ADD BASE CPP /nologo /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_MBCS" /D "_LIB" /YX /FD /GZ /c
-# ADD CPP /nologo /MTd /W3 /Gm /GX /ZI /Od /I "." /I "./Source" /I "./Source/Renderer" /I "../../include" /I "../../external/OmapGL/include" /D "WIN32" /D "_DEBUG" /D "_MBCS" /D "_LIB" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgOmapGLRendererPCH.h" /FD /GZ /c
+# ADD CPP /nologo /MTd /W3 /Gm /GX /ZI /Od /I "." /I "./Source" /I "./Source/Renderer" /I "../GLShared/Source" /I "../../include" /I "../../external/OmapGL/include" /D "WIN32" /D "_DEBUG" /D "_MBCS" /D "_LIB" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgOmapGLRendererPCH.h" /FD /GZ /c
 # ADD BASE RSC /l 0x412 /d "_DEBUG"
 # ADD RSC /l 0x412 /d "_DEBUG"
 BSC32=bscmake.exe
@@ -145,6 +145,18 @@ SOURCE=.\Source\Renderer\WgOmapGLZBufferState.cpp
 # PROP Default_Filter ""
 # Begin Source File
 
+SOURCE=..\GLShared\Source\WgGLStateCache.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=..\GLShared\Source\WgGLStateCache.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\GLShared\Source\WgGLStateCache.inl
+# End Source File
+# Begin Source File
+
 SOURCE=.\Source\Renderer\WgOmapGLRenderer.cpp
 # End Source File
 # Begin Source File
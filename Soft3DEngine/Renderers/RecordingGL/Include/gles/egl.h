@@ -0,0 +1,14 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    egl.h                              //
+//                                                       //
+//  - Forwards gles/egl.h to GLES/egl.h                  //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+// The OpenGL ES renderers include "gles/egl.h", which resolves only on a
+// case-insensitive file system.  With this directory on the include path, in
+// front of the OpenGL ES headers, they compile unchanged on the others.  It
+// is not for Windows, where "GLES/egl.h" would find these files again.
+
+#include "GLES/egl.h"
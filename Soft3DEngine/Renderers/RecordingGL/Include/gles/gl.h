@@ -0,0 +1,14 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    gl.h                               //
+//                                                       //
+//  - Forwards gles/gl.h to GLES/gl.h                    //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+// The OpenGL ES renderers include "gles/gl.h", which resolves only on a
+// case-insensitive file system.  With this directory on the include path, in
+// front of the OpenGL ES headers, they compile unchanged on the others.  It
+// is not for Windows, where "GLES/gl.h" would find these files again.
+
+#include "GLES/gl.h"
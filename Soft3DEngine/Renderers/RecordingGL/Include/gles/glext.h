@@ -0,0 +1,14 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    glext.h                            //
+//                                                       //
+//  - Forwards gles/glext.h to GLES/glext.h              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+// The OpenGL ES renderers include "gles/glext.h", which resolves only on a
+// case-insensitive file system.  With this directory on the include path, in
+// front of the OpenGL ES headers, they compile unchanged on the others.  It
+// is not for Windows, where "GLES/glext.h" would find these files again.
+
+#include "GLES/glext.h"
@@ -0,0 +1,3232 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgGLRecorder.cpp                   //
+//                                                       //
+//  - Implementation for GL Recorder class               //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgRecordingGLPCH.h"
+#include "WgGLRecorder.h"
+using namespace WGSoft3D;
+
+const GLenum GLRecorder::ms_aeCap[GLRecorder::CAP_QUANTITY] =
+{
+    GL_ALPHA_TEST,
+    GL_BLEND,
+    GL_COLOR_LOGIC_OP,
+    GL_CLIP_PLANE0,
+    GL_CLIP_PLANE1,
+    GL_CLIP_PLANE2,
+    GL_CLIP_PLANE3,
+    GL_CLIP_PLANE4,
+    GL_CLIP_PLANE5,
+    GL_COLOR_MATERIAL,
+    GL_CULL_FACE,
+    GL_DEPTH_TEST,
+    GL_DITHER,
+    GL_FOG,
+    GL_LIGHTING,
+    GL_LINE_SMOOTH,
+    GL_MULTISAMPLE,
+    GL_NORMALIZE,
+    GL_POINT_SMOOTH,
+    GL_POINT_SPRITE_OES,
+    GL_POLYGON_OFFSET_FILL,
+    GL_RESCALE_NORMAL,
+    GL_SAMPLE_ALPHA_TO_COVERAGE,
+    GL_SAMPLE_ALPHA_TO_ONE,
+    GL_SAMPLE_COVERAGE,
+    GL_SCISSOR_TEST,
+    GL_STENCIL_TEST
+};
+
+static const float gs_afIdentity[16] =
+{
+    1.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 1.0f, 0.0f, 0.0f,
+    0.0f, 0.0f, 1.0f, 0.0f,
+    0.0f, 0.0f, 0.0f, 1.0f
+};
+
+//----------------------------------------------------------------------------
+GLRecorder& GLRecorder::GetContext ()
+{
+    static GLRecorder s_kContext;
+    return s_kContext;
+}
+//----------------------------------------------------------------------------
+GLRecorder::GLRecorder ()
+    :
+    m_kTextures(256),
+    m_kBuffers(256)
+{
+    m_dLastStart = 0.0;
+    m_iWidth = 640;
+    m_iHeight = 480;
+    m_iDepthBits = 16;
+    m_iStencilBits = 8;
+    m_iTextureBytes = 0;
+    m_iBufferBytes = 0;
+    Reset();
+}
+//----------------------------------------------------------------------------
+GLRecorder::~GLRecorder ()
+{
+    Close();
+    Reset();
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::Open (const char* acFilename)
+{
+    if (!m_kWriter.Open(acFilename))
+    {
+        return false;
+    }
+    m_dLastStart = System::GetPreciseTime();
+    return true;
+}
+//----------------------------------------------------------------------------
+void GLRecorder::Close ()
+{
+    m_kWriter.Close();
+}
+//----------------------------------------------------------------------------
+void GLRecorder::EndFrame ()
+{
+    m_iFrameQuantity++;
+    if (m_kWriter.IsOpen())
+    {
+        GLTrace::Record kRecord;
+        double dTime = System::GetPreciseTime();
+        Write(kRecord,dTime,dTime);
+    }
+}
+//----------------------------------------------------------------------------
+void GLRecorder::Write (GLTrace::Record& rkRecord, double dStart,
+    double dEnd)
+{
+    double dDelta = 1e+09*(dStart - m_dLastStart);
+    double dDuration = 1e+09*(dEnd - dStart);
+    rkRecord.Delta = (dDelta < 4294967295.0 ?
+        (dDelta > 0.0 ? (unsigned int)dDelta : 0) : 0xFFFFFFFF);
+    rkRecord.Duration = (dDuration < 4294967295.0 ?
+        (dDuration > 0.0 ? (unsigned int)dDuration : 0) : 0xFFFFFFFF);
+    m_dLastStart = dStart;
+    m_kWriter.Write(rkRecord);
+}
+//----------------------------------------------------------------------------
+void GLRecorder::SetFramebuffer (int iWidth, int iHeight, int iDepthBits,
+    int iStencilBits)
+{
+    m_iWidth = iWidth;
+    m_iHeight = iHeight;
+    m_iDepthBits = iDepthBits;
+    m_iStencilBits = iStencilBits;
+    m_aiViewport[0] = 0;
+    m_aiViewport[1] = 0;
+    m_aiViewport[2] = iWidth;
+    m_aiViewport[3] = iHeight;
+    m_aiScissor[0] = 0;
+    m_aiScissor[1] = 0;
+    m_aiScissor[2] = iWidth;
+    m_aiScissor[3] = iHeight;
+}
+//----------------------------------------------------------------------------
+void GLRecorder::Reset ()
+{
+    int i, j;
+
+    m_iCallQuantity = 0;
+    m_iErrorQuantity = 0;
+    m_iFrameQuantity = 0;
+    m_eError = GL_NO_ERROR;
+
+    // objects
+    unsigned int uiName;
+    TextureObject** ppkTexture = m_kTextures.GetFirst(&uiName);
+    while (ppkTexture)
+    {
+        WG_DELETE *ppkTexture;
+        ppkTexture = m_kTextures.GetNext(&uiName);
+    }
+    m_kTextures.RemoveAll();
+    BufferObject** ppkBuffer = m_kBuffers.GetFirst(&uiName);
+    while (ppkBuffer)
+    {
+        WG_DELETE *ppkBuffer;
+        ppkBuffer = m_kBuffers.GetNext(&uiName);
+    }
+    m_kBuffers.RemoveAll();
+    m_kDefaultTexture = TextureObject();
+    m_kDefaultTexture.Bound = true;
+    m_uiNextTexture = 1;
+    m_uiNextBuffer = 1;
+    m_iTextureBytes = 0;
+    m_iBufferBytes = 0;
+    m_uiArrayBuffer = 0;
+    m_uiElementBuffer = 0;
+
+    // capabilities, only dithering and multisampling are initially enabled
+    for (i = 0; i < CAP_QUANTITY; i++)
+    {
+        m_abCap[i] = (ms_aeCap[i] == GL_DITHER
+            || ms_aeCap[i] == GL_MULTISAMPLE);
+    }
+
+    // texture units
+    m_iActiveUnit = 0;
+    m_iClientActiveUnit = 0;
+    for (i = 0; i < MAX_TEXTURE_UNITS; i++)
+    {
+        UnitState& rkUnit = m_akUnit[i];
+        rkUnit.Enabled = false;
+        rkUnit.Texture = 0;
+        rkUnit.EnvMode = (float)GL_MODULATE;
+        for (j = 0; j < 4; j++)
+        {
+            rkUnit.EnvColor[j] = 0.0f;
+        }
+        rkUnit.CombineRGB = (float)GL_MODULATE;
+        rkUnit.CombineAlpha = (float)GL_MODULATE;
+        rkUnit.SrcRGB[0] = rkUnit.SrcAlpha[0] = (float)GL_TEXTURE;
+        rkUnit.SrcRGB[1] = rkUnit.SrcAlpha[1] = (float)GL_PREVIOUS;
+        rkUnit.SrcRGB[2] = rkUnit.SrcAlpha[2] = (float)GL_CONSTANT;
+        rkUnit.OperandRGB[0] = rkUnit.OperandRGB[1] = (float)GL_SRC_COLOR;
+        rkUnit.OperandRGB[2] = (float)GL_SRC_ALPHA;
+        for (j = 0; j < 3; j++)
+        {
+            rkUnit.OperandAlpha[j] = (float)GL_SRC_ALPHA;
+        }
+        rkUnit.RGBScale = 1.0f;
+        rkUnit.AlphaScale = 1.0f;
+        rkUnit.CoordReplace = 0.0f;
+        rkUnit.TexCoord[0] = 0.0f;
+        rkUnit.TexCoord[1] = 0.0f;
+        rkUnit.TexCoord[2] = 0.0f;
+        rkUnit.TexCoord[3] = 1.0f;
+        rkUnit.Texture2D.Depth = 1;
+        rkUnit.Texture2D.MaxDepth = MAX_TEXTURE_DEPTH;
+        System::Memcpy(rkUnit.Texture2D.Matrix[0],16*sizeof(float),
+            gs_afIdentity,16*sizeof(float));
+    }
+
+    // client arrays
+    for (i = 0; i < ARRAY_QUANTITY; i++)
+    {
+        ArrayState& rkArray = m_akArray[i];
+        rkArray.Enabled = false;
+        rkArray.Size = (i == ARRAY_NORMAL ? 3 :
+            (i == ARRAY_POINT_SIZE ? 1 : 4));
+        rkArray.Type = GL_FLOAT;
+        rkArray.Stride = 0;
+        rkArray.Pointer = 0;
+        rkArray.Buffer = 0;
+    }
+
+    // current values
+    for (j = 0; j < 4; j++)
+    {
+        m_afColor[j] = 1.0f;
+    }
+    m_afNormal[0] = 0.0f;
+    m_afNormal[1] = 0.0f;
+    m_afNormal[2] = 1.0f;
+
+    // matrices
+    m_eMatrixMode = GL_MODELVIEW;
+    m_kModelView.Depth = 1;
+    m_kModelView.MaxDepth = MAX_MODELVIEW_DEPTH;
+    System::Memcpy(m_kModelView.Matrix[0],16*sizeof(float),gs_afIdentity,
+        16*sizeof(float));
+    m_kProjection.Depth = 1;
+    m_kProjection.MaxDepth = MAX_PROJECTION_DEPTH;
+    System::Memcpy(m_kProjection.Matrix[0],16*sizeof(float),gs_afIdentity,
+        16*sizeof(float));
+
+    // lights, the first one is white
+    for (i = 0; i < MAX_LIGHTS; i++)
+    {
+        LightState& rkLight = m_akLight[i];
+        float fValue = (i == 0 ? 1.0f : 0.0f);
+        rkLight.Enabled = false;
+        for (j = 0; j < 3; j++)
+        {
+            rkLight.Ambient[j] = 0.0f;
+            rkLight.Diffuse[j] = fValue;
+            rkLight.Specular[j] = fValue;
+        }
+        rkLight.Ambient[3] = 1.0f;
+        rkLight.Diffuse[3] = 1.0f;
+        rkLight.Specular[3] = 1.0f;
+        rkLight.Position[0] = 0.0f;
+        rkLight.Position[1] = 0.0f;
+        rkLight.Position[2] = 1.0f;
+        rkLight.Position[3] = 0.0f;
+        rkLight.SpotDirection[0] = 0.0f;
+        rkLight.SpotDirection[1] = 0.0f;
+        rkLight.SpotDirection[2] = -1.0f;
+        rkLight.SpotExponent = 0.0f;
+        rkLight.SpotCutoff = 180.0f;
+        rkLight.Attenuation[0] = 1.0f;
+        rkLight.Attenuation[1] = 0.0f;
+        rkLight.Attenuation[2] = 0.0f;
+    }
+    for (j = 0; j < 3; j++)
+    {
+        m_afLightModelAmbient[j] = 0.2f;
+        m_afAmbient[j] = 0.2f;
+        m_afDiffuse[j] = 0.8f;
+        m_afSpecular[j] = 0.0f;
+        m_afEmission[j] = 0.0f;
+    }
+    m_afLightModelAmbient[3] = 1.0f;
+    m_afAmbient[3] = 1.0f;
+    m_afDiffuse[3] = 1.0f;
+    m_afSpecular[3] = 1.0f;
+    m_afEmission[3] = 1.0f;
+    m_fLightModelTwoSide = 0.0f;
+    m_fShininess = 0.0f;
+
+    // fog and clip planes
+    m_fFogMode = (float)GL_EXP;
+    m_fFogDensity = 1.0f;
+    m_fFogStart = 0.0f;
+    m_fFogEnd = 1.0f;
+    for (j = 0; j < 4; j++)
+    {
+        m_afFogColor[j] = 0.0f;
+    }
+    for (i = 0; i < MAX_CLIP_PLANES; i++)
+    {
+        for (j = 0; j < 4; j++)
+        {
+            m_aafClipPlane[i][j] = 0.0f;
+        }
+    }
+
+    // fragment operations
+    m_eAlphaFunc = GL_ALWAYS;
+    m_fAlphaRef = 0.0f;
+    m_eBlendSrc = GL_ONE;
+    m_eBlendDst = GL_ZERO;
+    for (j = 0; j < 4; j++)
+    {
+        m_abColorMask[j] = true;
+        m_afClearColor[j] = 0.0f;
+    }
+    m_eDepthFunc = GL_LESS;
+    m_bDepthMask = true;
+    m_afDepthRange[0] = 0.0f;
+    m_afDepthRange[1] = 1.0f;
+    m_eStencilFunc = GL_ALWAYS;
+    m_iStencilRef = 0;
+    m_uiStencilValueMask = ~0u;
+    m_uiStencilWriteMask = ~0u;
+    m_eStencilFail = GL_KEEP;
+    m_eStencilZFail = GL_KEEP;
+    m_eStencilZPass = GL_KEEP;
+    m_eLogicOp = GL_COPY;
+    m_fClearDepth = 1.0f;
+    m_iClearStencil = 0;
+    m_fSampleCoverage = 1.0f;
+    m_bSampleCoverageInvert = false;
+
+    // rasterization
+    m_fOffsetFactor = 0.0f;
+    m_fOffsetUnits = 0.0f;
+    m_fLineWidth = 1.0f;
+    m_fPointSize = 1.0f;
+    m_afPointSizeRange[0] = 0.0f;
+    m_afPointSizeRange[1] = 64.0f;
+    m_fPointFade = 1.0f;
+    m_afPointAttenuation[0] = 1.0f;
+    m_afPointAttenuation[1] = 0.0f;
+    m_afPointAttenuation[2] = 0.0f;
+    m_eCullFace = GL_BACK;
+    m_eFrontFace = GL_CCW;
+    m_eShadeModel = GL_SMOOTH;
+    m_ePerspectiveHint = GL_DONT_CARE;
+    m_ePointSmoothHint = GL_DONT_CARE;
+    m_eLineSmoothHint = GL_DONT_CARE;
+    m_eFogHint = GL_DONT_CARE;
+    m_eMipmapHint = GL_DONT_CARE;
+    m_iPackAlignment = 4;
+    m_iUnpackAlignment = 4;
+    SetFramebuffer(m_iWidth,m_iHeight,m_iDepthBits,m_iStencilBits);
+}
+//----------------------------------------------------------------------------
+// GLRecorder::Call
+//----------------------------------------------------------------------------
+GLRecorder::Call::Call (int eOpcode)
+    :
+    m_rkContext(GLRecorder::GetContext())
+{
+    m_dStart = (m_rkContext.m_kWriter.IsOpen() ?
+        System::GetPreciseTime() : 0.0);
+    m_iErrorQuantity = m_rkContext.m_iErrorQuantity;
+    m_kRecord.Opcode = eOpcode;
+}
+//----------------------------------------------------------------------------
+GLRecorder::Call::~Call ()
+{
+    // a call that failed changed nothing, but it is not redundant
+    if (m_rkContext.m_iErrorQuantity != m_iErrorQuantity)
+    {
+        m_kRecord.Flags |= GLTrace::FLAG_ERROR;
+        m_kRecord.Flags &= ~GLTrace::FLAG_REDUNDANT;
+    }
+
+    m_rkContext.m_iCallQuantity++;
+    if (m_rkContext.m_kWriter.IsOpen())
+    {
+        m_rkContext.Write(m_kRecord,m_dStart,System::GetPreciseTime());
+    }
+}
+//----------------------------------------------------------------------------
+void GLRecorder::Call::Words (int iQuantity, const void* pvWords)
+{
+    const unsigned int* auiWord = (const unsigned int*)pvWords;
+    for (int i = 0; i < iQuantity; i++)
+    {
+        Word(auiWord[i]);
+    }
+}
+//----------------------------------------------------------------------------
+// errors and capabilities
+//----------------------------------------------------------------------------
+void GLRecorder::SetError (GLenum eError)
+{
+    // the first error is kept until it is queried
+    m_iErrorQuantity++;
+    if (m_eError == GL_NO_ERROR)
+    {
+        m_eError = eError;
+    }
+}
+//----------------------------------------------------------------------------
+GLenum GLRecorder::GetError ()
+{
+    GLenum eError = m_eError;
+    m_eError = GL_NO_ERROR;
+    return eError;
+}
+//----------------------------------------------------------------------------
+bool* GLRecorder::GetCapability (GLenum eCap)
+{
+    if (eCap == GL_TEXTURE_2D)
+    {
+        return &m_akUnit[m_iActiveUnit].Enabled;
+    }
+    if (GL_LIGHT0 <= eCap && eCap < GL_LIGHT0 + MAX_LIGHTS)
+    {
+        return &m_akLight[eCap - GL_LIGHT0].Enabled;
+    }
+    for (int i = 0; i < CAP_QUANTITY; i++)
+    {
+        if (ms_aeCap[i] == eCap)
+        {
+            return &m_abCap[i];
+        }
+    }
+    return 0;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::SetCapability (GLenum eCap, bool bEnabled)
+{
+    bool* pbCap = GetCapability(eCap);
+    if (!pbCap)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+    if (*pbCap == bEnabled)
+    {
+        return false;
+    }
+    *pbCap = bEnabled;
+
+    // the color material tracks the current color from now on
+    if (eCap == GL_COLOR_MATERIAL && bEnabled)
+    {
+        SetValues(4,m_afAmbient,m_afColor);
+        SetValues(4,m_afDiffuse,m_afColor);
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::IsEnabled (GLenum eCap)
+{
+    switch (eCap)
+    {
+    case GL_VERTEX_ARRAY:
+        return m_akArray[ARRAY_VERTEX].Enabled;
+    case GL_NORMAL_ARRAY:
+        return m_akArray[ARRAY_NORMAL].Enabled;
+    case GL_COLOR_ARRAY:
+        return m_akArray[ARRAY_COLOR].Enabled;
+    case GL_POINT_SIZE_ARRAY_OES:
+        return m_akArray[ARRAY_POINT_SIZE].Enabled;
+    case GL_TEXTURE_COORD_ARRAY:
+        return m_akArray[GetClientActiveArray()].Enabled;
+    }
+
+    bool* pbCap = GetCapability(eCap);
+    if (!pbCap)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+    return *pbCap;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::SetClientState (GLenum eArray, bool bEnabled)
+{
+    int iArray;
+    switch (eArray)
+    {
+    case GL_VERTEX_ARRAY:
+        iArray = ARRAY_VERTEX;
+        break;
+    case GL_NORMAL_ARRAY:
+        iArray = ARRAY_NORMAL;
+        break;
+    case GL_COLOR_ARRAY:
+        iArray = ARRAY_COLOR;
+        break;
+    case GL_POINT_SIZE_ARRAY_OES:
+        iArray = ARRAY_POINT_SIZE;
+        break;
+    case GL_TEXTURE_COORD_ARRAY:
+        iArray = GetClientActiveArray();
+        break;
+    default:
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    bool bChanged = (m_akArray[iArray].Enabled != bEnabled);
+    m_akArray[iArray].Enabled = bEnabled;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::ActiveTexture (GLenum eUnit)
+{
+    if (eUnit < GL_TEXTURE0 || eUnit >= GL_TEXTURE0 + MAX_TEXTURE_UNITS)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    int iUnit = (int)(eUnit - GL_TEXTURE0);
+    bool bChanged = (m_iActiveUnit != iUnit);
+    m_iActiveUnit = iUnit;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::ClientActiveTexture (GLenum eUnit)
+{
+    if (eUnit < GL_TEXTURE0 || eUnit >= GL_TEXTURE0 + MAX_TEXTURE_UNITS)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    int iUnit = (int)(eUnit - GL_TEXTURE0);
+    bool bChanged = (m_iClientActiveUnit != iUnit);
+    m_iClientActiveUnit = iUnit;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+// objects
+//----------------------------------------------------------------------------
+GLRecorder::TextureObject::TextureObject ()
+{
+    Bound = false;
+    for (int i = 0; i < MAX_TEXTURE_LEVELS; i++)
+    {
+        Format[i] = 0;
+        Width[i] = 0;
+        Height[i] = 0;
+        Bytes[i] = 0;
+    }
+    Compressed = false;
+    MinFilter = (float)GL_NEAREST_MIPMAP_LINEAR;
+    MagFilter = (float)GL_LINEAR;
+    WrapS = (float)GL_REPEAT;
+    WrapT = (float)GL_REPEAT;
+    GenerateMipmap = 0.0f;
+}
+//----------------------------------------------------------------------------
+GLRecorder::BufferObject::BufferObject ()
+{
+    Bound = false;
+    Size = 0;
+    Usage = GL_STATIC_DRAW;
+    Data = 0;
+}
+//----------------------------------------------------------------------------
+GLRecorder::BufferObject::~BufferObject ()
+{
+    WG_DELETE[] Data;
+}
+//----------------------------------------------------------------------------
+GLRecorder::TextureObject* GLRecorder::GetTextureObject (GLuint uiName)
+    const
+{
+    TextureObject** ppkTexture = m_kTextures.Find(uiName);
+    return (ppkTexture ? *ppkTexture : 0);
+}
+//----------------------------------------------------------------------------
+GLRecorder::BufferObject* GLRecorder::GetBufferObject (GLuint uiName) const
+{
+    BufferObject** ppkBuffer = m_kBuffers.Find(uiName);
+    return (ppkBuffer ? *ppkBuffer : 0);
+}
+//----------------------------------------------------------------------------
+GLRecorder::TextureObject* GLRecorder::GetTexture (GLenum eTarget)
+{
+    if (eTarget != GL_TEXTURE_2D)
+    {
+        return 0;
+    }
+
+    GLuint uiName = m_akUnit[m_iActiveUnit].Texture;
+    return (uiName ? GetTextureObject(uiName) : &m_kDefaultTexture);
+}
+//----------------------------------------------------------------------------
+GLRecorder::BufferObject* GLRecorder::GetBuffer (GLenum eTarget)
+{
+    GLuint uiName;
+    if (eTarget == GL_ARRAY_BUFFER)
+    {
+        uiName = m_uiArrayBuffer;
+    }
+    else if (eTarget == GL_ELEMENT_ARRAY_BUFFER)
+    {
+        uiName = m_uiElementBuffer;
+    }
+    else
+    {
+        return 0;
+    }
+    return (uiName ? GetBufferObject(uiName) : 0);
+}
+//----------------------------------------------------------------------------
+void GLRecorder::GenNames (bool bTexture, GLsizei iQuantity,
+    GLuint* auiName)
+{
+    if (iQuantity < 0)
+    {
+        SetError(GL_INVALID_VALUE);
+        return;
+    }
+
+    // The names are reserved, the objects exist once they are bound.
+    for (int i = 0; i < iQuantity; i++)
+    {
+        if (bTexture)
+        {
+            while (GetTextureObject(m_uiNextTexture))
+            {
+                m_uiNextTexture++;
+            }
+            m_kTextures.Insert(m_uiNextTexture,WG_NEW TextureObject);
+            auiName[i] = m_uiNextTexture++;
+        }
+        else
+        {
+            while (GetBufferObject(m_uiNextBuffer))
+            {
+                m_uiNextBuffer++;
+            }
+            m_kBuffers.Insert(m_uiNextBuffer,WG_NEW BufferObject);
+            auiName[i] = m_uiNextBuffer++;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void GLRecorder::DeleteNames (bool bTexture, GLsizei iQuantity,
+    const GLuint* auiName)
+{
+    if (iQuantity < 0)
+    {
+        SetError(GL_INVALID_VALUE);
+        return;
+    }
+
+    int i, j;
+    for (i = 0; i < iQuantity; i++)
+    {
+        // unused names and zero are silently ignored
+        GLuint uiName = auiName[i];
+        if (uiName == 0)
+        {
+            continue;
+        }
+
+        if (bTexture)
+        {
+            TextureObject* pkTexture = GetTextureObject(uiName);
+            if (!pkTexture)
+            {
+                continue;
+            }
+
+            // the units that use the texture revert to the default one
+            for (j = 0; j < MAX_TEXTURE_UNITS; j++)
+            {
+                if (m_akUnit[j].Texture == uiName)
+                {
+                    m_akUnit[j].Texture = 0;
+                }
+            }
+            for (j = 0; j < MAX_TEXTURE_LEVELS; j++)
+            {
+                m_iTextureBytes -= pkTexture->Bytes[j];
+            }
+            WG_DELETE pkTexture;
+            m_kTextures.Remove(uiName);
+        }
+        else
+        {
+            BufferObject* pkBuffer = GetBufferObject(uiName);
+            if (!pkBuffer)
+            {
+                continue;
+            }
+
+            // the bindings of the buffer revert to zero
+            if (m_uiArrayBuffer == uiName)
+            {
+                m_uiArrayBuffer = 0;
+            }
+            if (m_uiElementBuffer == uiName)
+            {
+                m_uiElementBuffer = 0;
+            }
+            for (j = 0; j < ARRAY_QUANTITY; j++)
+            {
+                if (m_akArray[j].Buffer == uiName)
+                {
+                    m_akArray[j].Buffer = 0;
+                }
+            }
+            m_iBufferBytes -= pkBuffer->Size;
+            WG_DELETE pkBuffer;
+            m_kBuffers.Remove(uiName);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::IsName (bool bTexture, GLuint uiName) const
+{
+    if (bTexture)
+    {
+        TextureObject* pkTexture = GetTextureObject(uiName);
+        return pkTexture && pkTexture->Bound;
+    }
+
+    BufferObject* pkBuffer = GetBufferObject(uiName);
+    return pkBuffer && pkBuffer->Bound;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::BindTexture (GLenum eTarget, GLuint uiName)
+{
+    if (eTarget != GL_TEXTURE_2D)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    // binding a name that was not generated creates the object
+    if (uiName)
+    {
+        TextureObject* pkTexture = GetTextureObject(uiName);
+        if (!pkTexture)
+        {
+            pkTexture = WG_NEW TextureObject;
+            m_kTextures.Insert(uiName,pkTexture);
+        }
+        pkTexture->Bound = true;
+    }
+
+    UnitState& rkUnit = m_akUnit[m_iActiveUnit];
+    bool bChanged = (rkUnit.Texture != uiName);
+    rkUnit.Texture = uiName;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::BindBuffer (GLenum eTarget, GLuint uiName)
+{
+    GLuint* puiBinding;
+    if (eTarget == GL_ARRAY_BUFFER)
+    {
+        puiBinding = &m_uiArrayBuffer;
+    }
+    else if (eTarget == GL_ELEMENT_ARRAY_BUFFER)
+    {
+        puiBinding = &m_uiElementBuffer;
+    }
+    else
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    if (uiName)
+    {
+        BufferObject* pkBuffer = GetBufferObject(uiName);
+        if (!pkBuffer)
+        {
+            pkBuffer = WG_NEW BufferObject;
+            m_kBuffers.Insert(uiName,pkBuffer);
+        }
+        pkBuffer->Bound = true;
+    }
+
+    bool bChanged = (*puiBinding != uiName);
+    *puiBinding = uiName;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+// uploads
+//----------------------------------------------------------------------------
+bool GLRecorder::IsPowerOfTwo (int iValue)
+{
+    return (iValue & (iValue - 1)) == 0;
+}
+//----------------------------------------------------------------------------
+int GLRecorder::GetImageBytes (GLsizei iWidth, GLsizei iHeight,
+    GLenum eFormat, GLenum eType, int iAlignment)
+{
+    int iComponents;
+    switch (eFormat)
+    {
+    case GL_ALPHA:
+    case GL_LUMINANCE:
+        iComponents = 1;
+        break;
+    case GL_LUMINANCE_ALPHA:
+        iComponents = 2;
+        break;
+    case GL_RGB:
+        iComponents = 3;
+        break;
+    case GL_RGBA:
+        iComponents = 4;
+        break;
+    default:
+        SetError(GL_INVALID_ENUM);
+        return -1;
+    }
+
+    int iPixelBytes;
+    switch (eType)
+    {
+    case GL_UNSIGNED_BYTE:
+        iPixelBytes = iComponents;
+        break;
+    case GL_UNSIGNED_SHORT_5_6_5:
+        if (eFormat != GL_RGB)
+        {
+            SetError(GL_INVALID_OPERATION);
+            return -1;
+        }
+        iPixelBytes = 2;
+        break;
+    case GL_UNSIGNED_SHORT_4_4_4_4:
+    case GL_UNSIGNED_SHORT_5_5_5_1:
+        if (eFormat != GL_RGBA)
+        {
+            SetError(GL_INVALID_OPERATION);
+            return -1;
+        }
+        iPixelBytes = 2;
+        break;
+    default:
+        SetError(GL_INVALID_ENUM);
+        return -1;
+    }
+
+    if (iWidth == 0 || iHeight == 0)
+    {
+        return 0;
+    }
+
+    // the rows are padded to the alignment, except for the last one
+    int iRowBytes = iWidth*iPixelBytes;
+    int iStride = (iRowBytes + iAlignment - 1)/iAlignment*iAlignment;
+    return (iHeight - 1)*iStride + iRowBytes;
+}
+//----------------------------------------------------------------------------
+GLRecorder::TextureObject* GLRecorder::ValidateImage (GLenum eTarget,
+    GLint iLevel, GLsizei iWidth, GLsizei iHeight, GLint iBorder)
+{
+    TextureObject* pkTexture = GetTexture(eTarget);
+    if (!pkTexture)
+    {
+        SetError(GL_INVALID_ENUM);
+        return 0;
+    }
+
+    // OpenGL ES 1.1 has no borders and only power of two textures
+    if (iLevel < 0 || iLevel >= MAX_TEXTURE_LEVELS
+    ||  iWidth < 0 || iWidth > (MAX_TEXTURE_SIZE >> iLevel)
+    ||  iHeight < 0 || iHeight > (MAX_TEXTURE_SIZE >> iLevel)
+    ||  !IsPowerOfTwo(iWidth) || !IsPowerOfTwo(iHeight)
+    ||  iBorder != 0)
+    {
+        SetError(GL_INVALID_VALUE);
+        return 0;
+    }
+    return pkTexture;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::ValidateSubImage (TextureObject* pkTexture, GLint iLevel,
+    GLint iX, GLint iY, GLsizei iWidth, GLsizei iHeight, GLenum eFormat)
+{
+    if (iLevel < 0 || iLevel >= MAX_TEXTURE_LEVELS)
+    {
+        SetError(GL_INVALID_VALUE);
+        return false;
+    }
+    if (pkTexture->Format[iLevel] == 0 || pkTexture->Compressed)
+    {
+        SetError(GL_INVALID_OPERATION);
+        return false;
+    }
+    if (iX < 0 || iY < 0 || iWidth < 0 || iHeight < 0
+    ||  iX + iWidth > pkTexture->Width[iLevel]
+    ||  iY + iHeight > pkTexture->Height[iLevel])
+    {
+        SetError(GL_INVALID_VALUE);
+        return false;
+    }
+    if (eFormat && eFormat != pkTexture->Format[iLevel])
+    {
+        SetError(GL_INVALID_OPERATION);
+        return false;
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+void GLRecorder::SetImage (TextureObject* pkTexture, GLint iLevel,
+    GLenum eFormat, GLsizei iWidth, GLsizei iHeight, int iBytes,
+    bool bCompressed)
+{
+    // a compressed image replaces all the levels, an uncompressed one
+    // replaces the levels of a compressed texture
+    int i;
+    if (bCompressed || pkTexture->Compressed)
+    {
+        for (i = 0; i < MAX_TEXTURE_LEVELS; i++)
+        {
+            m_iTextureBytes -= pkTexture->Bytes[i];
+            pkTexture->Format[i] = 0;
+            pkTexture->Width[i] = 0;
+            pkTexture->Height[i] = 0;
+            pkTexture->Bytes[i] = 0;
+        }
+    }
+    pkTexture->Compressed = bCompressed;
+
+    m_iTextureBytes += iBytes - pkTexture->Bytes[iLevel];
+    pkTexture->Format[iLevel] = eFormat;
+    pkTexture->Width[iLevel] = iWidth;
+    pkTexture->Height[iLevel] = iHeight;
+    pkTexture->Bytes[iLevel] = iBytes;
+
+    // automatic mipmap generation builds the levels below level zero
+    if (iLevel == 0 && !bCompressed && pkTexture->GenerateMipmap != 0.0f)
+    {
+        int iPixelBytes = (iWidth && iHeight ? iBytes/(iWidth*iHeight) : 0);
+        for (i = 1; i < MAX_TEXTURE_LEVELS; i++)
+        {
+            iWidth = (iWidth > 1 ? iWidth/2 : 1);
+            iHeight = (iHeight > 1 ? iHeight/2 : 1);
+            bool bUsed = (pkTexture->Width[i-1] > 1
+                || pkTexture->Height[i-1] > 1);
+            int iLevelBytes = (bUsed ? iWidth*iHeight*iPixelBytes : 0);
+            m_iTextureBytes += iLevelBytes - pkTexture->Bytes[i];
+            pkTexture->Format[i] = (bUsed ? eFormat : 0);
+            pkTexture->Width[i] = (bUsed ? iWidth : 0);
+            pkTexture->Height[i] = (bUsed ? iHeight : 0);
+            pkTexture->Bytes[i] = iLevelBytes;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+int GLRecorder::TexImage2D (GLenum eTarget, GLint iLevel,
+    GLenum eInternalFormat, GLsizei iWidth, GLsizei iHeight, GLint iBorder,
+    GLenum eFormat, GLenum eType, const GLvoid* pvPixels)
+{
+    TextureObject* pkTexture = ValidateImage(eTarget,iLevel,iWidth,iHeight,
+        iBorder);
+    if (!pkTexture)
+    {
+        return 0;
+    }
+
+    int iBytes = GetImageBytes(iWidth,iHeight,eFormat,eType,
+        m_iUnpackAlignment);
+    if (iBytes < 0)
+    {
+        return 0;
+    }
+    if (eInternalFormat != eFormat)
+    {
+        // the internal format must be one of the formats, and equal to it
+        bool bFormat = (eInternalFormat == GL_ALPHA
+            || eInternalFormat == GL_LUMINANCE
+            || eInternalFormat == GL_LUMINANCE_ALPHA
+            || eInternalFormat == GL_RGB
+            || eInternalFormat == GL_RGBA);
+        SetError(bFormat ? GL_INVALID_OPERATION : GL_INVALID_VALUE);
+        return 0;
+    }
+
+    int iStorage = GetImageBytes(iWidth,iHeight,eFormat,eType,1);
+    SetImage(pkTexture,iLevel,eFormat,iWidth,iHeight,iStorage,false);
+    return (pvPixels ? iBytes : 0);
+}
+//----------------------------------------------------------------------------
+int GLRecorder::TexSubImage2D (GLenum eTarget, GLint iLevel, GLint iX,
+    GLint iY, GLsizei iWidth, GLsizei iHeight, GLenum eFormat, GLenum eType,
+    const GLvoid* pvPixels)
+{
+    TextureObject* pkTexture = GetTexture(eTarget);
+    if (!pkTexture)
+    {
+        SetError(GL_INVALID_ENUM);
+        return 0;
+    }
+
+    int iBytes = GetImageBytes(iWidth,iHeight,eFormat,eType,
+        m_iUnpackAlignment);
+    if (iBytes < 0
+    ||  !ValidateSubImage(pkTexture,iLevel,iX,iY,iWidth,iHeight,eFormat))
+    {
+        return 0;
+    }
+    return (pvPixels ? iBytes : 0);
+}
+//----------------------------------------------------------------------------
+int GLRecorder::CompressedTexImage2D (GLenum eTarget, GLint iLevel,
+    GLenum eInternalFormat, GLsizei iWidth, GLsizei iHeight, GLint iBorder,
+    GLsizei iBytes, const GLvoid* pvData)
+{
+    // The paletted formats are the only compressed formats.  A level -n
+    // means that the data has the levels 0 through n.
+    int iEntryBytes;
+    switch (eInternalFormat)
+    {
+    case GL_PALETTE4_RGB8_OES:
+    case GL_PALETTE8_RGB8_OES:
+        iEntryBytes = 3;
+        break;
+    case GL_PALETTE4_RGBA8_OES:
+    case GL_PALETTE8_RGBA8_OES:
+        iEntryBytes = 4;
+        break;
+    case GL_PALETTE4_R5_G6_B5_OES:
+    case GL_PALETTE4_RGBA4_OES:
+    case GL_PALETTE4_RGB5_A1_OES:
+    case GL_PALETTE8_R5_G6_B5_OES:
+    case GL_PALETTE8_RGBA4_OES:
+    case GL_PALETTE8_RGB5_A1_OES:
+        iEntryBytes = 2;
+        break;
+    default:
+        SetError(GL_INVALID_ENUM);
+        return 0;
+    }
+
+    TextureObject* pkTexture = ValidateImage(eTarget,0,iWidth,iHeight,
+        iBorder);
+    if (!pkTexture)
+    {
+        return 0;
+    }
+    if (iLevel > 0 || -iLevel >= MAX_TEXTURE_LEVELS || iBytes < 0)
+    {
+        SetError(GL_INVALID_VALUE);
+        return 0;
+    }
+
+    bool bPalette4 = (eInternalFormat <= GL_PALETTE4_RGB5_A1_OES);
+    int iExpected = (bPalette4 ? 16 : 256)*iEntryBytes;
+    int iLevelWidth = iWidth, iLevelHeight = iHeight;
+    for (int i = 0; i <= -iLevel; i++)
+    {
+        int iTexels = iLevelWidth*iLevelHeight;
+        iExpected += (bPalette4 ? (iTexels + 1)/2 : iTexels);
+        iLevelWidth = (iLevelWidth > 1 ? iLevelWidth/2 : 1);
+        iLevelHeight = (iLevelHeight > 1 ? iLevelHeight/2 : 1);
+    }
+    if (iBytes != iExpected)
+    {
+        SetError(GL_INVALID_VALUE);
+        return 0;
+    }
+
+    SetImage(pkTexture,0,eInternalFormat,iWidth,iHeight,iBytes,true);
+    return (pvData ? iBytes : 0);
+}
+//----------------------------------------------------------------------------
+int GLRecorder::CompressedTexSubImage2D (GLenum eTarget, GLint, GLint,
+    GLint, GLsizei, GLsizei, GLenum, GLsizei, const GLvoid*)
+{
+    // paletted textures cannot be modified
+    if (eTarget != GL_TEXTURE_2D)
+    {
+        SetError(GL_INVALID_ENUM);
+        return 0;
+    }
+    SetError(GL_INVALID_OPERATION);
+    return 0;
+}
+//----------------------------------------------------------------------------
+int GLRecorder::BufferData (GLenum eTarget, GLsizeiptr iBytes,
+    const GLvoid* pvData, GLenum eUsage)
+{
+    if ((eTarget != GL_ARRAY_BUFFER && eTarget != GL_ELEMENT_ARRAY_BUFFER)
+    ||  (eUsage != GL_STATIC_DRAW && eUsage != GL_DYNAMIC_DRAW))
+    {
+        SetError(GL_INVALID_ENUM);
+        return 0;
+    }
+    if (iBytes < 0)
+    {
+        SetError(GL_INVALID_VALUE);
+        return 0;
+    }
+    BufferObject* pkBuffer = GetBuffer(eTarget);
+    if (!pkBuffer)
+    {
+        SetError(GL_INVALID_OPERATION);
+        return 0;
+    }
+
+    WG_DELETE[] pkBuffer->Data;
+    pkBuffer->Data = WG_NEW unsigned char[iBytes > 0 ? iBytes : 1];
+    if (pvData && iBytes > 0)
+    {
+        System::Memcpy(pkBuffer->Data,(size_t)iBytes,pvData,(size_t)iBytes);
+    }
+    else
+    {
+        memset(pkBuffer->Data,0,(size_t)(iBytes > 0 ? iBytes : 1));
+    }
+    m_iBufferBytes += iBytes - pkBuffer->Size;
+    pkBuffer->Size = iBytes;
+    pkBuffer->Usage = eUsage;
+    return (pvData ? iBytes : 0);
+}
+//----------------------------------------------------------------------------
+int GLRecorder::BufferSubData (GLenum eTarget, GLintptr iOffset,
+    GLsizeiptr iBytes, const GLvoid* pvData)
+{
+    if (eTarget != GL_ARRAY_BUFFER && eTarget != GL_ELEMENT_ARRAY_BUFFER)
+    {
+        SetError(GL_INVALID_ENUM);
+        return 0;
+    }
+    BufferObject* pkBuffer = GetBuffer(eTarget);
+    if (!pkBuffer)
+    {
+        SetError(GL_INVALID_OPERATION);
+        return 0;
+    }
+    if (iOffset < 0 || iBytes < 0 || iOffset + iBytes > pkBuffer->Size)
+    {
+        SetError(GL_INVALID_VALUE);
+        return 0;
+    }
+
+    if (pvData && iBytes > 0)
+    {
+        System::Memcpy(pkBuffer->Data + iOffset,(size_t)iBytes,pvData,
+            (size_t)iBytes);
+    }
+    return (pvData ? iBytes : 0);
+}
+//----------------------------------------------------------------------------
+// framebuffer operations
+//----------------------------------------------------------------------------
+int GLRecorder::CopyTexImage2D (GLenum eTarget, GLint iLevel,
+    GLenum eInternalFormat, GLint, GLint, GLsizei iWidth, GLsizei iHeight,
+    GLint iBorder)
+{
+    TextureObject* pkTexture = ValidateImage(eTarget,iLevel,iWidth,iHeight,
+        iBorder);
+    if (!pkTexture)
+    {
+        return 0;
+    }
+
+    int iBytes = GetImageBytes(iWidth,iHeight,eInternalFormat,
+        GL_UNSIGNED_BYTE,1);
+    if (iBytes < 0)
+    {
+        return 0;
+    }
+    SetImage(pkTexture,iLevel,eInternalFormat,iWidth,iHeight,iBytes,false);
+    return iBytes;
+}
+//----------------------------------------------------------------------------
+int GLRecorder::CopyTexSubImage2D (GLenum eTarget, GLint iLevel,
+    GLint iXOffset, GLint iYOffset, GLint, GLint, GLsizei iWidth,
+    GLsizei iHeight)
+{
+    TextureObject* pkTexture = GetTexture(eTarget);
+    if (!pkTexture)
+    {
+        SetError(GL_INVALID_ENUM);
+        return 0;
+    }
+    if (!ValidateSubImage(pkTexture,iLevel,iXOffset,iYOffset,iWidth,
+        iHeight,0))
+    {
+        return 0;
+    }
+    return GetImageBytes(iWidth,iHeight,pkTexture->Format[iLevel],
+        GL_UNSIGNED_BYTE,1);
+}
+//----------------------------------------------------------------------------
+int GLRecorder::ReadPixels (GLint, GLint, GLsizei iWidth, GLsizei iHeight,
+    GLenum eFormat, GLenum eType, GLvoid* pvPixels)
+{
+    if (iWidth < 0 || iHeight < 0)
+    {
+        SetError(GL_INVALID_VALUE);
+        return 0;
+    }
+
+    int iBytes = GetImageBytes(iWidth,iHeight,eFormat,eType,
+        m_iPackAlignment);
+    if (iBytes < 0)
+    {
+        return 0;
+    }
+
+    // RGBA with bytes, and the implementation read format
+    if (!(eFormat == GL_RGBA && eType == GL_UNSIGNED_BYTE)
+    &&  !(eFormat == GL_RGB && eType == GL_UNSIGNED_SHORT_5_6_5))
+    {
+        SetError(GL_INVALID_OPERATION);
+        return 0;
+    }
+
+    // nothing is rasterized, the framebuffer reads as zero
+    if (pvPixels && iBytes > 0)
+    {
+        memset(pvPixels,0,(size_t)iBytes);
+    }
+    return iBytes;
+}
+//----------------------------------------------------------------------------
+void GLRecorder::Clear (GLbitfield uiMask)
+{
+    if (uiMask & ~(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT
+        | GL_STENCIL_BUFFER_BIT))
+    {
+        SetError(GL_INVALID_VALUE);
+    }
+}
+//----------------------------------------------------------------------------
+// parameters
+//----------------------------------------------------------------------------
+bool GLRecorder::SetValue (float& rfState, float fValue)
+{
+    bool bChanged = (rfState != fValue);
+    rfState = fValue;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::SetValues (int iQuantity, float* afState,
+    const float* afValue)
+{
+    bool bChanged = false;
+    for (int i = 0; i < iQuantity; i++)
+    {
+        bChanged = bChanged || afState[i] != afValue[i];
+        afState[i] = afValue[i];
+    }
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::IsEnumParameter (GLenum ePName)
+{
+    switch (ePName)
+    {
+    case GL_TEXTURE_ENV_MODE:
+    case GL_COMBINE_RGB:
+    case GL_COMBINE_ALPHA:
+    case GL_SRC0_RGB:
+    case GL_SRC1_RGB:
+    case GL_SRC2_RGB:
+    case GL_SRC0_ALPHA:
+    case GL_SRC1_ALPHA:
+    case GL_SRC2_ALPHA:
+    case GL_OPERAND0_RGB:
+    case GL_OPERAND1_RGB:
+    case GL_OPERAND2_RGB:
+    case GL_OPERAND0_ALPHA:
+    case GL_OPERAND1_ALPHA:
+    case GL_OPERAND2_ALPHA:
+    case GL_TEXTURE_MIN_FILTER:
+    case GL_TEXTURE_MAG_FILTER:
+    case GL_TEXTURE_WRAP_S:
+    case GL_TEXTURE_WRAP_T:
+    case GL_FOG_MODE:
+        return true;
+    }
+    return false;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::TexParameter (GLenum eTarget, GLenum ePName, float fParam)
+{
+    TextureObject* pkTexture = GetTexture(eTarget);
+    if (!pkTexture)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    GLenum eParam = (GLenum)fParam;
+    switch (ePName)
+    {
+    case GL_TEXTURE_MIN_FILTER:
+        if (eParam != GL_NEAREST && eParam != GL_LINEAR
+        &&  eParam != GL_NEAREST_MIPMAP_NEAREST
+        &&  eParam != GL_LINEAR_MIPMAP_NEAREST
+        &&  eParam != GL_NEAREST_MIPMAP_LINEAR
+        &&  eParam != GL_LINEAR_MIPMAP_LINEAR)
+        {
+            break;
+        }
+        return SetValue(pkTexture->MinFilter,fParam);
+    case GL_TEXTURE_MAG_FILTER:
+        if (eParam != GL_NEAREST && eParam != GL_LINEAR)
+        {
+            break;
+        }
+        return SetValue(pkTexture->MagFilter,fParam);
+    case GL_TEXTURE_WRAP_S:
+    case GL_TEXTURE_WRAP_T:
+        if (eParam != GL_REPEAT && eParam != GL_CLAMP_TO_EDGE)
+        {
+            break;
+        }
+        return SetValue(ePName == GL_TEXTURE_WRAP_S ? pkTexture->WrapS :
+            pkTexture->WrapT,fParam);
+    case GL_GENERATE_MIPMAP:
+        return SetValue(pkTexture->GenerateMipmap,
+            (fParam != 0.0f ? 1.0f : 0.0f));
+    }
+
+    SetError(GL_INVALID_ENUM);
+    return false;
+}
+//----------------------------------------------------------------------------
+int GLRecorder::GetTexEnvQuantity (GLenum ePName)
+{
+    if (ePName == GL_TEXTURE_ENV_COLOR)
+    {
+        return 4;
+    }
+    if (ePName == GL_COORD_REPLACE_OES || ePName == GL_RGB_SCALE
+    ||  ePName == GL_ALPHA_SCALE || IsEnumParameter(ePName))
+    {
+        return 1;
+    }
+    return 0;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::TexEnv (GLenum eTarget, GLenum ePName,
+    const float* afParam)
+{
+    UnitState& rkUnit = m_akUnit[m_iActiveUnit];
+    if (eTarget == GL_POINT_SPRITE_OES && ePName == GL_COORD_REPLACE_OES)
+    {
+        return SetValue(rkUnit.CoordReplace,
+            (afParam[0] != 0.0f ? 1.0f : 0.0f));
+    }
+    if (eTarget != GL_TEXTURE_ENV)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    GLenum eParam = (GLenum)afParam[0];
+    int i;
+    switch (ePName)
+    {
+    case GL_TEXTURE_ENV_MODE:
+        if (eParam != GL_MODULATE && eParam != GL_DECAL
+        &&  eParam != GL_BLEND && eParam != GL_ADD
+        &&  eParam != GL_REPLACE && eParam != GL_COMBINE)
+        {
+            break;
+        }
+        return SetValue(rkUnit.EnvMode,afParam[0]);
+    case GL_TEXTURE_ENV_COLOR:
+    {
+        float afColor[4];
+        for (i = 0; i < 4; i++)
+        {
+            afColor[i] = (afParam[i] < 0.0f ? 0.0f :
+                (afParam[i] > 1.0f ? 1.0f : afParam[i]));
+        }
+        return SetValues(4,rkUnit.EnvColor,afColor);
+    }
+    case GL_COMBINE_RGB:
+    case GL_COMBINE_ALPHA:
+        if (eParam != GL_REPLACE && eParam != GL_MODULATE
+        &&  eParam != GL_ADD && eParam != GL_ADD_SIGNED
+        &&  eParam != GL_INTERPOLATE && eParam != GL_SUBTRACT
+        &&  (ePName == GL_COMBINE_ALPHA
+            || (eParam != GL_DOT3_RGB && eParam != GL_DOT3_RGBA)))
+        {
+            break;
+        }
+        return SetValue(ePName == GL_COMBINE_RGB ? rkUnit.CombineRGB :
+            rkUnit.CombineAlpha,afParam[0]);
+    case GL_SRC0_RGB:
+    case GL_SRC1_RGB:
+    case GL_SRC2_RGB:
+    case GL_SRC0_ALPHA:
+    case GL_SRC1_ALPHA:
+    case GL_SRC2_ALPHA:
+        if (eParam != GL_TEXTURE && eParam != GL_CONSTANT
+        &&  eParam != GL_PRIMARY_COLOR && eParam != GL_PREVIOUS)
+        {
+            break;
+        }
+        if (ePName <= GL_SRC2_RGB)
+        {
+            return SetValue(rkUnit.SrcRGB[ePName-GL_SRC0_RGB],afParam[0]);
+        }
+        return SetValue(rkUnit.SrcAlpha[ePName-GL_SRC0_ALPHA],afParam[0]);
+    case GL_OPERAND0_RGB:
+    case GL_OPERAND1_RGB:
+    case GL_OPERAND2_RGB:
+        if (eParam != GL_SRC_COLOR && eParam != GL_ONE_MINUS_SRC_COLOR
+        &&  eParam != GL_SRC_ALPHA && eParam != GL_ONE_MINUS_SRC_ALPHA)
+        {
+            break;
+        }
+        return SetValue(rkUnit.OperandRGB[ePName-GL_OPERAND0_RGB],
+            afParam[0]);
+    case GL_OPERAND0_ALPHA:
+    case GL_OPERAND1_ALPHA:
+    case GL_OPERAND2_ALPHA:
+        if (eParam != GL_SRC_ALPHA && eParam != GL_ONE_MINUS_SRC_ALPHA)
+        {
+            break;
+        }
+        return SetValue(rkUnit.OperandAlpha[ePName-GL_OPERAND0_ALPHA],
+            afParam[0]);
+    case GL_RGB_SCALE:
+    case GL_ALPHA_SCALE:
+        if (afParam[0] != 1.0f && afParam[0] != 2.0f && afParam[0] != 4.0f)
+        {
+            SetError(GL_INVALID_VALUE);
+            return false;
+        }
+        return SetValue(ePName == GL_RGB_SCALE ? rkUnit.RGBScale :
+            rkUnit.AlphaScale,afParam[0]);
+    }
+
+    SetError(GL_INVALID_ENUM);
+    return false;
+}
+//----------------------------------------------------------------------------
+int GLRecorder::GetLightQuantity (GLenum ePName)
+{
+    switch (ePName)
+    {
+    case GL_AMBIENT:
+    case GL_DIFFUSE:
+    case GL_SPECULAR:
+    case GL_POSITION:
+        return 4;
+    case GL_SPOT_DIRECTION:
+        return 3;
+    case GL_SPOT_EXPONENT:
+    case GL_SPOT_CUTOFF:
+    case GL_CONSTANT_ATTENUATION:
+    case GL_LINEAR_ATTENUATION:
+    case GL_QUADRATIC_ATTENUATION:
+        return 1;
+    }
+    return 0;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::Light (GLenum eLight, GLenum ePName, const float* afParam)
+{
+    if (eLight < GL_LIGHT0 || eLight >= GL_LIGHT0 + MAX_LIGHTS
+    ||  GetLightQuantity(ePName) == 0)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    // positions and directions are stored in eye coordinates
+    LightState& rkLight = m_akLight[eLight - GL_LIGHT0];
+    const float* afM = m_kModelView.Matrix[m_kModelView.Depth-1];
+    float afEye[4];
+    int iRow;
+    switch (ePName)
+    {
+    case GL_AMBIENT:
+        return SetValues(4,rkLight.Ambient,afParam);
+    case GL_DIFFUSE:
+        return SetValues(4,rkLight.Diffuse,afParam);
+    case GL_SPECULAR:
+        return SetValues(4,rkLight.Specular,afParam);
+    case GL_POSITION:
+        for (iRow = 0; iRow < 4; iRow++)
+        {
+            afEye[iRow] = afM[iRow]*afParam[0] + afM[4+iRow]*afParam[1] +
+                afM[8+iRow]*afParam[2] + afM[12+iRow]*afParam[3];
+        }
+        return SetValues(4,rkLight.Position,afEye);
+    case GL_SPOT_DIRECTION:
+        for (iRow = 0; iRow < 3; iRow++)
+        {
+            afEye[iRow] = afM[iRow]*afParam[0] + afM[4+iRow]*afParam[1] +
+                afM[8+iRow]*afParam[2];
+        }
+        return SetValues(3,rkLight.SpotDirection,afEye);
+    case GL_SPOT_EXPONENT:
+        if (afParam[0] < 0.0f || afParam[0] > 128.0f)
+        {
+            break;
+        }
+        return SetValue(rkLight.SpotExponent,afParam[0]);
+    case GL_SPOT_CUTOFF:
+        if ((afParam[0] < 0.0f || afParam[0] > 90.0f)
+        &&  afParam[0] != 180.0f)
+        {
+            break;
+        }
+        return SetValue(rkLight.SpotCutoff,afParam[0]);
+    default:
+        if (afParam[0] < 0.0f)
+        {
+            break;
+        }
+        return SetValue(rkLight.Attenuation[ePName-GL_CONSTANT_ATTENUATION],
+            afParam[0]);
+    }
+
+    SetError(GL_INVALID_VALUE);
+    return false;
+}
+//----------------------------------------------------------------------------
+int GLRecorder::GetLightModelQuantity (GLenum ePName)
+{
+    if (ePName == GL_LIGHT_MODEL_AMBIENT)
+    {
+        return 4;
+    }
+    return (ePName == GL_LIGHT_MODEL_TWO_SIDE ? 1 : 0);
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::LightModel (GLenum ePName, const float* afParam)
+{
+    if (ePName == GL_LIGHT_MODEL_AMBIENT)
+    {
+        return SetValues(4,m_afLightModelAmbient,afParam);
+    }
+    if (ePName == GL_LIGHT_MODEL_TWO_SIDE)
+    {
+        return SetValue(m_fLightModelTwoSide,
+            (afParam[0] != 0.0f ? 1.0f : 0.0f));
+    }
+    SetError(GL_INVALID_ENUM);
+    return false;
+}
+//----------------------------------------------------------------------------
+int GLRecorder::GetMaterialQuantity (GLenum ePName)
+{
+    switch (ePName)
+    {
+    case GL_AMBIENT:
+    case GL_DIFFUSE:
+    case GL_SPECULAR:
+    case GL_EMISSION:
+    case GL_AMBIENT_AND_DIFFUSE:
+        return 4;
+    case GL_SHININESS:
+        return 1;
+    }
+    return 0;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::Material (GLenum eFace, GLenum ePName,
+    const float* afParam)
+{
+    // OpenGL ES has the same material for both faces
+    if (eFace != GL_FRONT_AND_BACK || GetMaterialQuantity(ePName) == 0)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    bool bChanged;
+    switch (ePName)
+    {
+    case GL_AMBIENT:
+        return SetValues(4,m_afAmbient,afParam);
+    case GL_DIFFUSE:
+        return SetValues(4,m_afDiffuse,afParam);
+    case GL_AMBIENT_AND_DIFFUSE:
+        bChanged = SetValues(4,m_afAmbient,afParam);
+        return SetValues(4,m_afDiffuse,afParam) || bChanged;
+    case GL_SPECULAR:
+        return SetValues(4,m_afSpecular,afParam);
+    case GL_EMISSION:
+        return SetValues(4,m_afEmission,afParam);
+    }
+
+    if (afParam[0] < 0.0f || afParam[0] > 128.0f)
+    {
+        SetError(GL_INVALID_VALUE);
+        return false;
+    }
+    return SetValue(m_fShininess,afParam[0]);
+}
+//----------------------------------------------------------------------------
+int GLRecorder::GetFogQuantity (GLenum ePName)
+{
+    switch (ePName)
+    {
+    case GL_FOG_COLOR:
+        return 4;
+    case GL_FOG_MODE:
+    case GL_FOG_DENSITY:
+    case GL_FOG_START:
+    case GL_FOG_END:
+        return 1;
+    }
+    return 0;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::Fog (GLenum ePName, const float* afParam)
+{
+    GLenum eMode;
+    switch (ePName)
+    {
+    case GL_FOG_MODE:
+        eMode = (GLenum)afParam[0];
+        if (eMode != GL_EXP && eMode != GL_EXP2 && eMode != GL_LINEAR)
+        {
+            SetError(GL_INVALID_ENUM);
+            return false;
+        }
+        return SetValue(m_fFogMode,afParam[0]);
+    case GL_FOG_DENSITY:
+        if (afParam[0] < 0.0f)
+        {
+            SetError(GL_INVALID_VALUE);
+            return false;
+        }
+        return SetValue(m_fFogDensity,afParam[0]);
+    case GL_FOG_START:
+        return SetValue(m_fFogStart,afParam[0]);
+    case GL_FOG_END:
+        return SetValue(m_fFogEnd,afParam[0]);
+    case GL_FOG_COLOR:
+    {
+        float afColor[4];
+        for (int i = 0; i < 4; i++)
+        {
+            afColor[i] = (afParam[i] < 0.0f ? 0.0f :
+                (afParam[i] > 1.0f ? 1.0f : afParam[i]));
+        }
+        return SetValues(4,m_afFogColor,afColor);
+    }
+    }
+
+    SetError(GL_INVALID_ENUM);
+    return false;
+}
+//----------------------------------------------------------------------------
+int GLRecorder::GetPointParameterQuantity (GLenum ePName)
+{
+    switch (ePName)
+    {
+    case GL_POINT_DISTANCE_ATTENUATION:
+        return 3;
+    case GL_POINT_SIZE_MIN:
+    case GL_POINT_SIZE_MAX:
+    case GL_POINT_FADE_THRESHOLD_SIZE:
+        return 1;
+    }
+    return 0;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::PointParameter (GLenum ePName, const float* afParam)
+{
+    if (GetPointParameterQuantity(ePName) == 0)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+    if (ePName == GL_POINT_DISTANCE_ATTENUATION)
+    {
+        return SetValues(3,m_afPointAttenuation,afParam);
+    }
+    if (afParam[0] < 0.0f)
+    {
+        SetError(GL_INVALID_VALUE);
+        return false;
+    }
+    if (ePName == GL_POINT_FADE_THRESHOLD_SIZE)
+    {
+        return SetValue(m_fPointFade,afParam[0]);
+    }
+    return SetValue(m_afPointSizeRange[ePName == GL_POINT_SIZE_MAX ? 1 : 0],
+        afParam[0]);
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::ClipPlane (GLenum ePlane, const float* afEquation)
+{
+    if (ePlane < GL_CLIP_PLANE0 || ePlane >= GL_CLIP_PLANE0 + MAX_CLIP_PLANES)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    // The plane is stored in eye coordinates, the equation times the
+    // inverse of the model view matrix.  Gauss-Jordan elimination with
+    // partial pivoting on the transpose solves M^T*p' = p.
+    const float* afM = m_kModelView.Matrix[m_kModelView.Depth-1];
+    double aadA[4][5];
+    int iRow, iCol, i;
+    for (iRow = 0; iRow < 4; iRow++)
+    {
+        for (iCol = 0; iCol < 4; iCol++)
+        {
+            aadA[iRow][iCol] = afM[4*iRow+iCol];
+        }
+        aadA[iRow][4] = afEquation[iRow];
+    }
+    for (iCol = 0; iCol < 4; iCol++)
+    {
+        int iPivot = iCol;
+        for (iRow = iCol+1; iRow < 4; iRow++)
+        {
+            if (fabs(aadA[iRow][iCol]) > fabs(aadA[iPivot][iCol]))
+            {
+                iPivot = iRow;
+            }
+        }
+        if (aadA[iPivot][iCol] == 0.0)
+        {
+            // a singular model view matrix leaves the plane untransformed
+            return SetValues(4,m_aafClipPlane[ePlane-GL_CLIP_PLANE0],
+                afEquation);
+        }
+        for (i = 0; i < 5; i++)
+        {
+            double dSave = aadA[iCol][i];
+            aadA[iCol][i] = aadA[iPivot][i];
+            aadA[iPivot][i] = dSave;
+        }
+        for (iRow = 0; iRow < 4; iRow++)
+        {
+            if (iRow != iCol)
+            {
+                double dFactor = aadA[iRow][iCol]/aadA[iCol][iCol];
+                for (i = iCol; i < 5; i++)
+                {
+                    aadA[iRow][i] -= dFactor*aadA[iCol][i];
+                }
+            }
+        }
+    }
+
+    float afEye[4];
+    for (iRow = 0; iRow < 4; iRow++)
+    {
+        afEye[iRow] = (float)(aadA[iRow][4]/aadA[iRow][iRow]);
+    }
+    return SetValues(4,m_aafClipPlane[ePlane-GL_CLIP_PLANE0],afEye);
+}
+//----------------------------------------------------------------------------
+// current values
+//----------------------------------------------------------------------------
+bool GLRecorder::Color (const float* afColor)
+{
+    bool bChanged = SetValues(4,m_afColor,afColor);
+    if (*GetCapability(GL_COLOR_MATERIAL))
+    {
+        SetValues(4,m_afAmbient,afColor);
+        SetValues(4,m_afDiffuse,afColor);
+    }
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::Normal (const float* afNormal)
+{
+    return SetValues(3,m_afNormal,afNormal);
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::MultiTexCoord (GLenum eTarget, const float* afCoord)
+{
+    if (eTarget < GL_TEXTURE0 || eTarget >= GL_TEXTURE0 + MAX_TEXTURE_UNITS)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+    return SetValues(4,m_akUnit[eTarget-GL_TEXTURE0].TexCoord,afCoord);
+}
+//----------------------------------------------------------------------------
+// fragment and rasterization state
+//----------------------------------------------------------------------------
+bool GLRecorder::IsCompareFunc (GLenum eFunc)
+{
+    return GL_NEVER <= eFunc && eFunc <= GL_ALWAYS;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::AlphaFunc (GLenum eFunc, float fRef)
+{
+    if (!IsCompareFunc(eFunc))
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    fRef = (fRef < 0.0f ? 0.0f : (fRef > 1.0f ? 1.0f : fRef));
+    bool bChanged = (m_eAlphaFunc != eFunc || m_fAlphaRef != fRef);
+    m_eAlphaFunc = eFunc;
+    m_fAlphaRef = fRef;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::BlendFunc (GLenum eSrc, GLenum eDst)
+{
+    bool bSrc = (eSrc == GL_ZERO || eSrc == GL_ONE
+        || (GL_SRC_ALPHA <= eSrc && eSrc <= GL_SRC_ALPHA_SATURATE));
+    bool bDst = (eDst == GL_ZERO || eDst == GL_ONE
+        || (GL_SRC_COLOR <= eDst && eDst <= GL_ONE_MINUS_DST_ALPHA));
+    if (!bSrc || !bDst)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    bool bChanged = (m_eBlendSrc != eSrc || m_eBlendDst != eDst);
+    m_eBlendSrc = eSrc;
+    m_eBlendDst = eDst;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::ColorMask (bool bRed, bool bGreen, bool bBlue, bool bAlpha)
+{
+    bool bChanged = (m_abColorMask[0] != bRed || m_abColorMask[1] != bGreen
+        || m_abColorMask[2] != bBlue || m_abColorMask[3] != bAlpha);
+    m_abColorMask[0] = bRed;
+    m_abColorMask[1] = bGreen;
+    m_abColorMask[2] = bBlue;
+    m_abColorMask[3] = bAlpha;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::DepthFunc (GLenum eFunc)
+{
+    if (!IsCompareFunc(eFunc))
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    bool bChanged = (m_eDepthFunc != eFunc);
+    m_eDepthFunc = eFunc;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::DepthMask (bool bMask)
+{
+    bool bChanged = (m_bDepthMask != bMask);
+    m_bDepthMask = bMask;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::DepthRange (float fNear, float fFar)
+{
+    float afRange[2];
+    afRange[0] = (fNear < 0.0f ? 0.0f : (fNear > 1.0f ? 1.0f : fNear));
+    afRange[1] = (fFar < 0.0f ? 0.0f : (fFar > 1.0f ? 1.0f : fFar));
+    return SetValues(2,m_afDepthRange,afRange);
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::StencilFunc (GLenum eFunc, GLint iRef, GLuint uiMask)
+{
+    if (!IsCompareFunc(eFunc))
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    // the reference is clamped to the range of the stencil buffer
+    GLint iMax = (m_iStencilBits < 31 ? (1 << m_iStencilBits) - 1 : 0x7FFFFFFF);
+    iRef = (iRef < 0 ? 0 : (iRef > iMax ? iMax : iRef));
+    bool bChanged = (m_eStencilFunc != eFunc || m_iStencilRef != iRef
+        || m_uiStencilValueMask != uiMask);
+    m_eStencilFunc = eFunc;
+    m_iStencilRef = iRef;
+    m_uiStencilValueMask = uiMask;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::StencilOp (GLenum eFail, GLenum eZFail, GLenum eZPass)
+{
+    GLenum aeOp[3] = { eFail, eZFail, eZPass };
+    for (int i = 0; i < 3; i++)
+    {
+        if (aeOp[i] != GL_KEEP && aeOp[i] != GL_ZERO && aeOp[i] != GL_REPLACE
+        &&  aeOp[i] != GL_INCR && aeOp[i] != GL_DECR && aeOp[i] != GL_INVERT)
+        {
+            SetError(GL_INVALID_ENUM);
+            return false;
+        }
+    }
+
+    bool bChanged = (m_eStencilFail != eFail || m_eStencilZFail != eZFail
+        || m_eStencilZPass != eZPass);
+    m_eStencilFail = eFail;
+    m_eStencilZFail = eZFail;
+    m_eStencilZPass = eZPass;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::StencilMask (GLuint uiMask)
+{
+    bool bChanged = (m_uiStencilWriteMask != uiMask);
+    m_uiStencilWriteMask = uiMask;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::LogicOp (GLenum eOp)
+{
+    if (eOp < GL_CLEAR || eOp > GL_SET)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    bool bChanged = (m_eLogicOp != eOp);
+    m_eLogicOp = eOp;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::ClearColor (const float* afColor)
+{
+    float afClamped[4];
+    for (int i = 0; i < 4; i++)
+    {
+        afClamped[i] = (afColor[i] < 0.0f ? 0.0f :
+            (afColor[i] > 1.0f ? 1.0f : afColor[i]));
+    }
+    return SetValues(4,m_afClearColor,afClamped);
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::ClearDepth (float fDepth)
+{
+    return SetValue(m_fClearDepth,
+        (fDepth < 0.0f ? 0.0f : (fDepth > 1.0f ? 1.0f : fDepth)));
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::ClearStencil (GLint iStencil)
+{
+    bool bChanged = (m_iClearStencil != iStencil);
+    m_iClearStencil = iStencil;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::SampleCoverage (float fValue, bool bInvert)
+{
+    fValue = (fValue < 0.0f ? 0.0f : (fValue > 1.0f ? 1.0f : fValue));
+    bool bChanged = (m_fSampleCoverage != fValue
+        || m_bSampleCoverageInvert != bInvert);
+    m_fSampleCoverage = fValue;
+    m_bSampleCoverageInvert = bInvert;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::PolygonOffset (float fFactor, float fUnits)
+{
+    bool bChanged = (m_fOffsetFactor != fFactor || m_fOffsetUnits != fUnits);
+    m_fOffsetFactor = fFactor;
+    m_fOffsetUnits = fUnits;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::LineWidth (float fWidth)
+{
+    if (fWidth <= 0.0f)
+    {
+        SetError(GL_INVALID_VALUE);
+        return false;
+    }
+    return SetValue(m_fLineWidth,fWidth);
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::PointSize (float fSize)
+{
+    if (fSize <= 0.0f)
+    {
+        SetError(GL_INVALID_VALUE);
+        return false;
+    }
+    return SetValue(m_fPointSize,fSize);
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::CullFace (GLenum eMode)
+{
+    if (eMode != GL_FRONT && eMode != GL_BACK && eMode != GL_FRONT_AND_BACK)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    bool bChanged = (m_eCullFace != eMode);
+    m_eCullFace = eMode;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::FrontFace (GLenum eMode)
+{
+    if (eMode != GL_CW && eMode != GL_CCW)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    bool bChanged = (m_eFrontFace != eMode);
+    m_eFrontFace = eMode;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::ShadeModel (GLenum eMode)
+{
+    if (eMode != GL_FLAT && eMode != GL_SMOOTH)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    bool bChanged = (m_eShadeModel != eMode);
+    m_eShadeModel = eMode;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::Hint (GLenum eTarget, GLenum eMode)
+{
+    GLenum* peHint;
+    switch (eTarget)
+    {
+    case GL_PERSPECTIVE_CORRECTION_HINT:
+        peHint = &m_ePerspectiveHint;
+        break;
+    case GL_POINT_SMOOTH_HINT:
+        peHint = &m_ePointSmoothHint;
+        break;
+    case GL_LINE_SMOOTH_HINT:
+        peHint = &m_eLineSmoothHint;
+        break;
+    case GL_FOG_HINT:
+        peHint = &m_eFogHint;
+        break;
+    case GL_GENERATE_MIPMAP_HINT:
+        peHint = &m_eMipmapHint;
+        break;
+    default:
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+    if (eMode != GL_FASTEST && eMode != GL_NICEST && eMode != GL_DONT_CARE)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    bool bChanged = (*peHint != eMode);
+    *peHint = eMode;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::PixelStore (GLenum ePName, GLint iParam)
+{
+    if (ePName != GL_PACK_ALIGNMENT && ePName != GL_UNPACK_ALIGNMENT)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+    if (iParam != 1 && iParam != 2 && iParam != 4 && iParam != 8)
+    {
+        SetError(GL_INVALID_VALUE);
+        return false;
+    }
+
+    GLint& riAlignment = (ePName == GL_PACK_ALIGNMENT ? m_iPackAlignment :
+        m_iUnpackAlignment);
+    bool bChanged = (riAlignment != iParam);
+    riAlignment = iParam;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::Viewport (GLint iX, GLint iY, GLsizei iWidth,
+    GLsizei iHeight)
+{
+    if (iWidth < 0 || iHeight < 0)
+    {
+        SetError(GL_INVALID_VALUE);
+        return false;
+    }
+
+    // the size is clamped to the maximum viewport dimensions
+    iWidth = (iWidth < MAX_VIEWPORT_SIZE ? iWidth : MAX_VIEWPORT_SIZE);
+    iHeight = (iHeight < MAX_VIEWPORT_SIZE ? iHeight : MAX_VIEWPORT_SIZE);
+    bool bChanged = (m_aiViewport[0] != iX || m_aiViewport[1] != iY
+        || m_aiViewport[2] != iWidth || m_aiViewport[3] != iHeight);
+    m_aiViewport[0] = iX;
+    m_aiViewport[1] = iY;
+    m_aiViewport[2] = iWidth;
+    m_aiViewport[3] = iHeight;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::Scissor (GLint iX, GLint iY, GLsizei iWidth,
+    GLsizei iHeight)
+{
+    if (iWidth < 0 || iHeight < 0)
+    {
+        SetError(GL_INVALID_VALUE);
+        return false;
+    }
+
+    bool bChanged = (m_aiScissor[0] != iX || m_aiScissor[1] != iY
+        || m_aiScissor[2] != iWidth || m_aiScissor[3] != iHeight);
+    m_aiScissor[0] = iX;
+    m_aiScissor[1] = iY;
+    m_aiScissor[2] = iWidth;
+    m_aiScissor[3] = iHeight;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+// client arrays
+//----------------------------------------------------------------------------
+bool GLRecorder::ArrayPointer (int iArray, GLint iSize, GLenum eType,
+    GLsizei iStride, const GLvoid* pvPointer)
+{
+    bool bSize, bType;
+    switch (iArray)
+    {
+    case ARRAY_NORMAL:
+        bSize = (iSize == 3);
+        bType = (eType == GL_BYTE || eType == GL_SHORT || eType == GL_FIXED
+            || eType == GL_FLOAT);
+        break;
+    case ARRAY_COLOR:
+        bSize = (iSize == 4);
+        bType = (eType == GL_UNSIGNED_BYTE || eType == GL_FIXED
+            || eType == GL_FLOAT);
+        break;
+    case ARRAY_POINT_SIZE:
+        bSize = (iSize == 1);
+        bType = (eType == GL_FIXED || eType == GL_FLOAT);
+        break;
+    default:
+        // vertices and texture coordinates
+        bSize = (2 <= iSize && iSize <= 4);
+        bType = (eType == GL_BYTE || eType == GL_SHORT || eType == GL_FIXED
+            || eType == GL_FLOAT);
+        break;
+    }
+    if (!bType)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+    if (!bSize || iStride < 0)
+    {
+        SetError(GL_INVALID_VALUE);
+        return false;
+    }
+
+    ArrayState& rkArray = m_akArray[iArray];
+    bool bChanged = (rkArray.Size != iSize || rkArray.Type != eType
+        || rkArray.Stride != iStride || rkArray.Pointer != pvPointer
+        || rkArray.Buffer != m_uiArrayBuffer);
+    rkArray.Size = iSize;
+    rkArray.Type = eType;
+    rkArray.Stride = iStride;
+    rkArray.Pointer = pvPointer;
+    rkArray.Buffer = m_uiArrayBuffer;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+// matrices
+//----------------------------------------------------------------------------
+GLRecorder::MatrixStack& GLRecorder::GetStack ()
+{
+    if (m_eMatrixMode == GL_PROJECTION)
+    {
+        return m_kProjection;
+    }
+    if (m_eMatrixMode == GL_TEXTURE)
+    {
+        return m_akUnit[m_iActiveUnit].Texture2D;
+    }
+    return m_kModelView;
+}
+//----------------------------------------------------------------------------
+float* GLRecorder::GetTop ()
+{
+    MatrixStack& rkStack = GetStack();
+    return rkStack.Matrix[rkStack.Depth-1];
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::SetTop (const float* afMatrix)
+{
+    return SetValues(16,GetTop(),afMatrix);
+}
+//----------------------------------------------------------------------------
+void GLRecorder::MultiplyTop (float* afTop, const float* afMatrix)
+{
+    // column major, top = top*matrix
+    float afProduct[16];
+    for (int iCol = 0; iCol < 4; iCol++)
+    {
+        for (int iRow = 0; iRow < 4; iRow++)
+        {
+            afProduct[4*iCol+iRow] =
+                afTop[iRow]*afMatrix[4*iCol] +
+                afTop[4+iRow]*afMatrix[4*iCol+1] +
+                afTop[8+iRow]*afMatrix[4*iCol+2] +
+                afTop[12+iRow]*afMatrix[4*iCol+3];
+        }
+    }
+    System::Memcpy(afTop,16*sizeof(float),afProduct,16*sizeof(float));
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::MatrixMode (GLenum eMode)
+{
+    if (eMode != GL_MODELVIEW && eMode != GL_PROJECTION
+    &&  eMode != GL_TEXTURE)
+    {
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    bool bChanged = (m_eMatrixMode != eMode);
+    m_eMatrixMode = eMode;
+    return bChanged;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::LoadMatrix (const float* afMatrix)
+{
+    return SetTop(afMatrix);
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::MultMatrix (const float* afMatrix)
+{
+    float afTop[16];
+    System::Memcpy(afTop,16*sizeof(float),GetTop(),16*sizeof(float));
+    MultiplyTop(afTop,afMatrix);
+    return SetTop(afTop);
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::PushMatrix ()
+{
+    MatrixStack& rkStack = GetStack();
+    if (rkStack.Depth == rkStack.MaxDepth)
+    {
+        SetError(GL_STACK_OVERFLOW);
+        return false;
+    }
+
+    System::Memcpy(rkStack.Matrix[rkStack.Depth],16*sizeof(float),
+        rkStack.Matrix[rkStack.Depth-1],16*sizeof(float));
+    rkStack.Depth++;
+    return true;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::PopMatrix ()
+{
+    MatrixStack& rkStack = GetStack();
+    if (rkStack.Depth == 1)
+    {
+        SetError(GL_STACK_UNDERFLOW);
+        return false;
+    }
+
+    rkStack.Depth--;
+    return true;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::Rotate (float fAngle, float fX, float fY, float fZ)
+{
+    float fLength = sqrtf(fX*fX + fY*fY + fZ*fZ);
+    if (fLength == 0.0f)
+    {
+        return false;
+    }
+    fX /= fLength;
+    fY /= fLength;
+    fZ /= fLength;
+
+    float fRadians = fAngle*3.14159265f/180.0f;
+    float fCos = cosf(fRadians), fSin = sinf(fRadians);
+    float fOmc = 1.0f - fCos;
+    float afRotate[16] =
+    {
+        fX*fX*fOmc + fCos,    fY*fX*fOmc + fZ*fSin, fX*fZ*fOmc - fY*fSin,
+        0.0f,
+        fX*fY*fOmc - fZ*fSin, fY*fY*fOmc + fCos,    fY*fZ*fOmc + fX*fSin,
+        0.0f,
+        fX*fZ*fOmc + fY*fSin, fY*fZ*fOmc - fX*fSin, fZ*fZ*fOmc + fCos,
+        0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f
+    };
+    return MultMatrix(afRotate);
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::Scale (float fX, float fY, float fZ)
+{
+    float afScale[16] =
+    {
+        fX, 0.0f, 0.0f, 0.0f,
+        0.0f, fY, 0.0f, 0.0f,
+        0.0f, 0.0f, fZ, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f
+    };
+    return MultMatrix(afScale);
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::Translate (float fX, float fY, float fZ)
+{
+    float afTranslate[16] =
+    {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        fX, fY, fZ, 1.0f
+    };
+    return MultMatrix(afTranslate);
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::Frustum (float fLeft, float fRight, float fBottom,
+    float fTop, float fNear, float fFar)
+{
+    if (fLeft == fRight || fBottom == fTop || fNear == fFar
+    ||  fNear <= 0.0f || fFar <= 0.0f)
+    {
+        SetError(GL_INVALID_VALUE);
+        return false;
+    }
+
+    float fInvW = 1.0f/(fRight - fLeft);
+    float fInvH = 1.0f/(fTop - fBottom);
+    float fInvD = 1.0f/(fFar - fNear);
+    float afFrustum[16] =
+    {
+        2.0f*fNear*fInvW, 0.0f, 0.0f, 0.0f,
+        0.0f, 2.0f*fNear*fInvH, 0.0f, 0.0f,
+        (fRight + fLeft)*fInvW, (fTop + fBottom)*fInvH,
+        -(fFar + fNear)*fInvD, -1.0f,
+        0.0f, 0.0f, -2.0f*fFar*fNear*fInvD, 0.0f
+    };
+    return MultMatrix(afFrustum);
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::Ortho (float fLeft, float fRight, float fBottom,
+    float fTop, float fNear, float fFar)
+{
+    if (fLeft == fRight || fBottom == fTop || fNear == fFar)
+    {
+        SetError(GL_INVALID_VALUE);
+        return false;
+    }
+
+    float fInvW = 1.0f/(fRight - fLeft);
+    float fInvH = 1.0f/(fTop - fBottom);
+    float fInvD = 1.0f/(fFar - fNear);
+    float afOrtho[16] =
+    {
+        2.0f*fInvW, 0.0f, 0.0f, 0.0f,
+        0.0f, 2.0f*fInvH, 0.0f, 0.0f,
+        0.0f, 0.0f, -2.0f*fInvD, 0.0f,
+        -(fRight + fLeft)*fInvW, -(fTop + fBottom)*fInvH,
+        -(fFar + fNear)*fInvD, 1.0f
+    };
+    return MultMatrix(afOrtho);
+}
+//----------------------------------------------------------------------------
+// draws
+//----------------------------------------------------------------------------
+bool GLRecorder::ReadArrays (int iMin, int iMax, int& riStreamed)
+{
+    bool bInRange = true;
+    for (int i = 0; i < ARRAY_QUANTITY; i++)
+    {
+        const ArrayState& rkArray = m_akArray[i];
+        if (!rkArray.Enabled)
+        {
+            continue;
+        }
+
+        int iTypeBytes;
+        switch (rkArray.Type)
+        {
+        case GL_BYTE:
+        case GL_UNSIGNED_BYTE:
+            iTypeBytes = 1;
+            break;
+        case GL_SHORT:
+            iTypeBytes = 2;
+            break;
+        default:
+            iTypeBytes = 4;
+            break;
+        }
+        int iElementBytes = rkArray.Size*iTypeBytes;
+        int iStride = (rkArray.Stride ? rkArray.Stride : iElementBytes);
+        int iBytes = (iMax - iMin)*iStride + iElementBytes;
+
+        if (rkArray.Buffer)
+        {
+            // the pointer is an offset into the buffer object
+            BufferObject* pkBuffer = GetBufferObject(rkArray.Buffer);
+            size_t uiEnd = (size_t)rkArray.Pointer + (size_t)iMax*iStride +
+                iElementBytes;
+            if (!pkBuffer || uiEnd > (size_t)pkBuffer->Size)
+            {
+                bInRange = false;
+            }
+        }
+        else
+        {
+            if (!rkArray.Pointer)
+            {
+                bInRange = false;
+            }
+            riStreamed += iBytes;
+        }
+    }
+    return bInRange;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::DrawArrays (GLenum eMode, GLint iFirst, GLsizei iCount,
+    int& riVertices, int& riStreamed)
+{
+    riVertices = 0;
+    riStreamed = 0;
+    if (eMode > GL_TRIANGLE_FAN)
+    {
+        SetError(GL_INVALID_ENUM);
+        return true;
+    }
+    if (iFirst < 0 || iCount < 0)
+    {
+        SetError(GL_INVALID_VALUE);
+        return true;
+    }
+
+    // nothing is drawn without vertices
+    if (iCount == 0 || !m_akArray[ARRAY_VERTEX].Enabled)
+    {
+        return true;
+    }
+
+    riVertices = iCount;
+    return ReadArrays(iFirst,iFirst+iCount-1,riStreamed);
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::DrawElements (GLenum eMode, GLsizei iCount, GLenum eType,
+    const GLvoid* pvIndices, int& riVertices, int& riStreamed)
+{
+    riVertices = 0;
+    riStreamed = 0;
+    if (eMode > GL_TRIANGLE_FAN
+    ||  (eType != GL_UNSIGNED_BYTE && eType != GL_UNSIGNED_SHORT))
+    {
+        SetError(GL_INVALID_ENUM);
+        return true;
+    }
+    if (iCount < 0)
+    {
+        SetError(GL_INVALID_VALUE);
+        return true;
+    }
+    if (iCount == 0 || !m_akArray[ARRAY_VERTEX].Enabled)
+    {
+        return true;
+    }
+
+    // the indices are in the element buffer or in client memory
+    int iIndexBytes = (eType == GL_UNSIGNED_BYTE ? 1 : 2);
+    const unsigned char* aucIndex;
+    if (m_uiElementBuffer)
+    {
+        BufferObject* pkBuffer = GetBufferObject(m_uiElementBuffer);
+        size_t uiOffset = (size_t)pvIndices;
+        if (!pkBuffer || uiOffset + (size_t)iCount*iIndexBytes >
+            (size_t)pkBuffer->Size)
+        {
+            return false;
+        }
+        aucIndex = pkBuffer->Data + uiOffset;
+    }
+    else
+    {
+        if (!pvIndices)
+        {
+            return false;
+        }
+        aucIndex = (const unsigned char*)pvIndices;
+        riStreamed += iCount*iIndexBytes;
+    }
+
+    int iMin = 0x7FFFFFFF, iMax = -1;
+    for (int i = 0; i < iCount; i++)
+    {
+        int iIndex = (eType == GL_UNSIGNED_BYTE ? aucIndex[i] :
+            ((const unsigned short*)aucIndex)[i]);
+        iMin = (iIndex < iMin ? iIndex : iMin);
+        iMax = (iIndex > iMax ? iIndex : iMax);
+    }
+
+    riVertices = iMax - iMin + 1;
+    return ReadArrays(iMin,iMax,riStreamed);
+}
+//----------------------------------------------------------------------------
+// queries
+//----------------------------------------------------------------------------
+int GLRecorder::GetValue (GLenum ePName, double* adValue, int& reKind)
+{
+    // values of a single kind are copied at the end
+    const float* afValue = 0;
+    int iQuantity = 1, i;
+    const ArrayState* pkArray = 0;
+    const MatrixStack* pkStack = 0;
+
+    reKind = VK_INTEGER;
+    switch (ePName)
+    {
+    // client arrays
+    case GL_VERTEX_ARRAY:
+    case GL_NORMAL_ARRAY:
+    case GL_COLOR_ARRAY:
+    case GL_POINT_SIZE_ARRAY_OES:
+    case GL_TEXTURE_COORD_ARRAY:
+        reKind = VK_BOOLEAN;
+        adValue[0] = (IsEnabled(ePName) ? 1.0 : 0.0);
+        return 1;
+    case GL_VERTEX_ARRAY_SIZE:
+    case GL_VERTEX_ARRAY_TYPE:
+    case GL_VERTEX_ARRAY_STRIDE:
+    case GL_VERTEX_ARRAY_BUFFER_BINDING:
+        pkArray = &m_akArray[ARRAY_VERTEX];
+        break;
+    case GL_NORMAL_ARRAY_TYPE:
+    case GL_NORMAL_ARRAY_STRIDE:
+    case GL_NORMAL_ARRAY_BUFFER_BINDING:
+        pkArray = &m_akArray[ARRAY_NORMAL];
+        break;
+    case GL_COLOR_ARRAY_SIZE:
+    case GL_COLOR_ARRAY_TYPE:
+    case GL_COLOR_ARRAY_STRIDE:
+    case GL_COLOR_ARRAY_BUFFER_BINDING:
+        pkArray = &m_akArray[ARRAY_COLOR];
+        break;
+    case GL_POINT_SIZE_ARRAY_TYPE_OES:
+    case GL_POINT_SIZE_ARRAY_STRIDE_OES:
+    case GL_POINT_SIZE_ARRAY_BUFFER_BINDING_OES:
+        pkArray = &m_akArray[ARRAY_POINT_SIZE];
+        break;
+    case GL_TEXTURE_COORD_ARRAY_SIZE:
+    case GL_TEXTURE_COORD_ARRAY_TYPE:
+    case GL_TEXTURE_COORD_ARRAY_STRIDE:
+    case GL_TEXTURE_COORD_ARRAY_BUFFER_BINDING:
+        pkArray = &m_akArray[GetClientActiveArray()];
+        break;
+    case GL_ARRAY_BUFFER_BINDING:
+        adValue[0] = (double)m_uiArrayBuffer;
+        return 1;
+    case GL_ELEMENT_ARRAY_BUFFER_BINDING:
+        adValue[0] = (double)m_uiElementBuffer;
+        return 1;
+
+    // texture units
+    case GL_ACTIVE_TEXTURE:
+        reKind = VK_ENUM;
+        adValue[0] = (double)(GL_TEXTURE0 + m_iActiveUnit);
+        return 1;
+    case GL_CLIENT_ACTIVE_TEXTURE:
+        reKind = VK_ENUM;
+        adValue[0] = (double)(GL_TEXTURE0 + m_iClientActiveUnit);
+        return 1;
+    case GL_TEXTURE_BINDING_2D:
+        adValue[0] = (double)m_akUnit[m_iActiveUnit].Texture;
+        return 1;
+    case GL_CURRENT_TEXTURE_COORDS:
+        reKind = VK_FLOAT;
+        afValue = m_akUnit[m_iActiveUnit].TexCoord;
+        iQuantity = 4;
+        break;
+
+    // current values
+    case GL_CURRENT_COLOR:
+        reKind = VK_COLOR;
+        afValue = m_afColor;
+        iQuantity = 4;
+        break;
+    case GL_CURRENT_NORMAL:
+        reKind = VK_COLOR;
+        afValue = m_afNormal;
+        iQuantity = 3;
+        break;
+
+    // matrices
+    case GL_MATRIX_MODE:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eMatrixMode;
+        return 1;
+    case GL_MODELVIEW_MATRIX:
+    case GL_MODELVIEW_STACK_DEPTH:
+        pkStack = &m_kModelView;
+        break;
+    case GL_PROJECTION_MATRIX:
+    case GL_PROJECTION_STACK_DEPTH:
+        pkStack = &m_kProjection;
+        break;
+    case GL_TEXTURE_MATRIX:
+    case GL_TEXTURE_STACK_DEPTH:
+        pkStack = &m_akUnit[m_iActiveUnit].Texture2D;
+        break;
+
+    // lighting and fog
+    case GL_LIGHT_MODEL_AMBIENT:
+        reKind = VK_COLOR;
+        afValue = m_afLightModelAmbient;
+        iQuantity = 4;
+        break;
+    case GL_LIGHT_MODEL_TWO_SIDE:
+        reKind = VK_BOOLEAN;
+        afValue = &m_fLightModelTwoSide;
+        break;
+    case GL_FOG_MODE:
+        reKind = VK_ENUM;
+        afValue = &m_fFogMode;
+        break;
+    case GL_FOG_DENSITY:
+        reKind = VK_FLOAT;
+        afValue = &m_fFogDensity;
+        break;
+    case GL_FOG_START:
+        reKind = VK_FLOAT;
+        afValue = &m_fFogStart;
+        break;
+    case GL_FOG_END:
+        reKind = VK_FLOAT;
+        afValue = &m_fFogEnd;
+        break;
+    case GL_FOG_COLOR:
+        reKind = VK_COLOR;
+        afValue = m_afFogColor;
+        iQuantity = 4;
+        break;
+
+    // fragment operations
+    case GL_ALPHA_TEST_FUNC:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eAlphaFunc;
+        return 1;
+    case GL_ALPHA_TEST_REF:
+        reKind = VK_COLOR;
+        afValue = &m_fAlphaRef;
+        break;
+    case GL_BLEND_SRC:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eBlendSrc;
+        return 1;
+    case GL_BLEND_DST:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eBlendDst;
+        return 1;
+    case GL_COLOR_WRITEMASK:
+        reKind = VK_BOOLEAN;
+        for (i = 0; i < 4; i++)
+        {
+            adValue[i] = (m_abColorMask[i] ? 1.0 : 0.0);
+        }
+        return 4;
+    case GL_DEPTH_FUNC:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eDepthFunc;
+        return 1;
+    case GL_DEPTH_WRITEMASK:
+        reKind = VK_BOOLEAN;
+        adValue[0] = (m_bDepthMask ? 1.0 : 0.0);
+        return 1;
+    case GL_DEPTH_RANGE:
+        reKind = VK_COLOR;
+        afValue = m_afDepthRange;
+        iQuantity = 2;
+        break;
+    case GL_STENCIL_FUNC:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eStencilFunc;
+        return 1;
+    case GL_STENCIL_REF:
+        adValue[0] = (double)m_iStencilRef;
+        return 1;
+    case GL_STENCIL_VALUE_MASK:
+        adValue[0] = (double)m_uiStencilValueMask;
+        return 1;
+    case GL_STENCIL_WRITEMASK:
+        adValue[0] = (double)m_uiStencilWriteMask;
+        return 1;
+    case GL_STENCIL_FAIL:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eStencilFail;
+        return 1;
+    case GL_STENCIL_PASS_DEPTH_FAIL:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eStencilZFail;
+        return 1;
+    case GL_STENCIL_PASS_DEPTH_PASS:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eStencilZPass;
+        return 1;
+    case GL_LOGIC_OP_MODE:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eLogicOp;
+        return 1;
+    case GL_COLOR_CLEAR_VALUE:
+        reKind = VK_COLOR;
+        afValue = m_afClearColor;
+        iQuantity = 4;
+        break;
+    case GL_DEPTH_CLEAR_VALUE:
+        reKind = VK_COLOR;
+        afValue = &m_fClearDepth;
+        break;
+    case GL_STENCIL_CLEAR_VALUE:
+        adValue[0] = (double)m_iClearStencil;
+        return 1;
+    case GL_SAMPLE_COVERAGE_VALUE:
+        reKind = VK_FLOAT;
+        afValue = &m_fSampleCoverage;
+        break;
+    case GL_SAMPLE_COVERAGE_INVERT:
+        reKind = VK_BOOLEAN;
+        adValue[0] = (m_bSampleCoverageInvert ? 1.0 : 0.0);
+        return 1;
+
+    // rasterization
+    case GL_POLYGON_OFFSET_FACTOR:
+        reKind = VK_FLOAT;
+        afValue = &m_fOffsetFactor;
+        break;
+    case GL_POLYGON_OFFSET_UNITS:
+        reKind = VK_FLOAT;
+        afValue = &m_fOffsetUnits;
+        break;
+    case GL_LINE_WIDTH:
+        reKind = VK_FLOAT;
+        afValue = &m_fLineWidth;
+        break;
+    case GL_POINT_SIZE:
+        reKind = VK_FLOAT;
+        afValue = &m_fPointSize;
+        break;
+    case GL_POINT_SIZE_MIN:
+        reKind = VK_FLOAT;
+        afValue = &m_afPointSizeRange[0];
+        break;
+    case GL_POINT_SIZE_MAX:
+        reKind = VK_FLOAT;
+        afValue = &m_afPointSizeRange[1];
+        break;
+    case GL_POINT_FADE_THRESHOLD_SIZE:
+        reKind = VK_FLOAT;
+        afValue = &m_fPointFade;
+        break;
+    case GL_POINT_DISTANCE_ATTENUATION:
+        reKind = VK_FLOAT;
+        afValue = m_afPointAttenuation;
+        iQuantity = 3;
+        break;
+    case GL_CULL_FACE_MODE:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eCullFace;
+        return 1;
+    case GL_FRONT_FACE:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eFrontFace;
+        return 1;
+    case GL_SHADE_MODEL:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eShadeModel;
+        return 1;
+    case GL_PERSPECTIVE_CORRECTION_HINT:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_ePerspectiveHint;
+        return 1;
+    case GL_POINT_SMOOTH_HINT:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_ePointSmoothHint;
+        return 1;
+    case GL_LINE_SMOOTH_HINT:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eLineSmoothHint;
+        return 1;
+    case GL_FOG_HINT:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eFogHint;
+        return 1;
+    case GL_GENERATE_MIPMAP_HINT:
+        reKind = VK_ENUM;
+        adValue[0] = (double)m_eMipmapHint;
+        return 1;
+    case GL_PACK_ALIGNMENT:
+        adValue[0] = (double)m_iPackAlignment;
+        return 1;
+    case GL_UNPACK_ALIGNMENT:
+        adValue[0] = (double)m_iUnpackAlignment;
+        return 1;
+    case GL_VIEWPORT:
+        for (i = 0; i < 4; i++)
+        {
+            adValue[i] = (double)m_aiViewport[i];
+        }
+        return 4;
+    case GL_SCISSOR_BOX:
+        for (i = 0; i < 4; i++)
+        {
+            adValue[i] = (double)m_aiScissor[i];
+        }
+        return 4;
+
+    // implementation limits, an RGB565 framebuffer
+    case GL_MAX_LIGHTS:
+        adValue[0] = (double)MAX_LIGHTS;
+        return 1;
+    case GL_MAX_CLIP_PLANES:
+        adValue[0] = (double)MAX_CLIP_PLANES;
+        return 1;
+    case GL_MAX_MODELVIEW_STACK_DEPTH:
+        adValue[0] = (double)MAX_MODELVIEW_DEPTH;
+        return 1;
+    case GL_MAX_PROJECTION_STACK_DEPTH:
+        adValue[0] = (double)MAX_PROJECTION_DEPTH;
+        return 1;
+    case GL_MAX_TEXTURE_STACK_DEPTH:
+        adValue[0] = (double)MAX_TEXTURE_DEPTH;
+        return 1;
+    case GL_MAX_TEXTURE_SIZE:
+        adValue[0] = (double)MAX_TEXTURE_SIZE;
+        return 1;
+    case GL_MAX_TEXTURE_UNITS:
+        adValue[0] = (double)MAX_TEXTURE_UNITS;
+        return 1;
+    case GL_MAX_VIEWPORT_DIMS:
+        adValue[0] = (double)MAX_VIEWPORT_SIZE;
+        adValue[1] = (double)MAX_VIEWPORT_SIZE;
+        return 2;
+    case GL_ALIASED_POINT_SIZE_RANGE:
+    case GL_SMOOTH_POINT_SIZE_RANGE:
+        reKind = VK_FLOAT;
+        adValue[0] = 1.0;
+        adValue[1] = 64.0;
+        return 2;
+    case GL_ALIASED_LINE_WIDTH_RANGE:
+    case GL_SMOOTH_LINE_WIDTH_RANGE:
+        reKind = VK_FLOAT;
+        adValue[0] = 1.0;
+        adValue[1] = 8.0;
+        return 2;
+    case GL_SUBPIXEL_BITS:
+        adValue[0] = 4.0;
+        return 1;
+    case GL_RED_BITS:
+    case GL_BLUE_BITS:
+        adValue[0] = 5.0;
+        return 1;
+    case GL_GREEN_BITS:
+        adValue[0] = 6.0;
+        return 1;
+    case GL_ALPHA_BITS:
+    case GL_SAMPLE_BUFFERS:
+    case GL_SAMPLES:
+        adValue[0] = 0.0;
+        return 1;
+    case GL_DEPTH_BITS:
+        adValue[0] = (double)m_iDepthBits;
+        return 1;
+    case GL_STENCIL_BITS:
+        adValue[0] = (double)m_iStencilBits;
+        return 1;
+    case GL_IMPLEMENTATION_COLOR_READ_TYPE_OES:
+        reKind = VK_ENUM;
+        adValue[0] = (double)GL_UNSIGNED_SHORT_5_6_5;
+        return 1;
+    case GL_IMPLEMENTATION_COLOR_READ_FORMAT_OES:
+        reKind = VK_ENUM;
+        adValue[0] = (double)GL_RGB;
+        return 1;
+    case GL_NUM_COMPRESSED_TEXTURE_FORMATS:
+        adValue[0] = 10.0;
+        return 1;
+    case GL_COMPRESSED_TEXTURE_FORMATS:
+        reKind = VK_ENUM;
+        for (i = 0; i < 10; i++)
+        {
+            adValue[i] = (double)(GL_PALETTE4_RGB8_OES + i);
+        }
+        return 10;
+
+    default:
+    {
+        // the capabilities
+        bool* pbCap = GetCapability(ePName);
+        if (!pbCap)
+        {
+            SetError(GL_INVALID_ENUM);
+            return 0;
+        }
+        reKind = VK_BOOLEAN;
+        adValue[0] = (*pbCap ? 1.0 : 0.0);
+        return 1;
+    }
+    }
+
+    if (pkArray)
+    {
+        switch (ePName)
+        {
+        case GL_VERTEX_ARRAY_SIZE:
+        case GL_COLOR_ARRAY_SIZE:
+        case GL_TEXTURE_COORD_ARRAY_SIZE:
+            adValue[0] = (double)pkArray->Size;
+            break;
+        case GL_VERTEX_ARRAY_TYPE:
+        case GL_NORMAL_ARRAY_TYPE:
+        case GL_COLOR_ARRAY_TYPE:
+        case GL_POINT_SIZE_ARRAY_TYPE_OES:
+        case GL_TEXTURE_COORD_ARRAY_TYPE:
+            reKind = VK_ENUM;
+            adValue[0] = (double)pkArray->Type;
+            break;
+        case GL_VERTEX_ARRAY_STRIDE:
+        case GL_NORMAL_ARRAY_STRIDE:
+        case GL_COLOR_ARRAY_STRIDE:
+        case GL_POINT_SIZE_ARRAY_STRIDE_OES:
+        case GL_TEXTURE_COORD_ARRAY_STRIDE:
+            adValue[0] = (double)pkArray->Stride;
+            break;
+        default:
+            adValue[0] = (double)pkArray->Buffer;
+            break;
+        }
+        return 1;
+    }
+
+    if (pkStack)
+    {
+        if (ePName == GL_MODELVIEW_STACK_DEPTH
+        ||  ePName == GL_PROJECTION_STACK_DEPTH
+        ||  ePName == GL_TEXTURE_STACK_DEPTH)
+        {
+            adValue[0] = (double)pkStack->Depth;
+            return 1;
+        }
+        reKind = VK_FLOAT;
+        afValue = pkStack->Matrix[pkStack->Depth-1];
+        iQuantity = 16;
+    }
+
+    for (i = 0; i < iQuantity; i++)
+    {
+        adValue[i] = (double)afValue[i];
+    }
+    return iQuantity;
+}
+//----------------------------------------------------------------------------
+int GLRecorder::GetTexEnv (GLenum eTarget, GLenum ePName, double* adValue,
+    int& reKind)
+{
+    const UnitState& rkUnit = m_akUnit[m_iActiveUnit];
+    reKind = VK_ENUM;
+    if (eTarget == GL_POINT_SPRITE_OES && ePName == GL_COORD_REPLACE_OES)
+    {
+        reKind = VK_BOOLEAN;
+        adValue[0] = (double)rkUnit.CoordReplace;
+        return 1;
+    }
+    if (eTarget != GL_TEXTURE_ENV || GetTexEnvQuantity(ePName) == 0
+    ||  ePName == GL_COORD_REPLACE_OES)
+    {
+        SetError(GL_INVALID_ENUM);
+        return 0;
+    }
+
+    switch (ePName)
+    {
+    case GL_TEXTURE_ENV_MODE:
+        adValue[0] = (double)rkUnit.EnvMode;
+        return 1;
+    case GL_TEXTURE_ENV_COLOR:
+        reKind = VK_COLOR;
+        for (int i = 0; i < 4; i++)
+        {
+            adValue[i] = (double)rkUnit.EnvColor[i];
+        }
+        return 4;
+    case GL_COMBINE_RGB:
+        adValue[0] = (double)rkUnit.CombineRGB;
+        return 1;
+    case GL_COMBINE_ALPHA:
+        adValue[0] = (double)rkUnit.CombineAlpha;
+        return 1;
+    case GL_RGB_SCALE:
+        reKind = VK_FLOAT;
+        adValue[0] = (double)rkUnit.RGBScale;
+        return 1;
+    case GL_ALPHA_SCALE:
+        reKind = VK_FLOAT;
+        adValue[0] = (double)rkUnit.AlphaScale;
+        return 1;
+    }
+
+    if (GL_SRC0_RGB <= ePName && ePName <= GL_SRC2_RGB)
+    {
+        adValue[0] = (double)rkUnit.SrcRGB[ePName-GL_SRC0_RGB];
+    }
+    else if (GL_SRC0_ALPHA <= ePName && ePName <= GL_SRC2_ALPHA)
+    {
+        adValue[0] = (double)rkUnit.SrcAlpha[ePName-GL_SRC0_ALPHA];
+    }
+    else if (GL_OPERAND0_RGB <= ePName && ePName <= GL_OPERAND2_RGB)
+    {
+        adValue[0] = (double)rkUnit.OperandRGB[ePName-GL_OPERAND0_RGB];
+    }
+    else
+    {
+        adValue[0] = (double)rkUnit.OperandAlpha[ePName-GL_OPERAND0_ALPHA];
+    }
+    return 1;
+}
+//----------------------------------------------------------------------------
+int GLRecorder::GetTexParameter (GLenum eTarget, GLenum ePName,
+    double* adValue, int& reKind)
+{
+    TextureObject* pkTexture = GetTexture(eTarget);
+    if (!pkTexture)
+    {
+        SetError(GL_INVALID_ENUM);
+        return 0;
+    }
+
+    reKind = VK_ENUM;
+    switch (ePName)
+    {
+    case GL_TEXTURE_MIN_FILTER:
+        adValue[0] = (double)pkTexture->MinFilter;
+        return 1;
+    case GL_TEXTURE_MAG_FILTER:
+        adValue[0] = (double)pkTexture->MagFilter;
+        return 1;
+    case GL_TEXTURE_WRAP_S:
+        adValue[0] = (double)pkTexture->WrapS;
+        return 1;
+    case GL_TEXTURE_WRAP_T:
+        adValue[0] = (double)pkTexture->WrapT;
+        return 1;
+    case GL_GENERATE_MIPMAP:
+        reKind = VK_BOOLEAN;
+        adValue[0] = (double)pkTexture->GenerateMipmap;
+        return 1;
+    }
+
+    SetError(GL_INVALID_ENUM);
+    return 0;
+}
+//----------------------------------------------------------------------------
+int GLRecorder::GetLight (GLenum eLight, GLenum ePName, double* adValue)
+{
+    int iQuantity = GetLightQuantity(ePName);
+    if (eLight < GL_LIGHT0 || eLight >= GL_LIGHT0 + MAX_LIGHTS
+    ||  iQuantity == 0)
+    {
+        SetError(GL_INVALID_ENUM);
+        return 0;
+    }
+
+    const LightState& rkLight = m_akLight[eLight - GL_LIGHT0];
+    const float* afValue;
+    switch (ePName)
+    {
+    case GL_AMBIENT:
+        afValue = rkLight.Ambient;
+        break;
+    case GL_DIFFUSE:
+        afValue = rkLight.Diffuse;
+        break;
+    case GL_SPECULAR:
+        afValue = rkLight.Specular;
+        break;
+    case GL_POSITION:
+        afValue = rkLight.Position;
+        break;
+    case GL_SPOT_DIRECTION:
+        afValue = rkLight.SpotDirection;
+        break;
+    case GL_SPOT_EXPONENT:
+        afValue = &rkLight.SpotExponent;
+        break;
+    case GL_SPOT_CUTOFF:
+        afValue = &rkLight.SpotCutoff;
+        break;
+    default:
+        afValue = &rkLight.Attenuation[ePName-GL_CONSTANT_ATTENUATION];
+        break;
+    }
+
+    for (int i = 0; i < iQuantity; i++)
+    {
+        adValue[i] = (double)afValue[i];
+    }
+    return iQuantity;
+}
+//----------------------------------------------------------------------------
+int GLRecorder::GetMaterial (GLenum eFace, GLenum ePName, double* adValue)
+{
+    if ((eFace != GL_FRONT && eFace != GL_BACK)
+    ||  GetMaterialQuantity(ePName) == 0
+    ||  ePName == GL_AMBIENT_AND_DIFFUSE)
+    {
+        SetError(GL_INVALID_ENUM);
+        return 0;
+    }
+
+    const float* afValue;
+    switch (ePName)
+    {
+    case GL_AMBIENT:
+        afValue = m_afAmbient;
+        break;
+    case GL_DIFFUSE:
+        afValue = m_afDiffuse;
+        break;
+    case GL_SPECULAR:
+        afValue = m_afSpecular;
+        break;
+    case GL_EMISSION:
+        afValue = m_afEmission;
+        break;
+    default:
+        adValue[0] = (double)m_fShininess;
+        return 1;
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        adValue[i] = (double)afValue[i];
+    }
+    return 4;
+}
+//----------------------------------------------------------------------------
+int GLRecorder::GetClipPlane (GLenum ePlane, double* adValue)
+{
+    if (ePlane < GL_CLIP_PLANE0 || ePlane >= GL_CLIP_PLANE0 + MAX_CLIP_PLANES)
+    {
+        SetError(GL_INVALID_ENUM);
+        return 0;
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        adValue[i] = (double)m_aafClipPlane[ePlane-GL_CLIP_PLANE0][i];
+    }
+    return 4;
+}
+//----------------------------------------------------------------------------
+int GLRecorder::GetBufferParameter (GLenum eTarget, GLenum ePName,
+    GLint* aiValue)
+{
+    if ((eTarget != GL_ARRAY_BUFFER && eTarget != GL_ELEMENT_ARRAY_BUFFER)
+    ||  (ePName != GL_BUFFER_SIZE && ePName != GL_BUFFER_USAGE))
+    {
+        SetError(GL_INVALID_ENUM);
+        return 0;
+    }
+    BufferObject* pkBuffer = GetBuffer(eTarget);
+    if (!pkBuffer)
+    {
+        SetError(GL_INVALID_OPERATION);
+        return 0;
+    }
+
+    aiValue[0] = (ePName == GL_BUFFER_SIZE ? pkBuffer->Size :
+        (GLint)pkBuffer->Usage);
+    return 1;
+}
+//----------------------------------------------------------------------------
+bool GLRecorder::GetPointer (GLenum ePName, GLvoid** ppvPointer)
+{
+    int iArray;
+    switch (ePName)
+    {
+    case GL_VERTEX_ARRAY_POINTER:
+        iArray = ARRAY_VERTEX;
+        break;
+    case GL_NORMAL_ARRAY_POINTER:
+        iArray = ARRAY_NORMAL;
+        break;
+    case GL_COLOR_ARRAY_POINTER:
+        iArray = ARRAY_COLOR;
+        break;
+    case GL_POINT_SIZE_ARRAY_POINTER_OES:
+        iArray = ARRAY_POINT_SIZE;
+        break;
+    case GL_TEXTURE_COORD_ARRAY_POINTER:
+        iArray = GetClientActiveArray();
+        break;
+    default:
+        SetError(GL_INVALID_ENUM);
+        return false;
+    }
+
+    *ppvPointer = (GLvoid*)m_akArray[iArray].Pointer;
+    return true;
+}
+//----------------------------------------------------------------------------
+const GLubyte* GLRecorder::GetString (GLenum eName)
+{
+    switch (eName)
+    {
+    case GL_VENDOR:
+        return (const GLubyte*)"Soft3DEngine";
+    case GL_RENDERER:
+        return (const GLubyte*)"RecordingGL";
+    case GL_VERSION:
+        return (const GLubyte*)"OpenGL ES-CM 1.1";
+    case GL_EXTENSIONS:
+        return (const GLubyte*)"GL_OES_read_format "
+            "GL_OES_compressed_paletted_texture GL_OES_point_size_array "
+            "GL_OES_point_sprite";
+    }
+
+    SetError(GL_INVALID_ENUM);
+    return 0;
+}
+//----------------------------------------------------------------------------
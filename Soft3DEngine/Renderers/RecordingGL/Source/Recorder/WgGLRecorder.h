@@ -0,0 +1,457 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgGLRecorder.h                     //
+//                                                       //
+//  - Interface for GL Recorder class                    //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+
+#ifndef __WG_GLRECORDER_H__
+#define __WG_GLRECORDER_H__
+
+#include "WgRecordingGLLIB.h"
+#include "WgGLTrace.h"
+#include "WgTHashTable.h"
+#include "GLES/gl.h"
+
+
+namespace WGSoft3D
+{
+
+// The context of the recording OpenGL ES 1.1 library.  The library
+// implements every entry point of the common profile, so the OpenGL ES
+// renderers can be compiled, driven and profiled unchanged, without a
+// graphics driver.  Nothing is rasterized.
+//
+// Each call is validated as the specification requires:  a bad enumerant,
+// value or operation sets the GL error and the call is ignored.  The state
+// is tracked so that the queries answer as a driver would, and so that a
+// state call that changes nothing is known as redundant.  Texture and
+// buffer objects are tracked from glGen* to glDelete*, with their sizes.
+//
+// With an open trace each call is written as a record of a GLTrace:  its
+// opcode, arguments, flags and timing.  EndFrame marks the end of a frame,
+// a renderer calls it where it would swap the buffers.
+//
+// The library has one context and is not thread safe, as an OpenGL ES
+// context is current in one thread only.
+
+class WG3D_RENDERER_ITEM GLRecorder
+{
+public:
+    // the context that the gl* functions use
+    static GLRecorder& GetContext ();
+
+    // The trace.  Without an open trace the calls are still validated and
+    // tracked.
+    bool Open (const char* acFilename);
+    void Close ();
+    bool IsOpen () const;
+    void EndFrame ();
+
+    // The framebuffer that the queries report.  It also sets the viewport
+    // and the scissor box, as making a context current does.  The default
+    // is 640x480 with 16 depth bits and 8 stencil bits.
+    void SetFramebuffer (int iWidth, int iHeight, int iDepthBits,
+        int iStencilBits);
+
+    // Restores the initial state and deletes all objects.
+    void Reset ();
+
+    // counts since the last Reset
+    int GetCallQuantity () const;
+    int GetErrorQuantity () const;
+    int GetFrameQuantity () const;
+
+    // the live objects and the bytes of their data
+    int GetTextureQuantity () const;
+    int GetTextureBytes () const;
+    int GetBufferQuantity () const;
+    int GetBufferBytes () const;
+
+    enum
+    {
+        MAX_TEXTURE_UNITS = 4,
+        MAX_LIGHTS = 8,
+        MAX_CLIP_PLANES = 6,
+        MAX_MODELVIEW_DEPTH = 16,
+        MAX_PROJECTION_DEPTH = 2,
+        MAX_TEXTURE_DEPTH = 2,
+        MAX_TEXTURE_LEVELS = 12,
+        MAX_TEXTURE_SIZE = 1 << (MAX_TEXTURE_LEVELS-1),
+        MAX_VIEWPORT_SIZE = 2048
+    };
+
+    // The recording of one call.  A gl* function creates one on the stack,
+    // adds its arguments, and the record is written when it goes out of
+    // scope.
+    class WG3D_RENDERER_ITEM Call
+    {
+    public:
+        Call (int eOpcode);
+        ~Call ();
+
+        void Word (unsigned int uiValue);
+        void Float (float fValue);
+        void Words (int iQuantity, const void* pvWords);
+        void SetFlag (int eFlag);
+
+        // sets FLAG_REDUNDANT when bChanged is false
+        void Changed (bool bChanged);
+
+    private:
+        GLRecorder& m_rkContext;
+        double m_dStart;
+        int m_iErrorQuantity;
+        GLTrace::Record m_kRecord;
+    };
+
+    // the kinds of the values of the queries
+    enum ValueKind
+    {
+        VK_BOOLEAN,
+        VK_INTEGER,
+        VK_ENUM,
+        VK_FLOAT,
+        VK_COLOR
+    };
+
+    // the client arrays
+    enum
+    {
+        ARRAY_VERTEX,
+        ARRAY_NORMAL,
+        ARRAY_COLOR,
+        ARRAY_POINT_SIZE,
+        ARRAY_TEXCOORD,
+        ARRAY_QUANTITY = ARRAY_TEXCOORD + MAX_TEXTURE_UNITS
+    };
+
+    // The GL semantics.  The gl* functions convert their parameters to
+    // floats (enumerants are stored as exact floats) and call these.  The
+    // state setters return true when the state changed.
+    void SetError (GLenum eError);
+    GLenum GetError ();
+
+    bool SetCapability (GLenum eCap, bool bEnabled);
+    bool IsEnabled (GLenum eCap);
+    bool SetClientState (GLenum eArray, bool bEnabled);
+    bool ActiveTexture (GLenum eUnit);
+    bool ClientActiveTexture (GLenum eUnit);
+
+    // objects
+    void GenNames (bool bTexture, GLsizei iQuantity, GLuint* auiName);
+    void DeleteNames (bool bTexture, GLsizei iQuantity,
+        const GLuint* auiName);
+    bool IsName (bool bTexture, GLuint uiName) const;
+    bool BindTexture (GLenum eTarget, GLuint uiName);
+    bool BindBuffer (GLenum eTarget, GLuint uiName);
+
+    // Uploads, they return the bytes copied from client memory.
+    int TexImage2D (GLenum eTarget, GLint iLevel, GLenum eInternalFormat,
+        GLsizei iWidth, GLsizei iHeight, GLint iBorder, GLenum eFormat,
+        GLenum eType, const GLvoid* pvPixels);
+    int TexSubImage2D (GLenum eTarget, GLint iLevel, GLint iX, GLint iY,
+        GLsizei iWidth, GLsizei iHeight, GLenum eFormat, GLenum eType,
+        const GLvoid* pvPixels);
+    int CompressedTexImage2D (GLenum eTarget, GLint iLevel,
+        GLenum eInternalFormat, GLsizei iWidth, GLsizei iHeight,
+        GLint iBorder, GLsizei iBytes, const GLvoid* pvData);
+    int CompressedTexSubImage2D (GLenum eTarget, GLint iLevel, GLint iX,
+        GLint iY, GLsizei iWidth, GLsizei iHeight, GLenum eFormat,
+        GLsizei iBytes, const GLvoid* pvData);
+    int BufferData (GLenum eTarget, GLsizeiptr iBytes, const GLvoid* pvData,
+        GLenum eUsage);
+    int BufferSubData (GLenum eTarget, GLintptr iOffset, GLsizeiptr iBytes,
+        const GLvoid* pvData);
+
+    // framebuffer operations, they return the bytes written
+    int CopyTexImage2D (GLenum eTarget, GLint iLevel, GLenum eInternalFormat,
+        GLint iX, GLint iY, GLsizei iWidth, GLsizei iHeight, GLint iBorder);
+    int CopyTexSubImage2D (GLenum eTarget, GLint iLevel, GLint iXOffset,
+        GLint iYOffset, GLint iX, GLint iY, GLsizei iWidth, GLsizei iHeight);
+    int ReadPixels (GLint iX, GLint iY, GLsizei iWidth, GLsizei iHeight,
+        GLenum eFormat, GLenum eType, GLvoid* pvPixels);
+    void Clear (GLbitfield uiMask);
+
+    // parameters
+    bool TexParameter (GLenum eTarget, GLenum ePName, float fParam);
+    bool TexEnv (GLenum eTarget, GLenum ePName, const float* afParam);
+    bool Light (GLenum eLight, GLenum ePName, const float* afParam);
+    bool LightModel (GLenum ePName, const float* afParam);
+    bool Material (GLenum eFace, GLenum ePName, const float* afParam);
+    bool Fog (GLenum ePName, const float* afParam);
+    bool PointParameter (GLenum ePName, const float* afParam);
+    bool ClipPlane (GLenum ePlane, const float* afEquation);
+
+    // the quantity of values of a parameter, 0 for an invalid parameter
+    static int GetTexEnvQuantity (GLenum ePName);
+    static int GetLightQuantity (GLenum ePName);
+    static int GetLightModelQuantity (GLenum ePName);
+    static int GetMaterialQuantity (GLenum ePName);
+    static int GetFogQuantity (GLenum ePName);
+    static int GetPointParameterQuantity (GLenum ePName);
+
+    // true when a parameter takes an enumerant, so that a fixed-point or
+    // integer value is not converted
+    static bool IsEnumParameter (GLenum ePName);
+
+    // current values
+    bool Color (const float* afColor);
+    bool Normal (const float* afNormal);
+    bool MultiTexCoord (GLenum eTarget, const float* afCoord);
+
+    // fragment and rasterization state
+    bool AlphaFunc (GLenum eFunc, float fRef);
+    bool BlendFunc (GLenum eSrc, GLenum eDst);
+    bool ColorMask (bool bRed, bool bGreen, bool bBlue, bool bAlpha);
+    bool DepthFunc (GLenum eFunc);
+    bool DepthMask (bool bMask);
+    bool DepthRange (float fNear, float fFar);
+    bool StencilFunc (GLenum eFunc, GLint iRef, GLuint uiMask);
+    bool StencilOp (GLenum eFail, GLenum eZFail, GLenum eZPass);
+    bool StencilMask (GLuint uiMask);
+    bool LogicOp (GLenum eOp);
+    bool ClearColor (const float* afColor);
+    bool ClearDepth (float fDepth);
+    bool ClearStencil (GLint iStencil);
+    bool SampleCoverage (float fValue, bool bInvert);
+    bool PolygonOffset (float fFactor, float fUnits);
+    bool LineWidth (float fWidth);
+    bool PointSize (float fSize);
+    bool CullFace (GLenum eMode);
+    bool FrontFace (GLenum eMode);
+    bool ShadeModel (GLenum eMode);
+    bool Hint (GLenum eTarget, GLenum eMode);
+    bool PixelStore (GLenum ePName, GLint iParam);
+    bool Viewport (GLint iX, GLint iY, GLsizei iWidth, GLsizei iHeight);
+    bool Scissor (GLint iX, GLint iY, GLsizei iWidth, GLsizei iHeight);
+
+    // client arrays
+    bool ArrayPointer (int iArray, GLint iSize, GLenum eType, GLsizei iStride,
+        const GLvoid* pvPointer);
+    int GetClientActiveArray () const;
+
+    // matrices
+    bool MatrixMode (GLenum eMode);
+    bool LoadMatrix (const float* afMatrix);
+    bool MultMatrix (const float* afMatrix);
+    bool PushMatrix ();
+    bool PopMatrix ();
+    bool Rotate (float fAngle, float fX, float fY, float fZ);
+    bool Scale (float fX, float fY, float fZ);
+    bool Translate (float fX, float fY, float fZ);
+    bool Frustum (float fLeft, float fRight, float fBottom, float fTop,
+        float fNear, float fFar);
+    bool Ortho (float fLeft, float fRight, float fBottom, float fTop,
+        float fNear, float fFar);
+
+    // Draws.  The vertices referenced and the bytes read from client memory
+    // are returned.  The result is false when the call reads outside its
+    // arrays.
+    bool DrawArrays (GLenum eMode, GLint iFirst, GLsizei iCount,
+        int& riVertices, int& riStreamed);
+    bool DrawElements (GLenum eMode, GLsizei iCount, GLenum eType,
+        const GLvoid* pvIndices, int& riVertices, int& riStreamed);
+
+    // Queries.  They return the quantity of values, 0 after an error.
+    int GetValue (GLenum ePName, double* adValue, int& reKind);
+    int GetTexEnv (GLenum eTarget, GLenum ePName, double* adValue,
+        int& reKind);
+    int GetTexParameter (GLenum eTarget, GLenum ePName, double* adValue,
+        int& reKind);
+    int GetLight (GLenum eLight, GLenum ePName, double* adValue);
+    int GetMaterial (GLenum eFace, GLenum ePName, double* adValue);
+    int GetClipPlane (GLenum ePlane, double* adValue);
+    int GetBufferParameter (GLenum eTarget, GLenum ePName, GLint* aiValue);
+    bool GetPointer (GLenum ePName, GLvoid** ppvPointer);
+    const GLubyte* GetString (GLenum eName);
+
+private:
+    friend class Call;
+
+    // the context is a singleton
+    GLRecorder ();
+    ~GLRecorder ();
+
+    void Write (GLTrace::Record& rkRecord, double dStart, double dEnd);
+
+    class TextureObject
+    {
+    public:
+        TextureObject ();
+
+        bool Bound;  // named by glGenTextures but not yet bound
+        GLenum Format[MAX_TEXTURE_LEVELS];  // 0 for a level without image
+        int Width[MAX_TEXTURE_LEVELS];
+        int Height[MAX_TEXTURE_LEVELS];
+        int Bytes[MAX_TEXTURE_LEVELS];
+        bool Compressed;
+        float MinFilter, MagFilter, WrapS, WrapT, GenerateMipmap;
+    };
+
+    class BufferObject
+    {
+    public:
+        BufferObject ();
+        ~BufferObject ();
+
+        bool Bound;
+        int Size;
+        GLenum Usage;
+
+        // a copy of the data to check the indices of draws
+        unsigned char* Data;
+    };
+
+    class ArrayState
+    {
+    public:
+        bool Enabled;
+        GLint Size;
+        GLenum Type;
+        GLsizei Stride;
+        const GLvoid* Pointer;
+        GLuint Buffer;
+    };
+
+    class MatrixStack
+    {
+    public:
+        int Depth, MaxDepth;
+        float Matrix[MAX_MODELVIEW_DEPTH][16];
+    };
+
+    class UnitState
+    {
+    public:
+        bool Enabled;
+        GLuint Texture;
+        float EnvMode, EnvColor[4];
+        float CombineRGB, CombineAlpha;
+        float SrcRGB[3], SrcAlpha[3], OperandRGB[3], OperandAlpha[3];
+        float RGBScale, AlphaScale;
+        float CoordReplace;
+        float TexCoord[4];
+        MatrixStack Texture2D;
+    };
+
+    class LightState
+    {
+    public:
+        bool Enabled;
+        float Ambient[4], Diffuse[4], Specular[4], Position[4];
+        float SpotDirection[3], SpotExponent, SpotCutoff;
+        float Attenuation[3];
+    };
+
+    TextureObject* GetTexture (GLenum eTarget);
+    TextureObject* GetTextureObject (GLuint uiName) const;
+    BufferObject* GetBuffer (GLenum eTarget);
+    BufferObject* GetBufferObject (GLuint uiName) const;
+    MatrixStack& GetStack ();
+    float* GetTop ();
+    bool SetTop (const float* afMatrix);
+    bool* GetCapability (GLenum eCap);
+
+    // validation of pixel transfers, the bytes of the image or -1 after an
+    // error
+    int GetImageBytes (GLsizei iWidth, GLsizei iHeight, GLenum eFormat,
+        GLenum eType, int iAlignment);
+    TextureObject* ValidateImage (GLenum eTarget, GLint iLevel,
+        GLsizei iWidth, GLsizei iHeight, GLint iBorder);
+    bool ValidateSubImage (TextureObject* pkTexture, GLint iLevel, GLint iX,
+        GLint iY, GLsizei iWidth, GLsizei iHeight, GLenum eFormat);
+    void SetImage (TextureObject* pkTexture, GLint iLevel, GLenum eFormat,
+        GLsizei iWidth, GLsizei iHeight, int iBytes, bool bCompressed);
+
+    // the vertices read from the enabled arrays and the bytes of client
+    // memory, false when an array is too short
+    bool ReadArrays (int iMin, int iMax, int& riStreamed);
+
+    static bool IsPowerOfTwo (int iValue);
+    static bool IsCompareFunc (GLenum eFunc);
+    static bool SetValue (float& rfState, float fValue);
+    static bool SetValues (int iQuantity, float* afState,
+        const float* afValue);
+    static void MultiplyTop (float* afTop, const float* afMatrix);
+
+    // the trace
+    GLTraceWriter m_kWriter;
+    double m_dLastStart;
+    int m_iCallQuantity, m_iErrorQuantity, m_iFrameQuantity;
+
+    // the framebuffer
+    int m_iWidth, m_iHeight, m_iDepthBits, m_iStencilBits;
+
+    GLenum m_eError;
+
+    // objects, the texture name 0 is the default texture
+    THashTable<unsigned int,TextureObject*> m_kTextures;
+    THashTable<unsigned int,BufferObject*> m_kBuffers;
+    TextureObject m_kDefaultTexture;
+    GLuint m_uiNextTexture, m_uiNextBuffer;
+    int m_iTextureBytes, m_iBufferBytes;
+    GLuint m_uiArrayBuffer, m_uiElementBuffer;
+
+    // capabilities other than GL_TEXTURE_2D and the lights
+    enum { CAP_QUANTITY = 27 };
+    static const GLenum ms_aeCap[CAP_QUANTITY];
+    bool m_abCap[CAP_QUANTITY];
+
+    // texture units and client arrays
+    int m_iActiveUnit, m_iClientActiveUnit;
+    UnitState m_akUnit[MAX_TEXTURE_UNITS];
+    ArrayState m_akArray[ARRAY_QUANTITY];
+
+    // current values
+    float m_afColor[4], m_afNormal[3];
+
+    // matrices
+    GLenum m_eMatrixMode;
+    MatrixStack m_kModelView, m_kProjection;
+
+    // lighting, material and fog
+    LightState m_akLight[MAX_LIGHTS];
+    float m_afLightModelAmbient[4], m_fLightModelTwoSide;
+    float m_afAmbient[4], m_afDiffuse[4], m_afSpecular[4], m_afEmission[4];
+    float m_fShininess;
+    float m_fFogMode, m_fFogDensity, m_fFogStart, m_fFogEnd;
+    float m_afFogColor[4];
+    float m_aafClipPlane[MAX_CLIP_PLANES][4];
+
+    // fragment operations
+    GLenum m_eAlphaFunc;
+    float m_fAlphaRef;
+    GLenum m_eBlendSrc, m_eBlendDst;
+    bool m_abColorMask[4];
+    GLenum m_eDepthFunc;
+    bool m_bDepthMask;
+    float m_afDepthRange[2];
+    GLenum m_eStencilFunc;
+    GLint m_iStencilRef;
+    GLuint m_uiStencilValueMask, m_uiStencilWriteMask;
+    GLenum m_eStencilFail, m_eStencilZFail, m_eStencilZPass;
+    GLenum m_eLogicOp;
+    float m_afClearColor[4], m_fClearDepth;
+    GLint m_iClearStencil;
+    float m_fSampleCoverage;
+    bool m_bSampleCoverageInvert;
+
+    // rasterization
+    float m_fOffsetFactor, m_fOffsetUnits;
+    float m_fLineWidth, m_fPointSize;
+    float m_afPointSizeRange[2], m_fPointFade, m_afPointAttenuation[3];
+    GLenum m_eCullFace, m_eFrontFace, m_eShadeModel;
+    GLenum m_ePerspectiveHint, m_ePointSmoothHint, m_eLineSmoothHint;
+    GLenum m_eFogHint, m_eMipmapHint;
+    GLint m_iPackAlignment, m_iUnpackAlignment;
+    GLint m_aiViewport[4], m_aiScissor[4];
+};
+
+#include "WgGLRecorder.inl"
+
+}
+
+#endif
@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgGLRecorder.inl                   //
+//                                                       //
+//  - Inlines for GL Recorder class                      //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+inline bool GLRecorder::IsOpen () const
+{
+    return m_kWriter.IsOpen();
+}
+//----------------------------------------------------------------------------
+inline int GLRecorder::GetCallQuantity () const
+{
+    return m_iCallQuantity;
+}
+//----------------------------------------------------------------------------
+inline int GLRecorder::GetErrorQuantity () const
+{
+    return m_iErrorQuantity;
+}
+//----------------------------------------------------------------------------
+inline int GLRecorder::GetFrameQuantity () const
+{
+    return m_iFrameQuantity;
+}
+//----------------------------------------------------------------------------
+inline int GLRecorder::GetTextureQuantity () const
+{
+    return m_kTextures.GetQuantity();
+}
+//----------------------------------------------------------------------------
+inline int GLRecorder::GetTextureBytes () const
+{
+    return m_iTextureBytes;
+}
+//----------------------------------------------------------------------------
+inline int GLRecorder::GetBufferQuantity () const
+{
+    return m_kBuffers.GetQuantity();
+}
+//----------------------------------------------------------------------------
+inline int GLRecorder::GetBufferBytes () const
+{
+    return m_iBufferBytes;
+}
+//----------------------------------------------------------------------------
+inline int GLRecorder::GetClientActiveArray () const
+{
+    return ARRAY_TEXCOORD + m_iClientActiveUnit;
+}
+//----------------------------------------------------------------------------
+inline void GLRecorder::Call::Word (unsigned int uiValue)
+{
+    if (m_kRecord.ArgumentQuantity < GLTrace::MAX_ARGUMENTS)
+    {
+        m_kRecord.Argument[m_kRecord.ArgumentQuantity++] = uiValue;
+    }
+}
+//----------------------------------------------------------------------------
+inline void GLRecorder::Call::Float (float fValue)
+{
+    union { float f; unsigned int u; } kBits;
+    kBits.f = fValue;
+    Word(kBits.u);
+}
+//----------------------------------------------------------------------------
+inline void GLRecorder::Call::SetFlag (int eFlag)
+{
+    m_kRecord.Flags |= eFlag;
+}
+//----------------------------------------------------------------------------
+inline void GLRecorder::Call::Changed (bool bChanged)
+{
+    if (!bChanged)
+    {
+        m_kRecord.Flags |= GLTrace::FLAG_REDUNDANT;
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,391 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgGLTrace.cpp                      //
+//                                                       //
+//  - Implementation for GL Trace class                  //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgRecordingGLPCH.h"
+#include "WgGLTrace.h"
+using namespace WGSoft3D;
+
+const GLTrace::Info GLTrace::ms_akInfo[GLTrace::OP_QUANTITY] =
+{
+    { "Frame", CAT_MARKER },
+    { "glActiveTexture", CAT_STATE },
+    { "glAlphaFunc", CAT_STATE },
+    { "glAlphaFuncx", CAT_STATE },
+    { "glBindBuffer", CAT_STATE },
+    { "glBindTexture", CAT_STATE },
+    { "glBlendFunc", CAT_STATE },
+    { "glBufferData", CAT_UPLOAD },
+    { "glBufferSubData", CAT_UPLOAD },
+    { "glClear", CAT_FRAMEBUFFER },
+    { "glClearColor", CAT_STATE },
+    { "glClearColorx", CAT_STATE },
+    { "glClearDepthf", CAT_STATE },
+    { "glClearDepthx", CAT_STATE },
+    { "glClearStencil", CAT_STATE },
+    { "glClientActiveTexture", CAT_STATE },
+    { "glClipPlanef", CAT_STATE },
+    { "glClipPlanex", CAT_STATE },
+    { "glColor4f", CAT_STATE },
+    { "glColor4ub", CAT_STATE },
+    { "glColor4x", CAT_STATE },
+    { "glColorMask", CAT_STATE },
+    { "glColorPointer", CAT_STATE },
+    { "glCompressedTexImage2D", CAT_UPLOAD },
+    { "glCompressedTexSubImage2D", CAT_UPLOAD },
+    { "glCopyTexImage2D", CAT_FRAMEBUFFER },
+    { "glCopyTexSubImage2D", CAT_FRAMEBUFFER },
+    { "glCullFace", CAT_STATE },
+    { "glDeleteBuffers", CAT_OBJECT },
+    { "glDeleteTextures", CAT_OBJECT },
+    { "glDepthFunc", CAT_STATE },
+    { "glDepthMask", CAT_STATE },
+    { "glDepthRangef", CAT_STATE },
+    { "glDepthRangex", CAT_STATE },
+    { "glDisable", CAT_STATE },
+    { "glDisableClientState", CAT_STATE },
+    { "glDrawArrays", CAT_DRAW },
+    { "glDrawElements", CAT_DRAW },
+    { "glEnable", CAT_STATE },
+    { "glEnableClientState", CAT_STATE },
+    { "glFinish", CAT_FRAMEBUFFER },
+    { "glFlush", CAT_FRAMEBUFFER },
+    { "glFogf", CAT_STATE },
+    { "glFogfv", CAT_STATE },
+    { "glFogx", CAT_STATE },
+    { "glFogxv", CAT_STATE },
+    { "glFrontFace", CAT_STATE },
+    { "glFrustumf", CAT_MATRIX },
+    { "glFrustumx", CAT_MATRIX },
+    { "glGenBuffers", CAT_OBJECT },
+    { "glGenTextures", CAT_OBJECT },
+    { "glGetBooleanv", CAT_QUERY },
+    { "glGetBufferParameteriv", CAT_QUERY },
+    { "glGetClipPlanef", CAT_QUERY },
+    { "glGetClipPlanex", CAT_QUERY },
+    { "glGetError", CAT_QUERY },
+    { "glGetFixedv", CAT_QUERY },
+    { "glGetFloatv", CAT_QUERY },
+    { "glGetIntegerv", CAT_QUERY },
+    { "glGetLightfv", CAT_QUERY },
+    { "glGetLightxv", CAT_QUERY },
+    { "glGetMaterialfv", CAT_QUERY },
+    { "glGetMaterialxv", CAT_QUERY },
+    { "glGetPointerv", CAT_QUERY },
+    { "glGetString", CAT_QUERY },
+    { "glGetTexEnvfv", CAT_QUERY },
+    { "glGetTexEnviv", CAT_QUERY },
+    { "glGetTexEnvxv", CAT_QUERY },
+    { "glGetTexParameterfv", CAT_QUERY },
+    { "glGetTexParameteriv", CAT_QUERY },
+    { "glGetTexParameterxv", CAT_QUERY },
+    { "glHint", CAT_STATE },
+    { "glIsBuffer", CAT_QUERY },
+    { "glIsEnabled", CAT_QUERY },
+    { "glIsTexture", CAT_QUERY },
+    { "glLightModelf", CAT_STATE },
+    { "glLightModelfv", CAT_STATE },
+    { "glLightModelx", CAT_STATE },
+    { "glLightModelxv", CAT_STATE },
+    { "glLightf", CAT_STATE },
+    { "glLightfv", CAT_STATE },
+    { "glLightx", CAT_STATE },
+    { "glLightxv", CAT_STATE },
+    { "glLineWidth", CAT_STATE },
+    { "glLineWidthx", CAT_STATE },
+    { "glLoadIdentity", CAT_MATRIX },
+    { "glLoadMatrixf", CAT_MATRIX },
+    { "glLoadMatrixx", CAT_MATRIX },
+    { "glLogicOp", CAT_STATE },
+    { "glMaterialf", CAT_STATE },
+    { "glMaterialfv", CAT_STATE },
+    { "glMaterialx", CAT_STATE },
+    { "glMaterialxv", CAT_STATE },
+    { "glMatrixMode", CAT_STATE },
+    { "glMultMatrixf", CAT_MATRIX },
+    { "glMultMatrixx", CAT_MATRIX },
+    { "glMultiTexCoord4f", CAT_STATE },
+    { "glMultiTexCoord4x", CAT_STATE },
+    { "glNormal3f", CAT_STATE },
+    { "glNormal3x", CAT_STATE },
+    { "glNormalPointer", CAT_STATE },
+    { "glOrthof", CAT_MATRIX },
+    { "glOrthox", CAT_MATRIX },
+    { "glPixelStorei", CAT_STATE },
+    { "glPointParameterf", CAT_STATE },
+    { "glPointParameterfv", CAT_STATE },
+    { "glPointParameterx", CAT_STATE },
+    { "glPointParameterxv", CAT_STATE },
+    { "glPointSize", CAT_STATE },
+    { "glPointSizePointerOES", CAT_STATE },
+    { "glPointSizex", CAT_STATE },
+    { "glPolygonOffset", CAT_STATE },
+    { "glPolygonOffsetx", CAT_STATE },
+    { "glPopMatrix", CAT_MATRIX },
+    { "glPushMatrix", CAT_MATRIX },
+    { "glReadPixels", CAT_FRAMEBUFFER },
+    { "glRotatef", CAT_MATRIX },
+    { "glRotatex", CAT_MATRIX },
+    { "glSampleCoverage", CAT_STATE },
+    { "glSampleCoveragex", CAT_STATE },
+    { "glScalef", CAT_MATRIX },
+    { "glScalex", CAT_MATRIX },
+    { "glScissor", CAT_STATE },
+    { "glShadeModel", CAT_STATE },
+    { "glStencilFunc", CAT_STATE },
+    { "glStencilMask", CAT_STATE },
+    { "glStencilOp", CAT_STATE },
+    { "glTexCoordPointer", CAT_STATE },
+    { "glTexEnvf", CAT_STATE },
+    { "glTexEnvfv", CAT_STATE },
+    { "glTexEnvi", CAT_STATE },
+    { "glTexEnviv", CAT_STATE },
+    { "glTexEnvx", CAT_STATE },
+    { "glTexEnvxv", CAT_STATE },
+    { "glTexImage2D", CAT_UPLOAD },
+    { "glTexParameterf", CAT_STATE },
+    { "glTexParameterfv", CAT_STATE },
+    { "glTexParameteri", CAT_STATE },
+    { "glTexParameteriv", CAT_STATE },
+    { "glTexParameterx", CAT_STATE },
+    { "glTexParameterxv", CAT_STATE },
+    { "glTexSubImage2D", CAT_UPLOAD },
+    { "glTranslatef", CAT_MATRIX },
+    { "glTranslatex", CAT_MATRIX },
+    { "glVertexPointer", CAT_STATE },
+    { "glViewport", CAT_STATE },
+};
+
+const char* GLTrace::ms_aacCategoryName[GLTrace::CAT_QUANTITY] =
+{
+    "marker",
+    "state",
+    "matrix",
+    "object",
+    "upload",
+    "draw",
+    "framebuffer",
+    "query"
+};
+
+//----------------------------------------------------------------------------
+int GLTrace::GetPrimitiveQuantity (unsigned int eMode, int iVertices)
+{
+    // The values of GL_POINTS through GL_TRIANGLE_FAN.  The trace does not
+    // depend on the GL headers.
+    switch (eMode)
+    {
+    case 0:  // points
+        return iVertices;
+    case 1:  // lines
+        return iVertices/2;
+    case 2:  // line loop
+        return (iVertices >= 2 ? iVertices : 0);
+    case 3:  // line strip
+        return (iVertices >= 2 ? iVertices-1 : 0);
+    case 4:  // triangles
+        return iVertices/3;
+    case 5:  // triangle strip
+    case 6:  // triangle fan
+        return (iVertices >= 3 ? iVertices-2 : 0);
+    }
+    return 0;
+}
+//----------------------------------------------------------------------------
+GLTrace::Record::Record ()
+{
+    Opcode = OP_FRAME;
+    Flags = 0;
+    Delta = 0;
+    Duration = 0;
+    ArgumentQuantity = 0;
+}
+//----------------------------------------------------------------------------
+// GLTraceWriter
+//----------------------------------------------------------------------------
+GLTraceWriter::GLTraceWriter ()
+{
+    m_pkFile = 0;
+    m_iUsed = 0;
+}
+//----------------------------------------------------------------------------
+GLTraceWriter::~GLTraceWriter ()
+{
+    Close();
+}
+//----------------------------------------------------------------------------
+bool GLTraceWriter::Open (const char* acFilename)
+{
+    Close();
+
+    m_pkFile = fopen(acFilename,"wb");
+    if (!m_pkFile)
+    {
+        return false;
+    }
+
+    m_aucBuffer[0] = 'W';
+    m_aucBuffer[1] = 'G';
+    m_aucBuffer[2] = 'G';
+    m_aucBuffer[3] = 'T';
+    m_iUsed = 4;
+    WriteWord(GLTrace::VERSION);
+    return true;
+}
+//----------------------------------------------------------------------------
+void GLTraceWriter::Close ()
+{
+    if (m_pkFile)
+    {
+        Flush();
+        fclose(m_pkFile);
+        m_pkFile = 0;
+    }
+}
+//----------------------------------------------------------------------------
+void GLTraceWriter::Write (const GLTrace::Record& rkRecord)
+{
+    assert(m_pkFile);
+    assert(0 <= rkRecord.ArgumentQuantity
+        && rkRecord.ArgumentQuantity <= GLTrace::MAX_ARGUMENTS);
+
+    int iBytes = GLTrace::RECORD_BYTES + 4*rkRecord.ArgumentQuantity;
+    if (m_iUsed + iBytes > BUFFER_BYTES)
+    {
+        Flush();
+    }
+
+    unsigned char* aucRecord = m_aucBuffer + m_iUsed;
+    aucRecord[0] = (unsigned char)rkRecord.Opcode;
+    aucRecord[1] = (unsigned char)rkRecord.Flags;
+    aucRecord[2] = (unsigned char)(rkRecord.ArgumentQuantity & 0xFF);
+    aucRecord[3] = (unsigned char)(rkRecord.ArgumentQuantity >> 8);
+    m_iUsed += 4;
+
+    WriteWord(rkRecord.Delta);
+    WriteWord(rkRecord.Duration);
+    for (int i = 0; i < rkRecord.ArgumentQuantity; i++)
+    {
+        WriteWord(rkRecord.Argument[i]);
+    }
+}
+//----------------------------------------------------------------------------
+void GLTraceWriter::Flush ()
+{
+    if (m_pkFile && m_iUsed > 0)
+    {
+        fwrite(m_aucBuffer,1,(size_t)m_iUsed,m_pkFile);
+        fflush(m_pkFile);
+    }
+    m_iUsed = 0;
+}
+//----------------------------------------------------------------------------
+void GLTraceWriter::WriteWord (unsigned int uiValue)
+{
+    unsigned char* aucWord = m_aucBuffer + m_iUsed;
+    aucWord[0] = (unsigned char)(uiValue & 0xFF);
+    aucWord[1] = (unsigned char)((uiValue >> 8) & 0xFF);
+    aucWord[2] = (unsigned char)((uiValue >> 16) & 0xFF);
+    aucWord[3] = (unsigned char)(uiValue >> 24);
+    m_iUsed += 4;
+}
+//----------------------------------------------------------------------------
+// GLTraceReader
+//----------------------------------------------------------------------------
+GLTraceReader::GLTraceReader ()
+{
+    m_pkFile = 0;
+}
+//----------------------------------------------------------------------------
+GLTraceReader::~GLTraceReader ()
+{
+    Close();
+}
+//----------------------------------------------------------------------------
+bool GLTraceReader::Open (const char* acFilename)
+{
+    Close();
+
+    m_pkFile = fopen(acFilename,"rb");
+    if (!m_pkFile)
+    {
+        return false;
+    }
+
+    char acMagic[4];
+    unsigned int uiVersion;
+    if (fread(acMagic,1,4,m_pkFile) != 4
+    ||  strncmp(acMagic,"WGGT",4) != 0
+    ||  !ReadWord(uiVersion)
+    ||  uiVersion != GLTrace::VERSION)
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+void GLTraceReader::Close ()
+{
+    if (m_pkFile)
+    {
+        fclose(m_pkFile);
+        m_pkFile = 0;
+    }
+}
+//----------------------------------------------------------------------------
+bool GLTraceReader::Read (GLTrace::Record& rkRecord)
+{
+    if (!m_pkFile)
+    {
+        return false;
+    }
+
+    unsigned char aucHeader[4];
+    if (fread(aucHeader,1,4,m_pkFile) != 4)
+    {
+        return false;
+    }
+
+    rkRecord.Opcode = aucHeader[0];
+    rkRecord.Flags = aucHeader[1];
+    rkRecord.ArgumentQuantity = aucHeader[2] | (aucHeader[3] << 8);
+    if (rkRecord.Opcode >= GLTrace::OP_QUANTITY
+    ||  rkRecord.ArgumentQuantity > GLTrace::MAX_ARGUMENTS)
+    {
+        return false;
+    }
+
+    if (!ReadWord(rkRecord.Delta) || !ReadWord(rkRecord.Duration))
+    {
+        return false;
+    }
+    for (int i = 0; i < rkRecord.ArgumentQuantity; i++)
+    {
+        if (!ReadWord(rkRecord.Argument[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+bool GLTraceReader::ReadWord (unsigned int& ruiValue)
+{
+    unsigned char aucWord[4];
+    if (fread(aucWord,1,4,m_pkFile) != 4)
+    {
+        return false;
+    }
+
+    ruiValue = (unsigned int)aucWord[0]
+        | ((unsigned int)aucWord[1] << 8)
+        | ((unsigned int)aucWord[2] << 16)
+        | ((unsigned int)aucWord[3] << 24);
+    return true;
+}
+//----------------------------------------------------------------------------
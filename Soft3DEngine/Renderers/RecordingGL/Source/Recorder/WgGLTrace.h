@@ -0,0 +1,324 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgGLTrace.h                        //
+//                                                       //
+//  - Interface for GL Trace class                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+
+#ifndef __WG_GLTRACE_H__
+#define __WG_GLTRACE_H__
+
+#include "WgRecordingGLLIB.h"
+#include "WgSystem.h"
+
+
+namespace WGSoft3D
+{
+
+// The command stream of the recording OpenGL ES 1.1 library.  A trace is a
+// file that starts with the 8-byte header
+//
+//   'W' 'G' 'G' 'T' version (u32)
+//
+// followed by one record per call:
+//
+//   opcode (u8), flags (u8), argument quantity (u16),
+//   delta (u32), duration (u32), arguments (u32 each)
+//
+// All the numbers are little endian.  The delta is the time in nanoseconds
+// from the start of the previous record to the start of this one, the
+// duration is the time spent in the call.  Both saturate at 0xFFFFFFFF.
+//
+// The arguments are the parameters of the call in order, as 32-bit words.
+// Floats are stored with their bits, booleans as 0 or 1.  The pointers that
+// a call dereferences are replaced by the data they point to (the values of
+// a glLightfv, the names of a glGenTextures) or, for pixels and buffer data,
+// by the size of the data in bytes.  In detail:
+//
+//   upload calls    The data pointer is replaced by the uploaded bytes and
+//                   moves to the end, so the last argument of every record
+//                   of CAT_UPLOAD is its byte count.
+//   draw calls      Two words follow the parameters:  the quantity of
+//                   vertices that the call references, and the bytes read
+//                   from client memory (the enabled arrays that are not in
+//                   buffer objects, and client memory indices).
+//   array pointers  The pointer is stored as its low 32 bits, the offset
+//                   when a buffer object is bound.
+//   gen and delete  The quantity followed by the names.  The names are
+//                   truncated to MAX_ARGUMENTS-1 words.
+//   queries         Only the parameters, not the answers.
+//
+// OP_FRAME is not a GL call.  GLRecorder::EndFrame writes it to end a frame.
+
+class WG3D_RENDERER_ITEM GLTrace
+{
+public:
+    enum Opcode
+    {
+        OP_FRAME,
+        OP_ACTIVE_TEXTURE,
+        OP_ALPHA_FUNC,
+        OP_ALPHA_FUNCX,
+        OP_BIND_BUFFER,
+        OP_BIND_TEXTURE,
+        OP_BLEND_FUNC,
+        OP_BUFFER_DATA,
+        OP_BUFFER_SUB_DATA,
+        OP_CLEAR,
+        OP_CLEAR_COLOR,
+        OP_CLEAR_COLORX,
+        OP_CLEAR_DEPTHF,
+        OP_CLEAR_DEPTHX,
+        OP_CLEAR_STENCIL,
+        OP_CLIENT_ACTIVE_TEXTURE,
+        OP_CLIP_PLANEF,
+        OP_CLIP_PLANEX,
+        OP_COLOR4F,
+        OP_COLOR4UB,
+        OP_COLOR4X,
+        OP_COLOR_MASK,
+        OP_COLOR_POINTER,
+        OP_COMPRESSED_TEX_IMAGE_2D,
+        OP_COMPRESSED_TEX_SUB_IMAGE_2D,
+        OP_COPY_TEX_IMAGE_2D,
+        OP_COPY_TEX_SUB_IMAGE_2D,
+        OP_CULL_FACE,
+        OP_DELETE_BUFFERS,
+        OP_DELETE_TEXTURES,
+        OP_DEPTH_FUNC,
+        OP_DEPTH_MASK,
+        OP_DEPTH_RANGEF,
+        OP_DEPTH_RANGEX,
+        OP_DISABLE,
+        OP_DISABLE_CLIENT_STATE,
+        OP_DRAW_ARRAYS,
+        OP_DRAW_ELEMENTS,
+        OP_ENABLE,
+        OP_ENABLE_CLIENT_STATE,
+        OP_FINISH,
+        OP_FLUSH,
+        OP_FOGF,
+        OP_FOGFV,
+        OP_FOGX,
+        OP_FOGXV,
+        OP_FRONT_FACE,
+        OP_FRUSTUMF,
+        OP_FRUSTUMX,
+        OP_GEN_BUFFERS,
+        OP_GEN_TEXTURES,
+        OP_GET_BOOLEANV,
+        OP_GET_BUFFER_PARAMETERIV,
+        OP_GET_CLIP_PLANEF,
+        OP_GET_CLIP_PLANEX,
+        OP_GET_ERROR,
+        OP_GET_FIXEDV,
+        OP_GET_FLOATV,
+        OP_GET_INTEGERV,
+        OP_GET_LIGHTFV,
+        OP_GET_LIGHTXV,
+        OP_GET_MATERIALFV,
+        OP_GET_MATERIALXV,
+        OP_GET_POINTERV,
+        OP_GET_STRING,
+        OP_GET_TEX_ENVFV,
+        OP_GET_TEX_ENVIV,
+        OP_GET_TEX_ENVXV,
+        OP_GET_TEX_PARAMETERFV,
+        OP_GET_TEX_PARAMETERIV,
+        OP_GET_TEX_PARAMETERXV,
+        OP_HINT,
+        OP_IS_BUFFER,
+        OP_IS_ENABLED,
+        OP_IS_TEXTURE,
+        OP_LIGHT_MODELF,
+        OP_LIGHT_MODELFV,
+        OP_LIGHT_MODELX,
+        OP_LIGHT_MODELXV,
+        OP_LIGHTF,
+        OP_LIGHTFV,
+        OP_LIGHTX,
+        OP_LIGHTXV,
+        OP_LINE_WIDTH,
+        OP_LINE_WIDTHX,
+        OP_LOAD_IDENTITY,
+        OP_LOAD_MATRIXF,
+        OP_LOAD_MATRIXX,
+        OP_LOGIC_OP,
+        OP_MATERIALF,
+        OP_MATERIALFV,
+        OP_MATERIALX,
+        OP_MATERIALXV,
+        OP_MATRIX_MODE,
+        OP_MULT_MATRIXF,
+        OP_MULT_MATRIXX,
+        OP_MULTI_TEX_COORD4F,
+        OP_MULTI_TEX_COORD4X,
+        OP_NORMAL3F,
+        OP_NORMAL3X,
+        OP_NORMAL_POINTER,
+        OP_ORTHOF,
+        OP_ORTHOX,
+        OP_PIXEL_STOREI,
+        OP_POINT_PARAMETERF,
+        OP_POINT_PARAMETERFV,
+        OP_POINT_PARAMETERX,
+        OP_POINT_PARAMETERXV,
+        OP_POINT_SIZE,
+        OP_POINT_SIZE_POINTER_OES,
+        OP_POINT_SIZEX,
+        OP_POLYGON_OFFSET,
+        OP_POLYGON_OFFSETX,
+        OP_POP_MATRIX,
+        OP_PUSH_MATRIX,
+        OP_READ_PIXELS,
+        OP_ROTATEF,
+        OP_ROTATEX,
+        OP_SAMPLE_COVERAGE,
+        OP_SAMPLE_COVERAGEX,
+        OP_SCALEF,
+        OP_SCALEX,
+        OP_SCISSOR,
+        OP_SHADE_MODEL,
+        OP_STENCIL_FUNC,
+        OP_STENCIL_MASK,
+        OP_STENCIL_OP,
+        OP_TEX_COORD_POINTER,
+        OP_TEX_ENVF,
+        OP_TEX_ENVFV,
+        OP_TEX_ENVI,
+        OP_TEX_ENVIV,
+        OP_TEX_ENVX,
+        OP_TEX_ENVXV,
+        OP_TEX_IMAGE_2D,
+        OP_TEX_PARAMETERF,
+        OP_TEX_PARAMETERFV,
+        OP_TEX_PARAMETERI,
+        OP_TEX_PARAMETERIV,
+        OP_TEX_PARAMETERX,
+        OP_TEX_PARAMETERXV,
+        OP_TEX_SUB_IMAGE_2D,
+        OP_TRANSLATEF,
+        OP_TRANSLATEX,
+        OP_VERTEX_POINTER,
+        OP_VIEWPORT,
+        OP_QUANTITY
+    };
+
+    enum Category
+    {
+        CAT_MARKER,       // OP_FRAME
+        CAT_STATE,        // sets state, may be redundant
+        CAT_MATRIX,       // matrix stack
+        CAT_OBJECT,       // creates or deletes texture and buffer names
+        CAT_UPLOAD,       // copies client data to textures and buffers
+        CAT_DRAW,         // glDrawArrays, glDrawElements
+        CAT_FRAMEBUFFER,  // clears, reads, copies, flush and finish
+        CAT_QUERY,        // glGet*, glIs*
+        CAT_QUANTITY
+    };
+
+    enum Flag
+    {
+        // The call changed nothing.  Only state calls are tested.
+        FLAG_REDUNDANT = 1,
+
+        // The call generated a GL error and was ignored.
+        FLAG_ERROR = 2,
+
+        // A draw call read outside its arrays or buffer objects.  GL leaves
+        // the result undefined, so this is not a GL error.
+        FLAG_OUT_OF_RANGE = 4
+    };
+
+    enum
+    {
+        VERSION = 1,
+        MAX_ARGUMENTS = 64,
+        HEADER_BYTES = 8,
+        RECORD_BYTES = 12
+    };
+
+    static const char* GetName (int eOpcode);
+    static int GetCategory (int eOpcode);
+    static const char* GetCategoryName (int eCategory);
+
+    // the quantity of primitives a draw of iVertices vertices produces
+    static int GetPrimitiveQuantity (unsigned int eMode, int iVertices);
+
+    class WG3D_RENDERER_ITEM Record
+    {
+    public:
+        Record ();
+
+        int Opcode;
+        int Flags;
+        unsigned int Delta;
+        unsigned int Duration;
+        int ArgumentQuantity;
+        unsigned int Argument[MAX_ARGUMENTS];
+    };
+
+private:
+    class Info
+    {
+    public:
+        const char* Name;
+        int Category;
+    };
+
+    static const Info ms_akInfo[OP_QUANTITY];
+    static const char* ms_aacCategoryName[CAT_QUANTITY];
+};
+
+// Writes a trace to a file.  The records are buffered.
+class WG3D_RENDERER_ITEM GLTraceWriter
+{
+public:
+    GLTraceWriter ();
+    ~GLTraceWriter ();
+
+    bool Open (const char* acFilename);
+    void Close ();
+    bool IsOpen () const;
+
+    void Write (const GLTrace::Record& rkRecord);
+    void Flush ();
+
+private:
+    void WriteWord (unsigned int uiValue);
+
+    enum { BUFFER_BYTES = 65536 };
+
+    FILE* m_pkFile;
+    int m_iUsed;
+    unsigned char m_aucBuffer[BUFFER_BYTES];
+};
+
+// Reads a trace from a file.
+class WG3D_RENDERER_ITEM GLTraceReader
+{
+public:
+    GLTraceReader ();
+    ~GLTraceReader ();
+
+    // Fails when the file does not exist or its header is not a trace of
+    // this version.
+    bool Open (const char* acFilename);
+    void Close ();
+
+    // Returns false at the end of the trace or at a truncated record.
+    bool Read (GLTrace::Record& rkRecord);
+
+private:
+    bool ReadWord (unsigned int& ruiValue);
+
+    FILE* m_pkFile;
+};
+
+#include "WgGLTrace.inl"
+
+}
+
+#endif
@@ -0,0 +1,32 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgGLTrace.inl                      //
+//                                                       //
+//  - Inlines for GL Trace class                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+inline const char* GLTrace::GetName (int eOpcode)
+{
+    assert(0 <= eOpcode && eOpcode < OP_QUANTITY);
+    return ms_akInfo[eOpcode].Name;
+}
+//----------------------------------------------------------------------------
+inline int GLTrace::GetCategory (int eOpcode)
+{
+    assert(0 <= eOpcode && eOpcode < OP_QUANTITY);
+    return ms_akInfo[eOpcode].Category;
+}
+//----------------------------------------------------------------------------
+inline const char* GLTrace::GetCategoryName (int eCategory)
+{
+    assert(0 <= eCategory && eCategory < CAT_QUANTITY);
+    return ms_aacCategoryName[eCategory];
+}
+//----------------------------------------------------------------------------
+inline bool GLTraceWriter::IsOpen () const
+{
+    return m_pkFile != 0;
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,1659 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgRecordingGL.cpp                  //
+//                                                       //
+//  - Implementation for Recording GL entry points       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+// The OpenGL ES 1.1 common profile entry points of the recording library.
+// Each one records its call and forwards it to the GLRecorder context.  The
+// library is built with __GL_EXPORTS defined, so GL_API exports the
+// functions.
+
+#include "WgRecordingGLPCH.h"
+#include "WgGLRecorder.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+// conversions
+//----------------------------------------------------------------------------
+static float FixedToFloat (GLfixed iValue)
+{
+    return (float)iValue/65536.0f;
+}
+//----------------------------------------------------------------------------
+static GLfixed FloatToFixed (double dValue)
+{
+    double dFixed = dValue*65536.0;
+    if (dFixed >= 2147483647.0)
+    {
+        return 0x7FFFFFFF;
+    }
+    if (dFixed <= -2147483648.0)
+    {
+        return (GLfixed)0x80000000;
+    }
+    return (GLfixed)(dFixed < 0.0 ? dFixed - 0.5 : dFixed + 0.5);
+}
+//----------------------------------------------------------------------------
+static float ColorToFloat (GLint iValue)
+{
+    // the linear map of [-2^31,2^31-1] to [-1,1]
+    return (float)((2.0*(double)iValue + 1.0)/4294967295.0);
+}
+//----------------------------------------------------------------------------
+static void CopyParams (int iQuantity, const GLfloat* afParam,
+    float* afValue)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        afValue[i] = (i < iQuantity ? afParam[i] : 0.0f);
+    }
+}
+//----------------------------------------------------------------------------
+static void FixedParams (GLenum ePName, int iQuantity, const GLfixed* aiParam,
+    float* afValue)
+{
+    // enumerants are passed unconverted
+    bool bEnum = GLRecorder::IsEnumParameter(ePName);
+    for (int i = 0; i < 4; i++)
+    {
+        afValue[i] = (i < iQuantity ?
+            (bEnum ? (float)aiParam[i] : FixedToFloat(aiParam[i])) : 0.0f);
+    }
+}
+//----------------------------------------------------------------------------
+static void IntegerParams (GLenum ePName, int iQuantity, const GLint* aiParam,
+    float* afValue)
+{
+    // colors are mapped to [-1,1]
+    bool bColor = (ePName == GL_TEXTURE_ENV_COLOR);
+    for (int i = 0; i < 4; i++)
+    {
+        afValue[i] = (i < iQuantity ?
+            (bColor ? ColorToFloat(aiParam[i]) : (float)aiParam[i]) : 0.0f);
+    }
+}
+//----------------------------------------------------------------------------
+static void FixedMatrix (const GLfixed* aiMatrix, float* afMatrix)
+{
+    for (int i = 0; i < 16; i++)
+    {
+        afMatrix[i] = FixedToFloat(aiMatrix[i]);
+    }
+}
+//----------------------------------------------------------------------------
+static void GetBooleans (int iQuantity, const double* adValue,
+    GLboolean* abValue)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        abValue[i] = (adValue[i] != 0.0 ? GL_TRUE : GL_FALSE);
+    }
+}
+//----------------------------------------------------------------------------
+static void GetIntegers (int iQuantity, int eKind, const double* adValue,
+    GLint* aiValue)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        double dValue = adValue[i];
+        if (eKind == GLRecorder::VK_FLOAT)
+        {
+            dValue = floor(dValue + 0.5);
+        }
+        else if (eKind == GLRecorder::VK_COLOR)
+        {
+            dValue = (4294967295.0*dValue - 1.0)/2.0;
+        }
+
+        // names and masks are unsigned
+        if (dValue > 2147483647.0)
+        {
+            aiValue[i] = (dValue <= 4294967295.0 &&
+                eKind != GLRecorder::VK_COLOR ?
+                (GLint)(GLuint)dValue : 0x7FFFFFFF);
+        }
+        else if (dValue < -2147483648.0)
+        {
+            aiValue[i] = (GLint)0x80000000;
+        }
+        else
+        {
+            aiValue[i] = (GLint)dValue;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+static void GetFixeds (int iQuantity, int eKind, const double* adValue,
+    GLfixed* aiValue)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        // enumerants are returned unconverted, as they are passed
+        aiValue[i] = (eKind == GLRecorder::VK_ENUM ? (GLfixed)adValue[i] :
+            FloatToFixed(adValue[i]));
+    }
+}
+//----------------------------------------------------------------------------
+static void GetFloats (int iQuantity, const double* adValue,
+    GLfloat* afValue)
+{
+    for (int i = 0; i < iQuantity; i++)
+    {
+        afValue[i] = (GLfloat)adValue[i];
+    }
+}
+//----------------------------------------------------------------------------
+// shared implementations of the float, fixed and integer variants
+//----------------------------------------------------------------------------
+static GLRecorder& Context ()
+{
+    return GLRecorder::GetContext();
+}
+//----------------------------------------------------------------------------
+static void Fog (GLRecorder::Call& rkCall, GLenum ePName,
+    const float* afParam, bool bScalar)
+{
+    if (bScalar && GLRecorder::GetFogQuantity(ePName) > 1)
+    {
+        Context().SetError(GL_INVALID_ENUM);
+        return;
+    }
+    rkCall.Changed(Context().Fog(ePName,afParam));
+}
+//----------------------------------------------------------------------------
+static void Light (GLRecorder::Call& rkCall, GLenum eLight, GLenum ePName,
+    const float* afParam, bool bScalar)
+{
+    if (bScalar && GLRecorder::GetLightQuantity(ePName) > 1)
+    {
+        Context().SetError(GL_INVALID_ENUM);
+        return;
+    }
+    rkCall.Changed(Context().Light(eLight,ePName,afParam));
+}
+//----------------------------------------------------------------------------
+static void LightModel (GLRecorder::Call& rkCall, GLenum ePName,
+    const float* afParam, bool bScalar)
+{
+    if (bScalar && GLRecorder::GetLightModelQuantity(ePName) > 1)
+    {
+        Context().SetError(GL_INVALID_ENUM);
+        return;
+    }
+    rkCall.Changed(Context().LightModel(ePName,afParam));
+}
+//----------------------------------------------------------------------------
+static void Material (GLRecorder::Call& rkCall, GLenum eFace, GLenum ePName,
+    const float* afParam, bool bScalar)
+{
+    if (bScalar && GLRecorder::GetMaterialQuantity(ePName) > 1)
+    {
+        Context().SetError(GL_INVALID_ENUM);
+        return;
+    }
+    rkCall.Changed(Context().Material(eFace,ePName,afParam));
+}
+//----------------------------------------------------------------------------
+static void PointParameter (GLRecorder::Call& rkCall, GLenum ePName,
+    const float* afParam, bool bScalar)
+{
+    if (bScalar && GLRecorder::GetPointParameterQuantity(ePName) > 1)
+    {
+        Context().SetError(GL_INVALID_ENUM);
+        return;
+    }
+    rkCall.Changed(Context().PointParameter(ePName,afParam));
+}
+//----------------------------------------------------------------------------
+static void TexEnv (GLRecorder::Call& rkCall, GLenum eTarget, GLenum ePName,
+    const float* afParam, bool bScalar)
+{
+    if (bScalar && GLRecorder::GetTexEnvQuantity(ePName) > 1)
+    {
+        Context().SetError(GL_INVALID_ENUM);
+        return;
+    }
+    rkCall.Changed(Context().TexEnv(eTarget,ePName,afParam));
+}
+//----------------------------------------------------------------------------
+static void ArrayPointer (GLRecorder::Call& rkCall, int iArray, GLint iSize,
+    GLenum eType, GLsizei iStride, const GLvoid* pvPointer)
+{
+    if (iSize >= 0)
+    {
+        rkCall.Word((unsigned int)iSize);
+    }
+    rkCall.Word(eType);
+    rkCall.Word((unsigned int)iStride);
+    rkCall.Word((unsigned int)(size_t)pvPointer);
+    rkCall.Changed(Context().ArrayPointer(iArray,(iSize >= 0 ? iSize :
+        (iArray == GLRecorder::ARRAY_NORMAL ? 3 : 1)),eType,iStride,
+        pvPointer));
+}
+//----------------------------------------------------------------------------
+static void RecordNames (GLRecorder::Call& rkCall, GLsizei iQuantity,
+    const GLuint* auiName)
+{
+    rkCall.Word((unsigned int)iQuantity);
+    if (iQuantity > 0)
+    {
+        int iRecorded = (iQuantity < GLTrace::MAX_ARGUMENTS-1 ? iQuantity :
+            GLTrace::MAX_ARGUMENTS-1);
+        rkCall.Words(iRecorded,auiName);
+    }
+}
+//----------------------------------------------------------------------------
+// floating-point entry points
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glAlphaFunc (GLenum func, GLclampf ref)
+{
+    GLRecorder::Call kCall(GLTrace::OP_ALPHA_FUNC);
+    kCall.Word(func);
+    kCall.Float(ref);
+    kCall.Changed(Context().AlphaFunc(func,ref));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glClearColor (GLclampf red, GLclampf green,
+    GLclampf blue, GLclampf alpha)
+{
+    GLRecorder::Call kCall(GLTrace::OP_CLEAR_COLOR);
+    float afColor[4] = { red, green, blue, alpha };
+    kCall.Words(4,afColor);
+    kCall.Changed(Context().ClearColor(afColor));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glClearDepthf (GLclampf depth)
+{
+    GLRecorder::Call kCall(GLTrace::OP_CLEAR_DEPTHF);
+    kCall.Float(depth);
+    kCall.Changed(Context().ClearDepth(depth));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glClipPlanef (GLenum plane, const GLfloat *equation)
+{
+    GLRecorder::Call kCall(GLTrace::OP_CLIP_PLANEF);
+    kCall.Word(plane);
+    kCall.Words(4,equation);
+    kCall.Changed(Context().ClipPlane(plane,equation));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glColor4f (GLfloat red, GLfloat green, GLfloat blue,
+    GLfloat alpha)
+{
+    GLRecorder::Call kCall(GLTrace::OP_COLOR4F);
+    float afColor[4] = { red, green, blue, alpha };
+    kCall.Words(4,afColor);
+    kCall.Changed(Context().Color(afColor));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glDepthRangef (GLclampf zNear, GLclampf zFar)
+{
+    GLRecorder::Call kCall(GLTrace::OP_DEPTH_RANGEF);
+    kCall.Float(zNear);
+    kCall.Float(zFar);
+    kCall.Changed(Context().DepthRange(zNear,zFar));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glFogf (GLenum pname, GLfloat param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_FOGF);
+    kCall.Word(pname);
+    kCall.Float(param);
+    float afParam[4];
+    CopyParams(1,&param,afParam);
+    Fog(kCall,pname,afParam,true);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glFogfv (GLenum pname, const GLfloat *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_FOGFV);
+    int iQuantity = GLRecorder::GetFogQuantity(pname);
+    kCall.Word(pname);
+    kCall.Words(iQuantity,params);
+    float afParam[4];
+    CopyParams(iQuantity,params,afParam);
+    Fog(kCall,pname,afParam,false);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glFrustumf (GLfloat left, GLfloat right,
+    GLfloat bottom, GLfloat top, GLfloat zNear, GLfloat zFar)
+{
+    GLRecorder::Call kCall(GLTrace::OP_FRUSTUMF);
+    float afParam[6] = { left, right, bottom, top, zNear, zFar };
+    kCall.Words(6,afParam);
+    kCall.Changed(Context().Frustum(left,right,bottom,top,zNear,zFar));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetClipPlanef (GLenum pname, GLfloat eqn[4])
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_CLIP_PLANEF);
+    kCall.Word(pname);
+    double adValue[4];
+    GetFloats(Context().GetClipPlane(pname,adValue),adValue,eqn);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetFloatv (GLenum pname, GLfloat *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_FLOATV);
+    kCall.Word(pname);
+    double adValue[16];
+    int eKind;
+    GetFloats(Context().GetValue(pname,adValue,eKind),adValue,params);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetLightfv (GLenum light, GLenum pname,
+    GLfloat *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_LIGHTFV);
+    kCall.Word(light);
+    kCall.Word(pname);
+    double adValue[4];
+    GetFloats(Context().GetLight(light,pname,adValue),adValue,params);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetMaterialfv (GLenum face, GLenum pname,
+    GLfloat *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_MATERIALFV);
+    kCall.Word(face);
+    kCall.Word(pname);
+    double adValue[4];
+    GetFloats(Context().GetMaterial(face,pname,adValue),adValue,params);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetTexEnvfv (GLenum env, GLenum pname,
+    GLfloat *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_TEX_ENVFV);
+    kCall.Word(env);
+    kCall.Word(pname);
+    double adValue[4];
+    int eKind;
+    GetFloats(Context().GetTexEnv(env,pname,adValue,eKind),adValue,params);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetTexParameterfv (GLenum target, GLenum pname,
+    GLfloat *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_TEX_PARAMETERFV);
+    kCall.Word(target);
+    kCall.Word(pname);
+    double adValue[1];
+    int eKind;
+    GetFloats(Context().GetTexParameter(target,pname,adValue,eKind),
+        adValue,params);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glLightModelf (GLenum pname, GLfloat param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_LIGHT_MODELF);
+    kCall.Word(pname);
+    kCall.Float(param);
+    float afParam[4];
+    CopyParams(1,&param,afParam);
+    LightModel(kCall,pname,afParam,true);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glLightModelfv (GLenum pname, const GLfloat *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_LIGHT_MODELFV);
+    int iQuantity = GLRecorder::GetLightModelQuantity(pname);
+    kCall.Word(pname);
+    kCall.Words(iQuantity,params);
+    float afParam[4];
+    CopyParams(iQuantity,params,afParam);
+    LightModel(kCall,pname,afParam,false);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glLightf (GLenum light, GLenum pname, GLfloat param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_LIGHTF);
+    kCall.Word(light);
+    kCall.Word(pname);
+    kCall.Float(param);
+    float afParam[4];
+    CopyParams(1,&param,afParam);
+    Light(kCall,light,pname,afParam,true);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glLightfv (GLenum light, GLenum pname,
+    const GLfloat *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_LIGHTFV);
+    int iQuantity = GLRecorder::GetLightQuantity(pname);
+    kCall.Word(light);
+    kCall.Word(pname);
+    kCall.Words(iQuantity,params);
+    float afParam[4];
+    CopyParams(iQuantity,params,afParam);
+    Light(kCall,light,pname,afParam,false);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glLineWidth (GLfloat width)
+{
+    GLRecorder::Call kCall(GLTrace::OP_LINE_WIDTH);
+    kCall.Float(width);
+    kCall.Changed(Context().LineWidth(width));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glLoadMatrixf (const GLfloat *m)
+{
+    GLRecorder::Call kCall(GLTrace::OP_LOAD_MATRIXF);
+    kCall.Words(16,m);
+    kCall.Changed(Context().LoadMatrix(m));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glMaterialf (GLenum face, GLenum pname,
+    GLfloat param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_MATERIALF);
+    kCall.Word(face);
+    kCall.Word(pname);
+    kCall.Float(param);
+    float afParam[4];
+    CopyParams(1,&param,afParam);
+    Material(kCall,face,pname,afParam,true);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glMaterialfv (GLenum face, GLenum pname,
+    const GLfloat *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_MATERIALFV);
+    int iQuantity = GLRecorder::GetMaterialQuantity(pname);
+    kCall.Word(face);
+    kCall.Word(pname);
+    kCall.Words(iQuantity,params);
+    float afParam[4];
+    CopyParams(iQuantity,params,afParam);
+    Material(kCall,face,pname,afParam,false);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glMultMatrixf (const GLfloat *m)
+{
+    GLRecorder::Call kCall(GLTrace::OP_MULT_MATRIXF);
+    kCall.Words(16,m);
+    kCall.Changed(Context().MultMatrix(m));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glMultiTexCoord4f (GLenum target, GLfloat s,
+    GLfloat t, GLfloat r, GLfloat q)
+{
+    GLRecorder::Call kCall(GLTrace::OP_MULTI_TEX_COORD4F);
+    float afCoord[4] = { s, t, r, q };
+    kCall.Word(target);
+    kCall.Words(4,afCoord);
+    kCall.Changed(Context().MultiTexCoord(target,afCoord));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glNormal3f (GLfloat nx, GLfloat ny, GLfloat nz)
+{
+    GLRecorder::Call kCall(GLTrace::OP_NORMAL3F);
+    float afNormal[3] = { nx, ny, nz };
+    kCall.Words(3,afNormal);
+    kCall.Changed(Context().Normal(afNormal));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glOrthof (GLfloat left, GLfloat right,
+    GLfloat bottom, GLfloat top, GLfloat zNear, GLfloat zFar)
+{
+    GLRecorder::Call kCall(GLTrace::OP_ORTHOF);
+    float afParam[6] = { left, right, bottom, top, zNear, zFar };
+    kCall.Words(6,afParam);
+    kCall.Changed(Context().Ortho(left,right,bottom,top,zNear,zFar));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glPointParameterf (GLenum pname, GLfloat param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_POINT_PARAMETERF);
+    kCall.Word(pname);
+    kCall.Float(param);
+    float afParam[4];
+    CopyParams(1,&param,afParam);
+    PointParameter(kCall,pname,afParam,true);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glPointParameterfv (GLenum pname,
+    const GLfloat *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_POINT_PARAMETERFV);
+    int iQuantity = GLRecorder::GetPointParameterQuantity(pname);
+    kCall.Word(pname);
+    kCall.Words(iQuantity,params);
+    float afParam[4];
+    CopyParams(iQuantity,params,afParam);
+    PointParameter(kCall,pname,afParam,false);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glPointSize (GLfloat size)
+{
+    GLRecorder::Call kCall(GLTrace::OP_POINT_SIZE);
+    kCall.Float(size);
+    kCall.Changed(Context().PointSize(size));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glPolygonOffset (GLfloat factor, GLfloat units)
+{
+    GLRecorder::Call kCall(GLTrace::OP_POLYGON_OFFSET);
+    kCall.Float(factor);
+    kCall.Float(units);
+    kCall.Changed(Context().PolygonOffset(factor,units));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glRotatef (GLfloat angle, GLfloat x, GLfloat y,
+    GLfloat z)
+{
+    GLRecorder::Call kCall(GLTrace::OP_ROTATEF);
+    float afParam[4] = { angle, x, y, z };
+    kCall.Words(4,afParam);
+    kCall.Changed(Context().Rotate(angle,x,y,z));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glScalef (GLfloat x, GLfloat y, GLfloat z)
+{
+    GLRecorder::Call kCall(GLTrace::OP_SCALEF);
+    float afParam[3] = { x, y, z };
+    kCall.Words(3,afParam);
+    kCall.Changed(Context().Scale(x,y,z));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTexEnvf (GLenum target, GLenum pname,
+    GLfloat param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TEX_ENVF);
+    kCall.Word(target);
+    kCall.Word(pname);
+    kCall.Float(param);
+    float afParam[4];
+    CopyParams(1,&param,afParam);
+    TexEnv(kCall,target,pname,afParam,true);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTexEnvfv (GLenum target, GLenum pname,
+    const GLfloat *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TEX_ENVFV);
+    int iQuantity = GLRecorder::GetTexEnvQuantity(pname);
+    kCall.Word(target);
+    kCall.Word(pname);
+    kCall.Words(iQuantity,params);
+    float afParam[4];
+    CopyParams(iQuantity,params,afParam);
+    TexEnv(kCall,target,pname,afParam,false);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTexParameterf (GLenum target, GLenum pname,
+    GLfloat param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TEX_PARAMETERF);
+    kCall.Word(target);
+    kCall.Word(pname);
+    kCall.Float(param);
+    kCall.Changed(Context().TexParameter(target,pname,param));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTexParameterfv (GLenum target, GLenum pname,
+    const GLfloat *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TEX_PARAMETERFV);
+    kCall.Word(target);
+    kCall.Word(pname);
+    kCall.Words(1,params);
+    kCall.Changed(Context().TexParameter(target,pname,params[0]));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTranslatef (GLfloat x, GLfloat y, GLfloat z)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TRANSLATEF);
+    float afParam[3] = { x, y, z };
+    kCall.Words(3,afParam);
+    kCall.Changed(Context().Translate(x,y,z));
+}
+//----------------------------------------------------------------------------
+// fixed-point and common entry points
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glActiveTexture (GLenum texture)
+{
+    GLRecorder::Call kCall(GLTrace::OP_ACTIVE_TEXTURE);
+    kCall.Word(texture);
+    kCall.Changed(Context().ActiveTexture(texture));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glAlphaFuncx (GLenum func, GLclampx ref)
+{
+    GLRecorder::Call kCall(GLTrace::OP_ALPHA_FUNCX);
+    kCall.Word(func);
+    kCall.Word((unsigned int)ref);
+    kCall.Changed(Context().AlphaFunc(func,FixedToFloat(ref)));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glBindBuffer (GLenum target, GLuint buffer)
+{
+    GLRecorder::Call kCall(GLTrace::OP_BIND_BUFFER);
+    kCall.Word(target);
+    kCall.Word(buffer);
+    kCall.Changed(Context().BindBuffer(target,buffer));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glBindTexture (GLenum target, GLuint texture)
+{
+    GLRecorder::Call kCall(GLTrace::OP_BIND_TEXTURE);
+    kCall.Word(target);
+    kCall.Word(texture);
+    kCall.Changed(Context().BindTexture(target,texture));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glBlendFunc (GLenum sfactor, GLenum dfactor)
+{
+    GLRecorder::Call kCall(GLTrace::OP_BLEND_FUNC);
+    kCall.Word(sfactor);
+    kCall.Word(dfactor);
+    kCall.Changed(Context().BlendFunc(sfactor,dfactor));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glBufferData (GLenum target, GLsizeiptr size,
+    const GLvoid *data, GLenum usage)
+{
+    GLRecorder::Call kCall(GLTrace::OP_BUFFER_DATA);
+    kCall.Word(target);
+    kCall.Word((unsigned int)size);
+    kCall.Word(usage);
+    kCall.Word((unsigned int)Context().BufferData(target,size,data,usage));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glBufferSubData (GLenum target, GLintptr offset,
+    GLsizeiptr size, const GLvoid *data)
+{
+    GLRecorder::Call kCall(GLTrace::OP_BUFFER_SUB_DATA);
+    kCall.Word(target);
+    kCall.Word((unsigned int)offset);
+    kCall.Word((unsigned int)size);
+    kCall.Word((unsigned int)Context().BufferSubData(target,offset,size,
+        data));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glClear (GLbitfield mask)
+{
+    GLRecorder::Call kCall(GLTrace::OP_CLEAR);
+    kCall.Word(mask);
+    Context().Clear(mask);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glClearColorx (GLclampx red, GLclampx green,
+    GLclampx blue, GLclampx alpha)
+{
+    GLRecorder::Call kCall(GLTrace::OP_CLEAR_COLORX);
+    GLfixed aiColor[4] = { red, green, blue, alpha };
+    kCall.Words(4,aiColor);
+    float afColor[4] = { FixedToFloat(red), FixedToFloat(green),
+        FixedToFloat(blue), FixedToFloat(alpha) };
+    kCall.Changed(Context().ClearColor(afColor));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glClearDepthx (GLclampx depth)
+{
+    GLRecorder::Call kCall(GLTrace::OP_CLEAR_DEPTHX);
+    kCall.Word((unsigned int)depth);
+    kCall.Changed(Context().ClearDepth(FixedToFloat(depth)));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glClearStencil (GLint s)
+{
+    GLRecorder::Call kCall(GLTrace::OP_CLEAR_STENCIL);
+    kCall.Word((unsigned int)s);
+    kCall.Changed(Context().ClearStencil(s));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glClientActiveTexture (GLenum texture)
+{
+    GLRecorder::Call kCall(GLTrace::OP_CLIENT_ACTIVE_TEXTURE);
+    kCall.Word(texture);
+    kCall.Changed(Context().ClientActiveTexture(texture));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glClipPlanex (GLenum plane, const GLfixed *equation)
+{
+    GLRecorder::Call kCall(GLTrace::OP_CLIP_PLANEX);
+    kCall.Word(plane);
+    kCall.Words(4,equation);
+    float afEquation[4];
+    for (int i = 0; i < 4; i++)
+    {
+        afEquation[i] = FixedToFloat(equation[i]);
+    }
+    kCall.Changed(Context().ClipPlane(plane,afEquation));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glColor4ub (GLubyte red, GLubyte green,
+    GLubyte blue, GLubyte alpha)
+{
+    GLRecorder::Call kCall(GLTrace::OP_COLOR4UB);
+    kCall.Word(red);
+    kCall.Word(green);
+    kCall.Word(blue);
+    kCall.Word(alpha);
+    float afColor[4] = { red/255.0f, green/255.0f, blue/255.0f,
+        alpha/255.0f };
+    kCall.Changed(Context().Color(afColor));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glColor4x (GLfixed red, GLfixed green, GLfixed blue,
+    GLfixed alpha)
+{
+    GLRecorder::Call kCall(GLTrace::OP_COLOR4X);
+    GLfixed aiColor[4] = { red, green, blue, alpha };
+    kCall.Words(4,aiColor);
+    float afColor[4] = { FixedToFloat(red), FixedToFloat(green),
+        FixedToFloat(blue), FixedToFloat(alpha) };
+    kCall.Changed(Context().Color(afColor));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glColorMask (GLboolean red, GLboolean green,
+    GLboolean blue, GLboolean alpha)
+{
+    GLRecorder::Call kCall(GLTrace::OP_COLOR_MASK);
+    kCall.Word(red ? 1 : 0);
+    kCall.Word(green ? 1 : 0);
+    kCall.Word(blue ? 1 : 0);
+    kCall.Word(alpha ? 1 : 0);
+    kCall.Changed(Context().ColorMask(red != GL_FALSE,green != GL_FALSE,
+        blue != GL_FALSE,alpha != GL_FALSE));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glColorPointer (GLint size, GLenum type,
+    GLsizei stride, const GLvoid *pointer)
+{
+    GLRecorder::Call kCall(GLTrace::OP_COLOR_POINTER);
+    ArrayPointer(kCall,GLRecorder::ARRAY_COLOR,size,type,stride,pointer);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glCompressedTexImage2D (GLenum target, GLint level,
+    GLenum internalformat, GLsizei width, GLsizei height, GLint border,
+    GLsizei imageSize, const GLvoid *data)
+{
+    GLRecorder::Call kCall(GLTrace::OP_COMPRESSED_TEX_IMAGE_2D);
+    kCall.Word(target);
+    kCall.Word((unsigned int)level);
+    kCall.Word(internalformat);
+    kCall.Word((unsigned int)width);
+    kCall.Word((unsigned int)height);
+    kCall.Word((unsigned int)border);
+    kCall.Word((unsigned int)imageSize);
+    kCall.Word((unsigned int)Context().CompressedTexImage2D(target,level,
+        internalformat,width,height,border,imageSize,data));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glCompressedTexSubImage2D (GLenum target,
+    GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
+    GLenum format, GLsizei imageSize, const GLvoid *data)
+{
+    GLRecorder::Call kCall(GLTrace::OP_COMPRESSED_TEX_SUB_IMAGE_2D);
+    kCall.Word(target);
+    kCall.Word((unsigned int)level);
+    kCall.Word((unsigned int)xoffset);
+    kCall.Word((unsigned int)yoffset);
+    kCall.Word((unsigned int)width);
+    kCall.Word((unsigned int)height);
+    kCall.Word(format);
+    kCall.Word((unsigned int)imageSize);
+    kCall.Word((unsigned int)Context().CompressedTexSubImage2D(target,level,
+        xoffset,yoffset,width,height,format,imageSize,data));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glCopyTexImage2D (GLenum target, GLint level,
+    GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height,
+    GLint border)
+{
+    GLRecorder::Call kCall(GLTrace::OP_COPY_TEX_IMAGE_2D);
+    kCall.Word(target);
+    kCall.Word((unsigned int)level);
+    kCall.Word(internalformat);
+    kCall.Word((unsigned int)x);
+    kCall.Word((unsigned int)y);
+    kCall.Word((unsigned int)width);
+    kCall.Word((unsigned int)height);
+    kCall.Word((unsigned int)border);
+    kCall.Word((unsigned int)Context().CopyTexImage2D(target,level,
+        internalformat,x,y,width,height,border));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glCopyTexSubImage2D (GLenum target, GLint level,
+    GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width,
+    GLsizei height)
+{
+    GLRecorder::Call kCall(GLTrace::OP_COPY_TEX_SUB_IMAGE_2D);
+    kCall.Word(target);
+    kCall.Word((unsigned int)level);
+    kCall.Word((unsigned int)xoffset);
+    kCall.Word((unsigned int)yoffset);
+    kCall.Word((unsigned int)x);
+    kCall.Word((unsigned int)y);
+    kCall.Word((unsigned int)width);
+    kCall.Word((unsigned int)height);
+    kCall.Word((unsigned int)Context().CopyTexSubImage2D(target,level,
+        xoffset,yoffset,x,y,width,height));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glCullFace (GLenum mode)
+{
+    GLRecorder::Call kCall(GLTrace::OP_CULL_FACE);
+    kCall.Word(mode);
+    kCall.Changed(Context().CullFace(mode));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glDeleteBuffers (GLsizei n, const GLuint *buffers)
+{
+    GLRecorder::Call kCall(GLTrace::OP_DELETE_BUFFERS);
+    RecordNames(kCall,n,buffers);
+    Context().DeleteNames(false,n,buffers);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glDeleteTextures (GLsizei n, const GLuint *textures)
+{
+    GLRecorder::Call kCall(GLTrace::OP_DELETE_TEXTURES);
+    RecordNames(kCall,n,textures);
+    Context().DeleteNames(true,n,textures);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glDepthFunc (GLenum func)
+{
+    GLRecorder::Call kCall(GLTrace::OP_DEPTH_FUNC);
+    kCall.Word(func);
+    kCall.Changed(Context().DepthFunc(func));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glDepthMask (GLboolean flag)
+{
+    GLRecorder::Call kCall(GLTrace::OP_DEPTH_MASK);
+    kCall.Word(flag ? 1 : 0);
+    kCall.Changed(Context().DepthMask(flag != GL_FALSE));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glDepthRangex (GLclampx zNear, GLclampx zFar)
+{
+    GLRecorder::Call kCall(GLTrace::OP_DEPTH_RANGEX);
+    kCall.Word((unsigned int)zNear);
+    kCall.Word((unsigned int)zFar);
+    kCall.Changed(Context().DepthRange(FixedToFloat(zNear),
+        FixedToFloat(zFar)));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glDisable (GLenum cap)
+{
+    GLRecorder::Call kCall(GLTrace::OP_DISABLE);
+    kCall.Word(cap);
+    kCall.Changed(Context().SetCapability(cap,false));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glDisableClientState (GLenum array)
+{
+    GLRecorder::Call kCall(GLTrace::OP_DISABLE_CLIENT_STATE);
+    kCall.Word(array);
+    kCall.Changed(Context().SetClientState(array,false));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glDrawArrays (GLenum mode, GLint first,
+    GLsizei count)
+{
+    GLRecorder::Call kCall(GLTrace::OP_DRAW_ARRAYS);
+    kCall.Word(mode);
+    kCall.Word((unsigned int)first);
+    kCall.Word((unsigned int)count);
+    int iVertices = 0, iStreamed = 0;
+    if (!Context().DrawArrays(mode,first,count,iVertices,iStreamed))
+    {
+        kCall.SetFlag(GLTrace::FLAG_OUT_OF_RANGE);
+    }
+    kCall.Word((unsigned int)iVertices);
+    kCall.Word((unsigned int)iStreamed);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glDrawElements (GLenum mode, GLsizei count,
+    GLenum type, const GLvoid *indices)
+{
+    GLRecorder::Call kCall(GLTrace::OP_DRAW_ELEMENTS);
+    kCall.Word(mode);
+    kCall.Word((unsigned int)count);
+    kCall.Word(type);
+    kCall.Word((unsigned int)(size_t)indices);
+    int iVertices = 0, iStreamed = 0;
+    if (!Context().DrawElements(mode,count,type,indices,iVertices,iStreamed))
+    {
+        kCall.SetFlag(GLTrace::FLAG_OUT_OF_RANGE);
+    }
+    kCall.Word((unsigned int)iVertices);
+    kCall.Word((unsigned int)iStreamed);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glEnable (GLenum cap)
+{
+    GLRecorder::Call kCall(GLTrace::OP_ENABLE);
+    kCall.Word(cap);
+    kCall.Changed(Context().SetCapability(cap,true));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glEnableClientState (GLenum array)
+{
+    GLRecorder::Call kCall(GLTrace::OP_ENABLE_CLIENT_STATE);
+    kCall.Word(array);
+    kCall.Changed(Context().SetClientState(array,true));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glFinish (void)
+{
+    // nothing is queued, the call is only recorded
+    GLRecorder::Call kCall(GLTrace::OP_FINISH);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glFlush (void)
+{
+    // nothing is queued, the call is only recorded
+    GLRecorder::Call kCall(GLTrace::OP_FLUSH);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glFogx (GLenum pname, GLfixed param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_FOGX);
+    kCall.Word(pname);
+    kCall.Word((unsigned int)param);
+    float afParam[4];
+    FixedParams(pname,1,&param,afParam);
+    Fog(kCall,pname,afParam,true);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glFogxv (GLenum pname, const GLfixed *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_FOGXV);
+    int iQuantity = GLRecorder::GetFogQuantity(pname);
+    kCall.Word(pname);
+    kCall.Words(iQuantity,params);
+    float afParam[4];
+    FixedParams(pname,iQuantity,params,afParam);
+    Fog(kCall,pname,afParam,false);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glFrontFace (GLenum mode)
+{
+    GLRecorder::Call kCall(GLTrace::OP_FRONT_FACE);
+    kCall.Word(mode);
+    kCall.Changed(Context().FrontFace(mode));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glFrustumx (GLfixed left, GLfixed right,
+    GLfixed bottom, GLfixed top, GLfixed zNear, GLfixed zFar)
+{
+    GLRecorder::Call kCall(GLTrace::OP_FRUSTUMX);
+    GLfixed aiParam[6] = { left, right, bottom, top, zNear, zFar };
+    kCall.Words(6,aiParam);
+    kCall.Changed(Context().Frustum(FixedToFloat(left),FixedToFloat(right),
+        FixedToFloat(bottom),FixedToFloat(top),FixedToFloat(zNear),
+        FixedToFloat(zFar)));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetBooleanv (GLenum pname, GLboolean *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_BOOLEANV);
+    kCall.Word(pname);
+    double adValue[16];
+    int eKind;
+    GetBooleans(Context().GetValue(pname,adValue,eKind),adValue,params);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetBufferParameteriv (GLenum target, GLenum pname,
+    GLint *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_BUFFER_PARAMETERIV);
+    kCall.Word(target);
+    kCall.Word(pname);
+    Context().GetBufferParameter(target,pname,params);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetClipPlanex (GLenum pname, GLfixed eqn[4])
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_CLIP_PLANEX);
+    kCall.Word(pname);
+    double adValue[4];
+    GetFixeds(Context().GetClipPlane(pname,adValue),GLRecorder::VK_FLOAT,
+        adValue,eqn);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGenBuffers (GLsizei n, GLuint *buffers)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GEN_BUFFERS);
+    Context().GenNames(false,n,buffers);
+    RecordNames(kCall,n,buffers);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGenTextures (GLsizei n, GLuint *textures)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GEN_TEXTURES);
+    Context().GenNames(true,n,textures);
+    RecordNames(kCall,n,textures);
+}
+//----------------------------------------------------------------------------
+GL_API GLenum GL_APIENTRY glGetError (void)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_ERROR);
+    return Context().GetError();
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetFixedv (GLenum pname, GLfixed *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_FIXEDV);
+    kCall.Word(pname);
+    double adValue[16];
+    int eKind;
+    int iQuantity = Context().GetValue(pname,adValue,eKind);
+    GetFixeds(iQuantity,eKind,adValue,params);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetIntegerv (GLenum pname, GLint *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_INTEGERV);
+    kCall.Word(pname);
+    double adValue[16];
+    int eKind;
+    int iQuantity = Context().GetValue(pname,adValue,eKind);
+    GetIntegers(iQuantity,eKind,adValue,params);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetLightxv (GLenum light, GLenum pname,
+    GLfixed *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_LIGHTXV);
+    kCall.Word(light);
+    kCall.Word(pname);
+    double adValue[4];
+    GetFixeds(Context().GetLight(light,pname,adValue),GLRecorder::VK_FLOAT,
+        adValue,params);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetMaterialxv (GLenum face, GLenum pname,
+    GLfixed *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_MATERIALXV);
+    kCall.Word(face);
+    kCall.Word(pname);
+    double adValue[4];
+    GetFixeds(Context().GetMaterial(face,pname,adValue),GLRecorder::VK_FLOAT,
+        adValue,params);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetPointerv (GLenum pname, void **params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_POINTERV);
+    kCall.Word(pname);
+    Context().GetPointer(pname,params);
+}
+//----------------------------------------------------------------------------
+GL_API const GLubyte * GL_APIENTRY glGetString (GLenum name)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_STRING);
+    kCall.Word(name);
+    return Context().GetString(name);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetTexEnviv (GLenum env, GLenum pname,
+    GLint *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_TEX_ENVIV);
+    kCall.Word(env);
+    kCall.Word(pname);
+    double adValue[4];
+    int eKind;
+    int iQuantity = Context().GetTexEnv(env,pname,adValue,eKind);
+    GetIntegers(iQuantity,eKind,adValue,params);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetTexEnvxv (GLenum env, GLenum pname,
+    GLfixed *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_TEX_ENVXV);
+    kCall.Word(env);
+    kCall.Word(pname);
+    double adValue[4];
+    int eKind;
+    int iQuantity = Context().GetTexEnv(env,pname,adValue,eKind);
+    GetFixeds(iQuantity,eKind,adValue,params);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetTexParameteriv (GLenum target, GLenum pname,
+    GLint *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_TEX_PARAMETERIV);
+    kCall.Word(target);
+    kCall.Word(pname);
+    double adValue[1];
+    int eKind;
+    int iQuantity = Context().GetTexParameter(target,pname,adValue,eKind);
+    GetIntegers(iQuantity,eKind,adValue,params);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glGetTexParameterxv (GLenum target, GLenum pname,
+    GLfixed *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_GET_TEX_PARAMETERXV);
+    kCall.Word(target);
+    kCall.Word(pname);
+    double adValue[1];
+    int eKind;
+    int iQuantity = Context().GetTexParameter(target,pname,adValue,eKind);
+    GetFixeds(iQuantity,eKind,adValue,params);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glHint (GLenum target, GLenum mode)
+{
+    GLRecorder::Call kCall(GLTrace::OP_HINT);
+    kCall.Word(target);
+    kCall.Word(mode);
+    kCall.Changed(Context().Hint(target,mode));
+}
+//----------------------------------------------------------------------------
+GL_API GLboolean GL_APIENTRY glIsBuffer (GLuint buffer)
+{
+    GLRecorder::Call kCall(GLTrace::OP_IS_BUFFER);
+    kCall.Word(buffer);
+    return (Context().IsName(false,buffer) ? GL_TRUE : GL_FALSE);
+}
+//----------------------------------------------------------------------------
+GL_API GLboolean GL_APIENTRY glIsEnabled (GLenum cap)
+{
+    GLRecorder::Call kCall(GLTrace::OP_IS_ENABLED);
+    kCall.Word(cap);
+    return (Context().IsEnabled(cap) ? GL_TRUE : GL_FALSE);
+}
+//----------------------------------------------------------------------------
+GL_API GLboolean GL_APIENTRY glIsTexture (GLuint texture)
+{
+    GLRecorder::Call kCall(GLTrace::OP_IS_TEXTURE);
+    kCall.Word(texture);
+    return (Context().IsName(true,texture) ? GL_TRUE : GL_FALSE);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glLightModelx (GLenum pname, GLfixed param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_LIGHT_MODELX);
+    kCall.Word(pname);
+    kCall.Word((unsigned int)param);
+    float afParam[4];
+    FixedParams(pname,1,&param,afParam);
+    LightModel(kCall,pname,afParam,true);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glLightModelxv (GLenum pname, const GLfixed *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_LIGHT_MODELXV);
+    int iQuantity = GLRecorder::GetLightModelQuantity(pname);
+    kCall.Word(pname);
+    kCall.Words(iQuantity,params);
+    float afParam[4];
+    FixedParams(pname,iQuantity,params,afParam);
+    LightModel(kCall,pname,afParam,false);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glLightx (GLenum light, GLenum pname, GLfixed param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_LIGHTX);
+    kCall.Word(light);
+    kCall.Word(pname);
+    kCall.Word((unsigned int)param);
+    float afParam[4];
+    FixedParams(pname,1,&param,afParam);
+    Light(kCall,light,pname,afParam,true);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glLightxv (GLenum light, GLenum pname,
+    const GLfixed *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_LIGHTXV);
+    int iQuantity = GLRecorder::GetLightQuantity(pname);
+    kCall.Word(light);
+    kCall.Word(pname);
+    kCall.Words(iQuantity,params);
+    float afParam[4];
+    FixedParams(pname,iQuantity,params,afParam);
+    Light(kCall,light,pname,afParam,false);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glLineWidthx (GLfixed width)
+{
+    GLRecorder::Call kCall(GLTrace::OP_LINE_WIDTHX);
+    kCall.Word((unsigned int)width);
+    kCall.Changed(Context().LineWidth(FixedToFloat(width)));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glLoadIdentity (void)
+{
+    static const float s_afIdentity[16] =
+    {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f
+    };
+
+    GLRecorder::Call kCall(GLTrace::OP_LOAD_IDENTITY);
+    kCall.Changed(Context().LoadMatrix(s_afIdentity));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glLoadMatrixx (const GLfixed *m)
+{
+    GLRecorder::Call kCall(GLTrace::OP_LOAD_MATRIXX);
+    kCall.Words(16,m);
+    float afMatrix[16];
+    FixedMatrix(m,afMatrix);
+    kCall.Changed(Context().LoadMatrix(afMatrix));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glLogicOp (GLenum opcode)
+{
+    GLRecorder::Call kCall(GLTrace::OP_LOGIC_OP);
+    kCall.Word(opcode);
+    kCall.Changed(Context().LogicOp(opcode));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glMaterialx (GLenum face, GLenum pname,
+    GLfixed param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_MATERIALX);
+    kCall.Word(face);
+    kCall.Word(pname);
+    kCall.Word((unsigned int)param);
+    float afParam[4];
+    FixedParams(pname,1,&param,afParam);
+    Material(kCall,face,pname,afParam,true);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glMaterialxv (GLenum face, GLenum pname,
+    const GLfixed *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_MATERIALXV);
+    int iQuantity = GLRecorder::GetMaterialQuantity(pname);
+    kCall.Word(face);
+    kCall.Word(pname);
+    kCall.Words(iQuantity,params);
+    float afParam[4];
+    FixedParams(pname,iQuantity,params,afParam);
+    Material(kCall,face,pname,afParam,false);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glMatrixMode (GLenum mode)
+{
+    GLRecorder::Call kCall(GLTrace::OP_MATRIX_MODE);
+    kCall.Word(mode);
+    kCall.Changed(Context().MatrixMode(mode));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glMultMatrixx (const GLfixed *m)
+{
+    GLRecorder::Call kCall(GLTrace::OP_MULT_MATRIXX);
+    kCall.Words(16,m);
+    float afMatrix[16];
+    FixedMatrix(m,afMatrix);
+    kCall.Changed(Context().MultMatrix(afMatrix));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glMultiTexCoord4x (GLenum target, GLfixed s,
+    GLfixed t, GLfixed r, GLfixed q)
+{
+    GLRecorder::Call kCall(GLTrace::OP_MULTI_TEX_COORD4X);
+    GLfixed aiCoord[4] = { s, t, r, q };
+    kCall.Word(target);
+    kCall.Words(4,aiCoord);
+    float afCoord[4] = { FixedToFloat(s), FixedToFloat(t), FixedToFloat(r),
+        FixedToFloat(q) };
+    kCall.Changed(Context().MultiTexCoord(target,afCoord));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glNormal3x (GLfixed nx, GLfixed ny, GLfixed nz)
+{
+    GLRecorder::Call kCall(GLTrace::OP_NORMAL3X);
+    GLfixed aiNormal[3] = { nx, ny, nz };
+    kCall.Words(3,aiNormal);
+    float afNormal[3] = { FixedToFloat(nx), FixedToFloat(ny),
+        FixedToFloat(nz) };
+    kCall.Changed(Context().Normal(afNormal));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glNormalPointer (GLenum type, GLsizei stride,
+    const GLvoid *pointer)
+{
+    GLRecorder::Call kCall(GLTrace::OP_NORMAL_POINTER);
+    ArrayPointer(kCall,GLRecorder::ARRAY_NORMAL,-1,type,stride,pointer);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glOrthox (GLfixed left, GLfixed right,
+    GLfixed bottom, GLfixed top, GLfixed zNear, GLfixed zFar)
+{
+    GLRecorder::Call kCall(GLTrace::OP_ORTHOX);
+    GLfixed aiParam[6] = { left, right, bottom, top, zNear, zFar };
+    kCall.Words(6,aiParam);
+    kCall.Changed(Context().Ortho(FixedToFloat(left),FixedToFloat(right),
+        FixedToFloat(bottom),FixedToFloat(top),FixedToFloat(zNear),
+        FixedToFloat(zFar)));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glPixelStorei (GLenum pname, GLint param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_PIXEL_STOREI);
+    kCall.Word(pname);
+    kCall.Word((unsigned int)param);
+    kCall.Changed(Context().PixelStore(pname,param));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glPointParameterx (GLenum pname, GLfixed param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_POINT_PARAMETERX);
+    kCall.Word(pname);
+    kCall.Word((unsigned int)param);
+    float afParam[4];
+    FixedParams(pname,1,&param,afParam);
+    PointParameter(kCall,pname,afParam,true);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glPointParameterxv (GLenum pname,
+    const GLfixed *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_POINT_PARAMETERXV);
+    int iQuantity = GLRecorder::GetPointParameterQuantity(pname);
+    kCall.Word(pname);
+    kCall.Words(iQuantity,params);
+    float afParam[4];
+    FixedParams(pname,iQuantity,params,afParam);
+    PointParameter(kCall,pname,afParam,false);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glPointSizex (GLfixed size)
+{
+    GLRecorder::Call kCall(GLTrace::OP_POINT_SIZEX);
+    kCall.Word((unsigned int)size);
+    kCall.Changed(Context().PointSize(FixedToFloat(size)));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glPolygonOffsetx (GLfixed factor, GLfixed units)
+{
+    GLRecorder::Call kCall(GLTrace::OP_POLYGON_OFFSETX);
+    kCall.Word((unsigned int)factor);
+    kCall.Word((unsigned int)units);
+    kCall.Changed(Context().PolygonOffset(FixedToFloat(factor),
+        FixedToFloat(units)));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glPopMatrix (void)
+{
+    GLRecorder::Call kCall(GLTrace::OP_POP_MATRIX);
+    Context().PopMatrix();
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glPushMatrix (void)
+{
+    GLRecorder::Call kCall(GLTrace::OP_PUSH_MATRIX);
+    Context().PushMatrix();
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glReadPixels (GLint x, GLint y, GLsizei width,
+    GLsizei height, GLenum format, GLenum type, GLvoid *pixels)
+{
+    GLRecorder::Call kCall(GLTrace::OP_READ_PIXELS);
+    kCall.Word((unsigned int)x);
+    kCall.Word((unsigned int)y);
+    kCall.Word((unsigned int)width);
+    kCall.Word((unsigned int)height);
+    kCall.Word(format);
+    kCall.Word(type);
+    kCall.Word((unsigned int)Context().ReadPixels(x,y,width,height,format,
+        type,pixels));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glRotatex (GLfixed angle, GLfixed x, GLfixed y,
+    GLfixed z)
+{
+    GLRecorder::Call kCall(GLTrace::OP_ROTATEX);
+    GLfixed aiParam[4] = { angle, x, y, z };
+    kCall.Words(4,aiParam);
+    kCall.Changed(Context().Rotate(FixedToFloat(angle),FixedToFloat(x),
+        FixedToFloat(y),FixedToFloat(z)));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glSampleCoverage (GLclampf value, GLboolean invert)
+{
+    GLRecorder::Call kCall(GLTrace::OP_SAMPLE_COVERAGE);
+    kCall.Float(value);
+    kCall.Word(invert ? 1 : 0);
+    kCall.Changed(Context().SampleCoverage(value,invert != GL_FALSE));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glSampleCoveragex (GLclampx value, GLboolean invert)
+{
+    GLRecorder::Call kCall(GLTrace::OP_SAMPLE_COVERAGEX);
+    kCall.Word((unsigned int)value);
+    kCall.Word(invert ? 1 : 0);
+    kCall.Changed(Context().SampleCoverage(FixedToFloat(value),
+        invert != GL_FALSE));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glScalex (GLfixed x, GLfixed y, GLfixed z)
+{
+    GLRecorder::Call kCall(GLTrace::OP_SCALEX);
+    GLfixed aiParam[3] = { x, y, z };
+    kCall.Words(3,aiParam);
+    kCall.Changed(Context().Scale(FixedToFloat(x),FixedToFloat(y),
+        FixedToFloat(z)));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glScissor (GLint x, GLint y, GLsizei width,
+    GLsizei height)
+{
+    GLRecorder::Call kCall(GLTrace::OP_SCISSOR);
+    kCall.Word((unsigned int)x);
+    kCall.Word((unsigned int)y);
+    kCall.Word((unsigned int)width);
+    kCall.Word((unsigned int)height);
+    kCall.Changed(Context().Scissor(x,y,width,height));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glShadeModel (GLenum mode)
+{
+    GLRecorder::Call kCall(GLTrace::OP_SHADE_MODEL);
+    kCall.Word(mode);
+    kCall.Changed(Context().ShadeModel(mode));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glStencilFunc (GLenum func, GLint ref, GLuint mask)
+{
+    GLRecorder::Call kCall(GLTrace::OP_STENCIL_FUNC);
+    kCall.Word(func);
+    kCall.Word((unsigned int)ref);
+    kCall.Word(mask);
+    kCall.Changed(Context().StencilFunc(func,ref,mask));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glStencilMask (GLuint mask)
+{
+    GLRecorder::Call kCall(GLTrace::OP_STENCIL_MASK);
+    kCall.Word(mask);
+    kCall.Changed(Context().StencilMask(mask));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glStencilOp (GLenum fail, GLenum zfail, GLenum zpass)
+{
+    GLRecorder::Call kCall(GLTrace::OP_STENCIL_OP);
+    kCall.Word(fail);
+    kCall.Word(zfail);
+    kCall.Word(zpass);
+    kCall.Changed(Context().StencilOp(fail,zfail,zpass));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTexCoordPointer (GLint size, GLenum type,
+    GLsizei stride, const GLvoid *pointer)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TEX_COORD_POINTER);
+    ArrayPointer(kCall,Context().GetClientActiveArray(),size,type,stride,
+        pointer);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTexEnvi (GLenum target, GLenum pname, GLint param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TEX_ENVI);
+    kCall.Word(target);
+    kCall.Word(pname);
+    kCall.Word((unsigned int)param);
+    float afParam[4];
+    IntegerParams(pname,1,&param,afParam);
+    TexEnv(kCall,target,pname,afParam,true);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTexEnviv (GLenum target, GLenum pname,
+    const GLint *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TEX_ENVIV);
+    int iQuantity = GLRecorder::GetTexEnvQuantity(pname);
+    kCall.Word(target);
+    kCall.Word(pname);
+    kCall.Words(iQuantity,params);
+    float afParam[4];
+    IntegerParams(pname,iQuantity,params,afParam);
+    TexEnv(kCall,target,pname,afParam,false);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTexEnvx (GLenum target, GLenum pname,
+    GLfixed param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TEX_ENVX);
+    kCall.Word(target);
+    kCall.Word(pname);
+    kCall.Word((unsigned int)param);
+    float afParam[4];
+    FixedParams(pname,1,&param,afParam);
+    TexEnv(kCall,target,pname,afParam,true);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTexEnvxv (GLenum target, GLenum pname,
+    const GLfixed *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TEX_ENVXV);
+    int iQuantity = GLRecorder::GetTexEnvQuantity(pname);
+    kCall.Word(target);
+    kCall.Word(pname);
+    kCall.Words(iQuantity,params);
+    float afParam[4];
+    FixedParams(pname,iQuantity,params,afParam);
+    TexEnv(kCall,target,pname,afParam,false);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTexImage2D (GLenum target, GLint level,
+    GLint internalformat, GLsizei width, GLsizei height, GLint border,
+    GLenum format, GLenum type, const GLvoid *pixels)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TEX_IMAGE_2D);
+    kCall.Word(target);
+    kCall.Word((unsigned int)level);
+    kCall.Word((unsigned int)internalformat);
+    kCall.Word((unsigned int)width);
+    kCall.Word((unsigned int)height);
+    kCall.Word((unsigned int)border);
+    kCall.Word(format);
+    kCall.Word(type);
+    kCall.Word((unsigned int)Context().TexImage2D(target,level,
+        (GLenum)internalformat,width,height,border,format,type,pixels));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTexParameteri (GLenum target, GLenum pname,
+    GLint param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TEX_PARAMETERI);
+    kCall.Word(target);
+    kCall.Word(pname);
+    kCall.Word((unsigned int)param);
+    kCall.Changed(Context().TexParameter(target,pname,(float)param));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTexParameteriv (GLenum target, GLenum pname,
+    const GLint *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TEX_PARAMETERIV);
+    kCall.Word(target);
+    kCall.Word(pname);
+    kCall.Words(1,params);
+    kCall.Changed(Context().TexParameter(target,pname,(float)params[0]));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTexParameterx (GLenum target, GLenum pname,
+    GLfixed param)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TEX_PARAMETERX);
+    kCall.Word(target);
+    kCall.Word(pname);
+    kCall.Word((unsigned int)param);
+    float afParam[4];
+    FixedParams(pname,1,&param,afParam);
+    kCall.Changed(Context().TexParameter(target,pname,afParam[0]));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTexParameterxv (GLenum target, GLenum pname,
+    const GLfixed *params)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TEX_PARAMETERXV);
+    kCall.Word(target);
+    kCall.Word(pname);
+    kCall.Words(1,params);
+    float afParam[4];
+    FixedParams(pname,1,params,afParam);
+    kCall.Changed(Context().TexParameter(target,pname,afParam[0]));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTexSubImage2D (GLenum target, GLint level,
+    GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
+    GLenum format, GLenum type, const GLvoid *pixels)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TEX_SUB_IMAGE_2D);
+    kCall.Word(target);
+    kCall.Word((unsigned int)level);
+    kCall.Word((unsigned int)xoffset);
+    kCall.Word((unsigned int)yoffset);
+    kCall.Word((unsigned int)width);
+    kCall.Word((unsigned int)height);
+    kCall.Word(format);
+    kCall.Word(type);
+    kCall.Word((unsigned int)Context().TexSubImage2D(target,level,xoffset,
+        yoffset,width,height,format,type,pixels));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glTranslatex (GLfixed x, GLfixed y, GLfixed z)
+{
+    GLRecorder::Call kCall(GLTrace::OP_TRANSLATEX);
+    GLfixed aiParam[3] = { x, y, z };
+    kCall.Words(3,aiParam);
+    kCall.Changed(Context().Translate(FixedToFloat(x),FixedToFloat(y),
+        FixedToFloat(z)));
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glVertexPointer (GLint size, GLenum type,
+    GLsizei stride, const GLvoid *pointer)
+{
+    GLRecorder::Call kCall(GLTrace::OP_VERTEX_POINTER);
+    ArrayPointer(kCall,GLRecorder::ARRAY_VERTEX,size,type,stride,pointer);
+}
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glViewport (GLint x, GLint y, GLsizei width,
+    GLsizei height)
+{
+    GLRecorder::Call kCall(GLTrace::OP_VIEWPORT);
+    kCall.Word((unsigned int)x);
+    kCall.Word((unsigned int)y);
+    kCall.Word((unsigned int)width);
+    kCall.Word((unsigned int)height);
+    kCall.Changed(Context().Viewport(x,y,width,height));
+}
+//----------------------------------------------------------------------------
+// OES extensions
+//----------------------------------------------------------------------------
+GL_API void GL_APIENTRY glPointSizePointerOES (GLenum type, GLsizei stride,
+    const GLvoid *pointer)
+{
+    GLRecorder::Call kCall(GLTrace::OP_POINT_SIZE_POINTER_OES);
+    ArrayPointer(kCall,GLRecorder::ARRAY_POINT_SIZE,-1,type,stride,pointer);
+}
+//----------------------------------------------------------------------------
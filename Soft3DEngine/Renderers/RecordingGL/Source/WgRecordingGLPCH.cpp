@@ -0,0 +1,10 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgRecordingGLPCH.cpp               //
+//                                                       //
+//  - Implementation for Precompiled Header class        //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgRecordingGLPCH.h"
+
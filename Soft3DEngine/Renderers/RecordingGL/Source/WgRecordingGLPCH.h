@@ -0,0 +1,20 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgRecordingGLPCH.h                 //
+//                                                       //
+//  - Interface for Precompiled Header class             //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+
+#ifndef __WG_RECORDINGGLPCH_H__
+#define __WG_RECORDINGGLPCH_H__
+
+#ifdef WG3D_USE_PRECOMPILED_HEADERS
+
+#include "WgGLRecorder.h"
+
+#endif
+
+#endif
+
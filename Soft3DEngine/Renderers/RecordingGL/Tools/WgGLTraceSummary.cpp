@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgGLTraceSummary.cpp               //
+//                                                       //
+//  - Summary of a recorded GL trace                     //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+// Prints the summary of a trace of the recording OpenGL ES library:
+//
+//   WgGLTraceSummary trace.wggt [top]
+//
+// The calls per frame by category and by opcode (the top opcodes, 10 by
+// default), the bytes uploaded and streamed per frame, the redundant state
+// calls of each opcode, the draws and primitives, the time spent in the
+// calls, and the calls that generated a GL error or read out of range.
+//
+// A frame ends at each OP_FRAME.  The calls after the last one count as a
+// frame when there are any.
+
+#include "WgGLTrace.h"
+#include <cstdio>
+#include <cstdlib>
+using namespace WGSoft3D;
+
+static const int gs_iMaxListed = 10;
+
+//----------------------------------------------------------------------------
+class OpcodeCounts
+{
+public:
+    OpcodeCounts ()
+    {
+        Calls = 0;
+        Redundant = 0;
+        Errors = 0;
+        Time = 0.0;
+    }
+
+    int Calls, Redundant, Errors;
+    double Time;
+};
+//----------------------------------------------------------------------------
+static double PerFrame (double dValue, int iFrames)
+{
+    return (iFrames > 0 ? dValue/(double)iFrames : 0.0);
+}
+//----------------------------------------------------------------------------
+static double Percent (double dPart, double dWhole)
+{
+    return (dWhole > 0.0 ? 100.0*dPart/dWhole : 0.0);
+}
+//----------------------------------------------------------------------------
+static void PrintRecord (int iFrame, const GLTrace::Record& rkRecord)
+{
+    printf("  frame %d  %s (",iFrame,GLTrace::GetName(rkRecord.Opcode));
+    for (int i = 0; i < rkRecord.ArgumentQuantity; i++)
+    {
+        printf(i > 0 ? ",0x%x" : "0x%x",rkRecord.Argument[i]);
+    }
+    printf(")\n");
+}
+//----------------------------------------------------------------------------
+int main (int iArgs, char** aacArg)
+{
+    if (iArgs < 2)
+    {
+        printf("usage: WgGLTraceSummary trace.wggt [top]\n");
+        return 1;
+    }
+    int iTop = (iArgs > 2 ? atoi(aacArg[2]) : 10);
+
+    GLTraceReader kReader;
+    if (!kReader.Open(aacArg[1]))
+    {
+        printf("%s is not a trace of version %d\n",aacArg[1],
+            (int)GLTrace::VERSION);
+        return 1;
+    }
+
+    OpcodeCounts akOpcode[GLTrace::OP_QUANTITY];
+    int aiCategoryCalls[GLTrace::CAT_QUANTITY] = { 0 };
+    int iFrames = 0, iCalls = 0, iFrameCalls = 0;
+    int iDraws = 0, iOutOfRange = 0, iErrors = 0;
+    double dPrimitives = 0.0, dVertices = 0.0;
+    double dUploaded = 0.0, dStreamed = 0.0;
+    double dTime = 0.0, dElapsed = 0.0;
+    int iErrorsListed = 0, iOutOfRangeListed = 0;
+
+    GLTrace::Record kRecord;
+    while (kReader.Read(kRecord))
+    {
+        dElapsed += (double)kRecord.Delta;
+        if (kRecord.Opcode == GLTrace::OP_FRAME)
+        {
+            iFrames++;
+            iFrameCalls = 0;
+            continue;
+        }
+
+        OpcodeCounts& rkCounts = akOpcode[kRecord.Opcode];
+        int eCategory = GLTrace::GetCategory(kRecord.Opcode);
+        int iLast = kRecord.ArgumentQuantity-1;
+        rkCounts.Calls++;
+        rkCounts.Time += (double)kRecord.Duration;
+        aiCategoryCalls[eCategory]++;
+        iCalls++;
+        iFrameCalls++;
+        dTime += (double)kRecord.Duration;
+
+        if (kRecord.Flags & GLTrace::FLAG_REDUNDANT)
+        {
+            rkCounts.Redundant++;
+        }
+        if (kRecord.Flags & GLTrace::FLAG_ERROR)
+        {
+            rkCounts.Errors++;
+            iErrors++;
+            if (iErrorsListed++ < gs_iMaxListed)
+            {
+                printf("error:\n");
+                PrintRecord(iFrames,kRecord);
+            }
+            continue;
+        }
+
+        if (eCategory == GLTrace::CAT_UPLOAD && iLast >= 0)
+        {
+            dUploaded += (double)kRecord.Argument[iLast];
+        }
+        else if (eCategory == GLTrace::CAT_DRAW && iLast >= 1)
+        {
+            // the count is the third argument of glDrawArrays and the
+            // second of glDrawElements
+            int iCount = (int)kRecord.Argument[
+                kRecord.Opcode == GLTrace::OP_DRAW_ARRAYS ? 2 : 1];
+            iDraws++;
+            dPrimitives += (double)GLTrace::GetPrimitiveQuantity(
+                kRecord.Argument[0],iCount);
+            dVertices += (double)kRecord.Argument[iLast-1];
+            dStreamed += (double)kRecord.Argument[iLast];
+            if (kRecord.Flags & GLTrace::FLAG_OUT_OF_RANGE)
+            {
+                iOutOfRange++;
+                if (iOutOfRangeListed++ < gs_iMaxListed)
+                {
+                    printf("out of range:\n");
+                    PrintRecord(iFrames,kRecord);
+                }
+            }
+        }
+    }
+    kReader.Close();
+
+    // the calls after the last frame marker
+    if (iFrameCalls > 0)
+    {
+        iFrames++;
+    }
+
+    printf("\n%d frames, %d calls, %.1f calls per frame\n",iFrames,iCalls,
+        PerFrame(iCalls,iFrames));
+    printf("time in calls %.3f ms per frame (%.1f%% of the elapsed time)\n",
+        PerFrame(dTime,iFrames)*1e-6,Percent(dTime,dElapsed));
+    printf("draws %.1f, primitives %.1f, vertices %.1f per frame\n",
+        PerFrame(iDraws,iFrames),PerFrame(dPrimitives,iFrames),
+        PerFrame(dVertices,iFrames));
+    printf("uploaded %.0f bytes, streamed %.0f bytes per frame\n",
+        PerFrame(dUploaded,iFrames),PerFrame(dStreamed,iFrames));
+    printf("errors %d, out of range draws %d\n",iErrors,iOutOfRange);
+
+    printf("\n%-16s %12s %8s\n","category","calls/frame","share");
+    int i;
+    for (i = 0; i < GLTrace::CAT_QUANTITY; i++)
+    {
+        if (aiCategoryCalls[i] > 0)
+        {
+            printf("%-16s %12.1f %7.1f%%\n",GLTrace::GetCategoryName(i),
+                PerFrame(aiCategoryCalls[i],iFrames),
+                Percent(aiCategoryCalls[i],iCalls));
+        }
+    }
+
+    // the opcodes by decreasing calls, a selection sort of the few listed
+    bool abListed[GLTrace::OP_QUANTITY] = { false };
+    printf("\n%-26s %12s %10s %10s %8s\n","opcode","calls/frame",
+        "redundant","us/call","errors");
+    for (int iRank = 0; iRank < iTop; iRank++)
+    {
+        int iMax = -1;
+        for (i = 0; i < GLTrace::OP_QUANTITY; i++)
+        {
+            if (!abListed[i] && akOpcode[i].Calls > 0
+            &&  (iMax < 0 || akOpcode[i].Calls > akOpcode[iMax].Calls))
+            {
+                iMax = i;
+            }
+        }
+        if (iMax < 0)
+        {
+            break;
+        }
+        abListed[iMax] = true;
+
+        const OpcodeCounts& rkCounts = akOpcode[iMax];
+        printf("%-26s %12.1f %9.1f%% %10.3f %8d\n",GLTrace::GetName(iMax),
+            PerFrame(rkCounts.Calls,iFrames),
+            Percent(rkCounts.Redundant,rkCounts.Calls),
+            PerFrame(rkCounts.Time,rkCounts.Calls)*1e-3,rkCounts.Errors);
+    }
+
+    // every opcode with redundant calls, they are the candidates for state
+    // filtering in the renderer
+    printf("\n%-26s %12s %10s\n","redundant state","calls/frame","share");
+    for (i = 0; i < GLTrace::OP_QUANTITY; i++)
+    {
+        const OpcodeCounts& rkCounts = akOpcode[i];
+        if (rkCounts.Redundant > 0)
+        {
+            printf("%-26s %12.1f %9.1f%%\n",GLTrace::GetName(i),
+                PerFrame(rkCounts.Redundant,iFrames),
+                Percent(rkCounts.Redundant,rkCounts.Calls));
+        }
+    }
+
+    return 0;
+}
+//----------------------------------------------------------------------------
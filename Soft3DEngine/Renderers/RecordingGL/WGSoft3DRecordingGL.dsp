@@ -0,0 +1,145 @@
+# Microsoft Developer Studio Project File - Name="WGSoft3DRecordingGL" - Package Owner=<4>
+# Microsoft Developer Studio Generated Build File, Format Version 6.00
+# ** DO NOT EDIT **
+
+# TARGTYPE "Win32 (x86) Dynamic-Link Library" 0x0102
+
+CFG=WGSoft3DRecordingGL - Win32 Debug
+!MESSAGE This is not a valid makefile. To build this project using NMAKE,
+!MESSAGE use the Export Makefile command and run
+!MESSAGE 
+!MESSAGE NMAKE /f "WGSoft3DRecordingGL.mak".
+!MESSAGE 
+!MESSAGE You can specify a configuration when running NMAKE
+!MESSAGE by defining the macro CFG on the command line. For example:
+!MESSAGE 
+!MESSAGE NMAKE /f "WGSoft3DRecordingGL.mak" CFG="WGSoft3DRecordingGL - Win32 Debug"
+!MESSAGE 
+!MESSAGE Possible choices for configuration are:
+!MESSAGE 
+!MESSAGE "WGSoft3DRecordingGL - Win32 Release" (based on "Win32 (x86) Dynamic-Link Library")
+!MESSAGE "WGSoft3DRecordingGL - Win32 Debug" (based on "Win32 (x86) Dynamic-Link Library")
+!MESSAGE 
+
+# Begin Project
+# PROP AllowPerConfigDependencies 0
+# PROP Scc_ProjName ""
+# PROP Scc_LocalPath ""
+CPP=cl.exe
+MTL=midl.exe
+RSC=rc.exe
+
+!IF  "$(CFG)" == "WGSoft3DRecordingGL - Win32 Release"
+
+# PROP BASE Use_MFC 0
+# PROP BASE Use_Debug_Libraries 0
+# PROP BASE Output_Dir "Release"
+# PROP BASE Intermediate_Dir "Release"
+# PROP BASE Target_Dir ""
+# PROP Use_MFC 0
+# PROP Use_Debug_Libraries 0
+# PROP Output_Dir "Release"
+# PROP Intermediate_Dir "Release"
+# PROP Ignore_Export_Lib 0
+# PROP Target_Dir ""
+# ADD BASE CPP /nologo /MT /W3 /GX /O2 /D "WIN32" /D "NDEBUG" /D "_WINDOWS" /D "_MBCS" /D "_USRDLL" /D "WGSOFT3DOMAPGLRENDERER_EXPORTS" /YX /FD /c
+# ADD CPP /nologo /MD /W3 /GX /O2 /I "." /I "./Source" /I "./Source/Recorder" /I "../../include" /I "../../external/OmapGL/include" /D "WIN32" /D "NDEBUG" /D "_WINDOWS" /D "_MBCS" /D "_USRDLL" /D "WG3D_RENDERER_DLL_EXPORT" /D "__GL_EXPORTS" /D "WG3D_FOUNDATION_DLL_IMPORT" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgRecordingGLPCH.h" /FD /c
+# ADD BASE MTL /nologo /D "NDEBUG" /mktyplib203 /win32
+# ADD MTL /nologo /D "NDEBUG" /mktyplib203 /win32
+# ADD BASE RSC /l 0x412 /d "NDEBUG"
+# ADD RSC /l 0x412 /d "NDEBUG"
+BSC32=bscmake.exe
+# ADD BASE BSC32 /nologo
+# ADD BSC32 /nologo
+LINK32=link.exe
+# ADD BASE LINK32 kernel32.lib user32.lib gdi32.lib winspool.lib comdlg32.lib advapi32.lib shell32.lib ole32.lib oleaut32.lib uuid.lib odbc32.lib odbccp32.lib /nologo /dll /machine:I386
+# ADD LINK32 kernel32.lib user32.lib gdi32.lib winspool.lib comdlg32.lib advapi32.lib shell32.lib ole32.lib oleaut32.lib uuid.lib odbc32.lib odbccp32.lib WGSoft3DFoundation.lib /nologo /dll /machine:I386 /out:"../../bin/WGSoft3DRecordingGL.dll" /implib:"../../bin/WGSoft3DRecordingGL.lib" /libpath:"./../../bin"
+# SUBTRACT LINK32 /pdb:none
+# Begin Special Build Tool
+SOURCE="$(InputPath)"
+PostBuild_Cmds=copy /y Source\Recorder\*.h ..\..\Include	copy /y Source\Recorder\*.inl ..\..\Include	copy /y Source\*.h ..\..\Include
+# End Special Build Tool
+
+!ELSEIF  "$(CFG)" == "WGSoft3DRecordingGL - Win32 Debug"
+
+# PROP BASE Use_MFC 0
+# PROP BASE Use_Debug_Libraries 1
+# PROP BASE Output_Dir "Debug"
+# PROP BASE Intermediate_Dir "Debug"
+# PROP BASE Target_Dir ""
+# PROP Use_MFC 0
+# PROP Use_Debug_Libraries 1
+# PROP Output_Dir "Debug"
+# PROP Intermediate_Dir "Debug"
+# PROP Ignore_Export_Lib 0
+# PROP Target_Dir ""
+# ADD BASE CPP /nologo /MTd /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_WINDOWS" /D "_MBCS" /D "_USRDLL" /D "WGSOFT3DOMAPGLRENDERER_EXPORTS" /YX /FD /GZ /c
+# ADD CPP /nologo /MDd /W3 /Gm /GR /GX /ZI /Od /I "." /I "./Source" /I "./Source/Recorder" /I "../../include" /I "../../external/OmapGL/include" /D "WIN32" /D "_DEBUG" /D "_WINDOWS" /D "_MBCS" /D "_USRDLL" /D "WG3D_RENDERER_DLL_EXPORT" /D "__GL_EXPORTS" /D "WG3D_FOUNDATION_DLL_IMPORT" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgRecordingGLPCH.h" /FD /GZ /c
+# ADD BASE MTL /nologo /D "_DEBUG" /mktyplib203 /win32
+# ADD MTL /nologo /D "_DEBUG" /mktyplib203 /win32
+# ADD BASE RSC /l 0x412 /d "_DEBUG"
+# ADD RSC /l 0x412 /d "_DEBUG"
+BSC32=bscmake.exe
+# ADD BASE BSC32 /nologo
+# ADD BSC32 /nologo
+LINK32=link.exe
+# ADD BASE LINK32 kernel32.lib user32.lib gdi32.lib winspool.lib comdlg32.lib advapi32.lib shell32.lib ole32.lib oleaut32.lib uuid.lib odbc32.lib odbccp32.lib /nologo /dll /debug /machine:I386 /pdbtype:sept
+# ADD LINK32 kernel32.lib user32.lib gdi32.lib winspool.lib comdlg32.lib advapi32.lib shell32.lib ole32.lib oleaut32.lib uuid.lib odbc32.lib odbccp32.lib WGSoft3DFoundation_D.lib /nologo /dll /debug /machine:I386 /out:"../../bin/WGSoft3DRecordingGL_D.dll" /implib:"../../bin/WGSoft3DRecordingGL_D.lib" /pdbtype:sept /libpath:"./../../bin"
+# SUBTRACT LINK32 /pdb:none /nodefaultlib
+# Begin Special Build Tool
+SOURCE="$(InputPath)"
+PostBuild_Cmds=copy /y Source\Recorder\*.h ..\..\Include	copy /y Source\Recorder\*.inl ..\..\Include	copy /y Source\*.h ..\..\Include
+# End Special Build Tool
+
+!ENDIF 
+
+# Begin Target
+
+# Name "WGSoft3DRecordingGL - Win32 Release"
+# Name "WGSoft3DRecordingGL - Win32 Debug"
+# Begin Group "Recorder"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\Source\Recorder\WgGLRecorder.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Recorder\WgGLRecorder.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Recorder\WgGLRecorder.inl
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Recorder\WgGLTrace.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Recorder\WgGLTrace.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Recorder\WgGLTrace.inl
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Recorder\WgRecordingGL.cpp
+# End Source File
+# End Group
+# Begin Source File
+
+SOURCE=.\Source\WgRecordingGLLIB.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\WgRecordingGLPCH.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\WgRecordingGLPCH.h
+# End Source File
+# End Target
+# End Project
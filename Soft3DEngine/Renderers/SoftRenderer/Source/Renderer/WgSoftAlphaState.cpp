@@ -0,0 +1,30 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftAlphaState.cpp               //
+//                                                       //
+//  - Implementation for Soft Alpha State class          //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgSoftRendererPCH.h"
+#include "WgSoftRenderer.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+void SoftRenderer::SetAlphaState (AlphaState* pkState)
+{
+    m_kFragment.BlendEnabled = pkState->BlendEnabled;
+    if (pkState->BlendEnabled)
+    {
+        m_kFragment.SrcBlend = pkState->SrcBlend;
+        m_kFragment.DstBlend = pkState->DstBlend;
+    }
+
+    m_kFragment.AlphaTestEnabled = pkState->TestEnabled;
+    if (pkState->TestEnabled)
+    {
+        m_kFragment.AlphaTest = pkState->Test;
+        m_kFragment.AlphaReference = FloatFromFixed(pkState->Reference);
+    }
+}
+//----------------------------------------------------------------------------
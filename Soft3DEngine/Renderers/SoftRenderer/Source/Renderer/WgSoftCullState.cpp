@@ -0,0 +1,35 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftCullState.cpp                //
+//                                                       //
+//  - Implementation for Soft Cull State class           //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgSoftRendererPCH.h"
+#include "WgSoftRenderer.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+void SoftRenderer::SetCullState (CullState* pkState)
+{
+    m_bCullEnabled = pkState->Enabled;
+    m_iFrontFace = pkState->FrontFace;
+
+    if (!m_bReverseCullFace)
+    {
+        m_iCullFace = pkState->CullFace;
+    }
+    else
+    {
+        if (pkState->CullFace == CullState::CT_BACK)
+        {
+            m_iCullFace = CullState::CT_FRONT;
+        }
+        else
+        {
+            m_iCullFace = CullState::CT_BACK;
+        }
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,18 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftDitherState.cpp              //
+//                                                       //
+//  - Implementation for Soft Dither State class         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgSoftRendererPCH.h"
+#include "WgSoftRenderer.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+void SoftRenderer::SetDitherState (DitherState*)
+{
+    // the color buffer has 8 bits per channel, dithering changes nothing
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftFogState.cpp                 //
+//                                                       //
+//  - Implementation for Soft Fog State class            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgSoftRendererPCH.h"
+#include "WgSoftRenderer.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+void SoftRenderer::SetFogState (FogState* pkState)
+{
+    m_kFragment.FogEnabled = pkState->Enabled;
+    if (pkState->Enabled)
+    {
+        m_kFragment.FogStart = FloatFromFixed(pkState->Start);
+        m_kFragment.FogEnd = FloatFromFixed(pkState->End);
+        m_kFragment.FogDensity = FloatFromFixed(pkState->Density);
+        m_kFragment.FogColor[0] = FloatFromFixed(pkState->Color.R());
+        m_kFragment.FogColor[1] = FloatFromFixed(pkState->Color.G());
+        m_kFragment.FogColor[2] = FloatFromFixed(pkState->Color.B());
+        m_kFragment.FogFunction = pkState->DensityFunction;
+
+        // GL_NICEST computes the fog factor per pixel
+        m_kFragment.FogPerPixel =
+            (pkState->ApplyFunction == FogState::AF_PER_PIXEL);
+    }
+    else
+    {
+        m_kFragment.FogPerPixel = false;
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,25 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftMaterialState.cpp            //
+//                                                       //
+//  - Implementation for Soft Material State class       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgSoftRendererPCH.h"
+#include "WgSoftRenderer.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+void SoftRenderer::SetMaterialState (MaterialState* pkState)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        m_afEmissive[i] = FloatFromFixed(pkState->Emissive[i]);
+        m_afAmbient[i] = FloatFromFixed(pkState->Ambient[i]);
+        m_afDiffuse[i] = FloatFromFixed(pkState->Diffuse[i]);
+        m_afSpecular[i] = FloatFromFixed(pkState->Specular[i]);
+    }
+    m_fShininess = FloatFromFixed(pkState->Shininess);
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftPlanarShadow.cpp             //
+//                                                       //
+//  - Implementation for Soft Planar Shadow              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgSoftRendererPCH.h"
+#include "WgSoftRenderer.h"
+#include "WgMatrix4.h"
+#include "WgNode.h"
+#include "WgPlanarShadowEffect.h"
+#include "WgProfiler.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+void SoftRenderer::DrawPlanarShadow ()
+{
+    WG3D_PROFILE("SoftRenderer::DrawPlanarShadow");
+
+    // Access the special effect.  Detach it from the node to allow the
+    // effectless node drawing.
+    assert(DynamicCast<PlanarShadowEffect>(m_pkNode->GetEffect()));
+    PlanarShadowEffectPtr spkPSEffect =
+        (PlanarShadowEffect*)m_pkNode->GetEffect();
+    m_pkNode->SetEffect(0);
+
+    // draw the caster
+    m_pkNode->Draw(*this);
+
+    // number of planes limited by stencil buffer size
+    int iQuantity = spkPSEffect->GetQuantity();
+    if (iQuantity >= m_iMaxStencilIndices-1)
+    {
+        iQuantity = m_iMaxStencilIndices-1;
+    }
+
+    for (int i = 0; i < iQuantity; i++)
+    {
+        TriMeshPtr spkPlane = spkPSEffect->GetPlane(i);
+        LightPtr spkProjector = spkPSEffect->GetProjector(i);
+        ColorRGBA kShadowColor = spkPSEffect->GetShadowColor(i);
+
+        // enable depth buffering
+        m_kFragment.DepthEnabled = true;
+        m_kFragment.DepthCompare = ZBufferState::CF_LEQUAL;
+        m_kFragment.DepthWritable = true;
+        m_bAllowZBufferState = false;
+
+        // Enable the stencil buffer so that the shadow can be clipped by the
+        // plane.
+        m_kFragment.StencilEnabled = true;
+        m_kFragment.StencilCompare = StencilState::CF_ALWAYS;
+        m_kFragment.StencilReference = (unsigned int)(i+1);
+        m_kFragment.StencilMask = ~0u;
+        m_kFragment.StencilOnFail = StencilState::OT_KEEP;
+        m_kFragment.StencilOnZFail = StencilState::OT_KEEP;
+        m_kFragment.StencilOnZPass = StencilState::OT_REPLACE;
+        m_kFragment.StencilWriteMask = ~0u;
+        m_bAllowStencilState = false;
+
+        // draw the plane
+        Renderer::Draw(spkPlane);
+
+        // disable the stencil buffer and depth buffer
+        m_kFragment.StencilEnabled = false;
+        m_kFragment.DepthEnabled = false;
+        m_bAllowZBufferState = true;
+        m_bAllowStencilState = true;
+
+        // compute the equation for the shadow plane in world coordinates
+        Triangle3x kTri;
+        spkPlane->GetWorldTriangle(0,kTri);
+        Plane3x kPlane(kTri.V[0],kTri.V[1],kTri.V[2]);
+
+        // Conservative test to see if a shadow should be cast.  This can
+        // cause incorrect results if the caster is large and intersects the
+        // plane, but ordinarily we are not trying to cast shadows in such
+        // situations.
+        if (m_pkNode->WorldBound->WhichSide(kPlane) < 0)
+        {
+            // shadow caster is on far side of plane
+            continue;
+        }
+
+        // Compute the projection matrix for the light source.
+        Matrix4x kProjectionTranspose;
+        if (spkProjector->Type == Light::LT_DIRECTIONAL)
+        {
+            fixed fNdD =
+                kPlane.Normal.Dot(spkProjector->GetWorldDVector());
+            if (fNdD >= FIXED_ZERO)
+            {
+                // Projection must be onto the "positive side" of the plane.
+                continue;
+            }
+
+            kProjectionTranspose.MakeObliqueProjection(kPlane.Normal,
+                kTri.V[0],spkProjector->GetWorldDVector());
+        }
+        else if (spkProjector->Type == Light::LT_POINT
+        ||  spkProjector->Type == Light::LT_SPOT)
+        {
+            fixed fNdE =
+                kPlane.Normal.Dot(spkProjector->GetWorldLocation());
+            if (fNdE <= FIXED_ZERO)
+            {
+                // Projection must be onto the "positive side" of the plane.
+                continue;
+            }
+
+            kProjectionTranspose.MakePerspectiveProjection(kPlane.Normal,
+                kTri.V[0],spkProjector->GetWorldLocation());
+        }
+        else
+        {
+            assert(false);
+            kProjectionTranspose = Matrix4x::IDENTITY;
+        }
+
+        // The OpenGL renderers multiply the model-view matrix by the
+        // transpose of this matrix in column-major order, that is, by this
+        // matrix in row-major order.
+        const fixed* afProjection = (const fixed*)kProjectionTranspose;
+        int j;
+        for (j = 0; j < 16; j++)
+        {
+            m_afShadow[j] = FloatFromFixed(afProjection[j]);
+        }
+        m_bShadowTransform = true;
+
+        // Alpha blending used to blend the shadow color with the appropriate
+        // pixels drawn for the projection plane.
+        m_kFragment.BlendEnabled = true;
+        m_kFragment.SrcBlend = AlphaState::SBF_SRC_ALPHA;
+        m_kFragment.DstBlend = AlphaState::DBF_ONE_MINUS_SRC_ALPHA;
+        float afSaveColor[4];
+        for (j = 0; j < 4; j++)
+        {
+            afSaveColor[j] = m_afCurrentColor[j];
+            m_afCurrentColor[j] = FloatFromFixed(kShadowColor[j]);
+        }
+
+        // Only draw where the plane has been drawn.
+        m_kFragment.StencilEnabled = true;
+        m_kFragment.StencilCompare = StencilState::CF_EQUAL;
+        m_kFragment.StencilReference = (unsigned int)(i+1);
+        m_kFragment.StencilMask = ~0u;
+        m_kFragment.StencilOnFail = StencilState::OT_KEEP;
+        m_kFragment.StencilOnZFail = StencilState::OT_KEEP;
+        m_kFragment.StencilOnZPass = StencilState::OT_ZERO;
+
+        // Draw the caster again, but using only vertices and triangles
+        // indices.  Disable culling to allow out-of-view objects to cast
+        // shadows.
+        m_bAllowGlobalState = false;
+        m_bAllowLighting = false;
+        m_bAllowNormals = false;
+        m_bAllowColors = false;
+        m_bAllowTextures = false;
+
+        m_pkNode->Draw(*this,true);
+
+        m_bAllowGlobalState = true;
+        m_bAllowLighting = true;
+        m_bAllowNormals = true;
+        m_bAllowColors = true;
+        m_bAllowTextures = true;
+
+        // disable the stencil buffer
+        m_kFragment.StencilEnabled = false;
+
+        // restore current color
+        for (j = 0; j < 4; j++)
+        {
+            m_afCurrentColor[j] = afSaveColor[j];
+        }
+
+        // disable alpha blending
+        m_kFragment.BlendEnabled = false;
+
+        // restore the model-to-world transformation
+        m_bShadowTransform = false;
+    }
+
+    // reattach the effect
+    m_pkNode->SetEffect(spkPSEffect);
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,22 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftPolygonOffsetState.cpp       //
+//                                                       //
+//  - Implementation for Soft Polygon Offset State       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgSoftRendererPCH.h"
+#include "WgSoftRenderer.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+void SoftRenderer::SetPolygonOffsetState (PolygonOffsetState* pkState)
+{
+    // OpenGL ES offsets only the filled polygons, the lines and points are
+    // not offset either
+    m_bOffsetEnabled = pkState->FillEnabled;
+    m_fOffsetScale = FloatFromFixed(pkState->Scale);
+    m_fOffsetBias = FloatFromFixed(pkState->Bias);
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,597 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftRasterizer.cpp               //
+//                                                       //
+//  - Implementation for SoftRenderer rasterizer         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgSoftRendererPCH.h"
+#include "WgSoftRenderer.h"
+#include "WgSoftTexture.h"
+#include "WgAlphaState.h"
+#include "WgFogState.h"
+#include "WgStencilState.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+static inline float Clamp (float fValue)
+{
+    return (fValue < 0.0f ? 0.0f : (fValue > 1.0f ? 1.0f : fValue));
+}
+//----------------------------------------------------------------------------
+static inline float FastLog2 (float fValue)
+{
+    // the exponent plus a quadratic fit of log2 on the mantissa in [1,2)
+    union { float f; unsigned int i; } kBits;
+    kBits.f = fValue;
+    float fExponent = (float)((int)((kBits.i >> 23) & 255) - 128);
+    kBits.i = (kBits.i & ~(255u << 23)) | (127u << 23);
+    return fExponent + (-0.33333333f*kBits.f + 2.0f)*kBits.f - 0.66666667f;
+}
+//----------------------------------------------------------------------------
+static inline bool Compare (int iFunction, float fValue, float fReference)
+{
+    // AlphaState::TestFunc, StencilState::CompareFunction and
+    // ZBufferState::CompareFunc list the functions in the same order
+    switch (iFunction)
+    {
+    case StencilState::CF_NEVER:     return false;
+    case StencilState::CF_LESS:      return fValue < fReference;
+    case StencilState::CF_EQUAL:     return fValue == fReference;
+    case StencilState::CF_LEQUAL:    return fValue <= fReference;
+    case StencilState::CF_GREATER:   return fValue > fReference;
+    case StencilState::CF_NOTEQUAL:  return fValue != fReference;
+    case StencilState::CF_GEQUAL:    return fValue >= fReference;
+    default:                         return true;
+    }
+}
+//----------------------------------------------------------------------------
+static inline void ApplyStencil (int iOperation, unsigned char* pucStencil,
+    unsigned int uiReference, unsigned int uiWriteMask)
+{
+    unsigned int uiValue = *pucStencil;
+    unsigned int uiResult;
+    switch (iOperation)
+    {
+    case StencilState::OT_ZERO:
+        uiResult = 0;
+        break;
+    case StencilState::OT_REPLACE:
+        uiResult = uiReference;
+        break;
+    case StencilState::OT_INCREMENT:
+        uiResult = (uiValue < 255 ? uiValue + 1 : 255);
+        break;
+    case StencilState::OT_DECREMENT:
+        uiResult = (uiValue > 0 ? uiValue - 1 : 0);
+        break;
+    case StencilState::OT_INVERT:
+        uiResult = ~uiValue;
+        break;
+    default:  // StencilState::OT_KEEP
+        return;
+    }
+    *pucStencil = (unsigned char)((uiValue & ~uiWriteMask) |
+        (uiResult & uiWriteMask));
+}
+//----------------------------------------------------------------------------
+static void GetSrcFactor (int iFactor, const float afSrc[4],
+    const float afDst[4], float afFactor[4])
+{
+    int i;
+    switch (iFactor)
+    {
+    case AlphaState::SBF_ZERO:
+    case AlphaState::SBF_CONSTANT_COLOR:
+    case AlphaState::SBF_CONSTANT_ALPHA:
+        // the constant color of OpenGL is (0,0,0,0), OpenGL ES 1.1 cannot
+        // change it
+        afFactor[0] = afFactor[1] = afFactor[2] = afFactor[3] = 0.0f;
+        break;
+    case AlphaState::SBF_DST_COLOR:
+        for (i = 0; i < 4; i++)
+        {
+            afFactor[i] = afDst[i];
+        }
+        break;
+    case AlphaState::SBF_ONE_MINUS_DST_COLOR:
+        for (i = 0; i < 4; i++)
+        {
+            afFactor[i] = 1.0f - afDst[i];
+        }
+        break;
+    case AlphaState::SBF_SRC_ALPHA:
+        afFactor[0] = afFactor[1] = afFactor[2] = afFactor[3] = afSrc[3];
+        break;
+    case AlphaState::SBF_ONE_MINUS_SRC_ALPHA:
+        afFactor[0] = afFactor[1] = afFactor[2] = afFactor[3] =
+            1.0f - afSrc[3];
+        break;
+    case AlphaState::SBF_DST_ALPHA:
+        afFactor[0] = afFactor[1] = afFactor[2] = afFactor[3] = afDst[3];
+        break;
+    case AlphaState::SBF_ONE_MINUS_DST_ALPHA:
+        afFactor[0] = afFactor[1] = afFactor[2] = afFactor[3] =
+            1.0f - afDst[3];
+        break;
+    case AlphaState::SBF_SRC_ALPHA_SATURATE:
+        afFactor[0] = (afSrc[3] < 1.0f - afDst[3] ? afSrc[3] :
+            1.0f - afDst[3]);
+        afFactor[1] = afFactor[0];
+        afFactor[2] = afFactor[0];
+        afFactor[3] = 1.0f;
+        break;
+    default:  // SBF_ONE, SBF_ONE_MINUS_CONSTANT_COLOR/ALPHA
+        afFactor[0] = afFactor[1] = afFactor[2] = afFactor[3] = 1.0f;
+        break;
+    }
+}
+//----------------------------------------------------------------------------
+static void GetDstFactor (int iFactor, const float afSrc[4],
+    const float afDst[4], float afFactor[4])
+{
+    int i;
+    switch (iFactor)
+    {
+    case AlphaState::DBF_ZERO:
+    case AlphaState::DBF_CONSTANT_COLOR:
+    case AlphaState::DBF_CONSTANT_ALPHA:
+        afFactor[0] = afFactor[1] = afFactor[2] = afFactor[3] = 0.0f;
+        break;
+    case AlphaState::DBF_SRC_COLOR:
+        for (i = 0; i < 4; i++)
+        {
+            afFactor[i] = afSrc[i];
+        }
+        break;
+    case AlphaState::DBF_ONE_MINUS_SRC_COLOR:
+        for (i = 0; i < 4; i++)
+        {
+            afFactor[i] = 1.0f - afSrc[i];
+        }
+        break;
+    case AlphaState::DBF_SRC_ALPHA:
+        afFactor[0] = afFactor[1] = afFactor[2] = afFactor[3] = afSrc[3];
+        break;
+    case AlphaState::DBF_ONE_MINUS_SRC_ALPHA:
+        afFactor[0] = afFactor[1] = afFactor[2] = afFactor[3] =
+            1.0f - afSrc[3];
+        break;
+    case AlphaState::DBF_DST_ALPHA:
+        afFactor[0] = afFactor[1] = afFactor[2] = afFactor[3] = afDst[3];
+        break;
+    case AlphaState::DBF_ONE_MINUS_DST_ALPHA:
+        afFactor[0] = afFactor[1] = afFactor[2] = afFactor[3] =
+            1.0f - afDst[3];
+        break;
+    default:  // DBF_ONE, DBF_ONE_MINUS_CONSTANT_COLOR/ALPHA
+        afFactor[0] = afFactor[1] = afFactor[2] = afFactor[3] = 1.0f;
+        break;
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::TileTask::Execute (TaskPool&, int)
+{
+    Owner->RasterizeTile(Tile);
+}
+//----------------------------------------------------------------------------
+float SoftRenderer::GetFogFactor (const FragmentState& rkState,
+    float fDistance)
+{
+    float fFactor;
+    switch (rkState.FogFunction)
+    {
+    case FogState::DF_EXP:
+        fFactor = (float)exp(-rkState.FogDensity*fDistance);
+        break;
+    case FogState::DF_EXPSQR:
+    {
+        float fArg = rkState.FogDensity*fDistance;
+        fFactor = (float)exp(-fArg*fArg);
+        break;
+    }
+    default:  // FogState::DF_LINEAR
+        if (rkState.FogEnd != rkState.FogStart)
+        {
+            fFactor = (rkState.FogEnd - fDistance)/
+                (rkState.FogEnd - rkState.FogStart);
+        }
+        else
+        {
+            fFactor = 1.0f;
+        }
+        break;
+    }
+    return Clamp(fFactor);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ApplyTexture (const TextureUnit& rkUnit,
+    const float afTexel[4], const float afPrimary[4], float afColor[4])
+{
+    // The texture environment of OpenGL ES 1.1.  afColor is the output of
+    // the previous unit on input.  The images without alpha channel leave
+    // the alpha of the previous unit unchanged.
+    int i;
+    switch (rkUnit.Apply)
+    {
+    case Texture::AM_REPLACE:
+        for (i = 0; i < 3; i++)
+        {
+            afColor[i] = afTexel[i];
+        }
+        if (rkUnit.HasAlpha)
+        {
+            afColor[3] = afTexel[3];
+        }
+        break;
+    case Texture::AM_DECAL:
+        if (rkUnit.HasAlpha)
+        {
+            for (i = 0; i < 3; i++)
+            {
+                afColor[i] += afTexel[3]*(afTexel[i] - afColor[i]);
+            }
+        }
+        else
+        {
+            for (i = 0; i < 3; i++)
+            {
+                afColor[i] = afTexel[i];
+            }
+        }
+        break;
+    case Texture::AM_MODULATE:
+        for (i = 0; i < 3; i++)
+        {
+            afColor[i] *= afTexel[i];
+        }
+        if (rkUnit.HasAlpha)
+        {
+            afColor[3] *= afTexel[3];
+        }
+        break;
+    case Texture::AM_BLEND:
+        for (i = 0; i < 3; i++)
+        {
+            afColor[i] += afTexel[i]*(rkUnit.Color[i] - afColor[i]);
+        }
+        if (rkUnit.HasAlpha)
+        {
+            afColor[3] *= afTexel[3];
+        }
+        break;
+    case Texture::AM_ADD:
+        for (i = 0; i < 3; i++)
+        {
+            afColor[i] = Clamp(afColor[i] + afTexel[i]);
+        }
+        if (rkUnit.HasAlpha)
+        {
+            afColor[3] *= afTexel[3];
+        }
+        break;
+    case Texture::AM_COMBINE:
+        Combine(rkUnit,afTexel,afPrimary,afColor);
+        break;
+    default:  // Texture::AM_QUANTITY
+        break;
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::Combine (const TextureUnit& rkUnit,
+    const float afTexel[4], const float afPrimary[4], float afColor[4])
+{
+    float afTexelRGBA[4] =
+    {
+        afTexel[0], afTexel[1], afTexel[2],
+        (rkUnit.HasAlpha ? afTexel[3] : 1.0f)
+    };
+    float afResult[4];
+
+    // c = 0 is the RGB function, c = 1 the alpha function
+    for (int c = 0; c < 2; c++)
+    {
+        float aafArg[3][3];
+        int k, i;
+        for (k = 0; k < 3; k++)
+        {
+            const float* afSource;
+            switch (rkUnit.CombineSrc[c][k])
+            {
+            case Texture::ACS_TEXTURE:        afSource = afTexelRGBA;    break;
+            case Texture::ACS_PRIMARY_COLOR:  afSource = afPrimary;      break;
+            case Texture::ACS_CONSTANT:       afSource = rkUnit.Color;   break;
+            default:                          afSource = afColor;        break;
+            }
+
+            int iOperand = rkUnit.CombineOp[c][k];
+            if (c == 1)
+            {
+                // the alpha operands read the alpha channel
+                iOperand = (iOperand == Texture::ACO_SRC_COLOR ?
+                    Texture::ACO_SRC_ALPHA :
+                    (iOperand == Texture::ACO_ONE_MINUS_SRC_COLOR ?
+                    Texture::ACO_ONE_MINUS_SRC_ALPHA : iOperand));
+            }
+
+            for (i = 0; i < 3; i++)
+            {
+                switch (iOperand)
+                {
+                case Texture::ACO_SRC_COLOR:
+                    aafArg[k][i] = afSource[i];
+                    break;
+                case Texture::ACO_ONE_MINUS_SRC_COLOR:
+                    aafArg[k][i] = 1.0f - afSource[i];
+                    break;
+                case Texture::ACO_SRC_ALPHA:
+                    aafArg[k][i] = afSource[3];
+                    break;
+                default:  // Texture::ACO_ONE_MINUS_SRC_ALPHA
+                    aafArg[k][i] = 1.0f - afSource[3];
+                    break;
+                }
+            }
+        }
+
+        int iChannels = (c == 0 ? 3 : 1);
+        float* afOut = (c == 0 ? afResult : &afResult[3]);
+        for (i = 0; i < iChannels; i++)
+        {
+            float fA0 = aafArg[0][i], fA1 = aafArg[1][i], fA2 = aafArg[2][i];
+            switch (rkUnit.CombineFunc[c])
+            {
+            case Texture::ACF_REPLACE:
+                afOut[i] = fA0;
+                break;
+            case Texture::ACF_MODULATE:
+                afOut[i] = fA0*fA1;
+                break;
+            case Texture::ACF_ADD:
+                afOut[i] = fA0 + fA1;
+                break;
+            case Texture::ACF_ADD_SIGNED:
+                afOut[i] = fA0 + fA1 - 0.5f;
+                break;
+            case Texture::ACF_SUBTRACT:
+                afOut[i] = fA0 - fA1;
+                break;
+            case Texture::ACF_INTERPOLATE:
+                afOut[i] = fA0*fA2 + fA1*(1.0f - fA2);
+                break;
+            default:  // Texture::ACF_DOT3_RGB, Texture::ACF_DOT3_RGBA
+                afOut[i] = 4.0f*(
+                    (aafArg[0][0] - 0.5f)*(aafArg[1][0] - 0.5f) +
+                    (aafArg[0][1] - 0.5f)*(aafArg[1][1] - 0.5f) +
+                    (aafArg[0][2] - 0.5f)*(aafArg[1][2] - 0.5f));
+                break;
+            }
+        }
+    }
+
+    // DOT3_RGBA puts the dot product into alpha and ignores the alpha
+    // function
+    if (rkUnit.CombineFunc[0] == Texture::ACF_DOT3_RGBA)
+    {
+        afResult[3] = afResult[0];
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        afColor[i] = Clamp(rkUnit.CombineScale[0]*afResult[i]);
+    }
+    afColor[3] = Clamp(rkUnit.CombineScale[1]*afResult[3]);
+}
+//----------------------------------------------------------------------------
+bool SoftRenderer::TestStencilDepth (const FragmentState& rkState, float fZ,
+    unsigned char* pucStencil, float* pfDepth)
+{
+    // without a buffer the test passes, as in OpenGL
+    bool bStencil = (rkState.StencilEnabled && pucStencil);
+    unsigned int uiReference = rkState.StencilReference & 255;
+    if (bStencil)
+    {
+        unsigned int uiMask = rkState.StencilMask;
+        if (!Compare(rkState.StencilCompare,(float)(uiReference & uiMask),
+            (float)(*pucStencil & uiMask)))
+        {
+            ApplyStencil(rkState.StencilOnFail,pucStencil,uiReference,
+                rkState.StencilWriteMask);
+            return false;
+        }
+    }
+
+    bool bPass = true;
+    if (rkState.DepthEnabled && pfDepth)
+    {
+        bPass = Compare(rkState.DepthCompare,fZ,*pfDepth);
+        if (bPass && rkState.DepthWritable)
+        {
+            *pfDepth = fZ;
+        }
+    }
+
+    if (bStencil)
+    {
+        ApplyStencil(bPass ? rkState.StencilOnZPass : rkState.StencilOnZFail,
+            pucStencil,uiReference,rkState.StencilWriteMask);
+    }
+    return bPass;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::RasterizeTile (int iTile)
+{
+    // The triangles of the tile in submission order.  Every tile touches
+    // only its own pixels, so the tiles need no synchronization.
+    int iTileXMin = (iTile % m_iTileColumns)*TILE_SIZE;
+    int iTileYMin = (iTile / m_iTileColumns)*TILE_SIZE;
+    int iTileXMax = (iTileXMin + TILE_SIZE < m_iWidth ?
+        iTileXMin + TILE_SIZE : m_iWidth) - 1;
+    int iTileYMax = (iTileYMin + TILE_SIZE < m_iHeight ?
+        iTileYMin + TILE_SIZE : m_iHeight) - 1;
+
+    const Bin& rkBin = m_akBin[iTile];
+    for (int iT = 0; iT < rkBin.Quantity; iT++)
+    {
+        const Triangle* pkTri =
+            (const Triangle*)(m_aucArena + rkBin.Offset[iT]);
+        const float* afPlane = (const float*)(pkTri + 1);
+        const FragmentState& rkState = m_akState[pkTri->State];
+        int iAttributeQuantity = pkTri->AttributeQuantity;
+
+        // Without the alpha test, a fragment that reaches the stencil and
+        // depth tests is never discarded afterwards, so the tests can come
+        // before the texturing.
+        bool bEarlyTest = !rkState.AlphaTestEnabled;
+
+        int iXMin = (pkTri->XMin > iTileXMin ? pkTri->XMin : iTileXMin);
+        int iXMax = (pkTri->XMax < iTileXMax ? pkTri->XMax : iTileXMax);
+        int iYMin = (pkTri->YMin > iTileYMin ? pkTri->YMin : iTileYMin);
+        int iYMax = (pkTri->YMax < iTileYMax ? pkTri->YMax : iTileYMax);
+
+        for (int iY = iYMin; iY <= iYMax; iY++)
+        {
+            float fPY = (float)iY + 0.5f;
+            __int64 iE0 = pkTri->C[0] + (__int64)pkTri->A[0]*iXMin +
+                (__int64)pkTri->B[0]*iY;
+            __int64 iE1 = pkTri->C[1] + (__int64)pkTri->A[1]*iXMin +
+                (__int64)pkTri->B[1]*iY;
+            __int64 iE2 = pkTri->C[2] + (__int64)pkTri->A[2]*iXMin +
+                (__int64)pkTri->B[2]*iY;
+
+            for (int iX = iXMin; iX <= iXMax; iX++, iE0 += pkTri->A[0],
+                iE1 += pkTri->A[1], iE2 += pkTri->A[2])
+            {
+                if ((iE0 | iE1 | iE2) < 0)
+                {
+                    continue;
+                }
+
+                int iPixel = iY*m_iWidth + iX;
+                float fPX = (float)iX + 0.5f;
+                float fZ = Clamp(pkTri->Z[0]*fPX + pkTri->Z[1]*fPY +
+                    pkTri->Z[2]);
+                unsigned char* pucStencil =
+                    (m_aucStencil ? m_aucStencil + iPixel : 0);
+                float* pfDepth = (m_afDepth ? m_afDepth + iPixel : 0);
+
+                if (bEarlyTest
+                &&  !TestStencilDepth(rkState,fZ,pucStencil,pfDepth))
+                {
+                    continue;
+                }
+
+                // perspective correct attributes
+                float fInvW = pkTri->InvW[0]*fPX + pkTri->InvW[1]*fPY +
+                    pkTri->InvW[2];
+                float fW = 1.0f/fInvW;
+                float afAttribute[MAX_ATTRIBUTES];
+                int i;
+                for (i = 0; i < iAttributeQuantity; i++)
+                {
+                    const float* afP = &afPlane[3*i];
+                    afAttribute[i] = (afP[0]*fPX + afP[1]*fPY + afP[2])*fW;
+                }
+
+                float afPrimary[4], afColor[4];
+                for (i = 0; i < 4; i++)
+                {
+                    afPrimary[i] = Clamp(afAttribute[ATTR_COLOR+i]);
+                    afColor[i] = afPrimary[i];
+                }
+
+                for (int iUnit = 0; iUnit < rkState.UnitQuantity; iUnit++)
+                {
+                    const TextureUnit& rkUnit = rkState.Unit[iUnit];
+                    if (!rkUnit.Sampler)
+                    {
+                        continue;
+                    }
+
+                    int iSlot = ATTR_TEXTURE + 3*iUnit;
+                    float fQ = afAttribute[iSlot+2];
+                    float fInvQ = (fQ != 0.0f ? 1.0f/fQ : 0.0f);
+                    float fU = afAttribute[iSlot]*fInvQ;
+                    float fV = afAttribute[iSlot+1]*fInvQ;
+
+                    float fLod = 0.0f;
+                    if (rkUnit.Sampler->NeedsLod())
+                    {
+                        // The derivatives of u = (s/w)/(q/w) are
+                        // (d(s/w) - u*d(q/w))/(q/w), in texels.
+                        const float* afS = &afPlane[3*iSlot];
+                        const float* afT = afS + 3;
+                        const float* afQ = afS + 6;
+                        float fQW = fQ*fInvW;
+                        float fInvQW = (fQW != 0.0f ? 1.0f/fQW : 0.0f);
+                        float fWidth = (float)rkUnit.Sampler->GetWidth();
+                        float fHeight = (float)rkUnit.Sampler->GetHeight();
+                        float fDUDX = (afS[0] - fU*afQ[0])*fInvQW*fWidth;
+                        float fDUDY = (afS[1] - fU*afQ[1])*fInvQW*fWidth;
+                        float fDVDX = (afT[0] - fV*afQ[0])*fInvQW*fHeight;
+                        float fDVDY = (afT[1] - fV*afQ[1])*fInvQW*fHeight;
+                        float fRhoX = fDUDX*fDUDX + fDVDX*fDVDX;
+                        float fRhoY = fDUDY*fDUDY + fDVDY*fDVDY;
+                        float fRho = (fRhoX > fRhoY ? fRhoX : fRhoY);
+                        fLod = (fRho > 0.0f ? 0.5f*FastLog2(fRho) : -128.0f);
+                    }
+
+                    float afTexel[4];
+                    rkUnit.Sampler->Sample(fU,fV,fLod,afTexel);
+                    ApplyTexture(rkUnit,afTexel,afPrimary,afColor);
+                }
+
+                if (rkState.FogEnabled)
+                {
+                    float fFog = (rkState.FogPerPixel ?
+                        GetFogFactor(rkState,afAttribute[ATTR_FOG]) :
+                        Clamp(afAttribute[ATTR_FOG]));
+                    for (i = 0; i < 3; i++)
+                    {
+                        afColor[i] = rkState.FogColor[i] +
+                            fFog*(afColor[i] - rkState.FogColor[i]);
+                    }
+                }
+
+                if (rkState.AlphaTestEnabled)
+                {
+                    if (!Compare(rkState.AlphaTest,afColor[3],
+                        rkState.AlphaReference))
+                    {
+                        continue;
+                    }
+                    if (!TestStencilDepth(rkState,fZ,pucStencil,pfDepth))
+                    {
+                        continue;
+                    }
+                }
+
+                unsigned int* puiColor = m_auiColor + iPixel;
+                if (rkState.BlendEnabled)
+                {
+                    unsigned int uiDst = *puiColor;
+                    float afDst[4], afSrcFactor[4], afDstFactor[4];
+                    for (i = 0; i < 4; i++)
+                    {
+                        afDst[i] = ((uiDst >> (8*i)) & 255)*(1.0f/255.0f);
+                    }
+                    GetSrcFactor(rkState.SrcBlend,afColor,afDst,afSrcFactor);
+                    GetDstFactor(rkState.DstBlend,afColor,afDst,afDstFactor);
+                    for (i = 0; i < 4; i++)
+                    {
+                        afColor[i] = Clamp(afColor[i]*afSrcFactor[i] +
+                            afDst[i]*afDstFactor[i]);
+                    }
+                }
+
+                *puiColor =
+                    ((unsigned int)(afColor[0]*255.0f + 0.5f)) |
+                    ((unsigned int)(afColor[1]*255.0f + 0.5f) << 8) |
+                    ((unsigned int)(afColor[2]*255.0f + 0.5f) << 16) |
+                    ((unsigned int)(afColor[3]*255.0f + 0.5f) << 24);
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,1988 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftRenderer.cpp                 //
+//                                                       //
+//  - Implementation for SoftRenderer class              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgSoftRendererPCH.h"
+#include "WgSoftRenderer.h"
+#include "WgSoftTexture.h"
+#include "WgCamera.h"
+#include "WgEffect.h"
+#include "WgProjectedTextureEffect.h"
+#include "WgMatrix4.h"
+#include "WgProfiler.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+static void MakeIdentity (float afM[16])
+{
+    for (int i = 0; i < 16; i++)
+    {
+        afM[i] = (i % 5 == 0 ? 1.0f : 0.0f);
+    }
+}
+//----------------------------------------------------------------------------
+static void Multiply (const float afA[16], const float afB[16],
+    float afProduct[16])
+{
+    // row-major matrices, afProduct must not be one of the inputs
+    for (int iRow = 0; iRow < 4; iRow++)
+    {
+        for (int iCol = 0; iCol < 4; iCol++)
+        {
+            afProduct[4*iRow+iCol] =
+                afA[4*iRow  ]*afB[iCol   ] +
+                afA[4*iRow+1]*afB[iCol+ 4] +
+                afA[4*iRow+2]*afB[iCol+ 8] +
+                afA[4*iRow+3]*afB[iCol+12];
+        }
+    }
+}
+//----------------------------------------------------------------------------
+static Matrix4x MakeMatrix4 (const float afM[16])
+{
+    fixed afEntry[16];
+    for (int i = 0; i < 16; i++)
+    {
+        afEntry[i] = FixedFromFloat(afM[i]);
+    }
+    return Matrix4x(afEntry,true);
+}
+//----------------------------------------------------------------------------
+static void GetVector (const Vector3x& rkV, float afV[3])
+{
+    afV[0] = FloatFromFixed(rkV.X());
+    afV[1] = FloatFromFixed(rkV.Y());
+    afV[2] = FloatFromFixed(rkV.Z());
+}
+//----------------------------------------------------------------------------
+static void GetColor (const ColorRGBA& rkColor, float afColor[3])
+{
+    afColor[0] = FloatFromFixed(rkColor.R());
+    afColor[1] = FloatFromFixed(rkColor.G());
+    afColor[2] = FloatFromFixed(rkColor.B());
+}
+//----------------------------------------------------------------------------
+static float Dot (const float afU[3], const float afV[3])
+{
+    return afU[0]*afV[0] + afU[1]*afV[1] + afU[2]*afV[2];
+}
+//----------------------------------------------------------------------------
+static void Normalize (float afV[3])
+{
+    float fLength = (float)sqrt(Dot(afV,afV));
+    if (fLength > 0.0f)
+    {
+        float fInvLength = 1.0f/fLength;
+        afV[0] *= fInvLength;
+        afV[1] *= fInvLength;
+        afV[2] *= fInvLength;
+    }
+}
+//----------------------------------------------------------------------------
+static inline int FloorToInt (float fValue)
+{
+    int iValue = (int)fValue;
+    return (fValue < (float)iValue ? iValue-1 : iValue);
+}
+//----------------------------------------------------------------------------
+static inline int GetIndex (const unsigned short* ausIndex, int i)
+{
+    return (ausIndex ? (int)ausIndex[i] : i);
+}
+//----------------------------------------------------------------------------
+SoftRenderer::SoftRenderer (const BufferParams& rkBufferParams, int iWidth,
+    int iHeight, int iThreadQuantity)
+    :
+    Renderer(rkBufferParams,iWidth,iHeight),
+    m_kTexture(16,16)
+{
+    // the conventions (matrices, depth range, texture coordinates) are
+    // those of OpenGL
+    ms_eType = RT_OPENGL;
+
+    m_pkPool = WG_NEW TaskPool(iThreadQuantity);
+    CreateBuffers();
+
+    m_iArenaCapacity = 64*1024;
+    m_aucArena = WG_NEW unsigned char[m_iArenaCapacity];
+    m_iArenaQuantity = 0;
+    m_iMaxStateQuantity = 64;
+    m_akState = WG_NEW FragmentState[m_iMaxStateQuantity];
+    m_iStateQuantity = 0;
+    m_iStateIndex = -1;
+
+    // The state is compared bytewise, so the padding must be cleared.
+    memset(&m_kFragment,0,sizeof(FragmentState));
+
+    MakeIdentity(m_afView);
+    MakeIdentity(m_afProjection);
+    MakeIdentity(m_afShadow);
+    m_afViewerDirection[0] = 0.0f;
+    m_afViewerDirection[1] = 0.0f;
+    m_afViewerDirection[2] = 1.0f;
+    m_bScreenTransform = false;
+    m_bShadowTransform = false;
+
+    m_akVertex = 0;
+    m_akNormal = 0;
+    m_akColorRGBA = 0;
+    m_akColorRGB = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        m_afCurrentColor[i] = 1.0f;
+    }
+
+    m_bLighting = false;
+    memset(m_akLight,0,MAX_LIGHTS*sizeof(LightInfo));
+    m_iActiveUnit = 0;
+    memset(m_akUnit,0,MAX_TEXTURES*sizeof(UnitInfo));
+
+    m_akClipVertex = 0;
+    m_iMaxClipVertex = 0;
+    m_iAttributeQuantity = ATTR_TEXTURE;
+
+    m_iMaxTextures = MAX_TEXTURES;
+    m_iMaxLights = MAX_LIGHTS;
+    m_iMaxStencilIndices =
+        (m_kBufferParams.Stencil == BufferParams::BP_STENCIL_8 ? 256 : 0);
+
+    // the smallest resolvable depth difference for the polygon offset
+    m_fDepthResolution =
+        (m_kBufferParams.Depth == BufferParams::BP_DEPTH_16 ?
+        1.0f/65536.0f : 1.0f/16777216.0f);
+
+    // the full window until a camera is set
+    OnViewPortChange();
+
+    // initialize global render state to default settings
+    GlobalState::SetGlobalStates();
+    SetGlobalState(GlobalState::Default);
+}
+//----------------------------------------------------------------------------
+SoftRenderer::~SoftRenderer ()
+{
+    // the pending triangles are not drawn
+    for (int i = 0; i < m_kTexture.GetQuantity(); i++)
+    {
+        Texture* pkTexture = m_kTexture[i];
+        SoftTexture* pkSoftTexture;
+        pkTexture->BIArray.GetID(this,sizeof(SoftTexture*),&pkSoftTexture);
+        WG_DELETE pkSoftTexture;
+        pkTexture->BIArray.Unbind(this);
+    }
+
+    DestroyBuffers();
+    WG_DELETE[] m_aucArena;
+    WG_DELETE[] m_akState;
+    WG_DELETE[] m_akClipVertex;
+    WG_DELETE m_pkPool;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::CreateBuffers ()
+{
+    int iQuantity = m_iWidth*m_iHeight;
+    int i;
+
+    m_auiColor = WG_NEW unsigned int[iQuantity];
+    memset(m_auiColor,0,iQuantity*sizeof(unsigned int));
+
+    if (m_kBufferParams.Depth != BufferParams::BP_DEPTH_NONE)
+    {
+        m_afDepth = WG_NEW float[iQuantity];
+        for (i = 0; i < iQuantity; i++)
+        {
+            m_afDepth[i] = 1.0f;
+        }
+    }
+    else
+    {
+        m_afDepth = 0;
+    }
+
+    if (m_kBufferParams.Stencil != BufferParams::BP_STENCIL_NONE)
+    {
+        m_aucStencil = WG_NEW unsigned char[iQuantity];
+        memset(m_aucStencil,0,iQuantity);
+    }
+    else
+    {
+        m_aucStencil = 0;
+    }
+
+    m_iTileColumns = (m_iWidth + TILE_SIZE - 1)/TILE_SIZE;
+    m_iTileRows = (m_iHeight + TILE_SIZE - 1)/TILE_SIZE;
+    int iTileQuantity = m_iTileColumns*m_iTileRows;
+    m_akBin = WG_NEW Bin[iTileQuantity];
+    m_akTileTask = WG_NEW TileTask[iTileQuantity];
+    m_apkTask = WG_NEW Task*[iTileQuantity];
+    for (i = 0; i < iTileQuantity; i++)
+    {
+        m_akBin[i].Quantity = 0;
+        m_akBin[i].MaxQuantity = 0;
+        m_akBin[i].Offset = 0;
+        m_akTileTask[i].Owner = this;
+        m_akTileTask[i].Tile = i;
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::DestroyBuffers ()
+{
+    int iTileQuantity = m_iTileColumns*m_iTileRows;
+    for (int i = 0; i < iTileQuantity; i++)
+    {
+        WG_DELETE[] m_akBin[i].Offset;
+    }
+    WG_DELETE[] m_akBin;
+    WG_DELETE[] m_akTileTask;
+    WG_DELETE[] m_apkTask;
+    WG_DELETE[] m_auiColor;
+    WG_DELETE[] m_afDepth;
+    WG_DELETE[] m_aucStencil;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::Activate ()
+{
+    OnViewPortChange();
+    OnFrustumChange();
+    if (m_pkCamera)
+    {
+        OnFrameChange();
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::Resize (int iWidth, int iHeight)
+{
+    Flush();
+    DestroyBuffers();
+    Renderer::Resize(iWidth,iHeight);
+    CreateBuffers();
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ClearBackBuffer ()
+{
+    ClearRect(0,0,m_iWidth,m_iHeight,true,false,false);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ClearZBuffer ()
+{
+    ClearRect(0,0,m_iWidth,m_iHeight,false,true,false);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ClearStencilBuffer ()
+{
+    ClearRect(0,0,m_iWidth,m_iHeight,false,false,true);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ClearBuffers ()
+{
+    ClearRect(0,0,m_iWidth,m_iHeight,true,true,true);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ClearBackBuffer (int iXPos, int iYPos, int iWidth,
+    int iHeight)
+{
+    ClearRect(iXPos,iYPos,iWidth,iHeight,true,false,false);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ClearZBuffer (int iXPos, int iYPos, int iWidth,
+    int iHeight)
+{
+    ClearRect(iXPos,iYPos,iWidth,iHeight,false,true,false);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ClearStencilBuffer (int iXPos, int iYPos, int iWidth,
+    int iHeight)
+{
+    ClearRect(iXPos,iYPos,iWidth,iHeight,false,false,true);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ClearBuffers (int iXPos, int iYPos, int iWidth,
+    int iHeight)
+{
+    ClearRect(iXPos,iYPos,iWidth,iHeight,true,true,true);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ClearRect (int iXPos, int iYPos, int iWidth, int iHeight,
+    bool bColor, bool bDepth, bool bStencil)
+{
+    // the triangles drawn before the clear must not be cleared later
+    Flush();
+
+    // (iXPos,iYPos) is the lower-left corner, as for glScissor
+    int iXMin = (iXPos > 0 ? iXPos : 0);
+    int iXMax = (iXPos + iWidth < m_iWidth ? iXPos + iWidth : m_iWidth);
+    int iYMin = m_iHeight - (iYPos + iHeight);
+    int iYMax = m_iHeight - iYPos;
+    iYMin = (iYMin > 0 ? iYMin : 0);
+    iYMax = (iYMax < m_iHeight ? iYMax : m_iHeight);
+    if (iXMin >= iXMax || iYMin >= iYMax)
+    {
+        return;
+    }
+
+    unsigned int uiColor = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        float fValue = FloatFromFixed(m_kBackgroundColor[i]);
+        fValue = (fValue < 0.0f ? 0.0f : (fValue > 1.0f ? 1.0f : fValue));
+        uiColor |= ((unsigned int)(fValue*255.0f + 0.5f)) << (8*i);
+    }
+
+    int iQuantity = iXMax - iXMin;
+    for (int iY = iYMin; iY < iYMax; iY++)
+    {
+        int iRow = iY*m_iWidth + iXMin;
+        int iX;
+
+        if (bColor)
+        {
+            unsigned int* auiColor = m_auiColor + iRow;
+            for (iX = 0; iX < iQuantity; iX++)
+            {
+                auiColor[iX] = uiColor;
+            }
+        }
+
+        if (bDepth && m_afDepth)
+        {
+            float* afDepth = m_afDepth + iRow;
+            for (iX = 0; iX < iQuantity; iX++)
+            {
+                afDepth[iX] = 1.0f;
+            }
+        }
+
+        if (bStencil && m_aucStencil)
+        {
+            memset(m_aucStencil + iRow,0,iQuantity);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::DisplayBackBuffer ()
+{
+    Flush();
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::Flush ()
+{
+    int iTileQuantity = m_iTileColumns*m_iTileRows;
+    int iTaskQuantity = 0;
+    int i;
+
+    for (i = 0; i < iTileQuantity; i++)
+    {
+        if (m_akBin[i].Quantity > 0)
+        {
+            m_apkTask[iTaskQuantity++] = &m_akTileTask[i];
+        }
+    }
+
+    if (iTaskQuantity > 0)
+    {
+        m_pkPool->Run(iTaskQuantity,m_apkTask);
+        for (i = 0; i < iTileQuantity; i++)
+        {
+            m_akBin[i].Quantity = 0;
+        }
+    }
+
+    m_iArenaQuantity = 0;
+    m_iStateQuantity = 0;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::OnFrustumChange ()
+{
+    if (m_pkCamera)
+    {
+        fixed fL, fR, fB, fT, fN, fF;
+        m_pkCamera->GetFrustum(fL,fR,fB,fT,fN,fF);
+        float fLeft = FloatFromFixed(fL), fRight = FloatFromFixed(fR);
+        float fBottom = FloatFromFixed(fB), fTop = FloatFromFixed(fT);
+        float fNear = FloatFromFixed(fN), fFar = FloatFromFixed(fF);
+        float fInvRmL = 1.0f/(fRight - fLeft);
+        float fInvTmB = 1.0f/(fTop - fBottom);
+        float fInvFmN = 1.0f/(fFar - fNear);
+
+        // glFrustum and glOrtho
+        memset(m_afProjection,0,16*sizeof(float));
+        if (m_pkCamera->Perspective)
+        {
+            m_afProjection[ 0] = 2.0f*fNear*fInvRmL;
+            m_afProjection[ 2] = (fRight + fLeft)*fInvRmL;
+            m_afProjection[ 5] = 2.0f*fNear*fInvTmB;
+            m_afProjection[ 6] = (fTop + fBottom)*fInvTmB;
+            m_afProjection[10] = -(fFar + fNear)*fInvFmN;
+            m_afProjection[11] = -2.0f*fFar*fNear*fInvFmN;
+            m_afProjection[14] = -1.0f;
+        }
+        else
+        {
+            m_afProjection[ 0] = 2.0f*fInvRmL;
+            m_afProjection[ 3] = -(fRight + fLeft)*fInvRmL;
+            m_afProjection[ 5] = 2.0f*fInvTmB;
+            m_afProjection[ 7] = -(fTop + fBottom)*fInvTmB;
+            m_afProjection[10] = -2.0f*fInvFmN;
+            m_afProjection[11] = -(fFar + fNear)*fInvFmN;
+            m_afProjection[15] = 1.0f;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::OnViewPortChange ()
+{
+    fixed fL, fR, fT, fB;
+    if (m_pkCamera)
+    {
+        // 3D applications use cameras
+        m_pkCamera->GetViewPort(fL,fR,fT,fB);
+    }
+    else
+    {
+        // 2D applications do not use camera
+        fL = FIXED_ZERO;
+        fR = FIXED_ONE;
+        fT = FIXED_ONE;
+        fB = FIXED_ZERO;
+    }
+
+    // the viewport in pixels as glViewport gets it, then with the rows
+    // counted from the top
+    int iX = (int)(FloatFromFixed(fL)*m_iWidth);
+    int iY = (int)(FloatFromFixed(fB)*m_iHeight);
+    int iW = (int)((FloatFromFixed(fR) - FloatFromFixed(fL))*m_iWidth);
+    int iH = (int)((FloatFromFixed(fT) - FloatFromFixed(fB))*m_iHeight);
+    int iTop = m_iHeight - (iY + iH);
+
+    m_fPortX = (float)iX;
+    m_fPortY = (float)iTop;
+    m_fPortWidth = (float)iW;
+    m_fPortHeight = (float)iH;
+    m_iPortXMin = (iX > 0 ? iX : 0);
+    m_iPortYMin = (iTop > 0 ? iTop : 0);
+    m_iPortXMax = (iX + iW < m_iWidth ? iX + iW : m_iWidth) - 1;
+    m_iPortYMax = (iTop + iH < m_iHeight ? iTop + iH : m_iHeight) - 1;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::OnFrameChange ()
+{
+    float afE[3], afR[3], afU[3], afD[3];
+    GetVector(m_pkCamera->GetWorldLocation(),afE);
+    GetVector(m_pkCamera->GetWorldRVector(),afR);
+    GetVector(m_pkCamera->GetWorldUVector(),afU);
+    GetVector(m_pkCamera->GetWorldDVector(),afD);
+
+    // the rows are (R,U,-D), as gluLookAt makes them
+    for (int i = 0; i < 3; i++)
+    {
+        m_afView[i] = afR[i];
+        m_afView[4+i] = afU[i];
+        m_afView[8+i] = -afD[i];
+        m_afViewerDirection[i] = -afD[i];
+    }
+    m_afView[ 3] = -Dot(afR,afE);
+    m_afView[ 7] = -Dot(afU,afE);
+    m_afView[11] = Dot(afD,afE);
+    m_afView[12] = 0.0f;
+    m_afView[13] = 0.0f;
+    m_afView[14] = 0.0f;
+    m_afView[15] = 1.0f;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::EnableLighting (int eEnable)
+{
+    int iQuantity = m_pkGeometry->Lights.GetQuantity();
+    if (iQuantity >= m_iMaxLights)
+    {
+        iQuantity = m_iMaxLights;
+    }
+
+    if (iQuantity > 0)
+    {
+        m_bLighting = true;
+        for (int i = 0; i < iQuantity; i++)
+        {
+            const Light* pkLight = m_pkGeometry->Lights[i];
+            if (pkLight->On)
+            {
+                EnableLight(eEnable,i,pkLight);
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::DisableLighting ()
+{
+    int iQuantity = m_pkGeometry->Lights.GetQuantity();
+    if (iQuantity >= m_iMaxLights)
+    {
+        iQuantity = m_iMaxLights;
+    }
+
+    if (iQuantity > 0)
+    {
+        for (int i = 0; i < iQuantity; i++)
+        {
+            const Light* pkLight = m_pkGeometry->Lights[i];
+            if (pkLight->On)
+            {
+                DisableLight(i,pkLight);
+            }
+        }
+        m_bLighting = false;
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::EnableLight (int eEnable, int i, const Light* pkLight)
+{
+    LightInfo& rkInfo = m_akLight[i];
+    rkInfo.Enabled = true;
+    rkInfo.Type = pkLight->Type;
+
+    // The terms that are not enabled are black.  An ambient light has only
+    // the ambient term.
+    ColorRGBA kColor;
+    if (eEnable & EL_AMBIENT)
+    {
+        kColor = pkLight->Intensity*pkLight->Ambient;
+        kColor.Clamp();
+    }
+    else
+    {
+        kColor = ColorRGBA::BLACK;
+    }
+    GetColor(kColor,rkInfo.Ambient);
+
+    if ((eEnable & EL_DIFFUSE) && pkLight->Type != Light::LT_AMBIENT)
+    {
+        kColor = pkLight->Intensity*pkLight->Diffuse;
+        kColor.Clamp();
+    }
+    else
+    {
+        kColor = ColorRGBA::BLACK;
+    }
+    GetColor(kColor,rkInfo.Diffuse);
+
+    if ((eEnable & EL_SPECULAR) && pkLight->Type != Light::LT_AMBIENT)
+    {
+        kColor = pkLight->Intensity*pkLight->Specular;
+        kColor.Clamp();
+    }
+    else
+    {
+        kColor = ColorRGBA::BLACK;
+    }
+    GetColor(kColor,rkInfo.Specular);
+
+    if (pkLight->Attenuate)
+    {
+        rkInfo.Constant = FloatFromFixed(pkLight->Constant);
+        rkInfo.Linear = FloatFromFixed(pkLight->Linear);
+        rkInfo.Quadratic = FloatFromFixed(pkLight->Quadratic);
+    }
+    else
+    {
+        rkInfo.Constant = 1.0f;
+        rkInfo.Linear = 0.0f;
+        rkInfo.Quadratic = 0.0f;
+    }
+
+    switch (pkLight->Type)
+    {
+    case Light::LT_AMBIENT:
+        rkInfo.Position[0] = 0.0f;
+        rkInfo.Position[1] = 0.0f;
+        rkInfo.Position[2] = 1.0f;
+        break;
+    case Light::LT_DIRECTIONAL:
+        GetVector(pkLight->GetWorldDVector(),rkInfo.Position);
+        rkInfo.Position[0] = -rkInfo.Position[0];
+        rkInfo.Position[1] = -rkInfo.Position[1];
+        rkInfo.Position[2] = -rkInfo.Position[2];
+        Normalize(rkInfo.Position);
+        break;
+    case Light::LT_POINT:
+    case Light::LT_SPOT:
+        GetVector(pkLight->GetWorldLocation(),rkInfo.Position);
+        break;
+    default:  // Light::LT_QUANTITY
+        assert(false);
+        break;
+    }
+
+    if (pkLight->Type == Light::LT_SPOT)
+    {
+        GetVector(pkLight->GetWorldDVector(),rkInfo.Direction);
+        Normalize(rkInfo.Direction);
+        rkInfo.SpotCosine = (float)cos(FloatFromFixed(pkLight->Angle));
+        rkInfo.SpotExponent = FloatFromFixed(pkLight->Exponent);
+    }
+    else
+    {
+        rkInfo.Direction[0] = 0.0f;
+        rkInfo.Direction[1] = 0.0f;
+        rkInfo.Direction[2] = -1.0f;
+        rkInfo.SpotCosine = -1.0f;
+        rkInfo.SpotExponent = 0.0f;
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::DisableLight (int i, const Light*)
+{
+    m_akLight[i].Enabled = false;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::LightVertex (const float afPosition[3],
+    const float afNormal[3], float afColor[4]) const
+{
+    // The lighting equation of OpenGL ES with a black light model ambient,
+    // a nonlocal viewer and one-sided lighting.  The colors of the vertices
+    // are not used as material colors.
+    float afSum[3] =
+    {
+        m_afEmissive[0],
+        m_afEmissive[1],
+        m_afEmissive[2]
+    };
+
+    for (int i = 0; i < MAX_LIGHTS; i++)
+    {
+        const LightInfo& rkInfo = m_akLight[i];
+        if (!rkInfo.Enabled)
+        {
+            continue;
+        }
+
+        float afL[3];
+        float fScale = 1.0f;
+        if (rkInfo.Type == Light::LT_POINT || rkInfo.Type == Light::LT_SPOT)
+        {
+            afL[0] = rkInfo.Position[0] - afPosition[0];
+            afL[1] = rkInfo.Position[1] - afPosition[1];
+            afL[2] = rkInfo.Position[2] - afPosition[2];
+            float fDistance = (float)sqrt(Dot(afL,afL));
+            if (fDistance > 0.0f)
+            {
+                float fInvDistance = 1.0f/fDistance;
+                afL[0] *= fInvDistance;
+                afL[1] *= fInvDistance;
+                afL[2] *= fInvDistance;
+            }
+
+            float fDenom = rkInfo.Constant + fDistance*(rkInfo.Linear +
+                fDistance*rkInfo.Quadratic);
+            fScale = (fDenom > 0.0f ? 1.0f/fDenom : 1.0f);
+
+            if (rkInfo.Type == Light::LT_SPOT)
+            {
+                float fSpot = -Dot(afL,rkInfo.Direction);
+                if (fSpot < rkInfo.SpotCosine)
+                {
+                    continue;
+                }
+                if (rkInfo.SpotExponent != 0.0f)
+                {
+                    fScale *= (float)pow(fSpot,rkInfo.SpotExponent);
+                }
+            }
+        }
+        else
+        {
+            afL[0] = rkInfo.Position[0];
+            afL[1] = rkInfo.Position[1];
+            afL[2] = rkInfo.Position[2];
+        }
+
+        float afTerm[3];
+        int j;
+        for (j = 0; j < 3; j++)
+        {
+            afTerm[j] = rkInfo.Ambient[j]*m_afAmbient[j];
+        }
+
+        float fNdL = Dot(afNormal,afL);
+        if (fNdL > 0.0f)
+        {
+            float afH[3] =
+            {
+                afL[0] + m_afViewerDirection[0],
+                afL[1] + m_afViewerDirection[1],
+                afL[2] + m_afViewerDirection[2]
+            };
+            Normalize(afH);
+            float fNdH = Dot(afNormal,afH);
+            float fSpecular = 0.0f;
+            if (fNdH > 0.0f)
+            {
+                fSpecular = (m_fShininess != 0.0f ?
+                    (float)pow(fNdH,m_fShininess) : 1.0f);
+            }
+
+            for (j = 0; j < 3; j++)
+            {
+                afTerm[j] += fNdL*rkInfo.Diffuse[j]*m_afDiffuse[j] +
+                    fSpecular*rkInfo.Specular[j]*m_afSpecular[j];
+            }
+        }
+
+        for (j = 0; j < 3; j++)
+        {
+            afSum[j] += fScale*afTerm[j];
+        }
+    }
+
+    for (int j = 0; j < 3; j++)
+    {
+        afColor[j] = (afSum[j] < 0.0f ? 0.0f :
+            (afSum[j] > 1.0f ? 1.0f : afSum[j]));
+    }
+    afColor[3] = (m_afDiffuse[3] < 0.0f ? 0.0f :
+        (m_afDiffuse[3] > 1.0f ? 1.0f : m_afDiffuse[3]));
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::EnableTexture (int iUnit, int i, Effect* pkEffect)
+{
+    SetActiveTextureUnit(iUnit);
+    if (iUnit >= MAX_TEXTURES)
+    {
+        return;
+    }
+
+    UnitInfo& rkUnit = m_akUnit[iUnit];
+    rkUnit.UVs = 0;
+    if (i < pkEffect->UVs.GetQuantity())
+    {
+        Vector2xArray* pkUVs = pkEffect->UVs[i];
+        if (pkUVs)
+        {
+            EnableUVs(i,pkEffect);
+        }
+    }
+
+    // The coordinates of a unit without UVs are generated, OpenGL ES has no
+    // glTexGen to do it.
+    Texture* pkTexture = pkEffect->Textures[i];
+    rkUnit.Texgen = pkTexture->Texgen;
+    rkUnit.HasProjector = false;
+    if (!rkUnit.UVs && rkUnit.Texgen == Texture::TG_PROJECTED_TEXTURE)
+    {
+        ProjectedTextureEffect* pkPTEffect =
+            DynamicCast<ProjectedTextureEffect>(pkEffect);
+        Camera* pkProjector = (pkPTEffect ? pkPTEffect->GetCamera() : 0);
+        if (pkProjector)
+        {
+            rkUnit.HasProjector = true;
+            rkUnit.Perspective = pkProjector->Perspective;
+            GetVector(pkProjector->GetWorldLocation(),rkUnit.Location);
+            GetVector(pkProjector->GetWorldRVector(),rkUnit.Axis[0]);
+            GetVector(pkProjector->GetWorldUVector(),rkUnit.Axis[1]);
+            GetVector(pkProjector->GetWorldDVector(),rkUnit.Axis[2]);
+            rkUnit.Frustum[0] = FloatFromFixed(pkProjector->GetRMin());
+            rkUnit.Frustum[1] = FloatFromFixed(pkProjector->GetRMax());
+            rkUnit.Frustum[2] = FloatFromFixed(pkProjector->GetUMin());
+            rkUnit.Frustum[3] = FloatFromFixed(pkProjector->GetUMax());
+            rkUnit.Frustum[4] = FloatFromFixed(pkProjector->GetDMin());
+        }
+    }
+
+    SoftTexture* pkSoftTexture;
+    pkTexture->BIArray.GetID(this,sizeof(SoftTexture*),&pkSoftTexture);
+    if (!pkSoftTexture)
+    {
+        // texture seen first time, convert the image and build the mipmaps
+        pkSoftTexture = WG_NEW SoftTexture(pkTexture);
+        pkTexture->BIArray.Bind(this,sizeof(SoftTexture*),&pkSoftTexture);
+        m_kTexture.Append(pkTexture);
+    }
+
+    static const float s_afScale[Texture::ACSC_QUANTITY] =
+    {
+        1.0f, 2.0f, 4.0f
+    };
+
+    TextureUnit& rkState = m_kFragment.Unit[iUnit];
+    rkState.Sampler = pkSoftTexture;
+    rkState.Apply = pkTexture->Apply;
+    rkState.HasAlpha = pkSoftTexture->HasAlpha();
+    rkState.Projected = (rkUnit.HasProjector != 0);
+    for (int j = 0; j < 4; j++)
+    {
+        rkState.Color[j] = FloatFromFixed(pkTexture->BlendColor[j]);
+    }
+    rkState.CombineFunc[0] = pkTexture->CombineFuncRGB;
+    rkState.CombineFunc[1] = pkTexture->CombineFuncAlpha;
+    rkState.CombineSrc[0][0] = pkTexture->CombineSrc0RGB;
+    rkState.CombineSrc[0][1] = pkTexture->CombineSrc1RGB;
+    rkState.CombineSrc[0][2] = pkTexture->CombineSrc2RGB;
+    rkState.CombineSrc[1][0] = pkTexture->CombineSrc0Alpha;
+    rkState.CombineSrc[1][1] = pkTexture->CombineSrc1Alpha;
+    rkState.CombineSrc[1][2] = pkTexture->CombineSrc2Alpha;
+    rkState.CombineOp[0][0] = pkTexture->CombineOp0RGB;
+    rkState.CombineOp[0][1] = pkTexture->CombineOp1RGB;
+    rkState.CombineOp[0][2] = pkTexture->CombineOp2RGB;
+    rkState.CombineOp[1][0] = pkTexture->CombineOp0Alpha;
+    rkState.CombineOp[1][1] = pkTexture->CombineOp1Alpha;
+    rkState.CombineOp[1][2] = pkTexture->CombineOp2Alpha;
+    rkState.CombineScale[0] = s_afScale[pkTexture->CombineScaleRGB];
+    rkState.CombineScale[1] = s_afScale[pkTexture->CombineScaleAlpha];
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::DisableTexture (int iUnit, int, Effect*)
+{
+    if (iUnit < MAX_TEXTURES)
+    {
+        memset(&m_kFragment.Unit[iUnit],0,sizeof(TextureUnit));
+        memset(&m_akUnit[iUnit],0,sizeof(UnitInfo));
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::SetActiveTextureUnit (int iUnit)
+{
+    m_iActiveUnit = iUnit;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ReleaseTexture (Texture* pkTexture)
+{
+    assert(pkTexture);
+    SoftTexture* pkSoftTexture;
+    pkTexture->BIArray.GetID(this,sizeof(SoftTexture*),&pkSoftTexture);
+    if (pkSoftTexture)
+    {
+        // the pending triangles may sample the texture
+        Flush();
+
+        WG_DELETE pkSoftTexture;
+        pkTexture->BIArray.Unbind(this);
+        for (int i = 0; i < m_kTexture.GetQuantity(); i++)
+        {
+            if (m_kTexture[i] == pkTexture)
+            {
+                m_kTexture.Remove(i);
+                break;
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::SetWorldTransformation ()
+{
+    // the world matrix is read from the geometry when it is drawn
+    m_bScreenTransform = false;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::RestoreWorldTransformation ()
+{
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::SetScreenTransformation ()
+{
+    // Draw the polygon using an orthogonal frustum.  If the polygon has
+    // a z-value of 0.0, it is drawn in front of everything.  If the
+    // polygon has a z-value of 1.0, it is drawn in back of everything.
+    m_bScreenTransform = true;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::RestoreScreenTransformation ()
+{
+    m_bScreenTransform = false;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::EnableVertices ()
+{
+    m_akVertex = m_pkGeometry->Vertices->GetData();
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::DisableVertices ()
+{
+    m_akVertex = 0;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::EnableNormals ()
+{
+    m_akNormal = m_pkGeometry->Normals->GetData();
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::DisableNormals ()
+{
+    m_akNormal = 0;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::EnableColorRGBAs ()
+{
+    m_akColorRGBA = m_pkLocalEffect->ColorRGBAs->GetData();
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::DisableColorRGBAs ()
+{
+    m_akColorRGBA = 0;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::EnableColorRGBs ()
+{
+    m_akColorRGB = m_pkLocalEffect->ColorRGBs->GetData();
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::DisableColorRGBs ()
+{
+    m_akColorRGB = 0;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::EnableUVs (int i, Effect* pkEffect)
+{
+    if (m_iActiveUnit < MAX_TEXTURES)
+    {
+        m_akUnit[m_iActiveUnit].UVs = pkEffect->UVs[i]->GetData();
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::DisableUVs (Vector2xArray*)
+{
+    if (m_iActiveUnit < MAX_TEXTURES)
+    {
+        m_akUnit[m_iActiveUnit].UVs = 0;
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ReleaseArray (CachedColorRGBAArray*)
+{
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ReleaseArray (CachedColorRGBArray*)
+{
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ReleaseArray (CachedShortArray*)
+{
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ReleaseArray (CachedVector2xArray*)
+{
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::ReleaseArray (CachedVector3xArray*)
+{
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::GetWorldMatrix (float afMatrix[16]) const
+{
+    if (m_bScreenTransform)
+    {
+        MakeIdentity(afMatrix);
+        return;
+    }
+
+    // the homogeneous matrix is stored in column-major order
+    const fixed* afH = m_pkGeometry->GetWorldHomogeneous();
+    for (int iRow = 0; iRow < 4; iRow++)
+    {
+        for (int iCol = 0; iCol < 4; iCol++)
+        {
+            afMatrix[4*iRow+iCol] = FloatFromFixed(afH[4*iCol+iRow]);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::GetModelViewMatrix (float afMatrix[16]) const
+{
+    if (m_bScreenTransform)
+    {
+        MakeIdentity(afMatrix);
+        return;
+    }
+
+    float afWorld[16], afTmp[16];
+    GetWorldMatrix(afWorld);
+    if (m_bShadowTransform)
+    {
+        Multiply(m_afShadow,afWorld,afTmp);
+        Multiply(m_afView,afTmp,afMatrix);
+    }
+    else
+    {
+        Multiply(m_afView,afWorld,afMatrix);
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::GetProjectionMatrix (float afMatrix[16]) const
+{
+    if (m_bScreenTransform)
+    {
+        // glOrtho(0,1,0,1,0,-1)
+        MakeIdentity(afMatrix);
+        afMatrix[ 0] = 2.0f;
+        afMatrix[ 3] = -1.0f;
+        afMatrix[ 5] = 2.0f;
+        afMatrix[ 7] = -1.0f;
+        afMatrix[10] = 2.0f;
+        afMatrix[11] = -1.0f;
+        return;
+    }
+
+    memcpy(afMatrix,m_afProjection,16*sizeof(float));
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::DrawElements ()
+{
+    WG3D_PROFILE("SoftRenderer::DrawElements");
+
+    if (!m_akVertex)
+    {
+        return;
+    }
+
+    // bound the memory of the pending triangles
+    if (m_iArenaQuantity > ARENA_CAPACITY)
+    {
+        Flush();
+    }
+
+    int iVQuantity = m_pkGeometry->Vertices->GetQuantity();
+    const unsigned short* ausIndex = 0;
+    int iIQuantity = iVQuantity;
+    ShortArray* pkIndices = m_pkGeometry->Indices;
+    if (pkIndices && pkIndices->GetData())
+    {
+        ausIndex = (const unsigned short*)pkIndices->GetData();
+        iIQuantity = pkIndices->GetQuantity();
+    }
+    if (iVQuantity <= 0 || iIQuantity <= 0)
+    {
+        return;
+    }
+
+    m_iStateIndex = GetStateIndex();
+    TransformVertices(iVQuantity);
+
+    const ClipVertex* akV = m_akClipVertex;
+    int i, i0, i1, i2;
+
+    switch (m_pkGeometry->m_GeometryType)
+    {
+    case Geometry::GT_POLYPOINT:
+        for (i = 0; i < iIQuantity; i++)
+        {
+            i0 = GetIndex(ausIndex,i);
+            if (i0 < iVQuantity)
+            {
+                DrawPoint(akV[i0]);
+            }
+        }
+        break;
+    case Geometry::GT_POLYLINE_SEGMENTS:
+    case Geometry::GT_POLYLINE_OPEN:
+    case Geometry::GT_POLYLINE_CLOSED:
+    {
+        int iStep = (m_pkGeometry->m_GeometryType ==
+            Geometry::GT_POLYLINE_SEGMENTS ? 2 : 1);
+        int iLast = iIQuantity - 1;
+        if (m_pkGeometry->m_GeometryType == Geometry::GT_POLYLINE_CLOSED
+        &&  iIQuantity > 2)
+        {
+            iLast = iIQuantity;
+        }
+        for (i = 0; i < iLast; i += iStep)
+        {
+            i0 = GetIndex(ausIndex,i);
+            i1 = GetIndex(ausIndex,(i + 1) % iIQuantity);
+            if (i0 < iVQuantity && i1 < iVQuantity)
+            {
+                DrawLine(akV[i0],akV[i1]);
+            }
+        }
+        break;
+    }
+    case Geometry::GT_TRIMESH:
+        for (i = 0; i + 2 < iIQuantity; i += 3)
+        {
+            i0 = GetIndex(ausIndex,i);
+            i1 = GetIndex(ausIndex,i+1);
+            i2 = GetIndex(ausIndex,i+2);
+            if (i0 < iVQuantity && i1 < iVQuantity && i2 < iVQuantity)
+            {
+                DrawTriangle(akV[i0],akV[i1],akV[i2],true);
+            }
+        }
+        break;
+    case Geometry::GT_TRISTRIP:
+        for (i = 0; i + 2 < iIQuantity; i++)
+        {
+            // the odd triangles are reversed to keep the orientation
+            i0 = GetIndex(ausIndex,(i & 1) ? i+1 : i);
+            i1 = GetIndex(ausIndex,(i & 1) ? i : i+1);
+            i2 = GetIndex(ausIndex,i+2);
+            if (i0 < iVQuantity && i1 < iVQuantity && i2 < iVQuantity)
+            {
+                DrawTriangle(akV[i0],akV[i1],akV[i2],true);
+            }
+        }
+        break;
+    case Geometry::GT_TRIFAN:
+        i0 = GetIndex(ausIndex,0);
+        for (i = 1; i + 1 < iIQuantity; i++)
+        {
+            i1 = GetIndex(ausIndex,i);
+            i2 = GetIndex(ausIndex,i+1);
+            if (i0 < iVQuantity && i1 < iVQuantity && i2 < iVQuantity)
+            {
+                DrawTriangle(akV[i0],akV[i1],akV[i2],true);
+            }
+        }
+        break;
+    default:  // Geometry::GT_MAX_QUANTITY
+        assert(false);
+        break;
+    }
+}
+//----------------------------------------------------------------------------
+int SoftRenderer::GetStateIndex ()
+{
+    m_kFragment.UnitQuantity = 0;
+    for (int i = MAX_TEXTURES-1; i >= 0; i--)
+    {
+        if (m_kFragment.Unit[i].Sampler)
+        {
+            m_kFragment.UnitQuantity = i + 1;
+            break;
+        }
+    }
+
+    // consecutive draws usually share the state
+    if (m_iStateQuantity > 0 && memcmp(&m_akState[m_iStateQuantity-1],
+        &m_kFragment,sizeof(FragmentState)) == 0)
+    {
+        return m_iStateQuantity - 1;
+    }
+
+    if (m_iStateQuantity == m_iMaxStateQuantity)
+    {
+        int iNewMaxQuantity = 2*m_iMaxStateQuantity;
+        FragmentState* akNewState = WG_NEW FragmentState[iNewMaxQuantity];
+        memcpy(akNewState,m_akState,
+            m_iStateQuantity*sizeof(FragmentState));
+        WG_DELETE[] m_akState;
+        m_akState = akNewState;
+        m_iMaxStateQuantity = iNewMaxQuantity;
+    }
+
+    memcpy(&m_akState[m_iStateQuantity],&m_kFragment,sizeof(FragmentState));
+    return m_iStateQuantity++;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::TransformVertices (int iQuantity)
+{
+    if (iQuantity > m_iMaxClipVertex)
+    {
+        WG_DELETE[] m_akClipVertex;
+        m_iMaxClipVertex = iQuantity;
+        m_akClipVertex = WG_NEW ClipVertex[m_iMaxClipVertex];
+    }
+
+    int iUnitQuantity = m_kFragment.UnitQuantity;
+    m_iAttributeQuantity = ATTR_TEXTURE + 3*iUnitQuantity;
+
+    float afWorld[16], afModelView[16], afProjection[16], afMVP[16];
+    GetWorldMatrix(afWorld);
+    GetModelViewMatrix(afModelView);
+    GetProjectionMatrix(afProjection);
+    Multiply(afProjection,afModelView,afMVP);
+
+    // which of the spaces the vertex needs
+    bool bWorld = m_bLighting;
+    bool bEye = m_kFragment.FogEnabled;
+    bool bNormal = m_bLighting;
+    int iUnit;
+    for (iUnit = 0; iUnit < iUnitQuantity; iUnit++)
+    {
+        const UnitInfo& rkUnit = m_akUnit[iUnit];
+        if (m_kFragment.Unit[iUnit].Sampler && !rkUnit.UVs)
+        {
+            if (rkUnit.Texgen == Texture::TG_ENVIRONMENT_MAP)
+            {
+                bEye = true;
+                bNormal = true;
+            }
+            else if (rkUnit.Texgen == Texture::TG_PROJECTED_TEXTURE)
+            {
+                bWorld = true;
+            }
+        }
+    }
+
+    // The normals are transformed by the cofactors of the world matrix,
+    // the inverse transpose up to the determinant.  Its sign keeps the
+    // normals of mirrored objects pointing out.
+    float afNormalMatrix[9];
+    const float* afW = afWorld;
+    afNormalMatrix[0] = afW[5]*afW[10] - afW[6]*afW[9];
+    afNormalMatrix[1] = afW[6]*afW[8] - afW[4]*afW[10];
+    afNormalMatrix[2] = afW[4]*afW[9] - afW[5]*afW[8];
+    afNormalMatrix[3] = afW[2]*afW[9] - afW[1]*afW[10];
+    afNormalMatrix[4] = afW[0]*afW[10] - afW[2]*afW[8];
+    afNormalMatrix[5] = afW[1]*afW[8] - afW[0]*afW[9];
+    afNormalMatrix[6] = afW[1]*afW[6] - afW[2]*afW[5];
+    afNormalMatrix[7] = afW[2]*afW[4] - afW[0]*afW[6];
+    afNormalMatrix[8] = afW[0]*afW[5] - afW[1]*afW[4];
+    float fDet = afW[0]*afNormalMatrix[0] + afW[1]*afNormalMatrix[1] +
+        afW[2]*afNormalMatrix[2];
+    if (fDet < 0.0f)
+    {
+        for (int j = 0; j < 9; j++)
+        {
+            afNormalMatrix[j] = -afNormalMatrix[j];
+        }
+    }
+
+    const fixed* afVertex = (const fixed*)m_akVertex;
+    const fixed* afNormal = (const fixed*)m_akNormal;
+    const fixed* afRGBA = (const fixed*)m_akColorRGBA;
+    const fixed* afRGB = (const fixed*)m_akColorRGB;
+
+    for (int i = 0; i < iQuantity; i++)
+    {
+        ClipVertex& rkV = m_akClipVertex[i];
+        float afP[3] =
+        {
+            FloatFromFixed(afVertex[3*i]),
+            FloatFromFixed(afVertex[3*i+1]),
+            FloatFromFixed(afVertex[3*i+2])
+        };
+
+        int j;
+        for (j = 0; j < 4; j++)
+        {
+            const float* afRow = &afMVP[4*j];
+            rkV.Position[j] = afRow[0]*afP[0] + afRow[1]*afP[1] +
+                afRow[2]*afP[2] + afRow[3];
+        }
+
+        float afWorldP[3], afEyeP[3], afWorldN[3], afEyeN[3];
+        if (bWorld)
+        {
+            for (j = 0; j < 3; j++)
+            {
+                const float* afRow = &afWorld[4*j];
+                afWorldP[j] = afRow[0]*afP[0] + afRow[1]*afP[1] +
+                    afRow[2]*afP[2] + afRow[3];
+            }
+        }
+        if (bEye)
+        {
+            for (j = 0; j < 3; j++)
+            {
+                const float* afRow = &afModelView[4*j];
+                afEyeP[j] = afRow[0]*afP[0] + afRow[1]*afP[1] +
+                    afRow[2]*afP[2] + afRow[3];
+            }
+        }
+        if (bNormal)
+        {
+            // the current normal of OpenGL is (0,0,1)
+            float afN[3] = { 0.0f, 0.0f, 1.0f };
+            if (afNormal)
+            {
+                afN[0] = FloatFromFixed(afNormal[3*i]);
+                afN[1] = FloatFromFixed(afNormal[3*i+1]);
+                afN[2] = FloatFromFixed(afNormal[3*i+2]);
+            }
+            for (j = 0; j < 3; j++)
+            {
+                afWorldN[j] = afNormalMatrix[3*j]*afN[0] +
+                    afNormalMatrix[3*j+1]*afN[1] +
+                    afNormalMatrix[3*j+2]*afN[2];
+            }
+            Normalize(afWorldN);
+
+            if (m_bScreenTransform)
+            {
+                afEyeN[0] = afWorldN[0];
+                afEyeN[1] = afWorldN[1];
+                afEyeN[2] = afWorldN[2];
+            }
+            else
+            {
+                for (j = 0; j < 3; j++)
+                {
+                    afEyeN[j] = Dot(&m_afView[4*j],afWorldN);
+                }
+            }
+        }
+
+        float* afColor = rkV.Attribute + ATTR_COLOR;
+        if (m_bLighting)
+        {
+            LightVertex(afWorldP,afWorldN,afColor);
+        }
+        else if (afRGBA)
+        {
+            for (j = 0; j < 4; j++)
+            {
+                afColor[j] = FloatFromFixed(afRGBA[4*i+j]);
+            }
+        }
+        else if (afRGB)
+        {
+            for (j = 0; j < 3; j++)
+            {
+                afColor[j] = FloatFromFixed(afRGB[3*i+j]);
+            }
+            afColor[3] = 1.0f;
+        }
+        else
+        {
+            for (j = 0; j < 4; j++)
+            {
+                afColor[j] = m_afCurrentColor[j];
+            }
+        }
+
+        if (m_kFragment.FogEnabled)
+        {
+            float fDistance = (float)fabs(afEyeP[2]);
+            rkV.Attribute[ATTR_FOG] = (m_kFragment.FogPerPixel ? fDistance :
+                GetFogFactor(m_kFragment,fDistance));
+        }
+        else
+        {
+            rkV.Attribute[ATTR_FOG] = 1.0f;
+        }
+
+        for (iUnit = 0; iUnit < iUnitQuantity; iUnit++)
+        {
+            float* afSTQ = rkV.Attribute + ATTR_TEXTURE + 3*iUnit;
+            const Vector2x* akUV = m_akUnit[iUnit].UVs;
+            if (!m_kFragment.Unit[iUnit].Sampler)
+            {
+                afSTQ[0] = 0.0f;
+                afSTQ[1] = 0.0f;
+                afSTQ[2] = 1.0f;
+            }
+            else if (akUV)
+            {
+                const fixed* afUV = (const fixed*)akUV;
+                afSTQ[0] = FloatFromFixed(afUV[2*i]);
+                afSTQ[1] = FloatFromFixed(afUV[2*i+1]);
+                afSTQ[2] = 1.0f;
+            }
+            else
+            {
+                GenerateCoordinates(iUnit,afWorldP,afEyeP,afEyeN,afSTQ);
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::GenerateCoordinates (int iUnit, const float afWorld[3],
+    const float afEye[3], const float afEyeNormal[3], float* afSTQ) const
+{
+    const UnitInfo& rkUnit = m_akUnit[iUnit];
+    afSTQ[0] = 0.0f;
+    afSTQ[1] = 0.0f;
+    afSTQ[2] = 1.0f;
+
+    if (rkUnit.Texgen == Texture::TG_ENVIRONMENT_MAP)
+    {
+        // the sphere map of glTexGen
+        float afU[3] = { afEye[0], afEye[1], afEye[2] };
+        Normalize(afU);
+        float fNdU = 2.0f*Dot(afEyeNormal,afU);
+        float afR[3] =
+        {
+            afU[0] - fNdU*afEyeNormal[0],
+            afU[1] - fNdU*afEyeNormal[1],
+            afU[2] - fNdU*afEyeNormal[2] + 1.0f
+        };
+        float fM = 2.0f*(float)sqrt(Dot(afR,afR));
+        if (fM > 0.0f)
+        {
+            afSTQ[0] = afR[0]/fM + 0.5f;
+            afSTQ[1] = afR[1]/fM + 0.5f;
+        }
+        else
+        {
+            afSTQ[0] = 0.5f;
+            afSTQ[1] = 0.5f;
+        }
+    }
+    else if (rkUnit.Texgen == Texture::TG_PROJECTED_TEXTURE
+    &&  rkUnit.HasProjector)
+    {
+        // The projector maps its frustum to [0,1]^2, q is the depth for a
+        // perspective projector.
+        float afDiff[3] =
+        {
+            afWorld[0] - rkUnit.Location[0],
+            afWorld[1] - rkUnit.Location[1],
+            afWorld[2] - rkUnit.Location[2]
+        };
+        float fX = Dot(rkUnit.Axis[0],afDiff);
+        float fY = Dot(rkUnit.Axis[1],afDiff);
+        float fD = Dot(rkUnit.Axis[2],afDiff);
+        const float* afF = rkUnit.Frustum;
+        float fInvRmL = 1.0f/(afF[1] - afF[0]);
+        float fInvTmB = 1.0f/(afF[3] - afF[2]);
+        if (rkUnit.Perspective)
+        {
+            afSTQ[0] = (afF[4]*fX - afF[0]*fD)*fInvRmL;
+            afSTQ[1] = (afF[4]*fY - afF[2]*fD)*fInvTmB;
+            afSTQ[2] = fD;
+        }
+        else
+        {
+            afSTQ[0] = (fX - afF[0])*fInvRmL;
+            afSTQ[1] = (fY - afF[2])*fInvTmB;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::DrawPoint (const ClipVertex& rkV)
+{
+    // a point is clipped by its center
+    const float* afP = rkV.Position;
+    float fW = afP[3];
+    if (fW <= 0.0f || afP[0] < -fW || afP[0] > fW || afP[1] < -fW
+    ||  afP[1] > fW || afP[2] < -fW || afP[2] > fW)
+    {
+        return;
+    }
+
+    // a screen aligned square of the point size
+    float fSize = FloatFromFixed(m_fPointSize);
+    float fDX = fSize/m_fPortWidth*fW;
+    float fDY = fSize/m_fPortHeight*fW;
+    ClipVertex akCorner[4];
+    for (int i = 0; i < 4; i++)
+    {
+        akCorner[i] = rkV;
+        akCorner[i].Position[0] += ((i == 1 || i == 2) ? fDX : -fDX);
+        akCorner[i].Position[1] += (i >= 2 ? fDY : -fDY);
+    }
+    DrawTriangle(akCorner[0],akCorner[1],akCorner[2],false);
+    DrawTriangle(akCorner[0],akCorner[2],akCorner[3],false);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::DrawLine (const ClipVertex& rkV0, const ClipVertex& rkV1)
+{
+    ClipVertex akEnd[2] = { rkV0, rkV1 };
+    if (m_bFlatShade)
+    {
+        // the second vertex provides the color
+        memcpy(akEnd[0].Attribute + ATTR_COLOR,
+            akEnd[1].Attribute + ATTR_COLOR,4*sizeof(float));
+    }
+
+    // clip against the near and far planes to have a screen direction
+    for (int iPlane = 0; iPlane < 2; iPlane++)
+    {
+        float fSign = (iPlane == 0 ? 1.0f : -1.0f);
+        float fD0 = akEnd[0].Position[3] + fSign*akEnd[0].Position[2];
+        float fD1 = akEnd[1].Position[3] + fSign*akEnd[1].Position[2];
+        if (fD0 < 0.0f && fD1 < 0.0f)
+        {
+            return;
+        }
+        if (fD0 < 0.0f)
+        {
+            Interpolate(akEnd[0],akEnd[1],fD0/(fD0 - fD1),akEnd[0]);
+        }
+        else if (fD1 < 0.0f)
+        {
+            Interpolate(akEnd[1],akEnd[0],fD1/(fD1 - fD0),akEnd[1]);
+        }
+    }
+
+    // a quad that extends along the minor axis by the line width
+    float fW0 = akEnd[0].Position[3], fW1 = akEnd[1].Position[3];
+    float fDX = (akEnd[1].Position[0]/fW1 - akEnd[0].Position[0]/fW0)*
+        m_fPortWidth;
+    float fDY = (akEnd[1].Position[1]/fW1 - akEnd[0].Position[1]/fW0)*
+        m_fPortHeight;
+    float fWidth = FloatFromFixed(m_fLineWidth);
+    float fOffsetX = 0.0f, fOffsetY = 0.0f;
+    if (fabs(fDX) >= fabs(fDY))
+    {
+        fOffsetY = fWidth/m_fPortHeight;
+    }
+    else
+    {
+        fOffsetX = fWidth/m_fPortWidth;
+    }
+
+    ClipVertex akCorner[4];
+    for (int i = 0; i < 4; i++)
+    {
+        const ClipVertex& rkEnd = akEnd[i < 2 ? 0 : 1];
+        float fSign = ((i == 0 || i == 3) ? -1.0f : 1.0f);
+        akCorner[i] = rkEnd;
+        akCorner[i].Position[0] += fSign*fOffsetX*rkEnd.Position[3];
+        akCorner[i].Position[1] += fSign*fOffsetY*rkEnd.Position[3];
+    }
+    DrawTriangle(akCorner[0],akCorner[1],akCorner[2],false);
+    DrawTriangle(akCorner[0],akCorner[2],akCorner[3],false);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::DrawTriangle (const ClipVertex& rkV0,
+    const ClipVertex& rkV1, const ClipVertex& rkV2, bool bFill)
+{
+    // Outcodes of the view volume (trivial rejection) and of the clipping
+    // volume.  The clipping volume is larger than the view volume in x and
+    // y, the setup handles the triangles in that guard band.
+    const float fGuard = 4.0f;
+    const ClipVertex* apkV[3] = { &rkV0, &rkV1, &rkV2 };
+    unsigned int uiOutAnd = ~0u, uiClipOr = 0;
+    int i;
+    for (i = 0; i < 3; i++)
+    {
+        const float* afP = apkV[i]->Position;
+        float fW = afP[3];
+        unsigned int uiOut = 0, uiClip = 0;
+        if (afP[2] < -fW) { uiOut |= 1; uiClip |= 1; }
+        if (afP[2] > fW) { uiOut |= 2; uiClip |= 2; }
+        if (afP[0] < -fW) { uiOut |= 4; }
+        if (afP[0] > fW) { uiOut |= 8; }
+        if (afP[1] < -fW) { uiOut |= 16; }
+        if (afP[1] > fW) { uiOut |= 32; }
+        if (afP[0] < -fGuard*fW || afP[0] > fGuard*fW
+        ||  afP[1] < -fGuard*fW || afP[1] > fGuard*fW)
+        {
+            uiClip |= 4;
+        }
+        uiOutAnd &= uiOut;
+        uiClipOr |= uiClip;
+    }
+    if (uiOutAnd)
+    {
+        return;
+    }
+
+    ClipVertex akPolygon[16], akTmp[16];
+    int iQuantity = 3;
+    if (m_bFlatShade || uiClipOr)
+    {
+        for (i = 0; i < 3; i++)
+        {
+            akPolygon[i] = *apkV[i];
+            apkV[i] = &akPolygon[i];
+        }
+        if (m_bFlatShade)
+        {
+            // the last vertex provides the color
+            for (i = 0; i < 2; i++)
+            {
+                memcpy(akPolygon[i].Attribute + ATTR_COLOR,
+                    akPolygon[2].Attribute + ATTR_COLOR,4*sizeof(float));
+            }
+        }
+        if (uiClipOr)
+        {
+            iQuantity = ClipPolygon(3,akPolygon,akTmp);
+        }
+    }
+
+    if (iQuantity == 3)
+    {
+        SetupTriangle(*apkV[0],*apkV[1],*apkV[2],bFill);
+    }
+    else
+    {
+        for (i = 1; i + 1 < iQuantity; i++)
+        {
+            SetupTriangle(akPolygon[0],akPolygon[i],akPolygon[i+1],bFill);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::Interpolate (const ClipVertex& rkV0,
+    const ClipVertex& rkV1, float fT, ClipVertex& rkResult) const
+{
+    int i;
+    for (i = 0; i < 4; i++)
+    {
+        rkResult.Position[i] = rkV0.Position[i] +
+            fT*(rkV1.Position[i] - rkV0.Position[i]);
+    }
+    for (i = 0; i < m_iAttributeQuantity; i++)
+    {
+        rkResult.Attribute[i] = rkV0.Attribute[i] +
+            fT*(rkV1.Attribute[i] - rkV0.Attribute[i]);
+    }
+}
+//----------------------------------------------------------------------------
+int SoftRenderer::ClipPolygon (int iQuantity, ClipVertex* akVertex,
+    ClipVertex* akTmp) const
+{
+    // Sutherland-Hodgman against near, far and the guard band.  A convex
+    // polygon gains at most one vertex per plane.
+    const float fGuard = 4.0f;
+    ClipVertex* akIn = akVertex;
+    ClipVertex* akOut = akTmp;
+
+    for (int iPlane = 0; iPlane < 6 && iQuantity >= 3; iPlane++)
+    {
+        float afDistance[16];
+        bool bAllInside = true;
+        int i;
+        for (i = 0; i < iQuantity; i++)
+        {
+            const float* afP = akIn[i].Position;
+            switch (iPlane)
+            {
+            case 0:  afDistance[i] = afP[3] + afP[2];  break;
+            case 1:  afDistance[i] = afP[3] - afP[2];  break;
+            case 2:  afDistance[i] = fGuard*afP[3] + afP[0];  break;
+            case 3:  afDistance[i] = fGuard*afP[3] - afP[0];  break;
+            case 4:  afDistance[i] = fGuard*afP[3] + afP[1];  break;
+            default: afDistance[i] = fGuard*afP[3] - afP[1];  break;
+            }
+            if (afDistance[i] < 0.0f)
+            {
+                bAllInside = false;
+            }
+        }
+        if (bAllInside)
+        {
+            continue;
+        }
+
+        int iOutQuantity = 0;
+        for (i = 0; i < iQuantity; i++)
+        {
+            int iNext = (i + 1 < iQuantity ? i + 1 : 0);
+            float fD0 = afDistance[i], fD1 = afDistance[iNext];
+            if (fD0 >= 0.0f)
+            {
+                akOut[iOutQuantity++] = akIn[i];
+            }
+            if ((fD0 >= 0.0f) != (fD1 >= 0.0f))
+            {
+                Interpolate(akIn[i],akIn[iNext],fD0/(fD0 - fD1),
+                    akOut[iOutQuantity++]);
+            }
+        }
+
+        ClipVertex* akSwap = akIn;
+        akIn = akOut;
+        akOut = akSwap;
+        iQuantity = iOutQuantity;
+    }
+
+    if (akIn != akVertex)
+    {
+        for (int i = 0; i < iQuantity; i++)
+        {
+            akVertex[i] = akIn[i];
+        }
+    }
+    return (iQuantity >= 3 ? iQuantity : 0);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::SetupTriangle (const ClipVertex& rkV0,
+    const ClipVertex& rkV1, const ClipVertex& rkV2, bool bFill)
+{
+    const ClipVertex* apkV[3] = { &rkV0, &rkV1, &rkV2 };
+    float afZ[3], afInvW[3];
+    int aiX[3], aiY[3];
+    int i;
+
+    // window coordinates, x and y snapped to 28.4 fixed point
+    for (i = 0; i < 3; i++)
+    {
+        const float* afP = apkV[i]->Position;
+        afInvW[i] = 1.0f/afP[3];
+        float fX = m_fPortX + (0.5f + 0.5f*afP[0]*afInvW[i])*m_fPortWidth;
+        float fY = m_fPortY + (0.5f - 0.5f*afP[1]*afInvW[i])*m_fPortHeight;
+        afZ[i] = 0.5f + 0.5f*afP[2]*afInvW[i];
+        aiX[i] = FloorToInt(16.0f*fX + 0.5f);
+        aiY[i] = FloorToInt(16.0f*fY + 0.5f);
+    }
+
+    // Twice the signed area with the rows going down.  The triangles that
+    // are counterclockwise in OpenGL window coordinates have negative area.
+    __int64 iArea =
+        (__int64)(aiX[1] - aiX[0])*(__int64)(aiY[2] - aiY[0]) -
+        (__int64)(aiX[2] - aiX[0])*(__int64)(aiY[1] - aiY[0]);
+    if (iArea == 0)
+    {
+        return;
+    }
+
+    if (bFill && m_bCullEnabled)
+    {
+        bool bCCW = (iArea < 0);
+        bool bFront = (m_iFrontFace == CullState::FT_CCW ? bCCW : !bCCW);
+        if (bFront == (m_iCullFace == CullState::CT_FRONT))
+        {
+            return;
+        }
+    }
+
+    // order the vertices to have positive area
+    int aiOrder[3] = { 0, 1, 2 };
+    if (iArea < 0)
+    {
+        aiOrder[1] = 2;
+        aiOrder[2] = 1;
+    }
+
+    int aiSX[3], aiSY[3];
+    float afSZ[3], afSInvW[3];
+    const ClipVertex* apkSV[3];
+    for (i = 0; i < 3; i++)
+    {
+        aiSX[i] = aiX[aiOrder[i]];
+        aiSY[i] = aiY[aiOrder[i]];
+        afSZ[i] = afZ[aiOrder[i]];
+        afSInvW[i] = afInvW[aiOrder[i]];
+        apkSV[i] = apkV[aiOrder[i]];
+    }
+
+    // the pixels whose centers (16*x+8 in 28.4) can be inside
+    int iXMin = aiSX[0], iXMax = aiSX[0];
+    int iYMin = aiSY[0], iYMax = aiSY[0];
+    for (i = 1; i < 3; i++)
+    {
+        iXMin = (aiSX[i] < iXMin ? aiSX[i] : iXMin);
+        iXMax = (aiSX[i] > iXMax ? aiSX[i] : iXMax);
+        iYMin = (aiSY[i] < iYMin ? aiSY[i] : iYMin);
+        iYMax = (aiSY[i] > iYMax ? aiSY[i] : iYMax);
+    }
+    iXMin = (iXMin + 7) >> 4;
+    iXMax = (iXMax - 8) >> 4;
+    iYMin = (iYMin + 7) >> 4;
+    iYMax = (iYMax - 8) >> 4;
+    iXMin = (iXMin > m_iPortXMin ? iXMin : m_iPortXMin);
+    iXMax = (iXMax < m_iPortXMax ? iXMax : m_iPortXMax);
+    iYMin = (iYMin > m_iPortYMin ? iYMin : m_iPortYMin);
+    iYMax = (iYMax < m_iPortYMax ? iYMax : m_iPortYMax);
+    if (iXMin > iXMax || iYMin > iYMax)
+    {
+        return;
+    }
+
+    int iAttributeQuantity = m_iAttributeQuantity;
+    int iSize = (int)sizeof(Triangle) + 3*iAttributeQuantity*sizeof(float);
+    iSize = (iSize + 7) & ~7;
+    unsigned char* pucRecord = AllocateRecord(iSize);
+    int iOffset = (int)(pucRecord - m_aucArena);
+    Triangle* pkTri = (Triangle*)pucRecord;
+    float* afPlane = (float*)(pkTri + 1);
+
+    pkTri->State = m_iStateIndex;
+    pkTri->XMin = iXMin;
+    pkTri->XMax = iXMax;
+    pkTri->YMin = iYMin;
+    pkTri->YMax = iYMax;
+    pkTri->AttributeQuantity = iAttributeQuantity;
+
+    // Edge functions for the pixel centers.  The edges that are not top or
+    // left edges exclude the pixels on them (top-left fill rule).
+    for (i = 0; i < 3; i++)
+    {
+        int iNext = (i + 1) % 3;
+        int iDX = aiSX[iNext] - aiSX[i];
+        int iDY = aiSY[iNext] - aiSY[i];
+        __int64 iC = (__int64)iDY*aiSX[i] - (__int64)iDX*aiSY[i];
+        iC += 8*(__int64)(iDX - iDY);
+        if (!(iDY < 0 || (iDY == 0 && iDX > 0)))
+        {
+            iC -= 1;
+        }
+        pkTri->A[i] = -16*iDY;
+        pkTri->B[i] = 16*iDX;
+        pkTri->C[i] = iC;
+    }
+
+    // interpolation planes, computed in double precision from the snapped
+    // positions
+    double dX0 = aiSX[0]/16.0, dY0 = aiSY[0]/16.0;
+    double dE1X = aiSX[1]/16.0 - dX0, dE1Y = aiSY[1]/16.0 - dY0;
+    double dE2X = aiSX[2]/16.0 - dX0, dE2Y = aiSY[2]/16.0 - dY0;
+    double dInvDet = 1.0/(dE1X*dE2Y - dE2X*dE1Y);
+
+#define WG_SOFT_PLANE(afOut, dF0, dF1, dF2) \
+    { \
+        double dD1 = (dF1) - (dF0), dD2 = (dF2) - (dF0); \
+        double dDX = (dD1*dE2Y - dD2*dE1Y)*dInvDet; \
+        double dDY = (dD2*dE1X - dD1*dE2X)*dInvDet; \
+        (afOut)[0] = (float)dDX; \
+        (afOut)[1] = (float)dDY; \
+        (afOut)[2] = (float)((dF0) - dDX*dX0 - dDY*dY0); \
+    }
+
+    WG_SOFT_PLANE(pkTri->Z,afSZ[0],afSZ[1],afSZ[2]);
+    WG_SOFT_PLANE(pkTri->InvW,afSInvW[0],afSInvW[1],afSInvW[2]);
+    for (i = 0; i < iAttributeQuantity; i++)
+    {
+        WG_SOFT_PLANE(&afPlane[3*i],
+            apkSV[0]->Attribute[i]*afSInvW[0],
+            apkSV[1]->Attribute[i]*afSInvW[1],
+            apkSV[2]->Attribute[i]*afSInvW[2]);
+    }
+
+#undef WG_SOFT_PLANE
+
+    if (bFill && m_bOffsetEnabled)
+    {
+        float fDZDX = (float)fabs(pkTri->Z[0]);
+        float fDZDY = (float)fabs(pkTri->Z[1]);
+        pkTri->Z[2] += m_fOffsetScale*(fDZDX > fDZDY ? fDZDX : fDZDY) +
+            m_fOffsetBias*m_fDepthResolution;
+    }
+
+    // bin the triangle into the tiles that an edge does not exclude
+    int iTXMin = iXMin/TILE_SIZE, iTXMax = iXMax/TILE_SIZE;
+    int iTYMin = iYMin/TILE_SIZE, iTYMax = iYMax/TILE_SIZE;
+    for (int iTY = iTYMin; iTY <= iTYMax; iTY++)
+    {
+        int iPY0 = iTY*TILE_SIZE, iPY1 = iPY0 + TILE_SIZE - 1;
+        iPY0 = (iPY0 > iYMin ? iPY0 : iYMin);
+        iPY1 = (iPY1 < iYMax ? iPY1 : iYMax);
+        for (int iTX = iTXMin; iTX <= iTXMax; iTX++)
+        {
+            int iPX0 = iTX*TILE_SIZE, iPX1 = iPX0 + TILE_SIZE - 1;
+            iPX0 = (iPX0 > iXMin ? iPX0 : iXMin);
+            iPX1 = (iPX1 < iXMax ? iPX1 : iXMax);
+
+            bool bInside = true;
+            for (i = 0; i < 3 && bInside; i++)
+            {
+                // the corner where the edge function is largest
+                int iCX = (pkTri->A[i] > 0 ? iPX1 : iPX0);
+                int iCY = (pkTri->B[i] > 0 ? iPY1 : iPY0);
+                __int64 iE = pkTri->C[i] + (__int64)pkTri->A[i]*iCX +
+                    (__int64)pkTri->B[i]*iCY;
+                bInside = (iE >= 0);
+            }
+
+            if (bInside)
+            {
+                AppendToBin(iTY*m_iTileColumns + iTX,iOffset);
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+unsigned char* SoftRenderer::AllocateRecord (int iSize)
+{
+    if (m_iArenaQuantity + iSize > m_iArenaCapacity)
+    {
+        int iNewCapacity = 2*m_iArenaCapacity;
+        while (m_iArenaQuantity + iSize > iNewCapacity)
+        {
+            iNewCapacity *= 2;
+        }
+        unsigned char* aucNewArena = WG_NEW unsigned char[iNewCapacity];
+        memcpy(aucNewArena,m_aucArena,m_iArenaQuantity);
+        WG_DELETE[] m_aucArena;
+        m_aucArena = aucNewArena;
+        m_iArenaCapacity = iNewCapacity;
+    }
+
+    unsigned char* pucRecord = m_aucArena + m_iArenaQuantity;
+    m_iArenaQuantity += iSize;
+    return pucRecord;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::AppendToBin (int iTile, int iOffset)
+{
+    Bin& rkBin = m_akBin[iTile];
+    if (rkBin.Quantity == rkBin.MaxQuantity)
+    {
+        int iNewMaxQuantity = (rkBin.MaxQuantity > 0 ?
+            2*rkBin.MaxQuantity : 256);
+        int* aiNewOffset = WG_NEW int[iNewMaxQuantity];
+        if (rkBin.Quantity > 0)
+        {
+            memcpy(aiNewOffset,rkBin.Offset,rkBin.Quantity*sizeof(int));
+        }
+        WG_DELETE[] rkBin.Offset;
+        rkBin.Offset = aiNewOffset;
+        rkBin.MaxQuantity = iNewMaxQuantity;
+    }
+    rkBin.Offset[rkBin.Quantity++] = iOffset;
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::SetConstantTransformM (int iOption, fixed* afData)
+{
+    if (iOption == ShaderConstant::SCO_INVERSE
+    ||  iOption == ShaderConstant::SCO_INVERSE_TRANSPOSE)
+    {
+        // the inverse is cached along with the world matrix
+        Matrix4x kInvM(m_pkGeometry->GetWorldInverseHomogeneous(),false);
+        GetTransform(kInvM,(iOption == ShaderConstant::SCO_INVERSE ?
+            ShaderConstant::SCO_MATRIX : ShaderConstant::SCO_TRANSPOSE),
+            afData);
+        return;
+    }
+
+    Matrix4x kM(m_pkGeometry->GetWorldHomogeneous(),false);
+    GetTransform(kM,iOption,afData);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::SetConstantTransformP (int iOption, fixed* afData)
+{
+    float afProjection[16];
+    GetProjectionMatrix(afProjection);
+    Matrix4x kP = MakeMatrix4(afProjection);
+    GetTransform(kP,iOption,afData);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::SetConstantTransformMV (int iOption, fixed* afData)
+{
+    // The model-view matrix has vectors in the order (R,U,-D), as in
+    // OpenGL.  Wild Magic requires (R,U,D), so the third row changes sign.
+    float afModelView[16];
+    GetModelViewMatrix(afModelView);
+    for (int i = 8; i < 12; i++)
+    {
+        afModelView[i] = -afModelView[i];
+    }
+    Matrix4x kMV = MakeMatrix4(afModelView);
+    GetTransform(kMV,iOption,afData);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::SetConstantTransformMVP (int iOption, fixed* afData)
+{
+    // The projection matrix has the sign change of the model-view matrix
+    // built into it, so the product needs none.
+    float afProjection[16], afModelView[16], afProduct[16];
+    GetProjectionMatrix(afProjection);
+    GetModelViewMatrix(afModelView);
+    Multiply(afProjection,afModelView,afProduct);
+    Matrix4x kPMV = MakeMatrix4(afProduct);
+    GetTransform(kPMV,iOption,afData);
+}
+//----------------------------------------------------------------------------
+void SoftRenderer::GetTransform (Matrix4x& rkMat, int iOption,
+    fixed* afData)
+{
+    // The matrices are those of OpenGL, see OmapGLRenderer::GetTransform.
+    switch (iOption)
+    {
+    case ShaderConstant::SCO_MATRIX:
+        break;
+    case ShaderConstant::SCO_TRANSPOSE:
+        rkMat = rkMat.Transpose();
+        break;
+    case ShaderConstant::SCO_INVERSE:
+        rkMat = rkMat.Inverse();
+        break;
+    case ShaderConstant::SCO_INVERSE_TRANSPOSE:
+        rkMat = rkMat.Inverse().Transpose();
+        break;
+    default:
+        assert(false);
+        break;
+    }
+
+    const fixed* afMat = (const fixed*)rkMat;
+    for (int i = 0; i < 16; i++)
+    {
+        afData[i] = afMat[i];
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,408 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftRenderer.h                   //
+//                                                       //
+//  - Interface for SoftRenderer class                   //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+
+#ifndef __WG_SOFTRENDERER_H__
+#define __WG_SOFTRENDERER_H__
+
+#include "WgSoftRendererLIB.h"
+#include "WgRenderer.h"
+#include "WgTaskPool.h"
+#include "WgLight.h"
+#include "WgTexture.h"
+#include "WgGeometry.h"
+
+
+namespace WGSoft3D
+{
+
+class SoftTexture;
+
+// A renderer that needs no graphics hardware.  It draws into frame buffers
+// in memory that the application copies to the display (or into a file) in
+// DisplayBackBuffer or after it.
+//
+// The vertices are transformed, lit and clipped on the calling thread when
+// a Geometry is drawn.  The triangles that survive are set up (edge
+// functions and interpolation planes) and binned into tiles of
+// TILE_SIZE x TILE_SIZE pixels.  Nothing is rasterized until the frame is
+// flushed, then every tile that has triangles is rasterized by one task of
+// a TaskPool.  A tile is owned by one task, so the pixels need no locks and
+// every pixel sees its triangles in the order they were drawn.  The frame
+// is flushed by DisplayBackBuffer, by the clears when triangles are
+// pending, by ReleaseTexture and by Resize.
+//
+// The per-fragment operations follow OpenGL ES 1.1: texture environment
+// (including AM_COMBINE), fog, alpha test, stencil test, depth test and
+// blending.  The texture coordinates of Texture::TG_ENVIRONMENT_MAP (sphere
+// map) and Texture::TG_PROJECTED_TEXTURE are generated for texture units
+// without a UV array.  Line stipple, dithering and the texture correction
+// hint are ignored; the texture coordinates are always perspective correct.
+
+class WG3D_RENDERER_ITEM SoftRenderer : public Renderer
+{
+public:
+    // Construction and destruction.  The pool of the tile tasks has
+    // iThreadQuantity threads, zero selects the number of processors.
+    SoftRenderer (const BufferParams& rkBufferParams, int iWidth,
+        int iHeight, int iThreadQuantity = 0);
+    virtual ~SoftRenderer ();
+
+    virtual void Activate ();
+    virtual void Resize (int iWidth, int iHeight);
+
+    // full window buffer operations
+    virtual void ClearBackBuffer ();
+    virtual void ClearZBuffer ();
+    virtual void ClearStencilBuffer ();
+    virtual void ClearBuffers ();
+    virtual void DisplayBackBuffer ();
+
+    // clear the buffer in the specified subwindow
+    virtual void ClearBackBuffer (int iXPos, int iYPos, int iWidth,
+        int iHeight);
+    virtual void ClearZBuffer (int iXPos, int iYPos, int iWidth,
+        int iHeight);
+    virtual void ClearStencilBuffer (int iXPos, int iYPos, int iWidth,
+        int iHeight);
+    virtual void ClearBuffers (int iXPos, int iYPos, int iWidth,
+        int iHeight);
+
+    // The frame buffers, GetWidth()*GetHeight() pixels with the rows from
+    // top to bottom.  A color is RGBA8888 with R in the lowest byte, a depth
+    // is in [0,1].  The depth buffer is null for BP_DEPTH_NONE, the stencil
+    // buffer for BP_STENCIL_NONE.  The buffers hold the complete frame after
+    // DisplayBackBuffer.
+    const unsigned int* GetColorBuffer () const;
+    const float* GetDepthBuffer () const;
+    const unsigned char* GetStencilBuffer () const;
+
+    int GetThreadQuantity () const;
+
+    // management of texture resources
+    virtual void ReleaseTexture (Texture* pkTexture);
+
+    // The arrays are read from system memory, there is nothing to release.
+    virtual void ReleaseArray (CachedColorRGBAArray* pkArray);
+    virtual void ReleaseArray (CachedColorRGBArray* pkArray);
+    virtual void ReleaseArray (CachedShortArray* pkArray);
+    virtual void ReleaseArray (CachedVector2xArray* pkArray);
+    virtual void ReleaseArray (CachedVector3xArray* pkArray);
+
+    enum
+    {
+        TILE_SIZE = 64,
+        MAX_TEXTURES = 4,
+        MAX_LIGHTS = 8
+    };
+
+protected:
+    // camera updates
+    virtual void OnFrustumChange ();
+    virtual void OnViewPortChange ();
+    virtual void OnFrameChange ();
+
+    // global render state management
+    virtual void SetAlphaState (AlphaState* pkState);
+    virtual void SetCullState (CullState* pkState);
+    virtual void SetDitherState (DitherState* pkState);
+    virtual void SetFogState (FogState* pkState);
+    virtual void SetMaterialState (MaterialState* pkState);
+    virtual void SetPolygonOffsetState (PolygonOffsetState* pkState);
+    virtual void SetShadeState (ShadeState* pkState);
+    virtual void SetZBufferState (ZBufferState* pkState);
+    virtual void SetStencilState (StencilState* pkState);
+
+    // light management
+    virtual void EnableLighting (int eEnable = EL_ALL);
+    virtual void DisableLighting ();
+    virtual void EnableLight (int eEnable, int i, const Light* pkLight);
+    virtual void DisableLight (int i, const Light* pkLight);
+
+    // texture management
+    virtual void EnableTexture (int iUnit, int i, Effect* pkEffect);
+    virtual void DisableTexture (int iUnit, int i, Effect* pkEffect);
+    virtual void SetActiveTextureUnit (int iUnit);
+
+    // transformations
+    virtual void SetWorldTransformation ();
+    virtual void RestoreWorldTransformation ();
+    virtual void SetScreenTransformation ();
+    virtual void RestoreScreenTransformation ();
+
+    // array management
+    virtual void EnableVertices ();
+    virtual void DisableVertices ();
+    virtual void EnableNormals ();
+    virtual void DisableNormals ();
+    virtual void EnableColorRGBAs ();
+    virtual void DisableColorRGBAs ();
+    virtual void EnableColorRGBs ();
+    virtual void DisableColorRGBs ();
+    virtual void EnableUVs (int i, Effect* pkEffect);
+    virtual void DisableUVs (Vector2xArray* pkUVs);
+    virtual void DrawElements ();
+
+    // shader management
+    virtual void SetConstantTransformM (int iOption, fixed* afData);
+    virtual void SetConstantTransformP (int iOption, fixed* afData);
+    virtual void SetConstantTransformMV (int iOption, fixed* afData);
+    virtual void SetConstantTransformMVP (int iOption, fixed* afData);
+    void GetTransform (Matrix4x& rkMat, int iOption, fixed* afData);
+
+    // effects
+    virtual void DrawBumpMap ();
+    virtual void DrawEnvironmentMap ();
+    virtual void DrawGlossMap ();
+    virtual void DrawPlanarShadow ();
+    virtual void DrawProjectedTexture ();
+
+private:
+    enum
+    {
+        // The attributes of a vertex:  the color (RGBA), the fog factor or
+        // the eye distance for per-pixel fog, and (s,t,q) of each texture
+        // unit.
+        ATTR_COLOR = 0,
+        ATTR_FOG = 4,
+        ATTR_TEXTURE = 5,
+        MAX_ATTRIBUTES = ATTR_TEXTURE + 3*MAX_TEXTURES,
+
+        // The pending triangles are flushed when their records exceed this
+        // size (bytes).
+        ARENA_CAPACITY = 32*1024*1024
+    };
+
+    // a vertex in clip coordinates
+    class ClipVertex
+    {
+    public:
+        float Position[4];
+        float Attribute[MAX_ATTRIBUTES];
+    };
+
+    // a light in world coordinates, the colors include the intensity
+    class LightInfo
+    {
+    public:
+        bool Enabled;
+        int Type;
+        float Ambient[3], Diffuse[3], Specular[3];
+        float Position[3];   // the direction to the light for LT_DIRECTIONAL
+        float Direction[3];  // the spot direction
+        float SpotCosine, SpotExponent;
+        float Constant, Linear, Quadratic;
+    };
+
+    // The vertex inputs of a texture unit.  The frame (R,U,D) and the
+    // frustum (left, right, bottom, top, near) of the projector are used
+    // for Texture::TG_PROJECTED_TEXTURE.
+    class UnitInfo
+    {
+    public:
+        const Vector2x* UVs;  // null to generate the coordinates
+        int Texgen;
+        bool HasProjector, Perspective;
+        float Location[3], Axis[3][3], Frustum[5];
+    };
+
+    // the per-fragment state of a texture unit
+    class TextureUnit
+    {
+    public:
+        const SoftTexture* Sampler;  // null if the unit is disabled
+        int Apply;
+        bool HasAlpha, Projected;
+        float Color[4];
+        int CombineFunc[2];       // RGB, alpha
+        int CombineSrc[2][3];
+        int CombineOp[2][3];
+        float CombineScale[2];
+    };
+
+    // The state of the per-fragment operations.  It is kept with the
+    // pending triangles, compared with memcmp, so it must stay a class
+    // without pointers to data that changes and must be cleared bytewise.
+    class FragmentState
+    {
+    public:
+        int UnitQuantity;
+        TextureUnit Unit[MAX_TEXTURES];
+
+        bool FogEnabled, FogPerPixel;
+        int FogFunction;
+        float FogStart, FogEnd, FogDensity;
+        float FogColor[3];
+
+        bool AlphaTestEnabled;
+        int AlphaTest;
+        float AlphaReference;
+
+        bool StencilEnabled;
+        int StencilCompare;
+        unsigned int StencilReference, StencilMask, StencilWriteMask;
+        int StencilOnFail, StencilOnZFail, StencilOnZPass;
+
+        bool DepthEnabled, DepthWritable;
+        int DepthCompare;
+
+        bool BlendEnabled;
+        int SrcBlend, DstBlend;
+    };
+
+    // A triangle that is set up for rasterization.  The pixel (x,y) is
+    // inside if every edge function C[i] + A[i]*x + B[i]*y is nonnegative.
+    // The interpolation planes follow the record, three floats (dx,dy,c)
+    // per attribute, with the value c + dx*(x+1/2) + dy*(y+1/2) at the
+    // pixel center.  The attributes are divided by w, the plane of 1/w
+    // recovers them.
+    class Triangle
+    {
+    public:
+        __int64 C[3];
+        int A[3], B[3];
+        int State;
+        int XMin, YMin, XMax, YMax;
+        int AttributeQuantity;
+        float Z[3], InvW[3];
+    };
+
+    // the offsets of the triangle records that touch a tile
+    class Bin
+    {
+    public:
+        int Quantity, MaxQuantity;
+        int* Offset;
+    };
+
+    class TileTask : public Task
+    {
+    public:
+        virtual void Execute (TaskPool& rkPool, int iWorker);
+
+        SoftRenderer* Owner;
+        int Tile;
+    };
+
+    // frame buffers and tiles
+    void CreateBuffers ();
+    void DestroyBuffers ();
+    void ClearRect (int iXPos, int iYPos, int iWidth, int iHeight,
+        bool bColor, bool bDepth, bool bStencil);
+    void Flush ();
+
+    // vertex processing
+    void GetWorldMatrix (float afMatrix[16]) const;
+    void GetModelViewMatrix (float afMatrix[16]) const;
+    void GetProjectionMatrix (float afMatrix[16]) const;
+    void TransformVertices (int iQuantity);
+    void LightVertex (const float afPosition[3], const float afNormal[3],
+        float afColor[4]) const;
+    void GenerateCoordinates (int iUnit, const float afWorld[3],
+        const float afEye[3], const float afEyeNormal[3], float* afSTQ)
+        const;
+
+    // primitive assembly, clipping and setup
+    int GetStateIndex ();
+    void DrawTriangle (const ClipVertex& rkV0, const ClipVertex& rkV1,
+        const ClipVertex& rkV2, bool bFill);
+    void DrawPoint (const ClipVertex& rkV);
+    void DrawLine (const ClipVertex& rkV0, const ClipVertex& rkV1);
+    int ClipPolygon (int iQuantity, ClipVertex* akVertex,
+        ClipVertex* akTmp) const;
+    void Interpolate (const ClipVertex& rkV0, const ClipVertex& rkV1,
+        float fT, ClipVertex& rkResult) const;
+    void SetupTriangle (const ClipVertex& rkV0, const ClipVertex& rkV1,
+        const ClipVertex& rkV2, bool bFill);
+    unsigned char* AllocateRecord (int iSize);
+    void AppendToBin (int iTile, int iOffset);
+
+    // fragment processing
+    static float GetFogFactor (const FragmentState& rkState,
+        float fDistance);
+    static void ApplyTexture (const TextureUnit& rkUnit,
+        const float afTexel[4], const float afPrimary[4], float afColor[4]);
+    static void Combine (const TextureUnit& rkUnit, const float afTexel[4],
+        const float afPrimary[4], float afColor[4]);
+    static bool TestStencilDepth (const FragmentState& rkState, float fZ,
+        unsigned char* pucStencil, float* pfDepth);
+
+    // frame buffers, rows from top to bottom
+    unsigned int* m_auiColor;
+    float* m_afDepth;
+    unsigned char* m_aucStencil;
+
+    // tiles and their tasks
+    int m_iTileColumns, m_iTileRows;
+    Bin* m_akBin;
+    TileTask* m_akTileTask;
+    Task** m_apkTask;
+    TaskPool* m_pkPool;
+
+    // the pending triangles and their fragment states
+    unsigned char* m_aucArena;
+    int m_iArenaQuantity, m_iArenaCapacity;
+    FragmentState* m_akState;
+    int m_iStateQuantity, m_iMaxStateQuantity;
+    int m_iStateIndex;
+
+    // the current state of the per-fragment operations
+    FragmentState m_kFragment;
+
+    // The camera (view matrix rows R, U, -D) and the projection, stored in
+    // row-major order.  The shadow matrix is applied after the world
+    // matrix by the planar shadows.
+    float m_afView[16], m_afProjection[16], m_afShadow[16];
+    float m_afViewerDirection[3];
+    bool m_bScreenTransform, m_bShadowTransform;
+
+    // viewport in pixels, rows from the top
+    float m_fPortX, m_fPortY, m_fPortWidth, m_fPortHeight;
+    int m_iPortXMin, m_iPortYMin, m_iPortXMax, m_iPortYMax;
+
+    // the vertex arrays of the current draw
+    const Vector3x* m_akVertex;
+    const Vector3x* m_akNormal;
+    const ColorRGBA* m_akColorRGBA;
+    const ColorRGB* m_akColorRGB;
+    float m_afCurrentColor[4];
+
+    // lighting
+    bool m_bLighting;
+    LightInfo m_akLight[MAX_LIGHTS];
+    float m_afEmissive[4], m_afAmbient[4], m_afDiffuse[4], m_afSpecular[4];
+    float m_fShininess;
+
+    // texture units and the textures that have a SoftTexture
+    int m_iActiveUnit;
+    UnitInfo m_akUnit[MAX_TEXTURES];
+    TArray<Texture*> m_kTexture;
+
+    // triangle setup state
+    bool m_bCullEnabled;
+    int m_iFrontFace, m_iCullFace;
+    bool m_bFlatShade;
+    bool m_bOffsetEnabled;
+    float m_fOffsetScale, m_fOffsetBias, m_fDepthResolution;
+
+    // the vertices of the current draw in clip coordinates
+    ClipVertex* m_akClipVertex;
+    int m_iMaxClipVertex;
+    int m_iAttributeQuantity;
+
+// internal use
+public:
+    // rasterize the pending triangles of a tile (called by the tasks)
+    void RasterizeTile (int iTile);
+};
+
+#include "WgSoftRenderer.inl"
+
+}
+
+#endif
@@ -0,0 +1,29 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftRenderer.inl                 //
+//                                                       //
+//  - Inlines for SoftRenderer class                     //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+inline const unsigned int* SoftRenderer::GetColorBuffer () const
+{
+    return m_auiColor;
+}
+//----------------------------------------------------------------------------
+inline const float* SoftRenderer::GetDepthBuffer () const
+{
+    return m_afDepth;
+}
+//----------------------------------------------------------------------------
+inline const unsigned char* SoftRenderer::GetStencilBuffer () const
+{
+    return m_aucStencil;
+}
+//----------------------------------------------------------------------------
+inline int SoftRenderer::GetThreadQuantity () const
+{
+    return m_pkPool->GetThreadQuantity();
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,18 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftShadeState.cpp               //
+//                                                       //
+//  - Implementation for Soft Shade State class          //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgSoftRendererPCH.h"
+#include "WgSoftRenderer.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+void SoftRenderer::SetShadeState (ShadeState* pkState)
+{
+    m_bFlatShade = (pkState->Shade == ShadeState::SM_FLAT);
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,28 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftStencilState.cpp             //
+//                                                       //
+//  - Implementation for Soft Stencil State class        //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgSoftRendererPCH.h"
+#include "WgSoftRenderer.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+void SoftRenderer::SetStencilState (StencilState* pkState)
+{
+    m_kFragment.StencilEnabled = pkState->Enabled;
+    if (pkState->Enabled)
+    {
+        m_kFragment.StencilCompare = pkState->Compare;
+        m_kFragment.StencilReference = pkState->Reference;
+        m_kFragment.StencilMask = pkState->Mask;
+        m_kFragment.StencilOnFail = pkState->OnFail;
+        m_kFragment.StencilOnZFail = pkState->OnZFail;
+        m_kFragment.StencilOnZPass = pkState->OnZPass;
+    }
+    m_kFragment.StencilWriteMask = pkState->WriteMask;
+}
+//----------------------------------------------------------------------------
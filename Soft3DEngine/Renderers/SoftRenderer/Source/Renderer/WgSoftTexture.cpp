@@ -0,0 +1,297 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftTexture.cpp                  //
+//                                                       //
+//  - Implementation for Soft Texture class              //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgSoftRendererPCH.h"
+#include "WgSoftTexture.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+static inline int FloorToInt (float fValue)
+{
+    int iValue = (int)fValue;
+    return (fValue < (float)iValue ? iValue-1 : iValue);
+}
+//----------------------------------------------------------------------------
+static inline unsigned short GetShort (const unsigned char* aucData)
+{
+    // the packed formats are stored as native shorts, as OpenGL expects
+    unsigned short usValue;
+    memcpy(&usValue,aucData,sizeof(unsigned short));
+    return usValue;
+}
+//----------------------------------------------------------------------------
+static inline unsigned int MakeTexel (unsigned int uiR, unsigned int uiG,
+    unsigned int uiB, unsigned int uiA)
+{
+    return uiR | (uiG << 8) | (uiB << 16) | (uiA << 24);
+}
+//----------------------------------------------------------------------------
+SoftTexture::SoftTexture (const Texture* pkTexture)
+{
+    m_bRepeatU = (pkTexture->CoordU == Texture::WM_REPEAT);
+    m_bRepeatV = (pkTexture->CoordV == Texture::WM_REPEAT);
+    m_bMagLinear = (pkTexture->Filter == Texture::FM_LINEAR);
+    m_bMinLinear = (pkTexture->Mipmap == Texture::MM_LINEAR
+        || pkTexture->Mipmap == Texture::MM_LINEAR_NEAREST
+        || pkTexture->Mipmap == Texture::MM_LINEAR_LINEAR);
+    m_bMipmap = (pkTexture->Mipmap != Texture::MM_NEAREST
+        && pkTexture->Mipmap != Texture::MM_LINEAR);
+    m_bMipLinear = (pkTexture->Mipmap == Texture::MM_NEAREST_LINEAR
+        || pkTexture->Mipmap == Texture::MM_LINEAR_LINEAR);
+
+    // The image keeps its data, unlike with the OpenGL renderers, so that
+    // the texture can be converted again after Texture::Changed.
+    const Image* pkImage = pkTexture->GetImage();
+    if (pkImage && pkImage->GetData()
+    &&  pkImage->GetWidth() > 0 && pkImage->GetHeight() > 0)
+    {
+        int iWidth = pkImage->GetWidth();
+        int iHeight = pkImage->GetHeight();
+        m_iLevelQuantity = 1;
+        if (m_bMipmap)
+        {
+            for (int iSize = (iWidth > iHeight ? iWidth : iHeight);
+                iSize > 1; iSize >>= 1)
+            {
+                m_iLevelQuantity++;
+            }
+        }
+
+        m_akLevel = WG_NEW Level[m_iLevelQuantity];
+        m_akLevel[0].Width = iWidth;
+        m_akLevel[0].Height = iHeight;
+        m_akLevel[0].Texel = WG_NEW unsigned int[iWidth*iHeight];
+        Convert(pkImage,m_akLevel[0].Texel);
+        m_bHasAlpha = (pkImage->GetFormat() != Image::IT_RGB888
+            && pkImage->GetFormat() != Image::IT_RGB565);
+        BuildMipmaps();
+    }
+    else
+    {
+        m_iLevelQuantity = 1;
+        m_akLevel = WG_NEW Level[1];
+        m_akLevel[0].Width = 1;
+        m_akLevel[0].Height = 1;
+        m_akLevel[0].Texel = WG_NEW unsigned int[1];
+        m_akLevel[0].Texel[0] = 0xFFFFFFFF;
+        m_bHasAlpha = true;
+        m_bMipmap = false;
+    }
+}
+//----------------------------------------------------------------------------
+SoftTexture::~SoftTexture ()
+{
+    for (int i = 0; i < m_iLevelQuantity; i++)
+    {
+        WG_DELETE[] m_akLevel[i].Texel;
+    }
+    WG_DELETE[] m_akLevel;
+}
+//----------------------------------------------------------------------------
+void SoftTexture::Convert (const Image* pkImage, unsigned int* auiTexel)
+{
+    const unsigned char* aucData = pkImage->GetData();
+    int iQuantity = pkImage->GetWidth()*pkImage->GetHeight();
+    unsigned int uiR, uiG, uiB, uiA;
+    unsigned short usValue;
+    int i;
+
+    switch (pkImage->GetFormat())
+    {
+    case Image::IT_RGBA4444:
+        for (i = 0; i < iQuantity; i++, aucData += 2)
+        {
+            usValue = GetShort(aucData);
+            uiR = (usValue >> 12) & 0x0F;
+            uiG = (usValue >> 8) & 0x0F;
+            uiB = (usValue >> 4) & 0x0F;
+            uiA = usValue & 0x0F;
+            auiTexel[i] = MakeTexel(uiR*17,uiG*17,uiB*17,uiA*17);
+        }
+        break;
+    case Image::IT_RGB888:
+        for (i = 0; i < iQuantity; i++, aucData += 3)
+        {
+            auiTexel[i] = MakeTexel(aucData[0],aucData[1],aucData[2],255);
+        }
+        break;
+    case Image::IT_RGBA5551:
+        for (i = 0; i < iQuantity; i++, aucData += 2)
+        {
+            usValue = GetShort(aucData);
+            uiR = (usValue >> 11) & 0x1F;
+            uiG = (usValue >> 6) & 0x1F;
+            uiB = (usValue >> 1) & 0x1F;
+            uiA = (usValue & 1 ? 255 : 0);
+            auiTexel[i] = MakeTexel((uiR << 3) | (uiR >> 2),
+                (uiG << 3) | (uiG >> 2),(uiB << 3) | (uiB >> 2),uiA);
+        }
+        break;
+    case Image::IT_RGBA8888:
+        for (i = 0; i < iQuantity; i++, aucData += 4)
+        {
+            auiTexel[i] = MakeTexel(aucData[0],aucData[1],aucData[2],
+                aucData[3]);
+        }
+        break;
+    case Image::IT_RGB565:
+        for (i = 0; i < iQuantity; i++, aucData += 2)
+        {
+            usValue = GetShort(aucData);
+            uiR = (usValue >> 11) & 0x1F;
+            uiG = (usValue >> 5) & 0x3F;
+            uiB = usValue & 0x1F;
+            auiTexel[i] = MakeTexel((uiR << 3) | (uiR >> 2),
+                (uiG << 2) | (uiG >> 4),(uiB << 3) | (uiB >> 2),255);
+        }
+        break;
+    default:  // Image::IT_QUANTITY
+        assert(false);
+        memset(auiTexel,0xFF,iQuantity*sizeof(unsigned int));
+        break;
+    }
+}
+//----------------------------------------------------------------------------
+void SoftTexture::BuildMipmaps ()
+{
+    // box filter, the last row and column of odd sizes are repeated
+    for (int iLevel = 1; iLevel < m_iLevelQuantity; iLevel++)
+    {
+        const Level& rkSrc = m_akLevel[iLevel-1];
+        Level& rkDst = m_akLevel[iLevel];
+        rkDst.Width = (rkSrc.Width > 1 ? rkSrc.Width/2 : 1);
+        rkDst.Height = (rkSrc.Height > 1 ? rkSrc.Height/2 : 1);
+        rkDst.Texel = WG_NEW unsigned int[rkDst.Width*rkDst.Height];
+
+        for (int iY = 0; iY < rkDst.Height; iY++)
+        {
+            int iY0 = 2*iY;
+            int iY1 = (iY0+1 < rkSrc.Height ? iY0+1 : iY0);
+            for (int iX = 0; iX < rkDst.Width; iX++)
+            {
+                int iX0 = 2*iX;
+                int iX1 = (iX0+1 < rkSrc.Width ? iX0+1 : iX0);
+                unsigned int auiT[4] =
+                {
+                    rkSrc.Texel[iY0*rkSrc.Width+iX0],
+                    rkSrc.Texel[iY0*rkSrc.Width+iX1],
+                    rkSrc.Texel[iY1*rkSrc.Width+iX0],
+                    rkSrc.Texel[iY1*rkSrc.Width+iX1]
+                };
+
+                unsigned int uiTexel = 0;
+                for (int iShift = 0; iShift < 32; iShift += 8)
+                {
+                    unsigned int uiSum = ((auiT[0] >> iShift) & 0xFF)
+                        + ((auiT[1] >> iShift) & 0xFF)
+                        + ((auiT[2] >> iShift) & 0xFF)
+                        + ((auiT[3] >> iShift) & 0xFF);
+                    uiTexel |= ((uiSum + 2) >> 2) << iShift;
+                }
+                rkDst.Texel[iY*rkDst.Width+iX] = uiTexel;
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void SoftTexture::Sample (float fU, float fV, float fLod, float afColor[4])
+    const
+{
+    if (fLod <= 0.0f || !m_bMipmap)
+    {
+        SampleLevel(0,(fLod <= 0.0f ? m_bMagLinear : m_bMinLinear),fU,fV,
+            afColor);
+        return;
+    }
+
+    int iLast = m_iLevelQuantity - 1;
+    if (fLod >= (float)iLast)
+    {
+        SampleLevel(iLast,m_bMinLinear,fU,fV,afColor);
+        return;
+    }
+
+    if (!m_bMipLinear)
+    {
+        SampleLevel((int)(fLod+0.5f),m_bMinLinear,fU,fV,afColor);
+        return;
+    }
+
+    int iLevel = (int)fLod;
+    float fT = fLod - (float)iLevel;
+    float afNext[4];
+    SampleLevel(iLevel,m_bMinLinear,fU,fV,afColor);
+    SampleLevel(iLevel+1,m_bMinLinear,fU,fV,afNext);
+    for (int i = 0; i < 4; i++)
+    {
+        afColor[i] += fT*(afNext[i] - afColor[i]);
+    }
+}
+//----------------------------------------------------------------------------
+void SoftTexture::SampleLevel (int iLevel, bool bLinear, float fU, float fV,
+    float afColor[4]) const
+{
+    const float fInv255 = 1.0f/255.0f;
+    const Level& rkLevel = m_akLevel[iLevel];
+
+    // Keep the coordinates in a range where the texel indices cannot
+    // overflow.  Repeating coordinates lose only their integer part.
+    if (m_bRepeatU)
+    {
+        fU -= (float)FloorToInt(fU);
+    }
+    else
+    {
+        fU = (fU < -1.0f ? -1.0f : (fU > 2.0f ? 2.0f : fU));
+    }
+    if (m_bRepeatV)
+    {
+        fV -= (float)FloorToInt(fV);
+    }
+    else
+    {
+        fV = (fV < -1.0f ? -1.0f : (fV > 2.0f ? 2.0f : fV));
+    }
+
+    float fX = fU*(float)rkLevel.Width;
+    float fY = fV*(float)rkLevel.Height;
+
+    if (!bLinear)
+    {
+        unsigned int uiTexel = GetTexel(rkLevel,FloorToInt(fX),
+            FloorToInt(fY));
+        afColor[0] = (float)(uiTexel & 0xFF)*fInv255;
+        afColor[1] = (float)((uiTexel >> 8) & 0xFF)*fInv255;
+        afColor[2] = (float)((uiTexel >> 16) & 0xFF)*fInv255;
+        afColor[3] = (float)(uiTexel >> 24)*fInv255;
+        return;
+    }
+
+    // bilinear, the weights have 8 bits
+    fX -= 0.5f;
+    fY -= 0.5f;
+    int iX = FloorToInt(fX);
+    int iY = FloorToInt(fY);
+    unsigned int uiFX = (unsigned int)((fX - (float)iX)*256.0f);
+    unsigned int uiFY = (unsigned int)((fY - (float)iY)*256.0f);
+    unsigned int uiT00 = GetTexel(rkLevel,iX,iY);
+    unsigned int uiT10 = GetTexel(rkLevel,iX+1,iY);
+    unsigned int uiT01 = GetTexel(rkLevel,iX,iY+1);
+    unsigned int uiT11 = GetTexel(rkLevel,iX+1,iY+1);
+
+    const float fScale = fInv255/65536.0f;
+    for (int i = 0, iShift = 0; i < 4; i++, iShift += 8)
+    {
+        unsigned int uiC0 = ((uiT00 >> iShift) & 0xFF)*(256 - uiFX)
+            + ((uiT10 >> iShift) & 0xFF)*uiFX;
+        unsigned int uiC1 = ((uiT01 >> iShift) & 0xFF)*(256 - uiFX)
+            + ((uiT11 >> iShift) & 0xFF)*uiFX;
+        afColor[i] = (float)(uiC0*(256 - uiFY) + uiC1*uiFY)*fScale;
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftTexture.h                    //
+//                                                       //
+//  - Interface for Soft Texture class                   //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#ifndef __WG_SOFTTEXTURE_H__
+#define __WG_SOFTTEXTURE_H__
+
+#include "WgSoftRendererLIB.h"
+#include "WgTexture.h"
+
+namespace WGSoft3D
+{
+
+// The copy of a texture that the software renderer samples.  The image is
+// converted to RGBA8888 texels (R in the lowest byte) when the texture is
+// first enabled, and the mipmaps are built then if the mipmap mode of the
+// texture uses them.  Row 0 of the image is at v = 0, as in OpenGL.  The
+// texture is immutable afterwards, so the tiles can sample it from any
+// thread.  A texture without image data samples as opaque white.
+
+class WG3D_RENDERER_ITEM SoftTexture
+{
+public:
+    SoftTexture (const Texture* pkTexture);
+    ~SoftTexture ();
+
+    // The color at (u,v), each channel in [0,1].  The level of detail is
+    // log2 of the number of texels per pixel, it selects between the
+    // magnification filter (Texture::Filter, fLod <= 0) and the
+    // minification filter (Texture::Mipmap).
+    void Sample (float fU, float fV, float fLod, float afColor[4]) const;
+
+    // The level of detail matters only if the two filters differ or if
+    // there are mipmaps.
+    bool NeedsLod () const;
+
+    // Images without alpha channel (IT_RGB888, IT_RGB565) change the
+    // results of some apply modes.
+    bool HasAlpha () const;
+
+    int GetWidth () const;
+    int GetHeight () const;
+
+private:
+    class Level
+    {
+    public:
+        int Width, Height;
+        unsigned int* Texel;
+    };
+
+    void Convert (const Image* pkImage, unsigned int* auiTexel);
+    void BuildMipmaps ();
+    unsigned int GetTexel (const Level& rkLevel, int iX, int iY) const;
+    void SampleLevel (int iLevel, bool bLinear, float fU, float fV,
+        float afColor[4]) const;
+
+    int m_iLevelQuantity;
+    Level* m_akLevel;
+    bool m_bHasAlpha, m_bRepeatU, m_bRepeatV;
+    bool m_bMagLinear, m_bMinLinear, m_bMipmap, m_bMipLinear;
+};
+
+#include "WgSoftTexture.inl"
+
+}
+
+#endif
@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftTexture.inl                  //
+//                                                       //
+//  - Inlines for Soft Texture class                     //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------
+inline bool SoftTexture::NeedsLod () const
+{
+    return m_bMipmap || m_bMagLinear != m_bMinLinear;
+}
+//----------------------------------------------------------------------------
+inline bool SoftTexture::HasAlpha () const
+{
+    return m_bHasAlpha;
+}
+//----------------------------------------------------------------------------
+inline int SoftTexture::GetWidth () const
+{
+    return m_akLevel[0].Width;
+}
+//----------------------------------------------------------------------------
+inline int SoftTexture::GetHeight () const
+{
+    return m_akLevel[0].Height;
+}
+//----------------------------------------------------------------------------
+inline unsigned int SoftTexture::GetTexel (const Level& rkLevel, int iX,
+    int iY) const
+{
+    if (m_bRepeatU)
+    {
+        iX %= rkLevel.Width;
+        if (iX < 0)
+        {
+            iX += rkLevel.Width;
+        }
+    }
+    else
+    {
+        iX = (iX < 0 ? 0 : (iX >= rkLevel.Width ? rkLevel.Width-1 : iX));
+    }
+
+    if (m_bRepeatV)
+    {
+        iY %= rkLevel.Height;
+        if (iY < 0)
+        {
+            iY += rkLevel.Height;
+        }
+    }
+    else
+    {
+        iY = (iY < 0 ? 0 : (iY >= rkLevel.Height ? rkLevel.Height-1 : iY));
+    }
+
+    return rkLevel.Texel[iY*rkLevel.Width+iX];
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,21 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftZBufferState.cpp             //
+//                                                       //
+//  - Implementation for Soft ZBuffer State class        //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgSoftRendererPCH.h"
+#include "WgSoftRenderer.h"
+using namespace WGSoft3D;
+
+//----------------------------------------------------------------------------
+void SoftRenderer::SetZBufferState (ZBufferState* pkState)
+{
+    // as in OpenGL, the depth buffer is written only if the test is enabled
+    m_kFragment.DepthEnabled = pkState->Enabled;
+    m_kFragment.DepthCompare = pkState->Compare;
+    m_kFragment.DepthWritable = pkState->Writable;
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,27 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftRendererLIB.h                //
+//                                                       //
+//  - Interface for Soft Rendering Library class         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#ifndef __WG_SOFTRENDERERLIB_H__
+#define __WG_SOFTRENDERERLIB_H__
+
+// For the DLL library.
+#ifdef WG3D_RENDERER_DLL_EXPORT
+#define WG3D_RENDERER_ITEM __declspec(dllexport)
+
+// For a client of the DLL library.
+#else
+#ifdef WG3D_RENDERER_DLL_IMPORT
+#define WG3D_RENDERER_ITEM __declspec(dllimport)
+
+// For the static library.
+#else
+#define WG3D_RENDERER_ITEM
+
+#endif
+#endif
+#endif
+
@@ -0,0 +1,10 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftRendererPCH.cpp              //
+//                                                       //
+//  - Implementation for Precompiled Header class        //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+#include "WgSoftRendererPCH.h"
+
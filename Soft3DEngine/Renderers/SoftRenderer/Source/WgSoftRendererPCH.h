@@ -0,0 +1,20 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    WgSoftRendererPCH.h                //
+//                                                       //
+//  - Interface for Precompiled Header class             //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+
+#ifndef __WG_SOFTRENDERERPCH_H__
+#define __WG_SOFTRENDERERPCH_H__
+
+#ifdef WG3D_USE_PRECOMPILED_HEADERS
+
+#include "WgSoftRenderer.h"
+
+#endif
+
+#endif
+
@@ -0,0 +1,192 @@
+# Microsoft Developer Studio Project File - Name="WGSoft3DSoftRendererStatic" - Package Owner=<4>
+# Microsoft Developer Studio Generated Build File, Format Version 6.00
+# ** DO NOT EDIT **
+
+# TARGTYPE "Win32 (x86) Static Library" 0x0104
+
+CFG=WGSoft3DSoftRendererStatic - Win32 Debug
+!MESSAGE This is not a valid makefile. To build this project using NMAKE,
+!MESSAGE use the Export Makefile command and run
+!MESSAGE 
+!MESSAGE NMAKE /f "WGSoft3DSoftRendererStatic.mak".
+!MESSAGE 
+!MESSAGE You can specify a configuration when running NMAKE
+!MESSAGE by defining the macro CFG on the command line. For example:
+!MESSAGE 
+!MESSAGE NMAKE /f "WGSoft3DSoftRendererStatic.mak" CFG="WGSoft3DSoftRendererStatic - Win32 Debug"
+!MESSAGE 
+!MESSAGE Possible choices for configuration are:
+!MESSAGE 
+!MESSAGE "WGSoft3DSoftRendererStatic - Win32 Release" (based on "Win32 (x86) Static Library")
+!MESSAGE "WGSoft3DSoftRendererStatic - Win32 Debug" (based on "Win32 (x86) Static Library")
+!MESSAGE 
+
+# Begin Project
+# PROP AllowPerConfigDependencies 0
+# PROP Scc_ProjName ""
+# PROP Scc_LocalPath ""
+CPP=cl.exe
+RSC=rc.exe
+
+!IF  "$(CFG)" == "WGSoft3DSoftRendererStatic - Win32 Release"
+
+# PROP BASE Use_MFC 0
+# PROP BASE Use_Debug_Libraries 0
+# PROP BASE Output_Dir "Release"
+# PROP BASE Intermediate_Dir "Release"
+# PROP BASE Target_Dir ""
+# PROP Use_MFC 0
+# PROP Use_Debug_Libraries 0
+# PROP Output_Dir "Release"
+# PROP Intermediate_Dir "Release"
+# PROP Target_Dir ""
+# ADD BASE CPP /nologo /W3 /GX /O2 /D "WIN32" /D "NDEBUG" /D "_MBCS" /D "_LIB" /YX /FD /c
+# ADD CPP /nologo /MT /W3 /GX /O2 /I "." /I "./Source" /I "./Source/Renderer" /I "../../include" /D "WIN32" /D "NDEBUG" /D "_MBCS" /D "_LIB" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgSoftRendererPCH.h" /FD /c
+# ADD BASE RSC /l 0x412 /d "NDEBUG"
+# ADD RSC /l 0x412 /d "NDEBUG"
+BSC32=bscmake.exe
+# ADD BASE BSC32 /nologo
+# ADD BSC32 /nologo
+LIB32=link.exe -lib
+# ADD BASE LIB32 /nologo
+# ADD LIB32 /nologo /out:"../../bin/WGSoft3DSoftRendererStatic.lib"
+
+!ELSEIF  "$(CFG)" == "WGSoft3DSoftRendererStatic - Win32 Debug"
+
+# PROP BASE Use_MFC 0
+# PROP BASE Use_Debug_Libraries 1
+# PROP BASE Output_Dir "Debug"
+# PROP BASE Intermediate_Dir "Debug"
+# PROP BASE Target_Dir ""
+# PROP Use_MFC 0
+# PROP Use_Debug_Libraries 1
+# PROP Output_Dir "Debug"
+# PROP Intermediate_Dir "Debug"
+# PROP Target_Dir ""
+# ADD BASE CPP /nologo /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_MBCS" /D "_LIB" /YX /FD /GZ /c
+# ADD CPP /nologo /MTd /W3 /Gm /GX /ZI /Od /I "." /I "./Source" /I "./Source/Renderer" /I "../../include" /D "WIN32" /D "_DEBUG" /D "_MBCS" /D "_LIB" /D "WG3D_USE_PRECOMPILED_HEADERS" /YX"WgSoftRendererPCH.h" /FD /GZ /c
+# ADD BASE RSC /l 0x412 /d "_DEBUG"
+# ADD RSC /l 0x412 /d "_DEBUG"
+BSC32=bscmake.exe
+# ADD BASE BSC32 /nologo
+# ADD BSC32 /nologo
+LIB32=link.exe -lib
+# ADD BASE LIB32 /nologo
+# ADD LIB32 /nologo /out:"../../bin/WGSoft3DSoftRendererStatic_D.lib"
+
+!ENDIF 
+
+# Begin Target
+
+# Name "WGSoft3DSoftRendererStatic - Win32 Release"
+# Name "WGSoft3DSoftRendererStatic - Win32 Debug"
+# Begin Group "Effects"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftBumpMap.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftEnvironmentMap.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftGlossMap.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftPlanarShadow.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftProjectedTexture.cpp
+# End Source File
+# End Group
+# Begin Group "States"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftAlphaState.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftCullState.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftDitherState.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftFogState.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftMaterialState.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftPolygonOffsetState.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftShadeState.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftStencilState.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftZBufferState.cpp
+# End Source File
+# End Group
+# Begin Group "Renderer"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftRasterizer.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftRenderer.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftRenderer.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftRenderer.inl
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftTexture.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftTexture.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\Renderer\WgSoftTexture.inl
+# End Source File
+# End Group
+# Begin Source File
+
+SOURCE=.\Source\WgSoftRendererLIB.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\WgSoftRendererPCH.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Source\WgSoftRendererPCH.h
+# End Source File
+# End Target
+# End Project
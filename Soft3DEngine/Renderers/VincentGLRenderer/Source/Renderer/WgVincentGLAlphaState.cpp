@@ -62,23 +62,24 @@ void VincentGLRenderer::SetAlphaState (AlphaState* pkState)
 {
     if (pkState->BlendEnabled)
     {
-        glEnable(GL_BLEND);
-        glBlendFunc(ms_aeAlphaSrcBlend[pkState->SrcBlend],
+        m_kGLState.Enable(GL_BLEND);
+        m_kGLState.BlendFunc(ms_aeAlphaSrcBlend[pkState->SrcBlend],
             ms_aeAlphaDstBlend[pkState->DstBlend]);
     }
     else
     {
-        glDisable(GL_BLEND);
+        m_kGLState.Disable(GL_BLEND);
     }
 
     if (pkState->TestEnabled)
     {
-        glEnable(GL_ALPHA_TEST);
-        glAlphaFunc(ms_aeAlphaTest[pkState->Test],pkState->Reference.value);
+        m_kGLState.Enable(GL_ALPHA_TEST);
+        m_kGLState.AlphaFunc(ms_aeAlphaTest[pkState->Test],
+            pkState->Reference.value);
     }
     else
     {
-        glDisable(GL_ALPHA_TEST);
+        m_kGLState.Disable(GL_ALPHA_TEST);
     }
 }
 //----------------------------------------------------------------------------
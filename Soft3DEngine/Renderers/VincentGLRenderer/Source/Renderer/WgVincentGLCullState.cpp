@@ -29,28 +29,28 @@ void VincentGLRenderer::SetCullState (CullState* pkState)
 {
     if (pkState->Enabled)
     {
-        glEnable(GL_CULL_FACE);
+        m_kGLState.Enable(GL_CULL_FACE);
     }
     else
     {
-        glDisable(GL_CULL_FACE);
+        m_kGLState.Disable(GL_CULL_FACE);
     }
 
-    glFrontFace(ms_aeFrontFace[pkState->FrontFace]);
+    m_kGLState.FrontFace(ms_aeFrontFace[pkState->FrontFace]);
 
     if (!m_bReverseCullFace)
     {
-        glCullFace(ms_aeCullFace[pkState->CullFace]);
+        m_kGLState.CullFace(ms_aeCullFace[pkState->CullFace]);
     }
     else
     {
         if (ms_aeCullFace[pkState->CullFace] == GL_BACK)
         {
-            glCullFace(GL_FRONT);
+            m_kGLState.CullFace(GL_FRONT);
         }
         else
         {
-            glCullFace(GL_BACK);
+            m_kGLState.CullFace(GL_BACK);
         }
     }
 }
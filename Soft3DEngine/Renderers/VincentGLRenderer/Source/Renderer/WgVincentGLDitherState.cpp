@@ -17,11 +17,11 @@ void VincentGLRenderer::SetDitherState (DitherState* pkState)
 {
     if (pkState->Enabled)
     {
-        glEnable(GL_DITHER);
+        m_kGLState.Enable(GL_DITHER);
     }
     else
     {
-        glDisable(GL_DITHER);
+        m_kGLState.Disable(GL_DITHER);
     }
 }
 //----------------------------------------------------------------------------
@@ -13,11 +13,14 @@
 #include "WgVincentGLRenderer.h"
 #include "WgNode.h"
 #include "WgEnvironmentMapEffect.h"
+#include "WgProfiler.h"
 using namespace WGSoft3D;
 
 //----------------------------------------------------------------------------
 void VincentGLRenderer::DrawEnvironmentMap ()
 {
+    WG3D_PROFILE("VincentGLRenderer::DrawEnvironmentMap");
+
     // Access the special effect.  Detach it from the node to allow the
     // effectless node drawing.
     assert(DynamicCast<EnvironmentMapEffect>(m_pkGlobalEffect));
@@ -15,11 +15,11 @@ using namespace WGSoft3D;
 //----------------------------------------------------------------------------
 void VincentGLRenderer::SetMaterialState (MaterialState* pkState)
 {
-    glMaterialxv(GL_FRONT,GL_EMISSION,(int*)(fixed*)pkState->Emissive);
-    glMaterialxv(GL_FRONT,GL_AMBIENT,(int*)(fixed*)pkState->Ambient);
-    glMaterialxv(GL_FRONT,GL_DIFFUSE,(int*)(fixed*)pkState->Diffuse);
-    glMaterialxv(GL_FRONT,GL_SPECULAR,(int*)(fixed*)pkState->Specular);
-    glMaterialx(GL_FRONT,GL_SHININESS,pkState->Shininess.value);
+    m_kGLState.Materialv(GL_EMISSION,(GLreal*)(fixed*)pkState->Emissive);
+    m_kGLState.Materialv(GL_AMBIENT,(GLreal*)(fixed*)pkState->Ambient);
+    m_kGLState.Materialv(GL_DIFFUSE,(GLreal*)(fixed*)pkState->Diffuse);
+    m_kGLState.Materialv(GL_SPECULAR,(GLreal*)(fixed*)pkState->Specular);
+    m_kGLState.Material(GL_SHININESS,pkState->Shininess.value);
 }
 //----------------------------------------------------------------------------
 
@@ -17,11 +17,11 @@ void VincentGLRenderer::SetPolygonOffsetState (PolygonOffsetState* pkState)
 {
     if (pkState->FillEnabled)
     {
-        glEnable(GL_POLYGON_OFFSET_FILL);
+        m_kGLState.Enable(GL_POLYGON_OFFSET_FILL);
     }
     else
     {
-        glDisable(GL_POLYGON_OFFSET_FILL);
+        m_kGLState.Disable(GL_POLYGON_OFFSET_FILL);
     }
 
 //     if (pkState->LineEnabled)
@@ -42,6 +42,6 @@ void VincentGLRenderer::SetPolygonOffsetState (PolygonOffsetState* pkState)
 //         glDisable(GL_POLYGON_OFFSET_POINT);
 //     }
 
-    glPolygonOffsetx(pkState->Scale.value,pkState->Bias.value);
+    m_kGLState.PolygonOffset(pkState->Scale.value,pkState->Bias.value);
 }
 //----------------------------------------------------------------------------
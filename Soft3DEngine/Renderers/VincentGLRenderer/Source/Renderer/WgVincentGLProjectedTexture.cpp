@@ -13,11 +13,14 @@
 #include "WgVincentGLRenderer.h"
 #include "WgNode.h"
 #include "WgProjectedTextureEffect.h"
+#include "WgProfiler.h"
 using namespace WGSoft3D;
 
 //----------------------------------------------------------------------------
 void VincentGLRenderer::DrawProjectedTexture ()
 {
+    WG3D_PROFILE("VincentGLRenderer::DrawProjectedTexture");
+
     // Access the special effect.  Detach it from the node to allow the
     // effectless node drawing.
     assert(DynamicCast<ProjectedTextureEffect>(m_pkGlobalEffect));
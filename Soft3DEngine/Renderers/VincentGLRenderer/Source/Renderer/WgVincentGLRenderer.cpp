@@ -20,6 +20,7 @@
 #include "WgCachedShortArray.h"
 #include "WgCachedVector2Array.h"
 #include "WgCachedVector3Array.h"
+#include "WgProfiler.h"
 using namespace WGSoft3D;
 
 GLenum VincentGLRenderer::ms_aeObjectType[Geometry::GT_MAX_QUANTITY] =
@@ -127,8 +128,6 @@ VincentGLRenderer::VincentGLRenderer (const BufferParams& rkBufferParams,
 {
     ms_eType = RT_OPENGL;
 
-    // initial world matrix is zero (will always be set properly later)
-    memset(m_afWorldMatrix,0,16*sizeof(fixed));
 	InitializeState();
 }
 //----------------------------------------------------------------------------
@@ -138,19 +137,22 @@ VincentGLRenderer::~VincentGLRenderer ()
 //----------------------------------------------------------------------------
 void VincentGLRenderer::InitializeState ()
 {
+    // the state of a new context is not known to the cache
+    m_kGLState.Invalidate();
+
     // initialize global render state to default settings
 	GlobalState::SetGlobalStates();
     SetGlobalState(GlobalState::Default);
 
     // vertices always exist
-    glEnableClientState(GL_VERTEX_ARRAY);
+    m_kGLState.EnableClientState(GL_VERTEX_ARRAY);
 
     // colors disabled, current color is WHITE
-    glDisableClientState(GL_COLOR_ARRAY);
-    glColor4x(ColorRGBA::WHITE.R().value,ColorRGBA::WHITE.G().value,ColorRGBA::WHITE.B().value,ColorRGBA::WHITE.A().value);
+    m_kGLState.DisableClientState(GL_COLOR_ARRAY);
+    glColor4r(ColorRGBA::WHITE.R().value,ColorRGBA::WHITE.G().value,ColorRGBA::WHITE.B().value,ColorRGBA::WHITE.A().value);
 
     // normals disabled
-    glDisableClientState(GL_NORMAL_ARRAY);
+    m_kGLState.DisableClientState(GL_NORMAL_ARRAY);
 
     // Get number of supported texture units.  Initially disable them.
     GLint iMaxTextures=1;
@@ -172,16 +174,16 @@ void VincentGLRenderer::InitializeState ()
 
     // set up light model
     m_iMaxLights = 8;  // OpenGL limits the number of lights to eight
-    glLightModelxv(GL_LIGHT_MODEL_AMBIENT,(const int*)(const fixed*)ColorRGBA::BLACK);
+    glLightModelrv(GL_LIGHT_MODEL_AMBIENT,(const GLreal*)(const fixed*)ColorRGBA::BLACK);
     glLightModelx(GL_LIGHT_MODEL_TWO_SIDE,GL_FALSE);
-    glDisable(GL_LIGHTING);
+    m_kGLState.Disable(GL_LIGHTING);
 
      // get stencil buffer size
      GLint iBits = 0;
      glGetIntegerv((GLenum)GL_STENCIL_BITS,&iBits);
      m_iMaxStencilIndices = (iBits > 0 ? (1 << iBits) : 0);
 
-	 glDepthRangex(FIXED_ZERO,FIXED_ONE);
+	 glDepthRanger(fixed(FIXED_ZERO).value,fixed(FIXED_ONE).value);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::Activate ()
@@ -198,7 +200,7 @@ void VincentGLRenderer::Activate ()
 void VincentGLRenderer::SetBackgroundColor (const ColorRGBA& rkColor)
 {
     Renderer::SetBackgroundColor(rkColor);
-    glClearColorx(rkColor[0].value,rkColor[1].value,rkColor[2].value,rkColor[3].value);
+    glClearColorr(rkColor[0].value,rkColor[1].value,rkColor[2].value,rkColor[3].value);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::ClearBackBuffer ()
@@ -214,8 +216,8 @@ void VincentGLRenderer::ClearZBuffer ()
     //glEnable(GL_SCISSOR_TEST);
     //glScissor(0,0,m_iWidth,m_iHeight);
     //glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_TRUE);
-	glClearDepthx(FIXED_ONE);
+    m_kGLState.DepthMask(GL_TRUE);
+	glClearDepthr(fixed(FIXED_ONE).value);
     glClear(GL_DEPTH_BUFFER_BIT);
     //glDisable(GL_SCISSOR_TEST);
 }
@@ -224,7 +226,7 @@ void VincentGLRenderer::ClearStencilBuffer ()
 {
     //glEnable(GL_SCISSOR_TEST);
     //glScissor(0,0,m_iWidth,m_iHeight);
-    glStencilMask(~0);
+    m_kGLState.StencilMask(~0);
     glClear(GL_STENCIL_BUFFER_BIT);
     //glDisable(GL_SCISSOR_TEST);
 }
@@ -233,10 +235,10 @@ void VincentGLRenderer::ClearBuffers ()
 {
     //glEnable(GL_SCISSOR_TEST);
     //glScissor(0,0,m_iWidth,m_iHeight);
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_TRUE);
-	glClearDepthx(FIXED_ONE);
-    glStencilMask(~0);
+    m_kGLState.Enable(GL_DEPTH_TEST);
+    m_kGLState.DepthMask(GL_TRUE);
+	glClearDepthr(fixed(FIXED_ONE).value);
+    m_kGLState.StencilMask(~0);
     glClear(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT|GL_STENCIL_BUFFER_BIT);
     //glDisable(GL_SCISSOR_TEST);
 }
@@ -244,87 +246,43 @@ void VincentGLRenderer::ClearBuffers ()
 void VincentGLRenderer::ClearBackBuffer (int iXPos, int iYPos, int iWidth,
     int iHeight)
 {
-    glEnable(GL_SCISSOR_TEST);
+    m_kGLState.Enable(GL_SCISSOR_TEST);
     glScissor(iXPos,iYPos,iWidth,iHeight);
     glClear(GL_COLOR_BUFFER_BIT);
-    glDisable(GL_SCISSOR_TEST);
+    m_kGLState.Disable(GL_SCISSOR_TEST);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::ClearZBuffer (int iXPos, int iYPos, int iWidth,
     int iHeight)
 {
-    glEnable(GL_SCISSOR_TEST);
+    m_kGLState.Enable(GL_SCISSOR_TEST);
     glScissor(iXPos,iYPos,iWidth,iHeight);
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_TRUE);
+    m_kGLState.Enable(GL_DEPTH_TEST);
+    m_kGLState.DepthMask(GL_TRUE);
     glClear(GL_DEPTH_BUFFER_BIT);
-    glDisable(GL_SCISSOR_TEST);
+    m_kGLState.Disable(GL_SCISSOR_TEST);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::ClearStencilBuffer (int iXPos, int iYPos, int iWidth,
     int iHeight)
 {
-    glEnable(GL_SCISSOR_TEST);
+    m_kGLState.Enable(GL_SCISSOR_TEST);
     glScissor(iXPos,iYPos,iWidth,iHeight);
-    glStencilMask(~0);
+    m_kGLState.StencilMask(~0);
     glClear(GL_STENCIL_BUFFER_BIT);
-    glDisable(GL_SCISSOR_TEST);
+    m_kGLState.Disable(GL_SCISSOR_TEST);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::ClearBuffers (int iXPos, int iYPos, int iWidth,
     int iHeight)
 {
-    glEnable(GL_SCISSOR_TEST);
+    m_kGLState.Enable(GL_SCISSOR_TEST);
     glScissor(iXPos,iYPos,iWidth,iHeight);
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_TRUE);
-    glStencilMask(~0);
+    m_kGLState.Enable(GL_DEPTH_TEST);
+    m_kGLState.DepthMask(GL_TRUE);
+    m_kGLState.StencilMask(~0);
     glClear(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT|GL_STENCIL_BUFFER_BIT);
-    glDisable(GL_SCISSOR_TEST);
-}
-//----------------------------------------------------------------------------
-void VincentGLRenderer::SetWorldMatrix ()
-{
-    if (m_pkGeometry->World.IsRSMatrix())
-    {
-        const Matrix3x& rkRotate = m_pkGeometry->World.GetRotate();
-        const Vector3x& rkScale = m_pkGeometry->World.GetScale();
-
-        m_afWorldMatrix[ 0] = rkScale.X()*rkRotate[0][0];
-        m_afWorldMatrix[ 1] = rkScale.X()*rkRotate[1][0];
-        m_afWorldMatrix[ 2] = rkScale.X()*rkRotate[2][0];
-        m_afWorldMatrix[ 3] = FIXED_ZERO;
-        m_afWorldMatrix[ 4] = rkScale.Y()*rkRotate[0][1];
-        m_afWorldMatrix[ 5] = rkScale.Y()*rkRotate[1][1];
-        m_afWorldMatrix[ 6] = rkScale.Y()*rkRotate[2][1];
-        m_afWorldMatrix[ 7] = FIXED_ZERO;
-        m_afWorldMatrix[ 8] = rkScale.Z()*rkRotate[0][2];
-        m_afWorldMatrix[ 9] = rkScale.Z()*rkRotate[1][2];
-        m_afWorldMatrix[10] = rkScale.Z()*rkRotate[2][2];
-        m_afWorldMatrix[11] = FIXED_ZERO;
-    }
-    else
-    {
-        const Matrix3x& rkMatrix = m_pkGeometry->World.GetMatrix();
-        m_afWorldMatrix[ 0] = rkMatrix[0][0];
-        m_afWorldMatrix[ 1] = rkMatrix[1][0];
-        m_afWorldMatrix[ 2] = rkMatrix[2][0];
-        m_afWorldMatrix[ 3] = FIXED_ZERO;
-        m_afWorldMatrix[ 4] = rkMatrix[0][1];
-        m_afWorldMatrix[ 5] = rkMatrix[1][1];
-        m_afWorldMatrix[ 6] = rkMatrix[2][1];
-        m_afWorldMatrix[ 7] = FIXED_ZERO;
-        m_afWorldMatrix[ 8] = rkMatrix[0][2];
-        m_afWorldMatrix[ 9] = rkMatrix[1][2];
-        m_afWorldMatrix[10] = rkMatrix[2][2];
-        m_afWorldMatrix[11] = FIXED_ZERO;
-    }
-
-    const Vector3x& rkTranslate = m_pkGeometry->World.GetTranslate();
-    m_afWorldMatrix[12] = rkTranslate.X();
-    m_afWorldMatrix[13] = rkTranslate.Y();
-    m_afWorldMatrix[14] = rkTranslate.Z();
-    m_afWorldMatrix[15] = FIXED_ONE;
+    m_kGLState.Disable(GL_SCISSOR_TEST);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::OnFrustumChange ()
@@ -338,7 +296,7 @@ void VincentGLRenderer::OnFrustumChange ()
 
         if (m_pkCamera->Perspective)
         {
-            glFrustumx(fL.value,fR.value,fB.value,fT.value,fN.value,fF.value);
+            glFrustumr(fL.value,fR.value,fB.value,fT.value,fN.value,fF.value);
         }
         else
         {
@@ -364,10 +322,13 @@ void VincentGLRenderer::OnViewPortChange ()
         fB = FIXED_ZERO;
     }
 
-    GLint iX = (fL*m_iWidth).value;
-    GLint iY = (GLint)(fB*m_iHeight).value;
-    GLsizei iW = (GLsizei)((fR - fL)*m_iWidth).value;
-    GLsizei iH = (GLsizei)((fT - fB)*m_iHeight).value;
+    // the size of the window is an int, not a raw 16.16 operand
+    fixed fWidth = fixed::FromInt(m_iWidth);
+    fixed fHeight = fixed::FromInt(m_iHeight);
+    GLint iX = (GLint)IntFromFixed(fL*fWidth);
+    GLint iY = (GLint)IntFromFixed(fB*fHeight);
+    GLsizei iW = (GLsizei)IntFromFixed((fR - fL)*fWidth);
+    GLsizei iH = (GLsizei)IntFromFixed((fT - fB)*fHeight);
     glViewport(iX,iY,iW,iH);
 }
 //----------------------------------------------------------------------------
@@ -393,7 +354,7 @@ void VincentGLRenderer::EnableLighting (int eEnable)
 
     if (iQuantity > 0)
     {
-        glEnable(GL_LIGHTING);
+        m_kGLState.Enable(GL_LIGHTING);
         for (int i = 0; i < iQuantity; i++)
         {
             const Light* pkLight = m_pkGeometry->Lights[i];
@@ -423,14 +384,14 @@ void VincentGLRenderer::DisableLighting ()
                 DisableLight(i,pkLight);
             }
         }
-        glDisable(GL_LIGHTING);
+        m_kGLState.Disable(GL_LIGHTING);
     }
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::EnableLight (int eEnable, int i, const Light* pkLight)
 {
     GLenum eIndex = (GLenum)(GL_LIGHT0 + i);
-    glEnable(eIndex);
+    m_kGLState.Enable(eIndex);
 
     // ambient
     ColorRGBA kColor;
@@ -443,7 +404,7 @@ void VincentGLRenderer::EnableLight (int eEnable, int i, const Light* pkLight)
     {
         kColor = ColorRGBA::BLACK;
     }
-    glLightxv(eIndex,GL_AMBIENT,(int*)(fixed*)kColor);
+    glLightrv(eIndex,GL_AMBIENT,(GLreal*)(fixed*)kColor);
 
     // diffuse
     if ((eEnable & EL_DIFFUSE) && pkLight->Type != Light::LT_AMBIENT)
@@ -455,7 +416,7 @@ void VincentGLRenderer::EnableLight (int eEnable, int i, const Light* pkLight)
     {
         kColor = ColorRGBA::WHITE;
     }
-    glLightxv(eIndex,GL_DIFFUSE,(int*)(fixed*)kColor);
+    glLightrv(eIndex,GL_DIFFUSE,(GLreal*)(fixed*)kColor);
 
     // specular
     if ((eEnable & EL_SPECULAR) && pkLight->Type != Light::LT_AMBIENT)
@@ -467,22 +428,22 @@ void VincentGLRenderer::EnableLight (int eEnable, int i, const Light* pkLight)
     {
         kColor = ColorRGBA::WHITE;
     }
-    glLightxv(eIndex,GL_SPECULAR,(int*)(fixed*)kColor);
+    glLightrv(eIndex,GL_SPECULAR,(GLreal*)(fixed*)kColor);
 
     if (pkLight->Attenuate)
     {
-        glLightx(eIndex,GL_CONSTANT_ATTENUATION, pkLight->Constant.value);
-        glLightx(eIndex,GL_LINEAR_ATTENUATION, pkLight->Linear.value);
-        glLightx(eIndex,GL_QUADRATIC_ATTENUATION, pkLight->Quadratic.value);
+        glLightr(eIndex,GL_CONSTANT_ATTENUATION, pkLight->Constant.value);
+        glLightr(eIndex,GL_LINEAR_ATTENUATION, pkLight->Linear.value);
+        glLightr(eIndex,GL_QUADRATIC_ATTENUATION, pkLight->Quadratic.value);
     }
     else
     {
-        glLightx(eIndex,GL_CONSTANT_ATTENUATION,FIXED_ONE);
-        glLightx(eIndex,GL_LINEAR_ATTENUATION,FIXED_ZERO);
-        glLightx(eIndex,GL_QUADRATIC_ATTENUATION,FIXED_ZERO);
+        glLightr(eIndex,GL_CONSTANT_ATTENUATION,fixed(FIXED_ONE).value);
+        glLightr(eIndex,GL_LINEAR_ATTENUATION,fixed(FIXED_ZERO).value);
+        glLightr(eIndex,GL_QUADRATIC_ATTENUATION,fixed(FIXED_ZERO).value);
     }
 
-    GLfixed afTemp[4];
+    fixed afTemp[4];
     Vector3x kLoc, kDir;
 
     switch (pkLight->Type)
@@ -492,24 +453,24 @@ void VincentGLRenderer::EnableLight (int eEnable, int i, const Light* pkLight)
         afTemp[1] = FIXED_ZERO;
         afTemp[2] = FIXED_ONE;
         afTemp[3] = FIXED_ZERO;
-        glLightxv(eIndex,GL_POSITION,(int*)afTemp);
+        glLightrv(eIndex,GL_POSITION,(GLreal*)afTemp);
         break;
     case Light::LT_DIRECTIONAL:
         kDir = pkLight->GetWorldDVector();
-        afTemp[0] = (-kDir.X()).value;
-        afTemp[1] = (-kDir.Y()).value;
-        afTemp[2] = (-kDir.Z()).value;
+        afTemp[0] = -kDir.X();
+        afTemp[1] = -kDir.Y();
+        afTemp[2] = -kDir.Z();
         afTemp[3] = FIXED_ZERO;
-        glLightxv(eIndex,GL_POSITION,(int*)afTemp);
+        glLightrv(eIndex,GL_POSITION,(GLreal*)afTemp);
         break;
     case Light::LT_POINT:
     case Light::LT_SPOT:
         kLoc = pkLight->GetWorldLocation();
-        afTemp[0] = kLoc.X().value;
-        afTemp[1] = kLoc.Y().value;
-        afTemp[2] = kLoc.Z().value;
+        afTemp[0] = kLoc.X();
+        afTemp[1] = kLoc.Y();
+        afTemp[2] = kLoc.Z();
         afTemp[3] = FIXED_ONE;
-        glLightxv(eIndex,GL_POSITION,(int*)afTemp);
+        glLightrv(eIndex,GL_POSITION,(GLreal*)afTemp);
         break;
     default:  // Light::LT_QUANTITY
         assert( false );
@@ -519,24 +480,24 @@ void VincentGLRenderer::EnableLight (int eEnable, int i, const Light* pkLight)
     if (pkLight->Type == Light::LT_SPOT)
     {
         fixed fDegrees = Mathx::RAD_TO_DEG*pkLight->Angle;
-        glLightx(eIndex,GL_SPOT_CUTOFF,fDegrees.value);
+        glLightr(eIndex,GL_SPOT_CUTOFF,fDegrees.value);
         kDir = pkLight->GetWorldDVector();
-        glLightxv(eIndex,GL_SPOT_DIRECTION,(int*)(fixed*)kDir);
-        glLightx(eIndex,GL_SPOT_EXPONENT,pkLight->Exponent.value);
+        glLightrv(eIndex,GL_SPOT_DIRECTION,(GLreal*)(fixed*)kDir);
+        glLightr(eIndex,GL_SPOT_EXPONENT,pkLight->Exponent.value);
     }
     else
     {
-        GLfixed afDefaultDir[3] = { FIXED_ZERO, FIXED_ZERO, -FIXED_ONE };
-        glLightx(eIndex,GL_SPOT_CUTOFF,FixedFromFloat(180.0f));
-        glLightxv(eIndex,GL_SPOT_DIRECTION,afDefaultDir);
-        glLightx(eIndex,GL_SPOT_EXPONENT,FIXED_ZERO);
+        fixed afDefaultDir[3] = { FIXED_ZERO, FIXED_ZERO, FIXED_NEG_ONE };
+        glLightr(eIndex,GL_SPOT_CUTOFF,fixed(FixedFromFloat(180.0f)).value);
+        glLightrv(eIndex,GL_SPOT_DIRECTION,(GLreal*)afDefaultDir);
+        glLightr(eIndex,GL_SPOT_EXPONENT,fixed(FIXED_ZERO).value);
     }
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::DisableLight (int i, const Light* pkLight)
 {
     GLenum eIndex = (GLenum)(GL_LIGHT0 + i);
-    glDisable(eIndex);
+    m_kGLState.Disable(eIndex);
 }
 //----------------------------------------------------------------------------
 
@@ -553,15 +514,16 @@ void VincentGLRenderer::EnableTexture (int iUnit, int i, Effect* pkEffect)
     }
 
     Texture* pkTexture = pkEffect->Textures[i];
-    glEnable(GL_TEXTURE_2D);
+    m_kGLState.Enable(GL_TEXTURE_2D);
 
     GLuint uiID;
     pkTexture->BIArray.GetID(this,sizeof(GLuint),&uiID);
+    WG3D_RENDER_STATS_DO(m_kStats.GetCurrent().TextureBinds++);
 
     if (uiID != 0)
     {
         // texture already exists in OpenGL, just bind it
-        glBindTexture(GL_TEXTURE_2D,uiID);
+        m_kGLState.BindTexture(uiID);
     }
     else
     {
@@ -570,7 +532,7 @@ void VincentGLRenderer::EnableTexture (int iUnit, int i, Effect* pkEffect)
         pkTexture->BIArray.Bind(this,sizeof(GLuint),&uiID);
 
         // bind the texture
-        glBindTexture(GL_TEXTURE_2D,uiID);
+        m_kGLState.BindTexture(uiID);
 
         // Get texture image data.  Not all textures have image data.
         // For example, AM_COMBINE modes can use primary colors,
@@ -579,6 +541,12 @@ void VincentGLRenderer::EnableTexture (int iUnit, int i, Effect* pkEffect)
         ImagePtr spkImage = pkTexture->GetImage();
         if (spkImage)
         {
+#ifdef WG3D_RENDER_STATS
+            RenderStats::Frame& rkFrame = m_kStats.GetCurrent();
+            rkFrame.TextureUploads++;
+            rkFrame.TextureBytes +=
+                spkImage->GetQuantity()*spkImage->GetBytesPerPixel();
+#endif
             if (pkTexture->Mipmap == Texture::MM_NEAREST
             ||  pkTexture->Mipmap == Texture::MM_LINEAR)
             {
@@ -654,22 +622,21 @@ void VincentGLRenderer::EnableTexture (int iUnit, int i, Effect* pkEffect)
     }
 
     // set up correction mode
-    glHint(GL_PERSPECTIVE_CORRECTION_HINT,
+    m_kGLState.Hint(GL_PERSPECTIVE_CORRECTION_HINT,
         ms_aeTextureCorrection[pkTexture->Correction]);
 
     // set up the blend color
-    glTexEnvxv(GL_TEXTURE_ENV,GL_TEXTURE_ENV_COLOR,
-        (const int*)(const fixed*)pkTexture->BlendColor);
+    m_kGLState.TexEnvColor(
+        (const GLreal*)(const fixed*)pkTexture->BlendColor);
 
     // set up apply mode
     if (pkTexture->Apply != Texture::AM_COMBINE)
     {
-        glTexEnvx(GL_TEXTURE_ENV,GL_TEXTURE_ENV_MODE,
-            ms_aeTextureApply[pkTexture->Apply]);
+        m_kGLState.TexEnvMode(ms_aeTextureApply[pkTexture->Apply]);
     }
     else  // AM_COMBINE
     {
-		glTexEnvx(GL_TEXTURE_ENV,GL_TEXTURE_ENV_MODE,GL_REPLACE);
+		m_kGLState.TexEnvMode(GL_REPLACE);
     }
 }
 //----------------------------------------------------------------------------
@@ -677,8 +644,8 @@ void VincentGLRenderer::DisableTexture (int iUnit, int i, Effect* pkEffect)
 {
     Texture* pkTexture = pkEffect->Textures[i];
 
-    glDisable(GL_TEXTURE_2D);
-    glClientActiveTexture(GL_TEXTURE0+iUnit);
+    m_kGLState.Disable(GL_TEXTURE_2D);
+    m_kGLState.ClientActiveTexture(iUnit);
 
     if (i < pkEffect->UVs.GetQuantity())
     {
@@ -692,8 +659,8 @@ void VincentGLRenderer::DisableTexture (int iUnit, int i, Effect* pkEffect)
 //----------------------------------------------------------------------------
 void VincentGLRenderer::SetActiveTextureUnit (int iUnit)
 {
-        glClientActiveTexture(GL_TEXTURE0+iUnit);
-        glActiveTexture(GL_TEXTURE0+iUnit);
+        m_kGLState.ClientActiveTexture(iUnit);
+        m_kGLState.ActiveTexture(iUnit);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::ReleaseTexture (Texture* pkTexture)
@@ -706,27 +673,26 @@ void VincentGLRenderer::ReleaseTexture (Texture* pkTexture)
     pkTexture->BIArray.GetID(this,sizeof(GLuint),&uiID);
     if (uiID > 0)
     {
-        glDeleteTextures((GLsizei)1,(GLuint*)&uiID);
+        m_kGLState.DeleteTexture(uiID);
     }
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::SetWorldTransformation ()
 {
-    // primitive is 3D
-    SetWorldMatrix();
+    // primitive is 3D, the world matrix is cached by the transformation
     glMatrixMode(GL_MODELVIEW);
     glPushMatrix();
-    glMultMatrixx((int*)m_afWorldMatrix);
+    glMultMatrixr((const GLreal*)m_pkGeometry->GetWorldHomogeneous());
     if (m_pkGeometry->World.IsUniformScale())
     {
         if (m_pkGeometry->World.GetUniformScale() != FIXED_ONE)
         {
-			glEnable(GL_RESCALE_NORMAL);
+			m_kGLState.Enable(GL_RESCALE_NORMAL);
         }
     }
     else
     {
-        glEnable(GL_NORMALIZE);
+        m_kGLState.Enable(GL_NORMALIZE);
     }
 }
 //----------------------------------------------------------------------------
@@ -736,12 +702,12 @@ void VincentGLRenderer::RestoreWorldTransformation ()
     {
         if (m_pkGeometry->World.GetUniformScale() != FIXED_ONE)
         {
-            glDisable(GL_RESCALE_NORMAL);
+            m_kGLState.Disable(GL_RESCALE_NORMAL);
         }
     }
     else
     {
-        glDisable(GL_NORMALIZE);
+        m_kGLState.Disable(GL_NORMALIZE);
     }
 	glMatrixMode(GL_MODELVIEW);
     glPopMatrix();
@@ -790,7 +756,7 @@ void VincentGLRenderer::EnableVertices ()
         if (uiID > 0)
         {
             // vertices already cached, just bind them
-            glBindBuffer(GL_ARRAY_BUFFER,uiID);
+            m_kGLState.BindBuffer(GL_ARRAY_BUFFER,uiID);
         }
         else
         {
@@ -799,12 +765,17 @@ void VincentGLRenderer::EnableVertices ()
             pkCVertices->BIArray.Bind(this,sizeof(GLuint),&uiID);
 
             // bind the vertices
-            glBindBuffer(GL_ARRAY_BUFFER,uiID);
+            m_kGLState.BindBuffer(GL_ARRAY_BUFFER,uiID);
 
             // copy the data to the buffer
             glBufferData(GL_ARRAY_BUFFER,
                 pkVertices->GetQuantity()*sizeof(Vector3x),akVertex,
                 GL_STATIC_DRAW);
+#ifdef WG3D_RENDER_STATS
+            m_kStats.GetCurrent().BufferCreations++;
+            m_kStats.GetCurrent().BufferBytes +=
+                (int)(pkVertices->GetQuantity()*sizeof(Vector3x));
+#endif
 			pkVertices->DeleteRawData();
         }
 
@@ -814,18 +785,18 @@ void VincentGLRenderer::EnableVertices ()
 	else if(!akVertex)
 		return;
 
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glVertexPointer(3,GL_FIXED,0,akVertex);
+    m_kGLState.EnableClientState(GL_VERTEX_ARRAY);
+    m_kGLState.VertexPointer(3,akVertex);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::DisableVertices ()
 {
     if (m_pkGeometry->Vertices->IsExactly(CachedVector3xArray::TYPE))
     {
-        glBindBuffer(GL_ARRAY_BUFFER,0);
+        m_kGLState.BindBuffer(GL_ARRAY_BUFFER,0);
     }
 
-    glDisableClientState(GL_VERTEX_ARRAY);
+    m_kGLState.DisableClientState(GL_VERTEX_ARRAY);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::EnableNormals ()
@@ -843,7 +814,7 @@ void VincentGLRenderer::EnableNormals ()
         if (uiID > 0)
         {
             // normals already cached, just bind them
-            glBindBuffer(GL_ARRAY_BUFFER,uiID);
+            m_kGLState.BindBuffer(GL_ARRAY_BUFFER,uiID);
         }
         else
         {
@@ -852,12 +823,17 @@ void VincentGLRenderer::EnableNormals ()
             pkCNormals->BIArray.Bind(this,sizeof(GLuint),&uiID);
 
             // bind the normals
-            glBindBuffer(GL_ARRAY_BUFFER,uiID);
+            m_kGLState.BindBuffer(GL_ARRAY_BUFFER,uiID);
 
             // copy the data to the buffer
             glBufferData(GL_ARRAY_BUFFER,
                 pkNormals->GetQuantity()*sizeof(Vector3x),akNormal,
                 GL_STATIC_DRAW);
+#ifdef WG3D_RENDER_STATS
+            m_kStats.GetCurrent().BufferCreations++;
+            m_kStats.GetCurrent().BufferBytes +=
+                (int)(pkNormals->GetQuantity()*sizeof(Vector3x));
+#endif
 			pkNormals->DeleteRawData();
         }
 
@@ -866,18 +842,18 @@ void VincentGLRenderer::EnableNormals ()
 	else if(!akNormal)
 		return;
 
-    glEnableClientState(GL_NORMAL_ARRAY);
-    glNormalPointer(GL_FIXED,0,akNormal);
+    m_kGLState.EnableClientState(GL_NORMAL_ARRAY);
+    m_kGLState.NormalPointer(akNormal);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::DisableNormals ()
 {
     if (m_pkGeometry->Normals->IsExactly(CachedVector3xArray::TYPE))
     {
-		glBindBuffer(GL_ARRAY_BUFFER,0);
+		m_kGLState.BindBuffer(GL_ARRAY_BUFFER,0);
     }
 
-    glDisableClientState(GL_NORMAL_ARRAY);
+    m_kGLState.DisableClientState(GL_NORMAL_ARRAY);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::EnableColorRGBAs ()
@@ -895,7 +871,7 @@ void VincentGLRenderer::EnableColorRGBAs ()
         if (uiID > 0)
         {
             // colors already cached, just bind them
-            glBindBuffer(GL_ARRAY_BUFFER,uiID);
+            m_kGLState.BindBuffer(GL_ARRAY_BUFFER,uiID);
         }
         else
         {
@@ -904,12 +880,17 @@ void VincentGLRenderer::EnableColorRGBAs ()
             pkCColors->BIArray.Bind(this,sizeof(GLuint),&uiID);
 
             // bind the colors
-            glBindBuffer(GL_ARRAY_BUFFER,uiID);
+            m_kGLState.BindBuffer(GL_ARRAY_BUFFER,uiID);
 
             // copy the data to the buffer
             glBufferData(GL_ARRAY_BUFFER,
                 pkColors->GetQuantity()*sizeof(ColorRGBA),akColor,
                 GL_STATIC_DRAW);
+#ifdef WG3D_RENDER_STATS
+            m_kStats.GetCurrent().BufferCreations++;
+            m_kStats.GetCurrent().BufferBytes +=
+                (int)(pkColors->GetQuantity()*sizeof(ColorRGBA));
+#endif
 			pkCColors->DeleteRawData();
         }
 
@@ -918,18 +899,18 @@ void VincentGLRenderer::EnableColorRGBAs ()
     }
 	else if(!akColor)
 		return;
-    glEnableClientState(GL_COLOR_ARRAY);
-    glColorPointer(4,GL_FIXED,0,akColor);
+    m_kGLState.EnableClientState(GL_COLOR_ARRAY);
+    m_kGLState.ColorPointer(4,akColor);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::DisableColorRGBAs ()
 {
     if (m_pkLocalEffect->ColorRGBAs->IsExactly(CachedColorRGBAArray::TYPE))
     {
-		glBindBuffer(GL_ARRAY_BUFFER,0);
+		m_kGLState.BindBuffer(GL_ARRAY_BUFFER,0);
     }
 
-    glDisableClientState(GL_COLOR_ARRAY);
+    m_kGLState.DisableClientState(GL_COLOR_ARRAY);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::EnableColorRGBs ()
@@ -948,7 +929,7 @@ void VincentGLRenderer::EnableColorRGBs ()
         if (uiID > 0)
         {
             // colors already cached, just bind them
-            glBindBuffer(GL_ARRAY_BUFFER,uiID);
+            m_kGLState.BindBuffer(GL_ARRAY_BUFFER,uiID);
         }
         else
         {
@@ -957,12 +938,17 @@ void VincentGLRenderer::EnableColorRGBs ()
             pkCColors->BIArray.Bind(this,sizeof(GLuint),&uiID);
 
             // bind the colors
-            glBindBuffer(GL_ARRAY_BUFFER,uiID);
+            m_kGLState.BindBuffer(GL_ARRAY_BUFFER,uiID);
 
             // copy the data to the buffer
             glBufferData(GL_ARRAY_BUFFER,
                 pkColors->GetQuantity()*sizeof(ColorRGB),akColor,
                 GL_STATIC_DRAW);
+#ifdef WG3D_RENDER_STATS
+            m_kStats.GetCurrent().BufferCreations++;
+            m_kStats.GetCurrent().BufferBytes +=
+                (int)(pkColors->GetQuantity()*sizeof(ColorRGB));
+#endif
 			pkColors->DeleteRawData();
         }
 
@@ -970,18 +956,18 @@ void VincentGLRenderer::EnableColorRGBs ()
     }
 	else if(!akColor)
 		return;
-    glEnableClientState(GL_COLOR_ARRAY);
-    glColorPointer(3,GL_FIXED,0,akColor);
+    m_kGLState.EnableClientState(GL_COLOR_ARRAY);
+    m_kGLState.ColorPointer(3,akColor);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::DisableColorRGBs ()
 {
     if (m_pkLocalEffect->ColorRGBs->IsExactly(CachedColorRGBArray::TYPE))
     {
-        glBindBuffer(GL_ARRAY_BUFFER,0);
+        m_kGLState.BindBuffer(GL_ARRAY_BUFFER,0);
     }
 
-    glDisableClientState(GL_COLOR_ARRAY);
+    m_kGLState.DisableClientState(GL_COLOR_ARRAY);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::EnableUVs ( int i, Effect* pkEffect)
@@ -1000,7 +986,7 @@ void VincentGLRenderer::EnableUVs ( int i, Effect* pkEffect)
         if (uiID > 0)
         {
             // uv's already cached, just bind them
-            glBindBuffer(GL_ARRAY_BUFFER,uiID);
+            m_kGLState.BindBuffer(GL_ARRAY_BUFFER,uiID);
         }
         else
         {
@@ -1009,12 +995,17 @@ void VincentGLRenderer::EnableUVs ( int i, Effect* pkEffect)
             pkCUVs->BIArray.Bind(this,sizeof(GLuint),&uiID);
 
             // bind the uv's
-            glBindBuffer(GL_ARRAY_BUFFER,uiID);
+            m_kGLState.BindBuffer(GL_ARRAY_BUFFER,uiID);
 
             // copy the data to the buffer
             glBufferData(GL_ARRAY_BUFFER,
                 pkUVs->GetQuantity()*sizeof(Vector2x),akUV,
                 GL_STATIC_DRAW);
+#ifdef WG3D_RENDER_STATS
+            m_kStats.GetCurrent().BufferCreations++;
+            m_kStats.GetCurrent().BufferBytes +=
+                (int)(pkUVs->GetQuantity()*sizeof(Vector2x));
+#endif
 			pkEffect->RemoveTextureUVData(i);
         }
 
@@ -1022,22 +1013,24 @@ void VincentGLRenderer::EnableUVs ( int i, Effect* pkEffect)
     }
 	else if(!akUV)
 		return;
-    glEnableClientState(GL_TEXTURE_COORD_ARRAY); 
-    glTexCoordPointer(2,GL_FIXED,0,akUV);
+    m_kGLState.EnableClientState(GL_TEXTURE_COORD_ARRAY); 
+    m_kGLState.TexCoordPointer(2,akUV);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::DisableUVs (Vector2xArray* pkUVs)
 {
     if (pkUVs->IsExactly(CachedVector2xArray::TYPE))
     {
-        glBindBuffer(GL_ARRAY_BUFFER,0);
+        m_kGLState.BindBuffer(GL_ARRAY_BUFFER,0);
     }
 
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    m_kGLState.DisableClientState(GL_TEXTURE_COORD_ARRAY);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::DrawElements ()
 {
+    WG3D_PROFILE("VincentGLRenderer::DrawElements");
+
     // get indices
     ShortArray* pkIndices = m_pkGeometry->Indices;
     int iIQuantity = pkIndices->GetQuantity();
@@ -1054,7 +1047,7 @@ void VincentGLRenderer::DrawElements ()
         if (uiID > 0)
         {
             // indices already cached, just bind them
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,uiID);
+            m_kGLState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER,uiID);
         }
         else
         {
@@ -1063,17 +1056,26 @@ void VincentGLRenderer::DrawElements ()
             pkCIndices->BIArray.Bind(this,sizeof(GLuint),&uiID);
 
             // bind the indices
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,uiID);
+            m_kGLState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER,uiID);
 
             // copy the data to the buffer
             glBufferData(GL_ELEMENT_ARRAY_BUFFER,
                 iIQuantity*sizeof(short),aiIndex,GL_STATIC_DRAW);
+#ifdef WG3D_RENDER_STATS
+            m_kStats.GetCurrent().BufferCreations++;
+            m_kStats.GetCurrent().BufferBytes +=
+                (int)(iIQuantity*sizeof(short));
+#endif
 			pkCIndices->DeleteRawData();
         }
 
         aiIndex = 0;
     }
 	
+#ifdef WG3D_VERIFY_GL_STATE
+    assert(m_kGLState.Verify());
+#endif
+
     GLenum eType = ms_aeObjectType[m_pkGeometry->m_GeometryType];
     
 	if(!bCached && aiIndex==NULL && m_pkGeometry->Vertices->GetQuantity()>0)
@@ -1081,20 +1083,29 @@ void VincentGLRenderer::DrawElements ()
 	else
 		glDrawElements(eType,iIQuantity,GL_UNSIGNED_SHORT,aiIndex);
 
+#ifdef WG3D_RENDER_STATS
+    RenderStats::Frame& rkFrame = m_kStats.GetCurrent();
+    rkFrame.DrawCalls++;
+    rkFrame.Triangles += RenderStats::GetTriangleQuantity(
+        m_pkGeometry->m_GeometryType,(aiIndex || bCached) ? iIQuantity :
+        m_pkGeometry->Vertices->GetQuantity());
+#endif
+
     if (bCached)
     {
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,0);
+		m_kGLState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER,0);
     }
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::ReleaseArray (CachedColorRGBAArray* pkArray)
 {
     assert(pkArray);
+    WG3D_RENDER_STATS_DO(m_kStats.GetCurrent().ArrayReleases++);
     GLuint uiID;
     pkArray->BIArray.GetID(this,sizeof(GLuint),&uiID);
     if (uiID > 0)
     {
-        glDeleteBuffers((GLsizei)1,(GLuint*)&uiID);
+        m_kGLState.DeleteBuffer(uiID);
         pkArray->BIArray.Unbind(this);
 
     }
@@ -1103,12 +1114,13 @@ void VincentGLRenderer::ReleaseArray (CachedColorRGBAArray* pkArray)
 void VincentGLRenderer::ReleaseArray (CachedColorRGBArray* pkArray)
 {
     assert(pkArray);
+    WG3D_RENDER_STATS_DO(m_kStats.GetCurrent().ArrayReleases++);
     GLuint uiID;
     pkArray->BIArray.GetID(this,sizeof(GLuint),&uiID);
     if (uiID > 0)
     {
 
-        glDeleteBuffers((GLsizei)1,(GLuint*)&uiID);
+        m_kGLState.DeleteBuffer(uiID);
         pkArray->BIArray.Unbind(this);
     }
 }
@@ -1116,12 +1128,13 @@ void VincentGLRenderer::ReleaseArray (CachedColorRGBArray* pkArray)
 void VincentGLRenderer::ReleaseArray (CachedShortArray* pkArray)
 {
     assert(pkArray);
+    WG3D_RENDER_STATS_DO(m_kStats.GetCurrent().ArrayReleases++);
     GLuint uiID;
     pkArray->BIArray.GetID(this,sizeof(GLuint),&uiID);
     if (uiID > 0)
     {
 
-        glDeleteBuffers((GLsizei)1,(GLuint*)&uiID);
+        m_kGLState.DeleteBuffer(uiID);
         pkArray->BIArray.Unbind(this);
     }
 }
@@ -1129,12 +1142,13 @@ void VincentGLRenderer::ReleaseArray (CachedShortArray* pkArray)
 void VincentGLRenderer::ReleaseArray (CachedVector2xArray* pkArray)
 {
     assert(pkArray);
+    WG3D_RENDER_STATS_DO(m_kStats.GetCurrent().ArrayReleases++);
     GLuint uiID;
     pkArray->BIArray.GetID(this,sizeof(GLuint),&uiID);
     if (uiID > 0)
     {
 
-        glDeleteBuffers((GLsizei)1,(GLuint*)&uiID);
+        m_kGLState.DeleteBuffer(uiID);
         pkArray->BIArray.Unbind(this);
     }
 }
@@ -1142,26 +1156,38 @@ void VincentGLRenderer::ReleaseArray (CachedVector2xArray* pkArray)
 void VincentGLRenderer::ReleaseArray (CachedVector3xArray* pkArray)
 {
     assert(pkArray);
+    WG3D_RENDER_STATS_DO(m_kStats.GetCurrent().ArrayReleases++);
     GLuint uiID;
     pkArray->BIArray.GetID(this,sizeof(GLuint),&uiID);
     if (uiID > 0)
     {
 
-        glDeleteBuffers((GLsizei)1,(GLuint*)&uiID);
+        m_kGLState.DeleteBuffer(uiID);
         pkArray->BIArray.Unbind(this);
     }
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::SetConstantTransformM (int iOption, fixed* afData)
 {
-    Matrix4x kM(m_afWorldMatrix,false);
+    if (iOption == ShaderConstant::SCO_INVERSE
+    ||  iOption == ShaderConstant::SCO_INVERSE_TRANSPOSE)
+    {
+        // the inverse is cached along with the world matrix
+        Matrix4x kInvM(m_pkGeometry->GetWorldInverseHomogeneous(),false);
+        GetTransform(kInvM,(iOption == ShaderConstant::SCO_INVERSE ?
+            ShaderConstant::SCO_MATRIX : ShaderConstant::SCO_TRANSPOSE),
+            afData);
+        return;
+    }
+
+    Matrix4x kM(m_pkGeometry->GetWorldHomogeneous(),false);
     GetTransform(kM,iOption,afData);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::SetConstantTransformP (int iOption, fixed* afData)
 {
     fixed afProjection[16];
-    glGetFixedv(GL_PROJECTION_MATRIX,(int*)afProjection);
+    glGetRealv(GL_PROJECTION_MATRIX,(GLreal*)afProjection);
     Matrix4x kP(afProjection,false);
     GetTransform(kP,iOption,afData);
 }
@@ -1173,7 +1199,7 @@ void VincentGLRenderer::SetConstantTransformMV (int iOption, fixed* afData)
     // transpose of what Wild Magic expects.  These two facts require a
     // sign change in the specified entries to cause -D to be mapped to D.
     fixed afModelView[16];
-    glGetFixedv(GL_MODELVIEW_MATRIX,(int*)afModelView);
+    glGetRealv(GL_MODELVIEW_MATRIX,(GLreal*)afModelView);
     afModelView[ 2] = -afModelView[ 2];
     afModelView[ 6] = -afModelView[ 6];
     afModelView[10] = -afModelView[10];
@@ -1185,7 +1211,7 @@ void VincentGLRenderer::SetConstantTransformMV (int iOption, fixed* afData)
 void VincentGLRenderer::SetConstantTransformMVP (int iOption, fixed* afData)
 {
     fixed afProjection[16];
-    glGetFixedv(GL_PROJECTION_MATRIX,(int*)afProjection);
+    glGetRealv(GL_PROJECTION_MATRIX,(GLreal*)afProjection);
     Matrix4x kP(afProjection,false);
 
     // OpenGL's model-view matrix has vectors in the order (R,U,-D).  Wild
@@ -1195,7 +1221,7 @@ void VincentGLRenderer::SetConstantTransformMVP (int iOption, fixed* afData)
     // OpenGL's projection matrix has that sign change built into it, so
     // unlike SetConstantMVMatrix, there is no need to change signs.
     fixed afModelView[16];
-    glGetFixedv(GL_MODELVIEW_MATRIX,(int*)afModelView);
+    glGetRealv(GL_MODELVIEW_MATRIX,(GLreal*)afModelView);
     Matrix4x kMV(afModelView,false);
 
     Matrix4x kPMV = kP*kMV;
@@ -1207,7 +1233,7 @@ void VincentGLRenderer::GetTransform (Matrix4x& rkMat, int iOption,
 {
     // Wild Magic uses matrix M, OpenGL uses matrix Transpose(M).  The input
     // matrix is guaranteed to be in OpenGL format.  This ensures that the
-    // final matrix is in row-major order and the memcpy to afData produces
+    // final matrix is in row-major order and the copy to afData produces
     // a fixed[16] array in the format OpenGL expects.
 
     switch (iOption)
@@ -1228,20 +1254,24 @@ void VincentGLRenderer::GetTransform (Matrix4x& rkMat, int iOption,
         break;
     }
 
-    memcpy(afData,(const fixed*)rkMat,16*sizeof(fixed));
+    const fixed* afMat = (const fixed*)rkMat;
+    for (int i = 0; i < 16; i++)
+    {
+        afData[i] = afMat[i];
+    }
 }
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 void VincentGLRenderer::SetPointSize (fixed fSize)
 {
     Renderer::SetPointSize(fSize);
-    glPointSizex(m_fPointSize.value);
+    glPointSizer(m_fPointSize.value);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::SetLineWidth (fixed fWidth)
 {
     Renderer::SetLineWidth(fWidth);
-    glLineWidthx(m_fLineWidth.value);
+    glLineWidthr(m_fLineWidth.value);
 }
 //----------------------------------------------------------------------------
 void VincentGLRenderer::SetLineStipple (int iRepeat, unsigned short usPattern)
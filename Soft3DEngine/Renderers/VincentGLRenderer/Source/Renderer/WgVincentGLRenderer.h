@@ -20,10 +20,12 @@
 #include "gles/gl.h"
 #include "gles/glext.h"
 
+#include "WgGLStateCache.h"
 #include "WgLight.h"
 #include "WgTexture.h"
 #include "WgGeometry.h"
 
+
 namespace WGSoft3D
 {
 
@@ -85,6 +87,9 @@ public:
     virtual void ReleaseArray (CachedVector2xArray* pkArray);
     virtual void ReleaseArray (CachedVector3xArray* pkArray);
 
+    // the filter of redundant OpenGL state changes and its counters
+    GLStateCache& GetGLState ();
+
 
 protected:
     // construction
@@ -100,10 +105,6 @@ protected:
     virtual void SaveContext () = 0;
     virtual void RestoreContext () = 0;
 
-    // model-to-world transformation handling
-    void SetWorldMatrix ();
-    fixed m_afWorldMatrix[16];
-
     // global render state management
     virtual void SetAlphaState (AlphaState* pkState);
     virtual void SetCullState (CullState* pkState);
@@ -168,6 +169,9 @@ protected:
     };
     TArray<DisplayListInfo> m_kDLInfo;
 
+    // All the state that is changed per draw goes through the cache.
+    GLStateCache m_kGLState;
+
     // *** maps from Soft3D enums to OpenGL enums ***
 
     // object types
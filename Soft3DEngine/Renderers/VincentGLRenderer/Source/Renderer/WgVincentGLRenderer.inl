@@ -73,9 +73,9 @@ inline void gluLookAt(fixed eyex, fixed eyey, fixed eyez,
 	M(3, 2) = FIXED_ZERO;
 	M(3, 3) = FIXED_ONE;
 #undef M
-	glMultMatrixx((int*)m);
+	glMultMatrixr((GLreal*)m);
 	/* Translate Eye to Origin */
-	glTranslatex((-eyex).value,(-eyey).value,(-eyez).value);
+	glTranslater((-eyex).value,(-eyey).value,(-eyez).value);
 }
 
 
@@ -117,6 +117,13 @@ inline  void glOrtho (fixed left, fixed right, fixed bottom, fixed top, fixed iN
 	m[14] = (iFar + iNear) * _1over_fmn;
 	m[15] = FIXED_ONE;
 	
-	glMultMatrixx((int*)m);
+	glMultMatrixr((GLreal*)m);
 }
 
+
+//----------------------------------------------------------------------------
+inline GLStateCache& VincentGLRenderer::GetGLState ()
+{
+    return m_kGLState;
+}
+//----------------------------------------------------------------------------
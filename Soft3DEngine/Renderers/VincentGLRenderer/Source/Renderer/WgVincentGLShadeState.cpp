@@ -21,7 +21,7 @@ GLenum VincentGLRenderer::ms_aeShade[ShadeState::SM_QUANTITY] =
 //----------------------------------------------------------------------------
 void VincentGLRenderer::SetShadeState (ShadeState* pkState)
 {
-    glShadeModel(ms_aeShade[pkState->Shade]);
+    m_kGLState.ShadeModel(ms_aeShade[pkState->Shade]);
 }
 //----------------------------------------------------------------------------
 
@@ -29,22 +29,22 @@ void VincentGLRenderer::SetZBufferState (ZBufferState* pkState)
 {
     if (pkState->Enabled)
     {
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(ms_aeZBufferCompare[pkState->Compare]);
+        m_kGLState.Enable(GL_DEPTH_TEST);
+        m_kGLState.DepthFunc(ms_aeZBufferCompare[pkState->Compare]);
     }
     else
     {
-        glDisable(GL_DEPTH_TEST);
-        glDepthFunc(GL_ALWAYS);
+        m_kGLState.Disable(GL_DEPTH_TEST);
+        m_kGLState.DepthFunc(GL_ALWAYS);
     }
 
     if (pkState->Writable)
     {
-        glDepthMask(GL_TRUE);
+        m_kGLState.DepthMask(GL_TRUE);
     }
     else
     {
-        glDepthMask(GL_FALSE);
+        m_kGLState.DepthMask(GL_FALSE);
     }
 }
 //----------------------------------------------------------------------------